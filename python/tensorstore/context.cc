@@ -27,8 +27,11 @@
 #include "python/tensorstore/serialization.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_impl.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/cache_pool_resource.h"
 #include "tensorstore/internal/json/pprint_python.h"
 #include "tensorstore/json_serialization_options.h"
+#include "tensorstore/util/str_cat.h"
 
 namespace tensorstore {
 namespace internal_python {
@@ -309,6 +312,62 @@ Example:
     >>> context['cache_pool#a'].to_json()
     {'total_bytes_limit': 10000000}
 
+Group:
+  Accessors
+)");
+
+  cls.def(
+      "memory_usage",
+      [](ResourceImplWeakPtr self) {
+        if (self->spec_->provider_->id_ != internal::CachePoolResource::id) {
+          throw py::value_error(tensorstore::StrCat(
+              "Memory usage is only available for \"",
+              internal::CachePoolResource::id, "\" resources"));
+        }
+        auto& pool =
+            static_cast<
+                internal_context::ResourceImpl<internal::CachePoolResource>&>(
+                *self)
+                .value_;
+        const auto usage = pool->GetMemoryUsage();
+        auto to_dict = [](const internal::CacheMemoryUsage::StateUsage& u) {
+          py::dict d;
+          d["num_entries"] = u.num_entries;
+          d["num_bytes"] = u.num_bytes;
+          return d;
+        };
+        py::dict result;
+        result["num_entries"] = usage.num_entries();
+        result["num_bytes"] = usage.num_bytes();
+        result["clean"] = to_dict(usage.clean);
+        result["in_use"] = to_dict(usage.in_use);
+        result["dirty"] = to_dict(usage.dirty);
+        result["writeback_requested"] = to_dict(usage.writeback_requested);
+        return result;
+      },
+      R"(
+Returns the current memory usage of a :json:schema:`Context.cache_pool` resource.
+
+The returned :py:obj:`dict` contains the total ``num_entries`` and
+``num_bytes``, along with a breakdown by entry state:
+
+- ``clean``: unmodified entries that are not in use, and may be evicted;
+- ``in_use``: unmodified entries that are currently in use;
+- ``dirty``: entries with modifications that have not yet been written back;
+- ``writeback_requested``: entries for which writeback is in progress.
+
+The usage is maintained incrementally, and this method is cheap enough to call
+periodically for monitoring.
+
+Example:
+
+    >>> context = ts.Context({'cache_pool': {'total_bytes_limit': 10000000}})
+    >>> context['cache_pool'].memory_usage()['num_bytes']
+    0
+
+Raises:
+  ValueError: If this is not a :json:schema:`Context.cache_pool` resource.
+
 Group:
   Accessors
 )");
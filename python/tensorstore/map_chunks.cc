@@ -0,0 +1,186 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+// Other headers must be included after pybind11 to ensure header-order
+// inclusion constraints are satisfied.
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "python/tensorstore/array_type_caster.h"
+#include "python/tensorstore/data_type.h"
+#include "python/tensorstore/future.h"
+#include "python/tensorstore/gil_safe.h"
+#include "python/tensorstore/index.h"
+#include "python/tensorstore/index_space.h"
+#include "python/tensorstore/map_chunks.h"
+#include "python/tensorstore/result_type_caster.h"
+#include "python/tensorstore/status.h"
+#include "python/tensorstore/tensorstore_class.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/index_space/index_domain_builder.h"
+#include "tensorstore/map_chunks.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_python {
+
+namespace py = ::pybind11;
+
+namespace {
+
+/// Adapts a Python function into a `MapChunksFunction`.
+struct MapChunksFunctionAdapter {
+  GilSafeHolder<py::object> python_function;
+  IndexDomain<> target_domain;
+
+  Result<IndexDomain<>> GetDomain(BoxView<> bounds) const {
+    return IndexDomainBuilder(bounds.rank())
+        .bounds(bounds)
+        .labels(target_domain.labels())
+        .Finalize();
+  }
+
+  absl::Status operator()(SharedOffsetArrayView<const void> input,
+                          SharedOffsetArrayView<void> output) const {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto input_domain,
+                                 GetDomain(input.domain()));
+    TENSORSTORE_ASSIGN_OR_RETURN(auto output_domain,
+                                 GetDomain(output.domain()));
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto zero_origin_input,
+        (ArrayOriginCast<zero_origin, container>(input)));
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto zero_origin_output,
+        (ArrayOriginCast<zero_origin, container>(output)));
+    ExitSafeGilScopedAcquire gil;
+    if (!gil.acquired()) return PythonExitingError();
+    if (CallAndSetErrorIndicator([&] {
+          auto python_output = GetNumpyArray(zero_origin_output);
+          (*python_function)(py::cast(input_domain),
+                             GetNumpyArray(zero_origin_input),
+                             py::cast(output_domain), python_output);
+          if (!CanDataTypeShareMemoryWithNumpy(zero_origin_output.dtype())) {
+            // `python_output` is a copy; copy its content back.
+            CopyFromNumpyArray(python_output, zero_origin_output);
+          }
+        })) {
+      return GetStatusFromPythonException();
+    }
+    return absl::OkStatus();
+  }
+};
+
+}  // namespace
+
+void RegisterMapChunksBindings(pybind11::module m, Executor defer) {
+  defer([m]() mutable {
+    m.def(
+        "map_chunks",
+        [](py::object function, PythonTensorStoreObject& target,
+           std::optional<PythonTensorStoreObject*> source,
+           std::optional<std::vector<Index>> halo,
+           Index max_in_flight) -> PythonFutureWrapper<void> {
+          MapChunksOptions options;
+          if (halo) options.halo = std::move(*halo);
+          options.max_in_flight = max_in_flight;
+          TensorStore<> source_store =
+              source ? (*source)->value : target.value;
+          return PythonFutureWrapper<void>(
+              tensorstore::MapChunks(
+                  std::move(source_store), target.value,
+                  MapChunksFunctionAdapter{
+                      GilSafeHolder<py::object>(std::move(function)),
+                      target.value.domain()},
+                  std::move(options)),
+              target.reference_manager());
+        },
+        R"(
+Applies a function to each write chunk of a :py:obj:`TensorStore`.
+
+The write chunk grid of :py:param:`.target` is iterated over its domain.  For
+each chunk, the corresponding region of :py:param:`.source`, expanded by
+:py:param:`.halo`, is read and passed to :py:param:`.function` along with an
+output array for the chunk, which is then written to :py:param:`.target`.  Each
+chunk of :py:param:`.target` is written exactly once.
+
+Example:
+
+    >>> store = await ts.open(
+    ...     {
+    ...         'driver': 'zarr',
+    ...         'kvstore': {
+    ...             'driver': 'memory'
+    ...         }
+    ...     },
+    ...     dtype=ts.uint32,
+    ...     shape=[4, 6],
+    ...     chunk_layout=ts.ChunkLayout(write_chunk_shape=[2, 3]),
+    ...     create=True)
+    >>> await store.write(np.arange(24, dtype=np.uint32).reshape(4, 6))
+    >>> def threshold(input_domain, input, output_domain, output):
+    ...     output[...] = input > 10
+    >>> await ts.map_chunks(threshold, store)
+    >>> await store.read()
+    array([[0, 0, 0, 0, 0, 0],
+           [0, 0, 0, 0, 0, 1],
+           [1, 1, 1, 1, 1, 1],
+           [1, 1, 1, 1, 1, 1]], dtype=uint32)
+
+Args:
+
+  function: Called as :python:`function(input_domain, input, output_domain,
+    output)` for each chunk, where :python:`input` and :python:`output` are
+    NumPy arrays with the domains :python:`input_domain` and
+    :python:`output_domain`, respectively.  The :python:`output` array is
+    initially zero and must be assigned in place.  May be called concurrently
+    for multiple chunks, but always with the GIL held.
+
+  target: TensorStore to which the output is written.  Must have a finite
+    domain.
+
+  source: TensorStore from which the input is read, indexed using the same
+    coordinates as :py:param:`.target`.  If not specified, the input is read
+    from :py:param:`.target`, and the output is written back in place.
+
+  halo: Number of additional elements of :py:param:`.source` to include on
+    each side of each chunk, in each dimension.  The input is clipped to the
+    domain of :py:param:`.source`.
+
+  max_in_flight: Maximum number of chunks processed concurrently.
+
+Returns:
+
+  Future that becomes ready when all chunks have been written.
+
+Group:
+  I/O
+)",
+        py::arg("function"), py::arg("target"),
+        py::arg("source") = std::nullopt, py::kw_only(),
+        py::arg("halo") = std::nullopt,
+        py::arg("max_in_flight") = 16);
+  });
+}
+
+}  // namespace internal_python
+}  // namespace tensorstore
@@ -0,0 +1,177 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+// Other headers must be included after pybind11 to ensure header-order
+// inclusion constraints are satisfied.
+
+#include <optional>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "python/tensorstore/array_type_caster.h"
+#include "python/tensorstore/future.h"
+#include "python/tensorstore/garbage_collection.h"
+#include "python/tensorstore/index_space.h"
+#include "python/tensorstore/read_chunks.h"
+#include "python/tensorstore/result_type_caster.h"
+#include "python/tensorstore/status.h"
+#include "python/tensorstore/tensorstore_class.h"
+#include "tensorstore/array.h"
+#include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/read_chunks.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_python {
+
+namespace py = ::pybind11;
+
+namespace {
+
+using ChunkPair = std::pair<IndexDomain<>, SharedArray<void>>;
+
+/// Python wrapper for `ReadChunksIterator`.
+struct PythonReadChunksIterator {
+  ReadChunksIterator iterator;
+
+  /// References to Python objects used by the store, e.g. by a
+  /// `virtual_chunked` read function, that must remain alive while chunks
+  /// are being read.
+  PythonObjectReferenceManager reference_manager;
+
+  /// Encodes a `StopAsyncIteration` exception, with which the future returned
+  /// by `__anext__` fails once all chunks have been returned.
+  absl::Status stop_status;
+};
+
+using ReadChunksIteratorCls = py::class_<PythonReadChunksIterator>;
+
+auto MakeReadChunksIteratorClass(py::module m) {
+  return ReadChunksIteratorCls(m, "ReadChunksIterator", R"(
+Asynchronous iterator over the chunks of a :py:obj:`TensorStore`.
+
+Returned by :py:obj:`tensorstore.read_chunks`.
+
+Group:
+  I/O
+)");
+}
+
+void DefineReadChunksIteratorAttributes(ReadChunksIteratorCls& cls) {
+  using Self = PythonReadChunksIterator;
+  cls.def("__aiter__", [](py::object self) { return self; });
+  cls.def(
+      "__anext__",
+      [](Self& self) -> PythonFutureWrapper<ChunkPair> {
+        auto future = MapFutureValue(
+            InlineExecutor{},
+            [stop_status = self.stop_status](
+                std::optional<ReadChunksIterator::Chunk>& chunk)
+                -> Result<ChunkPair> {
+              if (!chunk) return stop_status;
+              TENSORSTORE_ASSIGN_OR_RETURN(
+                  auto array, (ArrayOriginCast<zero_origin, container>(
+                                  std::move(chunk->array))));
+              return ChunkPair(std::move(chunk->domain), std::move(array));
+            },
+            self.iterator.Next());
+        return PythonFutureWrapper<ChunkPair>(std::move(future),
+                                              self.reference_manager);
+      },
+      R"(
+Returns a future for the next :python:`(domain, array)` pair.
+
+The future fails with :py:obj:`StopAsyncIteration` once all chunks have been
+returned.
+)");
+}
+
+void DefineReadChunksFunction(py::module m) {
+  m.def(
+      "read_chunks",
+      [](PythonTensorStoreObject& store,
+         Index max_buffered_chunks) -> PythonReadChunksIterator {
+        PythonReadChunksIterator result;
+        result.iterator = tensorstore::ReadChunks(
+            store.value, {/*.max_buffered_chunks=*/max_buffered_chunks});
+        result.reference_manager = store.reference_manager();
+        result.stop_status = GetStatusFromPythonException(
+            py::handle(PyExc_StopAsyncIteration)());
+        return result;
+      },
+      R"(
+Reads a :py:obj:`TensorStore` one chunk at a time.
+
+The read chunk grid of :py:param:`.store` is iterated over its domain.  Each
+chunk, intersected with the domain, is read separately, and the
+:python:`(domain, array)` pairs are yielded as soon as the read of each chunk
+completes, in completion order.  Unlike :py:meth:`TensorStore.read`, the result
+is never assembled into a single array, which bounds the memory used to a few
+chunks.
+
+Example:
+
+    >>> store = await ts.open(
+    ...     {
+    ...         'driver': 'zarr',
+    ...         'kvstore': {
+    ...             'driver': 'memory'
+    ...         }
+    ...     },
+    ...     dtype=ts.uint32,
+    ...     shape=[4, 6],
+    ...     chunk_layout=ts.ChunkLayout(chunk_shape=[4, 3]),
+    ...     create=True)
+    >>> await store.write(np.arange(24, dtype=np.uint32).reshape(4, 6))
+    >>> total = 0
+    >>> async for domain, array in ts.read_chunks(store):
+    ...     total += int(array.sum())
+    >>> total
+    276
+
+Args:
+
+  store: TensorStore to read.  Must have a finite domain.
+
+  max_buffered_chunks: Maximum number of chunks that are read ahead of the
+    consumer, i.e. that are either being read or have been read but not yet
+    consumed.
+
+Returns:
+
+  Asynchronous iterator of :python:`(domain, array)` pairs, where
+  :python:`domain` is an :py:obj:`IndexDomain` and :python:`array` is a NumPy
+  array with the shape of :python:`domain`.
+
+Group:
+  I/O
+)",
+      py::arg("store"), py::kw_only(), py::arg("max_buffered_chunks") = 4);
+}
+
+}  // namespace
+
+void RegisterReadChunksBindings(pybind11::module m, Executor defer) {
+  defer([cls = MakeReadChunksIteratorClass(m)]() mutable {
+    DefineReadChunksIteratorAttributes(cls);
+  });
+  defer([m]() mutable { DefineReadChunksFunction(m); });
+}
+
+}  // namespace internal_python
+}  // namespace tensorstore
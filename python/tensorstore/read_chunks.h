@@ -0,0 +1,36 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_PY_TENSORSTORE_READ_CHUNKS_H_
+#define THIRD_PARTY_PY_TENSORSTORE_READ_CHUNKS_H_
+
+/// \file
+///
+/// Defines `tensorstore.read_chunks` and `tensorstore.ReadChunksIterator`.
+
+#include <pybind11/pybind11.h>
+// Other headers must be included after pybind11 to ensure header-order
+// inclusion constraints are satisfied.
+
+#include "tensorstore/util/executor.h"
+
+namespace tensorstore {
+namespace internal_python {
+
+void RegisterReadChunksBindings(pybind11::module m, Executor defer);
+
+}  // namespace internal_python
+}  // namespace tensorstore
+
+#endif  // THIRD_PARTY_PY_TENSORSTORE_READ_CHUNKS_H_
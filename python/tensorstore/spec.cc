@@ -679,10 +679,12 @@ Example:
     'context': {
       'cache_pool': {},
       'data_copy_concurrency': {},
+      'in_flight_bytes': {},
       'memory_key_value_store': {},
     },
     'data_copy_concurrency': ['data_copy_concurrency'],
     'driver': 'n5',
+    'in_flight_bytes': ['in_flight_bytes'],
     'kvstore': {
       'driver': 'memory',
       'memory_key_value_store': ['memory_key_value_store'],
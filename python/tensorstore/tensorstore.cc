@@ -34,6 +34,8 @@
 #include "python/tensorstore/gil_safe.h"
 #include "python/tensorstore/index_space.h"
 #include "python/tensorstore/kvstore.h"
+#include "python/tensorstore/map_chunks.h"
+#include "python/tensorstore/read_chunks.h"
 #include "python/tensorstore/python_imports.h"
 #include "python/tensorstore/serialization.h"
 #include "python/tensorstore/spec.h"
@@ -103,6 +105,8 @@ PYBIND11_MODULE(_tensorstore, m) {
   RegisterFutureBindings(m, defer);
   RegisterWriteFuturesBindings(m, defer);
   RegisterDownsampleBindings(m, defer);
+  RegisterMapChunksBindings(m, defer);
+  RegisterReadChunksBindings(m, defer);
   RegisterVirtualChunkedBindings(m, defer);
   RegisterSerializationBindings(m, defer);
 
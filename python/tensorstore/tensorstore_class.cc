@@ -185,6 +185,7 @@ Examples:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -380,6 +381,7 @@ Example:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -481,8 +483,15 @@ Group:
 
   cls.def(
       "read",
-      [](Self& self, ContiguousLayoutOrder order)
-          -> PythonFutureWrapper<SharedArray<void>> {
+      [](Self& self, ContiguousLayoutOrder order,
+         bool read_only) -> PythonFutureWrapper<SharedArray<void>> {
+        if (read_only) {
+          return PythonFutureWrapper<SharedArray<void>>(
+              PythonFutureObject::Make(
+                  tensorstore::Read<zero_origin>(
+                      self.value, ReadIntoSharedArrayOptions{order}),
+                  self.reference_manager()));
+        }
         return PythonFutureWrapper<SharedArray<void>>(
             tensorstore::Read<zero_origin>(self.value, {order}),
             self.reference_manager());
@@ -530,6 +539,10 @@ Args:
     :python:`'F'`
       Specifies Fortran order, i.e. colexicographic/column-major order.
 
+  read_only: Return a read-only array.  If the read is satisfied by a single
+    cached chunk that already has the requested :py:param:`.order`, the
+    returned array refers directly to the cached data rather than to a copy.
+
 Returns:
   A future representing the asynchronous read result.
 
@@ -553,7 +566,7 @@ Group:
   I/O
 
 )",
-      py::arg("order") = "C");
+      py::arg("order") = "C", py::kw_only(), py::arg("read_only") = false);
 
   cls.def(
       "write",
@@ -1249,6 +1262,7 @@ Example:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -1382,6 +1396,7 @@ integer or boolean array indexing terms are applied orthogonally:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -1497,6 +1512,7 @@ domain:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -1624,6 +1640,7 @@ Example:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -1792,6 +1809,7 @@ Example:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'n5',
@@ -1915,6 +1933,7 @@ Example:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'n5',
@@ -2105,6 +2124,7 @@ Opens or creates a :py:class:`TensorStore` from a :py:class:`Spec`.
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -2169,6 +2189,7 @@ like the data type, domain, and chunk layout, may be omitted:
         'gcs_request_concurrency': {},
         'gcs_request_retries': {},
         'gcs_user_project': {},
+        'in_flight_bytes': {},
       },
       'driver': 'neuroglancer_precomputed',
       'dtype': 'uint64',
@@ -2228,6 +2249,7 @@ properties that are left unconstrained:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -2280,6 +2302,7 @@ determine a matching chunk layout automatically:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
@@ -2332,6 +2355,7 @@ independent of the driver/format:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'n5',
@@ -2375,6 +2399,7 @@ schema constraints:
       'context': {
         'cache_pool': {},
         'data_copy_concurrency': {},
+        'in_flight_bytes': {},
         'memory_key_value_store': {},
       },
       'driver': 'zarr',
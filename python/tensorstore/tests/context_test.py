@@ -103,3 +103,31 @@ def test_pickle():
     assert new_parent is not parent_context
     assert new_ctx is not context
     parent_context, context = new_parent, new_ctx
+
+
+def test_cache_pool_memory_usage():
+  context = ts.Context({'cache_pool': {'total_bytes_limit': 10000000}})
+  store = ts.open(
+      {
+          'driver': 'zarr',
+          'kvstore': 'memory://',
+          'dtype': 'uint8',
+          'metadata': {
+              'shape': [100],
+              'chunks': [10],
+          },
+          'create': True,
+      },
+      context=context,
+  ).result()
+  store[:] = 1
+  store.read().result()
+  usage = context['cache_pool'].memory_usage()
+  assert usage['num_entries'] > 0
+  assert usage['num_bytes'] > 0
+  assert usage['num_bytes'] == sum(
+      usage[state]['num_bytes']
+      for state in ['clean', 'in_use', 'dirty', 'writeback_requested'])
+
+  with pytest.raises(ValueError):
+    context['data_copy_concurrency'].memory_usage()
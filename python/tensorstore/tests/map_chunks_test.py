@@ -0,0 +1,79 @@
+# Copyright 2023 The TensorStore Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests for tensorstore.map_chunks."""
+
+import numpy as np
+import pytest
+import tensorstore as ts
+
+pytestmark = pytest.mark.asyncio
+
+
+async def open_store(shape, chunks):
+  return await ts.open(
+      {
+          'driver': 'zarr',
+          'kvstore': {
+              'driver': 'memory'
+          },
+      },
+      dtype=ts.uint32,
+      shape=shape,
+      chunk_layout=ts.ChunkLayout(write_chunk_shape=chunks),
+      create=True)
+
+
+async def test_map_chunks_in_place():
+  store = await open_store([5, 6], [3, 4])
+  data = np.arange(30, dtype=np.uint32).reshape(5, 6)
+  await store.write(data)
+
+  output_domains = []
+
+  def double(input_domain, input, output_domain, output):
+    assert input_domain == output_domain
+    output_domains.append(output_domain)
+    output[...] = input * 2
+
+  await ts.map_chunks(double, store)
+  assert sorted(d.inclusive_min for d in output_domains) == [
+      (0, 0), (0, 4), (3, 0), (3, 4)
+  ]
+  np.testing.assert_equal(await store.read(), data * 2)
+
+
+async def test_map_chunks_halo():
+  source = ts.array(np.arange(10, dtype=np.uint32))
+  target = await open_store([10], [4])
+
+  def neighbor_sum(input_domain, input, output_domain, output):
+    offset = output_domain.inclusive_min[0] - input_domain.inclusive_min[0]
+    padded = np.pad(input, 1)
+    n = output.shape[0]
+    output[...] = padded[offset:offset + n] + padded[offset + 2:offset + 2 + n]
+
+  await ts.map_chunks(neighbor_sum, target, source, halo=[1])
+  np.testing.assert_equal(
+      await target.read(),
+      np.array([1, 2, 4, 6, 8, 10, 12, 14, 16, 8], dtype=np.uint32))
+
+
+async def test_map_chunks_error():
+  store = await open_store([4], [2])
+
+  def fail(input_domain, input, output_domain, output):
+    raise ValueError('failed')
+
+  with pytest.raises(ValueError, match='failed'):
+    await ts.map_chunks(fail, store)
@@ -0,0 +1,66 @@
+# Copyright 2023 The TensorStore Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests for tensorstore.read_chunks."""
+
+import numpy as np
+import pytest
+import tensorstore as ts
+
+pytestmark = pytest.mark.asyncio
+
+
+async def open_store(shape, chunks):
+  return await ts.open(
+      {
+          'driver': 'zarr',
+          'kvstore': {
+              'driver': 'memory'
+          },
+      },
+      dtype=ts.uint32,
+      shape=shape,
+      chunk_layout=ts.ChunkLayout(chunk_shape=chunks),
+      create=True)
+
+
+async def test_read_chunks():
+  store = await open_store([5, 6], [3, 4])
+  data = np.arange(30, dtype=np.uint32).reshape(5, 6)
+  await store.write(data)
+
+  origins = []
+  async for domain, array in ts.read_chunks(store, max_buffered_chunks=2):
+    origins.append(domain.origin)
+    assert array.shape == domain.shape
+    np.testing.assert_equal(array, data[domain.index_exp])
+  assert sorted(origins) == [(0, 0), (0, 4), (3, 0), (3, 4)]
+
+
+async def test_read_chunks_labels():
+  store = await open_store([5, 6], [5, 6])
+  store = store[ts.d[:].label['x', 'y']]
+  domains = [domain async for domain, _ in ts.read_chunks(store)]
+  assert len(domains) == 1
+  assert domains[0].labels == ('x', 'y')
+
+
+async def test_read_chunks_anext():
+  store = await open_store([4], [4])
+  it = ts.read_chunks(store)
+  domain, array = await it.__anext__()
+  assert domain == ts.IndexDomain(shape=[4])
+  np.testing.assert_equal(array, [0, 0, 0, 0])
+  with pytest.raises(StopAsyncIteration):
+    await it.__anext__()
+
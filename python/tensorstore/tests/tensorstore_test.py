@@ -58,6 +58,33 @@ async def test_open_array_driver():
     await t.read(order="X")
 
 
+async def test_read_only():
+  t = await ts.open(
+      {
+          "driver": "zarr",
+          "kvstore": "memory://",
+          "metadata": {
+              "shape": [4, 6],
+              "chunks": [2, 3],
+              "dtype": "<i4",
+          }
+      },
+      create=True)
+  await t.write(np.arange(24, dtype=np.int32).reshape(4, 6))
+
+  a = await t[2:4, 3:6].read(read_only=True)
+  assert not a.flags.writeable
+  np.testing.assert_equal(a, [[15, 16, 17], [21, 22, 23]])
+
+  # Reads spanning multiple chunks are copied, but are still read-only.
+  b = await t.read(order="F", read_only=True)
+  assert not b.flags.writeable
+  assert b.flags.fortran
+  np.testing.assert_equal(b, np.arange(24).reshape(4, 6))
+
+  assert (await t.read()).flags.writeable
+
+
 async def test_resize():
   arr = np.asarray([[1, 2, 3], [4, 5, 6], [7, 8, 9]])
   t = await ts.open(
@@ -100,6 +100,15 @@ async def test_transaction_context_manager_commit():
                             dataset.read().result())
 
 
+async def test_transaction_total_bytes():
+  with make_dataset() as dataset:
+    txn = ts.Transaction()
+    assert txn.total_bytes == 0
+    dataset.with_transaction(txn)[1:2, 3:4] = 42
+    assert txn.total_bytes > 0
+    txn.abort()
+
+
 async def test_transaction_context_manager_abort():
   with make_dataset() as dataset:
     with pytest.raises(ValueError, match='want to abort'):
@@ -268,6 +268,21 @@ The transaction remains open until commit starts or it is aborted.  Once commit
 starts or it has been aborted, it may not be used for any additional
 transactional operations.
 
+Group:
+  Accessors
+)");
+
+  cls.def_property_readonly(
+      "total_bytes",
+      [](const TransactionState::CommitPtr& self) {
+        return self->total_bytes();
+      },
+      R"(
+Estimate of the number of bytes of memory currently consumed by the transaction.
+
+This is maintained incrementally as modifications are made, and may be polled
+to monitor memory usage.
+
 Group:
   Accessors
 )");
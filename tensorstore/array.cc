@@ -23,6 +23,7 @@
 #include "riegeli/varint/varint_writing.h"
 #include "tensorstore/box.h"
 #include "tensorstore/data_type_conversion.h"
+#include "tensorstore/internal/compare_same_value_to_scalar.h"
 #include "tensorstore/internal/element_copy_function.h"
 #include "tensorstore/internal/unaligned_data_type_functions.h"
 #include "tensorstore/serialization/serialization.h"
@@ -313,10 +314,42 @@ SharedArray<const void> UnbroadcastArray(
   return new_array;
 }
 
+namespace {
+/// Returns `true` if every element of `array` is at the same address.
+bool IsBroadcastScalar(const OffsetArrayView<const void>& array) {
+  for (DimensionIndex i = 0; i < array.rank(); ++i) {
+    if (array.byte_strides()[i] != 0 && array.shape()[i] != 1) return false;
+  }
+  return true;
+}
+}  // namespace
+
 bool AreArraysSameValueEqual(const OffsetArrayView<const void>& a,
                              const OffsetArrayView<const void>& b) {
   if (a.dtype() != b.dtype()) return false;
   if (a.domain() != b.domain()) return false;
+  if (const DataTypeId id = a.dtype().id(); id != DataTypeId::custom) {
+    // Fast path for comparing to a broadcast scalar, such as a fill value.
+    const OffsetArrayView<const void>* array = nullptr;
+    const OffsetArrayView<const void>* scalar = nullptr;
+    if (IsBroadcastScalar(b)) {
+      array = &a;
+      scalar = &b;
+    } else if (IsBroadcastScalar(a)) {
+      array = &b;
+      scalar = &a;
+    }
+    if (scalar) {
+      return internal::IterateOverArrays(
+                 {&internal::kCompareSameValueToScalarFunctions[static_cast<
+                      size_t>(id)],
+                  const_cast<void*>(
+                      scalar->byte_strided_origin_pointer().get())},
+                 /*status=*/nullptr,
+                 /*constraints=*/skip_repeated_elements, *array)
+          .success;
+    }
+  }
   return internal::IterateOverArrays({&a.dtype()->compare_same_value, nullptr},
                                      /*status=*/nullptr,
                                      /*constraints=*/skip_repeated_elements, a,
@@ -14,7 +14,11 @@
 
 #include "tensorstore/array.h"
 
+#include <algorithm>
+#include <cmath>
 #include <random>
+#include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -1011,6 +1015,72 @@ TEST(ArrayTest, SameValue) {
       MakeArrayView<float>({{NAN, 2, -0.0}, {4, 5, 6}})));
 }
 
+template <typename T>
+SharedArray<const void> BroadcastScalar(T value, Index size) {
+  return BroadcastArray(tensorstore::MakeScalarArray<T>(value),
+                        span<const Index>({size}))
+      .value();
+}
+
+TEST(ArrayTest, SameValueBroadcastScalar) {
+  // Sizes on either side of the block size used for bitwise comparison.
+  for (Index size : {1, 63, 64, 65, 1000}) {
+    SCOPED_TRACE(StrCat("size=", size));
+    auto array = tensorstore::AllocateArray<int32_t>({size});
+    std::fill_n(array.data(), size, 7);
+    auto seven = BroadcastScalar<int32_t>(7, size);
+    auto eight = BroadcastScalar<int32_t>(8, size);
+    EXPECT_TRUE(AreArraysSameValueEqual(array, seven));
+    EXPECT_TRUE(AreArraysSameValueEqual(seven, array));
+    EXPECT_FALSE(AreArraysSameValueEqual(array, eight));
+    array(size - 1) = 8;
+    EXPECT_EQ(size == 1, AreArraysSameValueEqual(array, eight));
+    EXPECT_FALSE(AreArraysSameValueEqual(array, seven));
+  }
+}
+
+TEST(ArrayTest, SameValueBroadcastScalarFloat) {
+  auto array = tensorstore::AllocateArray<float>({100});
+  std::fill_n(array.data(), 100, std::nanf("1"));
+  // NaN values with different bit representations are equal.
+  EXPECT_TRUE(AreArraysSameValueEqual(
+      array, BroadcastScalar<float>(std::nanf("2"), 100)));
+  std::fill_n(array.data(), 100, +0.0f);
+  auto positive_zero = BroadcastScalar<float>(+0.0f, 100);
+  EXPECT_TRUE(AreArraysSameValueEqual(array, positive_zero));
+  array(50) = -0.0f;
+  EXPECT_FALSE(AreArraysSameValueEqual(array, positive_zero));
+}
+
+TEST(ArrayTest, SameValueBroadcastScalarComplex) {
+  using T = tensorstore::complex128_t;
+  auto array = tensorstore::AllocateArray<T>({100});
+  std::fill_n(array.data(), 100, T(1, 2));
+  auto fill = BroadcastScalar<T>(T(1, 2), 100);
+  EXPECT_TRUE(AreArraysSameValueEqual(array, fill));
+  array(99) = T(1, 3);
+  EXPECT_FALSE(AreArraysSameValueEqual(array, fill));
+}
+
+TEST(ArrayTest, SameValueBroadcastScalarString) {
+  auto array = MakeArray<std::string>({"abc", "abc", "abc"});
+  auto fill = BroadcastScalar<std::string>("abc", 3);
+  EXPECT_TRUE(AreArraysSameValueEqual(array, fill));
+  array(1) = "abd";
+  EXPECT_FALSE(AreArraysSameValueEqual(array, fill));
+}
+
+TEST(ArrayTest, SameValueBroadcastScalarStrided) {
+  std::vector<int32_t> data(200);
+  for (size_t i = 0; i < data.size(); ++i) data[i] = (i % 2) ? 1 : 5;
+  // Every other element.
+  ArrayView<int32_t> array(data.data(), StridedLayout<1>({100}, {8}));
+  auto fill = BroadcastScalar<int32_t>(5, 100);
+  EXPECT_TRUE(AreArraysSameValueEqual(array, fill));
+  data[198] = 6;
+  EXPECT_FALSE(AreArraysSameValueEqual(array, fill));
+}
+
 TEST(CopyArrayTest, ZeroOrigin) {
   int arr[2][3] = {{1, 2, 3}, {4, 5, 6}};
   auto arr_ref = MakeArrayView(arr);
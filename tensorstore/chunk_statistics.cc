@@ -0,0 +1,222 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/chunk_statistics.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "absl/status/status.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/data_type_conversion.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/elementwise_function.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_array.h"
+#include "tensorstore/util/iterate_over_index_range.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+constexpr int kNumBloomFilterHashes = 3;
+
+/// Returns a 64-bit hash of `value` that is stable across processes.
+///
+/// Uses the SplitMix64 finalizer on the bit representation, with `-0.0`
+/// normalized to `0.0` so that equal values hash equally.
+uint64_t HashValue(double value) {
+  if (value == 0) value = 0;
+  uint64_t x;
+  std::memcpy(&x, &value, sizeof(x));
+  x += 0x9e3779b97f4a7c15;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+  return x ^ (x >> 31);
+}
+
+/// Invokes `f(word, bit_mask)` for each of the Bloom filter bits for `value`.
+template <typename Func>
+void ForEachBloomFilterBit(double value, size_t num_words, Func f) {
+  const uint64_t hash = HashValue(value);
+  const uint64_t h1 = hash & 0xffffffff;
+  const uint64_t h2 = (hash >> 32) | 1;
+  const uint64_t num_bits = num_words * 64;
+  for (int i = 0; i < kNumBloomFilterHashes; ++i) {
+    const uint64_t bit = (h1 + i * h2) % num_bits;
+    f(bit / 64, uint64_t(1) << (bit % 64));
+  }
+}
+
+/// Binder for the `min` and `max` bounds.  Infinite bounds, which indicate that
+/// there are no non-NaN values, have no JSON representation and are omitted.
+constexpr auto InfiniteDefaultBinder(double sign) {
+  return jb::DefaultValue<jb::kNeverIncludeDefaults>([sign](double* v) {
+    *v = sign * std::numeric_limits<double>::infinity();
+  });
+}
+
+}  // namespace
+
+TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
+    ChunkStatisticsOptions,
+    jb::Object(jb::Member(
+        "bloom_filter_bits",
+        jb::Projection(&ChunkStatisticsOptions::bloom_filter_bits,
+                       jb::DefaultInitializedValue(jb::Integer<Index>(
+                           0, std::numeric_limits<int32_t>::max()))))))
+
+TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
+    ChunkStatistics,
+    jb::Object(
+        jb::Member("num_elements",
+                   jb::Projection(&ChunkStatistics::num_elements,
+                                  jb::Integer<Index>(0))),
+        jb::Member("non_fill_count",
+                   jb::Projection(&ChunkStatistics::non_fill_count,
+                                  jb::Integer<Index>(0))),
+        jb::Member("min", jb::Projection(&ChunkStatistics::min,
+                                         InfiniteDefaultBinder(1))),
+        jb::Member("max", jb::Projection(&ChunkStatistics::max,
+                                         InfiniteDefaultBinder(-1))),
+        jb::Member("bloom_filter",
+                   jb::Projection(&ChunkStatistics::bloom_filter,
+                                  jb::DefaultInitializedValue<
+                                      jb::kNeverIncludeDefaults>()))))
+
+bool ChunkStatistics::MayContain(double value) const {
+  if (std::isnan(value)) return true;
+  if (value < min || value > max) return false;
+  if (bloom_filter.empty()) return true;
+  bool found = true;
+  ForEachBloomFilterBit(value, bloom_filter.size(),
+                        [&](size_t word, uint64_t mask) {
+                          if (!(bloom_filter[word] & mask)) found = false;
+                        });
+  return found;
+}
+
+bool operator==(const ChunkStatistics& a, const ChunkStatistics& b) {
+  return a.num_elements == b.num_elements &&
+         a.non_fill_count == b.non_fill_count && a.min == b.min &&
+         a.max == b.max && a.bloom_filter == b.bloom_filter;
+}
+
+std::ostream& operator<<(std::ostream& os, const ChunkStatistics& x) {
+  return os << jb::ToJson(x).value();
+}
+
+bool MayMatch(const ChunkStatistics& stats, const ChunkStatisticsQuery& query) {
+  if (query.non_fill && stats.non_fill_count == 0) return false;
+  if (query.min_value && !(stats.max >= *query.min_value)) return false;
+  if (query.max_value && !(stats.min <= *query.max_value)) return false;
+  if (query.contains_value && !stats.MayContain(*query.contains_value)) {
+    return false;
+  }
+  return true;
+}
+
+namespace internal {
+
+Result<ChunkStatistics> ComputeChunkStatistics(
+    SharedArrayView<const void> array, SharedArrayView<const void> fill_value,
+    const ChunkStatisticsOptions& options) {
+  ChunkStatistics stats;
+  stats.num_elements = array.num_elements();
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto converter,
+      GetDataTypeConverterOrError(array.dtype(), dtype_v<double>));
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto broadcast_fill_value,
+      BroadcastArray(std::move(fill_value), array.shape()));
+  if (options.bloom_filter_bits > 0) {
+    stats.bloom_filter.resize((options.bloom_filter_bits + 63) / 64);
+  }
+  if (stats.num_elements == 0) return stats;
+
+  // The array is processed in place, one row along the last dimension at a
+  // time, so that only a single row is converted to `double` at once.
+  const DimensionIndex rank = array.rank();
+  const DimensionIndex outer_rank = std::max(DimensionIndex(0), rank - 1);
+  const Index row_size = rank == 0 ? 1 : array.shape()[rank - 1];
+  const Index array_stride = rank == 0 ? 0 : array.byte_strides()[rank - 1];
+  const Index fill_stride =
+      rank == 0 ? 0 : broadcast_fill_value.byte_strides()[rank - 1];
+  const Index element_size = array.dtype()->size;
+  std::vector<double> values(row_size);
+  absl::Status status;
+  IterateOverIndexRange(
+      span<const Index>(array.shape().data(), outer_rank),
+      [&](span<const Index> indices) {
+        Index array_offset = 0, fill_offset = 0;
+        for (DimensionIndex i = 0; i < outer_rank; ++i) {
+          array_offset += indices[i] * array.byte_strides()[i];
+          fill_offset += indices[i] * broadcast_fill_value.byte_strides()[i];
+        }
+        const char* a = static_cast<const char*>(array.data()) + array_offset;
+        const char* b =
+            static_cast<const char*>(broadcast_fill_value.data()) +
+            fill_offset;
+        if ((*converter.closure.function)[IterationBufferKind::kStrided](
+                converter.closure.context, row_size,
+                IterationBufferPointer(const_cast<char*>(a), array_stride),
+                IterationBufferPointer(values.data(), sizeof(double)),
+                &status) != row_size) {
+          if (status.ok()) {
+            status = absl::InvalidArgumentError(
+                tensorstore::StrCat("Failed to convert ", array.dtype(),
+                                    " value to ", dtype_v<double>));
+          }
+          return false;
+        }
+        for (Index i = 0; i < row_size; ++i) {
+          // Compare the original representations rather than the converted
+          // values, so that distinct 64-bit integers that round to the same
+          // `double` are not counted as equal to the fill value.
+          if (std::memcmp(a + i * array_stride, b + i * fill_stride,
+                          element_size) != 0) {
+            ++stats.non_fill_count;
+          }
+          const double value = values[i];
+          if (std::isnan(value)) continue;
+          stats.min = std::min(stats.min, value);
+          stats.max = std::max(stats.max, value);
+          if (!stats.bloom_filter.empty()) {
+            ForEachBloomFilterBit(value, stats.bloom_filter.size(),
+                                  [&](size_t word, uint64_t mask) {
+                                    stats.bloom_filter[word] |= mask;
+                                  });
+          }
+        }
+        return true;
+      });
+  TENSORSTORE_RETURN_IF_ERROR(status);
+  return stats;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,144 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_CHUNK_STATISTICS_H_
+#define TENSORSTORE_CHUNK_STATISTICS_H_
+
+/// \file
+/// Per-chunk statistics used to skip chunks that cannot match a query.
+
+#include <stdint.h>
+
+#include <iosfwd>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "tensorstore/array.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/json_serialization_options.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+
+/// Specifies how per-chunk statistics are computed.
+///
+/// Statistics are only maintained by a driver if this is specified, via the
+/// ``"chunk_statistics"`` spec member.
+///
+/// \relates ChunkStatistics
+struct ChunkStatisticsOptions {
+  /// Number of bits in the Bloom filter of element values stored with the
+  /// statistics of each chunk.  Rounded up to a multiple of 64.  A value of 0
+  /// disables the Bloom filter.
+  Index bloom_filter_bits = 0;
+
+  TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(ChunkStatisticsOptions,
+                                          JsonSerializationOptions,
+                                          JsonSerializationOptions)
+
+  friend bool operator==(const ChunkStatisticsOptions& a,
+                         const ChunkStatisticsOptions& b) {
+    return a.bloom_filter_bits == b.bloom_filter_bits;
+  }
+  friend bool operator!=(const ChunkStatisticsOptions& a,
+                         const ChunkStatisticsOptions& b) {
+    return !(a == b);
+  }
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.bloom_filter_bits);
+  };
+};
+
+/// Summary of the values of a single chunk.
+///
+/// All element values are converted to `double`.  Conversion is monotonic, so
+/// `min` and `max` are conservative bounds even for 64-bit integer values that
+/// are not exactly representable.
+struct ChunkStatistics {
+  /// Total number of elements in the chunk.
+  Index num_elements = 0;
+
+  /// Number of elements not equal to the fill value.
+  Index non_fill_count = 0;
+
+  /// Minimum and maximum element value, ignoring NaN values.  If there are no
+  /// non-NaN values, `min > max`.
+  double min = std::numeric_limits<double>::infinity();
+  double max = -std::numeric_limits<double>::infinity();
+
+  /// Bloom filter of the element values, or empty if disabled.
+  std::vector<uint64_t> bloom_filter;
+
+  /// Returns `false` if the chunk definitely does not contain `value`.
+  bool MayContain(double value) const;
+
+  TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(ChunkStatistics,
+                                          JsonSerializationOptions,
+                                          JsonSerializationOptions)
+
+  friend bool operator==(const ChunkStatistics& a, const ChunkStatistics& b);
+  friend bool operator!=(const ChunkStatistics& a, const ChunkStatistics& b) {
+    return !(a == b);
+  }
+  friend std::ostream& operator<<(std::ostream& os, const ChunkStatistics& x);
+};
+
+/// Predicate on the values of a chunk, evaluated against `ChunkStatistics`.
+///
+/// A chunk matches if all specified conditions may hold.
+///
+/// \relates ChunkStatistics
+struct ChunkStatisticsQuery {
+  /// If specified, matches only chunks that may contain a value greater than
+  /// or equal to `min_value`.
+  std::optional<double> min_value;
+
+  /// If specified, matches only chunks that may contain a value less than or
+  /// equal to `max_value`.
+  std::optional<double> max_value;
+
+  /// If specified, matches only chunks that may contain this value, using
+  /// the Bloom filter if available.
+  std::optional<double> contains_value;
+
+  /// If `true`, matches only chunks containing at least one element not equal
+  /// to the fill value.
+  bool non_fill = false;
+};
+
+/// Returns `false` if `stats` rules out `query`.
+///
+/// \relates ChunkStatistics
+bool MayMatch(const ChunkStatistics& stats, const ChunkStatisticsQuery& query);
+
+namespace internal {
+
+/// Computes the statistics of `array`.
+///
+/// \param array The chunk data.
+/// \param fill_value The fill value, broadcastable to `array.shape()`.
+/// \param options Specifies the Bloom filter size.
+/// \error `absl::StatusCode::kInvalidArgument` if `array.dtype()` cannot be
+///     converted to `double`.
+Result<ChunkStatistics> ComputeChunkStatistics(
+    SharedArrayView<const void> array, SharedArrayView<const void> fill_value,
+    const ChunkStatisticsOptions& options);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_CHUNK_STATISTICS_H_
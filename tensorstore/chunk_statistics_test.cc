@@ -0,0 +1,336 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/chunk_statistics.h"
+
+#include <stdint.h>
+
+#include <cmath>
+#include <limits>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/json_gtest.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/open.h"
+#include "tensorstore/strided_layout.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Box;
+using ::tensorstore::ChunkStatistics;
+using ::tensorstore::ChunkStatisticsOptions;
+using ::tensorstore::ChunkStatisticsQuery;
+using ::tensorstore::Context;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MakeScalarArray;
+using ::tensorstore::MatchesJson;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::MayMatch;
+using ::tensorstore::internal::ComputeChunkStatistics;
+using ::testing::ElementsAre;
+using ::testing::Optional;
+using ::testing::UnorderedElementsAre;
+
+TEST(ComputeChunkStatisticsTest, Basic) {
+  ChunkStatisticsOptions options;
+  options.bloom_filter_bits = 128;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stats,
+      ComputeChunkStatistics(MakeArray<int32_t>({{0, 5, 0}, {-3, 0, 7}}),
+                             MakeScalarArray<int32_t>(0), options));
+  EXPECT_EQ(6, stats.num_elements);
+  EXPECT_EQ(3, stats.non_fill_count);
+  EXPECT_EQ(-3, stats.min);
+  EXPECT_EQ(7, stats.max);
+  EXPECT_EQ(2, stats.bloom_filter.size());
+  for (double value : {0, 5, -3, 7}) {
+    EXPECT_TRUE(stats.MayContain(value)) << value;
+  }
+  EXPECT_FALSE(stats.MayContain(8));
+  EXPECT_FALSE(stats.MayContain(-4));
+}
+
+TEST(ComputeChunkStatisticsTest, NaN) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stats,
+      ComputeChunkStatistics(
+          MakeArray<float>({std::numeric_limits<float>::quiet_NaN(), 2.5f}),
+          MakeScalarArray<float>(2.5f), {}));
+  EXPECT_EQ(1, stats.non_fill_count);
+  EXPECT_EQ(2.5, stats.min);
+  EXPECT_EQ(2.5, stats.max);
+  EXPECT_TRUE(stats.bloom_filter.empty());
+}
+
+TEST(ComputeChunkStatisticsTest, AllFill) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stats, ComputeChunkStatistics(MakeArray<uint8_t>({1, 1, 1}),
+                                         MakeArray<uint8_t>({1, 1, 1}), {}));
+  EXPECT_EQ(0, stats.non_fill_count);
+}
+
+TEST(ComputeChunkStatisticsTest, Strided) {
+  auto array = MakeArray<int32_t>({0, 5, 0, 9, -3, 0, 7, 0});
+  // Transposed view of every other element: `{{0, -3}, {0, 7}}`.
+  tensorstore::SharedArray<const void> strided(
+      array.element_pointer(),
+      tensorstore::StridedLayout<>({2, 2}, {2 * sizeof(int32_t),
+                                            4 * sizeof(int32_t)}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stats,
+      ComputeChunkStatistics(strided, MakeScalarArray<int32_t>(0), {}));
+  EXPECT_EQ(4, stats.num_elements);
+  EXPECT_EQ(2, stats.non_fill_count);
+  EXPECT_EQ(-3, stats.min);
+  EXPECT_EQ(7, stats.max);
+}
+
+TEST(ComputeChunkStatisticsTest, Scalar) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stats, ComputeChunkStatistics(MakeScalarArray<int32_t>(5),
+                                         MakeScalarArray<int32_t>(0), {}));
+  EXPECT_EQ(1, stats.num_elements);
+  EXPECT_EQ(1, stats.non_fill_count);
+  EXPECT_EQ(5, stats.min);
+  EXPECT_EQ(5, stats.max);
+}
+
+TEST(ComputeChunkStatisticsTest, UnsupportedDataType) {
+  EXPECT_THAT(
+      ComputeChunkStatistics(MakeArray<std::string>({"a"}),
+                             MakeScalarArray<std::string>(""), {}),
+      MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(MayMatchTest, Basic) {
+  ChunkStatistics stats;
+  stats.num_elements = 10;
+  stats.non_fill_count = 2;
+  stats.min = 1;
+  stats.max = 5;
+  EXPECT_TRUE(MayMatch(stats, {}));
+
+  ChunkStatisticsQuery query;
+  query.min_value = 5;
+  EXPECT_TRUE(MayMatch(stats, query));
+  query.min_value = 6;
+  EXPECT_FALSE(MayMatch(stats, query));
+
+  query = {};
+  query.max_value = 1;
+  EXPECT_TRUE(MayMatch(stats, query));
+  query.max_value = 0;
+  EXPECT_FALSE(MayMatch(stats, query));
+
+  query = {};
+  query.contains_value = 3;
+  EXPECT_TRUE(MayMatch(stats, query));
+  query.contains_value = 6;
+  EXPECT_FALSE(MayMatch(stats, query));
+
+  query = {};
+  query.non_fill = true;
+  EXPECT_TRUE(MayMatch(stats, query));
+  stats.non_fill_count = 0;
+  EXPECT_FALSE(MayMatch(stats, query));
+}
+
+TEST(ChunkStatisticsTest, JsonRoundTrip) {
+  ChunkStatistics stats;
+  stats.num_elements = 4;
+  stats.non_fill_count = 1;
+  stats.min = 0;
+  stats.max = 3.5;
+  stats.bloom_filter = {1, 0x8000000000000000};
+  auto json = stats.ToJson();
+  EXPECT_THAT(json, Optional(MatchesJson({
+                        {"num_elements", 4},
+                        {"non_fill_count", 1},
+                        {"min", 0.0},
+                        {"max", 3.5},
+                        {"bloom_filter", {1u, 0x8000000000000000u}},
+                    })));
+  EXPECT_THAT(ChunkStatistics::FromJson(*json), Optional(stats));
+
+  // Infinite bounds and an empty Bloom filter are omitted.
+  ChunkStatistics empty_stats;
+  EXPECT_THAT(empty_stats.ToJson(),
+              Optional(MatchesJson(
+                  {{"num_elements", 0}, {"non_fill_count", 0}})));
+  EXPECT_THAT(ChunkStatistics::FromJson(*empty_stats.ToJson()),
+              Optional(empty_stats));
+}
+
+TEST(ChunkStatisticsOptionsTest, Json) {
+  EXPECT_THAT(ChunkStatisticsOptions::FromJson({{"bloom_filter_bits", 64}}),
+              Optional(ChunkStatisticsOptions{64}));
+  EXPECT_THAT(ChunkStatisticsOptions::FromJson(::nlohmann::json::object_t()),
+              Optional(ChunkStatisticsOptions{0}));
+  EXPECT_THAT(ChunkStatisticsOptions::FromJson({{"bloom_filter_bits", -1}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+::nlohmann::json GetSpec(bool chunk_statistics) {
+  ::nlohmann::json spec{
+      {"driver", "zarr"},
+      {"kvstore", {{"driver", "memory"}}},
+      {"metadata",
+       {{"dtype", "<u2"}, {"shape", {4, 4}}, {"chunks", {2, 2}}}},
+  };
+  if (chunk_statistics) {
+    spec["chunk_statistics"] = {{"bloom_filter_bits", 256}};
+  }
+  return spec;
+}
+
+TEST(FindChunksTest, Zarr) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec(true), context,
+                        tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint16_t>({{0, 0, 0, 0},
+                                              {0, 5, 0, 0},
+                                              {0, 0, 0, 0},
+                                              {0, 0, 0, 100}}),
+                         store)
+          .result());
+
+  const Box<> chunk00({0, 0}, {2, 2}), chunk01({0, 2}, {2, 2}),
+      chunk10({2, 0}, {2, 2}), chunk11({2, 2}, {2, 2});
+
+  EXPECT_THAT(tensorstore::FindChunks(store).result(),
+              Optional(ElementsAre(chunk00, chunk01, chunk10, chunk11)));
+
+  ChunkStatisticsQuery query;
+  query.non_fill = true;
+  EXPECT_THAT(tensorstore::FindChunks(store, query).result(),
+              Optional(ElementsAre(chunk00, chunk11)));
+
+  query = {};
+  query.min_value = 50;
+  EXPECT_THAT(tensorstore::FindChunks(store, query).result(),
+              Optional(ElementsAre(chunk11)));
+
+  query = {};
+  query.contains_value = 5;
+  EXPECT_THAT(tensorstore::FindChunks(store, query).result(),
+              Optional(ElementsAre(chunk00)));
+
+  // Chunks are clipped to the domain of the store.
+  query = {};
+  query.non_fill = true;
+  EXPECT_THAT(
+      tensorstore::FindChunks(
+          store | tensorstore::Dims(0, 1).SizedInterval({1, 1}, {2, 3}), query)
+          .result(),
+      Optional(ElementsAre(Box<>({1, 1}, {1, 1}), Box<>({2, 2}, {1, 2}))));
+
+  query = {};
+  query.contains_value = 1;
+  EXPECT_THAT(tensorstore::FindChunks(store, query).result(),
+              Optional(ElementsAre()));
+
+  // Modifying a chunk through a TensorStore that does not maintain statistics
+  // invalidates the stored statistics.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store_without_statistics,
+      tensorstore::Open(GetSpec(false), context, tensorstore::OpenMode::open)
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeScalarArray<uint16_t>(1),
+                         store_without_statistics |
+                             tensorstore::Dims(0, 1).IndexSlice({3, 3}))
+          .result());
+  EXPECT_THAT(tensorstore::FindChunks(store, query).result(),
+              Optional(ElementsAre(chunk11)));
+}
+
+TEST(FindChunksTest, DeletedChunk) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec(true), context,
+                        tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint16_t>({{1, 0, 0, 0},
+                                              {0, 0, 0, 0},
+                                              {0, 0, 0, 0},
+                                              {0, 0, 0, 2}}),
+                         store)
+          .result());
+
+  // Overwriting a chunk with the fill value deletes the chunk along with its
+  // statistics; the missing chunk is then known to contain only fill.
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeScalarArray<uint16_t>(0),
+                         store | tensorstore::Dims(0, 1).IndexSlice({0, 0}))
+          .result());
+  ChunkStatisticsQuery query;
+  query.non_fill = true;
+  EXPECT_THAT(tensorstore::FindChunks(store, query).result(),
+              Optional(ElementsAre(Box<>({2, 2}, {2, 2}))));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto kvs, tensorstore::kvstore::Open({{"driver", "memory"}}, context)
+                    .result());
+  EXPECT_THAT(tensorstore::kvstore::ListFuture(kvs).result(),
+              Optional(UnorderedElementsAre(".zarray", "1.1",
+                                            ".chunk_statistics/1.1")));
+}
+
+TEST(FindChunksTest, StatisticsNotEnabled) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec(false), context,
+                        tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeScalarArray<uint16_t>(0), store).result());
+  ChunkStatisticsQuery query;
+  query.non_fill = true;
+  EXPECT_THAT(tensorstore::FindChunks(store, query).result(),
+              Optional(ElementsAre(Box<>({0, 0}, {2, 2}), Box<>({0, 2}, {2, 2}),
+                                   Box<>({2, 0}, {2, 2}),
+                                   Box<>({2, 2}, {2, 2}))));
+}
+
+TEST(FindChunksTest, SpecRoundTrip) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec(true), context,
+                        tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec, store.spec());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto json, spec.ToJson());
+  EXPECT_EQ(::nlohmann::json({{"bloom_filter_bits", 256}}),
+            json["chunk_statistics"]);
+}
+
+}  // namespace
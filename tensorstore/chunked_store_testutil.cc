@@ -0,0 +1,49 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/chunked_store_testutil.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace tensorstore {
+namespace internal {
+
+TensorStore<> OpenChunkedTestStore(const Context& context, std::string dtype,
+                                   std::vector<Index> shape,
+                                   std::vector<Index> chunks,
+                                   ::nlohmann::json::object_t metadata) {
+  metadata["dtype"] = std::move(dtype);
+  metadata["shape"] = std::move(shape);
+  metadata["chunks"] = std::move(chunks);
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto store, tensorstore::Open({{"driver", "zarr"},
+                                     {"kvstore", {{"driver", "memory"}}},
+                                     {"metadata", std::move(metadata)}},
+                                    context, tensorstore::OpenMode::create)
+                      .result());
+  return store;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,48 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_CHUNKED_STORE_TESTUTIL_H_
+#define TENSORSTORE_CHUNKED_STORE_TESTUTIL_H_
+
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/tensorstore.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Creates a new chunked in-memory TensorStore for use by tests.
+///
+/// The store uses the zarr driver with a `memory` kvstore.
+///
+/// \param context Context in which to open the store.
+/// \param dtype Zarr data type, e.g. `"<u2"`.
+/// \param shape Shape of the array.
+/// \param chunks Chunk shape.
+/// \param metadata Additional zarr metadata members, e.g.
+///     `{{"compressor", nullptr}}`.
+/// Terminates the process if the store cannot be created.
+TensorStore<> OpenChunkedTestStore(const Context& context, std::string dtype,
+                                   std::vector<Index> shape,
+                                   std::vector<Index> chunks,
+                                   ::nlohmann::json::object_t metadata = {});
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_CHUNKED_STORE_TESTUTIL_H_
@@ -23,15 +23,20 @@
 /// Typically, a transform from a known index space to this "cell domain" is
 /// provided along with the ReadChunk/WriteChunk object.
 
+#include <functional>
 #include <mutex>
+#include <type_traits>
 
 #include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "tensorstore/array.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/internal/arena.h"
 #include "tensorstore/internal/lock_collection.h"
 #include "tensorstore/internal/nditerable.h"
 #include "tensorstore/internal/poly/poly.h"
+#include "tensorstore/kvstore/generation.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
@@ -41,6 +46,19 @@ namespace internal {
 
 struct ReadChunk {
   struct BeginRead {};
+  struct GetSharedArray {};
+  struct GetGeneration {};
+  struct GetGenerationValidator {};
+
+  /// Reads the generation of the stored data of a chunk, without reading the
+  /// data if its generation equals `if_not_equal`.
+  ///
+  /// The returned generation is the generation of the stored data, even if it
+  /// has changed since the chunk was read.
+  using GenerationValidator =
+      std::function<Future<TimestampedStorageGeneration>(
+          StorageGeneration if_not_equal, absl::Time staleness_bound)>;
+
   using Impl = poly::Poly<
       sizeof(void*) * 2,
       /*Copyable=*/true,  //
@@ -66,7 +84,46 @@ struct ReadChunk {
       /// \returns An NDIterable with a shape of
       ///     `chunk_transform.input_shape()`.
       Result<NDIterable::Ptr>(BeginRead, IndexTransform<> chunk_transform,
-                              Arena* arena)>;
+                              Arena* arena),
+
+      /// Returns a read-only array that directly references the chunk data,
+      /// without copying.
+      ///
+      /// No locks are held when this function is called.  The returned array
+      /// shares ownership of the data, which must not be modified for as long
+      /// as a reference to it exists.
+      ///
+      /// Chunk implementations that do not support this operation need not
+      /// define it, as a default implementation that always returns a null
+      /// array is provided below.
+      ///
+      /// \param chunk_transform Transform with a range that is a subset of
+      ///     `transform`.
+      /// \returns An array with a domain of `chunk_transform.domain()`, or a
+      ///     null array if the data cannot be referenced without copying.
+      Result<SharedOffsetArray<const void>>(GetSharedArray,
+                                            IndexTransform<> chunk_transform),
+
+      /// Returns the generation of the stored data provided by this chunk.
+      ///
+      /// No locks are held when this function is called.
+      ///
+      /// Chunk implementations that do not track generations need not define
+      /// it, as a default implementation that always returns
+      /// `StorageGeneration::Unknown()` is provided below.
+      StorageGeneration(GetGeneration),
+
+      /// Returns a function that checks whether the stored data provided by
+      /// this chunk has changed, or a null function if this cannot be done
+      /// without reading the chunk again.
+      ///
+      /// The returned function may be retained and called after this chunk is
+      /// destroyed.  No locks are held when this function is called.
+      ///
+      /// Chunk implementations that do not support this operation need not
+      /// define it, as a default implementation that always returns a null
+      /// function is provided below.
+      GenerationValidator(GetGenerationValidator)>;
 
   /// Type-erased chunk implementation.  In the case of the chunks produced by
   /// `ChunkCache::Read`, for example, the contained object holds a
@@ -78,6 +135,35 @@ struct ReadChunk {
   IndexTransform<> transform;
 };
 
+/// Default implementation of the `ReadChunk::GetSharedArray` operation, used
+/// for chunk implementations that do not define it.
+template <typename Self>
+std::enable_if_t<!std::is_invocable_v<Self&, ReadChunk::GetSharedArray,
+                                      IndexTransform<>>,
+                 Result<SharedOffsetArray<const void>>>
+PolyApply(Self&, ReadChunk::GetSharedArray, IndexTransform<>) {
+  return SharedOffsetArray<const void>();
+}
+
+/// Default implementation of the `ReadChunk::GetGeneration` operation, used
+/// for chunk implementations that do not define it.
+template <typename Self>
+std::enable_if_t<!std::is_invocable_v<Self&, ReadChunk::GetGeneration>,
+                 StorageGeneration>
+PolyApply(Self&, ReadChunk::GetGeneration) {
+  return StorageGeneration::Unknown();
+}
+
+/// Default implementation of the `ReadChunk::GetGenerationValidator`
+/// operation, used for chunk implementations that do not define it.
+template <typename Self>
+std::enable_if_t<
+    !std::is_invocable_v<Self&, ReadChunk::GetGenerationValidator>,
+    ReadChunk::GenerationValidator>
+PolyApply(Self&, ReadChunk::GetGenerationValidator) {
+  return {};
+}
+
 struct WriteChunk {
   struct BeginWrite {};
   struct EndWrite {};
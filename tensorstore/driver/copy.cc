@@ -19,6 +19,8 @@
 #include <utility>
 
 #include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/data_type_conversion.h"
 #include "tensorstore/driver/chunk.h"
@@ -35,6 +37,7 @@
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/internal/type_traits.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/read_write_options.h"
@@ -136,6 +139,7 @@ struct CopyState : public internal::AtomicReferenceCount<CopyState> {
   internal::OpenTransactionPtr target_transaction;
   IndexTransform<> target_transform;
   DomainAlignmentOptions alignment_options;
+  IoStatisticsPtr io_statistics;
   Promise<void> copy_promise;
   Promise<void> commit_promise;
   IntrusivePtr<CommitState> commit_state{new CommitState};
@@ -158,6 +162,8 @@ struct CopyChunkOp {
 
     absl::Status copy_status;
     Future<const void> commit_future;
+    const absl::Time start_time =
+        state->io_statistics ? absl::Now() : absl::InfinitePast();
     {
       TENSORSTORE_ASSIGN_OR_RETURN(
           auto guard,
@@ -195,6 +201,9 @@ struct CopyChunkOp {
         copy_status = std::move(end_write_result.copy_status);
       }
     }
+    if (state->io_statistics) {
+      state->io_statistics->RecordCopyTime(absl::Now() - start_time);
+    }
     if (copy_status.ok()) {
       const Index num_elements = write_chunk.transform.domain().num_elements();
       state->commit_state->UpdateCopyProgress(num_elements);
@@ -248,6 +257,7 @@ struct CopyWriteChunkReceiver {
     // Defer the actual copying to the executor.
     //
     // Don't move `state` since `set_value` may be called multiple times.
+    if (state->io_statistics) state->io_statistics->RecordChunk();
     state->executor(CopyChunkOp{state, std::move(adjusted_read_chunk),
                                 std::move(write_chunk)});
   }
@@ -272,6 +282,8 @@ struct CopyInitiateWriteOp {
 
     // Initiate a write for the portion of the target TensorStore
     // corresponding to this source `chunk`.
+    internal::ScopedIoStatistics scoped_io_statistics(
+        state->io_statistics.get());
     state->target_driver->Write(
         state->target_transaction, std::move(write_transform),
         CopyWriteChunkReceiver{state, std::move(chunk)});
@@ -326,6 +338,8 @@ struct DriverCopyInitiateOp {
     // Initiate the read operation on the source driver.
     auto source_driver = std::move(state->source_driver);
     auto source_transaction = std::move(state->source_transaction);
+    internal::ScopedIoStatistics scoped_io_statistics(
+        state->io_statistics.get());
     source_driver->Read(std::move(source_transaction),
                         std::move(source_transform),
                         CopyReadChunkReceiver{std::move(state)});
@@ -357,6 +371,7 @@ WriteFutures DriverCopy(Executor executor, DriverHandle source,
       internal::AcquireOpenTransactionPtrOrError(target.transaction));
   state->alignment_options = options.alignment_options;
   state->commit_state->progress_function = std::move(options.progress_function);
+  state->io_statistics = std::move(options.io_statistics);
   auto copy_pair = PromiseFuturePair<void>::Make(MakeResult());
   PromiseFuturePair<void> commit_pair;
   if (!state->target_transaction) {
@@ -390,7 +405,10 @@ WriteFutures DriverCopy(DriverHandle source, DriverHandle target,
       std::move(executor), std::move(source), std::move(target),
       /*options=*/
       {/*.progress_function=*/std::move(options.progress_function),
-       /*.alignment_options=*/options.alignment_options});
+       /*.alignment_options=*/options.alignment_options,
+       /*.data_type_conversion_flags=*/
+       DataTypeConversionFlags::kSafeAndImplicit,
+       /*.io_statistics=*/std::move(options.io_statistics)});
 }
 
 }  // namespace internal
@@ -18,6 +18,7 @@
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/driver_handle.h"
 #include "tensorstore/index_space/alignment.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/util/executor.h"
@@ -39,6 +40,9 @@ struct DriverCopyOptions {
 
   DataTypeConversionFlags data_type_conversion_flags =
       DataTypeConversionFlags::kSafeAndImplicit;
+
+  /// Optional sink for the I/O statistics of the copy.
+  IoStatisticsPtr io_statistics;
 };
 
 /// Copies data between two TensorStore drivers.
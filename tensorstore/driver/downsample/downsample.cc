@@ -14,10 +14,19 @@
 
 #include "tensorstore/driver/downsample/downsample.h"
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/driver/downsample/downsample_array.h"
 #include "tensorstore/driver/downsample/downsample_method_json_binder.h"
 #include "tensorstore/driver/downsample/downsample_nditerable.h"
@@ -30,13 +39,26 @@
 #include "tensorstore/index_space/dim_expression.h"
 #include "tensorstore/index_space/index_domain_builder.h"
 #include "tensorstore/index_space/index_transform_builder.h"
+#include "tensorstore/internal/cache/cache_pool_resource.h"
+#include "tensorstore/internal/cache/chunk_cache.h"
+#include "tensorstore/internal/cache_key/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/internal/cache_key/cache_key.h"
+#include "tensorstore/internal/cache_key/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/internal/cache_key/std_vector.h"  // IWYU pragma: keep
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/staleness_bound.h"
 #include "tensorstore/internal/json_binding/std_array.h"
+#include "tensorstore/internal/json_binding/std_optional.h"
 #include "tensorstore/internal/nditerable_transformed_array.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/serialization/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/serialization/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/serialization/std_vector.h"  // IWYU pragma: keep
 #include "tensorstore/spec.h"
+#include "tensorstore/staleness_bound.h"
 #include "tensorstore/util/execution/any_receiver.h"
 #include "tensorstore/util/execution/sender_util.h"
+#include "tensorstore/util/garbage_collection/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/util/garbage_collection/std_vector.h"  // IWYU pragma: keep
 
 namespace tensorstore {
@@ -103,9 +125,18 @@ class DownsampleDriverSpec
   std::vector<Index> downsample_factors;
   DownsampleMethod downsample_method;
 
+  /// If specified, downsampled chunks are cached in this pool rather than
+  /// being recomputed from `base` on every read.
+  std::optional<Context::Resource<internal::CachePoolResource>> cache_pool;
+
+  /// Staleness bound for cached downsampled chunks.  Only used if `cache_pool`
+  /// is specified.
+  StalenessBound data_staleness;
+
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(internal::BaseCast<internal::DriverSpec>(x), x.base,
-             x.downsample_factors, x.downsample_method);
+             x.downsample_factors, x.downsample_method, x.cache_pool,
+             x.data_staleness);
   };
 
   absl::Status InitializeFromBase() {
@@ -130,6 +161,9 @@ class DownsampleDriverSpec
   }
 
   absl::Status ApplyOptions(SpecOptions&& options) override {
+    if (options.recheck_cached_data.specified()) {
+      data_staleness = StalenessBound(options.recheck_cached_data);
+    }
     TENSORSTORE_RETURN_IF_ERROR(schema.Set(options.dtype()));
     TENSORSTORE_RETURN_IF_ERROR(schema.Set(options.rank()));
     auto transform = base.transform;
@@ -178,6 +212,13 @@ class DownsampleDriverSpec
                 return obj->ValidateDownsampleMethod();
               },
               jb::Projection<&DownsampleDriverSpec::downsample_method>())),
+      jb::Member(internal::CachePoolResource::id,
+                 jb::Projection<&DownsampleDriverSpec::cache_pool>()),
+      jb::Member("recheck_cached_data",
+                 jb::Projection<&DownsampleDriverSpec::data_staleness>(
+                     jb::DefaultValue([](auto* obj) {
+                       obj->bounded_by_open_time = true;
+                     }))),
       jb::Initialize([](auto* obj) {
         SpecOptions base_options;
         static_cast<Schema&>(base_options) = std::exchange(obj->schema, {});
@@ -236,34 +277,117 @@ class DownsampleDriverSpec
 
   Future<internal::Driver::Handle> Open(
       internal::OpenTransactionPtr transaction,
-      ReadWriteMode read_write_mode) const override {
-    if (!!(read_write_mode & ReadWriteMode::write)) {
-      return absl::InvalidArgumentError("only reading is supported");
+      ReadWriteMode read_write_mode) const override;
+};
+
+class DownsampleDriver;
+
+/// Chunks of the base driver from which a region of the downsampled domain is
+/// computed.
+struct BaseChunks {
+  /// Region of the downsampled domain, clipped to its current bounds.
+  Box<> region;
+
+  /// Domain of the base read request, which downsamples to `region`.
+  IndexDomain<> base_domain;
+
+  /// Downsample factors for each dimension of `base_domain`.
+  std::vector<Index> downsample_factors;
+
+  /// Chunks of the base driver, paired with the transform from their cell
+  /// domain to `base_domain`.
+  std::vector<std::pair<ReadChunk, IndexTransform<>>> chunks;
+
+  /// Generation identifying the stored data of all `chunks`, or
+  /// `StorageGeneration::Unknown()` if any chunk does not track its
+  /// generation.
+  StorageGeneration generation;
+
+  /// Generation and validator of each chunk, or empty if the generation of
+  /// any chunk cannot be checked without reading it again.
+  std::vector<std::pair<StorageGeneration, ReadChunk::GenerationValidator>>
+      validators;
+};
+
+/// Checks whether the base chunks from which a cached output chunk was
+/// computed are unchanged, without reading their data.
+struct BaseChunkValidators {
+  /// Generation of the cached output chunk.
+  StorageGeneration generation;
+
+  /// Region of the downsampled domain from which the output chunk was
+  /// computed, clipped to the bounds at the time.
+  Box<> region;
+
+  std::vector<std::pair<StorageGeneration, ReadChunk::GenerationValidator>>
+      validators;
+};
+
+/// Chunk cache used to hold downsampled output chunks when a `cache_pool` is
+/// specified.
+///
+/// Each chunk is computed from the base chunks that cover it.  Once a cached
+/// chunk is older than the staleness bound specified by `recheck_cached_data`,
+/// it is revalidated by conditionally reading the generations of the base
+/// chunks, which does not transfer their data if it is unchanged.  The chunk
+/// is only recomputed if the generations have changed.  If the generations of
+/// the base chunks cannot be checked separately, the base chunks are read
+/// again instead, and if the base driver does not track the generations of
+/// its chunks, the chunk is always recomputed.
+class DownsampleOutputCache : public internal::ChunkCache {
+ public:
+  using internal::ChunkCache::ChunkCache;
+
+  /// Common implementation used by `Entry::DoRead` and
+  /// `TransactionNode::DoRead`.
+  template <typename EntryOrNode>
+  void DoRead(EntryOrNode& node, absl::Time staleness_bound);
+
+  /// Computes the chunk for `node` from the base chunks.
+  template <typename EntryOrNode>
+  void ComputeChunk(EntryOrNode& node, Box<> cell_domain,
+                    absl::Time read_time);
+
+  class Entry : public internal::ChunkCache::Entry {
+   public:
+    using OwningCache = DownsampleOutputCache;
+    using internal::ChunkCache::Entry::Entry;
+    void DoRead(absl::Time staleness_bound) override {
+      GetOwningCache(*this).DoRead(*this, staleness_bound);
     }
-    return MapFutureValue(
-        InlineExecutor{},
-        [spec = internal::DriverSpec::PtrT<const DownsampleDriverSpec>(this)](
-            internal::Driver::Handle handle)
-            -> Result<internal::Driver::Handle> {
-          TENSORSTORE_ASSIGN_OR_RETURN(
-              auto downsampled_handle,
-              MakeDownsampleDriver(std::move(handle), spec->downsample_factors,
-                                   spec->downsample_method));
-          // Validate the domain constraint specified by the schema, if any.
-          // All other schema constraints are propagated to the base driver, and
-          // therefore aren't checked here.
-          if (auto domain = spec->schema.domain(); domain.valid()) {
-            TENSORSTORE_RETURN_IF_ERROR(
-                MergeIndexDomains(domain,
-                                  downsampled_handle.transform.domain()),
-                tensorstore::MaybeAnnotateStatus(
-                    _, "downsampled domain does not match domain in schema"));
-          }
-          return downsampled_handle;
-        },
-        internal::OpenDriver(std::move(transaction), base,
-                             ReadWriteMode::read));
+
+    absl::Mutex mutex;
+
+    /// Validators for the most recently computed chunk, or `nullptr`.
+    std::shared_ptr<const BaseChunkValidators> validators
+        ABSL_GUARDED_BY(mutex);
+  };
+
+  class TransactionNode : public internal::ChunkCache::TransactionNode {
+   public:
+    using OwningCache = DownsampleOutputCache;
+    using internal::ChunkCache::TransactionNode::TransactionNode;
+    void DoRead(absl::Time staleness_bound) override {
+      GetOwningCache(*this).DoRead(*this, staleness_bound);
+    }
+  };
+
+  Entry* DoAllocateEntry() final { return new Entry; }
+  std::size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+  TransactionNode* DoAllocateTransactionNode(
+      internal::AsyncCache::Entry& entry) final {
+    return new TransactionNode(static_cast<Entry&>(entry));
   }
+
+  /// Downsample driver, without an output cache, used to compute chunks.
+  IntrusivePtr<DownsampleDriver> driver_;
+
+  /// Origin of the chunk grid in the downsampled domain.
+  std::vector<Index> grid_origin_;
+
+  /// Generation assigned to the most recently computed chunk whose base
+  /// chunks do not track their generations.
+  std::atomic<uint64_t> generation_{0};
 };
 
 class DownsampleDriver
@@ -280,6 +404,8 @@ class DownsampleDriver
         base_driver_->GetBoundSpec(std::move(transaction), base_transform_));
     driver_spec->downsample_factors = downsample_factors_;
     driver_spec->downsample_method = downsample_method_;
+    driver_spec->cache_pool = cache_pool_;
+    driver_spec->data_staleness = data_staleness_;
     TENSORSTORE_RETURN_IF_ERROR(driver_spec->InitializeFromBase());
     TransformedDriverSpec spec;
     spec.transform = transform;
@@ -365,17 +491,483 @@ class DownsampleDriver
                                          IndexTransform<> transform,
                                          ResolveBoundsOptions options) override;
 
+  /// Enables caching of downsampled chunks in `cache_pool`.
+  ///
+  /// \param domain The downsampled domain, used to choose the chunk grid.
+  absl::Status InitializeOutputCache(
+      Context::Resource<internal::CachePoolResource> cache_pool,
+      StalenessBound data_staleness, BoxView<> domain);
+
+  /// Returns the intersection of `region` with the downsampled bounds of
+  /// `base_transform`.
+  Box<> ClipToDownsampledBounds(BoxView<> region,
+                                IndexTransformView<> base_transform);
+
+  /// Reads the base chunks from which `region` of the downsampled domain is
+  /// computed.
+  Future<BaseChunks> ReadBaseChunks(BoxView<> region);
+
+  /// Checks whether the base chunks from which `region` of the downsampled
+  /// domain was computed are unchanged, without reading their data.
+  ///
+  /// \returns `true` if the bounds and all base chunks are unchanged.
+  Future<bool> RevalidateBaseChunks(
+      BoxView<> region, std::shared_ptr<const BaseChunkValidators> validators,
+      absl::Time staleness_bound);
+
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     return f(x.base_driver_, x.base_transform_, x.downsample_factors_,
-             x.downsample_method_);
+             x.downsample_method_, x.cache_pool_, x.data_staleness_);
   };
 
   DriverPtr base_driver_;
   IndexTransform<> base_transform_;
   std::vector<Index> downsample_factors_;
   DownsampleMethod downsample_method_;
+
+  /// Cache pool and staleness bound specified in the spec, if any.
+  std::optional<Context::Resource<internal::CachePoolResource>> cache_pool_;
+  StalenessBound data_staleness_;
+
+  /// Output cache, or `nullptr` if downsampled chunks are not cached.
+  internal::CachePtr<DownsampleOutputCache> output_cache_;
+
+  /// Maps the downsampled domain to the grid of `output_cache_`.
+  IndexTransform<> output_cache_transform_;
+
+  /// Cached chunks read before this time are recomputed.
+  absl::Time output_cache_staleness_;
+};
+
+Future<internal::Driver::Handle> DownsampleDriverSpec::Open(
+    internal::OpenTransactionPtr transaction,
+    ReadWriteMode read_write_mode) const {
+  if (!!(read_write_mode & ReadWriteMode::write)) {
+    return absl::InvalidArgumentError("only reading is supported");
+  }
+  return MapFutureValue(
+      InlineExecutor{},
+      [spec = internal::DriverSpec::PtrT<const DownsampleDriverSpec>(this)](
+          internal::Driver::Handle handle) -> Result<internal::Driver::Handle> {
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto downsampled_handle,
+            MakeDownsampleDriver(std::move(handle), spec->downsample_factors,
+                                 spec->downsample_method));
+        // Validate the domain constraint specified by the schema, if any.
+        // All other schema constraints are propagated to the base driver, and
+        // therefore aren't checked here.
+        if (auto domain = spec->schema.domain(); domain.valid()) {
+          TENSORSTORE_RETURN_IF_ERROR(
+              MergeIndexDomains(domain, downsampled_handle.transform.domain()),
+              tensorstore::MaybeAnnotateStatus(
+                  _, "downsampled domain does not match domain in schema"));
+        }
+        if (spec->cache_pool) {
+          TENSORSTORE_RETURN_IF_ERROR(
+              static_cast<DownsampleDriver&>(*downsampled_handle.driver)
+                  .InitializeOutputCache(
+                      *spec->cache_pool, spec->data_staleness,
+                      downsampled_handle.transform.domain().box()));
+        }
+        return downsampled_handle;
+      },
+      internal::OpenDriver(std::move(transaction), base, ReadWriteMode::read));
+}
+
+absl::Status DownsampleDriver::InitializeOutputCache(
+    Context::Resource<internal::CachePoolResource> cache_pool,
+    StalenessBound data_staleness, BoxView<> domain) {
+  cache_pool_ = cache_pool;
+  data_staleness_ = data_staleness;
+  if (downsample_method_ == DownsampleMethod::kStride) {
+    // Stride-based downsampling involves no computation, and the base driver
+    // already caches the data if applicable.
+    return absl::OkStatus();
+  }
+  const DimensionIndex rank = this->rank();
+  TENSORSTORE_ASSIGN_OR_RETURN(auto chunk_layout,
+                               GetChunkLayout(IdentityTransform(domain)));
+  Box<> chunk_template(rank);
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::ChooseReadWriteChunkGrid(chunk_layout, domain, chunk_template),
+      tensorstore::MaybeAnnotateStatus(
+          _, "Failed to compute chunk grid for cached output"));
+
+  // The chunk cache grid has an origin of 0, while the downsampled domain has
+  // an origin of `chunk_template.origin()`.
+  IndexTransformBuilder transform_builder(rank, rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    transform_builder.output_single_input_dimension(
+        i, -chunk_template.origin()[i], 1, i);
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(output_cache_transform_,
+                               transform_builder.Finalize());
+  output_cache_staleness_ = data_staleness.BoundAtOpen(absl::Now()).time;
+
+  // Drivers that downsample the same base in the same way share cached chunks.
+  // The base kvstore, if any, identifies the context resources of the base.
+  TENSORSTORE_ASSIGN_OR_RETURN(auto base_spec,
+                               base_driver_->GetBoundSpec({}, base_transform_));
+  TENSORSTORE_ASSIGN_OR_RETURN(auto base_json, jb::ToJson(base_spec));
+  std::string cache_key;
+  internal::EncodeCacheKey(
+      &cache_key, base_json.dump(), downsample_factors_, downsample_method_,
+      std::vector<Index>(chunk_template.origin().begin(),
+                         chunk_template.origin().end()),
+      std::vector<Index>(chunk_template.shape().begin(),
+                         chunk_template.shape().end()));
+  if (auto base_kvstore = base_driver_->GetKvstore(); base_kvstore.valid()) {
+    internal::EncodeCacheKey(&cache_key, base_kvstore.driver);
+  }
+  auto make_cache = [&] {
+    // The fill value is only used for positions outside the downsampled
+    // domain, which are never read.
+    SharedArray<const void> fill_value;
+    fill_value.layout().set_rank(rank);
+    std::fill_n(fill_value.byte_strides().begin(), rank, 0);
+    std::copy_n(chunk_template.shape().begin(), rank,
+                fill_value.shape().begin());
+    fill_value.element_pointer() =
+        internal::AllocateAndConstructSharedElements(1, value_init, dtype());
+    internal::ChunkGridSpecification::Components components;
+    components.emplace_back(std::move(fill_value), Box<>(rank));
+    auto cache = std::make_unique<DownsampleOutputCache>(
+        internal::ChunkGridSpecification(std::move(components)),
+        data_copy_executor());
+    cache->driver_ = internal::MakeIntrusivePtr<DownsampleDriver>(
+        base_driver_, base_transform_, downsample_factors_,
+        downsample_method_);
+    cache->grid_origin_.assign(chunk_template.origin().begin(),
+                               chunk_template.origin().end());
+    return cache;
+  };
+  output_cache_ = (*cache_pool)->GetCache<DownsampleOutputCache>(cache_key,
+                                                                 make_cache);
+  return absl::OkStatus();
+}
+
+/// Receives the chunks of a base driver read for `ReadBaseChunks`.
+struct BaseChunkReceiver {
+  struct State : public internal::AtomicReferenceCount<State> {
+    Promise<BaseChunks> promise;
+    absl::Mutex mutex;
+    BaseChunks result ABSL_GUARDED_BY(mutex);
+    /// Generation of each chunk, encoded along with the domain of the chunk.
+    std::vector<std::string> chunk_generations ABSL_GUARDED_BY(mutex);
+  };
+  IntrusivePtr<State> state;
+
+  void set_starting(AnyCancelReceiver cancel) {}
+
+  void set_value(ReadChunk chunk, IndexTransform<> cell_transform) {
+    auto generation = chunk.impl(ReadChunk::GetGeneration{});
+    auto validator = chunk.impl(ReadChunk::GetGenerationValidator{});
+    std::string chunk_generation;
+    if (!StorageGeneration::IsUnknown(generation)) {
+      BoxView<> domain = cell_transform.domain().box();
+      for (DimensionIndex i = 0; i < domain.rank(); ++i) {
+        internal::EncodeCacheKey(&chunk_generation, domain.origin()[i],
+                                 domain.shape()[i]);
+      }
+      internal::EncodeCacheKey(&chunk_generation, generation.value);
+    }
+    absl::MutexLock lock(&state->mutex);
+    state->chunk_generations.push_back(std::move(chunk_generation));
+    state->result.validators.emplace_back(std::move(generation),
+                                          std::move(validator));
+    state->result.chunks.emplace_back(std::move(chunk),
+                                      std::move(cell_transform));
+  }
+
+  void set_done() {}
+
+  void set_error(absl::Status error) {
+    state->promise.SetResult(std::move(error));
+  }
+
+  void set_stopping() {
+    if (state->promise.ready()) return;
+    absl::MutexLock lock(&state->mutex);
+    auto& chunk_generations = state->chunk_generations;
+    if (std::none_of(chunk_generations.begin(), chunk_generations.end(),
+                     [](const std::string& g) { return g.empty(); })) {
+      // The order in which chunks are received is not deterministic.
+      std::sort(chunk_generations.begin(), chunk_generations.end());
+      std::string encoded;
+      internal::EncodeCacheKey(&encoded, chunk_generations);
+      state->result.generation = StorageGeneration::FromString(encoded);
+    }
+    auto& validators = state->result.validators;
+    if (StorageGeneration::IsUnknown(state->result.generation) ||
+        std::any_of(validators.begin(), validators.end(),
+                    [](const auto& v) { return !v.second; })) {
+      validators.clear();
+    }
+    state->promise.SetResult(std::move(state->result));
+  }
 };
 
+Box<> DownsampleDriver::ClipToDownsampledBounds(
+    BoxView<> region, IndexTransformView<> base_transform) {
+  const DimensionIndex rank = region.rank();
+  Box<> downsampled_bounds(rank);
+  internal_downsample::DownsampleBounds(base_transform.domain().box(),
+                                        downsampled_bounds, downsample_factors_,
+                                        downsample_method_);
+  Box<> clipped(rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    clipped[i] = Intersect(region[i], downsampled_bounds[i]);
+  }
+  return clipped;
+}
+
+Future<BaseChunks> DownsampleDriver::ReadBaseChunks(BoxView<> region) {
+  auto [promise, future] = PromiseFuturePair<BaseChunks>::Make();
+  auto base_resolve_future = base_driver_->ResolveBounds(
+      /*transaction=*/{}, base_transform_, {fix_resizable_bounds});
+  LinkValue(
+      [self = IntrusivePtr<DownsampleDriver>(this), region = Box<>(region)](
+          Promise<BaseChunks> promise,
+          ReadyFuture<IndexTransform<>> future) mutable {
+        IndexTransform<> base_transform = std::move(future.value());
+        region = self->ClipToDownsampledBounds(region, base_transform);
+        auto state = internal::MakeIntrusivePtr<BaseChunkReceiver::State>();
+        auto& result = state->result;
+        result.region = region;
+        if (region.is_empty()) {
+          promise.SetResult(std::move(result));
+          return;
+        }
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto propagated,
+            internal_downsample::PropagateIndexTransformDownsampling(
+                IdentityTransform(region), base_transform.domain().box(),
+                self->downsample_factors_),
+            static_cast<void>(promise.SetResult(_)));
+        // The domain of `propagated.transform`, when downsampled by
+        // `propagated.input_downsample_factors`, matches `region`.
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto base_request_transform,
+            ComposeTransforms(self->base_transform_, propagated.transform),
+            static_cast<void>(promise.SetResult(_)));
+        result.base_domain = propagated.transform.domain();
+        result.downsample_factors.assign(
+            propagated.input_downsample_factors.begin(),
+            propagated.input_downsample_factors.end());
+        state->promise = std::move(promise);
+        self->base_driver_->Read(/*transaction=*/{},
+                                 std::move(base_request_transform),
+                                 BaseChunkReceiver{std::move(state)});
+      },
+      std::move(promise), std::move(base_resolve_future));
+  return std::move(future);
+}
+
+Future<bool> DownsampleDriver::RevalidateBaseChunks(
+    BoxView<> region, std::shared_ptr<const BaseChunkValidators> validators,
+    absl::Time staleness_bound) {
+  auto [promise, future] = PromiseFuturePair<bool>::Make(false);
+  auto base_resolve_future = base_driver_->ResolveBounds(
+      /*transaction=*/{}, base_transform_, {fix_resizable_bounds});
+  LinkValue(
+      [self = IntrusivePtr<DownsampleDriver>(this), region = Box<>(region),
+       validators = std::move(validators), staleness_bound](
+          Promise<bool> promise, ReadyFuture<IndexTransform<>> future) {
+        if (self->ClipToDownsampledBounds(region, future.value()) !=
+            validators->region) {
+          // The bounds of the base have changed, which may change the set of
+          // base chunks.
+          return;
+        }
+        std::vector<Future<TimestampedStorageGeneration>> generation_futures;
+        generation_futures.reserve(validators->validators.size());
+        for (const auto& [generation, validator] : validators->validators) {
+          generation_futures.push_back(validator(generation, staleness_bound));
+        }
+        auto all_ready = WaitAllFuture(std::vector<AnyFuture>(
+            generation_futures.begin(), generation_futures.end()));
+        Link(
+            [validators, generation_futures = std::move(generation_futures)](
+                Promise<bool> promise, ReadyFuture<void> future) {
+              for (size_t i = 0; i < generation_futures.size(); ++i) {
+                auto& result = generation_futures[i].result();
+                if (!result.ok() ||
+                    result->generation != validators->validators[i].first) {
+                  // Any error is reported by the subsequent read of the base
+                  // chunks.
+                  return;
+                }
+              }
+              promise.SetResult(true);
+            },
+            std::move(promise), std::move(all_ready));
+      },
+      std::move(promise), std::move(base_resolve_future));
+  return std::move(future);
+}
+
+template <typename EntryOrNode>
+void DownsampleOutputCache::DoRead(EntryOrNode& node,
+                                   absl::Time staleness_bound) {
+  // `node` is guaranteed to remain valid until `ReadSuccess` or `ReadError`
+  // is called.  Therefore we don't need to separately hold a reference.
+  auto& entry = static_cast<Entry&>(GetOwningEntry(node));
+  auto& cache = GetOwningCache(entry);
+  const auto& component_spec = cache.grid().components.front();
+  span<const Index> cell_shape = component_spec.shape();
+  span<const Index> cell_indices = entry.cell_indices();
+  const DimensionIndex rank = cell_shape.size();
+  Box<> cell_domain(rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    cell_domain[i] = IndexInterval::UncheckedSized(
+        cache.grid_origin_[i] + cell_indices[i] * cell_shape[i],
+        cell_shape[i]);
+  }
+  const absl::Time read_time = absl::Now();
+  std::shared_ptr<const void> existing_data;
+  StorageGeneration generation;
+  {
+    AsyncCache::ReadLock<void> lock(node);
+    existing_data = lock.shared_data();
+    generation = lock.stamp().generation;
+  }
+  std::shared_ptr<const BaseChunkValidators> validators;
+  if (existing_data) {
+    absl::MutexLock lock(&entry.mutex);
+    if (entry.validators && entry.validators->generation == generation) {
+      validators = entry.validators;
+    }
+  }
+  if (!validators || validators->validators.empty()) {
+    ComputeChunk(node, std::move(cell_domain), read_time);
+    return;
+  }
+  auto revalidate_future = cache.driver_->RevalidateBaseChunks(
+      cell_domain, std::move(validators), staleness_bound);
+  revalidate_future.Force();
+  revalidate_future.ExecuteWhenReady(
+      [&node, cell_domain = std::move(cell_domain),
+       existing_data = std::move(existing_data),
+       generation = std::move(generation),
+       read_time](ReadyFuture<bool> future) mutable {
+        if (auto& r = future.result(); r.ok() && *r) {
+          node.ReadSuccess(
+              {std::move(existing_data), {std::move(generation), read_time}});
+          return;
+        }
+        GetOwningCache(GetOwningEntry(node))
+            .ComputeChunk(node, std::move(cell_domain), read_time);
+      });
+}
+
+template <typename EntryOrNode>
+void DownsampleOutputCache::ComputeChunk(EntryOrNode& node, Box<> cell_domain,
+                                         absl::Time read_time) {
+  auto& cache = GetOwningCache(GetOwningEntry(node));
+  // The domain of the base driver may have changed since the cache was
+  // created, so the current bounds are resolved before each read.
+  auto base_chunks_future = cache.driver_->ReadBaseChunks(cell_domain);
+  base_chunks_future.Force();
+  base_chunks_future.ExecuteWhenReady(
+      [&node, cell_origin = std::vector<Index>(cell_domain.origin().begin(),
+                                               cell_domain.origin().end()),
+       read_time](ReadyFuture<BaseChunks> future) {
+        auto& r = future.result();
+        if (!r.ok()) {
+          node.ReadError(r.status());
+          return;
+        }
+        auto& entry = static_cast<Entry&>(GetOwningEntry(node));
+        auto& cache = GetOwningCache(entry);
+        if (r->region.is_empty()) {
+          node.ReadSuccess(
+              {internal::make_shared_for_overwrite<ReadData[]>(1),
+               {StorageGeneration::NoValue(), read_time}});
+          return;
+        }
+        auto generation = r->generation;
+        if (!StorageGeneration::IsUnknown(generation)) {
+          // Record how to revalidate the chunk without reading the base
+          // chunks.
+          auto validators = std::make_shared<BaseChunkValidators>();
+          validators->generation = generation;
+          validators->region = r->region;
+          validators->validators = std::move(r->validators);
+          {
+            absl::MutexLock lock(&entry.mutex);
+            entry.validators = std::move(validators);
+          }
+          // The cached chunk may still match the base chunks.
+          std::shared_ptr<const void> existing_data;
+          {
+            AsyncCache::ReadLock<void> lock(node);
+            if (lock.stamp().generation == generation) {
+              existing_data = lock.shared_data();
+            }
+          }
+          if (existing_data) {
+            node.ReadSuccess(
+                {std::move(existing_data), {std::move(generation), read_time}});
+            return;
+          }
+        } else {
+          generation = StorageGeneration::FromUint64(++cache.generation_);
+        }
+        // Copying and downsampling the base chunks may be expensive.
+        cache.executor()([&node, base_chunks = std::move(*r),
+                          cell_origin = std::move(cell_origin),
+                          generation = std::move(generation),
+                          read_time]() mutable {
+          auto& cache = GetOwningCache(GetOwningEntry(node));
+          const auto& component_spec = cache.grid().components.front();
+          const DimensionIndex rank = cell_origin.size();
+          auto base_buffer = AllocateArray(
+              base_chunks.base_domain.box(), c_order, value_init,
+              cache.driver_->base_driver_->dtype());
+          for (auto& [chunk, cell_transform] : base_chunks.chunks) {
+            TENSORSTORE_ASSIGN_OR_RETURN(
+                auto target,
+                MakeTransformedArray(base_buffer, std::move(cell_transform)),
+                node.ReadError(_));
+            TENSORSTORE_RETURN_IF_ERROR(
+                internal::CopyReadChunk(chunk.impl, chunk.transform, target),
+                node.ReadError(_));
+          }
+          // Release the base chunks, and any resources they hold, before
+          // downsampling.
+          base_chunks.chunks.clear();
+          // Always allocate the full chunk size, since that is what
+          // `ChunkCache` requires.  The portion outside the domain is never
+          // read.
+          auto full_array = AllocateArray(component_spec.shape(), c_order,
+                                          value_init, component_spec.dtype());
+          IndexTransformBuilder target_builder(rank, rank);
+          target_builder.input_bounds(base_chunks.region);
+          for (DimensionIndex i = 0; i < rank; ++i) {
+            target_builder.output_single_input_dimension(i, -cell_origin[i], 1,
+                                                         i);
+          }
+          TENSORSTORE_ASSIGN_OR_RETURN(auto target_transform,
+                                       target_builder.Finalize(),
+                                       node.ReadError(_));
+          TENSORSTORE_ASSIGN_OR_RETURN(
+              auto target, MakeTransformedArray(full_array, target_transform),
+              node.ReadError(_));
+          TENSORSTORE_RETURN_IF_ERROR(
+              internal_downsample::DownsampleTransformedArray(
+                  base_buffer, target, base_chunks.downsample_factors,
+                  cache.driver_->downsample_method_),
+              node.ReadError(_));
+          auto read_data = internal::make_shared_for_overwrite<ReadData[]>(1);
+          read_data.get()[0] =
+              SharedArrayView<void>(std::move(full_array.element_pointer()),
+                                    component_spec.write_layout());
+          node.ReadSuccess(
+              {std::move(read_data), {std::move(generation), read_time}});
+        });
+      });
+}
+
 Future<IndexTransform<>> DownsampleDriver::ResolveBounds(
     OpenTransactionPtr transaction, IndexTransform<> transform,
     ResolveBoundsOptions options) {
@@ -872,6 +1464,18 @@ struct ReadReceiverImpl {
 void DownsampleDriver::Read(
     OpenTransactionPtr transaction, IndexTransform<> transform,
     AnyFlowReceiver<absl::Status, ReadChunk, IndexTransform<>> receiver) {
+  if (output_cache_ && !transaction) {
+    // Reads within a transaction bypass the output cache, since they may
+    // observe uncommitted modifications to the base driver.
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto cache_transform,
+        ComposeTransforms(output_cache_transform_, std::move(transform)),
+        execution::set_error(FlowSingleReceiver{std::move(receiver)}, _));
+    output_cache_->Read(/*transaction=*/{}, /*component_index=*/0,
+                        std::move(cache_transform), output_cache_staleness_,
+                        std::move(receiver));
+    return;
+  }
   if (downsample_method_ == DownsampleMethod::kStride) {
     // Stride-based downsampling just relies on the normal `IndexTransform`
     // machinery.
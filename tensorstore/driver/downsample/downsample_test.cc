@@ -23,6 +23,8 @@
 #include "tensorstore/index_space/dim_expression.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/json_gtest.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
 #include "tensorstore/open.h"
 #include "tensorstore/spec.h"
 #include "tensorstore/util/execution/sender_util.h"
@@ -42,10 +44,12 @@ using ::tensorstore::MatchesJson;
 using ::tensorstore::MatchesStatus;
 using ::tensorstore::ReadWriteMode;
 using ::tensorstore::Spec;
+using ::tensorstore::StorageGeneration;
 using ::tensorstore::TensorStore;
 using ::tensorstore::internal::CollectReadChunks;
 using ::tensorstore::internal::MakeArrayBackedReadChunk;
 using ::tensorstore::internal::MockDriver;
+using ::tensorstore::internal::MockKeyValueStoreResource;
 using ::tensorstore::internal::ReadAsIndividualChunks;
 using ::tensorstore::internal::TestSpecSchema;
 using ::tensorstore::internal::TestTensorStoreCreateCheckSchema;
@@ -135,6 +139,151 @@ TEST(DownsampleTest, Rank1MeanChunked) {
               Optional(MakeArray<uint8_t>({1, 6, 3, 5, 2, 5})));
 }
 
+TEST(DownsampleTest, Rank1MeanCached) {
+  ::nlohmann::json base_spec{{"driver", "n5"},
+                             {"kvstore", {{"driver", "memory"}}},
+                             {"metadata",
+                              {{"dataType", "uint8"},
+                               {"dimensions", {11}},
+                               {"blockSize", {3}},
+                               {"compression", {{"type", "raw"}}}}}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context_spec,
+      Context::Spec::FromJson(
+          {{"cache_pool#downsampled", {{"total_bytes_limit", 1000000}}}}));
+  Context context(context_spec);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base_store,
+      tensorstore::Open(base_spec, context, tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      MakeArray<uint8_t>({0, 2, 3, 9, 1, 5, 7, 3, 4, 0, 5}), base_store));
+  ::nlohmann::json downsampled_spec{{"driver", "downsample"},
+                                    {"base", base_spec},
+                                    {"downsample_factors", {2}},
+                                    {"downsample_method", "mean"},
+                                    {"cache_pool", "cache_pool#downsampled"}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto downsampled_store,
+      tensorstore::Open(downsampled_spec, context).result());
+  EXPECT_THAT(tensorstore::Read(downsampled_store).result(),
+              Optional(MakeArray<uint8_t>({1, 6, 3, 5, 2, 5})));
+  EXPECT_THAT(
+      tensorstore::Read(downsampled_store |
+                        tensorstore::Dims(0).HalfOpenInterval(1, 4))
+          .result(),
+      Optional(MakeOffsetArray<uint8_t>({1}, {6, 3, 5})));
+
+  // By default, chunks cached after the store was opened are not
+  // revalidated.
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      MakeArray<uint8_t>({2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}), base_store));
+  EXPECT_THAT(tensorstore::Read(downsampled_store).result(),
+              Optional(MakeArray<uint8_t>({1, 6, 3, 5, 2, 5})));
+
+  // With `"recheck_cached_data": true`, cached chunks are revalidated against
+  // the base chunks.
+  auto checked_spec = downsampled_spec;
+  checked_spec["recheck_cached_data"] = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto checked_store, tensorstore::Open(checked_spec, context).result());
+  EXPECT_THAT(tensorstore::Read(checked_store).result(),
+              Optional(MakeArray<uint8_t>({2, 2, 2, 2, 2, 2})));
+
+  // A store that downsamples the same base in the same way shares the cached
+  // chunks, which are not revalidated with `"recheck_cached_data": false`.
+  auto unchecked_spec = downsampled_spec;
+  unchecked_spec["recheck_cached_data"] = false;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto unchecked_store,
+      tensorstore::Open(unchecked_spec, context).result());
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      MakeArray<uint8_t>({4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4}), base_store));
+  EXPECT_THAT(tensorstore::Read(unchecked_store).result(),
+              Optional(MakeArray<uint8_t>({2, 2, 2, 2, 2, 2})));
+  EXPECT_THAT(tensorstore::Read(checked_store).result(),
+              Optional(MakeArray<uint8_t>({4, 4, 4, 4, 4, 4})));
+
+  // The caching options round trip through the spec.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto spec, unchecked_store.spec(tensorstore::retain_context));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec_json, spec.ToJson());
+  EXPECT_EQ(false, spec_json.value("recheck_cached_data", ::nlohmann::json()));
+  EXPECT_TRUE(spec_json.contains("cache_pool"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto reopened_store,
+                                   tensorstore::Open(spec).result());
+  EXPECT_THAT(tensorstore::Read(reopened_store).result(),
+              Optional(MakeArray<uint8_t>({2, 2, 2, 2, 2, 2})));
+}
+
+TEST(DownsampleTest, Rank1MeanCachedRevalidatesWithoutReadingBase) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context_spec,
+      Context::Spec::FromJson(
+          {{"cache_pool#downsampled", {{"total_bytes_limit", 1000000}}}}));
+  Context context(context_spec);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto memory_store,
+      tensorstore::Open({{"driver", "n5"},
+                         {"kvstore", {{"driver", "memory"}}},
+                         {"metadata",
+                          {{"dataType", "uint8"},
+                           {"dimensions", {4}},
+                           {"blockSize", {4}},
+                           {"compression", {{"type", "raw"}}}}}},
+                        context, tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint8_t>({1, 3, 5, 7}), memory_store));
+  auto memory_kvstore = memory_store.kvstore().driver;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_kvstore_resource,
+      context.GetResource<MockKeyValueStoreResource>());
+  auto mock_kvstore = *mock_kvstore_resource;
+  auto store_future = tensorstore::Open(
+      {{"driver", "downsample"},
+       {"base",
+        {{"driver", "n5"}, {"kvstore", {{"driver", "mock_key_value_store"}}}}},
+       {"downsample_factors", {2}},
+       {"downsample_method", "mean"},
+       {"cache_pool", "cache_pool#downsampled"},
+       {"recheck_cached_data", true}},
+      context);
+  mock_kvstore->read_requests.pop()(memory_kvstore);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, store_future.result());
+
+  // The first read computes the chunk from the base chunk.
+  {
+    auto read_future = tensorstore::Read(store);
+    auto request = mock_kvstore->read_requests.pop();
+    EXPECT_EQ(StorageGeneration::Unknown(), request.options.if_not_equal);
+    request(memory_kvstore);
+    EXPECT_THAT(read_future.result(), Optional(MakeArray<uint8_t>({2, 6})));
+  }
+
+  // Revalidating the cached chunk only reads the base chunk conditionally.
+  {
+    auto read_future = tensorstore::Read(store);
+    auto request = mock_kvstore->read_requests.pop();
+    EXPECT_FALSE(StorageGeneration::IsUnknown(request.options.if_not_equal));
+    request(memory_kvstore);
+    EXPECT_THAT(read_future.result(), Optional(MakeArray<uint8_t>({2, 6})));
+    EXPECT_TRUE(mock_kvstore->read_requests.empty());
+  }
+
+  // If the base chunk has changed, it is read again.
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint8_t>({5, 5, 9, 9}), memory_store));
+  {
+    auto read_future = tensorstore::Read(store);
+    auto request = mock_kvstore->read_requests.pop();
+    EXPECT_FALSE(StorageGeneration::IsUnknown(request.options.if_not_equal));
+    request(memory_kvstore);
+    mock_kvstore->read_requests.pop()(memory_kvstore);
+    EXPECT_THAT(read_future.result(), Optional(MakeArray<uint8_t>({5, 9})));
+  }
+}
+
 TEST(DownsampleTest, Rank1MeanChunkedTranslated) {
   ::nlohmann::json base_spec{{"driver", "n5"},
                              {"kvstore", {{"driver", "memory"}}},
@@ -24,7 +24,9 @@
 
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
+#include "tensorstore/box.h"
 #include "tensorstore/chunk_layout.h"
+#include "tensorstore/chunk_statistics.h"
 #include "tensorstore/codec_spec.h"
 #include "tensorstore/context.h"
 #include "tensorstore/data_type.h"
@@ -36,6 +38,7 @@
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/tagged_ptr.h"
+#include "tensorstore/io_cost.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/rank.h"
@@ -180,6 +183,21 @@ Future<IndexTransform<>> Driver::Resize(OpenTransactionPtr transaction,
   return absl::UnimplementedError("Resize not supported");
 }
 
+Future<std::vector<Box<>>> Driver::FindChunks(OpenTransactionPtr transaction,
+                                              IndexTransform<> transform,
+                                              ChunkStatisticsQuery query) {
+  assert(transform.output_rank() == rank());
+  std::vector<Box<>> chunks;
+  chunks.emplace_back(transform.domain().box());
+  return chunks;
+}
+
+Result<IoCostReport> Driver::ExplainIo(OpenTransactionPtr transaction,
+                                       IndexTransform<> transform,
+                                       ReadWriteMode mode) {
+  return absl::UnimplementedError("I/O cost estimation not supported");
+}
+
 Result<ChunkLayout> GetChunkLayout(const Driver::Handle& handle) {
   assert(handle.driver);
   return handle.driver->GetChunkLayout(handle.transform);
@@ -190,6 +208,16 @@ Result<CodecSpec> GetCodec(const Driver::Handle& handle) {
   return handle.driver->GetCodec();
 }
 
+Result<IoCostReport> ExplainIo(const Driver::Handle& handle,
+                               ReadWriteMode mode) {
+  assert(handle.driver);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto open_transaction,
+      internal::AcquireOpenTransactionPtrOrError(handle.transaction));
+  return handle.driver->ExplainIo(std::move(open_transaction),
+                                  handle.transform, mode);
+}
+
 Result<DimensionUnitsVector> GetDimensionUnits(const Driver::Handle& handle) {
   TENSORSTORE_ASSIGN_OR_RETURN(auto units, handle.driver->GetDimensionUnits());
   return tensorstore::TransformOutputDimensionUnits(handle.transform,
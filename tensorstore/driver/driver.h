@@ -41,10 +41,13 @@
 /// `kvstore::DriverPtr`, respectively.
 
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
+#include "tensorstore/box.h"
 #include "tensorstore/chunk_layout.h"
+#include "tensorstore/chunk_statistics.h"
 #include "tensorstore/codec_spec.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/chunk.h"
@@ -55,6 +58,7 @@
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/tagged_ptr.h"
+#include "tensorstore/io_cost.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/open_options.h"
@@ -237,6 +241,34 @@ class Driver : public AtomicReferenceCount<Driver> {
                                           span<const Index> exclusive_max,
                                           ResizeOptions options);
 
+  /// Returns the regions of the input domain of `transform` corresponding to
+  /// storage chunks that may contain elements matching `query`.
+  ///
+  /// Each returned box is the bounding box, within `transform.domain()`, of
+  /// the portion of a single chunk.  Chunks for which the driver cannot rule
+  /// out `query` are always included.
+  ///
+  /// The default implementation conservatively returns `transform.domain()`
+  /// as a single box.
+  ///
+  /// \dchecks `transform.output_rank() == rank()`.
+  virtual Future<std::vector<Box<>>> FindChunks(OpenTransactionPtr transaction,
+                                                IndexTransform<> transform,
+                                                ChunkStatisticsQuery query);
+
+  /// Estimates the I/O cost of reading (if `mode == ReadWriteMode::read`) or
+  /// writing (if `mode == ReadWriteMode::write`) the region `transform`,
+  /// without performing any I/O.
+  ///
+  /// The default implementation returns an error.
+  ///
+  /// \dchecks `transform.output_rank() == rank()`.
+  /// \error `absl::StatusCode::kUnimplemented` if the driver cannot estimate
+  ///     its I/O cost, for example within `transaction`.
+  virtual Result<IoCostReport> ExplainIo(OpenTransactionPtr transaction,
+                                         IndexTransform<> transform,
+                                         ReadWriteMode mode);
+
   virtual ~Driver();
 };
 
@@ -263,6 +295,13 @@ Result<ChunkLayout> GetChunkLayout(const Driver::Handle& handle);
 
 Result<CodecSpec> GetCodec(const Driver::Handle& handle);
 
+/// Estimates the I/O cost of reading or writing `handle`, within
+/// `handle.transaction`, without performing any I/O.
+///
+/// \param mode Must be `ReadWriteMode::read` or `ReadWriteMode::write`.
+Result<IoCostReport> ExplainIo(const Driver::Handle& handle,
+                               ReadWriteMode mode);
+
 template <typename Element = void>
 Result<SharedArray<const Element>> GetFillValue(const Driver::Handle& handle) {
   TENSORSTORE_ASSIGN_OR_RETURN(auto fill_value,
@@ -14,20 +14,41 @@
 
 #include "tensorstore/driver/kvs_backed_chunk_driver.h"
 
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "absl/container/fixed_array.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_join.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_statistics.h"
 #include "tensorstore/driver/kvs_backed_chunk_driver_impl.h"
 #include "tensorstore/internal/box_difference.h"
 #include "tensorstore/internal/cache/async_initialized_cache_mixin.h"
 #include "tensorstore/internal/cache/cache_pool_resource.h"
 #include "tensorstore/internal/cache_key/cache_key.h"
+#include "tensorstore/internal/cache_key/std_optional.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/grid_partition.h"
+#include "tensorstore/internal/in_flight_bytes_resource.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_binding/staleness_bound.h"
+#include "tensorstore/internal/json_binding/std_array.h"
+#include "tensorstore/internal/json_binding/std_optional.h"
 #include "tensorstore/internal/path.h"
 #include "tensorstore/internal/unowned_to_shared.h"
+#include "tensorstore/io_cost.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
 #include "tensorstore/tensorstore.h"
 #include "tensorstore/util/iterate_over_index_range.h"
+#include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/str_cat.h"
 
 #ifndef TENSORSTORE_KVS_DRIVER_DEBUG
@@ -37,6 +58,8 @@
 namespace tensorstore {
 namespace internal_kvs_backed_chunk_driver {
 
+namespace jb = tensorstore::internal_json_binding;
+
 OpenState::~OpenState() = default;
 
 Result<IndexTransform<>> DataCache::GetExternalToInternalTransform(
@@ -74,14 +97,18 @@ AtomicUpdateConstraint OpenState::GetCreateConstraint() {
 MetadataCache::MetadataCache(Initializer initializer)
     : Base(kvstore::DriverPtr()),
       data_copy_concurrency_(std::move(initializer.data_copy_concurrency)),
-      cache_pool_(std::move(initializer.cache_pool)) {}
+      cache_pool_(std::move(initializer.cache_pool)),
+      in_flight_bytes_(std::move(initializer.in_flight_bytes)) {}
 
 DataCache::DataCache(Initializer initializer,
                      internal::ChunkGridSpecification grid)
     : Base(std::move(initializer.store), std::move(grid),
            GetOwningCache(*initializer.metadata_cache_entry).executor()),
       metadata_cache_entry_(std::move(initializer.metadata_cache_entry)),
-      initial_metadata_(std::move(initializer.metadata)) {}
+      initial_metadata_(std::move(initializer.metadata)),
+      chunk_statistics_(std::move(initializer.chunk_statistics)) {
+  SetInFlightBytesBudget(*metadata_cache()->in_flight_bytes_);
+}
 
 Result<ChunkLayout> DataCache::GetChunkLayout(const void* metadata_ptr,
                                               std::size_t component_index) {
@@ -93,6 +120,93 @@ Result<CodecSpec> DataCache::GetCodec(const void* metadata,
   return CodecSpec{};
 }
 
+std::string DataCache::GetChunkStatisticsKey(const void* metadata,
+                                             span<const Index> cell_indices) {
+  return tensorstore::StrCat(GetBaseKvstorePath(), ".chunk_statistics/",
+                             absl::StrJoin(cell_indices, "."));
+}
+
+namespace {
+
+/// Statistics of all components of a chunk, as stored under
+/// `DataCache::GetChunkStatisticsKey`.
+struct StoredChunkStatistics {
+  /// Base64 encoding of the `StorageGeneration` of the chunk from which the
+  /// statistics were computed.
+  std::string generation;
+
+  std::vector<ChunkStatistics> components;
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("generation",
+                 jb::Projection(&StoredChunkStatistics::generation)),
+      jb::Member("components",
+                 jb::Projection(&StoredChunkStatistics::components)));
+};
+
+/// Computes and encodes the statistics of the chunk `read_state`.
+Result<absl::Cord> EncodeChunkStatistics(
+    span<const internal::ChunkGridSpecification::Component> component_specs,
+    const internal::AsyncCache::ReadState& read_state,
+    const ChunkStatisticsOptions& options) {
+  StoredChunkStatistics stored;
+  stored.generation =
+      absl::Base64Escape(read_state.stamp.generation.value);
+  auto* components =
+      static_cast<const internal::ChunkCache::ReadData*>(read_state.data.get());
+  for (size_t i = 0; i < component_specs.size(); ++i) {
+    const auto& fill_value = component_specs[i].fill_value;
+    // An invalid component array indicates that it equals the fill value.
+    SharedArrayView<const void> array =
+        internal::ChunkCache::GetReadComponent(components, i);
+    if (!array.valid()) array = fill_value;
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto stats,
+        internal::ComputeChunkStatistics(array, fill_value, options));
+    stored.components.push_back(std::move(stats));
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto json, jb::ToJson(stored));
+  return absl::Cord(json.dump());
+}
+
+}  // namespace
+
+void DataCache::TransactionNode::WritebackSuccess(ReadState&& read_state) {
+  auto& cache = GetOwningCache(*this);
+  const auto& generation = read_state.stamp.generation;
+  if (cache.chunk_statistics_ && !StorageGeneration::IsUnknown(generation)) {
+    auto& entry = GetOwningEntry(*this);
+    // The statistics of a deleted chunk are deleted along with it, since
+    // `FindChunks` treats a missing chunk as equal to the fill value.
+    // Statistics are only an optimization; if they cannot be computed, any
+    // existing statistics are deleted, since a chunk without statistics is
+    // always treated as a candidate by `FindChunks`.
+    std::optional<absl::Cord> value;
+    if (!StorageGeneration::IsNoValue(generation)) {
+      auto encoded = EncodeChunkStatistics(component_specs(), read_state,
+                                           *cache.chunk_statistics_);
+      if (encoded.ok()) value = *std::move(encoded);
+    }
+    auto key = cache.GetChunkStatisticsKey(cache.initial_metadata_.get(),
+                                           entry.cell_indices());
+    // The write is not awaited by the chunk writeback.  Since statistics that
+    // are missing or stale are ignored by `FindChunks`, a failure only affects
+    // performance, and is logged.
+    cache.metadata_cache()
+        ->base_store()
+        ->Write(key, std::move(value))
+        .ExecuteWhenReady([key](ReadyFuture<TimestampedStorageGeneration>
+                                    future) {
+          if (auto& result = future.result(); !result.ok()) {
+            ABSL_LOG(WARNING) << "Failed to write chunk statistics to "
+                              << tensorstore::QuoteString(key) << ": "
+                              << result.status();
+          }
+        });
+  }
+  Base::TransactionNode::WritebackSuccess(std::move(read_state));
+}
+
 namespace {
 
 // Address of this variable is used to signal an invalid metadata value.
@@ -306,6 +420,20 @@ Result<ChunkLayout> DataCache::GetChunkLayout(size_t component_index) {
   return GetChunkLayout(initial_metadata_.get(), component_index);
 }
 
+Future<TimestampedStorageGeneration> DataCache::ReadGeneration(
+    span<const Index> cell_indices, StorageGeneration if_not_equal,
+    absl::Time staleness_bound) {
+  kvstore::ReadOptions options;
+  options.if_not_equal = std::move(if_not_equal);
+  options.staleness_bound = staleness_bound;
+  return MapFutureValue(
+      InlineExecutor{},
+      [](const kvstore::ReadResult& read_result) { return read_result.stamp; },
+      kvstore_driver()->Read(
+          GetChunkStorageKey(initial_metadata_.get(), cell_indices),
+          std::move(options)));
+}
+
 Future<IndexTransform<>> KvsDriverBase::ResolveBounds(
     internal::OpenTransactionPtr transaction, IndexTransform<> transform,
     ResolveBoundsOptions options) {
@@ -644,11 +772,13 @@ Result<IndexTransform<>> KvsDriverBase::GetBoundSpecData(
   spec.store.path = cache->GetBaseKvstorePath();
   spec.data_copy_concurrency = metadata_cache->data_copy_concurrency_;
   spec.cache_pool = metadata_cache->cache_pool_;
+  spec.in_flight_bytes = metadata_cache->in_flight_bytes_;
   spec.delete_existing = false;
   spec.open = true;
   spec.create = false;
   spec.staleness.metadata = this->metadata_staleness_bound();
   spec.staleness.data = this->data_staleness_bound();
+  spec.chunk_statistics = cache->chunk_statistics_;
   spec.schema.Set(RankConstraint{this->rank()}).IgnoreError();
   spec.schema.Set(this->dtype()).IgnoreError();
 
@@ -707,6 +837,193 @@ KvStore KvsDriverBase::GetKvstore() {
                  cache->GetBaseKvstorePath()};
 }
 
+namespace {
+
+/// Local state for the asynchronous operation initiated by
+/// `KvsDriverBase::FindChunks`.
+///
+/// Once all per-chunk operations have completed, all references to
+/// `FindChunksState` are released, and the destructor sets the result of
+/// `promise` to the chunks that were not excluded.
+struct FindChunksState
+    : public internal::AtomicReferenceCount<FindChunksState> {
+  internal::IntrusivePtr<KvsDriverBase> driver;
+  ChunkStatisticsQuery query;
+  std::vector<Box<>> chunks;
+  std::vector<std::string> storage_keys;
+  std::vector<char> excluded;
+  Promise<std::vector<Box<>>> promise;
+
+  /// Statistics of a chunk equal to the fill value, which apply to missing
+  /// chunks, or `std::nullopt` if they cannot be computed.
+  std::optional<ChunkStatistics> fill_value_statistics;
+
+  /// Returns `true` if a missing chunk is ruled out by the query.
+  bool ExcludesMissingChunk() const {
+    return fill_value_statistics && !MayMatch(*fill_value_statistics, query);
+  }
+
+  ~FindChunksState() {
+    auto& result = promise.raw_result();
+    if (!result.ok()) return;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      if (!excluded[i]) result->push_back(std::move(chunks[i]));
+    }
+  }
+};
+
+/// Excludes chunk `i`, which has no stored statistics, if it is missing and
+/// the fill value rules out the query.
+void HandleMissingChunkStatistics(
+    internal::IntrusivePtr<FindChunksState> state, size_t i) {
+  if (!state->ExcludesMissingChunk()) return;
+  // Only the existence of the chunk is needed.
+  kvstore::ReadOptions options;
+  options.byte_range = OptionalByteRangeRequest(0, 0);
+  auto* cache = state->driver->cache();
+  auto read_future = cache->kvstore_driver()->Read(
+      std::move(state->storage_keys[i]), std::move(options));
+  std::move(read_future)
+      .ExecuteWhenReady([state = std::move(state),
+                         i](ReadyFuture<kvstore::ReadResult> future) {
+        auto& read_result = future.result();
+        if (!read_result.ok()) {
+          SetDeferredResult(state->promise, read_result.status());
+          return;
+        }
+        if (read_result->state == kvstore::ReadResult::kMissing) {
+          state->excluded[i] = true;
+        }
+      });
+}
+
+/// Excludes chunk `i` if its stored statistics `value` rule out the query and
+/// are still up to date.
+void HandleChunkStatistics(internal::IntrusivePtr<FindChunksState> state,
+                           size_t i, const kvstore::ReadResult& read_result) {
+  if (!read_result.has_value()) {
+    HandleMissingChunkStatistics(std::move(state), i);
+    return;
+  }
+  auto json = ::nlohmann::json::parse(std::string(read_result.value),
+                                      nullptr, /*allow_exceptions=*/false);
+  auto stored = jb::FromJson<StoredChunkStatistics>(std::move(json));
+  if (!stored.ok()) return;
+  const size_t component_index = state->driver->component_index();
+  if (stored->components.size() <= component_index ||
+      MayMatch(stored->components[component_index], state->query)) {
+    return;
+  }
+  StorageGeneration generation;
+  if (!absl::Base64Unescape(stored->generation, &generation.value)) return;
+  // Verify that the chunk has not been modified since the statistics were
+  // written.  If unmodified, the read is aborted without transferring data.
+  kvstore::ReadOptions options;
+  options.if_not_equal = generation;
+  auto* cache = state->driver->cache();
+  auto read_future = cache->kvstore_driver()->Read(
+      std::move(state->storage_keys[i]), std::move(options));
+  std::move(read_future)
+      .ExecuteWhenReady(
+          [state = std::move(state), i, generation = std::move(generation)](
+              ReadyFuture<kvstore::ReadResult> future) {
+            auto& read_result = future.result();
+            if (!read_result.ok()) {
+              SetDeferredResult(state->promise, read_result.status());
+              return;
+            }
+            if (read_result->aborted() ||
+                read_result->stamp.generation == generation) {
+              state->excluded[i] = true;
+            } else if (read_result->state == kvstore::ReadResult::kMissing &&
+                       state->ExcludesMissingChunk()) {
+              state->excluded[i] = true;
+            }
+          });
+}
+
+}  // namespace
+
+Future<std::vector<Box<>>> KvsDriverBase::FindChunks(
+    internal::OpenTransactionPtr transaction, IndexTransform<> transform,
+    ChunkStatisticsQuery query) {
+  auto* cache = this->cache();
+  const auto& component_spec = cache->grid().components[component_index()];
+  internal::IntrusivePtr<FindChunksState> state(new FindChunksState);
+  std::vector<std::vector<Index>> cell_indices;
+  TENSORSTORE_RETURN_IF_ERROR(internal::PartitionIndexTransformOverRegularGrid(
+      component_spec.chunked_to_cell_dimensions, cache->grid().chunk_shape,
+      transform,
+      [&](span<const Index> grid_cell_indices,
+          IndexTransformView<> cell_transform) -> absl::Status {
+        Box<> chunk(cell_transform.output_rank());
+        TENSORSTORE_RETURN_IF_ERROR(GetOutputRange(cell_transform, chunk));
+        state->chunks.push_back(std::move(chunk));
+        cell_indices.emplace_back(grid_cell_indices.begin(),
+                                  grid_cell_indices.end());
+        return absl::OkStatus();
+      }));
+  if (!cache->chunk_statistics_ || transaction) {
+    return std::move(state->chunks);
+  }
+  state->driver.reset(this);
+  state->query = std::move(query);
+  state->excluded.resize(state->chunks.size());
+  if (auto fill_value_statistics = internal::ComputeChunkStatistics(
+          component_spec.fill_value, component_spec.fill_value,
+          *cache->chunk_statistics_);
+      fill_value_statistics.ok()) {
+    state->fill_value_statistics = *std::move(fill_value_statistics);
+  }
+  auto pair = PromiseFuturePair<std::vector<Box<>>>::Make(std::in_place);
+  state->promise = std::move(pair.promise);
+  for (const auto& indices : cell_indices) {
+    state->storage_keys.push_back(
+        cache->GetChunkStorageKey(cache->initial_metadata_.get(), indices));
+  }
+  auto* base_store = cache->metadata_cache()->base_store();
+  for (size_t i = 0; i < cell_indices.size(); ++i) {
+    auto read_future = base_store->Read(cache->GetChunkStatisticsKey(
+        cache->initial_metadata_.get(), cell_indices[i]));
+    std::move(read_future)
+        .ExecuteWhenReady(
+            [state, i](ReadyFuture<kvstore::ReadResult> future) mutable {
+              // Errors reading the statistics are ignored, since the chunk is
+              // then simply not excluded.
+              if (!future.result().ok()) return;
+              HandleChunkStatistics(std::move(state), i, *future.result());
+            });
+  }
+  return std::move(pair.future);
+}
+
+Result<IoCostReport> KvsDriverBase::ExplainIo(
+    internal::OpenTransactionPtr transaction, IndexTransform<> transform,
+    ReadWriteMode mode) {
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto report, ChunkCacheDriver::ExplainIo(std::move(transaction),
+                                               std::move(transform), mode));
+  auto* cache = this->cache();
+  auto kvstore = GetKvstore();
+  std::string url;
+  if (auto result = kvstore.ToUrl(); result.ok()) {
+    url = *std::move(result);
+  } else {
+    url = kvstore.driver->DescribeKey(kvstore.path);
+  }
+  // Chunks may be stored within a kvstore adapter, such as a sharded
+  // kvstore, in which case the key is only described.
+  kvstore::Driver* chunk_store = cache->kvstore_driver();
+  const bool direct = chunk_store == kvstore.driver.get();
+  for (auto& chunk : report.chunks) {
+    chunk.kvstore = url;
+    auto key = cache->GetChunkStorageKey(cache->initial_metadata_.get(),
+                                         chunk.cell_indices);
+    chunk.key = direct ? std::move(key) : chunk_store->DescribeKey(key);
+  }
+  return report;
+}
+
 namespace {
 /// Validates that the open request specified by `state` can be applied to
 /// `metadata`.
@@ -743,7 +1060,8 @@ Result<internal::Driver::Handle> CreateTensorStoreFromMetadata(
     auto data_cache_key = state->GetDataCacheKey(metadata.get());
     if (!data_cache_key.empty()) {
       internal::EncodeCacheKey(&chunk_cache_identifier, data_cache_key,
-                               base.metadata_cache_key_);
+                               base.metadata_cache_key_,
+                               base.spec_->chunk_statistics);
     }
   }
   absl::Status data_key_value_store_status;
@@ -759,9 +1077,9 @@ Result<internal::Driver::Handle> CreateTensorStoreFromMetadata(
                       std::move(store_result).status();
                   return nullptr;
                 }
-                return state->GetDataCache({std::move(*store_result),
-                                            base.metadata_cache_entry_,
-                                            metadata});
+                return state->GetDataCache(
+                    {std::move(*store_result), base.metadata_cache_entry_,
+                     metadata, base.spec_->chunk_statistics});
               });
   TENSORSTORE_RETURN_IF_ERROR(data_key_value_store_status);
   TENSORSTORE_ASSIGN_OR_RETURN(
@@ -1120,6 +1438,42 @@ std::string DataCache::Entry::GetKeyValueStoreKey() {
                                   this->cell_indices());
 }
 
+namespace {
+/// Completes a `DataCache::Entry::DoDecode` or `DoDecodeStream` operation.
+void SetDecodedChunk(
+    DataCache::Entry& entry,
+    Result<absl::InlinedVector<SharedArrayView<const void>, 1>> decoded_result,
+    DataCache::Entry::DecodeReceiver& receiver) {
+  if (!decoded_result.ok()) {
+    execution::set_error(receiver,
+                         internal::ConvertInvalidArgumentToFailedPrecondition(
+                             std::move(decoded_result).status()));
+    return;
+  }
+  using ReadData = DataCache::ReadData;
+  const auto component_specs = entry.component_specs();
+  const size_t num_components = component_specs.size();
+  auto new_read_data =
+      internal::make_shared_for_overwrite<ReadData[]>(num_components);
+  assert(decoded_result->size() == num_components);
+  for (size_t i = 0; i < num_components; ++i) {
+    auto& array = (*decoded_result)[i];
+    const auto& component_spec = component_specs[i];
+    // A component equal to the fill value is represented by an invalid
+    // array, which avoids retaining a copy of the fill value in the cache.
+    // This is only equivalent if writeback does not need to distinguish a
+    // stored chunk equal to the fill value from a missing chunk.
+    if (!component_spec.store_if_equal_to_fill_value && array.valid() &&
+        AreArraysSameValueEqual(array, component_spec.fill_value)) {
+      array = {};
+    }
+    new_read_data.get()[i] = std::move(array);
+  }
+  execution::set_value(
+      receiver, std::static_pointer_cast<ReadData>(std::move(new_read_data)));
+}
+}  // namespace
+
 void DataCache::Entry::DoDecode(std::optional<absl::Cord> value,
                                 DecodeReceiver receiver) {
   GetOwningCache(*this).executor()([this, value = std::move(value),
@@ -1129,24 +1483,94 @@ void DataCache::Entry::DoDecode(std::optional<absl::Cord> value,
       return;
     }
     auto& cache = GetOwningCache(*this);
-    auto decoded_result = cache.DecodeChunk(
-        cache.initial_metadata_.get(), this->cell_indices(), std::move(*value));
-    if (!decoded_result.ok()) {
-      execution::set_error(receiver,
-                           internal::ConvertInvalidArgumentToFailedPrecondition(
-                               std::move(decoded_result).status()));
+    SetDecodedChunk(*this,
+                    cache.DecodeChunk(cache.initial_metadata_.get(),
+                                      this->cell_indices(), std::move(*value)),
+                    receiver);
+  });
+}
+
+bool DataCache::Entry::SupportsStreamingDecode() {
+  auto& cache = GetOwningCache(*this);
+  return cache.SupportsStreamingDecode(cache.initial_metadata_.get());
+}
+
+namespace {
+/// Feeds a chunk that is delivered incrementally to a `ChunkStreamDecoder`.
+///
+/// Runs on the cache executor whenever more of the chunk has been received,
+/// and never waits for the chunk to be received.
+struct StreamingDecodeOp {
+  DataCache::Entry* entry;
+  internal::CordStreamPtr value;
+  std::unique_ptr<DataCache::ChunkStreamDecoder> decoder;
+  DataCache::Entry::DecodeReceiver receiver;
+
+  void operator()() {
+    absl::Cord data;
+    auto finished = value->TryReadAvailable(data);
+    if (!data.empty()) {
+      if (auto status = decoder->Feed(data); !status.ok()) {
+        SetDecodedChunk(*entry, std::move(status), receiver);
+        return;
+      }
+    }
+    if (!finished.ok()) {
+      execution::set_error(receiver, std::move(finished).status());
+      return;
+    }
+    if (*finished) {
+      SetDecodedChunk(*entry, decoder->Finish(), receiver);
+      return;
+    }
+    auto available = value->WhenAvailable();
+    std::move(available).ExecuteWhenReady(
+        [op = std::move(*this)](ReadyFuture<const void> future) mutable {
+          auto executor = GetOwningCache(*op.entry).executor();
+          executor(std::move(op));
+        });
+  }
+};
+}  // namespace
+
+void DataCache::Entry::DoDecodeStream(internal::CordStreamPtr value,
+                                      DecodeReceiver receiver) {
+  GetOwningCache(*this).executor()([this, value = std::move(value),
+                                    receiver = std::move(receiver)]() mutable {
+    if (!value) {
+      execution::set_value(receiver, nullptr);
       return;
     }
-    const size_t num_components = this->component_specs().size();
-    auto new_read_data =
-        internal::make_shared_for_overwrite<ReadData[]>(num_components);
-    assert(decoded_result->size() == num_components);
-    std::copy_n(decoded_result->begin(), num_components, new_read_data.get());
-    execution::set_value(
-        receiver, std::static_pointer_cast<ReadData>(std::move(new_read_data)));
+    auto& cache = GetOwningCache(*this);
+    StreamingDecodeOp{this, std::move(value),
+                      cache.GetChunkStreamDecoder(cache.initial_metadata_.get(),
+                                                  this->cell_indices()),
+                      std::move(receiver)}();
   });
 }
 
+size_t DataCache::Entry::EstimateInFlightBytes() {
+  // Upper bound on the decoded size of the chunk.  The encoded value is not
+  // accounted for separately, since it is usually no larger and is released
+  // once decoding completes.
+  size_t bytes = 0;
+  for (const auto& component : GetOwningCache(*this).grid().components) {
+    bytes += component.num_elements() * component.dtype().size();
+  }
+  return bytes;
+}
+
+bool DataCache::SupportsStreamingDecode(const void* metadata) {
+  return false;
+}
+
+DataCache::ChunkStreamDecoder::~ChunkStreamDecoder() = default;
+
+std::unique_ptr<DataCache::ChunkStreamDecoder> DataCache::GetChunkStreamDecoder(
+    const void* metadata, span<const Index> chunk_indices) {
+  return nullptr;
+}
+
 void DataCache::Entry::DoEncode(std::shared_ptr<const ReadData> data,
                                 EncodeReceiver receiver) {
   if (!data) {
@@ -1199,8 +1623,9 @@ internal::CachePtr<MetadataCache> GetOrCreateMetadataCache(OpenState* state) {
       [&] {
         ABSL_LOG_IF(INFO, TENSORSTORE_KVS_DRIVER_DEBUG)
             << "Creating metadata cache: open_state=" << state;
-        return state->GetMetadataCache(
-            {base.spec_->data_copy_concurrency, base.spec_->cache_pool});
+        return state->GetMetadataCache({base.spec_->data_copy_concurrency,
+                                        base.spec_->cache_pool,
+                                        base.spec_->in_flight_bytes});
       },
       [&](Promise<void> initialized,
           internal::CachePtr<MetadataCache> metadata_cache) {
@@ -1410,7 +1835,6 @@ void KvsDriverBase::GarbageCollectionBase::Visit(
                                              *metadata_cache->base_store());
 }
 
-namespace jb = tensorstore::internal_json_binding;
 TENSORSTORE_DEFINE_JSON_BINDER(
     SpecJsonBinder,
     jb::Sequence(
@@ -1418,6 +1842,8 @@ TENSORSTORE_DEFINE_JSON_BINDER(
                    jb::Projection<&KvsDriverSpec::data_copy_concurrency>()),
         jb::Member(internal::CachePoolResource::id,
                    jb::Projection<&KvsDriverSpec::cache_pool>()),
+        jb::Member(internal::InFlightBytesResource::id,
+                   jb::Projection<&KvsDriverSpec::in_flight_bytes>()),
         jb::Projection<&KvsDriverSpec::store>(jb::KvStoreSpecAndPathJsonBinder),
         jb::Initialize([](auto* obj) {
           internal::EnsureDirectoryPath(obj->store.path);
@@ -1432,6 +1858,8 @@ TENSORSTORE_DEFINE_JSON_BINDER(
             jb::Member("recheck_cached_data",
                        jb::Projection(&StalenessBounds::data,
                                       jb::DefaultInitializedValue())))),
+        jb::Member("chunk_statistics",
+                   jb::Projection<&KvsDriverSpec::chunk_statistics>()),
         internal::OpenModeSpecJsonBinder));
 
 }  // namespace internal_kvs_backed_chunk_driver
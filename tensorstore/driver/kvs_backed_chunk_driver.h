@@ -22,11 +22,14 @@
 /// chunk.
 
 #include <memory>
+#include <optional>
 #include <string_view>
+#include <vector>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "tensorstore/box.h"
+#include "tensorstore/chunk_statistics.h"
 #include "tensorstore/driver/registry.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/index_transform.h"
@@ -37,15 +40,19 @@
 #include "tensorstore/internal/cache/chunk_cache.h"
 #include "tensorstore/internal/cache/kvs_backed_cache.h"
 #include "tensorstore/internal/context_binding.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/estimate_heap_usage/std_vector.h"
+#include "tensorstore/internal/in_flight_bytes_resource.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/open_mode_spec.h"
 #include "tensorstore/internal/type_traits.h"
+#include "tensorstore/io_cost.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/serialization/absl_time.h"
+#include "tensorstore/serialization/std_optional.h"
 #include "tensorstore/spec.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
@@ -63,12 +70,17 @@ struct KvsDriverSpec : public internal::DriverSpec,
   Context::Resource<internal::DataCopyConcurrencyResource>
       data_copy_concurrency;
   Context::Resource<internal::CachePoolResource> cache_pool;
+  Context::Resource<internal::InFlightBytesResource> in_flight_bytes;
   StalenessBounds staleness;
 
+  /// If specified, per-chunk statistics are maintained when writing chunks.
+  std::optional<ChunkStatisticsOptions> chunk_statistics;
+
   static constexpr auto ApplyMembers = [](auto& x, auto f) {
     return f(internal::BaseCast<internal::DriverSpec>(x),
              internal::BaseCast<internal::OpenModeSpec>(x), x.store,
-             x.data_copy_concurrency, x.cache_pool, x.staleness);
+             x.data_copy_concurrency, x.cache_pool, x.in_flight_bytes,
+             x.staleness, x.chunk_statistics);
   };
 
   kvstore::Spec GetKvstore() const override;
@@ -134,6 +146,7 @@ class MetadataCache
     Context::Resource<internal::DataCopyConcurrencyResource>
         data_copy_concurrency;
     Context::Resource<internal::CachePoolResource> cache_pool;
+    Context::Resource<internal::InFlightBytesResource> in_flight_bytes;
   };
 
   explicit MetadataCache(Initializer initializer);
@@ -264,6 +277,7 @@ class MetadataCache
   Context::Resource<internal::DataCopyConcurrencyResource>
       data_copy_concurrency_;
   Context::Resource<internal::CachePoolResource> cache_pool_;
+  Context::Resource<internal::InFlightBytesResource> in_flight_bytes_;
 };
 
 /// Inherits from `ChunkCache` and represents one or more chunked arrays that
@@ -284,6 +298,7 @@ class DataCache
     kvstore::DriverPtr store;
     internal::PinnedCacheEntry<MetadataCache> metadata_cache_entry;
     MetadataPtr metadata;
+    std::optional<ChunkStatisticsOptions> chunk_statistics;
   };
 
   explicit DataCache(Initializer initializer,
@@ -292,6 +307,18 @@ class DataCache
   virtual std::string GetChunkStorageKey(const void* metadata,
                                          span<const Index> cell_indices) = 0;
 
+  /// Returns the key, within the base kvstore, under which the statistics of
+  /// the specified chunk are stored if `chunk_statistics_` is specified.
+  ///
+  /// By default, returns `GetBaseKvstorePath() + ".chunk_statistics/"`
+  /// followed by the cell indices joined by `"."`.  Drivers that store
+  /// multiple arrays under the same base path must override this.
+  ///
+  /// \param metadata Non-null pointer to metadata of type `Metadata`.
+  /// \param cell_indices The chunk grid cell indices.
+  virtual std::string GetChunkStatisticsKey(const void* metadata,
+                                            span<const Index> cell_indices);
+
   /// Fills `bounds`, `implicit_lower_bounds`, and `implicit_upper_bounds` with
   /// the current bounds for the chunked dimensions as specified in `metadata`.
   ///
@@ -330,6 +357,12 @@ class DataCache
 
   Result<ChunkLayout> GetChunkLayout(std::size_t component_index) override;
 
+  /// Reads the chunk from the kvstore with `if_not_equal` specified, which
+  /// avoids transferring the value if it is unchanged.
+  Future<TimestampedStorageGeneration> ReadGeneration(
+      span<const Index> cell_indices, StorageGeneration if_not_equal,
+      absl::Time staleness_bound) override;
+
   /// Returns the encoding for the specified component.
   ///
   /// By default, just returns a null pointer to indicate an unknown encoding.
@@ -414,6 +447,46 @@ class DataCache
   DecodeChunk(const void* metadata, span<const Index> chunk_indices,
               absl::Cord data) = 0;
 
+  /// Decoder for a data chunk that is delivered incrementally.
+  ///
+  /// `Feed` is called from `executor()` with each successive piece of the
+  /// encoded chunk as it is received, followed by a single call to `Finish`.
+  /// Neither call may block.
+  class ChunkStreamDecoder {
+   public:
+    virtual ~ChunkStreamDecoder();
+
+    /// Decodes the next piece of the encoded chunk.
+    virtual absl::Status Feed(const absl::Cord& data) = 0;
+
+    /// Completes decoding once the entire encoded chunk has been fed.
+    ///
+    /// \returns On success, returns a decoded array for each component, as for
+    ///     `DecodeChunk`.
+    virtual Result<absl::InlinedVector<SharedArrayView<const void>, 1>>
+    Finish() = 0;
+  };
+
+  /// Specifies whether chunks are read incrementally and decoded with
+  /// `GetChunkStreamDecoder`.
+  ///
+  /// Drivers should only return `true` if the decoder makes progress before
+  /// the complete data is available, e.g. if the chunks are compressed with a
+  /// compressor that supports incremental decoding.  The default
+  /// implementation returns `false`.
+  ///
+  /// \param metadata The metadata (which may determine the decoding).
+  virtual bool SupportsStreamingDecode(const void* metadata);
+
+  /// Returns a decoder for a data chunk that is delivered incrementally.
+  ///
+  /// Only called if `SupportsStreamingDecode(metadata)` returns `true`.  The
+  /// default implementation returns `nullptr`.
+  ///
+  /// \param metadata The metadata (which may determine the decoding).
+  virtual std::unique_ptr<ChunkStreamDecoder> GetChunkStreamDecoder(
+      const void* metadata, span<const Index> chunk_indices);
+
   /// Encodes a data chunk.
   ///
   /// \param metadata The metadata (which may determine the encoding).
@@ -432,9 +505,23 @@ class DataCache
     using OwningCache = DataCache;
     void DoDecode(std::optional<absl::Cord> value,
                   DecodeReceiver receiver) override;
+    bool SupportsStreamingDecode() override;
+    void DoDecodeStream(internal::CordStreamPtr value,
+                        DecodeReceiver receiver) override;
     void DoEncode(std::shared_ptr<const ReadData> data,
                   EncodeReceiver receiver) override;
     std::string GetKeyValueStoreKey() override;
+    size_t EstimateInFlightBytes() override;
+  };
+
+  class TransactionNode : public Base::TransactionNode {
+   public:
+    using OwningCache = DataCache;
+    using Base::TransactionNode::TransactionNode;
+
+    /// Writes the chunk statistics, if enabled, before completing the
+    /// writeback.
+    void WritebackSuccess(ReadState&& read_state) override;
   };
 
   Entry* DoAllocateEntry() final { return new Entry; }
@@ -452,6 +539,7 @@ class DataCache
 
   const internal::PinnedCacheEntry<MetadataCache> metadata_cache_entry_;
   const MetadataPtr initial_metadata_;
+  const std::optional<ChunkStatisticsOptions> chunk_statistics_;
 };
 
 /// Private data members of `OpenState`.
@@ -509,6 +597,22 @@ class KvsDriverBase : public internal::ChunkCacheDriver {
 
   KvStore GetKvstore() override;
 
+  /// Uses the stored chunk statistics, if enabled, to exclude chunks.
+  ///
+  /// The statistics of a chunk are only used if the chunk has not been
+  /// modified since they were written, which is verified by a conditional read
+  /// of the chunk that does not transfer any data if unmodified.  If
+  /// `transaction` is specified, statistics are not used.
+  Future<std::vector<Box<>>> FindChunks(
+      internal::OpenTransactionPtr transaction, IndexTransform<> transform,
+      ChunkStatisticsQuery query) override;
+
+  /// Extends `ChunkCacheDriver::ExplainIo` with the kvstore URL and the key of
+  /// each chunk.
+  Result<IoCostReport> ExplainIo(internal::OpenTransactionPtr transaction,
+                                 IndexTransform<> transform,
+                                 ReadWriteMode mode) override;
+
   /// Base class intended for use in implementing
   /// `tensorstore::garbage_collection::GarbageCollection<Derived>`
   /// specializations for `Derived` driver types.
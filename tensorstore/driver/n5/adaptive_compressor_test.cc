@@ -0,0 +1,77 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/array.h"
+#include "tensorstore/driver/n5/compressor.h"
+#include "tensorstore/driver/n5/metadata.h"
+#include "tensorstore/internal/json_binding/gtest.h"
+#include "tensorstore/internal/json_gtest.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Index;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::span;
+using ::tensorstore::internal_n5::Compressor;
+using ::tensorstore::internal_n5::DecodeChunk;
+using ::tensorstore::internal_n5::N5Metadata;
+
+TEST(AdaptiveCompressionTest, Parse) {
+  tensorstore::TestJsonBinderRoundTripJsonOnly<Compressor>({
+      {{"type", "adaptive"},
+       {"candidates",
+        {{{"cname", "lz4"}, {"clevel", 1}, {"shuffle", 2}},
+         {{"cname", "zstd"}, {"clevel", 3}, {"shuffle", 1}}}},
+       {"speed_weight", 0.5},
+       {"sample_bytes", 4096}},
+  });
+
+  // Invalid candidate
+  EXPECT_THAT(Compressor::FromJson({{"type", "adaptive"},
+                                    {"candidates", {{{"cname", "lz4"}}}}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+
+  // Invalid speed_weight
+  EXPECT_THAT(
+      Compressor::FromJson({{"type", "adaptive"}, {"speed_weight", "a"}}),
+      MatchesStatus(absl::StatusCode::kInvalidArgument));
+
+  // Invalid extra option
+  EXPECT_THAT(Compressor::FromJson({{"type", "adaptive"}, {"extra", 5}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AdaptiveCompressionTest, RoundTrip) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto metadata,
+      N5Metadata::FromJson({{"dimensions", {10, 11, 12}},
+                            {"blockSize", {1, 2, 3}},
+                            {"dataType", "uint16"},
+                            {"compression", {{"type", "adaptive"}}}}));
+  auto array = MakeArray<std::uint16_t>({{{1, 2, 3}, {4, 5, 6}}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto buffer, EncodeChunk(span<const Index>({0, 0, 0}), metadata, array));
+  EXPECT_EQ(array, DecodeChunk(metadata, buffer));
+}
+
+}  // namespace
@@ -15,6 +15,7 @@
 #include "tensorstore/driver/driver.h"
 
 #include "absl/status/status.h"
+#include "absl/strings/str_join.h"
 #include "tensorstore/context.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/kvs_backed_chunk_driver.h"
@@ -33,6 +34,7 @@
 #include "tensorstore/util/constant_vector.h"
 #include "tensorstore/util/division.h"
 #include "tensorstore/util/future.h"
+#include "tensorstore/util/str_cat.h"
 
 namespace tensorstore {
 namespace internal_neuroglancer_precomputed {
@@ -351,6 +353,16 @@ class DataCacheBase : public internal_kvs_backed_chunk_driver::DataCache {
 
   std::string GetBaseKvstorePath() override { return key_prefix_; }
 
+  std::string GetChunkStatisticsKey(const void* metadata_ptr,
+                                    span<const Index> cell_indices) override {
+    // All scales share the same base path.
+    const auto& metadata =
+        *static_cast<const MultiscaleMetadata*>(metadata_ptr);
+    return tensorstore::StrCat(
+        ResolveScaleKey(key_prefix_, metadata.scales[scale_index_].key),
+        "/.chunk_statistics/", absl::StrJoin(cell_indices, "."));
+  }
+
   std::string key_prefix_;
   std::size_t scale_index_;
   // channel, z, y, x
@@ -14,12 +14,18 @@
 
 #include "tensorstore/driver/read.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <type_traits>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/array.h"
 #include "tensorstore/box.h"
 #include "tensorstore/container_kind.h"
@@ -31,6 +37,8 @@
 #include "tensorstore/driver/driver_handle.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/alignment.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/index_space/index_domain.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/intrusive_ptr.h"
@@ -42,11 +50,13 @@
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/internal/type_traits.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/resize_options.h"
+#include "tensorstore/strided_layout.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/element_pointer.h"
 #include "tensorstore/util/execution/sender.h"
@@ -103,6 +113,7 @@ struct ReadState
   TransformedArray<Shared<void>> target;
   DomainAlignmentOptions alignment_options;
   ReadProgressFunction read_progress_function;
+  IoStatisticsPtr io_statistics;
   Promise<PromiseValue> promise;
   std::atomic<Index> copied_elements{0};
   Index total_elements;
@@ -118,6 +129,10 @@ struct ReadState
   }
 };
 
+/// Minimum number of bytes copied by a single `ReadChunkOp`.  Larger chunks
+/// are split into pieces that are copied in parallel by the executor.
+constexpr Index kMinReadChunkOpBytes = 1024 * 1024;
+
 /// Callback invoked by `ReadChunkReceiver` (using the executor) to copy data
 /// from a single `ReadChunk` to the appropriate portion of the `target` array.
 template <typename PromiseValue>
@@ -125,22 +140,53 @@ struct ReadChunkOp {
   IntrusivePtr<ReadState<PromiseValue>> state;
   ReadChunk chunk;
   IndexTransform<> cell_transform;
+
+  /// Indicates whether this operation may be split into multiple operations.
+  bool may_split = true;
+
   void operator()() {
+    if (may_split && Split()) return;
     // Map the portion of the target array that corresponds to this chunk to
     // the index space expected by the chunk.
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto target,
         ApplyIndexTransform(std::move(cell_transform), state->target),
         state->SetError(_));
+    const absl::Time start_time =
+        state->io_statistics ? absl::Now() : absl::InfinitePast();
     absl::Status copy_status =
         internal::CopyReadChunk(chunk.impl, std::move(chunk.transform),
                                 state->data_type_conversion, target);
+    if (state->io_statistics) {
+      state->io_statistics->RecordCopyTime(absl::Now() - start_time);
+    }
     if (copy_status.ok()) {
       state->UpdateProgress(ProductOfExtents(target.shape()));
     } else {
       state->SetError(std::move(copy_status));
     }
   }
+
+  /// Splits the chunk into pieces of at least `kMinReadChunkOpBytes`, and
+  /// schedules a separate operation for each piece.
+  ///
+  /// \returns `false` if the chunk is too small to split.
+  bool Split() {
+    const Index max_pieces = cell_transform.domain().num_elements() *
+                             state->target.dtype()->size / kMinReadChunkOpBytes;
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        bool split,
+        SplitReadChunk(chunk, cell_transform, max_pieces,
+                       [&](ReadChunk piece_chunk,
+                           IndexTransform<> piece_cell_transform) {
+                         state->executor(ReadChunkOp<PromiseValue>{
+                             state, std::move(piece_chunk),
+                             std::move(piece_cell_transform),
+                             /*may_split=*/false});
+                       }),
+        (state->SetError(_), true));
+    return split;
+  }
 };
 
 /// FlowReceiver used by the two `DriverRead` overloads to copy data from chunks
@@ -157,6 +203,7 @@ struct ReadChunkReceiver {
   void set_done() {}
   void set_error(absl::Status error) { state->SetError(std::move(error)); }
   void set_value(ReadChunk chunk, IndexTransform<> cell_transform) {
+    if (state->io_statistics) state->io_statistics->RecordChunk();
     // Defer all work to the executor, because we don't know on which thread
     // this may be called.
     state->executor(ReadChunkOp<PromiseValue>{state, std::move(chunk),
@@ -185,6 +232,8 @@ struct DriverReadIntoExistingInitiateOp {
     // Initiate the read on the driver.
     auto source_driver = std::move(state->source_driver);
     auto source_transaction = std::move(state->source_transaction);
+    internal::ScopedIoStatistics scoped_io_statistics(
+        state->io_statistics.get());
     source_driver->Read(std::move(source_transaction),
                         std::move(source_transform),
                         ReadChunkReceiver<void>{std::move(state)});
@@ -219,12 +268,196 @@ struct DriverReadIntoNewInitiateOp {
     // Initiate the read on the driver.
     auto source_driver = std::move(state->source_driver);
     auto source_transaction = std::move(state->source_transaction);
+    internal::ScopedIoStatistics scoped_io_statistics(
+        state->io_statistics.get());
     source_driver->Read(
         std::move(source_transaction), std::move(source_transform),
         ReadChunkReceiver<SharedOffsetArray<void>>{std::move(state)});
   }
 };
 
+/// Returns `true` if `layout` is contiguous in the specified `order`.  The byte
+/// strides of dimensions of size 1 are ignored.
+bool IsContiguousLayout(StridedLayoutView<dynamic_rank, offset_origin> layout,
+                        ContiguousLayoutOrder order, Index element_size) {
+  const DimensionIndex rank = layout.rank();
+  Index byte_stride = element_size;
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    const DimensionIndex dim = (order == c_order) ? rank - 1 - i : i;
+    const Index size = layout.shape()[dim];
+    if (size != 1 && layout.byte_strides()[dim] != byte_stride) return false;
+    byte_stride *= size;
+  }
+  return true;
+}
+
+/// Local state for the asynchronous operation initiated by
+/// `DriverReadIntoSharedArray`.
+///
+/// This proceeds in the same way as `DriverReadIntoNewArray`, except that the
+/// `target` array is not allocated until a chunk that cannot be referenced
+/// directly is received.
+struct SharedArrayReadState
+    : public internal::AtomicReferenceCount<SharedArrayReadState> {
+  Executor executor;
+  DriverPtr source_driver;
+  internal::OpenTransactionPtr source_transaction;
+  DataType dtype;
+  ContiguousLayoutOrder target_layout_order;
+  ReadProgressFunction read_progress_function;
+  IoStatisticsPtr io_statistics;
+  Promise<SharedOffsetArray<const void>> promise;
+  IndexDomain<> domain;
+  std::atomic<Index> copied_elements{0};
+  Index total_elements;
+
+  absl::Mutex mutex;
+
+  /// Newly-allocated array into which chunks are copied.  Only valid once a
+  /// chunk has been received that cannot be referenced directly.
+  SharedOffsetArray<void> target ABSL_GUARDED_BY(mutex);
+
+  /// Array to be returned, either a reference to the data of a single chunk,
+  /// or equal to `target`.
+  SharedOffsetArray<const void> result ABSL_GUARDED_BY(mutex);
+
+  ~SharedArrayReadState() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    // Has no effect if an error has already been set.
+    if (!promise.null() && result.valid()) {
+      SetDeferredResult(promise, std::move(result));
+    }
+  }
+
+  void SetError(absl::Status error) {
+    SetDeferredResult(promise, std::move(error));
+  }
+
+  void UpdateProgress(Index num_elements) {
+    if (!read_progress_function) return;
+    read_progress_function(
+        ReadProgress{total_elements, copied_elements += num_elements});
+  }
+
+  /// Returns the `target` array, allocating it if necessary.
+  SharedOffsetArray<void> GetTarget() {
+    absl::MutexLock lock(&mutex);
+    if (!target.valid()) {
+      target = AllocateArray(domain.box(), target_layout_order, default_init,
+                             dtype);
+      result = target;
+    }
+    return target;
+  }
+};
+
+/// Callback invoked by `SharedArrayReadChunkReceiver` (using the executor) to
+/// either reference or copy the data from a single `ReadChunk`.
+struct SharedArrayReadChunkOp {
+  IntrusivePtr<SharedArrayReadState> state;
+  ReadChunk chunk;
+  IndexTransform<> cell_transform;
+
+  void operator()() {
+    const Index num_elements = cell_transform.domain().num_elements();
+    if (num_elements == state->total_elements) {
+      // Since chunks are disjoint, this chunk is the only chunk.
+      TENSORSTORE_ASSIGN_OR_RETURN(auto array, GetSharedArray(),
+                                   state->SetError(_));
+      if (array.valid() && array.domain() == state->domain.box() &&
+          IsContiguousLayout(array.layout(), state->target_layout_order,
+                             array.dtype()->size)) {
+        {
+          absl::MutexLock lock(&state->mutex);
+          state->result = std::move(array);
+        }
+        state->UpdateProgress(num_elements);
+        return;
+      }
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto target,
+        ApplyIndexTransform(
+            std::move(cell_transform),
+            TransformedArray<Shared<void>>(state->GetTarget())),
+        state->SetError(_));
+    const absl::Time start_time =
+        state->io_statistics ? absl::Now() : absl::InfinitePast();
+    absl::Status copy_status = internal::CopyReadChunk(
+        chunk.impl, std::move(chunk.transform), target);
+    if (state->io_statistics) {
+      state->io_statistics->RecordCopyTime(absl::Now() - start_time);
+    }
+    if (copy_status.ok()) {
+      state->UpdateProgress(num_elements);
+    } else {
+      state->SetError(std::move(copy_status));
+    }
+  }
+
+  /// Returns the chunk data as an array over the read domain, or a null array
+  /// if it cannot be referenced directly.
+  Result<SharedOffsetArray<const void>> GetSharedArray() {
+    auto inverse_cell_transform = InverseTransform(cell_transform);
+    if (!inverse_cell_transform.ok()) return SharedOffsetArray<const void>();
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto transform,
+        ComposeTransforms(chunk.transform, *inverse_cell_transform));
+    return chunk.impl(ReadChunk::GetSharedArray{}, std::move(transform));
+  }
+};
+
+/// FlowReceiver used by `DriverReadIntoSharedArray`.
+struct SharedArrayReadChunkReceiver {
+  IntrusivePtr<SharedArrayReadState> state;
+  FutureCallbackRegistration cancel_registration;
+  void set_starting(AnyCancelReceiver cancel) {
+    cancel_registration =
+        state->promise.ExecuteWhenNotNeeded(std::move(cancel));
+  }
+  void set_stopping() { cancel_registration(); }
+  void set_done() {}
+  void set_error(absl::Status error) { state->SetError(std::move(error)); }
+  void set_value(ReadChunk chunk, IndexTransform<> cell_transform) {
+    if (state->io_statistics) state->io_statistics->RecordChunk();
+    state->executor(SharedArrayReadChunkOp{state, std::move(chunk),
+                                           std::move(cell_transform)});
+  }
+};
+
+/// Callback used by `DriverReadIntoSharedArray` to initiate the read once the
+/// source transform bounds have been resolved.
+struct DriverReadIntoSharedArrayInitiateOp {
+  IntrusivePtr<SharedArrayReadState> state;
+  void operator()(Promise<SharedOffsetArray<const void>> promise,
+                  ReadyFuture<IndexTransform<>> source_transform_future) {
+    IndexTransform<> source_transform =
+        std::move(source_transform_future.value());
+
+    if (!IsFinite(source_transform.domain())) {
+      promise.SetResult(absl::InvalidArgumentError(tensorstore::StrCat(
+          "Read requires a finite domain, got ", source_transform.domain())));
+      return;
+    }
+
+    state->domain = source_transform.domain();
+    state->promise = std::move(promise);
+    state->total_elements = source_transform.input_domain().num_elements();
+    if (state->total_elements == 0) {
+      // No chunks will be received.
+      state->GetTarget();
+    }
+
+    // Initiate the read on the driver.
+    auto source_driver = std::move(state->source_driver);
+    auto source_transaction = std::move(state->source_transaction);
+    internal::ScopedIoStatistics scoped_io_statistics(
+        state->io_statistics.get());
+    source_driver->Read(std::move(source_transaction),
+                        std::move(source_transform),
+                        SharedArrayReadChunkReceiver{std::move(state)});
+  }
+};
+
 }  // namespace
 
 Future<void> DriverRead(Executor executor, DriverHandle source,
@@ -246,6 +479,7 @@ Future<void> DriverRead(Executor executor, DriverHandle source,
   state->target = std::move(target);
   state->alignment_options = options.alignment_options;
   state->read_progress_function = std::move(options.progress_function);
+  state->io_statistics = std::move(options.io_statistics);
   auto pair = PromiseFuturePair<void>::Make(MakeResult());
 
   // Resolve the bounds for `source.transform`.
@@ -267,7 +501,10 @@ Future<void> DriverRead(DriverHandle source,
   return internal::DriverRead(
       std::move(executor), std::move(source), std::move(target), /*options=*/
       {/*.progress_function=*/std::move(options.progress_function),
-       /*.alignment_options=*/options.alignment_options});
+       /*.alignment_options=*/options.alignment_options,
+       /*.data_type_conversion_flags=*/
+       DataTypeConversionFlags::kSafeAndImplicit,
+       /*.io_statistics=*/std::move(options.io_statistics)});
 }
 
 Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
@@ -287,6 +524,7 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
       state->source_transaction,
       internal::AcquireOpenTransactionPtrOrError(source.transaction));
   state->read_progress_function = std::move(options.progress_function);
+  state->io_statistics = std::move(options.io_statistics);
   auto pair = PromiseFuturePair<SharedOffsetArray<void>>::Make();
 
   // Resolve the bounds for `source.transform`.
@@ -310,7 +548,48 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
   return internal::DriverReadIntoNewArray(
       std::move(executor), std::move(source), dtype, options.layout_order,
       /*options=*/
-      {/*.progress_function=*/std::move(options.progress_function)});
+      {/*.progress_function=*/std::move(options.progress_function),
+       /*.io_statistics=*/std::move(options.io_statistics)});
+}
+
+Future<SharedOffsetArray<const void>> DriverReadIntoSharedArray(
+    Executor executor, DriverHandle source,
+    ContiguousLayoutOrder target_layout_order,
+    DriverReadIntoNewOptions options) {
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::ValidateSupportsRead(source.driver.read_write_mode()));
+  IntrusivePtr<SharedArrayReadState> state(new SharedArrayReadState);
+  state->executor = executor;
+  state->dtype = source.driver->dtype();
+  state->source_driver = std::move(source.driver);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      state->source_transaction,
+      internal::AcquireOpenTransactionPtrOrError(source.transaction));
+  state->target_layout_order = target_layout_order;
+  state->read_progress_function = std::move(options.progress_function);
+  state->io_statistics = std::move(options.io_statistics);
+  auto pair = PromiseFuturePair<SharedOffsetArray<const void>>::Make();
+
+  // Resolve the bounds for `source.transform`.
+  auto transform_future = state->source_driver->ResolveBounds(
+      state->source_transaction, std::move(source.transform),
+      fix_resizable_bounds);
+
+  // Initiate the read once the bounds have been resolved.
+  LinkValue(WithExecutor(std::move(executor),
+                         DriverReadIntoSharedArrayInitiateOp{std::move(state)}),
+            std::move(pair.promise), std::move(transform_future));
+  return std::move(pair.future);
+}
+
+Future<SharedOffsetArray<const void>> DriverReadIntoSharedArray(
+    DriverHandle source, ReadIntoSharedArrayOptions options) {
+  auto executor = source.driver->data_copy_executor();
+  return internal::DriverReadIntoSharedArray(
+      std::move(executor), std::move(source), options.layout_order,
+      /*options=*/
+      {/*.progress_function=*/std::move(options.progress_function),
+       /*.io_statistics=*/std::move(options.io_statistics)});
 }
 
 absl::Status CopyReadChunk(
@@ -348,5 +627,35 @@ absl::Status CopyReadChunk(ReadChunk::Impl& chunk,
                        std::move(target));
 }
 
+Result<bool> SplitReadChunk(
+    const ReadChunk& chunk, const IndexTransform<>& cell_transform,
+    Index max_pieces,
+    absl::FunctionRef<void(ReadChunk chunk, IndexTransform<> cell_transform)>
+        callback) {
+  if (max_pieces < 2) return false;
+  const auto domain = cell_transform.domain();
+  DimensionIndex dim = 0;
+  while (dim < domain.rank() && domain.shape()[dim] <= 1) ++dim;
+  if (dim == domain.rank()) return false;
+  const Index origin = domain.origin()[dim];
+  const Index size = domain.shape()[dim];
+  const Index num_pieces = std::min(max_pieces, size);
+  Index start = origin;
+  for (Index piece = 0; piece < num_pieces; ++piece) {
+    const Index stop =
+        start + size / num_pieces + (piece < size % num_pieces ? 1 : 0);
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto piece_cell_transform,
+        cell_transform | Dims(dim).HalfOpenInterval(start, stop));
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto piece_chunk_transform,
+        chunk.transform | Dims(dim).HalfOpenInterval(start, stop));
+    callback(ReadChunk{chunk.impl, std::move(piece_chunk_transform)},
+             std::move(piece_cell_transform));
+    start = stop;
+  }
+  return true;
+}
+
 }  // namespace internal
 }  // namespace tensorstore
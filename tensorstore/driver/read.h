@@ -15,6 +15,7 @@
 #ifndef TENSORSTORE_DRIVER_READ_H_
 #define TENSORSTORE_DRIVER_READ_H_
 
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
 #include "tensorstore/container_kind.h"
@@ -22,14 +23,17 @@
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/chunk.h"
 #include "tensorstore/driver/driver_handle.h"
+#include "tensorstore/index.h"
 #include "tensorstore/index_space/alignment.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
 
 namespace tensorstore {
 namespace internal {
@@ -48,6 +52,9 @@ struct DriverReadOptions {
 
   DataTypeConversionFlags data_type_conversion_flags =
       DataTypeConversionFlags::kSafeAndImplicit;
+
+  /// Optional sink for the I/O statistics of the read.
+  IoStatisticsPtr io_statistics;
 };
 
 struct DriverReadIntoNewOptions {
@@ -58,6 +65,9 @@ struct DriverReadIntoNewOptions {
   /// monotonically increasing.  The `total_elements` value does not change
   /// after the first call.
   ReadProgressFunction progress_function;
+
+  /// Optional sink for the I/O statistics of the read.
+  IoStatisticsPtr io_statistics;
 };
 
 /// Copies data from a TensorStore driver to an array.
@@ -105,6 +115,30 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
 Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
     DriverHandle source, ReadIntoNewArrayOptions options);
 
+/// Reads from a TensorStore driver into a read-only array, avoiding a copy
+/// when possible.
+///
+/// If the read is satisfied by a single chunk that supports
+/// `ReadChunk::GetSharedArray`, such as a chunk of a `ChunkCache`, and the
+/// chunk data already has the contiguous `target_layout_order`, the returned
+/// array directly references the cached chunk data and shares ownership of it.
+/// Otherwise, this behaves like `DriverReadIntoNewArray` with a `target_dtype`
+/// of `source.driver->dtype()`.
+///
+/// \param executor Executor to use for copying data.
+/// \param source Read source.
+/// \param target_layout_order Required layout order of the returned array.
+/// \param options Specifies optional progress function.
+/// \returns A future that becomes ready when the data has been read or an
+///     error occurs.
+Future<SharedOffsetArray<const void>> DriverReadIntoSharedArray(
+    Executor executor, DriverHandle source,
+    ContiguousLayoutOrder target_layout_order,
+    DriverReadIntoNewOptions options);
+
+Future<SharedOffsetArray<const void>> DriverReadIntoSharedArray(
+    DriverHandle source, ReadIntoSharedArrayOptions options);
+
 /// Copies `chunk` transformed by `chunk_transform` to `target`.
 absl::Status CopyReadChunk(
     ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
@@ -115,6 +149,23 @@ absl::Status CopyReadChunk(ReadChunk::Impl& chunk,
                            IndexTransform<> chunk_transform,
                            TransformedArray<void, dynamic_rank, view> target);
 
+/// Splits a `ReadChunk` into pieces that may be copied independently.
+///
+/// The domain of `cell_transform`, which must equal the domain of
+/// `chunk.transform`, is partitioned along its first dimension of size greater
+/// than 1 into at most `max_pieces` pieces of nearly equal size, and
+/// `callback` is invoked with the chunk and cell transform of each piece.
+///
+/// \returns `false`, without invoking `callback`, if `max_pieces < 2` or there
+///     is no dimension of size greater than 1.
+/// \error If the piece transforms cannot be computed, in which case `callback`
+///     may already have been invoked for some pieces.
+Result<bool> SplitReadChunk(
+    const ReadChunk& chunk, const IndexTransform<>& cell_transform,
+    Index max_pieces,
+    absl::FunctionRef<void(ReadChunk chunk, IndexTransform<> cell_transform)>
+        callback);
+
 }  // namespace internal
 }  // namespace tensorstore
 
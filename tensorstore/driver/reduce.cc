@@ -0,0 +1,372 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/reduce.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/data_type_conversion.h"
+#include "tensorstore/driver/chunk.h"
+#include "tensorstore/driver/driver.h"
+#include "tensorstore/driver/driver_handle.h"
+#include "tensorstore/driver/read.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/internal/integer_overflow.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/progress.h"
+#include "tensorstore/read_write_options.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal {
+
+namespace {
+
+/// Local state for the asynchronous operation initiated by `DriverReduce`.
+///
+/// This proceeds like `DriverReadIntoNewArray`, except that rather than
+/// copying each chunk into a single target array, each chunk is copied into a
+/// temporary block buffer that is passed to `function` and then freed.
+///
+/// Rather than reading the entire domain at once, the domain is partitioned
+/// by the read chunk grid, enumerated lazily in C order by `next_cell`.  Each
+/// of up to `max_in_flight` concurrent "lanes" reads one grid cell and, once
+/// all chunks of the cell have been reduced, continues with the next cell.
+///
+/// Once all lanes have finished, all references to `ReduceState` are
+/// released, which in turn causes `promise` to become ready.
+struct ReduceState : public internal::AtomicReferenceCount<ReduceState> {
+  Executor executor;
+  DriverPtr source_driver;
+  internal::OpenTransactionPtr source_transaction;
+  DataType dtype;
+  DataTypeConversionLookupResult data_type_conversion;
+  ReduceBlockFunction function;
+  ReadProgressFunction progress_function;
+  Index max_block_bytes;
+  Index max_in_flight;
+  Promise<void> promise;
+  std::atomic<Index> reduced_elements{0};
+  Index total_elements;
+
+  /// Resolved source transform, and the bounds of its domain.
+  IndexTransform<> source_transform;
+  Box<> bounds;
+
+  /// Origin and shape of the read chunk grid.
+  std::vector<Index> grid_origin;
+  std::vector<Index> chunk_shape;
+
+  /// Range of grid cell indices that intersect `bounds`.
+  std::vector<Index> first_cell;
+  std::vector<Index> num_cells;
+
+  Index total_cells;
+  std::atomic<Index> next_cell{0};
+
+  void SetError(absl::Status error) {
+    SetDeferredResult(promise, std::move(error));
+  }
+
+  void UpdateProgress(Index num_elements) {
+    if (!progress_function) return;
+    progress_function(
+        ReadProgress{total_elements, reduced_elements += num_elements});
+  }
+
+  /// Computes the read chunk grid over `bounds`.
+  absl::Status InitGrid(const ChunkLayout& chunk_layout) {
+    const DimensionIndex rank = bounds.rank();
+    const auto read_chunk_shape = chunk_layout.read_chunk_shape();
+    const auto layout_grid_origin = chunk_layout.grid_origin();
+    grid_origin.resize(rank);
+    chunk_shape.resize(rank);
+    first_cell.resize(rank);
+    num_cells.resize(rank);
+    total_cells = 1;
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      const IndexInterval interval = bounds[i];
+      Index chunk_size =
+          read_chunk_shape.size() == rank ? read_chunk_shape[i] : Index(0);
+      Index origin =
+          layout_grid_origin.size() == rank ? layout_grid_origin[i] : kImplicit;
+      if (chunk_size <= 0) {
+        // Treat the entire dimension as a single chunk.
+        chunk_size = std::max(Index(1), interval.size());
+        origin = interval.inclusive_min();
+      } else if (origin == kImplicit) {
+        origin = interval.inclusive_min();
+      }
+      grid_origin[i] = origin;
+      chunk_shape[i] = chunk_size;
+      if (interval.empty()) {
+        num_cells[i] = 0;
+      } else {
+        first_cell[i] =
+            FloorOfRatio(interval.inclusive_min() - origin, chunk_size);
+        num_cells[i] = FloorOfRatio(interval.inclusive_max() - origin,
+                                    chunk_size) -
+                       first_cell[i] + 1;
+      }
+      if (internal::MulOverflow(total_cells, num_cells[i], &total_cells)) {
+        return absl::InvalidArgumentError(tensorstore::StrCat(
+            "Number of read chunks in ", bounds, " exceeds maximum of ",
+            std::numeric_limits<Index>::max()));
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  /// Computes the bounds of the grid cell with the specified linear index.
+  void GetCellBounds(Index cell, MutableBoxView<> cell_bounds) const {
+    for (DimensionIndex i = bounds.rank() - 1; i >= 0; --i) {
+      const Index grid_cell = first_cell[i] + cell % num_cells[i];
+      cell /= num_cells[i];
+      cell_bounds[i] = Intersect(
+          IndexInterval::UncheckedSized(
+              grid_origin[i] + grid_cell * chunk_shape[i], chunk_shape[i]),
+          bounds[i]);
+    }
+  }
+};
+
+void StartNextCell(IntrusivePtr<ReduceState> state);
+
+/// Reference held by each operation that processes the chunks of a single
+/// grid cell.  Once the last reference is released, the lane continues with
+/// the next cell.
+struct ReduceCellState
+    : public internal::AtomicReferenceCount<ReduceCellState> {
+  explicit ReduceCellState(IntrusivePtr<ReduceState> state)
+      : state(std::move(state)) {}
+
+  ~ReduceCellState() {
+    // Start the next cell from the executor to avoid unbounded recursion if
+    // the read completes synchronously.
+    auto executor = state->executor;
+    executor([state = std::move(state)]() mutable {
+      StartNextCell(std::move(state));
+    });
+  }
+
+  IntrusivePtr<ReduceState> state;
+};
+
+/// Callback invoked by `ReduceChunkReceiver` (using the executor) to reduce a
+/// single `ReadChunk`, or a portion of one.
+struct ReduceChunkOp {
+  IntrusivePtr<ReduceCellState> cell;
+  ReadChunk chunk;
+  IndexTransform<> cell_transform;
+
+  void operator()() {
+    auto* state = cell->state.get();
+    if (!state->promise.result_needed()) return;
+    if (Split()) return;
+    const auto domain = cell_transform.domain();
+    const Index num_elements = domain.num_elements();
+    if (num_elements == 0) return;
+    // Copy the chunk into a zero-origin contiguous block.
+    auto block = AllocateArray(domain.shape(), c_order, default_init,
+                               state->dtype);
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto chunk_transform,
+        std::move(chunk.transform) | AllDims().TranslateTo(0),
+        state->SetError(_));
+    TENSORSTORE_RETURN_IF_ERROR(
+        internal::CopyReadChunk(chunk.impl, std::move(chunk_transform),
+                                state->data_type_conversion,
+                                TransformedArray<Shared<void>>(block)),
+        state->SetError(_));
+    TENSORSTORE_RETURN_IF_ERROR(
+        state->function(SharedArray<const void, 1>(block.element_pointer(),
+                                                   {num_elements})),
+        state->SetError(_));
+    state->UpdateProgress(num_elements);
+  }
+
+  /// Splits the chunk into pieces of at most `max_block_bytes`, and schedules
+  /// a separate operation for each piece.  Pieces that still exceed
+  /// `max_block_bytes` are split further along the next dimension when they
+  /// are processed.
+  ///
+  /// \returns `false` if the chunk does not need to be split.
+  bool Split() {
+    auto* state = cell->state.get();
+    const Index num_bytes =
+        cell_transform.domain().num_elements() * state->dtype->size;
+    const Index max_block_bytes = state->max_block_bytes;
+    if (num_bytes <= max_block_bytes) return false;
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        bool split,
+        SplitReadChunk(
+            chunk, cell_transform,
+            (num_bytes + max_block_bytes - 1) / max_block_bytes,
+            [&](ReadChunk piece_chunk, IndexTransform<> piece_cell_transform) {
+              state->executor(ReduceChunkOp{cell, std::move(piece_chunk),
+                                            std::move(piece_cell_transform)});
+            }),
+        (state->SetError(_), true));
+    return split;
+  }
+};
+
+/// FlowReceiver used by `DriverReduce` to reduce the chunks of a single grid
+/// cell as they become available.
+struct ReduceChunkReceiver {
+  IntrusivePtr<ReduceCellState> cell;
+  FutureCallbackRegistration cancel_registration;
+  void set_starting(AnyCancelReceiver cancel) {
+    cancel_registration =
+        cell->state->promise.ExecuteWhenNotNeeded(std::move(cancel));
+  }
+  void set_stopping() { cancel_registration(); }
+  void set_done() {}
+  void set_error(absl::Status error) {
+    cell->state->SetError(std::move(error));
+  }
+  void set_value(ReadChunk chunk, IndexTransform<> cell_transform) {
+    // Defer all work to the executor, because we don't know on which thread
+    // this may be called.
+    cell->state->executor(
+        ReduceChunkOp{cell, std::move(chunk), std::move(cell_transform)});
+  }
+};
+
+/// Claims the next grid cell, if any, and initiates the read of it.
+void StartNextCell(IntrusivePtr<ReduceState> state) {
+  if (!state->promise.result_needed()) return;
+  const Index cell = state->next_cell++;
+  if (cell >= state->total_cells) return;
+  Box<> cell_bounds(state->bounds.rank());
+  state->GetCellBounds(cell, cell_bounds);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto cell_transform,
+      state->source_transform | AllDims().BoxSlice(cell_bounds),
+      state->SetError(_));
+  auto driver = state->source_driver;
+  auto transaction = state->source_transaction;
+  driver->Read(std::move(transaction), std::move(cell_transform),
+               ReduceChunkReceiver{
+                   IntrusivePtr<ReduceCellState>(
+                       new ReduceCellState(std::move(state)))});
+}
+
+/// Callback used by `DriverReduce` to initiate the read once the source
+/// transform bounds have been resolved.
+struct DriverReduceInitiateOp {
+  IntrusivePtr<ReduceState> state;
+  void operator()(Promise<void> promise,
+                  ReadyFuture<IndexTransform<>> source_transform_future) {
+    IndexTransform<> source_transform =
+        std::move(source_transform_future.value());
+
+    if (!IsFinite(source_transform.domain())) {
+      promise.SetResult(absl::InvalidArgumentError(tensorstore::StrCat(
+          "Reduce requires a finite domain, got ",
+          source_transform.domain())));
+      return;
+    }
+
+    state->bounds = source_transform.domain().box();
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto chunk_layout,
+        state->source_driver->GetChunkLayout(source_transform),
+        static_cast<void>(promise.SetResult(_)));
+    if (auto status = state->InitGrid(chunk_layout); !status.ok()) {
+      promise.SetResult(std::move(status));
+      return;
+    }
+
+    state->promise = std::move(promise);
+    state->total_elements = source_transform.domain().num_elements();
+    state->source_transform = std::move(source_transform);
+
+    // Initiate the reads of the first cell of each lane.
+    const Index num_lanes =
+        std::min(state->max_in_flight, state->total_cells);
+    for (Index lane = 0; lane < num_lanes; ++lane) {
+      StartNextCell(state);
+    }
+  }
+};
+
+}  // namespace
+
+Future<void> DriverReduce(Executor executor, DriverHandle source,
+                          DataType dtype, ReduceBlockFunction function,
+                          DriverReduceOptions options) {
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::ValidateSupportsRead(source.driver.read_write_mode()));
+  IntrusivePtr<ReduceState> state(new ReduceState);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      state->data_type_conversion,
+      GetDataTypeConverterOrError(source.driver->dtype(), dtype));
+  state->executor = executor;
+  state->dtype = dtype;
+  state->source_driver = std::move(source.driver);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      state->source_transaction,
+      internal::AcquireOpenTransactionPtrOrError(source.transaction));
+  state->function = std::move(function);
+  state->progress_function = std::move(options.progress_function);
+  state->max_block_bytes = std::max(Index(1), options.max_block_bytes);
+  state->max_in_flight = std::max(Index(1), options.max_in_flight);
+  auto pair = PromiseFuturePair<void>::Make(MakeResult());
+
+  // Resolve the bounds for `source.transform`.
+  auto transform_future = state->source_driver->ResolveBounds(
+      state->source_transaction, std::move(source.transform),
+      fix_resizable_bounds);
+
+  // Initiate the read once the bounds have been resolved.
+  LinkValue(WithExecutor(std::move(executor),
+                         DriverReduceInitiateOp{std::move(state)}),
+            std::move(pair.promise), std::move(transform_future));
+  return std::move(pair.future);
+}
+
+Future<void> DriverReduce(DriverHandle source, DataType dtype,
+                          ReduceBlockFunction function,
+                          ReduceOptions options) {
+  auto executor = source.driver->data_copy_executor();
+  return internal::DriverReduce(
+      std::move(executor), std::move(source), dtype, std::move(function),
+      /*options=*/
+      {/*.progress_function=*/std::move(options.progress_function)});
+}
+
+}  // namespace internal
+}  // namespace tensorstore
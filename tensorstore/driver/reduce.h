@@ -0,0 +1,97 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_REDUCE_H_
+#define TENSORSTORE_DRIVER_REDUCE_H_
+
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/driver_handle.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/poly/poly.h"
+#include "tensorstore/progress.h"
+#include "tensorstore/read_write_options.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Type-erased function invoked by `DriverReduce` for each block of elements.
+///
+/// The block is passed as a contiguous 1-d array; the positions of the
+/// elements within the source domain are not exposed.  The function may be
+/// invoked concurrently from multiple threads.  Returning an error aborts the
+/// reduction.
+using ReduceBlockFunction =
+    poly::Poly<sizeof(void*) * 2, /*Copyable=*/false,
+               absl::Status(ArrayView<const void, 1> block)>;
+
+/// Options for DriverReduce.
+struct DriverReduceOptions {
+  /// Callback to be invoked after each block is reduced.  Must remain valid
+  /// until the returned future becomes ready.  May be `nullptr` to indicate
+  /// that progress information is not needed.  The callback may be invoked
+  /// concurrently from multiple threads.  The `copied_elements` value
+  /// indicates the number of elements that have been passed to the block
+  /// function.
+  ReadProgressFunction progress_function;
+
+  /// Upper bound on the size in bytes of each block.  Chunks larger than this
+  /// are split into multiple blocks, which bounds the memory used by each
+  /// concurrent invocation of the block function.
+  Index max_block_bytes = 1024 * 1024;
+
+  /// Maximum number of read chunk grid cells that are read and reduced
+  /// concurrently.  This bounds the memory used by chunks that have been read
+  /// but not yet reduced.
+  Index max_in_flight = 16;
+};
+
+/// Streams the elements of a TensorStore driver through `function`.
+///
+/// The resolved bounds of `source.transform` are partitioned according to the
+/// read chunk grid of `source`.  Up to `options.max_in_flight` grid cells are
+/// read (through the cache, if any) concurrently; the next cell is read once
+/// all chunks of a previous cell have been reduced.  Each chunk is converted
+/// to `dtype` and passed to `function` in one or more blocks of at most
+/// `options.max_block_bytes`.  Blocks are processed in parallel using
+/// `executor`.  Each element is passed to `function` exactly once, but in an
+/// unspecified order.
+///
+/// \param executor Executor to use for reading and reducing blocks.
+/// \param source Read source.
+/// \param dtype Data type to which elements are converted.
+/// \param function Function invoked for each block.
+/// \param options Specifies optional progress function and concurrency.
+/// \returns A future that becomes ready when all blocks have been processed
+///     or an error occurs.
+/// \error `absl::StatusCode::kInvalidArgument` if `source.driver->dtype()`
+///     cannot be converted to `dtype`.
+/// \error `absl::StatusCode::kInvalidArgument` if the resolved domain is not
+///     finite.
+/// \error `absl::StatusCode::kInvalidArgument` if the number of read chunk
+///     grid cells overflows `Index`.
+Future<void> DriverReduce(Executor executor, DriverHandle source,
+                          DataType dtype, ReduceBlockFunction function,
+                          DriverReduceOptions options);
+
+Future<void> DriverReduce(DriverHandle source, DataType dtype,
+                          ReduceBlockFunction function, ReduceOptions options);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_REDUCE_H_
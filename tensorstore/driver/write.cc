@@ -19,6 +19,8 @@
 #include <utility>
 
 #include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/data_type_conversion.h"
 #include "tensorstore/driver/chunk.h"
@@ -37,6 +39,7 @@
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/internal/type_traits.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/read_write_options.h"
@@ -121,6 +124,7 @@ struct WriteState : public internal::AtomicReferenceCount<WriteState> {
   DriverPtr target_driver;
   internal::OpenTransactionPtr target_transaction;
   DomainAlignmentOptions alignment_options;
+  IoStatisticsPtr io_statistics;
   Promise<void> copy_promise;
   Promise<void> commit_promise;
   IntrusivePtr<CommitState> commit_state{new CommitState};
@@ -155,6 +159,8 @@ struct WriteChunkOp {
 
     absl::Status copy_status;
     Future<const void> commit_future;
+    const absl::Time start_time =
+        state->io_statistics ? absl::Now() : absl::InfinitePast();
 
     {
       TENSORSTORE_ASSIGN_OR_RETURN(auto guard,
@@ -182,6 +188,9 @@ struct WriteChunkOp {
         copy_status = std::move(end_write_result.copy_status);
       }
     }
+    if (state->io_statistics) {
+      state->io_statistics->RecordCopyTime(absl::Now() - start_time);
+    }
 
     if (copy_status.ok()) {
       const Index num_elements = chunk.transform.input_domain().num_elements();
@@ -223,6 +232,7 @@ struct WriteChunkReceiver {
     // this may be called.
     //
     // Don't move `state` since `set_value` may be called multiple times.
+    if (state->io_statistics) state->io_statistics->RecordChunk();
     state->executor(
         WriteChunkOp{state, std::move(chunk), std::move(cell_transform)});
   }
@@ -249,6 +259,8 @@ struct DriverWriteInitiateOp {
     // Initiate the write on the driver.
     auto target_driver = std::move(state->target_driver);
     auto target_transaction = std::move(state->target_transaction);
+    internal::ScopedIoStatistics scoped_io_statistics(
+        state->io_statistics.get());
     target_driver->Write(std::move(target_transaction),
                          std::move(target_transform),
                          WriteChunkReceiver{std::move(state)});
@@ -276,6 +288,7 @@ WriteFutures DriverWrite(Executor executor,
   state->alignment_options = options.alignment_options;
   state->commit_state->write_progress_function =
       std::move(options.progress_function);
+  state->io_statistics = std::move(options.io_statistics);
   auto copy_pair = PromiseFuturePair<void>::Make(MakeResult());
   PromiseFuturePair<void> commit_pair;
   if (!state->target_transaction) {
@@ -305,7 +318,10 @@ WriteFutures DriverWrite(TransformedSharedArray<const void> source,
       std::move(executor), std::move(source), std::move(target),
       /*options=*/
       {/*.progress_function=*/std::move(options.progress_function),
-       /*.alignment_options=*/options.alignment_options});
+       /*.alignment_options=*/options.alignment_options,
+       /*.data_type_conversion_flags=*/
+       DataTypeConversionFlags::kSafeAndImplicit,
+       /*.io_statistics=*/std::move(options.io_statistics)});
 }
 
 }  // namespace internal
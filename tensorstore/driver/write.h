@@ -19,6 +19,7 @@
 #include "tensorstore/driver/driver_handle.h"
 #include "tensorstore/index_space/alignment.h"
 #include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/util/executor.h"
@@ -40,6 +41,9 @@ struct DriverWriteOptions {
 
   DataTypeConversionFlags data_type_conversion_flags =
       DataTypeConversionFlags::kSafeAndImplicit;
+
+  /// Optional sink for the I/O statistics of the write.
+  IoStatisticsPtr io_statistics;
 };
 
 /// Copies data from an array to a TensorStore driver.
@@ -0,0 +1,38 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// Defines the "adaptive" compressor for zarr.  Linking in this library
+/// automatically registers it.
+
+#include "tensorstore/internal/compression/adaptive_compressor.h"
+
+#include "tensorstore/driver/zarr/compressor.h"
+#include "tensorstore/driver/zarr/compressor_registry.h"
+
+namespace tensorstore {
+namespace internal_zarr {
+namespace {
+
+struct Registration {
+  Registration() {
+    using internal::AdaptiveCompressor;
+    RegisterCompressor<AdaptiveCompressor>(
+        "adaptive", AdaptiveCompressor::MembersBinder());
+  }
+} registration;
+
+}  // namespace
+}  // namespace internal_zarr
+}  // namespace tensorstore
@@ -0,0 +1,113 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/driver/zarr/compressor.h"
+#include "tensorstore/internal/json_gtest.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::MatchesJson;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_zarr::Compressor;
+
+TEST(AdaptiveCompressorTest, DefaultJson) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto compressor,
+                                   Compressor::FromJson({{"id", "adaptive"}}));
+  EXPECT_THAT(::nlohmann::json(compressor),
+              MatchesJson({
+                  {"id", "adaptive"},
+                  {"candidates",
+                   {{{"cname", "lz4"}, {"clevel", 5}, {"shuffle", 1}},
+                    {{"cname", "lz4"}, {"clevel", 5}, {"shuffle", 2}},
+                    {{"cname", "zstd"}, {"clevel", 1}, {"shuffle", 1}},
+                    {{"cname", "zstd"}, {"clevel", 5}, {"shuffle", 1}}}},
+                  {"speed_weight", 0},
+                  {"sample_bytes", 65536},
+              }));
+}
+
+TEST(AdaptiveCompressorTest, JsonRoundTrip) {
+  ::nlohmann::json j{
+      {"id", "adaptive"},
+      {"candidates", {{{"cname", "zstd"}, {"clevel", 9}, {"shuffle", 0}}}},
+      {"speed_weight", 0.0},
+      {"sample_bytes", 1024}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto compressor, Compressor::FromJson(j));
+  EXPECT_THAT(::nlohmann::json(compressor), MatchesJson(j));
+}
+
+TEST(AdaptiveCompressorTest, InvalidJson) {
+  EXPECT_THAT(Compressor::FromJson(
+                  {{"id", "adaptive"},
+                   {"candidates",
+                    {{{"cname", "invalid"}, {"clevel", 1}, {"shuffle", 0}}}}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(Compressor::FromJson(
+                  {{"id", "adaptive"},
+                   {"candidates",
+                    {{{"cname", "lz4"}, {"clevel", 10}, {"shuffle", 0}}}}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(
+      Compressor::FromJson({{"id", "adaptive"}, {"speed_weight", -1}}),
+      MatchesStatus(absl::StatusCode::kInvalidArgument,
+                    ".*Expected non-negative speed_weight.*"));
+  EXPECT_THAT(Compressor::FromJson({{"id", "adaptive"}, {"sample_bytes", 0}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AdaptiveCompressorTest, EncodeDecode) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto compressor,
+      Compressor::FromJson({{"id", "adaptive"}, {"speed_weight", 0}}));
+  for (const absl::Cord& array :
+       {absl::Cord(), absl::Cord(std::string(10000, '\0')),
+        absl::Cord("The quick brown fox jumped over the lazy dog.")}) {
+    for (const size_t element_size : {1, 2, 10}) {
+      absl::Cord encode_result, decode_result;
+      TENSORSTORE_ASSERT_OK(
+          compressor->Encode(array, &encode_result, element_size));
+      TENSORSTORE_ASSERT_OK(
+          compressor->Decode(encode_result, &decode_result, element_size));
+      EXPECT_EQ(array, decode_result);
+    }
+  }
+}
+
+// With the default `speed_weight` of 0, the encoding of a chunk does not
+// depend on timing.
+TEST(AdaptiveCompressorTest, DefaultEncodingIsDeterministic) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto compressor,
+                                   Compressor::FromJson({{"id", "adaptive"}}));
+  std::string data(100000, '\0');
+  unsigned char v = 0;
+  for (auto& x : data) x = (v += 7);
+  const absl::Cord input(data);
+  absl::Cord expected;
+  TENSORSTORE_ASSERT_OK(compressor->Encode(input, &expected, 2));
+  for (int i = 0; i < 10; ++i) {
+    absl::Cord encoded;
+    TENSORSTORE_ASSERT_OK(compressor->Encode(input, &encoded, 2));
+    EXPECT_EQ(expected, encoded);
+  }
+}
+
+}  // namespace
@@ -52,6 +52,28 @@ TEST(Bzip2CompressorTest, LargeRoundtrip) {
   EXPECT_EQ(input, decode_result);
 }
 
+// Tests that input delivered in pieces is decoded incrementally.
+TEST(Bzip2CompressorTest, StreamingDecode) {
+  std::string input(100000, '\0');
+  unsigned char x = 0;
+  for (auto& v : input) {
+    v = x;
+    x += 7;
+  }
+  auto compressor = Compressor::FromJson({{"id", "bz2"}, {"level", 6}}).value();
+  ASSERT_TRUE(compressor->SupportsStreamingDecode());
+  absl::Cord encode_result, decode_result;
+  TENSORSTORE_ASSERT_OK(
+      compressor->Encode(absl::Cord(input), &encode_result, 1));
+  auto decoder = compressor->GetStreamDecoder(1);
+  for (size_t i = 0; i < encode_result.size(); i += 1000) {
+    TENSORSTORE_ASSERT_OK(
+        decoder->Feed(encode_result.Subcord(i, 1000), &decode_result));
+  }
+  TENSORSTORE_ASSERT_OK(decoder->Finish(&decode_result));
+  EXPECT_EQ(input, decode_result);
+}
+
 // Tests that specifying a level of 1 gives the same result as not specifying a
 // level.
 TEST(Bzip2CompressorTest, DefaultLevel) {
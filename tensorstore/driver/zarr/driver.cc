@@ -373,6 +373,32 @@ class DataCache : public internal_kvs_backed_chunk_driver::DataCache {
         *static_cast<const ZarrMetadata*>(metadata), std::move(data));
   }
 
+  bool SupportsStreamingDecode(const void* metadata) override {
+    // Streaming only helps if decompression can overlap with the transfer.
+    return internal_zarr::SupportsStreamingDecode(
+        *static_cast<const ZarrMetadata*>(metadata));
+  }
+
+  std::unique_ptr<ChunkStreamDecoder> GetChunkStreamDecoder(
+      const void* metadata, span<const Index> chunk_indices) override {
+    class Decoder : public ChunkStreamDecoder {
+     public:
+      explicit Decoder(const ZarrMetadata& metadata) : decoder_(metadata) {}
+      absl::Status Feed(const absl::Cord& data) override {
+        return decoder_.Feed(data);
+      }
+      Result<absl::InlinedVector<SharedArrayView<const void>, 1>> Finish()
+          override {
+        return decoder_.Finish();
+      }
+
+     private:
+      internal_zarr::StreamingChunkDecoder decoder_;
+    };
+    return std::make_unique<Decoder>(
+        *static_cast<const ZarrMetadata*>(metadata));
+  }
+
   Result<absl::Cord> EncodeChunk(
       const void* metadata, span<const Index> chunk_indices,
       span<const SharedArrayView<const void>> component_arrays) override {
@@ -17,7 +17,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/base/optimization.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/context.h"
+#include "tensorstore/driver/chunk.h"
 #include "tensorstore/driver/driver_testutil.h"
 #include "tensorstore/index_space/dim_expression.h"
 #include "tensorstore/index_space/index_domain_builder.h"
@@ -25,16 +27,26 @@
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/compression/blosc.h"
 #include "tensorstore/internal/decoded_matches.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/http/curl_transport.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/in_flight_bytes_resource.h"
+#include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/gtest.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_gtest.h"
 #include "tensorstore/internal/parse_json_matches.h"
+#include "tensorstore/internal/queue_testutil.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/memory/memory_key_value_store.h"
 #include "tensorstore/kvstore/mock_kvstore.h"
 #include "tensorstore/kvstore/test_util.h"
 #include "tensorstore/open.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/execution/any_receiver.h"
 #include "tensorstore/util/status_testutil.h"
 #include "tensorstore/util/str_cat.h"
 
@@ -47,19 +59,29 @@ using ::tensorstore::Context;
 using ::tensorstore::DimensionIndex;
 using ::tensorstore::DimensionSet;
 using ::tensorstore::dtype_v;
+using ::tensorstore::Future;
 using ::tensorstore::Index;
 using ::tensorstore::kImplicit;
 using ::tensorstore::MatchesJson;
 using ::tensorstore::MatchesStatus;
+using ::tensorstore::Promise;
+using ::tensorstore::PromiseFuturePair;
 using ::tensorstore::Schema;
 using ::tensorstore::span;
 using ::tensorstore::StrCat;
+using ::tensorstore::internal::CordStream;
 using ::tensorstore::internal::DecodedMatches;
 using ::tensorstore::internal::GetMap;
+using ::tensorstore::internal::MakeIntrusivePtr;
 using ::tensorstore::internal::ParseJsonMatches;
 using ::tensorstore::internal::TestSpecSchema;
 using ::tensorstore::internal::TestTensorStoreCreateCheckSchema;
 using ::tensorstore::internal::TestTensorStoreCreateWithSchema;
+using ::tensorstore::internal_http::HttpRequest;
+using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::HttpStreamingResponse;
+using ::tensorstore::internal_http::HttpTransport;
+using ::tensorstore::internal_http::SetDefaultHttpTransport;
 using ::testing::ElementsAreArray;
 using ::testing::Pair;
 using ::testing::UnorderedElementsAreArray;
@@ -2179,6 +2201,237 @@ TEST(ZarrDriverTest, ReadAfterUncommittedWrite) {
               })));
 }
 
+TEST(ZarrDriverTest, InFlightBytesLimit) {
+  ::nlohmann::json json_spec{
+      {"driver", "zarr"},
+      {"kvstore",
+       {
+           {"driver", "memory"},
+           {"path", "prefix/"},
+       }},
+      // Each chunk is 12 bytes, so at most one chunk is read or encoded at a
+      // time.
+      {"context", {{"in_flight_bytes", {{"limit", 20}}}}},
+      {"metadata",
+       {
+           {"compressor", {{"id", "zlib"}}},
+           {"dtype", "<i2"},
+           {"shape", {8, 3}},
+           {"chunks", {2, 3}},
+       }},
+  };
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(json_spec, tensorstore::OpenMode::create).result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(tensorstore::MakeScalarArray<std::int16_t>(42),
+                         store | tensorstore::Dims(0).SizedInterval(1, 6))
+          .result());
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(tensorstore::MakeArray<std::int16_t>({
+                  {0, 0, 0},
+                  {42, 42, 42},
+                  {42, 42, 42},
+                  {42, 42, 42},
+                  {42, 42, 42},
+                  {42, 42, 42},
+                  {42, 42, 42},
+                  {0, 0, 0},
+              })));
+}
+
+/// Read receiver that records the in-flight bytes when each chunk is received,
+/// and when the last copy of the receiver is destroyed.
+struct InFlightBytesRecordingReceiver {
+  struct State {
+    tensorstore::internal::InFlightBytesBudget* budget;
+    Promise<std::vector<size_t>> promise;
+    absl::Mutex mutex;
+    std::vector<size_t> in_flight;
+    ~State() {
+      in_flight.push_back(budget->in_flight());
+      promise.SetResult(std::move(in_flight));
+    }
+  };
+  std::shared_ptr<State> state;
+
+  void set_starting(tensorstore::AnyCancelReceiver cancel) {}
+  void set_value(tensorstore::internal::ReadChunk chunk,
+                 tensorstore::IndexTransform<> cell_transform) {
+    absl::MutexLock lock(&state->mutex);
+    state->in_flight.push_back(state->budget->in_flight());
+  }
+  void set_done() {}
+  void set_error(absl::Status error) {}
+  void set_stopping() {}
+};
+
+TEST(ZarrDriverTest, InFlightBytesHeldUntilChunksDelivered) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context_spec,
+      Context::Spec::FromJson({{"in_flight_bytes", {{"limit", 100}}}}));
+  Context context(context_spec);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto budget,
+      context.GetResource<tensorstore::internal::InFlightBytesResource>());
+  ::nlohmann::json json_spec{
+      {"driver", "zarr"},
+      {"kvstore", {{"driver", "memory"}}},
+      {"metadata",
+       {
+           {"compressor", nullptr},
+           {"dtype", "<i2"},
+           {"shape", {4, 3}},
+           {"chunks", {2, 3}},
+       }},
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(json_spec, context, tensorstore::OpenMode::create)
+          .result());
+  auto [promise, future] = PromiseFuturePair<std::vector<size_t>>::Make();
+  auto state = std::make_shared<InFlightBytesRecordingReceiver::State>();
+  state->budget = budget->get();
+  state->promise = std::move(promise);
+  auto handle = tensorstore::internal::TensorStoreAccess::handle(store);
+  handle.driver->Read(/*transaction=*/{}, handle.transform,
+                      InFlightBytesRecordingReceiver{std::move(state)});
+  // Each decoded 12-byte chunk remains reserved until the read operation has
+  // delivered all chunks, and is released along with the receiver.
+  EXPECT_THAT(future.result(),
+              ::testing::Optional(::testing::ElementsAre(
+                  ::testing::Ge(12u), 24u, 0u)));
+}
+
+class StreamingMockTransport : public HttpTransport {
+ public:
+  Future<HttpResponse> IssueRequest(const HttpRequest& request,
+                                    absl::Cord payload,
+                                    absl::Duration request_timeout,
+                                    absl::Duration connect_timeout) override {
+    auto [promise, future] = PromiseFuturePair<HttpResponse>::Make();
+    requests_.push({request, promise});
+    return future;
+  }
+
+  Future<HttpStreamingResponse> IssueStreamingRequest(
+      const HttpRequest& request, absl::Cord payload,
+      absl::Duration request_timeout,
+      absl::Duration connect_timeout) override {
+    auto [promise, future] = PromiseFuturePair<HttpStreamingResponse>::Make();
+    streaming_requests_.push({request, promise});
+    return future;
+  }
+
+  template <typename T>
+  struct Request {
+    HttpRequest request;
+    Promise<T> promise;
+  };
+
+  tensorstore::internal::ConcurrentQueue<Request<HttpResponse>> requests_;
+  tensorstore::internal::ConcurrentQueue<Request<HttpStreamingResponse>>
+      streaming_requests_;
+};
+
+class ZarrHttpStreamingTest : public ::testing::Test {
+ public:
+  ZarrHttpStreamingTest() { SetDefaultHttpTransport(mock_transport); }
+  ~ZarrHttpStreamingTest() { SetDefaultHttpTransport(nullptr); }
+
+  ::nlohmann::json GetMetadata(::nlohmann::json compressor) {
+    return {
+        {"compressor", compressor},
+        {"dtype", "<i2"},
+        {"shape", {2, 3}},
+        {"chunks", {2, 3}},
+    };
+  }
+
+  /// Returns the encoded chunk `0.0` of an array with `metadata`, as written
+  /// by the zarr driver.
+  absl::Cord EncodeChunk(::nlohmann::json metadata) {
+    auto store = tensorstore::Open({{"driver", "zarr"},
+                                    {"kvstore", {{"driver", "memory"}}},
+                                    {"metadata", metadata}},
+                                   tensorstore::OpenMode::create)
+                     .value();
+    TENSORSTORE_CHECK_OK(tensorstore::Write(array, store).result());
+    return kvstore::Read(store.kvstore(), "0.0").value().value;
+  }
+
+  /// Opens an array with `metadata` stored at `https://example.com/prefix/`.
+  tensorstore::TensorStore<> OpenHttp(::nlohmann::json metadata,
+                                      Context context) {
+    return tensorstore::Open({{"driver", "zarr"},
+                              {"kvstore", "https://example.com/prefix/"},
+                              {"metadata", metadata}},
+                             context,
+                             tensorstore::OpenMode::open |
+                                 tensorstore::OpenMode::assume_metadata,
+                             tensorstore::ReadWriteMode::read)
+        .value();
+  }
+
+  tensorstore::SharedArray<std::int16_t, 2> array =
+      tensorstore::MakeArray<std::int16_t>({{1, 2, 3}, {4, 5, 6}});
+  std::shared_ptr<StreamingMockTransport> mock_transport =
+      std::make_shared<StreamingMockTransport>();
+};
+
+// Tests that chunks compressed with blosc, which cannot be decoded
+// incrementally, are read in full rather than streamed.
+TEST_F(ZarrHttpStreamingTest, BloscNotStreamed) {
+  auto metadata = GetMetadata({{"id", "blosc"}});
+  auto encoded = EncodeChunk(metadata);
+  auto store = OpenHttp(metadata, Context::Default());
+  auto read_future = tensorstore::Read(store);
+  auto request = mock_transport->requests_.pop();
+  EXPECT_EQ("https://example.com/prefix/0.0", request.request.url());
+  request.promise.SetResult(HttpResponse{200, encoded});
+  EXPECT_THAT(read_future.result(), ::testing::Optional(array));
+  EXPECT_TRUE(mock_transport->streaming_requests_.empty());
+}
+
+// Tests that a zlib chunk is decoded as it is received, without blocking an
+// executor thread while waiting for the remainder.
+TEST_F(ZarrHttpStreamingTest, ZlibStreamedWithoutBlocking) {
+  auto metadata = GetMetadata({{"id", "zlib"}});
+  auto encoded = EncodeChunk(metadata);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context_spec,
+      Context::Spec::FromJson({{"data_copy_concurrency", {{"limit", 1}}}}));
+  Context context(context_spec);
+  auto store = OpenHttp(metadata, context);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto memory_store,
+      tensorstore::Open({{"driver", "zarr"},
+                         {"kvstore", {{"driver", "memory"}}},
+                         {"metadata", metadata}},
+                        context, tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(array, memory_store).result());
+
+  auto read_future = tensorstore::Read(store);
+  auto request = mock_transport->streaming_requests_.pop();
+  EXPECT_EQ("https://example.com/prefix/0.0", request.request.url());
+  auto body = MakeIntrusivePtr<CordStream>();
+  body->Append(encoded.Subcord(0, encoded.size() / 2));
+  request.promise.SetResult(HttpStreamingResponse{HttpResponse{200}, body});
+
+  // The only data copy thread remains available while the chunk is partially
+  // received.
+  EXPECT_THAT(tensorstore::Read(memory_store).result(),
+              ::testing::Optional(array));
+  EXPECT_FALSE(read_future.ready());
+
+  body->Append(encoded.Subcord(encoded.size() / 2, encoded.size()));
+  body->Finish();
+  EXPECT_THAT(read_future.result(), ::testing::Optional(array));
+  EXPECT_TRUE(mock_transport->requests_.empty());
+}
+
 TENSORSTORE_GLOBAL_INITIALIZER {
   tensorstore::internal::TestTensorStoreDriverSpecRoundtripOptions options;
   options.test_name = "zarr";
@@ -354,15 +354,10 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(ZarrPartialMetadata,
 // Two decoding strategies:  raw decoder and custom decoder.  Initially we will
 // only support raw decoder.
 
-Result<absl::InlinedVector<SharedArrayView<const void>, 1>> DecodeChunk(
-    const ZarrMetadata& metadata, absl::Cord buffer) {
+namespace {
+Result<absl::InlinedVector<SharedArrayView<const void>, 1>>
+DecodeUncompressedChunk(const ZarrMetadata& metadata, absl::Cord buffer) {
   const size_t num_fields = metadata.dtype.fields.size();
-  if (metadata.compressor) {
-    absl::Cord decoded;
-    TENSORSTORE_RETURN_IF_ERROR(metadata.compressor->Decode(
-        buffer, &decoded, metadata.dtype.bytes_per_outer_element));
-    buffer = std::move(decoded);
-  }
   if (static_cast<Index>(buffer.size()) !=
       metadata.chunk_layout.bytes_per_chunk) {
     return absl::InvalidArgumentError(tensorstore::StrCat(
@@ -400,6 +395,37 @@ Result<absl::InlinedVector<SharedArrayView<const void>, 1>> DecodeChunk(
   }
   return field_arrays;
 }
+}  // namespace
+
+Result<absl::InlinedVector<SharedArrayView<const void>, 1>> DecodeChunk(
+    const ZarrMetadata& metadata, absl::Cord buffer) {
+  if (metadata.compressor) {
+    absl::Cord decoded;
+    TENSORSTORE_RETURN_IF_ERROR(metadata.compressor->Decode(
+        buffer, &decoded, metadata.dtype.bytes_per_outer_element));
+    buffer = std::move(decoded);
+  }
+  return DecodeUncompressedChunk(metadata, std::move(buffer));
+}
+
+bool SupportsStreamingDecode(const ZarrMetadata& metadata) {
+  return metadata.compressor && metadata.compressor->SupportsStreamingDecode();
+}
+
+StreamingChunkDecoder::StreamingChunkDecoder(const ZarrMetadata& metadata)
+    : metadata_(metadata),
+      decoder_(metadata.compressor->GetStreamDecoder(
+          metadata.dtype.bytes_per_outer_element)) {}
+
+absl::Status StreamingChunkDecoder::Feed(const absl::Cord& data) {
+  return decoder_->Feed(data, &decoded_);
+}
+
+Result<absl::InlinedVector<SharedArrayView<const void>, 1>>
+StreamingChunkDecoder::Finish() {
+  TENSORSTORE_RETURN_IF_ERROR(decoder_->Finish(&decoded_));
+  return DecodeUncompressedChunk(metadata_, std::move(decoded_));
+}
 
 namespace {
 bool SingleArrayMatchesEncodedRepresentation(
@@ -243,6 +243,41 @@ Result<absl::Cord> EncodeChunk(
 Result<absl::InlinedVector<SharedArrayView<const void>, 1>> DecodeChunk(
     const ZarrMetadata& metadata, absl::Cord buffer);
 
+/// Returns `true` if chunks encoded according to `metadata` can be decoded
+/// incrementally by `StreamingChunkDecoder`, i.e. if they are compressed with
+/// a compressor that supports incremental decoding.
+bool SupportsStreamingDecode(const ZarrMetadata& metadata);
+
+/// Decodes an encoded chunk that is delivered incrementally.
+///
+/// Must only be used if `SupportsStreamingDecode(metadata)` returns `true`.
+/// Decompression proceeds as each piece is passed to `Feed`; neither `Feed`
+/// nor `Finish` blocks.
+class StreamingChunkDecoder {
+ public:
+  /// Constructs a decoder for chunks encoded according to `metadata`.
+  ///
+  /// The `metadata` must remain valid for the lifetime of the decoder.
+  explicit StreamingChunkDecoder(const ZarrMetadata& metadata);
+
+  /// Decodes the next piece of the encoded chunk.
+  ///
+  /// \error `absl::StatusCode::kInvalidArgument` if the data is invalid.
+  absl::Status Feed(const absl::Cord& data);
+
+  /// Completes decoding once the entire encoded chunk has been fed.
+  ///
+  /// \returns A vector of length `metadata.dtype.fields.size()`.
+  /// \error `absl::StatusCode::kInvalidArgument` if the data is not a valid
+  ///     encoded zarr chunk according to `metadata`.
+  Result<absl::InlinedVector<SharedArrayView<const void>, 1>> Finish();
+
+ private:
+  const ZarrMetadata& metadata_;
+  std::unique_ptr<internal::JsonSpecifiedCompressor::StreamDecoder> decoder_;
+  absl::Cord decoded_;
+};
+
 /// Returns `true` if `a` and `b` are compatible, meaning stored data created
 /// with `a` can be read using `b`.
 bool IsMetadataCompatible(const ZarrMetadata& a, const ZarrMetadata& b);
@@ -18,6 +18,8 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include "absl/strings/escaping.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/array_testutil.h"
@@ -38,10 +40,13 @@ using ::tensorstore::MakeScalarArray;
 using ::tensorstore::MatchesStatus;
 using ::tensorstore::internal_zarr::DimensionSeparator;
 using ::tensorstore::internal_zarr::DimensionSeparatorJsonBinder;
+using ::tensorstore::internal_zarr::EncodeChunk;
 using ::tensorstore::internal_zarr::EncodeFillValue;
 using ::tensorstore::internal_zarr::OrderJsonBinder;
 using ::tensorstore::internal_zarr::ParseDType;
 using ::tensorstore::internal_zarr::ParseFillValue;
+using ::tensorstore::internal_zarr::StreamingChunkDecoder;
+using ::tensorstore::internal_zarr::SupportsStreamingDecode;
 using ::tensorstore::internal_zarr::ZarrMetadata;
 using ::testing::ElementsAre;
 
@@ -710,4 +715,61 @@ TEST(DimensionSeparatorTest, JsonBinderTestInvalid) {
       DimensionSeparatorJsonBinder);
 }
 
+// Tests that a compressed chunk delivered in small pieces is decoded.
+TEST(DecodeChunkTest, Stream) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto metadata,
+      ZarrMetadata::FromJson({{"zarr_format", 2},
+                              {"shape", {4, 5}},
+                              {"chunks", {4, 5}},
+                              {"dtype", "<u2"},
+                              {"compressor", {{"id", "zlib"}, {"level", 1}}},
+                              {"fill_value", nullptr},
+                              {"order", "C"},
+                              {"filters", nullptr}}));
+  auto array = MakeArray<uint16_t>({{1, 2, 3, 4, 5},
+                                    {6, 7, 8, 9, 10},
+                                    {11, 12, 13, 14, 15},
+                                    {16, 17, 18, 19, 20}});
+  const tensorstore::SharedArrayView<const void> components[] = {array};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   EncodeChunk(metadata, components));
+  ASSERT_TRUE(SupportsStreamingDecode(metadata));
+  {
+    StreamingChunkDecoder decoder(metadata);
+    for (size_t i = 0; i < encoded.size(); i += 7) {
+      TENSORSTORE_ASSERT_OK(decoder.Feed(encoded.Subcord(i, 7)));
+    }
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto decoded, decoder.Finish());
+    ASSERT_EQ(1, decoded.size());
+    EXPECT_EQ(array, decoded[0]);
+  }
+
+  {
+    StreamingChunkDecoder decoder(metadata);
+    TENSORSTORE_ASSERT_OK(
+        decoder.Feed(encoded.Subcord(0, encoded.size() - 1)));
+    EXPECT_THAT(decoder.Finish(),
+                MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+}
+
+// Tests that only compressors that decode incrementally use streaming.
+TEST(DecodeChunkTest, SupportsStreamingDecode) {
+  ::nlohmann::json json{{"zarr_format", 2},     {"shape", {4, 5}},
+                        {"chunks", {4, 5}},     {"dtype", "<u2"},
+                        {"fill_value", nullptr}, {"order", "C"},
+                        {"filters", nullptr}};
+  json["compressor"] = nullptr;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto uncompressed,
+                                   ZarrMetadata::FromJson(json));
+  EXPECT_FALSE(SupportsStreamingDecode(uncompressed));
+  json["compressor"] = {{"id", "blosc"}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto blosc, ZarrMetadata::FromJson(json));
+  EXPECT_FALSE(SupportsStreamingDecode(blosc));
+  json["compressor"] = {{"id", "gzip"}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto gzip, ZarrMetadata::FromJson(json));
+  EXPECT_TRUE(SupportsStreamingDecode(gzip));
+}
+
 }  // namespace
@@ -189,6 +189,38 @@ struct RegisterIterateBenchmarks {
            /*indexed=*/{true, false, false}},
       });
     }
+
+    // Small inner extents, for which the per-row loop overhead dominates.
+    for (const auto& copy_shape : std::vector<std::vector<Index>>{
+             {4096, 2},
+             {4096, 4},
+             {512, 8, 2},
+             {512, 4, 4},
+             {64, 8, 8, 2},
+             {64, 4, 8, 4},
+         }) {
+      const DimensionIndex rank = copy_shape.size();
+      std::vector<DimensionIndex> c_order(rank), reverse_order(rank);
+      for (DimensionIndex i = 0; i < rank; ++i) {
+        c_order[i] = i;
+        reverse_order[i] = rank - 1 - i;
+      }
+      // Copy from a sub-region of a larger array, so that the dimensions cannot
+      // be combined.
+      std::vector<Index> padded_shape = copy_shape;
+      for (auto& size : padded_shape) ++size;
+      const std::vector<bool> not_indexed(rank, false);
+
+      Register({copy_shape,
+                /*constraints=*/{},
+                /*source=*/{padded_shape, c_order, not_indexed},
+                /*dest=*/{padded_shape, c_order, not_indexed}});
+
+      Register({copy_shape,
+                /*constraints=*/{},
+                /*source=*/{copy_shape, c_order, not_indexed},
+                /*dest=*/{copy_shape, reverse_order, not_indexed}});
+    }
   }
 } register_iterate_benchmarks_;
 
@@ -22,6 +22,8 @@
 #include "tensorstore/array.h"
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/index.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/output_index_method.h"
 #include "tensorstore/internal/masked_array.h"
 #include "tensorstore/internal/nditerable.h"
 #include "tensorstore/internal/nditerable_transformed_array.h"
@@ -81,6 +83,26 @@ Result<NDIterable::Ptr> AsyncWriteArray::Spec::GetReadNDIterable(
       arena);
 }
 
+Result<SharedOffsetArray<const void>> AsyncWriteArray::Spec::GetReadArray(
+    SharedArrayView<const void> array, span<const Index> origin,
+    IndexTransform<> chunk_transform) const {
+  if (!array.valid()) array = fill_value;
+  assert(internal::RangesEqual(array.shape(), this->shape()));
+  for (const auto map : chunk_transform.output_index_maps()) {
+    // Index array output maps require a copy.
+    if (map.method() == OutputIndexMethod::array) {
+      return SharedOffsetArray<const void>();
+    }
+  }
+  StridedLayoutView<dynamic_rank, offset_origin> data_layout(
+      origin, shape(), array.byte_strides());
+  SharedOffsetArray<const void> data_array(
+      AddByteOffset(std::move(array.element_pointer()),
+                    -data_layout.origin_byte_offset()),
+      data_layout);
+  return TransformArray(data_array, chunk_transform);
+}
+
 AsyncWriteArray::MaskedArray::MaskedArray(DimensionIndex rank) : mask(rank) {}
 
 void AsyncWriteArray::MaskedArray::WriteFillValue(const Spec& spec,
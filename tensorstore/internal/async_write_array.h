@@ -128,6 +128,19 @@ struct AsyncWriteArray {
                                               IndexTransform<> chunk_transform,
                                               Arena* arena) const;
 
+    /// Returns a view of the specified `array`, using the specified
+    /// `chunk_transform`, that shares ownership of the array data.
+    ///
+    /// \param array The array to read, must have shape equal to `shape()`.
+    /// \param origin The associated origin of the array.
+    /// \param chunk_transform Transform to use for reading, the output rank
+    ///     must equal `rank()`.
+    /// \returns The transformed view, or a null array if `chunk_transform`
+    ///     cannot be represented as a strided view of `array`.
+    Result<SharedOffsetArray<const void>> GetReadArray(
+        SharedArrayView<const void> array, span<const Index> origin,
+        IndexTransform<> chunk_transform) const;
+
     std::size_t EstimateReadStateSizeInBytes(bool valid) const {
       if (!valid) return 0;
       return num_elements() * dtype()->size;
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
 #include <mutex>  // NOLINT
 #include <utility>
 
@@ -31,6 +32,7 @@
 #include "tensorstore/internal/mutex.h"
 #include "tensorstore/internal/no_destructor.h"
 #include "tensorstore/internal/type_traits.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/future.h"
@@ -112,11 +114,14 @@ void EntryOrNodeStartRead(EntryOrNode& entry_or_node,
         << "EntryOrNodeStartRead: pending read request was cancelled";
     request_state.queued = Promise<void>();
     request_state.queued_time = absl::InfinitePast();
+    request_state.queued_io_statistics.reset();
     return;
   }
   auto staleness_bound = request_state.issued_time =
       std::exchange(request_state.queued_time, absl::InfinitePast());
   request_state.issued = std::move(request_state.queued);
+  request_state.issued_io_statistics =
+      std::move(request_state.queued_io_statistics);
   lock.unlock();
   AcquireReadRequestReference(entry_or_node);
   ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
@@ -241,7 +246,8 @@ void SetReadState(EntryOrNode& entry_or_node, ReadState&& read_state,
 
 template <typename EntryOrNode>
 Future<const void> RequestRead(EntryOrNode& entry_or_node,
-                               absl::Time staleness_bound) {
+                               absl::Time staleness_bound,
+                               IoStatistics* io_statistics) {
   static_assert(std::is_same_v<EntryOrNode, Entry> ||
                 std::is_same_v<EntryOrNode, TransactionNode>);
   auto& entry = GetOwningEntry(entry_or_node);
@@ -260,6 +266,13 @@ Future<const void> RequestRead(EntryOrNode& entry_or_node,
   request_state.queued_time = std::max(request_state.queued_time,
                                        std::min(staleness_bound, absl::Now()));
   Future<const void> future;
+  const auto get_queued_future = [&] {
+    // The queued read is attributed to the first request that requires it.
+    if (!request_state.queued_io_statistics) {
+      request_state.queued_io_statistics.reset(io_statistics);
+    }
+    return GetFuture(request_state.queued);
+  };
   if (!request_state.issued.null()) {
     // Another read operation is in progress.
     if (!request_state.issued.null() &&
@@ -270,10 +283,10 @@ Future<const void> RequestRead(EntryOrNode& entry_or_node,
     } else {
       // A read is in progress.  We will wait until it completes, and then may
       // need to issue another read operation to satisfy `staleness_bound`.
-      future = GetFuture(request_state.queued);
+      future = get_queued_future();
     }
   } else {
-    future = GetFuture(request_state.queued);
+    future = get_queued_future();
   }
   MaybeIssueRead(entry_or_node, std::move(lock));
   return future;
@@ -295,6 +308,7 @@ class QueuedReadHandler {
       // Queued read is also satisfied.
       queued_ = std::move(request_state.queued);
       request_state.queued_time = absl::InfinitePast();
+      request_state.queued_io_statistics.reset();
     }
   }
 
@@ -309,13 +323,21 @@ class QueuedReadHandler {
   Promise<void> queued_;
 };
 
+/// Resolves the read futures of `entry_or_node` with `status`.
+///
+/// \param read_resources If not null, the resources made available from
+///     `Entry::GetCompletingReadResources` while the futures are resolved.
 template <typename EntryOrNode>
 void ResolveIssuedRead(EntryOrNode& entry_or_node, absl::Status status,
-                       UniqueWriterLock<Entry> lock) {
+                       UniqueWriterLock<Entry> lock,
+                       std::shared_ptr<const void> read_resources = nullptr) {
   static_assert(std::is_same_v<EntryOrNode, Entry> ||
                 std::is_same_v<EntryOrNode, TransactionNode>);
   auto& request_state = entry_or_node.read_request_state_;
   auto issued = std::move(request_state.issued);
+  // Released after the lock, since `MaybeIssueRead` may set it for the next
+  // read.
+  auto issued_io_statistics = std::move(request_state.issued_io_statistics);
   auto time = GetEffectiveReadRequestState(entry_or_node).read_state.stamp.time;
   assert(!issued.null());
   assert(!status.ok() || time >= request_state.issued_time);
@@ -328,6 +350,14 @@ void ResolveIssuedRead(EntryOrNode& entry_or_node, absl::Status status,
     // `issued.SetResult` will have no effect.
     issued.SetResult(tensorstore::MakeResult(status));
   }
+  if (read_resources) {
+    // A subsequent read may already have replaced the resources.
+    auto& entry = GetOwningEntry(entry_or_node);
+    UniqueWriterLock lock(entry);
+    if (entry.completing_read_resources_ == read_resources) {
+      entry.completing_read_resources_ = nullptr;
+    }
+  }
   ReleaseReadRequestReference(entry_or_node);
 }
 
@@ -337,8 +367,9 @@ size_t GetReadStateSize(Entry& entry, const void* read_data) {
 }
 
 template <typename EntryOrNode>
-void EntryOrNodeReadSuccess(EntryOrNode& entry_or_node,
-                            ReadState&& read_state) {
+void EntryOrNodeReadSuccess(
+    EntryOrNode& entry_or_node, ReadState&& read_state,
+    std::shared_ptr<const void> read_resources = nullptr) {
   static_assert(std::is_same_v<EntryOrNode, Entry> ||
                 std::is_same_v<EntryOrNode, TransactionNode>);
   Entry& entry = GetOwningEntry(entry_or_node);
@@ -347,7 +378,9 @@ void EntryOrNodeReadSuccess(EntryOrNode& entry_or_node,
   assert(read_state.stamp.time != absl::InfinitePast());
   assert(!StorageGeneration::IsUnknown(read_state.stamp.generation));
   SetReadState(entry_or_node, std::move(read_state), read_state_size);
-  ResolveIssuedRead(entry_or_node, absl::OkStatus(), std::move(lock));
+  if (read_resources) entry.completing_read_resources_ = read_resources;
+  ResolveIssuedRead(entry_or_node, absl::OkStatus(), std::move(lock),
+                    std::move(read_resources));
 }
 
 template <typename EntryOrNode>
@@ -482,10 +515,11 @@ size_t AsyncCache::DoGetSizeInBytes(Cache::Entry* base_entry) {
   return this->DoGetFixedSizeInBytes(entry);
 }
 
-Future<const void> AsyncCache::Entry::Read(absl::Time staleness_bound) {
+Future<const void> AsyncCache::Entry::Read(absl::Time staleness_bound,
+                                           IoStatistics* io_statistics) {
   ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
       << *this << "Read: staleness_bound=" << staleness_bound;
-  return RequestRead(*this, staleness_bound);
+  return RequestRead(*this, staleness_bound, io_statistics);
 }
 
 void AsyncCache::Entry::ReadSuccess(ReadState&& read_state) {
@@ -494,6 +528,19 @@ void AsyncCache::Entry::ReadSuccess(ReadState&& read_state) {
   internal::EntryOrNodeReadSuccess(*this, std::move(read_state));
 }
 
+void AsyncCache::Entry::ReadSuccess(
+    ReadState&& read_state, std::shared_ptr<const void> read_resources) {
+  ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
+      << *this << "ReadSuccess: " << read_state.stamp;
+  internal::EntryOrNodeReadSuccess(*this, std::move(read_state),
+                                   std::move(read_resources));
+}
+
+std::shared_ptr<const void> AsyncCache::Entry::GetCompletingReadResources() {
+  absl::ReaderMutexLock lock(&mutex_);
+  return completing_read_resources_;
+}
+
 void AsyncCache::Entry::ReadError(absl::Status error) {
   ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
       << *this << "ReadError: error=" << error;
@@ -523,14 +570,14 @@ AsyncCache::TransactionNode::TransactionNode(Entry& entry)
       size_updated_(false) {}
 
 Future<const void> AsyncCache::TransactionNode::Read(
-    absl::Time staleness_bound) {
+    absl::Time staleness_bound, IoStatistics* io_statistics) {
   ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
       << *this << "Read: staleness_bound=" << staleness_bound;
   if (reads_committed_ && (prepare_for_commit_state_ !=
                            PrepareForCommitState::kReadyForCommitCalled)) {
-    return RequestRead(GetOwningEntry(*this), staleness_bound);
+    return RequestRead(GetOwningEntry(*this), staleness_bound, io_statistics);
   }
-  return RequestRead(*this, staleness_bound);
+  return RequestRead(*this, staleness_bound, io_statistics);
 }
 
 void AsyncCache::TransactionNode::ReadSuccess(ReadState&& read_state) {
@@ -808,6 +855,26 @@ bool AsyncCache::TransactionNode::try_lock() {
   return false;
 }
 
+void AsyncCache::TransactionNode::SetWritebackIoStatistics(
+    IoStatistics* io_statistics) {
+  if (!io_statistics ||
+      writeback_io_statistics_.load(std::memory_order_relaxed) ==
+          io_statistics) {
+    return;
+  }
+  intrusive_ptr_increment(io_statistics);
+  if (auto* prev = writeback_io_statistics_.exchange(
+          io_statistics, std::memory_order_acq_rel)) {
+    intrusive_ptr_decrement(prev);
+  }
+}
+
+IoStatisticsPtr AsyncCache::TransactionNode::TakeWritebackIoStatistics() {
+  return IoStatisticsPtr(
+      writeback_io_statistics_.exchange(nullptr, std::memory_order_acq_rel),
+      adopt_object_ref);
+}
+
 size_t AsyncCache::TransactionNode::ComputeWriteStateSizeInBytes() { return 0; }
 
 absl::Status AsyncCache::TransactionNode::DoInitialize(
@@ -835,6 +902,7 @@ void AsyncCache::TransactionNode::InvalidateReadState() {
 AsyncCache::TransactionNode::~TransactionNode() {
   ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
       << *this << "~TransactionNode";
+  TakeWritebackIoStatistics();
   Cache::PinnedEntry(static_cast<Cache::Entry*>(associated_data()),
                      adopt_object_ref);
 }
@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <memory>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/strings/str_format.h"
@@ -29,6 +30,7 @@
 #include "tensorstore/internal/intrusive_red_black_tree.h"
 #include "tensorstore/internal/mutex.h"
 #include "tensorstore/internal/tagged_ptr.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/execution/any_receiver.h"
@@ -197,6 +199,14 @@ class AsyncCache : public Cache {
     /// Only meaningful if `queued.valid()`.
     absl::Time queued_time = absl::InfinitePast();
 
+    /// Sink to which the queued read is attributed: that of the first request
+    /// that required it to be issued.  Only meaningful if `queued.valid()`.
+    IoStatisticsPtr queued_io_statistics;
+
+    /// Sink to which the in-progress read is attributed.  Set before `DoRead`
+    /// is called, and not modified until the read completes.
+    IoStatisticsPtr issued_io_statistics;
+
     /// The most recently-cached read state.
     ReadState read_state;
 
@@ -354,10 +364,13 @@ class AsyncCache : public Cache {
     /// Requests data no older than `staleness_bound`.
     ///
     /// \param staleness_bound Limit on data staleness.
+    /// \param io_statistics Optional sink to which a read issued as a result
+    ///     of this request is attributed.
     /// \returns A future that resolves to a success state once data no older
     ///     than `staleness_bound` is available, or to an error state if the
     ///     request failed.
-    Future<const void> Read(absl::Time staleness_bound);
+    Future<const void> Read(absl::Time staleness_bound,
+                            IoStatistics* io_statistics = nullptr);
 
     /// Obtains an existing or new transaction node for the specified entry and
     /// transaction.  May also be used to obtain an implicit transaction node.
@@ -422,6 +435,13 @@ class AsyncCache : public Cache {
     /// to signal completion.
     virtual void DoRead(absl::Time staleness_bound) = 0;
 
+    /// Returns the sink to which the read initiated by the most recent call to
+    /// `DoRead` is attributed, or `nullptr` if none.  Must only be called
+    /// before that read completes.
+    IoStatistics* GetReadIoStatistics() const {
+      return read_request_state_.issued_io_statistics.get();
+    }
+
     /// Signals that the read request initiated by the most recent call to
     /// `DoRead` succeeded.
     ///
@@ -429,6 +449,16 @@ class AsyncCache : public Cache {
     /// class method is called.
     virtual void ReadSuccess(ReadState&& read_state);
 
+    /// Same as above, but additionally makes `read_resources`, such as an
+    /// `InFlightBytesReservation` held on behalf of the consumers of the read,
+    /// available from `GetCompletingReadResources` to the callbacks of the
+    /// read futures resolved by this call.
+    ///
+    /// The entry releases its reference to `read_resources` before this call
+    /// returns.
+    void ReadSuccess(ReadState&& read_state,
+                     std::shared_ptr<const void> read_resources);
+
     /// Signals that the read request initiated by the most recent call to
     /// `DoRead` failed.
     ///
@@ -436,6 +466,14 @@ class AsyncCache : public Cache {
     /// class method is called.
     virtual void ReadError(absl::Status error);
 
+    /// Returns the resources passed to the `ReadSuccess` call that is
+    /// resolving the read futures, or `nullptr` if there are none.
+    ///
+    /// Read future callbacks that access the read data only later, such as
+    /// through a `ReadChunk`, should retain the returned handle until the data
+    /// has been consumed.
+    std::shared_ptr<const void> GetCompletingReadResources();
+
     /// Derived classes should override this to return the size of the "read
     /// state".
     ///
@@ -468,6 +506,10 @@ class AsyncCache : public Cache {
 
     ReadRequestState read_request_state_;
 
+    /// Resources passed to the `ReadSuccess` call that is resolving the read
+    /// futures.
+    std::shared_ptr<const void> completing_read_resources_;
+
     /// Sum of the size of all implicit transaction nodes associated with this
     /// entry.
     size_t write_state_size_ = 0;
@@ -651,6 +693,15 @@ class AsyncCache : public Cache {
     /// Returns true if this node has been revoked.
     bool IsRevoked() { return revoked_.load(std::memory_order_acquire); }
 
+    /// Attributes the writeback of this node to `io_statistics`, which
+    /// replaces any previously-specified sink.  Has no effect if
+    /// `io_statistics == nullptr`.
+    void SetWritebackIoStatistics(IoStatistics* io_statistics);
+
+    /// Returns and clears the sink most recently specified by
+    /// `SetWritebackIoStatistics`, or returns `nullptr` if none.
+    IoStatisticsPtr TakeWritebackIoStatistics();
+
     /// Invalidates the read state of this transaction node.  This must only be
     /// called if `transaction->commit_started() == true` and `Commit()` has not
     /// yet been called.  This is called in the case of multi-phase
@@ -672,7 +723,11 @@ class AsyncCache : public Cache {
 
     /// Requests a read state for this transaction node that is current as of
     /// the specified `staleness_bound`.
-    Future<const void> Read(absl::Time staleness_bound);
+    ///
+    /// \param io_statistics Optional sink to which a read issued as a result
+    ///     of this request is attributed.
+    Future<const void> Read(absl::Time staleness_bound,
+                            IoStatistics* io_statistics = nullptr);
 
     /// Requests initial or updated data from persistent storage for a single
     /// `Entry`.
@@ -686,6 +741,13 @@ class AsyncCache : public Cache {
     /// to signal completion.
     virtual void DoRead(absl::Time staleness_bound) = 0;
 
+    /// Returns the sink to which the read initiated by the most recent call to
+    /// `DoRead` is attributed, or `nullptr` if none.  Must only be called
+    /// before that read completes.
+    IoStatistics* GetReadIoStatistics() const {
+      return read_request_state_.issued_io_statistics.get();
+    }
+
     /// Signals that the read request initiated by the most recent call to
     /// `DoRead` succeeded.
     ///
@@ -877,6 +939,11 @@ class AsyncCache : public Cache {
     /// `mutex_` is acquired after `revoked_` has been set to `true`.
     std::atomic<bool> revoked_{false};
 
+    /// Sink specified by `SetWritebackIoStatistics`, which holds a reference
+    /// to it.  Updated by atomic exchange, so that recording the sink for each
+    /// written chunk does not require a lock.
+    std::atomic<IoStatistics*> writeback_io_statistics_{nullptr};
+
     enum class PrepareForCommitState {
       /// Either `PrepareForCommit` has not yet been called, or
       /// `PrepareForCommit` has been called but this node is still enqueued in
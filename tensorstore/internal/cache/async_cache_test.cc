@@ -14,8 +14,11 @@
 
 #include "tensorstore/internal/cache/async_cache.h"
 
+#include <stdint.h>
+
 #include <memory>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -25,7 +28,9 @@
 #include "tensorstore/internal/concurrent_testutil.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/memory.h"
+#include "tensorstore/internal/metrics/registry.h"
 #include "tensorstore/internal/queue_testutil.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generation_testutil.h"
 #include "tensorstore/util/future.h"
@@ -55,6 +60,7 @@ constexpr CachePool::Limits kSmallCacheLimits{10000000, 5000000};
 struct RequestLog {
   struct ReadRequest {
     AsyncCache::Entry* entry;
+    tensorstore::IoStatistics* io_statistics = nullptr;
     void Success(absl::Time time = absl::Now(),
                  std::shared_ptr<const size_t> value = {}) {
       entry->ReadSuccess(
@@ -115,7 +121,8 @@ class TestCache : public tensorstore::internal::AsyncCache {
     }
 
     void DoRead(absl::Time staleness_bound) override {
-      GetOwningCache(*this).log_->reads.push(RequestLog::ReadRequest{this});
+      GetOwningCache(*this).log_->reads.push(
+          RequestLog::ReadRequest{this, GetReadIoStatistics()});
     }
 
     bool ShareImplicitTransactionNodes() override {
@@ -341,6 +348,39 @@ TEST(AsyncCacheTest, ReadBasic) {
   }
 }
 
+// Tests that a queued read is attributed to the request that queued it, even
+// though it is issued when the prior read completes.
+TEST(AsyncCacheTest, ReadIoStatistics) {
+  auto pool = CachePool::Make(CachePool::Limits{});
+  RequestLog log;
+  auto cache = pool->GetCache<TestCache>(
+      "", [&] { return std::make_unique<TestCache>(&log); });
+  auto entry = GetCacheEntry(cache, "a");
+  auto stats1 = tensorstore::IoStatistics::Make();
+  auto stats2 = tensorstore::IoStatistics::Make();
+
+  auto read_future1 = entry->Read(absl::InfiniteFuture(), stats1.get());
+  auto read_time = UniqueNow();
+  auto read_future2 = entry->Read(absl::InfiniteFuture(), stats2.get());
+  // Shares the queued read, which remains attributed to `stats2`.
+  auto read_future3 = entry->Read(absl::InfiniteFuture(), stats1.get());
+  EXPECT_TRUE(HaveSameSharedState(read_future2, read_future3));
+  {
+    auto read_req = log.reads.pop();
+    EXPECT_EQ(stats1.get(), read_req.io_statistics);
+    read_req.Success(read_time);
+  }
+  ASSERT_TRUE(read_future1.ready());
+  ASSERT_FALSE(read_future2.ready());
+  {
+    auto read_req = log.reads.pop();
+    EXPECT_EQ(stats2.get(), read_req.io_statistics);
+    read_req.Success();
+  }
+  ASSERT_TRUE(read_future2.ready());
+  EXPECT_TRUE(log.reads.empty());
+}
+
 TEST(AsyncCacheTest, ReadFailed) {
   auto pool = CachePool::Make(kSmallCacheLimits);
   RequestLog log;
@@ -1062,6 +1102,40 @@ TEST(AsyncCacheTest, ExplicitTransactionSize) {
   }
 }
 
+int64_t GetTransactionBytesMetric() {
+  auto metric = tensorstore::internal_metrics::GetMetricRegistry().Collect(
+      "/tensorstore/transaction/total_bytes");
+  if (!metric || metric->gauges.empty()) return 0;
+  return std::get<int64_t>(metric->gauges[0].value);
+}
+
+TEST(AsyncCacheTest, TransactionBytesMetric) {
+  auto pool = CachePool::Make(CachePool::Limits{20000, 10000});
+  RequestLog log;
+  auto cache = pool->GetCache<TestCache>(
+      "", [&] { return std::make_unique<TestCache>(&log); });
+  const int64_t initial_bytes = GetTransactionBytesMetric();
+
+  auto transaction = Transaction(tensorstore::isolated);
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto open_transaction,
+        tensorstore::internal::AcquireOpenTransactionPtrOrError(transaction));
+    auto entry = GetCacheEntry(cache, "a");
+    auto node = entry->CreateWriteTransaction(open_transaction);
+    UniqueWriterLock lock(*node);
+    node->size = 1000;
+    node->MarkSizeUpdated();
+  }
+  EXPECT_EQ(initial_bytes + 1000, GetTransactionBytesMetric());
+
+  // The bytes are no longer counted once the transaction completes, even
+  // though `transaction` still references it.
+  transaction.Abort();
+  transaction.future().Wait();
+  EXPECT_EQ(initial_bytes, GetTransactionBytesMetric());
+}
+
 void TestRevokedTransactionNode(bool reverse_order) {
   auto pool = CachePool::Make(CachePool::Limits{});
   RequestLog log;
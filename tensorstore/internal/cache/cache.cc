@@ -16,6 +16,8 @@
 
 #include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <initializer_list>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <optional>
@@ -31,11 +33,13 @@
 #include "absl/container/flat_hash_set.h"
 #include "absl/functional/function_ref.h"
 #include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/cache/cache_memory_usage.h"
 #include "tensorstore/internal/cache/cache_pool_limits.h"
 #include "tensorstore/internal/integer_overflow.h"
 #include "tensorstore/internal/intrusive_linked_list.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/gauge.h"
 #include "tensorstore/internal/mutex.h"
 
 // A CacheEntry owns a strong reference to the Cache that contains it only if
@@ -53,6 +57,21 @@ auto& miss_count = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/cache/miss_count", "Number of cache misses.");
 auto& evict_count = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/cache/evict_count", "Number of evictions from the cache.");
+auto& entry_count = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/cache/entries", "Number of cache entries.");
+auto& clean_bytes = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/cache/clean_bytes",
+    "Bytes used by clean cache entries that are not in use.");
+auto& in_use_bytes = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/cache/in_use_bytes",
+    "Bytes used by clean cache entries that are in use.");
+auto& dirty_bytes = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/cache/dirty_bytes",
+    "Bytes used by dirty cache entries for which writeback has not been "
+    "requested.");
+auto& writeback_requested_bytes = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/cache/writeback_requested_bytes",
+    "Bytes used by cache entries for which writeback has been requested.");
 
 using ::tensorstore::internal::PinnedCacheEntry;
 
@@ -102,6 +121,44 @@ inline CachePtr<Cache> AcquireCacheStrongPtr(CacheImpl* cache_impl) {
 void SetStateAndSize(CacheEntryImpl* entry, CacheEntryQueueState state,
                      size_t num_bytes) noexcept;
 
+/// Adds (`sign == 1`) or removes (`sign == -1`) the contribution of `entry`,
+/// with its current `queue_state_` and `num_bytes_`, to the memory usage of its
+/// cache and cache pool.
+void AdjustMemoryUsage(CacheEntryImpl* entry, int sign) noexcept {
+  auto* cache = entry->cache_;
+  DebugAssertMutexHeld(&cache->pool_->mutex_);
+  CacheMemoryUsage::StateUsage CacheMemoryUsage::*state_usage;
+  internal_metrics::Gauge<int64_t>* state_bytes;
+  switch (entry->queue_state_) {
+    case CacheEntryQueueState::clean_and_not_in_use:
+      state_usage = &CacheMemoryUsage::clean;
+      state_bytes = &clean_bytes;
+      break;
+    case CacheEntryQueueState::clean_and_in_use:
+      state_usage = &CacheMemoryUsage::in_use;
+      state_bytes = &in_use_bytes;
+      break;
+    case CacheEntryQueueState::dirty:
+      state_usage = &CacheMemoryUsage::dirty;
+      state_bytes = &dirty_bytes;
+      break;
+    default:
+      state_usage = &CacheMemoryUsage::writeback_requested;
+      state_bytes = &writeback_requested_bytes;
+      break;
+  }
+  // Relies on unsigned overflow to do the right thing when `sign == -1`.
+  const size_t num_entries_change = static_cast<size_t>(sign);
+  const size_t num_bytes_change = num_entries_change * entry->num_bytes_;
+  for (auto* usage : {&cache->memory_usage_, &cache->pool_->memory_usage_}) {
+    auto& u = usage->*state_usage;
+    u.num_entries += num_entries_change;
+    u.num_bytes += num_bytes_change;
+  }
+  entry_count.IncrementBy(sign);
+  state_bytes->IncrementBy(sign * static_cast<int64_t>(entry->num_bytes_));
+}
+
 void UnlinkListNode(LruListNode* node) noexcept {
   Remove(LruListAccessor{}, node);
   Initialize(LruListAccessor{}, node);
@@ -110,6 +167,7 @@ void UnlinkListNode(LruListNode* node) noexcept {
 void UnregisterEntryFromPool(CacheEntryImpl* entry,
                              CachePoolImpl* pool) noexcept {
   DebugAssertMutexHeld(&pool->mutex_);
+  AdjustMemoryUsage(entry, -1);
   UnlinkListNode(entry);
   pool->total_bytes_ -= entry->num_bytes_;
   if (entry->queue_state_ == CacheEntryQueueState::dirty) {
@@ -143,7 +201,9 @@ void EnsureNotOnCleanList(CacheEntryImpl* entry) noexcept {
   DebugAssertMutexHeld(&entry->cache_->pool_->mutex_);
   if (entry->queue_state_ == CacheEntryQueueState::clean_and_not_in_use) {
     UnlinkListNode(entry);
+    AdjustMemoryUsage(entry, -1);
     entry->queue_state_ = CacheEntryQueueState::clean_and_in_use;
+    AdjustMemoryUsage(entry, 1);
   }
 }
 
@@ -178,6 +238,7 @@ void InitializeNewEntry(CacheEntryImpl* entry, CacheImpl* cache) noexcept {
   entry->reference_count_.store(1, std::memory_order_relaxed);
   entry->num_bytes_ = 0;
   entry->queue_state_ = CacheEntryQueueState::clean_and_in_use;
+  AdjustMemoryUsage(entry, 1);
   pool->total_bytes_ += entry->num_bytes_;
   MaybeEvictEntries(pool);
   Initialize(LruListAccessor{}, entry);
@@ -227,8 +288,10 @@ void SetStateAndSize(CacheEntryImpl* entry, CacheEntryQueueState state,
   }
 
   UnlinkListNode(entry);
+  AdjustMemoryUsage(entry, -1);
   entry->queue_state_ = state;
   entry->num_bytes_ = num_bytes;
+  AdjustMemoryUsage(entry, 1);
 
   if (state == CacheEntryQueueState::clean_and_not_in_use) {
     AddToEvictionQueue(pool, entry);
@@ -330,6 +393,47 @@ CachePtr<Cache> GetCacheInternal(
       Access::StaticCast<CacheImpl>(*insert_result.first));
 }
 
+namespace {
+
+/// Acquires a reference to an existing `entry_impl` of `cache`.
+PinnedCacheEntry<Cache> AcquireExistingEntry(internal::Cache* cache,
+                                             CacheEntryImpl* entry_impl)
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  DebugAssertMutexHeld(&entry_impl->cache_->pool_->mutex_);
+  if (entry_impl->reference_count_.fetch_add(1, std::memory_order_acq_rel) ==
+      0) {
+    // When the first reference to an entry is acquired, also acquire a strong
+    // reference to the cache to be held by the entry.  This ensures the Cache
+    // object is not destroyed while any of its entries are referenced.
+    StrongPtrTraitsCache::increment(cache);
+    EnsureNotOnCleanList(entry_impl);
+  }
+  // Adopt reference added via `fetch_add` above.
+  return PinnedCacheEntry<Cache>(Access::StaticCast<Cache::Entry>(entry_impl),
+                                 internal::adopt_object_ref);
+}
+
+/// Initializes `entry` if it has not already been initialized, or waits for
+/// a concurrent initialization to complete.
+void EnsureEntryInitialized(internal::Cache* cache,
+                            const PinnedCacheEntry<Cache>& entry) {
+  absl::call_once(
+      Access::StaticCast<CacheEntryImpl>(entry.get())->initialized_, [&] {
+        entry->DoInitialize();
+        // This is the only call to `DoGetSizeInBytes` made by this cache
+        // framework directly.  Because `entry` is not yet visible to other
+        // threads, it is safe to call `DoGetSizeInBytes` without holding any
+        // locks.  All other calls are made by derived classes while holding
+        // any relevant locks on the portions of the entry state that the
+        // derived implementation of DoGetSizeInBytes may access.
+        CacheEntry::StateUpdate state_update;
+        state_update.new_size = cache->DoGetSizeInBytes(entry.get());
+        entry->UpdateState(std::move(state_update));
+      });
+}
+
+}  // namespace
+
 PinnedCacheEntry<Cache> GetCacheEntryInternal(internal::Cache* cache,
                                               std::string_view key) {
   auto* cache_impl = Access::StaticCast<CacheImpl>(cache);
@@ -339,20 +443,7 @@ PinnedCacheEntry<Cache> GetCacheEntryInternal(internal::Cache* cache,
     auto it = cache_impl->entries_.find(key);
     if (it != cache_impl->entries_.end()) {
       hit_count.Increment();
-      auto* entry_impl = *it;
-      if (entry_impl->reference_count_.fetch_add(
-              1, std::memory_order_acq_rel) == 0) {
-        // When the first reference to an entry is acquired, also acquire a
-        // strong reference to the cache to be held by the entry.  This ensures
-        // the Cache object is not destroyed while any of its entries are
-        // referenced.
-        StrongPtrTraitsCache::increment(cache);
-        EnsureNotOnCleanList(entry_impl);
-      }
-      // Adopt reference added via `fetch_add` above.
-      returned_entry =
-          PinnedCacheEntry<Cache>(Access::StaticCast<Cache::Entry>(entry_impl),
-                                  internal::adopt_object_ref);
+      returned_entry = AcquireExistingEntry(cache, *it);
     } else {
       miss_count.Increment();
       std::string temp_key(key);  // May throw, done before allocating entry.
@@ -375,20 +466,23 @@ PinnedCacheEntry<Cache> GetCacheEntryInternal(internal::Cache* cache,
           PinnedCacheEntry<Cache>(entry.release(), internal::adopt_object_ref);
     }
   }
-  absl::call_once(
-      Access::StaticCast<CacheEntryImpl>(returned_entry.get())->initialized_,
-      [&] {
-        returned_entry->DoInitialize();
-        // This is the only call to `DoGetSizeInBytes` made by this cache
-        // framework directly.  Because `entry` is not yet visible to other
-        // threads, it is safe to call `DoGetSizeInBytes` without holding any
-        // locks.  All other calls are made by derived classes while holding any
-        // relevant locks on the portions of the entry state that the derived
-        // implementation of DoGetSizeInBytes may access.
-        CacheEntry::StateUpdate state_update;
-        state_update.new_size = cache->DoGetSizeInBytes(returned_entry.get());
-        returned_entry->UpdateState(std::move(state_update));
-      });
+  EnsureEntryInitialized(cache, returned_entry);
+  return returned_entry;
+}
+
+PinnedCacheEntry<Cache> FindCacheEntryInternal(internal::Cache* cache,
+                                               std::string_view key) {
+  auto* cache_impl = Access::StaticCast<CacheImpl>(cache);
+  PinnedCacheEntry<Cache> returned_entry;
+  {
+    absl::MutexLock lock(&cache_impl->pool_->mutex_);
+    auto it = cache_impl->entries_.find(key);
+    if (it == cache_impl->entries_.end()) return returned_entry;
+    returned_entry = AcquireExistingEntry(cache, *it);
+  }
+  // The entry may still be in the process of being initialized by a
+  // concurrent call to `GetCacheEntryInternal`.
+  EnsureEntryInitialized(cache, returned_entry);
   return returned_entry;
 }
 
@@ -475,6 +569,11 @@ namespace internal {
 Cache::Cache() = default;
 Cache::~Cache() = default;
 
+CacheMemoryUsage Cache::GetMemoryUsage() {
+  absl::MutexLock lock(&pool_->mutex_);
+  return memory_usage_;
+}
+
 std::size_t Cache::DoGetSizeInBytes(Cache::Entry* entry) {
   return ((internal_cache::CacheEntryImpl*)entry)->key_.capacity() +
          this->DoGetSizeofEntry();
@@ -502,7 +601,9 @@ void Cache::Entry::UpdateState(StateUpdate update) {
   if (old_num_bytes == new_num_bytes) {
     return;
   }
+  internal_cache::AdjustMemoryUsage(this, -1);
   num_bytes_ = new_num_bytes;
+  internal_cache::AdjustMemoryUsage(this, 1);
   std::size_t num_bytes_change =
       wrap_on_overflow::Subtract(new_num_bytes, old_num_bytes);
   pool->total_bytes_ += num_bytes_change;
@@ -532,6 +633,22 @@ std::ostream& operator<<(std::ostream& os, CacheEntryQueueState state) {
   }
 }
 
+CacheMemoryUsage CachePool::GetMemoryUsage() {
+  absl::MutexLock lock(&mutex_);
+  return memory_usage_;
+}
+
+std::vector<CachePool::CacheUsage> CachePool::GetCacheMemoryUsage() {
+  absl::MutexLock lock(&mutex_);
+  std::vector<CacheUsage> result;
+  result.reserve(caches_.size());
+  for (auto* cache : caches_) {
+    result.push_back(CacheUsage{cache->cache_type_, cache->cache_identifier_,
+                                cache->memory_usage_});
+  }
+  return result;
+}
+
 CachePool::StrongPtr CachePool::Make(const CachePool::Limits& cache_limits) {
   CachePool::StrongPtr pool;
   internal_cache::Access::StaticCast<internal_cache::CachePoolStrongPtr>(&pool)
@@ -82,12 +82,16 @@
 #include <iosfwd>
 #include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include "absl/functional/function_ref.h"
 #include "tensorstore/internal/cache/cache_impl.h"
+#include "tensorstore/internal/cache/cache_memory_usage.h"
 #include "tensorstore/internal/cache/cache_pool_limits.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/mutex.h"
@@ -124,6 +128,29 @@ class CachePool : private internal_cache::CachePoolImpl {
   /// Returns the limits of this cache pool.
   const Limits& limits() const { return limits_; }
 
+  /// Returns the memory usage of all entries of all caches in this pool.
+  ///
+  /// This only acquires the pool mutex, and is cheap enough to be polled.
+  CacheMemoryUsage GetMemoryUsage();
+
+  /// Memory usage of a single cache, as returned by `GetCacheMemoryUsage`.
+  struct CacheUsage {
+    /// Type specified to `GetCache`.
+    const std::type_info* cache_type;
+
+    /// Cache key specified to `GetCache`.
+    std::string cache_identifier;
+
+    CacheMemoryUsage memory_usage;
+  };
+
+  /// Returns the memory usage of each cache in this pool that was created with
+  /// a non-empty `cache_key`.
+  ///
+  /// Caches created with an empty `cache_key` are not tracked individually by
+  /// the pool, but their entries are still included in `GetMemoryUsage`.
+  std::vector<CacheUsage> GetCacheMemoryUsage();
+
   /// Returns a cache of type `CacheType` for the specified `cache_key`.
   ///
   /// If such a cache does not already exist, or `cache_key` is empty,
@@ -332,6 +359,9 @@ class Cache : private internal_cache::CacheImpl {
   /// pointer to this same cache.
   std::string_view cache_identifier() const { return cache_identifier_; }
 
+  /// Returns the memory usage of the entries of this cache.
+  CacheMemoryUsage GetMemoryUsage();
+
   /// Allocates a new `entry` to be stored in this cache.
   ///
   /// Usually this method can be defined as:
@@ -419,6 +449,18 @@ GetCacheEntry(const CachePtr<CacheType>& cache, std::string_view key) {
   return GetCacheEntry(cache.get(), key);
 }
 
+/// Returns the existing entry of `cache` for the specified `key`, or `nullptr`
+/// if there is no such entry.
+///
+/// Unlike `GetCacheEntry`, this never creates a new entry.
+template <typename CacheType>
+std::enable_if_t<std::is_base_of<Cache, CacheType>::value,
+                 PinnedCacheEntry<CacheType>>
+FindCacheEntry(CacheType* cache, std::string_view key) {
+  return static_pointer_cast<typename CacheType::Entry>(
+      internal_cache::FindCacheEntryInternal(cache, key));
+}
+
 }  // namespace internal
 }  // namespace tensorstore
 
@@ -28,6 +28,7 @@
 #include "absl/base/call_once.h"
 #include "absl/functional/function_ref.h"
 #include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/cache/cache_memory_usage.h"
 #include "tensorstore/internal/cache/cache_pool_limits.h"
 #include "tensorstore/internal/heterogeneous_container.h"
 #include "tensorstore/internal/intrusive_ptr.h"
@@ -43,6 +44,7 @@ namespace internal_cache {
 using internal::Cache;
 using internal::CacheEntry;
 using internal::CachePool;
+using internal::CacheMemoryUsage;
 using internal::CachePoolLimits;
 
 class Access;
@@ -104,6 +106,9 @@ class CacheImpl {
                                  &CacheEntryImpl::key_>
       entries_;
 
+  /// Memory usage of the entries of this cache, protected by `pool_->mutex_`.
+  CacheMemoryUsage memory_usage_;
+
   // Key by which a cache may be looked up in a `CachePool`.
   using CacheKey = std::pair<std::type_index, std::string_view>;
 
@@ -117,12 +122,14 @@ class CachePoolImpl {
   using CacheKey = CacheImpl::CacheKey;
 
   /// Protects access to `total_bytes_`, `queued_for_writeback_bytes_`,
-  /// `writeback_queue_`, `eviction_queue_`, `caches_`, and the `entries_` hash
-  /// tables of all caches associated with this pool.
+  /// `memory_usage_`, `writeback_queue_`, `eviction_queue_`, `caches_`, and the
+  /// `entries_` hash tables and `memory_usage_` of all caches associated with
+  /// this pool.
   absl::Mutex mutex_;
   CachePoolLimits limits_;
   size_t total_bytes_;
   size_t queued_for_writeback_bytes_;
+  CacheMemoryUsage memory_usage_;
   LruListNode writeback_queue_;
 
   // next points to the front of the queue, which is the first to be evicted.
@@ -206,6 +213,9 @@ CachePtr<Cache> GetCacheInternal(
 CacheEntryStrongPtr<CacheEntry> GetCacheEntryInternal(internal::Cache* cache,
                                                       std::string_view key);
 
+CacheEntryStrongPtr<CacheEntry> FindCacheEntryInternal(internal::Cache* cache,
+                                                       std::string_view key);
+
 }  // namespace internal_cache
 }  // namespace tensorstore
 
@@ -0,0 +1,65 @@
+// Copyright 2020 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CACHE_CACHE_MEMORY_USAGE_H_
+#define TENSORSTORE_INTERNAL_CACHE_CACHE_MEMORY_USAGE_H_
+
+#include <cstddef>
+
+namespace tensorstore {
+namespace internal {
+
+/// Memory accounted to a cache or cache pool, broken down by the
+/// `CacheEntryQueueState` of the entries.
+///
+/// Sizes are as reported by `Cache::DoGetSizeInBytes`, and are maintained
+/// incrementally by the cache pool, so obtaining a snapshot is cheap.
+struct CacheMemoryUsage {
+  struct StateUsage {
+    std::size_t num_entries = 0;
+    std::size_t num_bytes = 0;
+  };
+
+  /// Entries in the `clean_and_not_in_use` state, which are eligible for
+  /// eviction.
+  StateUsage clean;
+
+  /// Entries in the `clean_and_in_use` state, which are pinned by a reference
+  /// and cannot be evicted.
+  StateUsage in_use;
+
+  /// Entries in the `dirty` state, which count towards the
+  /// `queued_for_writeback_bytes_limit`.
+  StateUsage dirty;
+
+  /// Entries in the `writeback_requested` state.
+  StateUsage writeback_requested;
+
+  /// Returns the total number of entries.
+  std::size_t num_entries() const {
+    return clean.num_entries + in_use.num_entries + dirty.num_entries +
+           writeback_requested.num_entries;
+  }
+
+  /// Returns the total number of bytes.
+  std::size_t num_bytes() const {
+    return clean.num_bytes + in_use.num_bytes + dirty.num_bytes +
+           writeback_requested.num_bytes;
+  }
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CACHE_CACHE_MEMORY_USAGE_H_
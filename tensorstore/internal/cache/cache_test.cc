@@ -20,7 +20,10 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -36,6 +39,7 @@ namespace {
 using ::tensorstore::StrCat;
 using ::tensorstore::internal::Cache;
 using ::tensorstore::internal::CacheEntryQueueState;
+using ::tensorstore::internal::CacheMemoryUsage;
 using ::tensorstore::internal::CachePool;
 using ::tensorstore::internal::CachePtr;
 using ::tensorstore::internal::PinnedCacheEntry;
@@ -145,6 +149,37 @@ class TestCacheWithCachePool : public TestCache {
   CachePool::WeakPtr cache_pool;
 };
 
+void AddToMemoryUsage(CacheMemoryUsage& usage, CacheEntryImpl* entry) {
+  CacheMemoryUsage::StateUsage* state_usage;
+  switch (entry->queue_state_) {
+    case QueueState::clean_and_not_in_use:
+      state_usage = &usage.clean;
+      break;
+    case QueueState::clean_and_in_use:
+      state_usage = &usage.in_use;
+      break;
+    case QueueState::dirty:
+      state_usage = &usage.dirty;
+      break;
+    default:
+      state_usage = &usage.writeback_requested;
+      break;
+  }
+  ++state_usage->num_entries;
+  state_usage->num_bytes += entry->num_bytes_;
+}
+
+void ExpectMemoryUsageEq(const CacheMemoryUsage& expected,
+                         const CacheMemoryUsage& actual) {
+  auto as_tuple = [](const CacheMemoryUsage& u) {
+    return std::make_tuple(
+        u.clean.num_entries, u.clean.num_bytes, u.in_use.num_entries,
+        u.in_use.num_bytes, u.dirty.num_entries, u.dirty.num_bytes,
+        u.writeback_requested.num_entries, u.writeback_requested.num_bytes);
+  };
+  EXPECT_EQ(as_tuple(expected), as_tuple(actual));
+}
+
 using EntryIdentifier = std::pair<std::string, void*>;
 
 std::pair<std::string, void*> GetEntryIdentifier(CacheEntryImpl* entry) {
@@ -171,6 +206,7 @@ void AssertInvariants(const CachePool::StrongPtr& pool,
       expected_writeback_queue_entries;
 
   size_t expected_total_bytes = 0, expected_pending_writeback_bytes = 0;
+  CacheMemoryUsage expected_pool_memory_usage;
 
   // Verify that every cache owned by the pool is in `expected_caches`.
   for (auto* cache : pool_impl->caches_) {
@@ -189,7 +225,10 @@ void AssertInvariants(const CachePool::StrongPtr& pool,
       EXPECT_EQ(cache_impl, *it);
     }
 
+    CacheMemoryUsage expected_cache_memory_usage;
     for (CacheEntryImpl* entry : cache_impl->entries_) {
+      AddToMemoryUsage(expected_cache_memory_usage, entry);
+      AddToMemoryUsage(expected_pool_memory_usage, entry);
       EXPECT_EQ(
           entry->num_bytes_,
           cache->DoGetSizeInBytes(Access::StaticCast<Cache::Entry>(entry)));
@@ -206,11 +245,14 @@ void AssertInvariants(const CachePool::StrongPtr& pool,
           break;
       }
     }
+    ExpectMemoryUsageEq(expected_cache_memory_usage, cache->GetMemoryUsage());
   }
 
   EXPECT_EQ(expected_total_bytes, pool_impl->total_bytes_);
   EXPECT_EQ(expected_pending_writeback_bytes,
             pool_impl->queued_for_writeback_bytes_);
+  ExpectMemoryUsageEq(expected_pool_memory_usage, pool->GetMemoryUsage());
+  EXPECT_EQ(expected_total_bytes, pool->GetMemoryUsage().num_bytes());
 
   EXPECT_EQ(expected_eviction_queue_entries, eviction_queue_entries);
   EXPECT_EQ(expected_writeback_queue_entries, writeback_queue_entries);
@@ -401,6 +443,26 @@ TEST_P(NamedOrAnonymousCacheTest, GetWithImmediateEvict) {
   TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {test_cache.get()});
 }
 
+// Tests that `FindCacheEntry` returns existing entries without creating new
+// ones.
+TEST_P(NamedOrAnonymousCacheTest, FindCacheEntry) {
+  auto pool = CachePool::Make(kSmallCacheLimits);
+  auto test_cache = GetCache(pool);
+  EXPECT_FALSE(FindCacheEntry(test_cache.get(), "a"));
+  EXPECT_THAT(log->entry_allocate_log, ElementsAre());
+  auto e = GetCacheEntry(test_cache, "a");
+  e->data = "value";
+  EXPECT_THAT(log->entry_allocate_log, ElementsAre(cache_key));
+  {
+    auto e2 = FindCacheEntry(test_cache.get(), "a");
+    EXPECT_EQ(e, e2);
+    EXPECT_EQ(2, e->use_count());
+  }
+  EXPECT_FALSE(FindCacheEntry(test_cache.get(), "b"));
+  EXPECT_THAT(log->entry_allocate_log, ElementsAre(cache_key));
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {test_cache.get()});
+}
+
 // Tests that an unpinned entry is not destroyed immediately when using the
 // default limits.
 TEST_P(NamedOrAnonymousCacheTest, GetWithoutImmediateEvict) {
@@ -662,6 +724,53 @@ TEST_P(NamedOrAnonymousCacheTest, DelayedWritebackRequested) {
   TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {test_cache.get()});
 }
 
+TEST(CacheTest, MemoryUsage) {
+  auto pool = CachePool::Make(kSmallCacheLimits);
+  auto cache_a = GetTestCache(pool.get(), "a");
+  auto cache_b = GetTestCache(pool.get(), "b");
+  auto anonymous_cache = GetTestCache(pool.get(), "");
+  {
+    auto entry = GetCacheEntry(cache_a, "x");
+    entry->UpdateState({{/*.lock=*/{}, /*.new_size=*/100}});
+    auto usage = cache_a->GetMemoryUsage();
+    EXPECT_EQ(1, usage.in_use.num_entries);
+    EXPECT_EQ(100, usage.in_use.num_bytes);
+    EXPECT_EQ(0, usage.clean.num_entries);
+  }
+  {
+    auto usage = cache_a->GetMemoryUsage();
+    EXPECT_EQ(0, usage.in_use.num_entries);
+    EXPECT_EQ(1, usage.clean.num_entries);
+    EXPECT_EQ(100, usage.clean.num_bytes);
+  }
+  {
+    auto entry = GetCacheEntry(cache_b, "y");
+    entry->UpdateState({{/*.lock=*/{}, /*.new_size=*/20},
+                        /*.new_state=*/CacheEntryQueueState::dirty});
+  }
+  GetCacheEntry(anonymous_cache, "z")->UpdateState(
+      {{/*.lock=*/{}, /*.new_size=*/3}});
+
+  auto pool_usage = pool->GetMemoryUsage();
+  EXPECT_EQ(3, pool_usage.num_entries());
+  EXPECT_EQ(123, pool_usage.num_bytes());
+  EXPECT_EQ(2, pool_usage.clean.num_entries);
+  EXPECT_EQ(103, pool_usage.clean.num_bytes);
+  EXPECT_EQ(1, pool_usage.dirty.num_entries);
+  EXPECT_EQ(20, pool_usage.dirty.num_bytes);
+
+  // Only named caches are reported individually.
+  std::vector<std::pair<std::string, size_t>> cache_bytes;
+  for (const auto& cache_usage : pool->GetCacheMemoryUsage()) {
+    EXPECT_EQ(typeid(TestCache), *cache_usage.cache_type);
+    cache_bytes.emplace_back(cache_usage.cache_identifier,
+                             cache_usage.memory_usage.num_bytes());
+  }
+  EXPECT_THAT(cache_bytes, UnorderedElementsAre(Pair("a", 100), Pair("b", 20)));
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(
+      pool, {cache_a.get(), cache_b.get(), anonymous_cache.get()});
+}
+
 // Tests that an entry can be destroyed while dirty.
 TEST(CacheTest, DestroyWhileDirty) {
   auto log = std::make_shared<TestCache::RequestLog>();
@@ -28,6 +28,7 @@
 #include "absl/container/fixed_array.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/array.h"
 #include "tensorstore/box.h"
 #include "tensorstore/contiguous_layout.h"
@@ -43,10 +44,15 @@
 #include "tensorstore/internal/elementwise_function.h"
 #include "tensorstore/internal/grid_partition.h"
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/mapped_memory.h"
 #include "tensorstore/internal/memory.h"
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/mutex.h"
 #include "tensorstore/internal/nditerable.h"
+#include "tensorstore/io_cost.h"
+#include "tensorstore/io_statistics.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/open_mode.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/staleness_bound.h"
 #include "tensorstore/strided_layout.h"
@@ -219,6 +225,38 @@ struct ReadChunkImpl {
     return component_spec.GetReadNDIterable(std::move(read_array), origin,
                                             std::move(chunk_transform), arena);
   }
+
+  Result<SharedOffsetArray<const void>> operator()(
+      ReadChunk::GetSharedArray, IndexTransform<> chunk_transform) const {
+    // The cached read data is immutable, and the returned array shares
+    // ownership of it, which keeps it valid even after the entry is evicted.
+    const auto& component_spec =
+        GetOwningCache(*entry).grid().components[component_index];
+    absl::FixedArray<Index, kNumInlinedDims> origin(component_spec.rank());
+    GetOwningCache(*entry).grid().GetComponentOrigin(
+        component_index, entry->cell_indices(), origin);
+    auto read_array = ChunkCache::GetReadComponent(
+        AsyncCache::ReadLock<ChunkCache::ReadData>(*entry).data(),
+        component_index);
+    return component_spec.GetReadArray(std::move(read_array), origin,
+                                       std::move(chunk_transform));
+  }
+
+  StorageGeneration operator()(ReadChunk::GetGeneration) const {
+    return AsyncCache::ReadLock<void>(*entry).stamp().generation;
+  }
+
+  ReadChunk::GenerationValidator operator()(
+      ReadChunk::GetGenerationValidator) const {
+    auto cell_indices = entry->cell_indices();
+    return [cache = CachePtr<ChunkCache>(&GetOwningCache(*entry)),
+            cell_indices = std::vector<Index>(cell_indices.begin(),
+                                              cell_indices.end())](
+               StorageGeneration if_not_equal, absl::Time staleness_bound) {
+      return cache->ReadGeneration(cell_indices, std::move(if_not_equal),
+                                   staleness_bound);
+    };
+  }
 };
 
 /// TensorStore Driver ReadChunk implementation for the chunk cache, for the
@@ -289,11 +327,24 @@ struct ReadChunkTransactionImpl {
   }
 };
 
+// Both are stored inline in `ReadChunk::Impl`, which avoids a heap allocation
+// per chunk.
+static_assert(sizeof(ReadChunkImpl) <= sizeof(void*) * 2);
+static_assert(sizeof(ReadChunkTransactionImpl) <= sizeof(void*) * 2);
+
 /// Shared state used while `Read` is in progress.
 struct ReadOperationState : public AtomicReferenceCount<ReadOperationState> {
   using Receiver = AnyFlowReceiver<absl::Status, ReadChunk, IndexTransform<>>;
   struct SharedReceiver : public AtomicReferenceCount<SharedReceiver> {
     Receiver receiver;
+
+    absl::Mutex mutex;
+    /// Resources held by the reads that provided the chunks, such as their
+    /// in-flight byte reservations.  They are kept in this per-operation
+    /// state rather than in each `ReadChunk`, which must remain small, and
+    /// are released once the receiver has been stopped.
+    std::vector<std::shared_ptr<const void>> read_resources
+        ABSL_GUARDED_BY(mutex);
   };
   ReadOperationState(Receiver receiver) : shared_receiver(new SharedReceiver) {
     // The receiver is stored in a separate reference-counted object, so that it
@@ -465,6 +516,7 @@ void ChunkCache::Read(
   const auto& component_spec = grid().components[component_index];
   IntrusivePtr<ReadOperationState> state(
       new ReadOperationState(std::move(receiver)));
+  IoStatistics* io_statistics = GetCurrentIoStatistics();
   auto status = PartitionIndexTransformOverRegularGrid(
       component_spec.chunked_to_cell_dimensions, grid().chunk_shape, transform,
       [&](span<const Index> grid_cell_indices,
@@ -485,18 +537,35 @@ void ChunkCache::Read(
         if (transaction) {
           TENSORSTORE_ASSIGN_OR_RETURN(auto node,
                                        GetTransactionNode(*entry, transaction));
-          read_future = node->IsUnconditional() ? MakeReadyFuture()
-                                                : node->Read(staleness);
+          read_future = node->IsUnconditional()
+                            ? MakeReadyFuture()
+                            : node->Read(staleness, io_statistics);
           chunk.impl =
               ReadChunkTransactionImpl{component_index, std::move(node)};
         } else {
-          read_future = entry->Read(staleness);
+          read_future = entry->Read(staleness, io_statistics);
           chunk.impl = ReadChunkImpl{component_index, std::move(entry)};
         }
+        if (io_statistics) {
+          if (read_future.ready()) {
+            io_statistics->RecordCacheHit();
+          } else {
+            io_statistics->RecordCacheMiss();
+          }
+        }
         LinkValue(
             [state, chunk = std::move(chunk),
              cell_transform = IndexTransform<>(cell_transform)](
                 Promise<void> promise, ReadyFuture<const void> future) mutable {
+              if (auto* impl = chunk.impl.target<ReadChunkImpl>()) {
+                auto resources = impl->entry->GetCompletingReadResources();
+                if (resources) {
+                  auto& shared_receiver = *state->shared_receiver;
+                  absl::MutexLock lock(&shared_receiver.mutex);
+                  shared_receiver.read_resources.push_back(
+                      std::move(resources));
+                }
+              }
               execution::set_value(state->shared_receiver->receiver,
                                    std::move(chunk), std::move(cell_transform));
             },
@@ -517,6 +586,7 @@ void ChunkCache::Write(
   // immediately.  The entire stream of chunks is sent to the receiver before
   // this function returns.
   const auto& component_spec = grid().components[component_index];
+  IoStatistics* io_statistics = GetCurrentIoStatistics();
   std::atomic<bool> cancelled{false};
   execution::set_starting(receiver, [&cancelled] { cancelled = true; });
   absl::Status status = PartitionIndexTransformOverRegularGrid(
@@ -531,6 +601,7 @@ void ChunkCache::Write(
         auto transaction_copy = transaction;
         TENSORSTORE_ASSIGN_OR_RETURN(
             auto node, GetTransactionNode(*entry, transaction_copy));
+        node->SetWritebackIoStatistics(io_statistics);
         execution::set_value(
             receiver,
             WriteChunk{WriteChunkImpl{component_index, std::move(node)},
@@ -556,6 +627,16 @@ PinnedCacheEntry<ChunkCache> ChunkCache::GetEntryForCell(
   return GetCacheEntry(this, key);
 }
 
+PinnedCacheEntry<ChunkCache> ChunkCache::FindEntryForCell(
+    span<const Index> grid_cell_indices) {
+  assert(static_cast<size_t>(grid_cell_indices.size()) ==
+         grid().chunk_shape.size());
+  const std::string_view key(
+      reinterpret_cast<const char*>(grid_cell_indices.data()),
+      grid_cell_indices.size() * sizeof(Index));
+  return FindCacheEntry(this, key);
+}
+
 absl::Status ChunkCache::TransactionNode::Delete() {
   UniqueWriterLock lock(*this);
   this->MarkSizeUpdated();
@@ -599,6 +680,14 @@ std::size_t ChunkCache::TransactionNode::ComputeWriteStateSizeInBytes() {
   return total;
 }
 
+/// Size charged for a component that references a memory-mapped file.
+///
+/// Such data is backed by the page cache rather than by the cache pool, but
+/// each mapping counts towards the per-process limit on the number of mappings
+/// (`vm.max_map_count` on Linux), so it must still be charged enough that the
+/// cache pool eventually evicts it.
+constexpr std::size_t kMappedComponentSizeInBytes = 64 * 1024;
+
 std::size_t ChunkCache::Entry::ComputeReadDataSizeInBytes(
     const void* read_data) {
   const ReadData* components = static_cast<const ReadData*>(read_data);
@@ -607,8 +696,13 @@ std::size_t ChunkCache::Entry::ComputeReadDataSizeInBytes(
   for (size_t component_index = 0;
        component_index < static_cast<size_t>(component_specs.size());
        ++component_index) {
+    const auto& array = components[component_index];
+    if (array.valid() && internal::IsMappedMemoryOwner(array.pointer())) {
+      total += kMappedComponentSizeInBytes;
+      continue;
+    }
     total += component_specs[component_index].EstimateReadStateSizeInBytes(
-        components[component_index].valid());
+        array.valid());
   }
   return total;
 }
@@ -762,6 +856,91 @@ Result<ChunkLayout> ChunkCache::GetChunkLayout(size_t component_index) {
   return layout;
 }
 
+Future<TimestampedStorageGeneration> ChunkCache::ReadGeneration(
+    span<const Index> cell_indices, StorageGeneration if_not_equal,
+    absl::Time staleness_bound) {
+  return TimestampedStorageGeneration{StorageGeneration::Unknown(),
+                                      absl::InfinitePast()};
+}
+
+Result<IoCostReport> ChunkCacheDriver::ExplainIo(
+    OpenTransactionPtr transaction, IndexTransform<> transform,
+    ReadWriteMode mode) {
+  assert(mode == ReadWriteMode::read || mode == ReadWriteMode::write);
+  if (transaction) {
+    return absl::UnimplementedError(
+        "I/O cost estimation not supported within a transaction");
+  }
+  const auto& grid = cache_->grid();
+  const auto& component_spec = grid.components[component_index_];
+  const absl::Time staleness = data_staleness_bound_.time;
+  // All components of a chunk are read, decoded, and written together.
+  Index chunk_bytes = 0;
+  for (const auto& spec : grid.components) {
+    chunk_bytes += spec.EstimateReadStateSizeInBytes(/*valid=*/true);
+  }
+  const Index element_size = component_spec.dtype()->size;
+  IoCostReport report;
+  absl::InlinedVector<Index, kNumInlinedDims> origin(component_spec.rank());
+  Box<> chunk_range(component_spec.rank());
+  TENSORSTORE_RETURN_IF_ERROR(PartitionIndexTransformOverRegularGrid(
+      component_spec.chunked_to_cell_dimensions, grid.chunk_shape, transform,
+      [&](span<const Index> grid_cell_indices,
+          IndexTransformView<> cell_transform) -> absl::Status {
+        ChunkIoCost chunk;
+        chunk.mode = mode;
+        chunk.cell_indices.assign(grid_cell_indices.begin(),
+                                  grid_cell_indices.end());
+        chunk.domain = Box<>(cell_transform.output_rank());
+        TENSORSTORE_RETURN_IF_ERROR(
+            GetOutputRange(cell_transform, chunk.domain));
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto cell_to_chunk, ComposeTransforms(transform, cell_transform));
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            const bool exact, GetOutputRange(cell_to_chunk, chunk_range));
+        grid.GetComponentOrigin(component_index_, grid_cell_indices, origin);
+        const Index chunk_elements = component_spec.chunk_num_elements(origin);
+        // If the accessed positions are not a dense box, the number of input
+        // positions is an upper bound on the number of distinct elements.
+        const Index accessed_elements = std::min(
+            chunk_elements, exact ? chunk_range.num_elements()
+                                  : cell_transform.domain().num_elements());
+        const bool partial = !exact || accessed_elements < chunk_elements;
+
+        auto& cost = chunk.cost;
+        cost.chunks = 1;
+        cost.partial_chunks = partial;
+        cost.bytes_accessed = accessed_elements * element_size;
+        // Writing a chunk only requires reading it first if the chunk will not
+        // be fully overwritten.
+        if (mode == ReadWriteMode::read || partial ||
+            grid.components.size() > 1) {
+          // Look up the entry without creating it, since a dry run must not
+          // populate the cache.
+          bool cached = false;
+          if (auto entry = cache_->FindEntryForCell(grid_cell_indices)) {
+            AsyncCache::ReadLock<void> lock(*entry);
+            cached = !StorageGeneration::IsUnknown(lock.stamp().generation) &&
+                     lock.stamp().time >= staleness;
+          }
+          if (cached) {
+            cost.cached_chunks = 1;
+          } else {
+            cost.kvstore_reads = 1;
+            cost.bytes_fetched = chunk_bytes;
+            cost.bytes_decoded = chunk_bytes;
+          }
+        }
+        if (mode == ReadWriteMode::write) {
+          cost.kvstore_writes = 1;
+          cost.bytes_written = chunk_bytes;
+        }
+        report.chunks.push_back(std::move(chunk));
+        return absl::OkStatus();
+      }));
+  return report;
+}
+
 Executor ChunkCacheDriver::data_copy_executor() { return cache_->executor(); }
 
 }  // namespace internal
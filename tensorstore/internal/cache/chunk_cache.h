@@ -62,6 +62,8 @@
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/io_cost.h"
+#include "tensorstore/open_mode.h"
 #include "tensorstore/staleness_bound.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/execution/any_receiver.h"
@@ -355,12 +357,31 @@ class ChunkCache : public AsyncCache {
   PinnedCacheEntry<ChunkCache> GetEntryForCell(
       span<const Index> grid_cell_indices);
 
+  /// Returns the existing entry for the specified grid cell, or `nullptr` if
+  /// there is no such entry.
+  PinnedCacheEntry<ChunkCache> FindEntryForCell(
+      span<const Index> grid_cell_indices);
+
   /// Returns the chunk layout for the specified component.
   ///
   /// The default implementation returns a single-level layout based on the
   /// `ChunkGridSpecification`, but derived classes may override.
   virtual Result<ChunkLayout> GetChunkLayout(size_t component_index);
 
+  /// Reads the generation of the stored data for the specified grid cell,
+  /// without reading the data if its generation equals `if_not_equal`.
+  ///
+  /// This is used to implement `ReadChunk::GetGenerationValidator`, and
+  /// bypasses any data held in the cache.
+  ///
+  /// The default implementation returns `StorageGeneration::Unknown()`, which
+  /// indicates that the generation cannot be determined without reading the
+  /// data.  Derived classes backed by storage that supports conditional reads
+  /// may override.
+  virtual Future<TimestampedStorageGeneration> ReadGeneration(
+      span<const Index> cell_indices, StorageGeneration if_not_equal,
+      absl::Time staleness_bound);
+
   const Executor& executor() const { return executor_; }
 
  private:
@@ -422,6 +443,17 @@ class ChunkCacheDriver : public Driver {
   /// Returns a chunk layout derived from the `ChunkGridSpecification`.
   Result<ChunkLayout> GetChunkLayout(IndexTransformView<> transform) override;
 
+  /// Partitions `transform` over the chunk grid, like `Read` and `Write`, and
+  /// checks which chunks are already cached, without issuing any reads.
+  ///
+  /// Each chunk is assumed to require one read and/or write request for all
+  /// components.  Cache entries are not created for chunks that are not
+  /// already cached.  Estimation within a transaction is not supported, since
+  /// modifications pending in the transaction would not be taken into account.
+  Result<IoCostReport> ExplainIo(OpenTransactionPtr transaction,
+                                 IndexTransform<> transform,
+                                 ReadWriteMode mode) override;
+
   Executor data_copy_executor() override;
 
   ~ChunkCacheDriver() override;
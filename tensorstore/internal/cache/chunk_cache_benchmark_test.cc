@@ -367,6 +367,24 @@ struct RegisterBenchmarks {
         }
       }
     }
+
+    // Large cached reads, where the copy of each chunk is split across
+    // threads.
+    for (const int threads : {1, 2, 4, 8, 16}) {
+      for (const Index cell_size : {64, 256}) {
+        Register({
+            /*dtype=*/tensorstore::dtype_v<int>,
+            /*copy_shape=*/{256, 256, 256},
+            /*stride=*/{1, 1, 1},
+            /*indexed=*/{false, false, false},
+            /*cell_shape=*/{cell_size, cell_size, cell_size},
+            /*chunked=*/{true, true, true},
+            /*cached=*/true,
+            /*threads=*/threads,
+            /*read=*/true,
+        });
+      }
+    }
   }
 } register_benchmarks_;
 
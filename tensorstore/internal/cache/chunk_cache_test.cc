@@ -39,6 +39,7 @@
 #include "tensorstore/driver/chunk.h"
 #include "tensorstore/driver/driver.h"
 #include "tensorstore/driver/driver_handle.h"
+#include "tensorstore/driver/read.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/dim_expression.h"
 #include "tensorstore/index_space/index_transform.h"
@@ -83,6 +84,7 @@ using ::tensorstore::Index;
 using ::tensorstore::IndexTransform;
 using ::tensorstore::MakeArray;
 using ::tensorstore::MakeCopy;
+using ::tensorstore::MakeOffsetArray;
 using ::tensorstore::MatchesStatus;
 using ::tensorstore::no_transaction;
 using ::tensorstore::ReadProgressFunction;
@@ -587,6 +589,79 @@ TEST_F(ChunkCacheTest, ReadSingleComponentOneDimensionalExisting) {
   }
 }
 
+// Tests reading a chunk large enough that the copy is split into multiple
+// operations.
+TEST_F(ChunkCacheTest, ReadLargeChunk) {
+  auto fill_value = tensorstore::AllocateArray<int>({1000, 600});
+  for (Index i = 0; i < 1000; ++i) {
+    for (Index j = 0; j < 600; ++j) {
+      fill_value(i, j) = static_cast<int>(i * 600 + j);
+    }
+  }
+  grid = ChunkGridSpecification({ChunkGridSpecification::Component{
+      SharedArray<const void>(fill_value), Box<>(2)}});
+
+  auto cache = MakeChunkCache();
+
+  auto read_future =
+      tensorstore::Read(GetTensorStore(cache, absl::InfinitePast()) |
+                        tensorstore::Dims(0).HalfOpenInterval(1, 999));
+  {
+    auto r = mock_store->read_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(0, 0));
+    r(memory_store);
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto expected,
+      fill_value | tensorstore::Dims(0).HalfOpenInterval(1, 999) |
+          tensorstore::Materialize());
+  EXPECT_THAT(read_future.result(), ::testing::Optional(expected));
+}
+
+// Tests that reading exactly one cached chunk returns a reference to the
+// cached data rather than a copy.
+TEST_F(ChunkCacheTest, ReadIntoSharedArray) {
+  // Dimension 0 is chunked with a size of 2.
+  grid = ChunkGridSpecification({ChunkGridSpecification::Component{
+      SharedArray<const void>(MakeArray<int>({1, 2})), Box<>(1)}});
+
+  SetChunk({1}, {MakeArray<int>({5, 6})});
+
+  auto cache = MakeChunkCache();
+
+  auto read = [&](Index origin, Index size) {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto store, GetTensorStore(cache, absl::InfinitePast()) |
+                        tensorstore::Dims(0).TranslateSizedInterval(origin,
+                                                                    size));
+    return tensorstore::Read(store, tensorstore::ReadIntoSharedArrayOptions{});
+  };
+
+  auto read_future1 = read(2, 2);
+  {
+    auto r = mock_store->read_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(1));
+    r(memory_store);
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto array1, read_future1.result());
+  EXPECT_EQ(MakeOffsetArray<int>({2}, {5, 6}), array1);
+
+  // Read is satisfied from the cache, and references the same data.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto array2, read(2, 2).result());
+  EXPECT_EQ(MakeOffsetArray<int>({2}, {5, 6}), array2);
+  EXPECT_EQ(array1.data(), array2.data());
+
+  // Read spanning multiple chunks is copied.
+  auto read_future3 = read(1, 3);
+  {
+    auto r = mock_store->read_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(0));
+    r(memory_store);
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto array3, read_future3.result());
+  EXPECT_EQ(MakeOffsetArray<int>({1}, {2, 5, 6}), array3);
+}
+
 // Test reading the fill value from a two-dimensional chunk cache.
 TEST_F(ChunkCacheTest, TwoDimensional) {
   grid = ChunkGridSpecification({ChunkGridSpecification::Component{
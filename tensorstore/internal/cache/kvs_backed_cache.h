@@ -29,8 +29,13 @@
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/cord_stream.h"
+#include "tensorstore/internal/in_flight_bytes_resource.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
@@ -69,6 +74,8 @@ void KvsBackedCache_IncrementReadErrorMetric();
 ///
 /// 3. overrides `GetKeyValueStoreKey` if necessary.
 ///
+/// 4. (if an `InFlightBytesBudget` is used) overrides `EstimateInFlightBytes`.
+///
 /// This class takes care of reading from and writing to the
 /// `kvstore::Driver`, and handling the timestamps and `StorageGeneration`
 /// values.
@@ -108,16 +115,39 @@ class KvsBackedCache : public Parent {
     struct DecodeReceiverImpl {
       EntryOrNode* self_;
       TimestampedStorageGeneration stamp_;
+      // Held until the decoded data has been stored in the cache entry and the
+      // consumers of the read have copied or released it.
+      InFlightBytesReservation reservation_;
+      IoStatisticsPtr io_statistics_;
+      absl::Time start_time_ = absl::InfinitePast();
+      void RecordDecodeTime() {
+        if (io_statistics_) {
+          io_statistics_->RecordDecodeTime(absl::Now() - start_time_);
+        }
+      }
       void set_error(absl::Status error) {
+        RecordDecodeTime();
         self_->ReadError(
             GetOwningEntry(*self_).AnnotateError(error,
                                                  /*reading=*/true));
+        reservation_.Release();
       }
       void set_cancel() { set_error(absl::CancelledError("")); }
       void set_value(std::shared_ptr<const void> data) {
+        RecordDecodeTime();
         AsyncCache::ReadState read_state;
         read_state.stamp = std::move(stamp_);
         read_state.data = std::move(data);
+        if constexpr (std::is_base_of_v<AsyncCache::Entry, EntryOrNode>) {
+          if (reservation_.bytes()) {
+            // Consumers that retain the reservation while they copy the data
+            // keep the bytes reserved until they are done.
+            self_->ReadSuccess(std::move(read_state),
+                               std::make_shared<InFlightBytesReservation>(
+                                   std::move(reservation_)));
+            return;
+          }
+        }
         self_->ReadSuccess(std::move(read_state));
       }
     };
@@ -126,7 +156,14 @@ class KvsBackedCache : public Parent {
     struct ReadReceiverImpl {
       EntryOrNode* entry_or_node_;
       std::shared_ptr<const void> existing_read_data_;
+      InFlightBytesReservation reservation_;
+      IoStatisticsPtr io_statistics_;
       void set_value(kvstore::ReadResult read_result) {
+        if (io_statistics_) {
+          io_statistics_->RecordKvstoreRead(
+              GetOwningCache(*entry_or_node_).kvstore_driver(),
+              read_result.has_value() ? read_result.value.size() : 0);
+        }
         if (read_result.aborted()) {
           ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
               << *entry_or_node_
@@ -135,6 +172,7 @@ class KvsBackedCache : public Parent {
           // Value has not changed.
           entry_or_node_->ReadSuccess(AsyncCache::ReadState{
               std::move(existing_read_data_), std::move(read_result.stamp)});
+          reservation_.Release();
           return;
         }
         ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
@@ -143,35 +181,97 @@ class KvsBackedCache : public Parent {
         GetOwningEntry(*entry_or_node_)
             .DoDecode(std::move(read_result).optional_value(),
                       DecodeReceiverImpl<EntryOrNode>{
-                          entry_or_node_, std::move(read_result.stamp)});
+                          entry_or_node_, std::move(read_result.stamp),
+                          std::move(reservation_), io_statistics_,
+                          io_statistics_ ? absl::Now() : absl::InfinitePast()});
       }
       void set_error(absl::Status error) {
         KvsBackedCache_IncrementReadErrorMetric();
         entry_or_node_->ReadError(GetOwningEntry(*entry_or_node_)
                                       .AnnotateError(error, /*reading=*/true));
+        reservation_.Release();
       }
       void set_cancel() { ABSL_UNREACHABLE(); }  // COV_NF_LINE
     };
 
+    template <typename EntryOrNode>
+    struct StreamingReadReceiverImpl : public ReadReceiverImpl<EntryOrNode> {
+      void set_value(kvstore::StreamingReadResult result) {
+        if (result.read_result.aborted()) {
+          ReadReceiverImpl<EntryOrNode>::set_value(
+              std::move(result.read_result));
+          return;
+        }
+        ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
+            << *this->entry_or_node_
+            << "DoDecodeStream: " << result.read_result.stamp;
+        KvsBackedCache_IncrementReadChangedMetric();
+        auto& io_statistics = this->io_statistics_;
+        absl::Time start_time = absl::InfinitePast();
+        if (io_statistics) {
+          // The size is only known once the transfer has finished.  Decoding
+          // overlaps the transfer, so its time includes waiting for data.
+          start_time = absl::Now();
+          auto* driver = GetOwningCache(*this->entry_or_node_).kvstore_driver();
+          if (!result.value) {
+            io_statistics->RecordKvstoreRead(driver, 0);
+          } else {
+            result.value->finished().ExecuteWhenReady(
+                [io_statistics, driver, stream = result.value](
+                    ReadyFuture<const void> future) {
+                  io_statistics->RecordKvstoreRead(driver, stream->size());
+                });
+          }
+        }
+        GetOwningEntry(*this->entry_or_node_)
+            .DoDecodeStream(std::move(result.value),
+                            DecodeReceiverImpl<EntryOrNode>{
+                                this->entry_or_node_,
+                                std::move(result.read_result.stamp),
+                                std::move(this->reservation_),
+                                std::move(io_statistics), start_time});
+      }
+    };
+
     /// Implements reading for the `AsyncCache` interface.
     ///
-    /// Reads from the `kvstore::Driver` and invokes `DoDecode` with the result.
+    /// Reads from the `kvstore::Driver` and invokes `DoDecode` with the result,
+    /// or, if `SupportsStreamingDecode()` returns `true`, invokes
+    /// `DoDecodeStream` as soon as the value starts to arrive.
     ///
     /// If an error occurs, calls `ReadError` directly without invoking
     /// `DoDecode`.
+    ///
+    /// If the cache has an `InFlightBytesBudget`, the read is not issued until
+    /// `EstimateInFlightBytes()` bytes have been admitted, and the bytes are
+    /// held until the decoded data has been stored and the consumers that
+    /// retained `GetCompletingReadResources()` have released it.
+    ///
+    /// The read is attributed to the `IoStatistics` sink of the request that
+    /// required it, if any.
     void DoRead(absl::Time staleness_bound) final {
-      kvstore::ReadOptions options;
-      options.staleness_bound = staleness_bound;
-      auto read_state = AsyncCache::ReadLock<void>(*this).read_state();
-      options.if_not_equal = std::move(read_state.stamp.generation);
-      auto& cache = GetOwningCache(*this);
-      auto future = cache.kvstore_driver_->Read(this->GetKeyValueStoreKey(),
-                                                std::move(options));
-      execution::submit(
-          std::move(future),
-          ReadReceiverImpl<Entry>{this, std::move(read_state.data)});
+      IoStatisticsPtr io_statistics(this->GetReadIoStatistics());
+      auto* budget = GetOwningCache(*this).in_flight_bytes_budget_.get();
+      const size_t bytes = budget ? EstimateInFlightBytes() : 0;
+      if (bytes == 0) {
+        IssueRead(staleness_bound, {}, std::move(io_statistics));
+        return;
+      }
+      budget->Admit(bytes, [this, staleness_bound,
+                            io_statistics = std::move(io_statistics)](
+                               InFlightBytesReservation reservation) mutable {
+        IssueRead(staleness_bound, std::move(reservation),
+                  std::move(io_statistics));
+      });
     }
 
+    /// Returns an estimate of the peak number of bytes of memory required to
+    /// read or write back this entry, used to admit the operation against the
+    /// cache's `InFlightBytesBudget`.
+    ///
+    /// The default implementation returns `0`, which bypasses the budget.
+    virtual size_t EstimateInFlightBytes() { return 0; }
+
     using DecodeReceiver =
         AnyReceiver<absl::Status,
                     std::shared_ptr<const typename Derived::ReadData>>;
@@ -183,6 +283,45 @@ class KvsBackedCache : public Parent {
     virtual void DoDecode(std::optional<absl::Cord> value,
                           DecodeReceiver receiver) = 0;
 
+    /// Specifies whether `DoRead` reads the value incrementally, using
+    /// `kvstore::Driver::ReadStreaming`, and decodes it with `DoDecodeStream`.
+    ///
+    /// The transaction node read path always uses `DoDecode`.
+    virtual bool SupportsStreamingDecode() { return false; }
+
+    /// Decodes a value that is delivered incrementally from the kvstore into a
+    /// `ReadData` object.
+    ///
+    /// Only called if `SupportsStreamingDecode()` returns `true`.  The calling
+    /// thread may be the one that delivers `value`, and must not be blocked;
+    /// the derived class implementation should consume `value` using a
+    /// separate executor.  Executor threads must not be blocked either: the
+    /// implementation should consume the data that is already available with
+    /// `CordStream::TryReadAvailable` and resume from `WhenAvailable`.
+    ///
+    /// The default implementation waits for the complete value, without
+    /// blocking, and then calls `DoDecode`.
+    ///
+    /// \param value The value, or `nullptr` if the key was not found.
+    virtual void DoDecodeStream(internal::CordStreamPtr value,
+                                DecodeReceiver receiver) {
+      if (!value) {
+        DoDecode(std::nullopt, std::move(receiver));
+        return;
+      }
+      auto finished = value->finished();
+      finished.ExecuteWhenReady(
+          [this, value = std::move(value), receiver = std::move(receiver)](
+              ReadyFuture<const void> future) mutable {
+            auto data = value->ReadAll();
+            if (!data.ok()) {
+              execution::set_error(receiver, std::move(data).status());
+              return;
+            }
+            DoDecode(std::move(*data), std::move(receiver));
+          });
+    }
+
     using EncodeReceiver = AnyReceiver<absl::Status, std::optional<absl::Cord>>;
 
     /// Encodes a `ReadData` object into a value to write back to the
@@ -201,6 +340,33 @@ class KvsBackedCache : public Parent {
       return GetOwningCache(*this).kvstore_driver_->AnnotateError(
           this->GetKeyValueStoreKey(), reading ? "reading" : "writing", error);
     }
+
+   private:
+    void IssueRead(absl::Time staleness_bound,
+                   InFlightBytesReservation reservation,
+                   IoStatisticsPtr io_statistics) {
+      kvstore::ReadOptions options;
+      options.staleness_bound = staleness_bound;
+      auto read_state = AsyncCache::ReadLock<void>(*this).read_state();
+      options.if_not_equal = std::move(read_state.stamp.generation);
+      auto& cache = GetOwningCache(*this);
+      if (SupportsStreamingDecode()) {
+        auto future = cache.kvstore_driver_->ReadStreaming(
+            this->GetKeyValueStoreKey(), std::move(options));
+        execution::submit(std::move(future),
+                          StreamingReadReceiverImpl<Entry>{
+                              {this, std::move(read_state.data),
+                               std::move(reservation),
+                               std::move(io_statistics)}});
+        return;
+      }
+      auto future = cache.kvstore_driver_->Read(this->GetKeyValueStoreKey(),
+                                                std::move(options));
+      execution::submit(std::move(future),
+                        ReadReceiverImpl<Entry>{
+                            this, std::move(read_state.data),
+                            std::move(reservation), std::move(io_statistics)});
+    }
   };
 
   class TransactionNode : public Parent::TransactionNode,
@@ -230,7 +396,8 @@ class KvsBackedCache : public Parent {
       target_->KvsRead(
           {std::move(read_state.stamp.generation), staleness_bound},
           typename Entry::template ReadReceiverImpl<TransactionNode>{
-              this, std::move(read_state.data)});
+              this, std::move(read_state.data), {},
+              IoStatisticsPtr(this->GetReadIoStatistics())});
     }
 
     using ReadModifyWriteSource = kvstore::ReadModifyWriteSource;
@@ -257,6 +424,7 @@ class KvsBackedCache : public Parent {
           << ", staleness_bound=" << options.staleness_bound
           << ", mode=" << options.writeback_mode;
       auto read_state = AsyncCache::ReadLock<void>(*this).read_state();
+      written_value_size_ = std::nullopt;
       if (!StorageGeneration::IsUnknown(options.if_not_equal) &&
           options.if_not_equal == read_state.stamp.generation &&
           read_state.stamp.time >= options.staleness_bound) {
@@ -270,13 +438,19 @@ class KvsBackedCache : public Parent {
         TransactionNode* self_;
         AsyncCache::ReadState update_;
         ReadModifyWriteSource::WritebackReceiver receiver_;
+        // Held until the encoded value has been produced.
+        InFlightBytesReservation reservation_;
         void set_error(absl::Status error) {
+          reservation_.Release();
           error = GetOwningEntry(*self_).AnnotateError(std::move(error),
                                                        /*reading=*/false);
           execution::set_error(receiver_, std::move(error));
         }
         void set_cancel() { ABSL_UNREACHABLE(); }  // COV_NF_LINE
         void set_value(std::optional<absl::Cord> value) {
+          reservation_.Release();
+          // Recorded in the `IoStatistics` sink only once the write succeeds.
+          self_->written_value_size_ = value ? value->size() : 0;
           kvstore::ReadResult read_result;
           read_result.stamp = std::move(update_.stamp);
           if (value) {
@@ -314,6 +488,23 @@ class KvsBackedCache : public Parent {
             }
             return execution::set_value(receiver_, std::move(update.stamp));
           }
+          auto& entry = GetOwningEntry(*self_);
+          auto* budget = GetOwningCache(entry).in_flight_bytes_budget_.get();
+          const size_t bytes = budget ? entry.EstimateInFlightBytes() : 0;
+          if (bytes == 0) {
+            Encode(std::move(update), {});
+            return;
+          }
+          // Only the encoding is admitted against the budget, since `DoApply`
+          // may itself depend on a read.
+          budget->Admit(
+              bytes, [self = std::move(*this), update = std::move(update)](
+                         InFlightBytesReservation reservation) mutable {
+                self.Encode(std::move(update), std::move(reservation));
+              });
+        }
+        void Encode(AsyncCache::ReadState update,
+                    InFlightBytesReservation reservation) {
           ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
               << *self_ << "DoEncode";
           auto update_data =
@@ -322,7 +513,8 @@ class KvsBackedCache : public Parent {
           GetOwningEntry(*self_).DoEncode(
               std::move(update_data),
               EncodeReceiverImpl{self_, std::move(update),
-                                 std::move(receiver_)});
+                                 std::move(receiver_),
+                                 std::move(reservation)});
         }
       };
       AsyncCache::TransactionNode::ApplyOptions apply_options;
@@ -336,10 +528,18 @@ class KvsBackedCache : public Parent {
     }
 
     void KvsWritebackSuccess(TimestampedStorageGeneration new_stamp) override {
+      if (auto io_statistics = this->TakeWritebackIoStatistics();
+          io_statistics && written_value_size_) {
+        io_statistics->RecordKvstoreWrite(
+            GetOwningCache(*this).kvstore_driver(), *written_value_size_);
+      }
       return this->WritebackSuccess(
           AsyncCache::ReadState{std::move(new_data_), std::move(new_stamp)});
     }
-    void KvsWritebackError() override { this->WritebackError(); }
+    void KvsWritebackError() override {
+      this->TakeWritebackIoStatistics();
+      this->WritebackError();
+    }
 
     void KvsRevoke() override { this->Revoke(); }
 
@@ -349,11 +549,23 @@ class KvsBackedCache : public Parent {
     // Target to which this `ReadModifyWriteSource` is bound.
     ReadModifyWriteTarget* target_;
     std::shared_ptr<const void> new_data_;
+    // Size of the value most recently encoded by `KvsWriteback`, or
+    // `std::nullopt` if the most recent writeback did not encode a value.
+    std::optional<size_t> written_value_size_;
   };
 
   /// Returns the associated `kvstore::Driver`.
   kvstore::Driver* kvstore_driver() { return kvstore_driver_.get(); }
 
+  /// Sets the budget against which reads and writeback of entries are
+  /// admitted.  If `nullptr` (the default), or the budget is unlimited,
+  /// operations are issued immediately.  Must be called before any read or
+  /// write operations are performed.
+  void SetInFlightBytesBudget(IntrusivePtr<InFlightBytesBudget> budget) {
+    if (budget && budget->limit() == 0) budget.reset();
+    in_flight_bytes_budget_ = std::move(budget);
+  }
+
   /// Sets the `kvstore::Driver`.  The caller is responsible for ensuring there
   /// are no concurrent read or write operations.
   void SetKvStoreDriver(kvstore::DriverPtr driver) {
@@ -361,6 +573,7 @@ class KvsBackedCache : public Parent {
   }
 
   kvstore::DriverPtr kvstore_driver_;
+  IntrusivePtr<InFlightBytesBudget> in_flight_bytes_budget_;
 };
 
 }  // namespace internal
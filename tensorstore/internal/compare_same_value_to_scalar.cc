@@ -0,0 +1,154 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/compare_same_value_to_scalar.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+#include "absl/status/status.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/elementwise_function.h"
+#include "tensorstore/util/utf8_string.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+/// Number of elements compared bitwise before checking for a difference.
+///
+/// Large enough for the inner loop to be vectorized effectively, and small
+/// enough that a difference is detected soon after it occurs.
+constexpr Index kBlockSize = 64;
+
+/// Unsigned integer type used to compare elements of type `T` bitwise.
+template <size_t ElementSize>
+struct BitwiseWord {
+  using type = uint64_t;
+};
+template <>
+struct BitwiseWord<1> {
+  using type = uint8_t;
+};
+template <>
+struct BitwiseWord<2> {
+  using type = uint16_t;
+};
+template <>
+struct BitwiseWord<4> {
+  using type = uint32_t;
+};
+
+template <typename T>
+constexpr bool SupportsBitwiseComparison =
+    IsTrivial<T> && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                     sizeof(T) % 8 == 0);
+
+/// Indicates that bitwise inequality implies "same value" inequality.
+template <typename T>
+constexpr bool BitwiseInequalityIsExact =
+    std::is_integral_v<T> || std::is_same_v<T, std::byte>;
+
+template <typename T>
+struct CompareSameValueToScalarLoopTemplate {
+  using ElementwiseFunctionType = ElementwiseFunction<1, absl::Status*>;
+
+  template <typename ArrayAccessor>
+  static Index Loop(void* context, Index count, IterationBufferPointer pointer,
+                    absl::Status* /*status*/) {
+    const T& value = *static_cast<const T*>(context);
+    if constexpr (SupportsBitwiseComparison<T> &&
+                  ArrayAccessor::buffer_kind ==
+                      IterationBufferKind::kContiguous) {
+      return ContiguousLoop(value, count,
+                            static_cast<const T*>(pointer.pointer.get()));
+    } else {
+      return ElementLoop<ArrayAccessor>(value, 0, count, pointer);
+    }
+  }
+
+  /// Compares elements `[begin, end)` one at a time.
+  template <typename ArrayAccessor>
+  static Index ElementLoop(const T& value, Index begin, Index end,
+                           IterationBufferPointer pointer) {
+    for (Index i = begin; i < end; ++i) {
+      if (!internal_data_type::CompareSameValue<T>(
+              *ArrayAccessor::template GetPointerAtOffset<const T>(pointer, i),
+              value)) {
+        return i;
+      }
+    }
+    return end;
+  }
+
+  static Index ContiguousLoop(const T& value, Index count, const T* elements) {
+    using Word = typename BitwiseWord<sizeof(T)>::type;
+    constexpr size_t kWordsPerElement = sizeof(T) / sizeof(Word);
+    Word value_words[kWordsPerElement];
+    std::memcpy(value_words, &value, sizeof(T));
+    const char* data = reinterpret_cast<const char*>(elements);
+    for (Index block_begin = 0; block_begin < count;
+         block_begin += kBlockSize) {
+      const Index block_end = std::min(count, block_begin + kBlockSize);
+      Word difference = 0;
+      for (Index i = block_begin; i < block_end; ++i) {
+        for (size_t j = 0; j < kWordsPerElement; ++j) {
+          Word word;
+          std::memcpy(&word, data + i * sizeof(T) + j * sizeof(Word),
+                      sizeof(Word));
+          difference |= word ^ value_words[j];
+        }
+      }
+      if (difference == 0) continue;
+      if constexpr (BitwiseInequalityIsExact<T>) {
+        // Locate the first element that differs.
+        for (Index i = block_begin;; ++i) {
+          if (std::memcmp(elements + i, &value, sizeof(T)) != 0) return i;
+        }
+      } else {
+        // Elements that differ bitwise may still be "same value" equal, e.g.
+        // NaN values with different payloads.
+        const Index end = ElementLoop<
+            IterationBufferAccessor<IterationBufferKind::kContiguous>>(
+            value, block_begin, block_end,
+            IterationBufferPointer(const_cast<T*>(elements),
+                                   static_cast<Index>(sizeof(T))));
+        if (end != block_end) return end;
+      }
+    }
+    return count;
+  }
+};
+
+}  // namespace
+
+const std::array<ElementwiseFunction<1, absl::Status*>, kNumDataTypeIds>
+    kCompareSameValueToScalarFunctions =
+        MapCanonicalDataTypes([](auto dtype) {
+          using T = typename decltype(dtype)::Element;
+          ElementwiseFunction<1, absl::Status*> function =
+              GetElementwiseFunction<
+                  CompareSameValueToScalarLoopTemplate<T>>();
+          return function;
+        });
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,46 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_COMPARE_SAME_VALUE_TO_SCALAR_H_
+#define TENSORSTORE_INTERNAL_COMPARE_SAME_VALUE_TO_SCALAR_H_
+
+#include <array>
+
+#include "absl/status/status.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/internal/elementwise_function.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Elementwise function, for each canonical data type, that checks whether
+/// every element of an array is "same value" equal (as defined by
+/// `DataTypeOperations::compare_same_value`) to a single scalar value.
+///
+/// The `context` points to the scalar value, which must be of the same data
+/// type.  Returns the number of leading elements that compare equal, so that
+/// iteration stops at the first element that differs.
+///
+/// For contiguous arrays, elements are first compared bitwise in fixed-size
+/// blocks using a loop that the compiler can vectorize.  For data types where
+/// bitwise inequality does not imply "same value" inequality (floating point
+/// and complex types, due to the multiple representations of NaN), blocks that
+/// differ bitwise are re-checked element by element.
+extern const std::array<ElementwiseFunction<1, absl::Status*>, kNumDataTypeIds>
+    kCompareSameValueToScalarFunctions;
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_COMPARE_SAME_VALUE_TO_SCALAR_H_
@@ -0,0 +1,79 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// Benchmarks `AreArraysSameValueEqual` comparing a chunk to its fill value,
+/// as done by `AsyncWriteArray` to elide writeback of chunks equal to the fill
+/// value.
+///
+/// The "Broadcast" variants compare to a broadcast scalar fill value, which
+/// uses `kCompareSameValueToScalarFunctions`.  The "Materialized" variants
+/// compare to a fill value copied to a full-size array, which uses the generic
+/// elementwise comparison.
+
+#include <stdint.h>
+
+#include <benchmark/benchmark.h>
+#include "tensorstore/array.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/util/span.h"
+
+namespace {
+
+using ::tensorstore::Index;
+using ::tensorstore::span;
+
+template <typename T>
+void BenchmarkCompareToFillValue(benchmark::State& state, bool materialize) {
+  const Index size = state.range(0);
+  // 3-d chunk of `size^3` elements, equal to the fill value.
+  const Index shape[] = {size, size, size};
+  auto chunk = tensorstore::AllocateArray<T>(shape, tensorstore::c_order,
+                                             tensorstore::value_init);
+  tensorstore::SharedArray<const void> fill_value =
+      tensorstore::BroadcastArray(tensorstore::MakeScalarArray<T>(T{}),
+                                  span<const Index>(shape))
+          .value();
+  if (materialize) {
+    fill_value = tensorstore::MakeCopy(fill_value, tensorstore::c_order);
+  }
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        tensorstore::AreArraysSameValueEqual(chunk, fill_value));
+  }
+  state.SetBytesProcessed(state.iterations() * chunk.num_elements() *
+                          sizeof(T));
+}
+
+template <typename T>
+void BM_Broadcast(benchmark::State& state) {
+  BenchmarkCompareToFillValue<T>(state, /*materialize=*/false);
+}
+
+template <typename T>
+void BM_Materialized(benchmark::State& state) {
+  BenchmarkCompareToFillValue<T>(state, /*materialize=*/true);
+}
+
+BENCHMARK_TEMPLATE(BM_Broadcast, uint8_t)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Materialized, uint8_t)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Broadcast, uint16_t)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Materialized, uint16_t)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Broadcast, uint64_t)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Materialized, uint64_t)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Broadcast, float)->Range(16, 256);
+BENCHMARK_TEMPLATE(BM_Materialized, float)->Range(16, 256);
+
+}  // namespace
@@ -0,0 +1,162 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/compression/adaptive_compressor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <blosc.h>
+#include "tensorstore/internal/compression/blosc.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+auto& adaptive_choices = internal_metrics::Counter<int64_t, std::string>::New(
+    "/tensorstore/compression/adaptive/choices", "codec",
+    "Count of chunks encoded by the adaptive compressor, by chosen codec.");
+
+/// Number of evenly-spaced slices of the input that make up the sample when
+/// the input exceeds `sample_bytes`.
+constexpr size_t kNumSampleSlices = 4;
+
+absl::Cord GetSample(const absl::Cord& input, size_t element_size,
+                     size_t sample_bytes) {
+  if (input.size() <= sample_bytes) return input;
+  // Slices are aligned to `element_size` so that shuffling sees the same byte
+  // positions as it would when encoding the full input.
+  const size_t num_elements = input.size() / element_size;
+  const size_t slice_elements =
+      std::max<size_t>(1, sample_bytes / kNumSampleSlices / element_size);
+  if (num_elements <= slice_elements * kNumSampleSlices) return input;
+  absl::Cord sample;
+  for (size_t i = 0; i < kNumSampleSlices; ++i) {
+    const size_t start_element =
+        (num_elements - slice_elements) * i / (kNumSampleSlices - 1);
+    sample.Append(input.Subcord(start_element * element_size,
+                                slice_elements * element_size));
+  }
+  return sample;
+}
+
+blosc::Options GetBloscOptions(const AdaptiveCompressor::Candidate& candidate,
+                               size_t element_size) {
+  return blosc::Options{candidate.codec.c_str(), candidate.level,
+                        candidate.shuffle, /*blocksize=*/0, element_size};
+}
+
+std::string GetMetricLabel(const AdaptiveCompressor::Candidate* candidate) {
+  if (!candidate) return "raw";
+  return tensorstore::StrCat(candidate->codec, "/", candidate->level, "/",
+                             candidate->shuffle);
+}
+
+}  // namespace
+
+absl::Status AdaptiveCompressor::ValidateSpeedWeight(double speed_weight) {
+  if (!std::isfinite(speed_weight) || speed_weight < 0) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Expected non-negative speed_weight, but received: ", speed_weight));
+  }
+  return absl::OkStatus();
+}
+
+std::vector<AdaptiveCompressor::Candidate>
+AdaptiveCompressor::DefaultCandidates() {
+  return {
+      {BLOSC_LZ4_COMPNAME, 5, BLOSC_SHUFFLE},
+      {BLOSC_LZ4_COMPNAME, 5, BLOSC_BITSHUFFLE},
+      {BLOSC_ZSTD_COMPNAME, 1, BLOSC_SHUFFLE},
+      {BLOSC_ZSTD_COMPNAME, 5, BLOSC_SHUFFLE},
+  };
+}
+
+absl::Status AdaptiveCompressor::Encode(const absl::Cord& input,
+                                        absl::Cord* output,
+                                        std::size_t element_size) const {
+  const Candidate* best = nullptr;
+  // Encoded `sample`, retained when the sample is the entire input so that the
+  // chosen candidate need not be re-run.
+  absl::Cord best_encoded;
+  if (!input.empty()) {
+    const absl::Cord sample = GetSample(input, element_size, sample_bytes);
+    const bool sample_is_input = sample.size() == input.size();
+    double best_cost = 1;
+    for (const auto& candidate : candidates) {
+      absl::Cord encoded;
+      const absl::Time start = absl::Now();
+      TENSORSTORE_RETURN_IF_ERROR(blosc::Encode(
+          sample, &encoded, GetBloscOptions(candidate, element_size)));
+      double cost = static_cast<double>(encoded.size()) / sample.size();
+      if (speed_weight != 0) {
+        cost += speed_weight *
+                absl::ToDoubleNanoseconds(absl::Now() - start) / sample.size();
+      }
+      if (cost < best_cost) {
+        best_cost = cost;
+        best = &candidate;
+        if (sample_is_input) best_encoded = std::move(encoded);
+      }
+    }
+    if (best && !sample_is_input) {
+      TENSORSTORE_RETURN_IF_ERROR(blosc::Encode(
+          input, &best_encoded, GetBloscOptions(*best, element_size)));
+    }
+    // The sample may not be representative; never store a chunk larger than
+    // the raw encoding.
+    if (best && best_encoded.size() >= input.size()) {
+      best = nullptr;
+    }
+  }
+  adaptive_choices.Increment(GetMetricLabel(best));
+  const char tag = best ? kBloscTag : kRawTag;
+  output->Append(std::string_view(&tag, 1));
+  output->Append(best ? std::move(best_encoded) : input);
+  return absl::OkStatus();
+}
+
+absl::Status AdaptiveCompressor::Decode(const absl::Cord& input,
+                                        absl::Cord* output,
+                                        std::size_t element_size) const {
+  if (input.empty()) {
+    return absl::InvalidArgumentError(
+        "Adaptive-encoded chunk is missing codec tag");
+  }
+  const unsigned char tag = static_cast<unsigned char>(input[0]);
+  const absl::Cord payload = input.Subcord(1, input.size() - 1);
+  switch (tag) {
+    case kRawTag:
+      output->Append(payload);
+      return absl::OkStatus();
+    case kBloscTag:
+      return blosc::Decode(payload, output);
+  }
+  return absl::InvalidArgumentError(tensorstore::StrCat(
+      "Invalid adaptive codec tag: ", static_cast<int>(tag)));
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,130 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_COMPRESSION_ADAPTIVE_COMPRESSOR_H_
+#define TENSORSTORE_INTERNAL_COMPRESSION_ADAPTIVE_COMPRESSOR_H_
+
+/// \file Defines a JsonSpecifiedCompressor that selects the codec per chunk.
+///
+/// Each encoded chunk starts with a single tag byte identifying the codec that
+/// was chosen for it, so that chunks encoded with different codecs (or with
+/// different candidate lists) can always be decoded:
+///
+///   - `kRawTag`: the remaining bytes are the uncompressed input.
+///   - `kBloscTag`: the remaining bytes are a self-describing blosc buffer.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include <blosc.h>
+#include "tensorstore/internal/compression/blosc_compressor.h"
+#include "tensorstore/internal/compression/json_specified_compressor.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_array.h"
+
+namespace tensorstore {
+namespace internal {
+
+class AdaptiveCompressor : public internal::JsonSpecifiedCompressor {
+ public:
+  constexpr static unsigned char kRawTag = 0;
+  constexpr static unsigned char kBloscTag = 1;
+
+  /// Blosc configuration that may be chosen for a chunk.
+  struct Candidate {
+    std::string codec;
+    int level;
+    int shuffle;
+
+    friend bool operator==(const Candidate& a, const Candidate& b) {
+      return a.codec == b.codec && a.level == b.level &&
+             a.shuffle == b.shuffle;
+    }
+  };
+
+  /// Encodes `input` with the candidate that minimizes
+  /// `compressed_size / input_size + speed_weight * encode_ns_per_byte`, as
+  /// measured on a sample of at most `sample_bytes` bytes of `input`.  Storing
+  /// the input uncompressed is always a candidate with a cost of `1`.
+  absl::Status Encode(const absl::Cord& input, absl::Cord* output,
+                      std::size_t element_size) const override;
+
+  absl::Status Decode(const absl::Cord& input, absl::Cord* output,
+                      std::size_t element_size) const override;
+
+  static absl::Status ValidateSpeedWeight(double speed_weight);
+
+  /// Returns the candidates used if none are specified.
+  static std::vector<Candidate> DefaultCandidates();
+
+  static constexpr auto CandidateBinder() {
+    namespace jb = tensorstore::internal_json_binding;
+    return jb::Object(
+        jb::Member("cname", jb::Projection(&Candidate::codec,
+                                           BloscCompressor::CodecBinder())),
+        jb::Member("clevel", jb::Projection(&Candidate::level,
+                                            jb::Integer<int>(0, 9))),
+        jb::Member("shuffle", jb::Projection(&Candidate::shuffle,
+                                             jb::Integer<int>(-1, 2))));
+  }
+
+  /// Binder for the compressor-specific members, shared by the zarr and n5
+  /// registrations.
+  static constexpr auto MembersBinder() {
+    namespace jb = tensorstore::internal_json_binding;
+    return jb::Object(
+        jb::Member("candidates",
+                   jb::Projection(&AdaptiveCompressor::candidates,
+                                  jb::DefaultValue<jb::kAlwaysIncludeDefaults>(
+                                      [](std::vector<Candidate>* v) {
+                                        *v = DefaultCandidates();
+                                      },
+                                      jb::Array(CandidateBinder())))),
+        jb::Member("speed_weight",
+                   jb::Projection(&AdaptiveCompressor::speed_weight,
+                                  jb::DefaultValue<jb::kAlwaysIncludeDefaults>(
+                                      [](double* v) { *v = 0; },
+                                      jb::Validate(
+                                          [](const auto& options, double* v) {
+                                            return ValidateSpeedWeight(*v);
+                                          },
+                                          jb::LooseFloatBinder)))),
+        jb::Member("sample_bytes",
+                   jb::Projection(&AdaptiveCompressor::sample_bytes,
+                                  jb::DefaultValue<jb::kAlwaysIncludeDefaults>(
+                                      [](std::size_t* v) { *v = 65536; },
+                                      jb::Integer<std::size_t>(1)))));
+  }
+
+  std::vector<Candidate> candidates;
+
+  /// Cost, in units of compression ratio, of one nanosecond of encoding time
+  /// per input byte.  A value of `0` (the default) selects purely by
+  /// compression ratio, so that the encoding of a chunk is deterministic.  Any
+  /// other value makes the choice depend on measured wall-clock time, so the
+  /// same chunk may be encoded differently by different writes.
+  double speed_weight;
+
+  /// Maximum number of bytes of each chunk that are trial-encoded with every
+  /// candidate.
+  std::size_t sample_bytes;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_COMPRESSION_ADAPTIVE_COMPRESSOR_H_
@@ -0,0 +1,138 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/compression/adaptive_compressor.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include <blosc.h>
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::AdaptiveCompressor;
+
+AdaptiveCompressor MakeCompressor(size_t sample_bytes = 65536) {
+  AdaptiveCompressor compressor;
+  compressor.candidates = AdaptiveCompressor::DefaultCandidates();
+  // Selection by compression ratio alone is deterministic.
+  compressor.speed_weight = 0;
+  compressor.sample_bytes = sample_bytes;
+  return compressor;
+}
+
+/// Returns `size` bytes that blosc cannot compress.
+std::string GetIncompressibleData(size_t size) {
+  std::string data(size, '\0');
+  uint32_t state = 1;
+  for (auto& c : data) {
+    state = state * 1664525 + 1013904223;
+    c = static_cast<char>(state >> 24);
+  }
+  return data;
+}
+
+std::vector<absl::Cord> GetTestArrays() {
+  std::vector<absl::Cord> arrays;
+  arrays.emplace_back();
+  arrays.emplace_back(std::string(100000, '\0'));
+  arrays.emplace_back(GetIncompressibleData(1000));
+  arrays.emplace_back("The quick brown fox jumped over the lazy dog.");
+  {
+    std::string arr(100000, '\0');
+    unsigned char v = 0;
+    for (auto& x : arr) {
+      x = (v += 7);
+    }
+    arrays.emplace_back(std::move(arr));
+  }
+  return arrays;
+}
+
+TEST(AdaptiveCompressorTest, EncodeDecode) {
+  for (size_t sample_bytes : {1, 100, 65536}) {
+    auto compressor = MakeCompressor(sample_bytes);
+    for (const auto& array : GetTestArrays()) {
+      for (const size_t element_size : {1, 2, 10}) {
+        absl::Cord encode_result, decode_result;
+        TENSORSTORE_ASSERT_OK(
+            compressor.Encode(array, &encode_result, element_size));
+        EXPECT_LE(encode_result.size(), array.size() + 1);
+        TENSORSTORE_ASSERT_OK(
+            compressor.Decode(encode_result, &decode_result, element_size));
+        EXPECT_EQ(array, decode_result);
+      }
+    }
+  }
+}
+
+TEST(AdaptiveCompressorTest, ChoosesBloscForCompressibleData) {
+  auto compressor = MakeCompressor();
+  absl::Cord input(std::string(10000, '\0'));
+  absl::Cord encoded;
+  TENSORSTORE_ASSERT_OK(compressor.Encode(input, &encoded, 1));
+  EXPECT_EQ(AdaptiveCompressor::kBloscTag,
+            static_cast<unsigned char>(encoded[0]));
+  EXPECT_LT(encoded.size(), 1000);
+}
+
+TEST(AdaptiveCompressorTest, ChoosesRawForIncompressibleData) {
+  auto compressor = MakeCompressor();
+  absl::Cord input(GetIncompressibleData(1000));
+  absl::Cord encoded;
+  TENSORSTORE_ASSERT_OK(compressor.Encode(input, &encoded, 1));
+  EXPECT_EQ(AdaptiveCompressor::kRawTag,
+            static_cast<unsigned char>(encoded[0]));
+  EXPECT_EQ(input, encoded.Subcord(1, encoded.size() - 1));
+}
+
+TEST(AdaptiveCompressorTest, NoCandidates) {
+  auto compressor = MakeCompressor();
+  compressor.candidates.clear();
+  absl::Cord input(std::string(10000, '\0'));
+  absl::Cord encoded;
+  TENSORSTORE_ASSERT_OK(compressor.Encode(input, &encoded, 1));
+  EXPECT_EQ(AdaptiveCompressor::kRawTag,
+            static_cast<unsigned char>(encoded[0]));
+}
+
+TEST(AdaptiveCompressorTest, DecodeInvalid) {
+  auto compressor = MakeCompressor();
+  absl::Cord output;
+  EXPECT_THAT(compressor.Decode(absl::Cord(), &output, 1),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Adaptive-encoded chunk is missing codec tag"));
+  EXPECT_THAT(compressor.Decode(absl::Cord("\x05"), &output, 1),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Invalid adaptive codec tag: 5"));
+  EXPECT_THAT(compressor.Decode(absl::Cord("\x01" "abc"), &output, 1),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(AdaptiveCompressorTest, ValidateSpeedWeight) {
+  TENSORSTORE_EXPECT_OK(AdaptiveCompressor::ValidateSpeedWeight(0));
+  TENSORSTORE_EXPECT_OK(AdaptiveCompressor::ValidateSpeedWeight(0.5));
+  EXPECT_THAT(AdaptiveCompressor::ValidateSpeedWeight(-1),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
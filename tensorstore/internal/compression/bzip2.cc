@@ -101,5 +101,68 @@ absl::Status Decode(const absl::Cord& input, absl::Cord* output) {
   ABSL_UNREACHABLE();  // COV_NF_LINE
 }
 
+struct StreamDecoder::State {
+  bz_stream stream = {};
+  bool stream_end = false;
+};
+
+StreamDecoder::StreamDecoder() : state_(new State) {
+  int err = BZ2_bzDecompressInit(&state_->stream, /*verbosity=*/0,
+                                 // No need to reduce memory usage.
+                                 /*small=*/0);
+  ABSL_CHECK_EQ(err, BZ_OK);
+}
+
+StreamDecoder::~StreamDecoder() { BZ2_bzDecompressEnd(&state_->stream); }
+
+absl::Status StreamDecoder::Feed(const absl::Cord& input, absl::Cord* output) {
+  if (input.empty()) return absl::OkStatus();
+  return Process(input, output, /*finish=*/false);
+}
+
+absl::Status StreamDecoder::Finish(absl::Cord* output) {
+  return Process(absl::Cord(), output, /*finish=*/true);
+}
+
+absl::Status StreamDecoder::Process(const absl::Cord& input,
+                                    absl::Cord* output, bool finish) {
+  const auto data_error = [] {
+    return absl::InvalidArgumentError("Error decoding bzip2-compressed data");
+  };
+  if (state_->stream_end) {
+    // Data following the end of the bzip2 stream is invalid.
+    if (!input.empty()) return data_error();
+    return absl::OkStatus();
+  }
+  StreamManager stream_manager(state_->stream, input, output);
+  while (true) {
+    stream_manager.FeedInputAndOutputBuffers();
+    const int err = BZ2_bzDecompress(&state_->stream);
+    const bool made_progress = stream_manager.HandleOutput();
+    switch (err) {
+      case BZ_STREAM_END:
+        if (stream_manager.has_input_remaining()) return data_error();
+        state_->stream_end = true;
+        return absl::OkStatus();
+      case BZ_OK:
+        break;
+      case BZ_DATA_ERROR_MAGIC:
+      case BZ_DATA_ERROR:
+        return data_error();
+      case BZ_MEM_ERROR:
+      case BZ_PARAM_ERROR:
+      default:
+        ABSL_CHECK(false);
+    }
+    if (!made_progress) {
+      // All output that can be produced from the input so far has been
+      // appended.  Once the end of the input has been reached, the end of the
+      // bzip2 stream must also have been reached.
+      if (finish || stream_manager.has_input_remaining()) return data_error();
+      return absl::OkStatus();
+    }
+  }
+}
+
 }  // namespace bzip2
 }  // namespace tensorstore
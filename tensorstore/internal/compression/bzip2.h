@@ -16,6 +16,7 @@
 #define TENSORSTORE_INTERNAL_COMPRESSION_BZIP2_H_
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
 #include "absl/status/status.h"
@@ -50,6 +51,39 @@ void Encode(const absl::Cord& input, absl::Cord* output,
 /// \error `absl::StatusCode::kInvalidArgument` if `input` is corrupt.
 absl::Status Decode(const absl::Cord& input, absl::Cord* output);
 
+/// Decompresses input that is delivered incrementally.
+///
+/// `Feed` is called with each successive piece of the input, followed by a
+/// single call to `Finish`.  Neither call blocks.
+class StreamDecoder {
+ public:
+  StreamDecoder();
+
+  StreamDecoder(const StreamDecoder&) = delete;
+  StreamDecoder& operator=(const StreamDecoder&) = delete;
+
+  ~StreamDecoder();
+
+  /// Decompresses the next piece of the input, and appends the result to
+  /// `*output`.
+  ///
+  /// \error `absl::StatusCode::kInvalidArgument` if the input is corrupt.
+  absl::Status Feed(const absl::Cord& input, absl::Cord* output);
+
+  /// Completes decompression once all of the input has been fed.
+  ///
+  /// \error `absl::StatusCode::kInvalidArgument` if the input is corrupt or
+  ///     truncated.
+  absl::Status Finish(absl::Cord* output);
+
+ private:
+  absl::Status Process(const absl::Cord& input, absl::Cord* output,
+                       bool finish);
+
+  struct State;
+  std::unique_ptr<State> state_;
+};
+
 }  // namespace bzip2
 }  // namespace tensorstore
 
@@ -18,6 +18,7 @@
 /// \file Defines a bzip2 JsonSpecifiedCompressor.
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
 #include "absl/status/status.h"
@@ -42,6 +43,24 @@ class Bzip2Compressor : public internal::JsonSpecifiedCompressor,
     // element_size is not used for bzip2 compression.
     return bzip2::Decode(input, output);
   }
+  bool SupportsStreamingDecode() const override { return true; }
+  std::unique_ptr<StreamDecoder> GetStreamDecoder(
+      std::size_t element_size) const override {
+    // element_size is not used for bzip2 compression.
+    class Decoder : public StreamDecoder {
+     public:
+      absl::Status Feed(const absl::Cord& input, absl::Cord* output) override {
+        return decoder_.Feed(input, output);
+      }
+      absl::Status Finish(absl::Cord* output) override {
+        return decoder_.Finish(output);
+      }
+
+     private:
+      bzip2::StreamDecoder decoder_;
+    };
+    return std::make_unique<Decoder>();
+  }
 };
 
 }  // namespace internal
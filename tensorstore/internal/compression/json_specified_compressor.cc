@@ -14,6 +14,9 @@
 
 #include "tensorstore/internal/compression/json_specified_compressor.h"
 
+#include <cstddef>
+#include <memory>
+
 #include "absl/status/status.h"
 
 namespace tensorstore {
@@ -21,5 +24,14 @@ namespace internal {
 
 JsonSpecifiedCompressor::~JsonSpecifiedCompressor() = default;
 
+JsonSpecifiedCompressor::StreamDecoder::~StreamDecoder() = default;
+
+bool JsonSpecifiedCompressor::SupportsStreamingDecode() const { return false; }
+
+std::unique_ptr<JsonSpecifiedCompressor::StreamDecoder>
+JsonSpecifiedCompressor::GetStreamDecoder(std::size_t element_bytes) const {
+  return nullptr;
+}
+
 }  // namespace internal
 }  // namespace tensorstore
@@ -16,6 +16,7 @@
 #define TENSORSTORE_INTERNAL_COMPRESSION_JSON_SPECIFIED_COMPRESSOR_H_
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
 #include "absl/status/status.h"
@@ -61,6 +62,42 @@ class JsonSpecifiedCompressor
   virtual absl::Status Decode(const absl::Cord& input, absl::Cord* output,
                               std::size_t element_bytes) const = 0;
 
+  /// Decoder for input that is delivered incrementally.
+  class StreamDecoder {
+   public:
+    virtual ~StreamDecoder();
+
+    /// Decodes the next piece of the input, without blocking.
+    ///
+    /// \param input The next piece of the input data.
+    /// \param output[out] Output buffer to which decoded output will be
+    ///     appended.  The value is unspecified if an error occurs.
+    /// \error `absl::StatusCode::kInvalidArgument` if the input is invalid.
+    virtual absl::Status Feed(const absl::Cord& input, absl::Cord* output) = 0;
+
+    /// Completes decoding once all of the input has been passed to `Feed`.
+    ///
+    /// \param output[out] Output buffer to which decoded output will be
+    ///     appended.  The value is unspecified if an error occurs.
+    /// \error `absl::StatusCode::kInvalidArgument` if the input is invalid.
+    virtual absl::Status Finish(absl::Cord* output) = 0;
+  };
+
+  /// Specifies whether `GetStreamDecoder` is supported, i.e. whether decoding
+  /// can make progress before the complete input is available.
+  ///
+  /// The default implementation returns `false`.
+  virtual bool SupportsStreamingDecode() const;
+
+  /// Returns a decoder for input that is delivered incrementally.
+  ///
+  /// Must only be called if `SupportsStreamingDecode()` returns `true`.
+  ///
+  /// \param element_bytes Specifies the element size as a hint to the
+  ///     compressor.  Must be `> 0`.
+  virtual std::unique_ptr<StreamDecoder> GetStreamDecoder(
+      std::size_t element_bytes) const;
+
   using ToJsonOptions = JsonSerializationOptions;
   using FromJsonOptions = JsonSerializationOptions;
 
@@ -113,6 +113,64 @@ absl::Status Decode(const absl::Cord& input, absl::Cord* output) {
   if (err != LZMA_OK) return lzma::GetInitErrorStatus(err);
   return lzma::GetDecodeErrorStatus(manager.Process());
 }
+
+struct StreamDecoder::State {
+  lzma_stream stream = LZMA_STREAM_INIT;
+  bool stream_end = false;
+};
+
+StreamDecoder::StreamDecoder() : state_(new State) {
+  ::lzma_ret err = ::lzma_stream_decoder(
+      &state_->stream, /*memlimit=*/std::numeric_limits<std::uint64_t>::max(),
+      /*flags=*/0);
+  // Terminate if allocating even the small amount of memory required fails.
+  ABSL_CHECK_EQ(err, LZMA_OK);
+}
+
+StreamDecoder::~StreamDecoder() { ::lzma_end(&state_->stream); }
+
+absl::Status StreamDecoder::Feed(const absl::Cord& input, absl::Cord* output) {
+  if (input.empty()) return absl::OkStatus();
+  return Process(input, output, /*finish=*/false);
+}
+
+absl::Status StreamDecoder::Finish(absl::Cord* output) {
+  return Process(absl::Cord(), output, /*finish=*/true);
+}
+
+absl::Status StreamDecoder::Process(const absl::Cord& input,
+                                    absl::Cord* output, bool finish) {
+  if (state_->stream_end) {
+    // Data following the end of the xz stream is invalid.
+    if (!input.empty()) return lzma::GetDecodeErrorStatus(LZMA_DATA_ERROR);
+    return absl::OkStatus();
+  }
+  internal::CordStreamManager<lzma_stream, lzma::BufferManager::kBufferSize>
+      stream_manager(state_->stream, input, output);
+  while (true) {
+    stream_manager.FeedInputAndOutputBuffers();
+    const ::lzma_ret r =
+        ::lzma_code(&state_->stream, finish ? LZMA_FINISH : LZMA_RUN);
+    stream_manager.HandleOutput();
+    if (r == LZMA_STREAM_END) {
+      if (stream_manager.has_input_remaining()) {
+        return lzma::GetDecodeErrorStatus(LZMA_DATA_ERROR);
+      }
+      state_->stream_end = true;
+      return absl::OkStatus();
+    }
+    // Truncated input results in `LZMA_BUF_ERROR` once `LZMA_FINISH` can make
+    // no further progress.
+    if (r != LZMA_OK) return lzma::GetDecodeErrorStatus(r);
+    // Return once all of `input` has been consumed and all output that can be
+    // produced from it has been appended.  Once the end of the input has been
+    // reached, continue until the end of the xz stream.
+    if (!finish && !stream_manager.has_input_remaining() &&
+        state_->stream.avail_out != 0) {
+      return absl::OkStatus();
+    }
+  }
+}
 }  // namespace xz
 
 }  // namespace lzma
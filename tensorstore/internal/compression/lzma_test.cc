@@ -133,4 +133,62 @@ TEST(XzCompressorTest, DecodeCorruptData) {
   }
 }
 
+// Tests that decoding input delivered in small pieces succeeds.
+TEST(XzCompressorTest, StreamingRoundtrip) {
+  std::string input(100000, '\0');
+  unsigned char x = 0;
+  for (auto& v : input) {
+    v = x;
+    x += 7;
+  }
+  xz::Options options{6};
+  absl::Cord encode_result;
+  TENSORSTORE_ASSERT_OK(xz::Encode(absl::Cord(input), &encode_result, options));
+  xz::StreamDecoder decoder;
+  absl::Cord decode_result("abc");
+  for (size_t i = 0; i < encode_result.size(); i += 1000) {
+    TENSORSTORE_ASSERT_OK(
+        decoder.Feed(encode_result.Subcord(i, 1000), &decode_result));
+  }
+  TENSORSTORE_ASSERT_OK(decoder.Finish(&decode_result));
+  EXPECT_EQ("abc" + input, decode_result);
+}
+
+// Tests that streaming decoding of truncated or corrupt data gives an error.
+TEST(XzCompressorTest, StreamingDecodeCorruptData) {
+  xz::Options options{6};
+  const absl::Cord input("The quick brown fox jumped over the lazy dog.");
+  absl::Cord encode_result;
+  TENSORSTORE_ASSERT_OK(xz::Encode(input, &encode_result, options));
+
+  // Truncated.
+  {
+    xz::StreamDecoder decoder;
+    absl::Cord decode_result;
+    TENSORSTORE_ASSERT_OK(decoder.Feed(
+        encode_result.Subcord(0, encode_result.size() - 1), &decode_result));
+    EXPECT_THAT(decoder.Finish(&decode_result),
+                MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+
+  // Trailing data.
+  {
+    xz::StreamDecoder decoder;
+    absl::Cord decode_result;
+    TENSORSTORE_ASSERT_OK(decoder.Feed(encode_result, &decode_result));
+    EXPECT_THAT(decoder.Feed(absl::Cord("x"), &decode_result),
+                MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+
+  // Corrupt header.
+  {
+    xz::StreamDecoder decoder;
+    absl::Cord decode_result;
+    std::string corrupted(encode_result);
+    corrupted[0] = 0;
+    EXPECT_THAT(decoder.Feed(absl::Cord(corrupted), &decode_result),
+                MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+}
+
 }  // namespace
@@ -18,6 +18,7 @@
 /// \file Define an XZ-format JsonSpecifiedCompressor.
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
 #include "absl/status/status.h"
@@ -39,6 +40,23 @@ class XzCompressor : public internal::JsonSpecifiedCompressor,
                       std::size_t element_size) const override {
     return tensorstore::lzma::xz::Decode(input, output);
   }
+  bool SupportsStreamingDecode() const override { return true; }
+  std::unique_ptr<StreamDecoder> GetStreamDecoder(
+      std::size_t element_size) const override {
+    class Decoder : public StreamDecoder {
+     public:
+      absl::Status Feed(const absl::Cord& input, absl::Cord* output) override {
+        return decoder_.Feed(input, output);
+      }
+      absl::Status Finish(absl::Cord* output) override {
+        return decoder_.Finish(output);
+      }
+
+     private:
+      tensorstore::lzma::xz::StreamDecoder decoder_;
+    };
+    return std::make_unique<Decoder>();
+  }
 };
 
 }  // namespace internal
@@ -17,7 +17,9 @@
 #include "absl/base/optimization.h"
 #include "absl/log/absl_check.h"
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include "tensorstore/internal/compression/cord_stream_manager.h"
+#include "tensorstore/util/status.h"
 
 // Include zlib header last because it defines a bunch of poorly-named macros.
 #include <zlib.h>
@@ -118,5 +120,64 @@ absl::Status Decode(const absl::Cord& input, absl::Cord* output,
   return ProcessZlib<InflateOp>(input, output, 0, use_gzip_header);
 }
 
+struct StreamDecoder::State {
+  z_stream s = {};
+  bool stream_end = false;
+};
+
+StreamDecoder::StreamDecoder(bool use_gzip_header) : state_(new State) {
+  const int header_option = use_gzip_header ? 16 /* require gzip header */
+                                            : 0;
+  if (InflateOp::Init(&state_->s, 0, header_option) != Z_OK) {
+    // Terminate if allocating even the small amount of memory required fails.
+    ABSL_CHECK(false);
+  }
+}
+
+StreamDecoder::~StreamDecoder() { InflateOp::Destroy(&state_->s); }
+
+absl::Status StreamDecoder::Feed(const absl::Cord& input, absl::Cord* output) {
+  if (input.empty()) return absl::OkStatus();
+  return Process(input, output, /*finish=*/false);
+}
+
+absl::Status StreamDecoder::Finish(absl::Cord* output) {
+  return Process(absl::Cord(), output, /*finish=*/true);
+}
+
+absl::Status StreamDecoder::Process(const absl::Cord& input,
+                                    absl::Cord* output, bool finish) {
+  const auto data_error = [] {
+    return absl::InvalidArgumentError("Error decoding zlib-compressed data");
+  };
+  if (state_->stream_end) {
+    // Data following the end of the zlib stream is invalid.
+    if (!input.empty()) return data_error();
+    return absl::OkStatus();
+  }
+  z_stream& s = state_->s;
+  internal::CordStreamManager<z_stream, /*BufferSize=*/16 * 1024>
+      stream_manager(s, input, output);
+  while (true) {
+    stream_manager.FeedInputAndOutputBuffers();
+    const int err = InflateOp::Process(&s, finish ? Z_FINISH : Z_NO_FLUSH);
+    const bool made_progress = stream_manager.HandleOutput();
+    if (err == Z_STREAM_END) {
+      if (stream_manager.has_input_remaining()) return data_error();
+      state_->stream_end = true;
+      return absl::OkStatus();
+    }
+    if (err != Z_OK && !(err == Z_BUF_ERROR && made_progress)) {
+      return data_error();
+    }
+    // Return once all of `input` has been consumed and all output that can be
+    // produced from it has been appended.  Once the end of the input has been
+    // reached, continue until the end of the zlib stream.
+    if (!finish && !stream_manager.has_input_remaining() && s.avail_out != 0) {
+      return absl::OkStatus();
+    }
+  }
+}
+
 }  // namespace zlib
 }  // namespace tensorstore
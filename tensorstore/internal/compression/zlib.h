@@ -19,6 +19,7 @@
 /// Convenience interface to the zlib library.
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
 #include "absl/status/status.h"
@@ -60,6 +61,48 @@ void Encode(const absl::Cord& input, absl::Cord* output,
 absl::Status Decode(const absl::Cord& input, absl::Cord* output,
                     bool use_gzip_header);
 
+/// Decompresses input that is delivered incrementally.
+///
+/// `Feed` is called with each successive piece of the input, followed by a
+/// single call to `Finish`.  Neither call blocks.
+class StreamDecoder {
+ public:
+  /// Constructs a decoder.
+  ///
+  /// \param use_gzip_header Specifies the header type with which the input was
+  ///     encoded.
+  explicit StreamDecoder(bool use_gzip_header);
+
+  StreamDecoder(const StreamDecoder&) = delete;
+  StreamDecoder& operator=(const StreamDecoder&) = delete;
+
+  ~StreamDecoder();
+
+  /// Decompresses the next piece of the input, and appends the result to
+  /// `*output`.
+  ///
+  /// \param input Next piece of the input.
+  /// \param output[in,out] Output cord to which decompressed data will be
+  ///     appended.
+  /// \error `absl::StatusCode::kInvalidArgument` if the input is corrupt.
+  absl::Status Feed(const absl::Cord& input, absl::Cord* output);
+
+  /// Completes decompression once all of the input has been fed.
+  ///
+  /// \param output[in,out] Output cord to which the remaining decompressed data
+  ///     will be appended.
+  /// \error `absl::StatusCode::kInvalidArgument` if the input is corrupt or
+  ///     truncated.
+  absl::Status Finish(absl::Cord* output);
+
+ private:
+  absl::Status Process(const absl::Cord& input, absl::Cord* output,
+                       bool finish);
+
+  struct State;
+  std::unique_ptr<State> state_;
+};
+
 }  // namespace zlib
 }  // namespace tensorstore
 
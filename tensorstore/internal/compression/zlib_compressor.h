@@ -18,6 +18,7 @@
 /// \file Defines a zlib JsonSpecifiedCompressor.
 
 #include <cstddef>
+#include <memory>
 #include <string>
 
 #include "absl/status/status.h"
@@ -42,6 +43,25 @@ class ZlibCompressor : public internal::JsonSpecifiedCompressor,
     // element_size is not used for zlib compression.
     return zlib::Decode(input, output, this->use_gzip_header);
   }
+  bool SupportsStreamingDecode() const override { return true; }
+  std::unique_ptr<StreamDecoder> GetStreamDecoder(
+      std::size_t element_size) const override {
+    // element_size is not used for zlib compression.
+    class Decoder : public StreamDecoder {
+     public:
+      explicit Decoder(bool use_gzip_header) : decoder_(use_gzip_header) {}
+      absl::Status Feed(const absl::Cord& input, absl::Cord* output) override {
+        return decoder_.Feed(input, output);
+      }
+      absl::Status Finish(absl::Cord* output) override {
+        return decoder_.Finish(output);
+      }
+
+     private:
+      zlib::StreamDecoder decoder_;
+    };
+    return std::make_unique<Decoder>(this->use_gzip_header);
+  }
 };
 
 }  // namespace internal
@@ -137,4 +137,62 @@ TEST_P(ZlibCompressorTest, DecodeCorruptData) {
   }
 }
 
+// Tests that decoding input delivered in small pieces succeeds.
+TEST_P(ZlibCompressorTest, StreamingRoundtrip) {
+  const bool use_gzip_header = GetParam();
+  std::string input(100000, '\0');
+  unsigned char x = 0;
+  for (auto& v : input) {
+    v = x;
+    x += 7;
+  }
+  zlib::Options options{6, use_gzip_header};
+  absl::Cord encode_result;
+  zlib::Encode(absl::Cord(input), &encode_result, options);
+  zlib::StreamDecoder decoder(options.use_gzip_header);
+  absl::Cord decode_result("abc");
+  for (size_t i = 0; i < encode_result.size(); i += 1000) {
+    TENSORSTORE_ASSERT_OK(
+        decoder.Feed(encode_result.Subcord(i, 1000), &decode_result));
+  }
+  TENSORSTORE_ASSERT_OK(decoder.Finish(&decode_result));
+  EXPECT_EQ("abc" + input, decode_result);
+}
+
+// Tests that streaming decoding of truncated or corrupt data gives an error.
+TEST_P(ZlibCompressorTest, StreamingDecodeCorruptData) {
+  const bool use_gzip_header = GetParam();
+  zlib::Options options{6, use_gzip_header};
+  const absl::Cord input("The quick brown fox jumped over the lazy dog.");
+  absl::Cord encode_result;
+  zlib::Encode(input, &encode_result, options);
+
+  // Truncated.
+  {
+    zlib::StreamDecoder decoder(options.use_gzip_header);
+    absl::Cord decode_result;
+    TENSORSTORE_ASSERT_OK(decoder.Feed(
+        encode_result.Subcord(0, encode_result.size() - 1), &decode_result));
+    EXPECT_THAT(decoder.Finish(&decode_result),
+                MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+
+  // Trailing data.
+  {
+    zlib::StreamDecoder decoder(options.use_gzip_header);
+    absl::Cord decode_result;
+    TENSORSTORE_ASSERT_OK(decoder.Feed(encode_result, &decode_result));
+    EXPECT_THAT(decoder.Feed(absl::Cord("x"), &decode_result),
+                MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+
+  // Corrupt.
+  {
+    zlib::StreamDecoder decoder(options.use_gzip_header);
+    absl::Cord decode_result;
+    EXPECT_THAT(decoder.Feed(absl::Cord("\xff\xff\xff\xff"), &decode_result),
+                MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+}
+
 }  // namespace
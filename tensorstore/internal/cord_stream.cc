@@ -0,0 +1,121 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cord_stream.h"
+
+#include <cassert>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal {
+
+CordStream::CordStream() {
+  auto pair = PromiseFuturePair<void>::Make();
+  finished_promise_ = std::move(pair.promise);
+  finished_future_ = std::move(pair.future);
+}
+
+CordStreamPtr CordStream::FromCord(absl::Cord data) {
+  auto stream = MakeIntrusivePtr<CordStream>();
+  stream->Append(std::move(data));
+  stream->Finish();
+  return stream;
+}
+
+void CordStream::Append(absl::Cord data) {
+  if (data.empty()) return;
+  Promise<void> available_promise;
+  {
+    absl::MutexLock lock(&mutex_);
+    assert(!finished_);
+    size_ += data.size();
+    pieces_.push_back(std::move(data));
+    available_promise = std::move(available_promise_);
+  }
+  if (!available_promise.null()) available_promise.SetResult(MakeResult());
+}
+
+size_t CordStream::size() {
+  absl::MutexLock lock(&mutex_);
+  return size_;
+}
+
+void CordStream::Finish(absl::Status status) {
+  Promise<void> available_promise;
+  {
+    absl::MutexLock lock(&mutex_);
+    assert(!finished_);
+    finished_ = true;
+    status_ = status;
+    available_promise = std::move(available_promise_);
+  }
+  if (!available_promise.null()) available_promise.SetResult(MakeResult());
+  finished_promise_.SetResult(MakeResult(std::move(status)));
+}
+
+Result<bool> CordStream::Next(absl::Cord& piece) {
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(
+      +[](CordStream* self) ABSL_EXCLUSIVE_LOCKS_REQUIRED(self->mutex_) {
+        return self->finished_ || !self->pieces_.empty();
+      },
+      this));
+  if (!pieces_.empty()) {
+    piece = std::move(pieces_.front());
+    pieces_.pop_front();
+    return true;
+  }
+  TENSORSTORE_RETURN_IF_ERROR(status_);
+  return false;
+}
+
+Result<absl::Cord> CordStream::ReadAll() {
+  absl::Cord data;
+  absl::Cord piece;
+  while (true) {
+    TENSORSTORE_ASSIGN_OR_RETURN(bool has_piece, Next(piece));
+    if (!has_piece) break;
+    data.Append(std::move(piece));
+  }
+  return data;
+}
+
+Result<bool> CordStream::TryReadAvailable(absl::Cord& data) {
+  absl::MutexLock lock(&mutex_);
+  for (auto& piece : pieces_) data.Append(std::move(piece));
+  pieces_.clear();
+  if (!finished_) return false;
+  TENSORSTORE_RETURN_IF_ERROR(status_);
+  return true;
+}
+
+Future<const void> CordStream::WhenAvailable() {
+  absl::MutexLock lock(&mutex_);
+  if (finished_ || !pieces_.empty()) return MakeReadyFuture();
+  assert(available_promise_.null());
+  auto pair = PromiseFuturePair<void>::Make();
+  available_promise_ = std::move(pair.promise);
+  return std::move(pair.future);
+}
+
+}  // namespace internal
+}  // namespace tensorstore
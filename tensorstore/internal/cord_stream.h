@@ -0,0 +1,118 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CORD_STREAM_H_
+#define TENSORSTORE_INTERNAL_CORD_STREAM_H_
+
+#include <stddef.h>
+
+#include <deque>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Sequence of bytes that is delivered incrementally by a producer, e.g. an
+/// HTTP transfer, and consumed incrementally by a single consumer, e.g. a
+/// decompressor.
+///
+/// The producer calls `Append` for each piece as it becomes available,
+/// followed by exactly one call to `Finish`.  The consumer calls `Next` to
+/// obtain each piece, blocking until it is available, or `ReadAll` to obtain
+/// the remainder of the stream.
+///
+/// A consumer that runs on an executor must not block, and instead calls
+/// `TryReadAvailable` to obtain the data received so far, and `WhenAvailable`
+/// to be notified when more data has been received.
+///
+/// All methods are thread safe.
+class CordStream : public AtomicReferenceCount<CordStream> {
+ public:
+  CordStream();
+
+  /// Returns a stream that has already finished with the specified `data`.
+  static IntrusivePtr<CordStream> FromCord(absl::Cord data);
+
+  /// Appends `data` to the stream.
+  ///
+  /// Must not be called after `Finish`.
+  void Append(absl::Cord data);
+
+  /// Marks the end of the stream.
+  ///
+  /// \param status If not `absl::OkStatus()`, indicates that the stream was
+  ///     truncated due to an error.  The error is returned to the consumer
+  ///     after all previously appended data has been consumed.
+  void Finish(absl::Status status = absl::OkStatus());
+
+  /// Obtains the next piece of the stream, blocking until it is available.
+  ///
+  /// \param piece[out] Set to the next piece.  Unspecified if `false` or an
+  ///     error is returned.
+  /// \returns `true` if `piece` was set, or `false` if the end of the stream
+  ///     has been reached.
+  /// \error The error passed to `Finish`.
+  Result<bool> Next(absl::Cord& piece);
+
+  /// Returns the remainder of the stream, blocking until it has finished.
+  Result<absl::Cord> ReadAll();
+
+  /// Appends all data received but not yet consumed to `data`, without
+  /// blocking.
+  ///
+  /// \returns `true` if the stream has finished, in which case no further data
+  ///     will become available.
+  /// \error The error passed to `Finish`, if the stream has finished.  `data`
+  ///     still receives the data appended before the error.
+  Result<bool> TryReadAvailable(absl::Cord& data);
+
+  /// Returns a future that becomes ready once data that has not yet been
+  /// consumed is available, or the stream has finished.
+  ///
+  /// Must not be called again until the returned future becomes ready.
+  Future<const void> WhenAvailable();
+
+  /// Returns a future that becomes ready once `Finish` has been called, with
+  /// the status passed to `Finish`.
+  ///
+  /// This may be used to wait for the complete stream without blocking.
+  Future<const void> finished() const { return finished_future_; }
+
+  /// Returns the total number of bytes appended so far.
+  size_t size();
+
+ private:
+  absl::Mutex mutex_;
+  std::deque<absl::Cord> pieces_ ABSL_GUARDED_BY(mutex_);
+  size_t size_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool finished_ ABSL_GUARDED_BY(mutex_) = false;
+  absl::Status status_ ABSL_GUARDED_BY(mutex_);
+  Promise<void> available_promise_ ABSL_GUARDED_BY(mutex_);
+  Promise<void> finished_promise_;
+  Future<const void> finished_future_;
+};
+
+using CordStreamPtr = IntrusivePtr<CordStream>;
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CORD_STREAM_H_
@@ -0,0 +1,112 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cord_stream.h"
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::CordStream;
+using ::tensorstore::internal::MakeIntrusivePtr;
+
+TEST(CordStreamTest, FromCord) {
+  auto stream = CordStream::FromCord(absl::Cord("abc"));
+  EXPECT_TRUE(stream->finished().ready());
+  absl::Cord piece;
+  EXPECT_THAT(stream->Next(piece), ::testing::Optional(true));
+  EXPECT_EQ("abc", piece);
+  EXPECT_THAT(stream->Next(piece), ::testing::Optional(false));
+  // Consumed pieces are still counted.
+  EXPECT_EQ(3, stream->size());
+}
+
+TEST(CordStreamTest, Empty) {
+  auto stream = CordStream::FromCord(absl::Cord());
+  EXPECT_THAT(stream->ReadAll(), ::testing::Optional(absl::Cord()));
+}
+
+TEST(CordStreamTest, Error) {
+  auto stream = MakeIntrusivePtr<CordStream>();
+  stream->Append(absl::Cord("abc"));
+  EXPECT_FALSE(stream->finished().ready());
+  stream->Finish(absl::UnknownError("truncated"));
+  EXPECT_THAT(stream->finished().result(),
+              MatchesStatus(absl::StatusCode::kUnknown, "truncated"));
+  absl::Cord piece;
+  EXPECT_THAT(stream->Next(piece), ::testing::Optional(true));
+  EXPECT_EQ("abc", piece);
+  EXPECT_THAT(stream->Next(piece),
+              MatchesStatus(absl::StatusCode::kUnknown, "truncated"));
+}
+
+TEST(CordStreamTest, TryReadAvailable) {
+  auto stream = MakeIntrusivePtr<CordStream>();
+  absl::Cord data;
+  EXPECT_THAT(stream->TryReadAvailable(data), ::testing::Optional(false));
+  EXPECT_EQ("", data);
+  auto available = stream->WhenAvailable();
+  EXPECT_FALSE(available.ready());
+  stream->Append(absl::Cord("abc"));
+  stream->Append(absl::Cord("def"));
+  EXPECT_TRUE(available.ready());
+  EXPECT_TRUE(stream->WhenAvailable().ready());
+  EXPECT_THAT(stream->TryReadAvailable(data), ::testing::Optional(false));
+  EXPECT_EQ("abcdef", data);
+  available = stream->WhenAvailable();
+  EXPECT_FALSE(available.ready());
+  stream->Append(absl::Cord("g"));
+  stream->Finish(absl::UnknownError("truncated"));
+  EXPECT_TRUE(available.ready());
+  EXPECT_THAT(stream->TryReadAvailable(data),
+              MatchesStatus(absl::StatusCode::kUnknown, "truncated"));
+  EXPECT_EQ("abcdefg", data);
+}
+
+TEST(CordStreamTest, WhenAvailableFinished) {
+  auto stream = MakeIntrusivePtr<CordStream>();
+  auto available = stream->WhenAvailable();
+  stream->Finish();
+  EXPECT_TRUE(available.ready());
+  absl::Cord data;
+  EXPECT_THAT(stream->TryReadAvailable(data), ::testing::Optional(true));
+  EXPECT_EQ("", data);
+}
+
+TEST(CordStreamTest, Concurrent) {
+  auto stream = MakeIntrusivePtr<CordStream>();
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    expected += std::to_string(i);
+  }
+  tensorstore::internal::Thread producer({"producer"}, [stream] {
+    for (int i = 0; i < 100; ++i) {
+      stream->Append(absl::Cord(std::to_string(i)));
+    }
+    stream->Finish();
+  });
+  EXPECT_THAT(stream->ReadAll(), ::testing::Optional(absl::Cord(expected)));
+  producer.Join();
+}
+
+}  // namespace
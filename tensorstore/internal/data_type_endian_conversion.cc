@@ -22,6 +22,7 @@
 #include "tensorstore/array.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/internal/elementwise_function.h"
+#include "tensorstore/internal/mapped_memory.h"
 #include "tensorstore/internal/unaligned_data_type_functions.h"
 #include "tensorstore/strided_layout.h"
 #include "tensorstore/util/element_pointer.h"
@@ -167,7 +168,8 @@ SharedArrayView<const void> TryViewCordAsArray(const absl::Cord& source,
     // Source string is not suitably aligned.
     return {};
   }
-  auto shared_cord = std::make_shared<absl::Cord>(source);
+  // Marks the array if `source` references mapped memory.
+  auto shared_cord = internal::MakeSharedCord(source);
   // Verify that `shared_cord` has the same flat buffer (this will only fail in
   // the unusual case that `source` was using the inline representation).
   if (auto shared_flat = shared_cord->TryFlat();
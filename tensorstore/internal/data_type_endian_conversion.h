@@ -91,7 +91,8 @@ SharedArrayView<void> CopyAndDecodeArray(ArrayView<const void> source,
 ///
 /// If `source` is already flattened, suitably aligned, and requires no
 /// conversion, then an array view that shares ownership with `source` is
-/// returned.
+/// returned.  If `source` references memory-mapped file data, the returned
+/// array is marked as described in `MakeSharedCord`.
 ///
 /// Otherwise, returns a null array.
 SharedArrayView<const void> TryViewCordAsArray(const absl::Cord& source,
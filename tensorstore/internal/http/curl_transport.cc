@@ -29,11 +29,14 @@
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include <curl/curl.h>
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/cord_util.h"
 #include "tensorstore/internal/env.h"
 #include "tensorstore/internal/http/curl_handle.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/gauge.h"
 #include "tensorstore/internal/metrics/histogram.h"
@@ -89,6 +92,12 @@ struct CurlRequestState {
   size_t payload_remaining_;
   HttpResponse response_;
   Promise<HttpResponse> promise_;
+  // Set only for requests issued by `IssueStreamingRequest`, in which case the
+  // body is appended to `body_` rather than to `response_.payload`, and
+  // `streaming_promise_` is used instead of `promise_`.
+  internal::CordStreamPtr body_;
+  Promise<HttpStreamingResponse> streaming_promise_;
+  bool streaming_started_ = false;
   char error_buffer_[CURL_ERROR_SIZE] = {0};
   absl::Time start_time_;
 
@@ -258,6 +267,15 @@ struct CurlRequestState {
         CurlEasySetopt(handle_.get(), CURLOPT_FORBID_REUSE, 1));
   }
 
+  // Resolves `streaming_promise_` once the response status and headers are
+  // known.
+  void StartStreamingResponse() {
+    streaming_started_ = true;
+    response_.status_code = CurlGetResponseCode(handle_.get());
+    streaming_promise_.SetResult(
+        HttpStreamingResponse{std::move(response_), body_});
+  }
+
   absl::Status CurlCodeToStatus(CURLcode code) {
     if (code == CURLE_OK) {
       return absl::OkStatus();
@@ -274,6 +292,11 @@ struct CurlRequestState {
     http_response_bytes.IncrementBy(size);
     auto data =
         std::string_view(static_cast<char const*>(contents), size * nmemb);
+    if (self->body_) {
+      if (!self->streaming_started_) self->StartStreamingResponse();
+      self->body_->Append(absl::Cord(data));
+      return data.size();
+    }
     self->response_.payload.Append(data);
     return data.size();
   }
@@ -337,6 +360,16 @@ class MultiTransportImpl {
                                     absl::Duration request_timeout,
                                     absl::Duration connect_timeout);
 
+  Future<HttpStreamingResponse> StartStreamingRequest(
+      const HttpRequest& request, absl::Cord payload,
+      absl::Duration request_timeout, absl::Duration connect_timeout);
+
+  std::unique_ptr<CurlRequestState> CreateRequestState(
+      const HttpRequest& request, absl::Cord payload,
+      absl::Duration request_timeout, absl::Duration connect_timeout);
+
+  void EnqueueRequest(std::unique_ptr<CurlRequestState> state);
+
   void FinishRequest(CURL* e, CURLcode code);
 
   void Run();
@@ -359,17 +392,41 @@ class MultiTransportImpl {
   internal::Thread thread_;
 };
 
-Future<HttpResponse> MultiTransportImpl::StartRequest(
+std::unique_ptr<CurlRequestState> MultiTransportImpl::CreateRequestState(
     const HttpRequest& request, absl::Cord payload,
     absl::Duration request_timeout, absl::Duration connect_timeout) {
   auto state = std::make_unique<CurlRequestState>(factory_.get());
   http_request_started.Increment();
   state->Setup(request, std::move(payload), request_timeout, connect_timeout);
   state->SetHTTP2();
+  return state;
+}
 
+Future<HttpResponse> MultiTransportImpl::StartRequest(
+    const HttpRequest& request, absl::Cord payload,
+    absl::Duration request_timeout, absl::Duration connect_timeout) {
+  auto state = CreateRequestState(request, std::move(payload), request_timeout,
+                                  connect_timeout);
   auto pair = PromiseFuturePair<HttpResponse>::Make();
   state->promise_ = std::move(pair.promise);
+  EnqueueRequest(std::move(state));
+  return std::move(pair.future);
+}
 
+Future<HttpStreamingResponse> MultiTransportImpl::StartStreamingRequest(
+    const HttpRequest& request, absl::Cord payload,
+    absl::Duration request_timeout, absl::Duration connect_timeout) {
+  auto state = CreateRequestState(request, std::move(payload), request_timeout,
+                                  connect_timeout);
+  auto pair = PromiseFuturePair<HttpStreamingResponse>::Make();
+  state->streaming_promise_ = std::move(pair.promise);
+  state->body_ = internal::MakeIntrusivePtr<internal::CordStream>();
+  EnqueueRequest(std::move(state));
+  return std::move(pair.future);
+}
+
+void MultiTransportImpl::EnqueueRequest(
+    std::unique_ptr<CurlRequestState> state) {
   // Transfer ownership into the curl handle.
   CURL* e = state->handle_.get();
   assert(state.get() == GetStatePointer(e));
@@ -383,8 +440,6 @@ Future<HttpResponse> MultiTransportImpl::StartRequest(
     pending_requests_.emplace_back(e);
   }
   curl_multi_wakeup(multi_.get());
-
-  return std::move(pair.future);
 }
 
 void MultiTransportImpl::FinishRequest(CURL* e, CURLcode code) {
@@ -403,6 +458,23 @@ void MultiTransportImpl::FinishRequest(CURL* e, CURLcode code) {
   http_request_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
   http_request_completed.Increment();
 
+  if (state->body_) {
+    absl::Status status = state->CurlCodeToStatus(code);
+    if (status.ok()) {
+      http_request_errors.Increment(CurlGetResponseCode(e));
+    }
+    if (!state->streaming_started_) {
+      if (status.ok()) {
+        // The response has an empty body.
+        state->StartStreamingResponse();
+      } else {
+        state->streaming_promise_.SetResult(status);
+      }
+    }
+    state->body_->Finish(std::move(status));
+    return;
+  }
+
   if (code != CURLE_OK) {
     state->promise_.SetResult(state->CurlCodeToStatus(code));
   } else {
@@ -508,6 +580,13 @@ Future<HttpResponse> CurlTransport::IssueRequest(
                              connect_timeout);
 }
 
+Future<HttpStreamingResponse> CurlTransport::IssueStreamingRequest(
+    const HttpRequest& request, absl::Cord payload,
+    absl::Duration request_timeout, absl::Duration connect_timeout) {
+  return impl_->StartStreamingRequest(request, std::move(payload),
+                                      request_timeout, connect_timeout);
+}
+
 namespace {
 struct GlobalTransport {
   GlobalTransport()
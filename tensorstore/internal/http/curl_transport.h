@@ -47,6 +47,13 @@ class CurlTransport : public HttpTransport {
                                     absl::Duration request_timeout,
                                     absl::Duration connect_timeout) override;
 
+  /// Issues the request, resolving the returned future as soon as the first
+  /// bytes of the response body are received.
+  Future<HttpStreamingResponse> IssueStreamingRequest(
+      const HttpRequest& request, absl::Cord payload,
+      absl::Duration request_timeout,
+      absl::Duration connect_timeout) override;
+
  private:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -33,7 +33,9 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
+#include "absl/strings/cord.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/notification.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/transport_test_utils.h"
 #include "tensorstore/internal/thread.h"
@@ -230,4 +232,53 @@ TEST_F(CurlTransportTest, Http1Resend) {
   }
 }
 
+// Tests that a streaming request resolves before the body has been received.
+TEST_F(CurlTransportTest, Http1Streaming) {
+  auto transport = ::tensorstore::internal_http::GetDefaultHttpTransport();
+
+  auto socket = CreateBoundSocket();
+  ABSL_CHECK(socket.has_value());
+
+  auto hostport = FormatSocketAddress(*socket);
+  ABSL_CHECK(!hostport.empty());
+
+  static constexpr char kResponseStart[] =  //
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: text/plain\r\n"
+      "Content-Length: 10\r\n"
+      "\r\n"
+      "01234";
+  static constexpr char kResponseEnd[] = "56789";
+
+  absl::Notification response_received;
+  tensorstore::internal::Thread serve_thread({"serve_thread"}, [&] {
+    auto client_fd = AcceptNonBlocking(*socket);
+    ABSL_CHECK(client_fd.has_value());
+    ReceiveAvailable(*client_fd);
+    AssertSend(*client_fd, kResponseStart);
+    response_received.WaitForNotification();
+    AssertSend(*client_fd, kResponseEnd);
+    CloseSocket(*client_fd);
+  });
+
+  auto response = transport
+                      ->IssueStreamingRequest(
+                          HttpRequestBuilder(
+                              "GET", absl::StrCat("http://", hostport, "/"))
+                              .BuildRequest(),
+                          absl::Cord())
+                      .result();
+  response_received.Notify();
+  ASSERT_TRUE(response.ok()) << response.status();
+  EXPECT_EQ(200, response->response.status_code);
+  EXPECT_TRUE(response->response.payload.empty());
+  auto body = response->body->ReadAll();
+
+  serve_thread.Join();
+  CloseSocket(*socket);
+
+  ASSERT_TRUE(body.ok()) << body.status();
+  EXPECT_EQ("0123456789", *body);
+}
+
 }  // namespace
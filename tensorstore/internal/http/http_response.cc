@@ -18,13 +18,17 @@
 
 #include <algorithm>
 #include <iterator>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 
 #include "absl/status/status.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/strip.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/str_cat.h"
 
@@ -219,11 +223,73 @@ Result<ByteRange> GetHttpResponseByteRange(
         tensorstore::StrCat("bytes ", byte_range_request.inclusive_min, "-");
   }
   if (!absl::StartsWith(it->second, prefix)) {
+    // The server returns a truncated range if the requested range extends
+    // past the end of the value.
+    if (auto content_range = TryParseContentRangeHeader(response)) {
+      TENSORSTORE_RETURN_IF_ERROR(
+          byte_range_request.Validate(std::get<2>(*content_range)));
+    }
     return absl::UnknownError(tensorstore::StrCat(
         "Unexpected Content-Range header received: ", QuoteString(it->second)));
   }
   return ByteRange{0, response.payload.size()};
 }
 
+Result<ByteRange> GetHttpResponsePartialByteRange(
+    const HttpResponse& response, OptionalByteRangeRequest byte_range_request,
+    uint64_t& value_size) {
+  assert(byte_range_request.SatisfiesInvariants());
+  if (response.status_code != 206) {
+    // Server ignored the range request.
+    value_size = response.payload.size();
+    if (byte_range_request.exclusive_max &&
+        *byte_range_request.exclusive_max > value_size) {
+      byte_range_request.exclusive_max =
+          std::max(value_size, byte_range_request.inclusive_min);
+    }
+    return byte_range_request.Validate(value_size);
+  }
+  auto content_range = TryParseContentRangeHeader(response);
+  if (!content_range) {
+    return absl::UnknownError(
+        "Expected Content-Range header with total size with HTTP 206 "
+        "response");
+  }
+  auto [inclusive_min, exclusive_max, total_size] = *content_range;
+  if (inclusive_min != byte_range_request.inclusive_min ||
+      exclusive_max - inclusive_min != response.payload.size() ||
+      (byte_range_request.exclusive_max &&
+       exclusive_max > *byte_range_request.exclusive_max)) {
+    return absl::UnknownError(tensorstore::StrCat(
+        "Unexpected Content-Range header received: ",
+        QuoteString(response.headers.find("content-range")->second)));
+  }
+  value_size = total_size;
+  return ByteRange{0, response.payload.size()};
+}
+
+std::optional<std::tuple<uint64_t, uint64_t, uint64_t>>
+TryParseContentRangeHeader(const HttpResponse& response) {
+  auto it = response.headers.find("content-range");
+  if (it == response.headers.end()) return std::nullopt;
+  std::string_view value = it->second;
+  if (!absl::ConsumePrefix(&value, "bytes ")) return std::nullopt;
+  const size_t dash = value.find('-');
+  const size_t slash = value.find('/');
+  if (dash == std::string_view::npos || slash == std::string_view::npos ||
+      slash < dash) {
+    return std::nullopt;
+  }
+  uint64_t inclusive_min, inclusive_max, total_size;
+  if (!absl::SimpleAtoi(value.substr(0, dash), &inclusive_min) ||
+      !absl::SimpleAtoi(value.substr(dash + 1, slash - dash - 1),
+                        &inclusive_max) ||
+      !absl::SimpleAtoi(value.substr(slash + 1), &total_size) ||
+      inclusive_max < inclusive_min || inclusive_max >= total_size) {
+    return std::nullopt;
+  }
+  return std::make_tuple(inclusive_min, inclusive_max + 1, total_size);
+}
+
 }  // namespace internal_http
 }  // namespace tensorstore
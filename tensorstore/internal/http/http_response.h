@@ -16,9 +16,12 @@
 #define TENSORSTORE_INTERNAL_HTTP_HTTP_RESPONSE_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
@@ -50,6 +53,25 @@ absl::Status HttpResponseCodeToStatus(const HttpResponse& response);
 Result<ByteRange> GetHttpResponseByteRange(
     const HttpResponse& response, OptionalByteRangeRequest byte_range_request);
 
+/// Like `GetHttpResponseByteRange`, but `byte_range_request` may extend past
+/// the end of the value, in which case only the bytes that exist are
+/// returned, as for an HTTP range request.
+///
+/// \param value_size[out] Set to the total size of the value.
+/// \error `absl::StatusCode::kOutOfRange` if
+///     `byte_range_request.inclusive_min` exceeds the size of the value.
+Result<ByteRange> GetHttpResponsePartialByteRange(
+    const HttpResponse& response, OptionalByteRangeRequest byte_range_request,
+    uint64_t& value_size);
+
+/// Parses the `Content-Range` header of `response`, of the form
+/// `bytes <inclusive_min>-<inclusive_max>/<total_size>`.
+///
+/// \returns `{inclusive_min, exclusive_max, total_size}`, or `std::nullopt` if
+///     the header is missing or invalid, or does not specify the total size.
+std::optional<std::tuple<uint64_t, uint64_t, uint64_t>>
+TryParseContentRangeHeader(const HttpResponse& response);
+
 }  // namespace internal_http
 }  // namespace tensorstore
 
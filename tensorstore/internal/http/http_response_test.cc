@@ -14,16 +14,31 @@
 
 #include "tensorstore/internal/http/http_response.h"
 
+#include <stdint.h>
+
 #include <set>
+#include <tuple>
 #include <utility>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/container/flat_hash_set.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/util/status.h"
+#include "tensorstore/util/status_testutil.h"
 
 namespace {
 
+using ::tensorstore::ByteRange;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::OptionalByteRangeRequest;
 using ::tensorstore::internal_http::AppendHeaderData;
+using ::tensorstore::internal_http::GetHttpResponseByteRange;
+using ::tensorstore::internal_http::GetHttpResponsePartialByteRange;
+using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::TryParseContentRangeHeader;
+using ::testing::Optional;
 
 TEST(AppendHeaderData, BadHeaders) {
   std::multimap<std::string, std::string> headers;
@@ -133,4 +148,66 @@ TEST(HttpResponseCodeToStatusTest, AllCodes) {
   }
 }
 
+HttpResponse MakePartialResponse(std::string_view payload,
+                                 std::string content_range) {
+  HttpResponse response{206, absl::Cord(payload)};
+  response.headers.emplace("content-range", std::move(content_range));
+  return response;
+}
+
+TEST(TryParseContentRangeHeader, Basic) {
+  EXPECT_THAT(
+      TryParseContentRangeHeader(MakePartialResponse("", "bytes 1-2/5")),
+      Optional(std::make_tuple(1, 3, 5)));
+  EXPECT_EQ(std::nullopt,
+            TryParseContentRangeHeader(HttpResponse{206, absl::Cord()}));
+  for (auto header : {"bytes 1-2/*", "bytes */5", "bytes 2-1/5",
+                      "bytes 1-5/5", "items 1-2/5", "bytes 1-x/5"}) {
+    EXPECT_EQ(std::nullopt,
+              TryParseContentRangeHeader(MakePartialResponse("", header)))
+        << header;
+  }
+}
+
+TEST(GetHttpResponseByteRange, Basic) {
+  EXPECT_THAT(GetHttpResponseByteRange(HttpResponse{200, absl::Cord("abcde")},
+                                       OptionalByteRangeRequest(1, 3)),
+              ::testing::Eq(ByteRange{1, 3}));
+  EXPECT_THAT(GetHttpResponseByteRange(MakePartialResponse("bc", "bytes 1-2/5"),
+                                       OptionalByteRangeRequest(1, 3)),
+              ::testing::Eq(ByteRange{0, 2}));
+  // Truncated by the server.
+  EXPECT_THAT(GetHttpResponseByteRange(MakePartialResponse("bc", "bytes 1-2/3"),
+                                       OptionalByteRangeRequest(1, 10)),
+              MatchesStatus(absl::StatusCode::kOutOfRange));
+}
+
+TEST(GetHttpResponsePartialByteRange, Basic) {
+  uint64_t value_size = 0;
+  // Server ignored the range request.
+  EXPECT_THAT(GetHttpResponsePartialByteRange(
+                  HttpResponse{200, absl::Cord("abcde")},
+                  OptionalByteRangeRequest(1, 10), value_size),
+              ::testing::Eq(ByteRange{1, 5}));
+  EXPECT_EQ(5, value_size);
+  EXPECT_THAT(GetHttpResponsePartialByteRange(
+                  HttpResponse{200, absl::Cord("abcde")},
+                  OptionalByteRangeRequest(6, 10), value_size),
+              MatchesStatus(absl::StatusCode::kOutOfRange));
+  // Truncated by the server.
+  EXPECT_THAT(GetHttpResponsePartialByteRange(
+                  MakePartialResponse("bc", "bytes 1-2/3"),
+                  OptionalByteRangeRequest(1, 10), value_size),
+              ::testing::Eq(ByteRange{0, 2}));
+  EXPECT_EQ(3, value_size);
+  EXPECT_THAT(GetHttpResponsePartialByteRange(
+                  MakePartialResponse("bc", "bytes 2-3/5"),
+                  OptionalByteRangeRequest(1, 10), value_size),
+              MatchesStatus(absl::StatusCode::kUnknown));
+  EXPECT_THAT(GetHttpResponsePartialByteRange(
+                  MakePartialResponse("bc", "bytes 1-2/*"),
+                  OptionalByteRangeRequest(1, 10), value_size),
+              MatchesStatus(absl::StatusCode::kUnknown));
+}
+
 }  // namespace
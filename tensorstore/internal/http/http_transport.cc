@@ -0,0 +1,48 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/http/http_transport.h"
+
+#include <utility>
+
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/cord_stream.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_http {
+
+Future<HttpStreamingResponse> HttpTransport::IssueStreamingRequest(
+    const HttpRequest& request, absl::Cord payload,
+    absl::Duration request_timeout, absl::Duration connect_timeout) {
+  return MapFutureValue(
+      InlineExecutor{},
+      [](HttpResponse& response) {
+        HttpStreamingResponse result;
+        result.body =
+            internal::CordStream::FromCord(std::move(response.payload));
+        response.payload.Clear();
+        result.response = std::move(response);
+        return result;
+      },
+      IssueRequest(request, std::move(payload), request_timeout,
+                   connect_timeout));
+}
+
+}  // namespace internal_http
+}  // namespace tensorstore
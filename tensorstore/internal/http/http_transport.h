@@ -15,7 +15,9 @@
 #ifndef TENSORSTORE_INTERNAL_HTTP_HTTP_TRANSPORT_H_
 #define TENSORSTORE_INTERNAL_HTTP_HTTP_TRANSPORT_H_
 
+#include "absl/strings/cord.h"
 #include "absl/time/time.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/util/future.h"
@@ -23,6 +25,15 @@
 namespace tensorstore {
 namespace internal_http {
 
+/// Response returned by `HttpTransport::IssueStreamingRequest`.
+struct HttpStreamingResponse {
+  /// Status code and headers of the response.  The `payload` is always empty.
+  HttpResponse response;
+
+  /// Receives the response body as it is transferred.
+  internal::CordStreamPtr body;
+};
+
 /// HttpTransport is an interface class for making http requests.
 class HttpTransport {
  public:
@@ -34,6 +45,21 @@ class HttpTransport {
       const HttpRequest& request, absl::Cord payload,
       absl::Duration request_timeout = absl::ZeroDuration(),
       absl::Duration connect_timeout = absl::ZeroDuration()) = 0;
+
+  /// IssueStreamingRequest issues the request with the provided body
+  /// `payload`, delivering the response body incrementally.
+  ///
+  /// The returned future may become ready as soon as the response status and
+  /// headers have been received, while the body is still being transferred.
+  /// Errors that occur while transferring the body are reported by
+  /// `HttpStreamingResponse::body`.
+  ///
+  /// The default implementation calls `IssueRequest` and delivers the complete
+  /// body at once.
+  virtual Future<HttpStreamingResponse> IssueStreamingRequest(
+      const HttpRequest& request, absl::Cord payload,
+      absl::Duration request_timeout = absl::ZeroDuration(),
+      absl::Duration connect_timeout = absl::ZeroDuration());
 };
 
 }  // namespace internal_http
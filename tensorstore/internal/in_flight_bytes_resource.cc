@@ -0,0 +1,164 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/in_flight_bytes_resource.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/histogram.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+auto& in_flight_bytes_queued = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/in_flight_bytes/queued",
+    "Number of operations that waited for in-flight byte budget.");
+
+auto& in_flight_bytes_wait_latency_ms =
+    internal_metrics::Histogram<internal_metrics::DefaultBucketer>::New(
+        "/tensorstore/in_flight_bytes/wait_latency_ms",
+        "Time queued operations waited for in-flight byte budget (ms)");
+
+auto& in_flight_bytes_admitted = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/in_flight_bytes/admitted_bytes",
+    "Bytes admitted by all in-flight byte budgets and not yet released.");
+
+struct InFlightBytesResourceTraits
+    : public ContextResourceTraits<InFlightBytesResource> {
+  using Spec = InFlightBytesResource::Spec;
+  using Resource = InFlightBytesResource::Resource;
+  static constexpr Spec Default() { return {}; }
+  static constexpr auto JsonBinder() {
+    namespace jb = tensorstore::internal_json_binding;
+    return jb::Object(jb::Member(
+        "limit", jb::Projection(&Spec::limit,
+                                jb::DefaultValue([](auto* v) { *v = 0; }))));
+  }
+  static Result<Resource> Create(const Spec& spec,
+                                 ContextResourceCreationContext context) {
+    return MakeIntrusivePtr<InFlightBytesBudget>(spec.limit);
+  }
+  static Spec GetSpec(const Resource& budget,
+                      const ContextSpecBuilder& builder) {
+    return Spec{budget->limit()};
+  }
+};
+
+const ContextResourceRegistration<InFlightBytesResourceTraits> registration;
+
+struct AdmittedOperation {
+  IntrusivePtr<InFlightBytesBudget> budget;
+  size_t bytes;
+  InFlightBytesBudget::StartFn fn;
+};
+
+// Queue of admitted operations to be started by the outermost `StartAdmitted`
+// call on the current thread, or `nullptr` if no start function is running.
+ABSL_CONST_INIT thread_local std::deque<AdmittedOperation>* admitted_queue =
+    nullptr;
+
+// Invokes the start function of `op`.
+//
+// A start function commonly releases its reservation, or one it has obtained
+// previously, before returning, which admits further operations.  To avoid
+// unbounded recursion, operations admitted while a start function is running
+// on the current thread are queued and started in turn by the outermost call.
+void StartAdmitted(AdmittedOperation op) {
+  if (admitted_queue) {
+    admitted_queue->push_back(std::move(op));
+    return;
+  }
+  std::deque<AdmittedOperation> queue;
+  queue.push_back(std::move(op));
+  admitted_queue = &queue;
+  while (!queue.empty()) {
+    auto next = std::move(queue.front());
+    queue.pop_front();
+    std::move(next.fn)(
+        InFlightBytesReservation(std::move(next.budget), next.bytes));
+  }
+  admitted_queue = nullptr;
+}
+
+}  // namespace
+
+void InFlightBytesReservation::Release() {
+  if (!budget_) return;
+  std::exchange(budget_, {})->Release(std::exchange(bytes_, 0));
+}
+
+void InFlightBytesBudget::Admit(size_t bytes, StartFn fn) {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!pending_.empty() ||
+        (in_flight_ != 0 && limit_ != 0 && in_flight_ + bytes > limit_)) {
+      in_flight_bytes_queued.Increment();
+      pending_.push_back(PendingOperation{bytes, absl::Now(), std::move(fn)});
+      return;
+    }
+    in_flight_ += bytes;
+  }
+  in_flight_bytes_admitted.IncrementBy(bytes);
+  StartAdmitted(AdmittedOperation{IntrusivePtr<InFlightBytesBudget>(this),
+                                  bytes, std::move(fn)});
+}
+
+void InFlightBytesBudget::Release(size_t bytes) {
+  absl::InlinedVector<PendingOperation, 4> admitted;
+  {
+    absl::MutexLock lock(&mutex_);
+    in_flight_ -= bytes;
+    while (!pending_.empty()) {
+      auto& op = pending_.front();
+      if (in_flight_ != 0 && limit_ != 0 && in_flight_ + op.bytes > limit_) {
+        break;
+      }
+      in_flight_ += op.bytes;
+      admitted.push_back(std::move(op));
+      pending_.pop_front();
+    }
+  }
+  in_flight_bytes_admitted.DecrementBy(bytes);
+  // Start functions are invoked after releasing the lock, since they may
+  // themselves call `Admit`.
+  const absl::Time now = absl::Now();
+  for (auto& op : admitted) {
+    in_flight_bytes_admitted.IncrementBy(op.bytes);
+    in_flight_bytes_wait_latency_ms.Observe(
+        absl::ToInt64Milliseconds(now - op.enqueue_time));
+    StartAdmitted(AdmittedOperation{IntrusivePtr<InFlightBytesBudget>(this),
+                                    op.bytes, std::move(op.fn)});
+  }
+}
+
+}  // namespace internal
+}  // namespace tensorstore
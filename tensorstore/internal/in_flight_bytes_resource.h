@@ -0,0 +1,131 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_IN_FLIGHT_BYTES_RESOURCE_H_
+#define TENSORSTORE_INTERNAL_IN_FLIGHT_BYTES_RESOURCE_H_
+
+#include <stddef.h>
+
+#include <deque>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+
+namespace tensorstore {
+namespace internal {
+
+class InFlightBytesBudget;
+
+/// Move-only handle to a number of bytes admitted by an `InFlightBytesBudget`.
+///
+/// The bytes are returned to the budget by `Release` or upon destruction.
+class InFlightBytesReservation {
+ public:
+  InFlightBytesReservation() = default;
+  InFlightBytesReservation(IntrusivePtr<InFlightBytesBudget> budget,
+                           size_t bytes)
+      : budget_(std::move(budget)), bytes_(bytes) {}
+  InFlightBytesReservation(InFlightBytesReservation&& other)
+      : budget_(std::move(other.budget_)),
+        bytes_(std::exchange(other.bytes_, 0)) {}
+  InFlightBytesReservation& operator=(InFlightBytesReservation&& other) {
+    Release();
+    budget_ = std::move(other.budget_);
+    bytes_ = std::exchange(other.bytes_, 0);
+    return *this;
+  }
+  ~InFlightBytesReservation() { Release(); }
+
+  /// Number of bytes reserved.
+  size_t bytes() const { return bytes_; }
+
+  /// Returns the bytes to the budget, possibly admitting queued operations on
+  /// the current thread.
+  void Release();
+
+ private:
+  IntrusivePtr<InFlightBytesBudget> budget_;
+  size_t bytes_ = 0;
+};
+
+/// Limits the total number of bytes of in-flight operations, such as chunk
+/// reads and writeback, across all caches that share it.
+///
+/// Operations are admitted in the order in which `Admit` was called.  When the
+/// budget is exhausted, later operations are queued until earlier operations
+/// release their bytes.  An operation larger than the entire limit is admitted
+/// once no other operation is in flight.
+class InFlightBytesBudget
+    : public AtomicReferenceCount<InFlightBytesBudget> {
+ public:
+  using StartFn = absl::AnyInvocable<void(InFlightBytesReservation) &&>;
+
+  /// Constructs a budget with the specified `limit`.  A limit of `0` means
+  /// unlimited.
+  explicit InFlightBytesBudget(size_t limit) : limit_(limit) {}
+
+  size_t limit() const { return limit_; }
+
+  size_t in_flight() const {
+    absl::MutexLock lock(&mutex_);
+    return in_flight_;
+  }
+
+  /// Admits an operation of `bytes` bytes.
+  ///
+  /// The start function `fn` is invoked with the reservation once the
+  /// operation is admitted, either immediately on the calling thread or later
+  /// on the thread that releases sufficient bytes.  `fn` must not block.
+  ///
+  /// If the operation is admitted while another start function is running on
+  /// the calling thread, `fn` is invoked after that start function returns,
+  /// rather than recursively.
+  void Admit(size_t bytes, StartFn fn);
+
+ private:
+  friend class InFlightBytesReservation;
+
+  void Release(size_t bytes);
+
+  struct PendingOperation {
+    size_t bytes;
+    absl::Time enqueue_time;
+    StartFn fn;
+  };
+
+  const size_t limit_;
+  mutable absl::Mutex mutex_;
+  size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::deque<PendingOperation> pending_ ABSL_GUARDED_BY(mutex_);
+};
+
+/// Context resource that limits the number of bytes of in-flight chunk
+/// operations.
+struct InFlightBytesResource {
+  static constexpr char id[] = "in_flight_bytes";
+  struct Spec {
+    /// Maximum number of in-flight bytes, or `0` for unlimited.
+    size_t limit = 0;
+  };
+  using Resource = IntrusivePtr<InFlightBytesBudget>;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_IN_FLIGHT_BYTES_RESOURCE_H_
@@ -0,0 +1,141 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/in_flight_bytes_resource.h"
+
+#include <stddef.h>
+
+#include <optional>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::internal::InFlightBytesBudget;
+using ::tensorstore::internal::InFlightBytesReservation;
+using ::tensorstore::internal::InFlightBytesResource;
+using ::tensorstore::internal::MakeIntrusivePtr;
+
+TEST(InFlightBytesResourceTest, Default) {
+  auto resource_spec = Context::Resource<InFlightBytesResource>::DefaultSpec();
+  auto budget = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(0u, (*budget)->limit());
+}
+
+TEST(InFlightBytesResourceTest, Limit) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<InFlightBytesResource>::FromJson({{"limit", 100}}));
+  auto budget = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(100u, (*budget)->limit());
+}
+
+TEST(InFlightBytesBudgetTest, AdmitsInOrder) {
+  auto budget = MakeIntrusivePtr<InFlightBytesBudget>(100);
+  std::vector<int> started;
+  std::vector<InFlightBytesReservation> reservations;
+  reservations.reserve(3);
+  auto admit = [&](int id, size_t bytes) {
+    budget->Admit(bytes, [&, id](InFlightBytesReservation reservation) {
+      started.push_back(id);
+      reservations.push_back(std::move(reservation));
+    });
+  };
+  admit(0, 60);
+  admit(1, 60);
+  // Fits within the limit but must wait behind operation 1.
+  admit(2, 10);
+  EXPECT_THAT(started, ::testing::ElementsAre(0));
+  EXPECT_EQ(60u, budget->in_flight());
+
+  reservations[0].Release();
+  EXPECT_THAT(started, ::testing::ElementsAre(0, 1, 2));
+  EXPECT_EQ(70u, budget->in_flight());
+
+  reservations.clear();
+  EXPECT_EQ(0u, budget->in_flight());
+}
+
+TEST(InFlightBytesBudgetTest, OversizeAdmittedWhenIdle) {
+  auto budget = MakeIntrusivePtr<InFlightBytesBudget>(100);
+  std::optional<InFlightBytesReservation> small, large;
+  budget->Admit(10, [&](InFlightBytesReservation reservation) {
+    small = std::move(reservation);
+  });
+  budget->Admit(1000, [&](InFlightBytesReservation reservation) {
+    large = std::move(reservation);
+  });
+  EXPECT_TRUE(small);
+  EXPECT_FALSE(large);
+  small.reset();
+  ASSERT_TRUE(large);
+  EXPECT_EQ(1000u, large->bytes());
+  EXPECT_EQ(1000u, budget->in_flight());
+}
+
+TEST(InFlightBytesBudgetTest, ReleaseDoesNotRecurse) {
+  // Each start function releases its reservation immediately, which admits
+  // the next operation.  This must not recurse once per queued operation.
+  constexpr int kNumOperations = 1000000;
+  auto budget = MakeIntrusivePtr<InFlightBytesBudget>(1);
+  std::optional<InFlightBytesReservation> first;
+  budget->Admit(1, [&](InFlightBytesReservation reservation) {
+    first = std::move(reservation);
+  });
+  int started = 0;
+  for (int i = 0; i < kNumOperations; ++i) {
+    budget->Admit(1, [&](InFlightBytesReservation reservation) { ++started; });
+  }
+  EXPECT_EQ(0, started);
+  first.reset();
+  EXPECT_EQ(kNumOperations, started);
+  EXPECT_EQ(0u, budget->in_flight());
+}
+
+TEST(InFlightBytesBudgetTest, AdmitWithinStartFunction) {
+  auto budget = MakeIntrusivePtr<InFlightBytesBudget>(100);
+  std::vector<int> events;
+  std::optional<InFlightBytesReservation> inner;
+  budget->Admit(10, [&](InFlightBytesReservation reservation) {
+    budget->Admit(10, [&](InFlightBytesReservation reservation) {
+      events.push_back(1);
+      inner = std::move(reservation);
+    });
+    // Started after the current start function returns.
+    events.push_back(0);
+  });
+  EXPECT_THAT(events, ::testing::ElementsAre(0, 1));
+  EXPECT_EQ(10u, budget->in_flight());
+}
+
+TEST(InFlightBytesBudgetTest, Unlimited) {
+  auto budget = MakeIntrusivePtr<InFlightBytesBudget>(0);
+  std::vector<InFlightBytesReservation> reservations;
+  for (int i = 0; i < 10; ++i) {
+    budget->Admit(1000, [&](InFlightBytesReservation reservation) {
+      reservations.push_back(std::move(reservation));
+    });
+  }
+  EXPECT_EQ(10u, reservations.size());
+  EXPECT_EQ(10000u, budget->in_flight());
+}
+
+}  // namespace
@@ -0,0 +1,110 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/mapped_memory.h"
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/no_destructor.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+/// Set of referenced mapped regions, keyed by start address.
+class MappedRegionRegistry {
+ public:
+  void Add(std::string_view data) {
+    absl::MutexLock lock(&mutex_);
+    regions_.emplace(data.data(), data.data() + data.size());
+    num_regions_.fetch_add(1, std::memory_order_release);
+  }
+
+  void Remove(std::string_view data) {
+    absl::MutexLock lock(&mutex_);
+    regions_.erase(data.data());
+    num_regions_.fetch_sub(1, std::memory_order_release);
+  }
+
+  bool Contains(const void* ptr) {
+    if (num_regions_.load(std::memory_order_acquire) == 0) return false;
+    const char* p = static_cast<const char*>(ptr);
+    absl::ReaderMutexLock lock(&mutex_);
+    auto it = regions_.upper_bound(p);
+    if (it == regions_.begin()) return false;
+    --it;
+    return p < it->second;
+  }
+
+ private:
+  std::atomic<size_t> num_regions_{0};
+  absl::Mutex mutex_;
+  absl::btree_map<const char*, const char*> regions_ ABSL_GUARDED_BY(mutex_);
+};
+
+MappedRegionRegistry& GetMappedRegionRegistry() {
+  static internal::NoDestructor<MappedRegionRegistry> registry;
+  return *registry;
+}
+
+/// Deleter used by `MakeSharedCord` to mark cords that reference mapped
+/// memory.
+struct MappedCordDeleter {
+  void operator()(const absl::Cord* cord) const { delete cord; }
+};
+
+}  // namespace
+
+absl::Cord MakeCordFromMappedMemory(std::string_view data,
+                                    absl::AnyInvocable<void() &&> unmap) {
+  if (data.empty()) {
+    std::move(unmap)();
+    return absl::Cord();
+  }
+  GetMappedRegionRegistry().Add(data);
+  return absl::MakeCordFromExternal(
+      data, [unmap = std::move(unmap)](std::string_view data) mutable {
+        GetMappedRegionRegistry().Remove(data);
+        std::move(unmap)();
+      });
+}
+
+bool IsMappedMemory(const void* ptr) {
+  return GetMappedRegionRegistry().Contains(ptr);
+}
+
+std::shared_ptr<const absl::Cord> MakeSharedCord(absl::Cord cord) {
+  if (auto flat = cord.TryFlat(); flat && IsMappedMemory(flat->data())) {
+    return std::shared_ptr<const absl::Cord>(new absl::Cord(std::move(cord)),
+                                             MappedCordDeleter{});
+  }
+  return std::make_shared<const absl::Cord>(std::move(cord));
+}
+
+bool IsMappedMemoryOwner(const std::shared_ptr<const void>& owner) {
+  return std::get_deleter<MappedCordDeleter>(owner) != nullptr;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
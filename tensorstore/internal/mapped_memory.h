@@ -0,0 +1,68 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_MAPPED_MEMORY_H_
+#define TENSORSTORE_INTERNAL_MAPPED_MEMORY_H_
+
+/// \file
+/// Tracking of memory-mapped file data that is shared via `absl::Cord`.
+///
+/// Memory-mapped file data is backed by the operating system page cache, and
+/// may be evicted and re-read on demand.  Arrays that reference such data are
+/// marked when they are created by `MakeSharedCord`, so that caches can
+/// account for them separately using `IsMappedMemoryOwner`.
+
+#include <memory>
+#include <string_view>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/cord.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Returns a cord that references `data`, which must lie within a
+/// memory-mapped region that remains valid until `unmap` is invoked.
+///
+/// `unmap` is invoked once the returned cord, and all cords and arrays that
+/// share its data, are destroyed.  Until then, `IsMappedMemory` returns `true`
+/// for addresses within `data`.
+absl::Cord MakeCordFromMappedMemory(std::string_view data,
+                                    absl::AnyInvocable<void() &&> unmap);
+
+/// Returns `true` if `ptr` points into the `data` of a cord returned by
+/// `MakeCordFromMappedMemory` that has not yet been released.
+///
+/// This is cheap if no mapped memory is referenced, but otherwise requires
+/// a lookup in a global table; use `IsMappedMemoryOwner` on hot paths.
+bool IsMappedMemory(const void* ptr);
+
+/// Returns a shared pointer to a copy of `cord`, suitable for use as the owner
+/// of array data that references it.
+///
+/// If `cord` is flat and references mapped memory, the returned pointer (and
+/// any pointer that shares ownership with it) is marked such that
+/// `IsMappedMemoryOwner` returns `true`.
+std::shared_ptr<const absl::Cord> MakeSharedCord(absl::Cord cord);
+
+/// Returns `true` if `owner` shares ownership with a pointer returned by
+/// `MakeSharedCord` for a cord that references mapped memory.
+///
+/// This does not require any locking.
+bool IsMappedMemoryOwner(const std::shared_ptr<const void>& owner);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_MAPPED_MEMORY_H_
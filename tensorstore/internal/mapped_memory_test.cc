@@ -0,0 +1,86 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/mapped_memory.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+
+namespace {
+
+using ::tensorstore::internal::IsMappedMemory;
+using ::tensorstore::internal::IsMappedMemoryOwner;
+using ::tensorstore::internal::MakeCordFromMappedMemory;
+using ::tensorstore::internal::MakeSharedCord;
+
+TEST(MappedMemoryTest, Basic) {
+  // Stands in for a mapped region.
+  std::string region(100, 'x');
+  bool unmapped = false;
+  std::string_view data(region.data() + 10, 50);
+  {
+    absl::Cord cord =
+        MakeCordFromMappedMemory(data, [&unmapped] { unmapped = true; });
+    EXPECT_EQ(std::string(data), std::string(cord));
+    EXPECT_TRUE(IsMappedMemory(data.data()));
+    EXPECT_TRUE(IsMappedMemory(data.data() + 49));
+    EXPECT_FALSE(IsMappedMemory(data.data() + 50));
+    EXPECT_FALSE(IsMappedMemory(region.data()));
+
+    // Copies share the mapping.
+    absl::Cord copy = cord;
+    cord.Clear();
+    EXPECT_FALSE(unmapped);
+    EXPECT_TRUE(IsMappedMemory(data.data()));
+  }
+  EXPECT_TRUE(unmapped);
+  EXPECT_FALSE(IsMappedMemory(data.data()));
+}
+
+TEST(MappedMemoryTest, Empty) {
+  bool unmapped = false;
+  absl::Cord cord = MakeCordFromMappedMemory(std::string_view(),
+                                             [&unmapped] { unmapped = true; });
+  EXPECT_TRUE(cord.empty());
+  EXPECT_TRUE(unmapped);
+}
+
+TEST(MappedMemoryTest, MakeSharedCord) {
+  std::string region(100, 'x');
+  std::string_view data(region.data() + 10, 50);
+  std::shared_ptr<const void> owner;
+  {
+    absl::Cord cord = MakeCordFromMappedMemory(data, [] {});
+    auto shared_cord = MakeSharedCord(cord);
+    EXPECT_EQ(cord, *shared_cord);
+    EXPECT_TRUE(IsMappedMemoryOwner(shared_cord));
+    // Aliasing pointers share the mark.
+    owner = std::shared_ptr<const void>(std::move(shared_cord), data.data());
+  }
+  EXPECT_TRUE(IsMappedMemoryOwner(owner));
+  EXPECT_TRUE(IsMappedMemory(data.data()));
+  owner.reset();
+  EXPECT_FALSE(IsMappedMemory(data.data()));
+
+  auto unmapped_cord = MakeSharedCord(absl::Cord(region));
+  EXPECT_EQ(region, std::string(*unmapped_cord));
+  EXPECT_FALSE(IsMappedMemoryOwner(unmapped_cord));
+  EXPECT_FALSE(IsMappedMemoryOwner(std::make_shared<int>(1)));
+}
+
+}  // namespace
@@ -14,22 +14,29 @@
 
 #include "tensorstore/internal/schedule_at.h"
 
+#include <stdint.h>
+
 #include <algorithm>
 #include <cassert>
-#include <queue>
+#include <limits>
+#include <optional>
 #include <thread>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "absl/base/optimization.h"
 #include "absl/base/thread_annotations.h"
+#include "absl/numeric/bits.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_linked_list.h"
 #include "tensorstore/internal/metrics/gauge.h"
 #include "tensorstore/internal/metrics/histogram.h"
 #include "tensorstore/internal/metrics/value.h"
 #include "tensorstore/internal/no_destructor.h"
 #include "tensorstore/util/executor.h"
+#include "tensorstore/util/stop_token.h"
 
 namespace tensorstore {
 namespace internal {
@@ -48,87 +55,322 @@ auto& schedule_at_insert_histogram_ms =
         "/tensorstore/internal/schedule_at/insert_histogram_ms",
         "Histogram of schedule_at insert delays (ms)");
 
-struct DeadlineTask {
-  absl::Time deadline;
+/// Deadlines are rounded up to a multiple of the tick duration, 1ms.
+using Tick = int64_t;
+
+constexpr Tick kInfiniteFutureTick = std::numeric_limits<Tick>::max();
+
+Tick TimeToTickCeil(absl::Time time) {
+  return absl::ToInt64Milliseconds(
+      absl::Ceil(time - absl::UnixEpoch(), absl::Milliseconds(1)));
+}
+
+Tick TimeToTickFloor(absl::Time time) { return absl::ToUnixMillis(time); }
+
+absl::Time TickToTime(Tick tick) {
+  return tick == kInfiniteFutureTick ? absl::InfiniteFuture()
+                                     : absl::FromUnixMillis(tick);
+}
+
+struct TimerListNode {
+  TimerListNode* next;
+  TimerListNode* prev;
+};
+
+using TimerListAccessor = intrusive_linked_list::MemberAccessor<TimerListNode>;
+
+class DeadlineTaskQueue;
+
+struct DeadlineTaskNode : public TimerListNode {
+  DeadlineTaskNode(DeadlineTaskQueue& queue, Tick deadline, ExecutorTask task)
+      : queue(queue), deadline(deadline), task(std::move(task)) {}
+
+  /// Invoked when a stop is requested on the `StopToken` specified to
+  /// `ScheduleAt`.
+  struct CancelCallback {
+    DeadlineTaskNode* node;
+    void operator()() const;
+  };
+
+  DeadlineTaskQueue& queue;
+  Tick deadline;
   ExecutorTask task;
+
+  /// Index of the list containing this node, guarded by the queue mutex.  Only
+  /// meaningful if `in_wheel == true`.
+  uint8_t level;
+  uint8_t slot;
+
+  /// Indicates whether this node is contained in the `TimerWheel`, guarded by
+  /// the queue mutex.
+  bool in_wheel = false;
+
+  /// Set if a stop is requested before this node is added to the wheel,
+  /// guarded by the queue mutex.
+  bool cancelled = false;
+
+  std::optional<StopCallback<CancelCallback>> stop_callback;
 };
 
-/// Comparison for constructing a min-heap.
-struct Compare {
-  bool operator()(const DeadlineTask& a, const DeadlineTask& b) {
-    return b.deadline < a.deadline;
+/// Hierarchical timing wheel.
+///
+/// Level `l` consists of `kSlotsPerLevel` slots, each spanning
+/// `kSlotsPerLevel**l` ticks.  A node is stored at the lowest level `l` for
+/// which its deadline and `current_tick_` agree on all bits above the bits
+/// that select the slot of level `l`.  Consequently, all occupied slots of a
+/// level are after the slot containing `current_tick_`, and the nodes of a
+/// level `l > 0` slot are redistributed to lower levels ("cascaded") when
+/// `current_tick_` reaches the start of the slot.  Deadlines beyond the range
+/// of the top level are kept in an overflow list that is redistributed each
+/// time the top level wraps around.
+///
+/// Insertion and removal are O(1).  Finding the next occupied slot is
+/// O(kNumLevels), using a per-level occupancy bit mask.
+///
+/// This class is not thread-safe.
+class TimerWheel {
+ public:
+  constexpr static int kBitsPerLevel = 6;
+  constexpr static int kSlotsPerLevel = 1 << kBitsPerLevel;
+  constexpr static int kNumLevels = 6;
+  constexpr static uint8_t kDueLevel = kNumLevels;
+  constexpr static uint8_t kOverflowLevel = kNumLevels + 1;
+
+  explicit TimerWheel(Tick current_tick) : current_tick_(current_tick) {
+    for (auto& level : slots_) {
+      for (auto& head : level) {
+        intrusive_linked_list::Initialize(TimerListAccessor{}, &head);
+      }
+    }
+    intrusive_linked_list::Initialize(TimerListAccessor{}, &due_);
+    intrusive_linked_list::Initialize(TimerListAccessor{}, &overflow_);
+  }
+
+  Tick current_tick() const { return current_tick_; }
+
+  void Insert(DeadlineTaskNode* node) {
+    node->in_wheel = true;
+    if (node->deadline <= current_tick_) {
+      node->level = kDueLevel;
+      PushBack(due_, node);
+      return;
+    }
+    const uint64_t diff = static_cast<uint64_t>(node->deadline) ^
+                          static_cast<uint64_t>(current_tick_);
+    for (int level = 0; level < kNumLevels; ++level) {
+      if ((diff >> (kBitsPerLevel * (level + 1))) != 0) continue;
+      const int slot = SlotIndex(node->deadline, level);
+      node->level = level;
+      node->slot = slot;
+      occupied_[level] |= uint64_t{1} << slot;
+      PushBack(slots_[level][slot], node);
+      return;
+    }
+    node->level = kOverflowLevel;
+    PushBack(overflow_, node);
   }
+
+  void Remove(DeadlineTaskNode* node) {
+    assert(node->in_wheel);
+    node->in_wheel = false;
+    intrusive_linked_list::Remove(TimerListAccessor{}, node);
+    if (node->level < kNumLevels &&
+        intrusive_linked_list::OnlyContainsNode(
+            TimerListAccessor{}, &slots_[node->level][node->slot])) {
+      occupied_[node->level] &= ~(uint64_t{1} << node->slot);
+    }
+  }
+
+  /// Returns the earliest tick at which a node may become due, or
+  /// `kInfiniteFutureTick` if the wheel is empty.
+  Tick NextEventTick() const {
+    if (!IsEmpty(due_)) return current_tick_;
+    for (int level = 0; level < kNumLevels; ++level) {
+      if (!occupied_[level]) continue;
+      // Slots of lower levels always precede those of higher levels.
+      const int shift = kBitsPerLevel * (level + 1);
+      return ((current_tick_ >> shift) << shift) |
+             (Tick{absl::countr_zero(occupied_[level])}
+              << (kBitsPerLevel * level));
+    }
+    if (!IsEmpty(overflow_)) {
+      constexpr int shift = kBitsPerLevel * kNumLevels;
+      return ((current_tick_ >> shift) + 1) << shift;
+    }
+    return kInfiniteFutureTick;
+  }
+
+  /// Advances the current tick to `tick`, and removes all nodes with a
+  /// deadline not after `tick`, appending them to `runnable`.
+  void AdvanceTo(Tick tick, std::vector<DeadlineTaskNode*>& runnable) {
+    while (true) {
+      MoveAll(due_, runnable);
+      const Tick next_tick = NextEventTick();
+      if (next_tick > tick) break;
+      current_tick_ = next_tick;
+      if (next_tick % (Tick{1} << (kBitsPerLevel * kNumLevels)) == 0) {
+        Cascade(overflow_);
+      }
+      for (int level = kNumLevels - 1; level > 0; --level) {
+        if (next_tick % (Tick{1} << (kBitsPerLevel * level)) != 0) continue;
+        const int slot = SlotIndex(next_tick, level);
+        occupied_[level] &= ~(uint64_t{1} << slot);
+        Cascade(slots_[level][slot]);
+      }
+      const int slot = SlotIndex(next_tick, 0);
+      occupied_[0] &= ~(uint64_t{1} << slot);
+      MoveAll(slots_[0][slot], runnable);
+    }
+    current_tick_ = std::max(current_tick_, tick);
+  }
+
+ private:
+  static int SlotIndex(Tick tick, int level) {
+    return static_cast<int>(tick >> (kBitsPerLevel * level)) &
+           (kSlotsPerLevel - 1);
+  }
+
+  static bool IsEmpty(const TimerListNode& head) {
+    return head.next == &head;
+  }
+
+  static void PushBack(TimerListNode& head, DeadlineTaskNode* node) {
+    intrusive_linked_list::InsertBefore(TimerListAccessor{}, &head, node);
+  }
+
+  /// Removes all nodes from `head` and re-inserts them.
+  void Cascade(TimerListNode& head) {
+    while (!IsEmpty(head)) {
+      auto* node = static_cast<DeadlineTaskNode*>(head.next);
+      intrusive_linked_list::Remove(TimerListAccessor{}, node);
+      Insert(node);
+    }
+  }
+
+  static void MoveAll(TimerListNode& head,
+                      std::vector<DeadlineTaskNode*>& runnable) {
+    while (!IsEmpty(head)) {
+      auto* node = static_cast<DeadlineTaskNode*>(head.next);
+      intrusive_linked_list::Remove(TimerListAccessor{}, node);
+      node->in_wheel = false;
+      runnable.push_back(node);
+    }
+  }
+
+  Tick current_tick_;
+  uint64_t occupied_[kNumLevels] = {};
+  TimerListNode slots_[kNumLevels][kSlotsPerLevel];
+  TimerListNode due_;
+  TimerListNode overflow_;
 };
 
 class DeadlineTaskQueue {
  public:
   explicit DeadlineTaskQueue()
-      : next_wakeup_(absl::InfiniteFuture()),
+      : wheel_(TimeToTickFloor(absl::Now())),
+        next_wakeup_(kInfiniteFutureTick),
         thread_(&DeadlineTaskQueue::Run, this) {}
 
   ~DeadlineTaskQueue() { ABSL_UNREACHABLE(); }  // COV_NF_LINE
 
-  void ScheduleAt(absl::Time target_time, ExecutorTask task);
+  void ScheduleAt(absl::Time target_time, ExecutorTask task,
+                  const StopToken& stop_token);
+
+  void Cancel(DeadlineTaskNode* node);
 
   void Run();
 
  private:
   static bool Wakeup(DeadlineTaskQueue* self)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(self->mutex_) {
-    return self->next_wakeup_ > self->heap_min_deadline();
-  }
-
-  absl::Time heap_min_deadline() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
-    return heap_.empty() ? absl::InfiniteFuture() : heap_.begin()->deadline;
+    return self->next_wakeup_ > self->wheel_.NextEventTick();
   }
 
   absl::Mutex mutex_;
-  std::vector<DeadlineTask> heap_ ABSL_GUARDED_BY(mutex_);
-  absl::Time next_wakeup_ ABSL_GUARDED_BY(mutex_);
+  TimerWheel wheel_ ABSL_GUARDED_BY(mutex_);
+  Tick next_wakeup_ ABSL_GUARDED_BY(mutex_);
 
   std::thread thread_;
 };
 
-void DeadlineTaskQueue::ScheduleAt(absl::Time target_time, ExecutorTask task) {
+void DeadlineTaskNode::CancelCallback::operator()() const {
+  node->queue.Cancel(node);
+}
+
+void DeadlineTaskQueue::ScheduleAt(absl::Time target_time, ExecutorTask task,
+                                   const StopToken& stop_token) {
+  if (stop_token.stop_requested()) return;
+
   schedule_at_queued_ops.Increment();
   schedule_at_insert_histogram_ms.Observe(
       absl::ToInt64Milliseconds(target_time - absl::Now()));
 
+  auto* node =
+      new DeadlineTaskNode(*this, TimeToTickCeil(target_time), std::move(task));
+  if (stop_token.stop_possible()) {
+    // If a stop is requested before the node is added to the wheel, the
+    // callback just marks the node as cancelled.
+    node->stop_callback.emplace(stop_token,
+                                DeadlineTaskNode::CancelCallback{node});
+  }
+
   // Enqueue the task.
-  absl::MutexLock l(&mutex_);
-  heap_.emplace_back(DeadlineTask{std::move(target_time), std::move(task)});
-  std::push_heap(heap_.begin(), heap_.end(), Compare{});
+  {
+    absl::MutexLock l(&mutex_);
+    if (!node->cancelled) {
+      wheel_.Insert(node);
+      return;
+    }
+  }
+  schedule_at_queued_ops.Decrement();
+  delete node;
+}
+
+void DeadlineTaskQueue::Cancel(DeadlineTaskNode* node) {
+  {
+    absl::MutexLock l(&mutex_);
+    if (!node->in_wheel) {
+      // Either `ScheduleAt` has not yet added the node to the wheel, in which
+      // case it is responsible for deleting it, or the node has already been
+      // dequeued by `Run`.
+      node->cancelled = true;
+      return;
+    }
+    wheel_.Remove(node);
+  }
+  schedule_at_queued_ops.Decrement();
+  // Deleting the node unregisters the `StopCallback` that is currently being
+  // invoked, which is permitted.
+  delete node;
 }
 
 void DeadlineTaskQueue::Run() {
-  std::vector<DeadlineTask> runnable;
+  std::vector<DeadlineTaskNode*> runnable;
   runnable.reserve(1000);
-  absl::Time minimum_wakeup;
 
   while (true) {
     {
       absl::MutexLock l(&mutex_);
 
       // Sleep until our next deadline.
-      next_wakeup_ = heap_min_deadline();
-      schedule_at_next_event.Set(next_wakeup_);
+      next_wakeup_ = wheel_.NextEventTick();
+      schedule_at_next_event.Set(TickToTime(next_wakeup_));
 
       mutex_.AwaitWithDeadline(
-          absl::Condition(&DeadlineTaskQueue::Wakeup, this), next_wakeup_);
-
-      // Consume the queue.
-      minimum_wakeup = absl::Now();
-      while (!heap_.empty() && heap_.begin()->deadline <= minimum_wakeup) {
-        std::pop_heap(heap_.begin(), heap_.end(), Compare{});
-        runnable.emplace_back(std::move(heap_.back()));
-        heap_.pop_back();
-      }
+          absl::Condition(&DeadlineTaskQueue::Wakeup, this),
+          TickToTime(next_wakeup_));
+
+      // Consume all tasks that are due, which are run as a single batch.
+      wheel_.AdvanceTo(TimeToTickFloor(absl::Now()), runnable);
     }  // MutexLock
 
     // Execute functions without lock
-    for (auto& r : runnable) {
+    for (auto* node : runnable) {
       schedule_at_queued_ops.Decrement();
-      r.task();
+      node->task();
+      // Unregisters the `StopCallback`, waiting for any concurrent invocation
+      // to complete.
+      delete node;
     }
     runnable.clear();
   }
@@ -136,9 +378,10 @@ void DeadlineTaskQueue::Run() {
 
 }  // namespace
 
-void ScheduleAt(absl::Time target_time, ExecutorTask task) {
+void ScheduleAt(absl::Time target_time, ExecutorTask task,
+                const StopToken& stop_token) {
   static internal::NoDestructor<DeadlineTaskQueue> g_queue;
-  g_queue->ScheduleAt(std::move(target_time), std::move(task));
+  g_queue->ScheduleAt(std::move(target_time), std::move(task), stop_token);
 }
 
 }  // namespace internal
@@ -25,6 +25,7 @@
 #include "tensorstore/internal/poly/poly.h"
 #include "tensorstore/internal/type_traits.h"
 #include "tensorstore/util/executor.h"
+#include "tensorstore/util/stop_token.h"
 
 namespace tensorstore {
 namespace internal {
@@ -34,8 +35,12 @@ namespace internal {
 ///
 /// The return value of the `ExecutorTask` is ignored.
 ///
+/// If a stop is requested on `stop_token` before the task runs, the task is
+/// destroyed without being run.
+///
 /// \ingroup async
-void ScheduleAt(absl::Time target_time, ExecutorTask task);
+void ScheduleAt(absl::Time target_time, ExecutorTask task,
+                const StopToken& stop_token = {});
 
 }  // namespace internal
 }  // namespace tensorstore
@@ -0,0 +1,87 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include <atomic>
+#include <vector>
+
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <benchmark/benchmark.h>
+#include "tensorstore/internal/schedule_at.h"
+#include "tensorstore/util/stop_token.h"
+
+namespace {
+
+using ::tensorstore::StopSource;
+using ::tensorstore::internal::ScheduleAt;
+
+// Schedules `state.range(0)` timers with deadlines spread over the next hour,
+// then cancels `state.range(1)` percent of them.
+void BM_ScheduleAtCancel(benchmark::State& state) {
+  const size_t num_timers = state.range(0);
+  const size_t cancel_percent = state.range(1);
+  std::vector<StopSource> stop_sources(num_timers);
+  for (auto s : state) {
+    state.PauseTiming();
+    for (auto& stop_source : stop_sources) stop_source = StopSource();
+    state.ResumeTiming();
+
+    const absl::Time now = absl::Now();
+    for (size_t i = 0; i < num_timers; ++i) {
+      ScheduleAt(
+          now + absl::Minutes(1) + absl::Milliseconds(i % 3600000), [] {},
+          stop_sources[i].get_token());
+    }
+    for (size_t i = 0; i < num_timers; ++i) {
+      if (i % 100 < cancel_percent) stop_sources[i].request_stop();
+    }
+
+    // Cancel any remaining timers so that iterations are independent.
+    state.PauseTiming();
+    for (auto& stop_source : stop_sources) stop_source.request_stop();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_timers);
+}
+
+BENCHMARK(BM_ScheduleAtCancel)
+    ->Args({1000, 90})
+    ->Args({1000000, 0})
+    ->Args({1000000, 90})
+    ->Args({1000000, 100});
+
+// Schedules `state.range(0)` timers due in the next few milliseconds, and
+// waits for all of them to run.
+void BM_ScheduleAtRun(benchmark::State& state) {
+  const size_t num_timers = state.range(0);
+  for (auto s : state) {
+    std::atomic<size_t> remaining{num_timers};
+    absl::Notification done;
+    const absl::Time now = absl::Now();
+    for (size_t i = 0; i < num_timers; ++i) {
+      ScheduleAt(now + absl::Milliseconds(i % 10), [&] {
+        if (--remaining == 0) done.Notify();
+      });
+    }
+    done.WaitForNotification();
+  }
+  state.SetItemsProcessed(state.iterations() * num_timers);
+}
+
+BENCHMARK(BM_ScheduleAtRun)->Arg(1000)->Arg(100000);
+
+}  // namespace
@@ -14,13 +14,20 @@
 
 #include "tensorstore/internal/schedule_at.h"
 
+#include <atomic>
+#include <memory>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/util/executor.h"
+#include "tensorstore/util/stop_token.h"
 
 namespace {
 
+using ::tensorstore::StopSource;
 using ::tensorstore::internal::ScheduleAt;
 
 // Tests that the thread pool runs a task.
@@ -35,4 +42,71 @@ TEST(DelayExecutorTest, Basic) {
   EXPECT_TRUE(a.HasBeenNotified());
 }
 
+TEST(DelayExecutorTest, Ordering) {
+  // Deadlines span several levels of the timer wheel.
+  std::atomic<int> count{0};
+  int order[3] = {};
+  absl::Notification done;
+  auto now = absl::Now();
+  ScheduleAt(now + absl::Milliseconds(300), [&] {
+    order[2] = ++count;
+    done.Notify();
+  });
+  ScheduleAt(now + absl::Milliseconds(70), [&] { order[1] = ++count; });
+  ScheduleAt(now + absl::Milliseconds(2), [&] { order[0] = ++count; });
+  done.WaitForNotification();
+  EXPECT_GE(absl::Now(), now + absl::Milliseconds(300));
+  EXPECT_EQ(1, order[0]);
+  EXPECT_EQ(2, order[1]);
+  EXPECT_EQ(3, order[2]);
+}
+
+TEST(DelayExecutorTest, PastDeadline) {
+  absl::Notification a, b;
+  ScheduleAt(absl::InfinitePast(), [&] { a.Notify(); });
+  ScheduleAt(absl::Now() - absl::Seconds(1), [&] { b.Notify(); });
+  a.WaitForNotification();
+  b.WaitForNotification();
+}
+
+TEST(DelayExecutorTest, Cancel) {
+  StopSource stop_source;
+  std::atomic<bool> cancelled_ran{false};
+  absl::Notification done;
+
+  auto now = absl::Now();
+  ScheduleAt(
+      now + absl::Milliseconds(5), [&] { cancelled_ran = true; },
+      stop_source.get_token());
+  ScheduleAt(
+      absl::InfiniteFuture(), [&] { cancelled_ran = true; },
+      stop_source.get_token());
+  ScheduleAt(now + absl::Milliseconds(20), [&] { done.Notify(); });
+  EXPECT_TRUE(stop_source.request_stop());
+  done.WaitForNotification();
+  EXPECT_FALSE(cancelled_ran);
+
+  // A task scheduled after a stop was requested is never run.
+  ScheduleAt(
+      absl::InfinitePast(), [&] { cancelled_ran = true; },
+      stop_source.get_token());
+  absl::Notification done2;
+  ScheduleAt(now + absl::Milliseconds(1), [&] { done2.Notify(); });
+  done2.WaitForNotification();
+  EXPECT_FALSE(cancelled_ran);
+}
+
+TEST(DelayExecutorTest, CancelDestroysTask) {
+  StopSource stop_source;
+  struct Task {
+    std::shared_ptr<int> ptr;
+    void operator()() {}
+  };
+  auto ptr = std::make_shared<int>(0);
+  ScheduleAt(absl::Now() + absl::Hours(1), Task{ptr}, stop_source.get_token());
+  EXPECT_EQ(2, ptr.use_count());
+  stop_source.request_stop();
+  EXPECT_EQ(1, ptr.use_count());
+}
+
 }  // namespace
@@ -0,0 +1,89 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/io_cost.h"
+
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include "tensorstore/index.h"
+
+namespace tensorstore {
+
+double IoCost::read_amplification() const {
+  if (bytes_accessed == 0) return 1;
+  return static_cast<double>(bytes_decoded) /
+         static_cast<double>(bytes_accessed);
+}
+
+IoCost& IoCost::operator+=(const IoCost& other) {
+  chunks += other.chunks;
+  cached_chunks += other.cached_chunks;
+  partial_chunks += other.partial_chunks;
+  kvstore_reads += other.kvstore_reads;
+  kvstore_writes += other.kvstore_writes;
+  bytes_accessed += other.bytes_accessed;
+  bytes_fetched += other.bytes_fetched;
+  bytes_decoded += other.bytes_decoded;
+  bytes_written += other.bytes_written;
+  return *this;
+}
+
+bool operator==(const IoCost& a, const IoCost& b) {
+  return a.chunks == b.chunks && a.cached_chunks == b.cached_chunks &&
+         a.partial_chunks == b.partial_chunks &&
+         a.kvstore_reads == b.kvstore_reads &&
+         a.kvstore_writes == b.kvstore_writes &&
+         a.bytes_accessed == b.bytes_accessed &&
+         a.bytes_fetched == b.bytes_fetched &&
+         a.bytes_decoded == b.bytes_decoded &&
+         a.bytes_written == b.bytes_written;
+}
+
+std::ostream& operator<<(std::ostream& os, const IoCost& x) {
+  return os << "{chunks=" << x.chunks << ", cached_chunks=" << x.cached_chunks
+            << ", partial_chunks=" << x.partial_chunks
+            << ", kvstore_reads=" << x.kvstore_reads
+            << ", kvstore_writes=" << x.kvstore_writes
+            << ", bytes_accessed=" << x.bytes_accessed
+            << ", bytes_fetched=" << x.bytes_fetched
+            << ", bytes_decoded=" << x.bytes_decoded
+            << ", bytes_written=" << x.bytes_written << "}";
+}
+
+IoCost IoCostReport::total() const {
+  IoCost total;
+  for (const auto& chunk : chunks) total += chunk.cost;
+  return total;
+}
+
+std::map<std::string, IoCost> IoCostReport::per_kvstore() const {
+  std::map<std::string, IoCost> result;
+  for (const auto& chunk : chunks) result[chunk.kvstore] += chunk.cost;
+  return result;
+}
+
+void IoCostReport::Append(IoCostReport other) {
+  if (chunks.empty()) {
+    chunks = std::move(other.chunks);
+    return;
+  }
+  chunks.insert(chunks.end(), std::make_move_iterator(other.chunks.begin()),
+                std::make_move_iterator(other.chunks.end()));
+}
+
+}  // namespace tensorstore
@@ -0,0 +1,128 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_IO_COST_H_
+#define TENSORSTORE_IO_COST_H_
+
+/// \file
+/// Estimated I/O cost of a read or write, computed without performing I/O.
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/open_mode.h"
+
+namespace tensorstore {
+
+/// Estimated I/O counters of an operation, or of a part of an operation.
+///
+/// Byte counts of encoded data are estimated from the decoded size, since the
+/// encoded size of a chunk is not known without reading it.
+///
+/// \relates IoCostReport
+struct IoCost {
+  /// Number of chunks accessed.
+  Index chunks = 0;
+
+  /// Number of chunks that must be read but for which no kvstore read is
+  /// needed, because data satisfying the staleness bound is already cached.
+  Index cached_chunks = 0;
+
+  /// Number of chunks that are only partially accessed.
+  Index partial_chunks = 0;
+
+  /// Number of kvstore read requests.
+  Index kvstore_reads = 0;
+
+  /// Number of kvstore write requests.
+  Index kvstore_writes = 0;
+
+  /// Number of bytes of the accessed elements.
+  Index bytes_accessed = 0;
+
+  /// Estimated number of bytes fetched from the kvstore.
+  Index bytes_fetched = 0;
+
+  /// Number of bytes decoded, including the elements of partially-accessed
+  /// chunks that are not accessed.
+  Index bytes_decoded = 0;
+
+  /// Estimated number of bytes written to the kvstore.
+  Index bytes_written = 0;
+
+  /// Returns `bytes_decoded / bytes_accessed`, or `1` if no bytes are
+  /// accessed.
+  double read_amplification() const;
+
+  IoCost& operator+=(const IoCost& other);
+
+  friend bool operator==(const IoCost& a, const IoCost& b);
+  friend bool operator!=(const IoCost& a, const IoCost& b) {
+    return !(a == b);
+  }
+  friend std::ostream& operator<<(std::ostream& os, const IoCost& x);
+};
+
+/// Estimated I/O cost of a single chunk accessed by an operation.
+///
+/// \relates IoCostReport
+struct ChunkIoCost {
+  /// Specifies whether the chunk is read (`ReadWriteMode::read`) or written
+  /// (`ReadWriteMode::write`).
+  ReadWriteMode mode = ReadWriteMode::read;
+
+  /// Grid cell indices of the chunk.
+  std::vector<Index> cell_indices;
+
+  /// Bounding box, within the domain of the TensorStore, of the accessed
+  /// portion of the chunk.
+  Box<> domain;
+
+  /// Identifies the kvstore containing the chunk, normally a URL, or empty if
+  /// unknown.
+  std::string kvstore;
+
+  /// Key of the chunk within `kvstore`, or empty if unknown.
+  std::string key;
+
+  /// Costs attributed to this chunk.  `cost.chunks` is always `1`.
+  IoCost cost;
+};
+
+/// Estimated I/O cost of an operation, as computed by `ExplainRead`,
+/// `ExplainWrite`, and `ExplainCopy`.
+///
+/// \ingroup I/O
+struct IoCostReport {
+  /// Cost of each chunk accessed, in the order in which the chunks would be
+  /// issued.
+  std::vector<ChunkIoCost> chunks;
+
+  /// Returns the total cost of all chunks.
+  IoCost total() const;
+
+  /// Returns the total cost of all chunks, grouped by `ChunkIoCost::kvstore`.
+  std::map<std::string, IoCost> per_kvstore() const;
+
+  /// Appends the chunks of `other`.
+  void Append(IoCostReport other);
+};
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_IO_COST_H_
@@ -0,0 +1,221 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/io_cost.h"
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "absl/status/status.h"
+#include "tensorstore/box.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::ChunkIoCost;
+using ::tensorstore::Context;
+using ::tensorstore::Dims;
+using ::tensorstore::Index;
+using ::tensorstore::IoCost;
+using ::tensorstore::IoCostReport;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::ReadWriteMode;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+// 10x10 uint16 array with 4x4 chunks, so each chunk is 32 bytes.
+::nlohmann::json GetSpec(std::string path) {
+  return {
+      {"driver", "zarr"},
+      {"kvstore", {{"driver", "memory"}, {"path", path}}},
+      {"recheck_cached_data", false},
+      {"metadata",
+       {{"compressor", nullptr},
+        {"dtype", "<u2"},
+        {"shape", {10, 10}},
+        {"chunks", {4, 4}}}},
+  };
+}
+
+Context GetContext() {
+  return Context::FromJson({{"cache_pool", {{"total_bytes_limit", 1000000}}}})
+      .value();
+}
+
+IoCost MakeCost(Index chunks, Index cached_chunks, Index partial_chunks,
+                Index kvstore_reads, Index kvstore_writes, Index bytes_accessed,
+                Index bytes_fetched, Index bytes_decoded,
+                Index bytes_written) {
+  IoCost cost;
+  cost.chunks = chunks;
+  cost.cached_chunks = cached_chunks;
+  cost.partial_chunks = partial_chunks;
+  cost.kvstore_reads = kvstore_reads;
+  cost.kvstore_writes = kvstore_writes;
+  cost.bytes_accessed = bytes_accessed;
+  cost.bytes_fetched = bytes_fetched;
+  cost.bytes_decoded = bytes_decoded;
+  cost.bytes_written = bytes_written;
+  return cost;
+}
+
+TEST(IoCostReportTest, Totals) {
+  IoCostReport report;
+  ChunkIoCost chunk;
+  chunk.kvstore = "memory://a/";
+  chunk.cost = MakeCost(1, 0, 1, 1, 0, 8, 32, 32, 0);
+  report.chunks.push_back(chunk);
+  chunk.kvstore = "memory://b/";
+  chunk.cost = MakeCost(1, 1, 0, 0, 1, 32, 0, 0, 32);
+  report.chunks.push_back(chunk);
+  EXPECT_EQ(MakeCost(2, 1, 1, 1, 1, 40, 32, 32, 32), report.total());
+  EXPECT_DOUBLE_EQ(0.8, report.total().read_amplification());
+  EXPECT_EQ(1, IoCost{}.read_amplification());
+  EXPECT_THAT(
+      report.per_kvstore(),
+      ElementsAre(Pair("memory://a/", report.chunks[0].cost),
+                  Pair("memory://b/", report.chunks[1].cost)));
+}
+
+TEST(ExplainTest, Read) {
+  auto context = GetContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(GetSpec("a/"), context,
+                                    tensorstore::OpenMode::create)
+                      .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto report,
+      tensorstore::ExplainRead(store |
+                               Dims(0, 1).HalfOpenInterval({0, 2}, {4, 8})));
+  ASSERT_EQ(2, report.chunks.size());
+  EXPECT_EQ(ReadWriteMode::read, report.chunks[0].mode);
+  EXPECT_THAT(report.chunks[0].cell_indices, ElementsAre(0, 0));
+  EXPECT_EQ(tensorstore::BoxView({0, 2}, {4, 2}), report.chunks[0].domain);
+  EXPECT_EQ("memory://a/", report.chunks[0].kvstore);
+  EXPECT_EQ("a/0.0", report.chunks[0].key);
+  EXPECT_EQ(MakeCost(1, 0, 1, 1, 0, 16, 32, 32, 0), report.chunks[0].cost);
+  EXPECT_THAT(report.chunks[1].cell_indices, ElementsAre(0, 1));
+  EXPECT_EQ("a/0.1", report.chunks[1].key);
+  EXPECT_EQ(MakeCost(1, 0, 0, 1, 0, 32, 32, 32, 0), report.chunks[1].cost);
+  EXPECT_EQ(MakeCost(2, 0, 1, 2, 0, 48, 64, 64, 0), report.total());
+  EXPECT_DOUBLE_EQ(64.0 / 48, report.total().read_amplification());
+}
+
+TEST(ExplainTest, Strided) {
+  auto context = GetContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(GetSpec("a/"), context,
+                                    tensorstore::OpenMode::create)
+                      .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto report,
+      tensorstore::ExplainRead(store |
+                               Dims(0, 1).HalfOpenInterval({0, 0}, {4, 4}) |
+                               Dims(0).Stride(2)));
+  ASSERT_EQ(1, report.chunks.size());
+  EXPECT_EQ(MakeCost(1, 0, 1, 1, 0, 16, 32, 32, 0), report.chunks[0].cost);
+}
+
+TEST(ExplainTest, Cached) {
+  auto context = GetContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(GetSpec("a/"), context,
+                                    tensorstore::OpenMode::create)
+                      .result());
+  auto region = store | Dims(0, 1).HalfOpenInterval({0, 0}, {4, 8});
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Read(store | Dims(0, 1).HalfOpenInterval({0, 0}, {4, 4}))
+          .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto report,
+                                   tensorstore::ExplainRead(region));
+  ASSERT_EQ(2, report.chunks.size());
+  EXPECT_EQ(MakeCost(1, 1, 0, 0, 0, 32, 0, 0, 0), report.chunks[0].cost);
+  EXPECT_EQ(MakeCost(1, 0, 0, 1, 0, 32, 32, 32, 0), report.chunks[1].cost);
+}
+
+TEST(ExplainTest, Write) {
+  auto context = GetContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(GetSpec("a/"), context,
+                                    tensorstore::OpenMode::create)
+                      .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto report,
+      tensorstore::ExplainWrite(store |
+                                Dims(0, 1).HalfOpenInterval({0, 0}, {4, 6})));
+  ASSERT_EQ(2, report.chunks.size());
+  EXPECT_EQ(ReadWriteMode::write, report.chunks[0].mode);
+  // Fully overwritten chunks are not read.
+  EXPECT_EQ(MakeCost(1, 0, 0, 0, 1, 32, 0, 0, 32), report.chunks[0].cost);
+  EXPECT_EQ(MakeCost(1, 0, 1, 1, 1, 16, 32, 32, 32), report.chunks[1].cost);
+}
+
+TEST(ExplainTest, Copy) {
+  auto context = GetContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto source, tensorstore::Open(GetSpec("a/"), context,
+                                     tensorstore::OpenMode::create)
+                       .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto target, tensorstore::Open(GetSpec("b/"), context,
+                                     tensorstore::OpenMode::create)
+                       .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto report,
+      tensorstore::ExplainCopy(
+          source | Dims(0, 1).HalfOpenInterval({0, 0}, {4, 4}),
+          target | Dims(0, 1).HalfOpenInterval({0, 0}, {4, 4})));
+  ASSERT_EQ(2, report.chunks.size());
+  EXPECT_EQ(ReadWriteMode::read, report.chunks[0].mode);
+  EXPECT_EQ(ReadWriteMode::write, report.chunks[1].mode);
+  EXPECT_THAT(report.per_kvstore(),
+              ElementsAre(Pair("memory://a/",
+                               MakeCost(1, 0, 0, 1, 0, 32, 32, 32, 0)),
+                          Pair("memory://b/",
+                               MakeCost(1, 0, 0, 0, 1, 32, 0, 0, 32))));
+}
+
+TEST(ExplainTest, Transaction) {
+  auto context = GetContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(GetSpec("a/"), context,
+                                    tensorstore::OpenMode::create)
+                      .result());
+  tensorstore::Transaction transaction(tensorstore::isolated);
+  EXPECT_THAT(tensorstore::ExplainWrite(store | transaction),
+              MatchesStatus(absl::StatusCode::kUnimplemented,
+                            ".*within a transaction"));
+}
+
+TEST(ExplainTest, Unimplemented) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open({{"driver", "array"},
+                         {"dtype", "int32"},
+                         {"array", {1, 2, 3}}})
+          .result());
+  EXPECT_THAT(tensorstore::ExplainRead(store),
+              MatchesStatus(absl::StatusCode::kUnimplemented));
+}
+
+}  // namespace
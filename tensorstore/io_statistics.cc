@@ -0,0 +1,133 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/io_statistics.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "absl/base/attributes.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/driver.h"
+
+namespace tensorstore {
+namespace {
+
+ABSL_CONST_INIT thread_local IoStatistics* current_io_statistics = nullptr;
+
+void AddTo(KvstoreIoStatistics& stats, int64_t reads, int64_t bytes_read,
+           int64_t writes, int64_t bytes_written) {
+  stats.reads += reads;
+  stats.bytes_read += bytes_read;
+  stats.writes += writes;
+  stats.bytes_written += bytes_written;
+}
+
+}  // namespace
+
+bool operator==(const KvstoreIoStatistics& a, const KvstoreIoStatistics& b) {
+  return a.reads == b.reads && a.bytes_read == b.bytes_read &&
+         a.writes == b.writes && a.bytes_written == b.bytes_written;
+}
+
+std::ostream& operator<<(std::ostream& os, const KvstoreIoStatistics& x) {
+  return os << "{reads=" << x.reads << ", bytes_read=" << x.bytes_read
+            << ", writes=" << x.writes << ", bytes_written=" << x.bytes_written
+            << "}";
+}
+
+IoStatisticsPtr IoStatistics::Make() {
+  return internal::MakeIntrusivePtr<IoStatistics>();
+}
+
+IoStatistics::KvstoreCounters& IoStatistics::GetKvstoreCounters(
+    kvstore::Driver* driver) {
+  // Counters are keyed by the driver identifier rather than the address of the
+  // driver, since the driver may be destroyed, and its address reused, while
+  // this object is still in use.  The identifier has static storage duration,
+  // so it may be retained.
+  const std::string_view id = driver->driver_id();
+  for (auto& counters : kvstores_) {
+    const char* existing = counters.id.load(std::memory_order_acquire);
+    if (existing == nullptr &&
+        counters.id.compare_exchange_strong(existing, id.data(),
+                                            std::memory_order_acq_rel)) {
+      return counters;
+    }
+    // `existing` was updated by a failed `compare_exchange_strong`.
+    if (existing == id.data() || std::string_view(existing) == id) {
+      return counters;
+    }
+  }
+  return other_kvstores_;
+}
+
+void IoStatistics::RecordKvstoreRead(kvstore::Driver* driver, int64_t bytes) {
+  auto& counters = GetKvstoreCounters(driver);
+  counters.reads.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes_read.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void IoStatistics::RecordKvstoreWrite(kvstore::Driver* driver, int64_t bytes) {
+  auto& counters = GetKvstoreCounters(driver);
+  counters.writes.fetch_add(1, std::memory_order_relaxed);
+  counters.bytes_written.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+IoStatisticsSnapshot IoStatistics::Get() const {
+  IoStatisticsSnapshot snapshot;
+  snapshot.chunks = chunks_.load(std::memory_order_relaxed);
+  snapshot.cache_hits = cache_hits_.load(std::memory_order_relaxed);
+  snapshot.cache_misses = cache_misses_.load(std::memory_order_relaxed);
+  snapshot.decode_time =
+      absl::Nanoseconds(decode_nanoseconds_.load(std::memory_order_relaxed));
+  snapshot.copy_time =
+      absl::Nanoseconds(copy_nanoseconds_.load(std::memory_order_relaxed));
+  auto add = [&](std::string_view id, const KvstoreCounters& counters) {
+    AddTo(snapshot.kvstores[std::string(id)],
+          counters.reads.load(std::memory_order_relaxed),
+          counters.bytes_read.load(std::memory_order_relaxed),
+          counters.writes.load(std::memory_order_relaxed),
+          counters.bytes_written.load(std::memory_order_relaxed));
+  };
+  for (const auto& counters : kvstores_) {
+    const char* id = counters.id.load(std::memory_order_acquire);
+    if (!id) break;
+    add(id, counters);
+  }
+  if (other_kvstores_.reads.load(std::memory_order_relaxed) != 0 ||
+      other_kvstores_.writes.load(std::memory_order_relaxed) != 0) {
+    add("other", other_kvstores_);
+  }
+  return snapshot;
+}
+
+namespace internal {
+
+IoStatistics* GetCurrentIoStatistics() { return current_io_statistics; }
+
+ScopedIoStatistics::ScopedIoStatistics(IoStatistics* io_statistics)
+    : prev_(current_io_statistics) {
+  current_io_statistics = io_statistics;
+}
+
+ScopedIoStatistics::~ScopedIoStatistics() { current_io_statistics = prev_; }
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,231 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_IO_STATISTICS_H_
+#define TENSORSTORE_IO_STATISTICS_H_
+
+/// \file
+/// Per-operation I/O statistics.
+
+#include <stdint.h>
+
+#include <atomic>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+
+namespace tensorstore {
+namespace kvstore {
+class Driver;
+}  // namespace kvstore
+
+/// I/O statistics of a single kvstore, as reported by `IoStatisticsSnapshot`.
+///
+/// \relates IoStatistics
+struct KvstoreIoStatistics {
+  /// Number of read requests.
+  int64_t reads = 0;
+
+  /// Number of bytes received by read requests.
+  int64_t bytes_read = 0;
+
+  /// Number of write requests.
+  int64_t writes = 0;
+
+  /// Number of bytes sent by write requests.
+  int64_t bytes_written = 0;
+
+  friend bool operator==(const KvstoreIoStatistics& a,
+                         const KvstoreIoStatistics& b);
+  friend bool operator!=(const KvstoreIoStatistics& a,
+                         const KvstoreIoStatistics& b) {
+    return !(a == b);
+  }
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const KvstoreIoStatistics& x);
+};
+
+/// Point-in-time copy of the counters of an `IoStatistics` object.
+///
+/// \relates IoStatistics
+struct IoStatisticsSnapshot {
+  /// Number of chunks copied to or from the user's array.  A chunk is counted
+  /// once per operation that accesses it.
+  int64_t chunks = 0;
+
+  /// Number of chunks for which cached data satisfied the staleness bound.
+  int64_t cache_hits = 0;
+
+  /// Number of chunks that had to be read.
+  int64_t cache_misses = 0;
+
+  /// Total time spent decoding chunks, from the time the encoded value was
+  /// received until the decoded chunk was available.
+  absl::Duration decode_time = absl::ZeroDuration();
+
+  /// Total time spent copying data between chunks and the user's array.
+  absl::Duration copy_time = absl::ZeroDuration();
+
+  /// Statistics of each kvstore, keyed by kvstore driver identifier, such as
+  /// ``"file"`` or ``"gcs"``.  All kvstores with the same driver identifier,
+  /// e.g. several GCS buckets, are combined.
+  std::map<std::string, KvstoreIoStatistics> kvstores;
+};
+
+class IoStatistics;
+
+/// Shared handle to an `IoStatistics` object.
+///
+/// \relates IoStatistics
+using IoStatisticsPtr = internal::IntrusivePtr<IoStatistics>;
+
+/// Accumulates I/O statistics of the operations with which it is associated.
+///
+/// A sink may be specified for an individual `Read`, `Write`, or `Copy`
+/// operation by the `io_statistics` member of the options, and may be shared
+/// by multiple concurrent operations.  All counters are updated with relaxed
+/// atomic operations, without locking.
+///
+/// Attribution to operations follows the flow of work:
+///
+/// - A kvstore read, and the decoding of its result, is attributed to the
+///   operation that required it, even if it is issued later from another
+///   thread.  Other operations that concurrently wait for the same chunk count
+///   a cache miss, but no kvstore request.
+///
+/// - Writes are buffered and written back later, possibly combining the
+///   modifications of several operations.  The kvstore write request for a
+///   chunk is attributed to the most recent operation that modified it, and
+///   is only recorded once the write succeeds.
+///
+/// - Kvstore requests are recorded against the kvstore that the TensorStore
+///   driver reads and writes chunks through.  If that is an adapter, such as
+///   ``neuroglancer_uint64_sharded``, the request is recorded under the
+///   adapter's identifier with the size of the value that the adapter
+///   returned.  The requests that the adapter issues to its base kvstore,
+///   such as shard index reads, are not recorded.
+///
+/// Example::
+///
+///     auto stats = IoStatistics::Make();
+///     ReadOptions options;
+///     options.io_statistics = stats;
+///     TENSORSTORE_RETURN_IF_ERROR(Read(store, array, options).result());
+///     auto snapshot = stats->Get();
+///     std::cout << snapshot.cache_misses << " chunks read" << std::endl;
+///
+/// \ingroup I/O
+class IoStatistics : public internal::AtomicReferenceCount<IoStatistics> {
+ public:
+  /// Maximum number of distinct kvstore driver identifiers tracked
+  /// separately.  Requests to kvstores with additional identifiers are
+  /// combined under the identifier ``"other"``.
+  static constexpr size_t kMaxKvstores = 8;
+
+  /// Returns a new object with all counters equal to zero.
+  static IoStatisticsPtr Make();
+
+  IoStatistics() = default;
+  IoStatistics(const IoStatistics&) = delete;
+  IoStatistics& operator=(const IoStatistics&) = delete;
+
+  void RecordChunk() { chunks_.fetch_add(1, std::memory_order_relaxed); }
+
+  void RecordCacheHit() {
+    cache_hits_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void RecordCacheMiss() {
+    cache_misses_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void RecordDecodeTime(absl::Duration duration) {
+    decode_nanoseconds_.fetch_add(absl::ToInt64Nanoseconds(duration),
+                                  std::memory_order_relaxed);
+  }
+
+  void RecordCopyTime(absl::Duration duration) {
+    copy_nanoseconds_.fetch_add(absl::ToInt64Nanoseconds(duration),
+                                std::memory_order_relaxed);
+  }
+
+  /// Records a read request to `driver` that received `bytes` bytes.
+  ///
+  /// No reference to `driver` is retained.
+  void RecordKvstoreRead(kvstore::Driver* driver, int64_t bytes);
+
+  /// Records a write request to `driver` that sent `bytes` bytes.
+  ///
+  /// No reference to `driver` is retained.
+  void RecordKvstoreWrite(kvstore::Driver* driver, int64_t bytes);
+
+  /// Returns the current value of all counters.
+  ///
+  /// Counters updated concurrently with this call may or may not be included.
+  IoStatisticsSnapshot Get() const;
+
+ private:
+  /// Counters of all kvstore drivers with a given identifier.
+  struct KvstoreCounters {
+    /// Driver identifier, as returned by `kvstore::Driver::driver_id`, claimed
+    /// by the first request recorded.
+    std::atomic<const char*> id{nullptr};
+    std::atomic<int64_t> reads{0};
+    std::atomic<int64_t> bytes_read{0};
+    std::atomic<int64_t> writes{0};
+    std::atomic<int64_t> bytes_written{0};
+  };
+
+  KvstoreCounters& GetKvstoreCounters(kvstore::Driver* driver);
+
+  std::atomic<int64_t> chunks_{0};
+  std::atomic<int64_t> cache_hits_{0};
+  std::atomic<int64_t> cache_misses_{0};
+  std::atomic<int64_t> decode_nanoseconds_{0};
+  std::atomic<int64_t> copy_nanoseconds_{0};
+  KvstoreCounters kvstores_[kMaxKvstores];
+  KvstoreCounters other_kvstores_;
+};
+
+namespace internal {
+
+/// Returns the statistics sink of the operation being initiated on the current
+/// thread, or `nullptr` if there is none.
+///
+/// Drivers and caches that do not receive the operation options directly,
+/// such as `ChunkCache`, use this while synchronously initiating work, and
+/// pass the sink explicitly, e.g. to `AsyncCache::Entry::Read`, for any work
+/// that is issued or completes asynchronously.
+IoStatistics* GetCurrentIoStatistics();
+
+/// Sets the sink returned by `GetCurrentIoStatistics` for the lifetime of this
+/// object.
+class ScopedIoStatistics {
+ public:
+  explicit ScopedIoStatistics(IoStatistics* io_statistics);
+  ~ScopedIoStatistics();
+  ScopedIoStatistics(const ScopedIoStatistics&) = delete;
+  ScopedIoStatistics& operator=(const ScopedIoStatistics&) = delete;
+
+ private:
+  IoStatistics* prev_;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_IO_STATISTICS_H_
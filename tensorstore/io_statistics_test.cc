@@ -0,0 +1,214 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/io_statistics.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "absl/time/time.h"
+#include "tensorstore/array.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/read_write_options.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::Dims;
+using ::tensorstore::IoStatistics;
+using ::tensorstore::KvstoreIoStatistics;
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+KvstoreIoStatistics MakeKvstoreStatistics(int64_t reads, int64_t bytes_read,
+                                          int64_t writes,
+                                          int64_t bytes_written) {
+  KvstoreIoStatistics stats;
+  stats.reads = reads;
+  stats.bytes_read = bytes_read;
+  stats.writes = writes;
+  stats.bytes_written = bytes_written;
+  return stats;
+}
+
+// 10x10 uint16 array with 4x4 chunks, so each chunk is 32 bytes.
+::nlohmann::json GetSpec() {
+  return {
+      {"driver", "zarr"},
+      {"kvstore", {{"driver", "memory"}, {"path", "a/"}}},
+      {"recheck_cached_data", false},
+      {"metadata",
+       {{"compressor", nullptr},
+        {"dtype", "<u2"},
+        {"shape", {10, 10}},
+        {"chunks", {4, 4}}}},
+  };
+}
+
+TEST(IoStatisticsTest, Counters) {
+  auto stats = IoStatistics::Make();
+  stats->RecordChunk();
+  stats->RecordChunk();
+  stats->RecordCacheHit();
+  stats->RecordCacheMiss();
+  stats->RecordDecodeTime(absl::Milliseconds(2));
+  stats->RecordCopyTime(absl::Milliseconds(3));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto kvs, tensorstore::kvstore::Open({{"driver", "memory"}}).result());
+  stats->RecordKvstoreRead(kvs.driver.get(), 10);
+  stats->RecordKvstoreRead(kvs.driver.get(), 5);
+  stats->RecordKvstoreWrite(kvs.driver.get(), 7);
+  auto snapshot = stats->Get();
+  EXPECT_EQ(2, snapshot.chunks);
+  EXPECT_EQ(1, snapshot.cache_hits);
+  EXPECT_EQ(1, snapshot.cache_misses);
+  EXPECT_EQ(absl::Milliseconds(2), snapshot.decode_time);
+  EXPECT_EQ(absl::Milliseconds(3), snapshot.copy_time);
+  EXPECT_THAT(snapshot.kvstores,
+              ElementsAre(Pair("memory", MakeKvstoreStatistics(2, 15, 1, 7))));
+}
+
+TEST(IoStatisticsTest, KvstoresKeyedByDriverId) {
+  auto stats = IoStatistics::Make();
+  for (int i = 0; i < 2; ++i) {
+    // Each iteration opens a distinct driver, which is destroyed at the end of
+    // the iteration; no reference to it is retained.
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto kvs, tensorstore::kvstore::Open({{"driver", "memory"}}).result());
+    EXPECT_EQ("memory", kvs.driver->driver_id());
+    stats->RecordKvstoreRead(kvs.driver.get(), 1);
+  }
+  EXPECT_THAT(stats->Get().kvstores,
+              ElementsAre(Pair("memory", MakeKvstoreStatistics(2, 2, 0, 0))));
+}
+
+TEST(IoStatisticsTest, CurrentScope) {
+  auto stats = IoStatistics::Make();
+  EXPECT_EQ(nullptr, tensorstore::internal::GetCurrentIoStatistics());
+  {
+    tensorstore::internal::ScopedIoStatistics scope(stats.get());
+    EXPECT_EQ(stats.get(), tensorstore::internal::GetCurrentIoStatistics());
+    {
+      tensorstore::internal::ScopedIoStatistics inner_scope(nullptr);
+      EXPECT_EQ(nullptr, tensorstore::internal::GetCurrentIoStatistics());
+    }
+    EXPECT_EQ(stats.get(), tensorstore::internal::GetCurrentIoStatistics());
+  }
+  EXPECT_EQ(nullptr, tensorstore::internal::GetCurrentIoStatistics());
+}
+
+TEST(IoStatisticsTest, ReadAndWrite) {
+  auto context =
+      Context::FromJson({{"cache_pool", {{"total_bytes_limit", 1000000}}}})
+          .value();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec(), context, tensorstore::OpenMode::create)
+          .result());
+  auto region = store | Dims(0, 1).HalfOpenInterval({0, 0}, {4, 8});
+
+  // Missing chunks are read, but no bytes are received.
+  auto read_stats = IoStatistics::Make();
+  {
+    tensorstore::ReadIntoNewArrayOptions options;
+    options.io_statistics = read_stats;
+    TENSORSTORE_ASSERT_OK(
+        tensorstore::Read(region, std::move(options)).result());
+  }
+  auto snapshot = read_stats->Get();
+  EXPECT_EQ(2, snapshot.chunks);
+  EXPECT_EQ(0, snapshot.cache_hits);
+  EXPECT_EQ(2, snapshot.cache_misses);
+  EXPECT_THAT(snapshot.kvstores,
+              ElementsAre(Pair("memory", MakeKvstoreStatistics(2, 0, 0, 0))));
+
+  // Writeback is attributed to the write.
+  auto write_stats = IoStatistics::Make();
+  {
+    tensorstore::WriteOptions options;
+    options.io_statistics = write_stats;
+    TENSORSTORE_ASSERT_OK(
+        tensorstore::Write(tensorstore::MakeScalarArray<uint16_t>(42), region,
+                           std::move(options))
+            .commit_future.result());
+  }
+  snapshot = write_stats->Get();
+  EXPECT_EQ(2, snapshot.chunks);
+  EXPECT_EQ(0, snapshot.cache_hits);
+  EXPECT_EQ(0, snapshot.cache_misses);
+  EXPECT_THAT(snapshot.kvstores,
+              ElementsAre(Pair("memory", MakeKvstoreStatistics(0, 0, 2, 64))));
+
+  // The written chunks remain cached.
+  auto cached_stats = IoStatistics::Make();
+  {
+    tensorstore::ReadIntoNewArrayOptions options;
+    options.io_statistics = cached_stats;
+    TENSORSTORE_ASSERT_OK(
+        tensorstore::Read(region, std::move(options)).result());
+  }
+  snapshot = cached_stats->Get();
+  EXPECT_EQ(2, snapshot.chunks);
+  EXPECT_EQ(2, snapshot.cache_hits);
+  EXPECT_EQ(0, snapshot.cache_misses);
+  EXPECT_THAT(snapshot.kvstores, ElementsAre());
+
+  // Earlier sinks are unaffected by later operations.
+  snapshot = read_stats->Get();
+  EXPECT_EQ(2, snapshot.chunks);
+  EXPECT_EQ(2, snapshot.cache_misses);
+}
+
+TEST(IoStatisticsTest, ReadReceivesBytes) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(GetSpec(), context, tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(tensorstore::MakeScalarArray<uint16_t>(1),
+                         store | Dims(0, 1).HalfOpenInterval({0, 0}, {4, 4}))
+          .commit_future.result());
+
+  // The default cache pool does not retain chunks, so the chunk is re-read.
+  auto stats = IoStatistics::Make();
+  tensorstore::ReadOptions options;
+  options.io_statistics = stats;
+  auto array = tensorstore::AllocateArray<uint16_t>({4, 4});
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Read(store | Dims(0, 1).HalfOpenInterval({0, 0}, {4, 4}),
+                        array, std::move(options))
+          .result());
+  auto snapshot = stats->Get();
+  EXPECT_EQ(1, snapshot.chunks);
+  EXPECT_EQ(1, snapshot.cache_misses);
+  EXPECT_THAT(snapshot.kvstores,
+              ElementsAre(Pair("memory", MakeKvstoreStatistics(1, 32, 0, 0))));
+  EXPECT_GE(snapshot.decode_time, absl::ZeroDuration());
+  EXPECT_GE(snapshot.copy_time, absl::ZeroDuration());
+}
+
+}  // namespace
@@ -0,0 +1,320 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// Key-value store adapter that merges concurrent reads of the same key into a
+/// single read of the base key-value store.
+///
+/// A read shares an in-progress read of the base kvstore (rather than issuing
+/// its own) if:
+///
+///   - both have the same `if_equal` and `if_not_equal` conditions;
+///
+///   - the byte range of the in-progress read contains the requested byte
+///     range; and
+///
+///   - the staleness bound of the in-progress read is no earlier than the
+///     requested staleness bound, less the configured `staleness_tolerance`.
+///
+/// Since all readers of the same kvstore, including independent arrays and
+/// caches, share the same driver instance, this deduplicates reads across all
+/// of them.  The result, including any error, is shared by all merged reads.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/cache_key/absl_time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/absl_time.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/serialization/absl_time.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/garbage_collection.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::kvstore::ReadResult;
+
+auto& coalesce_reads = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/coalesce/reads",
+    "Number of coalesce kvstore reads that were issued to the base kvstore");
+
+auto& coalesce_shared_reads = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/coalesce/shared_reads",
+    "Number of coalesce kvstore reads that shared a concurrent read of the "
+    "base kvstore");
+
+struct CoalesceKeyValueStoreSpecData {
+  kvstore::Spec base;
+
+  /// Reads may share a read of the base kvstore with a staleness bound up to
+  /// this much earlier than their own.
+  absl::Duration staleness_tolerance = absl::ZeroDuration();
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.staleness_tolerance);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base",
+                 jb::Projection<&CoalesceKeyValueStoreSpecData::base>()),
+      jb::Member(
+          "staleness_tolerance",
+          jb::Projection<&CoalesceKeyValueStoreSpecData::staleness_tolerance>(
+              jb::DefaultValue([](auto* v) { *v = absl::ZeroDuration(); }))));
+};
+
+class CoalesceKeyValueStoreSpec
+    : public internal_kvstore::RegisteredDriverSpec<
+          CoalesceKeyValueStoreSpec, CoalesceKeyValueStoreSpecData> {
+ public:
+  static constexpr char id[] = "coalesce";
+  Future<kvstore::DriverPtr> DoOpen() const override;
+};
+
+/// Returns `true` if `outer` contains `inner`, irrespective of the size of the
+/// value.
+bool Contains(const OptionalByteRangeRequest& outer,
+              const OptionalByteRangeRequest& inner) {
+  if (inner.inclusive_min < outer.inclusive_min) return false;
+  if (!outer.exclusive_max) return true;
+  return inner.exclusive_max && *inner.exclusive_max <= *outer.exclusive_max;
+}
+
+/// Computes the result of a read of `byte_range` from the result of a shared
+/// read of `shared_byte_range`, which contains `byte_range`.
+Result<ReadResult> GetSharedReadResult(
+    const Result<ReadResult>& shared,
+    const OptionalByteRangeRequest& shared_byte_range,
+    const OptionalByteRangeRequest& byte_range) {
+  if (!shared.ok()) return shared.status();
+  if (!shared->has_value()) return *shared;
+  const uint64_t offset = shared_byte_range.inclusive_min;
+  ByteRange range;
+  if (shared_byte_range.exclusive_max) {
+    // The shared read succeeded, so `byte_range` is also valid.
+    range = ByteRange{byte_range.inclusive_min, *byte_range.exclusive_max};
+  } else {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        range, byte_range.Validate(offset + shared->value.size()));
+  }
+  ReadResult result;
+  result.state = ReadResult::kValue;
+  result.stamp = shared->stamp;
+  result.value = internal::GetSubCord(
+      shared->value,
+      ByteRange{range.inclusive_min - offset, range.exclusive_max - offset});
+  return result;
+}
+
+class CoalesceKeyValueStore
+    : public internal_kvstore::RegisteredDriver<CoalesceKeyValueStore,
+                                                CoalesceKeyValueStoreSpec> {
+ public:
+  Future<ReadResult> Read(Key key, ReadOptions options) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override {
+    return base_.driver->Write(BaseKey(key), std::move(value),
+                               std::move(options));
+  }
+
+  Future<const void> DeleteRange(KeyRange range) override {
+    return base_.driver->DeleteRange(
+        KeyRange::AddPrefix(base_.path, std::move(range)));
+  }
+
+  void ListImpl(ListOptions options,
+                AnyFlowReceiver<absl::Status, Key> receiver) override {
+    options.range = KeyRange::AddPrefix(base_.path, std::move(options.range));
+    options.strip_prefix_length += base_.path.size();
+    base_.driver->ListImpl(std::move(options), std::move(receiver));
+  }
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(BaseKey(key));
+  }
+
+  absl::Status GetBoundSpecData(CoalesceKeyValueStoreSpecData& spec) const {
+    spec = spec_;
+    TENSORSTORE_ASSIGN_OR_RETURN(spec.base.driver,
+                                 base_.driver->GetBoundSpec());
+    spec.base.path = base_.path;
+    return absl::OkStatus();
+  }
+
+  std::string BaseKey(std::string_view key) const {
+    return tensorstore::StrCat(base_.path, key);
+  }
+
+  /// Returns the result of a read with the specified `options` computed from
+  /// the shared read `shared`, which was issued with `shared_byte_range`.
+  Future<ReadResult> Share(Key key, ReadOptions options,
+                           OptionalByteRangeRequest shared_byte_range,
+                           Future<ReadResult> shared);
+
+  /// Read of the base kvstore that is still in progress.
+  struct PendingRead {
+    /// Options with a resolved `staleness_bound`.
+    ReadOptions options;
+    Future<ReadResult> future;
+  };
+
+  SpecData spec_;
+  kvstore::KvStore base_;
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::vector<PendingRead>> pending_reads_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+Future<ReadResult> CoalesceKeyValueStore::Read(Key key, ReadOptions options) {
+  if (options.staleness_bound == absl::InfiniteFuture()) {
+    options.staleness_bound = absl::Now();
+  }
+  const absl::Time min_staleness_bound =
+      options.staleness_bound - spec_.staleness_tolerance;
+  Promise<ReadResult> promise;
+  Future<ReadResult> future;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto& pending_reads = pending_reads_[key];
+    for (const auto& pending : pending_reads) {
+      if (pending.options.staleness_bound >= min_staleness_bound &&
+          pending.options.if_equal == options.if_equal &&
+          pending.options.if_not_equal == options.if_not_equal &&
+          Contains(pending.options.byte_range, options.byte_range)) {
+        coalesce_shared_reads.Increment();
+        return Share(std::move(key), std::move(options),
+                     pending.options.byte_range, pending.future);
+      }
+    }
+    auto pair = PromiseFuturePair<ReadResult>::Make();
+    promise = std::move(pair.promise);
+    future = std::move(pair.future);
+    pending_reads.push_back(PendingRead{options, future});
+  }
+  coalesce_reads.Increment();
+  future.ExecuteWhenReady([self = IntrusivePtr<CoalesceKeyValueStore>(this),
+                           key](ReadyFuture<ReadResult> future) {
+    absl::MutexLock lock(&self->mutex_);
+    auto it = self->pending_reads_.find(key);
+    if (it == self->pending_reads_.end()) return;
+    auto& pending_reads = it->second;
+    for (size_t i = 0; i < pending_reads.size(); ++i) {
+      if (HaveSameSharedState(pending_reads[i].future, future)) {
+        pending_reads.erase(pending_reads.begin() + i);
+        break;
+      }
+    }
+    if (pending_reads.empty()) self->pending_reads_.erase(it);
+  });
+  LinkResult(std::move(promise),
+             base_.driver->Read(BaseKey(key), std::move(options)));
+  return future;
+}
+
+Future<ReadResult> CoalesceKeyValueStore::Share(
+    Key key, ReadOptions options, OptionalByteRangeRequest shared_byte_range,
+    Future<ReadResult> shared) {
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  shared.ExecuteWhenReady(
+      [self = IntrusivePtr<CoalesceKeyValueStore>(this), key = std::move(key),
+       options = std::move(options), shared_byte_range,
+       promise = std::move(promise)](ReadyFuture<ReadResult> shared) mutable {
+        const auto& result = shared.result();
+        if (!result.ok() && absl::IsOutOfRange(result.status()) &&
+            shared_byte_range != options.byte_range) {
+          // The shared byte range extends past the end of the value, but the
+          // requested byte range may not.
+          coalesce_reads.Increment();
+          LinkResult(std::move(promise),
+                     self->base_.driver->Read(self->BaseKey(key),
+                                              std::move(options)));
+          return;
+        }
+        promise.SetResult(GetSharedReadResult(result, shared_byte_range,
+                                              options.byte_range));
+      });
+  return std::move(future);
+}
+
+Future<kvstore::DriverPtr> CoalesceKeyValueStoreSpec::DoOpen() const {
+  return MapFutureValue(
+      InlineExecutor{},
+      [spec = IntrusivePtr<const CoalesceKeyValueStoreSpec>(this)](
+          kvstore::KvStore& base) -> Result<kvstore::DriverPtr> {
+        auto driver = internal::MakeIntrusivePtr<CoalesceKeyValueStore>();
+        driver->spec_ = spec->data_;
+        driver->base_ = std::move(base);
+        return driver;
+      },
+      kvstore::Open(data_.base));
+}
+
+}  // namespace
+}  // namespace tensorstore
+
+namespace tensorstore {
+namespace garbage_collection {
+template <>
+struct GarbageCollection<tensorstore::CoalesceKeyValueStore> {
+  static void Visit(GarbageCollectionVisitor& visitor,
+                    const tensorstore::CoalesceKeyValueStore& value) {
+    garbage_collection::GarbageCollectionVisit(visitor, *value.base_.driver);
+  }
+};
+}  // namespace garbage_collection
+}  // namespace tensorstore
+
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::CoalesceKeyValueStoreSpec>
+    registration;
+}  // namespace
@@ -0,0 +1,233 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string_view>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = tensorstore::kvstore;
+using ::tensorstore::Context;
+using ::tensorstore::KvStore;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::TimestampedStorageGeneration;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MockKeyValueStore;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+
+class CoalesceKeyValueStoreTest : public ::testing::Test {
+ protected:
+  CoalesceKeyValueStoreTest() {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto resource, context.GetResource<MockKeyValueStoreResource>());
+    mock = *resource;
+  }
+
+  KvStore Open(::nlohmann::json options = ::nlohmann::json::object_t()) {
+    options["driver"] = "coalesce";
+    options["base"] = {{"driver", "mock_key_value_store"}};
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(auto store,
+                                    kvstore::Open(options, context).result());
+    return store;
+  }
+
+  Context context = Context::Default();
+  MockKeyValueStore::MockPtr mock;
+};
+
+kvstore::ReadResult MakeValue(std::string_view value) {
+  return kvstore::ReadResult{
+      kvstore::ReadResult::kValue, absl::Cord(value),
+      TimestampedStorageGeneration{StorageGeneration::FromString("g"),
+                                   absl::Now()}};
+}
+
+kvstore::ReadOptions MakeOptions(OptionalByteRangeRequest byte_range = {}) {
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  options.byte_range = byte_range;
+  return options;
+}
+
+TEST(CoalesceKeyValueStoreBasicTest, Basic) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "coalesce"}, {"base", "memory://prefix/"}},
+                    context)
+          .result());
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+}
+
+TEST(CoalesceKeyValueStoreBasicTest, SpecRoundtrip) {
+  tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
+  options.full_spec = {{"driver", "coalesce"},
+                       {"base", {{"driver", "memory"}, {"path", "abc/"}}},
+                       {"staleness_tolerance", "1s"}};
+  options.check_data_persists = false;
+  tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
+}
+
+TEST_F(CoalesceKeyValueStoreTest, IdenticalReads) {
+  auto store = Open();
+  auto future1 = kvstore::Read(store, "x", MakeOptions());
+  auto future2 = kvstore::Read(store, "x", MakeOptions());
+  auto future3 = kvstore::Read(store, "y", MakeOptions());
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ("x", request.key);
+    request.promise.SetResult(MakeValue("abc"));
+  }
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ("y", request.key);
+    request.promise.SetResult(MakeValue("def"));
+  }
+  EXPECT_TRUE(mock->read_requests.empty());
+  EXPECT_THAT(future1.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(future2.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(future3.result(), MatchesKvsReadResult(absl::Cord("def")));
+
+  // Reads issued after completion are not shared.
+  auto future4 = kvstore::Read(store, "x", MakeOptions());
+  mock->read_requests.pop().promise.SetResult(MakeValue("ghi"));
+  EXPECT_THAT(future4.result(), MatchesKvsReadResult(absl::Cord("ghi")));
+}
+
+TEST_F(CoalesceKeyValueStoreTest, ContainedByteRanges) {
+  auto store = Open();
+  auto future1 = kvstore::Read(store, "x", MakeOptions({1}));
+  auto future2 = kvstore::Read(store, "x", MakeOptions({2, 4}));
+  auto future3 = kvstore::Read(store, "x", MakeOptions({2}));
+  auto future4 = kvstore::Read(store, "x", MakeOptions({3, 10}));
+  // Not contained in `[1, ...)`.
+  auto future5 = kvstore::Read(store, "x", MakeOptions({0, 2}));
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ(OptionalByteRangeRequest(1), request.options.byte_range);
+    request.promise.SetResult(MakeValue("bcdef"));
+  }
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ(OptionalByteRangeRequest(0, 2), request.options.byte_range);
+    request.promise.SetResult(MakeValue("ab"));
+  }
+  EXPECT_TRUE(mock->read_requests.empty());
+  EXPECT_THAT(future1.result(), MatchesKvsReadResult(absl::Cord("bcdef")));
+  EXPECT_THAT(future2.result(), MatchesKvsReadResult(absl::Cord("cd")));
+  EXPECT_THAT(future3.result(), MatchesKvsReadResult(absl::Cord("cdef")));
+  EXPECT_THAT(future4.result(), MatchesStatus(absl::StatusCode::kOutOfRange));
+  EXPECT_THAT(future5.result(), MatchesKvsReadResult(absl::Cord("ab")));
+}
+
+TEST_F(CoalesceKeyValueStoreTest, SharedReadOutOfRange) {
+  auto store = Open();
+  auto future1 = kvstore::Read(store, "x", MakeOptions({0, 10}));
+  auto future2 = kvstore::Read(store, "x", MakeOptions({0, 2}));
+  mock->read_requests.pop().promise.SetResult(
+      absl::OutOfRangeError("out of range"));
+  EXPECT_THAT(future1.result(), MatchesStatus(absl::StatusCode::kOutOfRange));
+  // The contained read is retried on its own.
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ(OptionalByteRangeRequest(0, 2), request.options.byte_range);
+    request.promise.SetResult(MakeValue("ab"));
+  }
+  EXPECT_THAT(future2.result(), MatchesKvsReadResult(absl::Cord("ab")));
+}
+
+TEST_F(CoalesceKeyValueStoreTest, SharedError) {
+  auto store = Open();
+  auto future1 = kvstore::Read(store, "x", MakeOptions());
+  auto future2 = kvstore::Read(store, "x", MakeOptions());
+  mock->read_requests.pop().promise.SetResult(
+      absl::UnavailableError("unavailable"));
+  EXPECT_TRUE(mock->read_requests.empty());
+  EXPECT_THAT(future1.result(), MatchesStatus(absl::StatusCode::kUnavailable));
+  EXPECT_THAT(future2.result(), MatchesStatus(absl::StatusCode::kUnavailable));
+}
+
+TEST_F(CoalesceKeyValueStoreTest, DifferentConditions) {
+  auto store = Open();
+  auto options = MakeOptions();
+  options.if_not_equal = StorageGeneration::FromString("g");
+  auto future1 = kvstore::Read(store, "x", MakeOptions());
+  auto future2 = kvstore::Read(store, "x", options);
+  auto future3 = kvstore::Read(store, "x", options);
+  mock->read_requests.pop().promise.SetResult(MakeValue("abc"));
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ(StorageGeneration::FromString("g"),
+              request.options.if_not_equal);
+    request.promise.SetResult(kvstore::ReadResult{TimestampedStorageGeneration{
+        StorageGeneration::FromString("g"), absl::Now()}});
+  }
+  EXPECT_TRUE(mock->read_requests.empty());
+  EXPECT_THAT(future1.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  for (auto* future : {&future2, &future3}) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result, future->result());
+    EXPECT_TRUE(result.aborted());
+  }
+}
+
+TEST_F(CoalesceKeyValueStoreTest, StalenessBound) {
+  auto store = Open();
+  // A read requiring more recent data than an in-progress read does not share
+  // it.
+  const absl::Time now = absl::Now();
+  auto options1 = MakeOptions();
+  options1.staleness_bound = now;
+  auto options2 = MakeOptions();
+  options2.staleness_bound = now + absl::Seconds(1);
+  auto future1 = kvstore::Read(store, "x", options1);
+  auto future2 = kvstore::Read(store, "x", options2);
+  // A read permitting stale data shares the first read.
+  auto future3 = kvstore::Read(store, "x", MakeOptions());
+  mock->read_requests.pop().promise.SetResult(MakeValue("abc"));
+  mock->read_requests.pop().promise.SetResult(MakeValue("def"));
+  EXPECT_TRUE(mock->read_requests.empty());
+  EXPECT_THAT(future1.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(future2.result(), MatchesKvsReadResult(absl::Cord("def")));
+  EXPECT_THAT(future3.result(), MatchesKvsReadResult(absl::Cord("abc")));
+}
+
+TEST_F(CoalesceKeyValueStoreTest, StalenessTolerance) {
+  auto store = Open({{"staleness_tolerance", "1h"}});
+  auto future1 = kvstore::Read(store, "x");
+  auto future2 = kvstore::Read(store, "x");
+  mock->read_requests.pop().promise.SetResult(MakeValue("abc"));
+  EXPECT_TRUE(mock->read_requests.empty());
+  EXPECT_THAT(future1.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(future2.result(), MatchesKvsReadResult(absl::Cord("abc")));
+}
+
+}  // namespace
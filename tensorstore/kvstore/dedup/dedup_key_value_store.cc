@@ -0,0 +1,494 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// Key-value store adapter that stores each distinct value only once.
+///
+/// Within the base kvstore, the value of each key is stored as an immutable
+/// "blob" under `blobs/<hex sha256 digest>`, and the key itself maps to the
+/// digest via an index entry stored under `index/<key>`.  The generation of a
+/// key is the generation of its index entry.
+///
+/// Since blobs are immutable and named by their content, a blob is written
+/// conditionally on it not already existing, and blobs may be cached in memory
+/// without revalidation.  The blob write is issued even if the blob is cached,
+/// since the blob may have been deleted by `CollectDedupGarbage`.
+
+#include "tensorstore/kvstore/dedup/dedup_key_value_store.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
+#include "absl/synchronization/mutex.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/digest/sha256.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/garbage_collection.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal::IntrusivePtr;
+
+auto& dedup_blob_writes = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/dedup/blob_writes",
+    "Number of new blobs written by the dedup kvstore");
+
+auto& dedup_blob_cache_hits = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/dedup/blob_cache_hits",
+    "Number of dedup kvstore reads that found the blob in memory");
+
+constexpr std::string_view kIndexPrefix = "index/";
+constexpr std::string_view kBlobPrefix = "blobs/";
+
+/// Length of the hex-encoded SHA-256 digest that identifies a blob.
+constexpr size_t kDigestHexLength = 64;
+
+struct DedupKeyValueStoreSpecData {
+  kvstore::Spec base;
+
+  /// Maximum total size of the blobs cached in memory.
+  size_t blob_cache_bytes_limit = 0;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.blob_cache_bytes_limit);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base", jb::Projection<&DedupKeyValueStoreSpecData::base>()),
+      jb::Member(
+          "blob_cache_bytes_limit",
+          jb::Projection<&DedupKeyValueStoreSpecData::blob_cache_bytes_limit>(
+              jb::DefaultValue([](auto* v) { *v = 0; }))));
+};
+
+class DedupKeyValueStoreSpec
+    : public internal_kvstore::RegisteredDriverSpec<
+          DedupKeyValueStoreSpec, DedupKeyValueStoreSpecData> {
+ public:
+  static constexpr char id[] = "dedup";
+  Future<kvstore::DriverPtr> DoOpen() const override;
+};
+
+/// In-memory LRU cache of blobs, keyed by digest.
+///
+/// Since blobs are immutable, cached blobs never need to be revalidated.
+class BlobCache {
+ public:
+  explicit BlobCache(size_t bytes_limit) : bytes_limit_(bytes_limit) {}
+
+  std::optional<absl::Cord> Find(std::string_view digest) {
+    if (bytes_limit_ == 0) return std::nullopt;
+    absl::MutexLock lock(&mutex_);
+    auto it = map_.find(digest);
+    if (it == map_.end()) return std::nullopt;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    dedup_blob_cache_hits.Increment();
+    return it->second->second;
+  }
+
+  void Erase(std::string_view digest) {
+    if (bytes_limit_ == 0) return;
+    absl::MutexLock lock(&mutex_);
+    auto it = map_.find(digest);
+    if (it == map_.end()) return;
+    auto list_it = it->second;
+    total_bytes_ -= list_it->second.size();
+    map_.erase(it);
+    lru_.erase(list_it);
+  }
+
+  void Insert(std::string digest, absl::Cord value) {
+    if (value.size() > bytes_limit_) return;
+    absl::MutexLock lock(&mutex_);
+    if (map_.contains(digest)) return;
+    total_bytes_ += value.size();
+    lru_.emplace_front(std::move(digest), std::move(value));
+    map_.emplace(lru_.front().first, lru_.begin());
+    while (total_bytes_ > bytes_limit_) {
+      auto& last = lru_.back();
+      total_bytes_ -= last.second.size();
+      map_.erase(last.first);
+      lru_.pop_back();
+    }
+  }
+
+ private:
+  using List = std::list<std::pair<std::string, absl::Cord>>;
+  const size_t bytes_limit_;
+  absl::Mutex mutex_;
+  List lru_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string_view, List::iterator> map_
+      ABSL_GUARDED_BY(mutex_);
+  size_t total_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+/// Returns the hex-encoded SHA-256 digest of `value`.
+std::string ComputeDigest(const absl::Cord& value) {
+  internal::SHA256Digester digester;
+  for (std::string_view chunk : value.Chunks()) {
+    digester.Write(chunk);
+  }
+  const auto digest = digester.Digest();
+  return absl::BytesToHexString(std::string_view(
+      reinterpret_cast<const char*>(digest.data()), digest.size()));
+}
+
+bool IsValidDigest(std::string_view digest) {
+  if (digest.size() != kDigestHexLength) return false;
+  for (char c : digest) {
+    if (!absl::ascii_isxdigit(c) || absl::ascii_isupper(c)) return false;
+  }
+  return true;
+}
+
+class DedupKeyValueStore
+    : public internal_kvstore::RegisteredDriver<DedupKeyValueStore,
+                                                DedupKeyValueStoreSpec> {
+ public:
+  explicit DedupKeyValueStore(size_t blob_cache_bytes_limit)
+      : blob_cache_(blob_cache_bytes_limit) {}
+
+  Future<ReadResult> Read(Key key, ReadOptions options) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override;
+
+  Future<const void> DeleteRange(KeyRange range) override {
+    return base_.driver->DeleteRange(
+        KeyRange::AddPrefix(IndexKey(""), std::move(range)));
+  }
+
+  void ListImpl(ListOptions options,
+                AnyFlowReceiver<absl::Status, Key> receiver) override {
+    const std::string prefix = IndexKey("");
+    options.range = KeyRange::AddPrefix(prefix, std::move(options.range));
+    options.strip_prefix_length += prefix.size();
+    base_.driver->ListImpl(std::move(options), std::move(receiver));
+  }
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(IndexKey(key));
+  }
+
+  absl::Status GetBoundSpecData(DedupKeyValueStoreSpecData& spec) const {
+    spec = spec_;
+    TENSORSTORE_ASSIGN_OR_RETURN(spec.base.driver,
+                                 base_.driver->GetBoundSpec());
+    spec.base.path = base_.path;
+    return absl::OkStatus();
+  }
+
+  std::string IndexKey(std::string_view key) const {
+    return tensorstore::StrCat(base_.path, kIndexPrefix, key);
+  }
+
+  std::string BlobKey(std::string_view digest) const {
+    return tensorstore::StrCat(base_.path, kBlobPrefix, digest);
+  }
+
+  /// Returns the blob with the specified digest, referenced by the index
+  /// entry for `key`.
+  Future<absl::Cord> ReadBlob(std::string_view key, std::string digest);
+
+  SpecData spec_;
+  kvstore::KvStore base_;
+  BlobCache blob_cache_;
+};
+
+Future<absl::Cord> DedupKeyValueStore::ReadBlob(std::string_view key,
+                                                std::string digest) {
+  if (auto value = blob_cache_.Find(digest)) {
+    return MakeReadyFuture<absl::Cord>(*std::move(value));
+  }
+  auto read_future = base_.driver->Read(BlobKey(digest));
+  return MapFutureValue(
+      InlineExecutor{},
+      [self = IntrusivePtr<DedupKeyValueStore>(this), key = std::string(key),
+       digest = std::move(digest)](
+          const ReadResult& read_result) -> Result<absl::Cord> {
+        if (!read_result.has_value()) {
+          return absl::DataLossError(tensorstore::StrCat(
+              "Blob ", digest, " referenced by ",
+              self->DescribeKey(key), " is missing"));
+        }
+        self->blob_cache_.Insert(std::move(digest), read_result.value);
+        return read_result.value;
+      },
+      std::move(read_future));
+}
+
+Future<kvstore::ReadResult> DedupKeyValueStore::Read(Key key,
+                                                     ReadOptions options) {
+  const auto byte_range = options.byte_range;
+  options.byte_range = {};
+  auto index_future = base_.driver->Read(IndexKey(key), std::move(options));
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  LinkValue(
+      [self = IntrusivePtr<DedupKeyValueStore>(this), key = std::move(key),
+       byte_range](Promise<ReadResult> promise,
+                   ReadyFuture<ReadResult> index_future) {
+        auto& index_result = index_future.value();
+        if (!index_result.has_value()) {
+          // Missing or aborted due to the generation conditions.
+          promise.SetResult(std::move(index_result));
+          return;
+        }
+        std::string digest(index_result.value);
+        if (!IsValidDigest(digest)) {
+          promise.SetResult(absl::DataLossError(tensorstore::StrCat(
+              "Invalid index entry for ", self->DescribeKey(key))));
+          return;
+        }
+        LinkValue(
+            [stamp = std::move(index_result.stamp), byte_range](
+                Promise<ReadResult> promise,
+                ReadyFuture<absl::Cord> blob_future) mutable {
+              auto& blob = blob_future.value();
+              TENSORSTORE_ASSIGN_OR_RETURN(
+                  auto validated_byte_range, byte_range.Validate(blob.size()),
+                  static_cast<void>(promise.SetResult(_)));
+              promise.SetResult(std::in_place, ReadResult::kValue,
+                                internal::GetSubCord(blob,
+                                                     validated_byte_range),
+                                std::move(stamp));
+            },
+            std::move(promise), self->ReadBlob(key, std::move(digest)));
+      },
+      std::move(promise), std::move(index_future));
+  return std::move(future);
+}
+
+Future<TimestampedStorageGeneration> DedupKeyValueStore::Write(
+    Key key, std::optional<Value> value, WriteOptions options) {
+  if (!value) {
+    return base_.driver->Write(IndexKey(key), std::nullopt,
+                               std::move(options));
+  }
+  std::string digest = ComputeDigest(*value);
+  auto write_index = [self = IntrusivePtr<DedupKeyValueStore>(this),
+                      key = std::move(key), digest,
+                      options = std::move(options)]() mutable {
+    return self->base_.driver->Write(self->IndexKey(key), absl::Cord(digest),
+                                     std::move(options));
+  };
+  // Only write the blob if it does not already exist.  If the condition fails,
+  // an identical blob is already stored.
+  kvstore::WriteOptions blob_options;
+  blob_options.if_equal = StorageGeneration::NoValue();
+  auto blob_future =
+      base_.driver->Write(BlobKey(digest), *value, std::move(blob_options));
+  auto [promise, future] =
+      PromiseFuturePair<TimestampedStorageGeneration>::Make();
+  LinkValue(
+      [self = IntrusivePtr<DedupKeyValueStore>(this), digest,
+       value = *std::move(value), write_index = std::move(write_index)](
+          Promise<TimestampedStorageGeneration> promise,
+          ReadyFuture<TimestampedStorageGeneration> blob_future) mutable {
+        if (!StorageGeneration::IsUnknown(blob_future.value().generation)) {
+          dedup_blob_writes.Increment();
+        }
+        self->blob_cache_.Insert(std::move(digest), std::move(value));
+        LinkResult(std::move(promise), write_index());
+      },
+      std::move(promise), std::move(blob_future));
+  return std::move(future);
+}
+
+Future<kvstore::DriverPtr> DedupKeyValueStoreSpec::DoOpen() const {
+  return MapFutureValue(
+      InlineExecutor{},
+      [spec = IntrusivePtr<const DedupKeyValueStoreSpec>(this)](
+          kvstore::KvStore& base) -> Result<kvstore::DriverPtr> {
+        auto driver = internal::MakeIntrusivePtr<DedupKeyValueStore>(
+            spec->data_.blob_cache_bytes_limit);
+        driver->spec_ = spec->data_;
+        driver->base_ = std::move(base);
+        return driver;
+      },
+      kvstore::Open(data_.base));
+}
+
+/// Local state for the asynchronous operation initiated by
+/// `CollectDedupGarbage`.
+struct GarbageCollectionState
+    : public internal::AtomicReferenceCount<GarbageCollectionState> {
+  IntrusivePtr<DedupKeyValueStore> driver;
+
+  absl::Mutex mutex;
+  absl::flat_hash_set<std::string> referenced ABSL_GUARDED_BY(mutex);
+
+  std::atomic<size_t> num_deleted{0};
+  Promise<size_t> promise;
+
+  ~GarbageCollectionState() {
+    auto& result = promise.raw_result();
+    if (result.ok()) *result = num_deleted.load();
+  }
+};
+
+/// Deletes the blobs that are not in `state->referenced`.
+void DeleteUnreferencedBlobs(IntrusivePtr<GarbageCollectionState> state) {
+  auto& driver = *state->driver;
+  kvstore::ListOptions list_options;
+  list_options.range = KeyRange::Prefix(driver.BlobKey(""));
+  list_options.strip_prefix_length = list_options.range.inclusive_min.size();
+  kvstore::ListFuture(driver.base_.driver.get(), std::move(list_options))
+      .ExecuteWhenReady([state = std::move(state)](
+                            ReadyFuture<std::vector<kvstore::Key>> future) {
+        if (!future.result().ok()) {
+          SetDeferredResult(state->promise, future.result().status());
+          return;
+        }
+        for (auto& digest : future.value()) {
+          {
+            absl::MutexLock lock(&state->mutex);
+            if (state->referenced.contains(digest)) continue;
+          }
+          auto& driver = *state->driver;
+          // Evict the blob so that it is not assumed to exist by reads.
+          driver.blob_cache_.Erase(digest);
+          driver.base_.driver->Write(driver.BlobKey(digest), std::nullopt)
+              .ExecuteWhenReady(
+                  [state](ReadyFuture<TimestampedStorageGeneration> future) {
+                    if (!future.result().ok()) {
+                      SetDeferredResult(state->promise,
+                                        future.result().status());
+                      return;
+                    }
+                    ++state->num_deleted;
+                  });
+        }
+      });
+}
+
+/// Collects the digests referenced by the index entries, then invokes
+/// `DeleteUnreferencedBlobs` once all index entries have been read.
+///
+/// The index entries are read while holding a reference to `mark_state`,
+/// whose destructor starts the deletion phase.
+struct MarkState : public internal::AtomicReferenceCount<MarkState> {
+  IntrusivePtr<GarbageCollectionState> state;
+  std::atomic<bool> failed{false};
+
+  ~MarkState() {
+    if (failed) return;
+    DeleteUnreferencedBlobs(std::move(state));
+  }
+};
+
+}  // namespace
+
+Future<size_t> CollectDedupGarbage(const KvStore& store) {
+  if (!store.driver) {
+    return absl::InvalidArgumentError("Invalid kvstore");
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto spec, store.driver->GetBoundSpec());
+  if (spec->driver_id() != DedupKeyValueStoreSpec::id) {
+    return absl::InvalidArgumentError(
+        tensorstore::StrCat("Garbage collection requires the \"",
+                            DedupKeyValueStoreSpec::id, "\" kvstore driver"));
+  }
+  IntrusivePtr<GarbageCollectionState> state(new GarbageCollectionState);
+  state->driver.reset(static_cast<DedupKeyValueStore*>(store.driver.get()));
+  auto [promise, future] = PromiseFuturePair<size_t>::Make(size_t(0));
+  state->promise = std::move(promise);
+  auto& driver = *state->driver;
+  kvstore::ListOptions list_options;
+  list_options.range = KeyRange::Prefix(driver.IndexKey(""));
+  list_options.strip_prefix_length = list_options.range.inclusive_min.size();
+  kvstore::ListFuture(driver.base_.driver.get(), std::move(list_options))
+      .ExecuteWhenReady([state = std::move(state)](
+                            ReadyFuture<std::vector<kvstore::Key>> future) {
+        if (!future.result().ok()) {
+          SetDeferredResult(state->promise, future.result().status());
+          return;
+        }
+        IntrusivePtr<MarkState> mark_state(new MarkState);
+        mark_state->state = state;
+        for (const auto& key : future.value()) {
+          state->driver->base_.driver->Read(state->driver->IndexKey(key))
+              .ExecuteWhenReady([mark_state](ReadyFuture<kvstore::ReadResult>
+                                                 future) {
+                auto& state = *mark_state->state;
+                if (!future.result().ok()) {
+                  mark_state->failed = true;
+                  SetDeferredResult(state.promise, future.result().status());
+                  return;
+                }
+                if (!future.value().has_value()) return;
+                absl::MutexLock lock(&state.mutex);
+                state.referenced.insert(std::string(future.value().value));
+              });
+        }
+      });
+  return std::move(future);
+}
+
+}  // namespace tensorstore
+
+namespace tensorstore {
+namespace garbage_collection {
+template <>
+struct GarbageCollection<tensorstore::DedupKeyValueStore> {
+  static void Visit(GarbageCollectionVisitor& visitor,
+                    const tensorstore::DedupKeyValueStore& value) {
+    garbage_collection::GarbageCollectionVisit(visitor, *value.base_.driver);
+  }
+};
+}  // namespace garbage_collection
+}  // namespace tensorstore
+
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::DedupKeyValueStoreSpec>
+    registration;
+}  // namespace
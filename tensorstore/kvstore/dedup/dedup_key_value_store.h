@@ -0,0 +1,45 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_DEDUP_DEDUP_KEY_VALUE_STORE_H_
+#define TENSORSTORE_KVSTORE_DEDUP_DEDUP_KEY_VALUE_STORE_H_
+
+/// \file
+/// Key-value store adapter that stores each distinct value once, under its
+/// SHA-256 digest.
+
+#include <stddef.h>
+
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+
+/// Deletes the blobs of a ``"dedup"`` kvstore that are not referenced by any
+/// key.
+///
+/// Blobs become unreferenced when keys are overwritten or deleted.  This must
+/// not be called concurrently with writes to `store`, since a blob written by
+/// a concurrent write may be deleted before the key referencing it is written.
+///
+/// \param store A kvstore opened with the ``"dedup"`` driver.  The path is
+///     ignored; garbage collection always applies to the entire kvstore.
+/// \returns A future for the number of blobs deleted.
+/// \error `absl::StatusCode::kInvalidArgument` if `store` does not use the
+///     ``"dedup"`` driver.
+Future<size_t> CollectDedupGarbage(const KvStore& store);
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_DEDUP_DEDUP_KEY_VALUE_STORE_H_
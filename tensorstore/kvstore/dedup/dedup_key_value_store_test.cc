@@ -0,0 +1,227 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/dedup/dedup_key_value_store.h"
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/test_util.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace {
+
+namespace kvstore = tensorstore::kvstore;
+using ::tensorstore::Context;
+using ::tensorstore::KvStore;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::testing::Optional;
+using ::testing::UnorderedElementsAre;
+
+// SHA-256 digests of "a" and "b".
+constexpr char kDigestA[] =
+    "ca978112ca1bbdcafac231b39a23dc4da786eff8147c4e72b9807785afee48bb";
+constexpr char kDigestB[] =
+    "3e23e8160039594a33894f6564e1b1348bbd7a0088d42c4acb73eeaed59c009d";
+
+KvStore OpenDedup(const Context& context, ::nlohmann::json base,
+                  size_t blob_cache_bytes_limit = 0) {
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "dedup"},
+                     {"base", base},
+                     {"blob_cache_bytes_limit", blob_cache_bytes_limit}},
+                    context)
+          .result());
+  return store;
+}
+
+TEST(DedupKeyValueStoreTest, Basic) {
+  auto context = Context::Default();
+  auto store = OpenDedup(context, "memory://prefix/");
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+}
+
+TEST(DedupKeyValueStoreTest, BasicWithBlobCache) {
+  auto context = Context::Default();
+  auto store = OpenDedup(context, "memory://prefix/", 1 << 20);
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+}
+
+TEST(DedupKeyValueStoreTest, DeleteRange) {
+  auto context = Context::Default();
+  auto store = OpenDedup(context, "memory://prefix/");
+  tensorstore::internal::TestKeyValueStoreDeleteRange(store);
+}
+
+TEST(DedupKeyValueStoreTest, File) {
+  tensorstore::internal::ScopedTemporaryDirectory tempdir;
+  auto context = Context::Default();
+  auto store = OpenDedup(
+      context, {{"driver", "file"}, {"path", tempdir.path() + "/"}});
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+}
+
+TEST(DedupKeyValueStoreTest, StoresIdenticalValuesOnce) {
+  auto context = Context::Default();
+  auto store = OpenDedup(context, "memory://prefix/");
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://prefix/", context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "x", absl::Cord("a")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "y", absl::Cord("a")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "z", absl::Cord("b")));
+  EXPECT_THAT(kvstore::ListFuture(base).result(),
+              Optional(UnorderedElementsAre(
+                  tensorstore::StrCat("blobs/", kDigestA),
+                  tensorstore::StrCat("blobs/", kDigestB), "index/x",
+                  "index/y", "index/z")));
+  EXPECT_THAT(kvstore::Read(base, "index/x").result(),
+              MatchesKvsReadResult(absl::Cord(kDigestA)));
+  EXPECT_THAT(kvstore::Read(store, "y").result(),
+              MatchesKvsReadResult(absl::Cord("a")));
+  EXPECT_THAT(kvstore::ListFuture(store).result(),
+              Optional(UnorderedElementsAre("x", "y", "z")));
+}
+
+TEST(DedupKeyValueStoreTest, BlobCache) {
+  auto context = Context::Default();
+  auto store = OpenDedup(context, "memory://", 1 << 20);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://", context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "x", absl::Cord("a")));
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              MatchesKvsReadResult(absl::Cord("a")));
+
+  // A cached blob does not prevent the blob from being written.
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Delete(base, tensorstore::StrCat("blobs/", kDigestA)));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "y", absl::Cord("a")));
+  EXPECT_THAT(
+      kvstore::Read(base, tensorstore::StrCat("blobs/", kDigestA)).result(),
+      MatchesKvsReadResult(absl::Cord("a")));
+  auto uncached_store = OpenDedup(context, "memory://");
+  EXPECT_THAT(kvstore::Read(uncached_store, "y").result(),
+              MatchesKvsReadResult(absl::Cord("a")));
+
+  // Without the cache, a missing blob is detected.
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Delete(base, tensorstore::StrCat("blobs/", kDigestA)));
+  EXPECT_THAT(kvstore::Read(uncached_store, "y").result(),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            "Blob .* referenced by .* is missing"));
+}
+
+TEST(DedupKeyValueStoreTest, WriteAfterCollectGarbage) {
+  auto context = Context::Default();
+  auto store = OpenDedup(context, "memory://", 1 << 20);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://", context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "x", absl::Cord("a")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "x", absl::Cord("b")));
+  EXPECT_THAT(tensorstore::CollectDedupGarbage(store).result(), Optional(1));
+
+  // The blob deleted by garbage collection is written again.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "y", absl::Cord("a")));
+  EXPECT_THAT(kvstore::ListFuture(base).result(),
+              Optional(UnorderedElementsAre(
+                  tensorstore::StrCat("blobs/", kDigestA),
+                  tensorstore::StrCat("blobs/", kDigestB), "index/x",
+                  "index/y")));
+  auto uncached_store = OpenDedup(context, "memory://");
+  EXPECT_THAT(kvstore::Read(uncached_store, "y").result(),
+              MatchesKvsReadResult(absl::Cord("a")));
+  EXPECT_THAT(kvstore::Read(store, "y").result(),
+              MatchesKvsReadResult(absl::Cord("a")));
+}
+
+TEST(DedupKeyValueStoreTest, InvalidIndexEntry) {
+  auto context = Context::Default();
+  auto store = OpenDedup(context, "memory://");
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://", context).result());
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(base, "index/x", absl::Cord("not a digest")));
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            "Invalid index entry for .*"));
+}
+
+TEST(DedupKeyValueStoreTest, CollectGarbage) {
+  auto context = Context::Default();
+  auto store = OpenDedup(context, "memory://prefix/");
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://prefix/", context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "x", absl::Cord("a")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "y", absl::Cord("a")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "z", absl::Cord("b")));
+  EXPECT_THAT(tensorstore::CollectDedupGarbage(store).result(), Optional(0));
+
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(store, "x"));
+  EXPECT_THAT(tensorstore::CollectDedupGarbage(store).result(), Optional(0));
+
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "y", absl::Cord("b")));
+  EXPECT_THAT(tensorstore::CollectDedupGarbage(store).result(), Optional(1));
+  EXPECT_THAT(kvstore::ListFuture(base).result(),
+              Optional(UnorderedElementsAre(
+                  tensorstore::StrCat("blobs/", kDigestB), "index/y",
+                  "index/z")));
+  EXPECT_THAT(kvstore::Read(store, "y").result(),
+              MatchesKvsReadResult(absl::Cord("b")));
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              MatchesKvsReadResultNotFound());
+}
+
+TEST(DedupKeyValueStoreTest, CollectGarbageInvalidDriver) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://", context).result());
+  EXPECT_THAT(tensorstore::CollectDedupGarbage(base).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Garbage collection requires the \"dedup\" "
+                            "kvstore driver"));
+}
+
+TEST(DedupKeyValueStoreTest, SpecRoundtrip) {
+  tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
+  options.full_spec = {{"driver", "dedup"},
+                       {"base", {{"driver", "memory"}, {"path", "abc/"}}},
+                       {"blob_cache_bytes_limit", 1000}};
+  options.check_data_persists = false;
+  tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
+}
+
+TEST(DedupKeyValueStoreTest, InvalidSpec) {
+  auto context = Context::Default();
+  EXPECT_THAT(kvstore::Open({{"driver", "dedup"},
+                             {"base", "memory://"},
+                             {"blob_cache_bytes_limit", -1}},
+                            context)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
@@ -17,6 +17,7 @@
 
 #include "absl/status/status.h"
 #include "tensorstore/internal/context_binding.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
@@ -107,6 +108,18 @@ class DriverSpec : public internal::AtomicReferenceCount<DriverSpec> {
   ContextBindingState context_binding_state_ = ContextBindingState::unknown;
 };
 
+/// Result of `Driver::ReadStreaming`.
+struct StreamingReadResult {
+  /// Specifies the state of the key and its generation.  The `value` member is
+  /// always empty; if `read_result.has_value()`, the value is instead
+  /// delivered incrementally via `value`.
+  ReadResult read_result;
+
+  /// Receives the value.  Non-null if, and only if,
+  /// `read_result.has_value()`.
+  internal::CordStreamPtr value;
+};
+
 /// Abstract base class representing a key-value store.
 ///
 /// Support for different storage systems is provided by individual key-value
@@ -143,6 +156,25 @@ class Driver {
   ///     with an error.
   virtual Future<ReadResult> Read(Key key, ReadOptions options = {});
 
+  /// Attempts to read the specified key, delivering the value incrementally.
+  ///
+  /// The returned future may become ready as soon as the state and generation
+  /// of the key are known, before the value has been fully transferred.  This
+  /// allows the consumer, e.g. a decompressor, to begin processing the value
+  /// while it is still being transferred.
+  ///
+  /// The default implementation calls `Read` and delivers the complete value
+  /// at once; drivers that receive the value incrementally, such as the HTTP
+  /// and GCS drivers, override this.
+  ///
+  /// \param key The key to read.
+  /// \param options Specifies options for reading.
+  /// \returns A Future that resolves once the read has started successfully,
+  ///     or with an error.  Errors encountered while transferring the value
+  ///     are instead reported by the `CordStream`.
+  virtual Future<StreamingReadResult> ReadStreaming(Key key,
+                                                    ReadOptions options = {});
+
   /// Performs an optionally-conditional write.
   ///
   /// Atomically updates or deletes the value stored for `key` subject to the
@@ -260,6 +292,17 @@ class Driver {
   /// automatically by `internal_kvstore::RegisteredDriver` in `registry.h`.
   virtual void EncodeCacheKey(std::string* out) const;
 
+  /// Returns the identifier of the driver, e.g. ``"file"`` or ``"gcs"``.
+  ///
+  /// Unlike `GetBoundSpec`, this is cheap enough to call for every request.
+  /// The returned string is null-terminated and has static storage duration.
+  ///
+  /// The default implementation returns ``"unknown"``.  For drivers that
+  /// support a JSON representation, this is defined automatically by
+  /// `internal_kvstore::RegisteredDriver` in `registry.h` to return the
+  /// registered identifier.
+  virtual std::string_view driver_id() const;
+
   /// Returns a human-readable description of a key for use in error messages.
   ///
   /// By default, returns `QuoteString(key)`.
@@ -109,6 +109,7 @@
 #include "tensorstore/internal/flat_cord_builder.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/mapped_memory.h"
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/os_error_code.h"
 #include "tensorstore/internal/path.h"
@@ -176,6 +177,10 @@ auto& file_bytes_read = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/kvstore/file/bytes_read",
     "Bytes read by the file kvstore driver");
 
+auto& file_bytes_mapped = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/file/bytes_mapped",
+    "Bytes memory-mapped by the file kvstore driver");
+
 auto& file_bytes_written = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/kvstore/file/bytes_written",
     "Bytes written by the file kvstore driver");
@@ -335,10 +340,30 @@ Result<UniqueFileDescriptor> OpenValueFile(const char* path,
   return fd;
 }
 
+/// Returns a cord that references `byte_range` of `fd` by memory-mapping it,
+/// or `std::nullopt` if the file cannot be mapped.
+std::optional<absl::Cord> MapFileRange(FileDescriptor fd,
+                                       ByteRange byte_range) {
+  const uint64_t alignment = internal_file_util::GetMapFileAlignment();
+  const uint64_t map_offset =
+      byte_range.inclusive_min - byte_range.inclusive_min % alignment;
+  const size_t map_size = byte_range.exclusive_max - map_offset;
+  const void* data = internal_file_util::MapFileForReading(
+      fd, map_size, static_cast<int64_t>(map_offset));
+  if (!data) return std::nullopt;
+  file_bytes_mapped.IncrementBy(byte_range.size());
+  return internal::MakeCordFromMappedMemory(
+      std::string_view(static_cast<const char*>(data) +
+                           (byte_range.inclusive_min - map_offset),
+                       byte_range.size()),
+      [data, map_size] { internal_file_util::UnmapFile(data, map_size); });
+}
+
 /// Implements `FileKeyValueStore::Read`.
 struct ReadTask {
   std::string full_path;
   kvstore::ReadOptions options;
+  bool memory_map;
 
   Result<ReadResult> operator()() const {
     ReadResult read_result;
@@ -359,6 +384,13 @@ struct ReadTask {
     TENSORSTORE_ASSIGN_OR_RETURN(auto byte_range,
                                  options.byte_range.Validate(size));
     read_result.state = ReadResult::kValue;
+    if (memory_map && byte_range.size() > 0) {
+      // Falls back to reading if the file cannot be mapped.
+      if (auto value = MapFileRange(fd.get(), byte_range)) {
+        read_result.value = *std::move(value);
+        return read_result;
+      }
+    }
     internal::FlatCordBuilder buffer(byte_range.size());
     std::size_t offset = 0;
     while (offset < buffer.size()) {
@@ -763,8 +795,12 @@ struct ListTask {
 struct FileKeyValueStoreSpecData {
   Context::Resource<internal::FileIoConcurrencyResource> file_io_concurrency;
 
+  /// Specifies whether values are read by memory-mapping the file rather than
+  /// copying it, so that they are backed by the page cache.
+  bool memory_map = false;
+
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
-    return f(x.file_io_concurrency);
+    return f(x.file_io_concurrency, x.memory_map);
   };
 
   // TODO(jbms): Storing a UNIX path as a JSON string presents a challenge
@@ -782,9 +818,13 @@ struct FileKeyValueStoreSpecData {
   // including base64-encoding, or using NUL as an escape sequence (taking
   // advantage of the fact that valid paths on all operating systems
   // cannot contain NUL characters).
-  constexpr static auto default_json_binder = jb::Object(jb::Member(
-      internal::FileIoConcurrencyResource::id,
-      jb::Projection<&FileKeyValueStoreSpecData::file_io_concurrency>()));
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member(
+          internal::FileIoConcurrencyResource::id,
+          jb::Projection<&FileKeyValueStoreSpecData::file_io_concurrency>()),
+      jb::Member("memory_map",
+                 jb::Projection<&FileKeyValueStoreSpecData::memory_map>(
+                     jb::DefaultValue([](auto* x) { *x = false; }))));
 };
 
 class FileKeyValueStoreSpec
@@ -807,7 +847,8 @@ class FileKeyValueStore
   Future<ReadResult> Read(Key key, ReadOptions options) override {
     file_read.Increment();
     TENSORSTORE_RETURN_IF_ERROR(ValidateKey(key));
-    return MapFuture(executor(), ReadTask{std::move(key), std::move(options)});
+    return MapFuture(executor(), ReadTask{std::move(key), std::move(options),
+                                          spec_.memory_map});
   }
 
   Future<TimestampedStorageGeneration> Write(Key key,
@@ -31,8 +31,10 @@
 #include <nlohmann/json.hpp>
 #include "tensorstore/context.h"
 #include "tensorstore/internal/file_io_concurrency_resource.h"
+#include "tensorstore/internal/mapped_memory.h"
 #include "tensorstore/internal/test_util.h"
 #include "tensorstore/internal/thread.h"
+#include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generation_testutil.h"
 #include "tensorstore/kvstore/key_range.h"
@@ -77,6 +79,51 @@ TEST(FileKeyValueStoreTest, Basic) {
   tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
 }
 
+TEST(FileKeyValueStoreTest, MemoryMap) {
+  tensorstore::internal::ScopedTemporaryDirectory tempdir;
+  std::string root = tempdir.path() + "/root";
+  auto store = kvstore::Open({{"driver", "file"},
+                              {"path", root + "/"},
+                              {"memory_map", true}})
+                   .value();
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+}
+
+TEST(FileKeyValueStoreTest, MemoryMapRead) {
+  tensorstore::internal::ScopedTemporaryDirectory tempdir;
+  std::string root = tempdir.path() + "/root";
+  auto store = kvstore::Open({{"driver", "file"},
+                              {"path", root + "/"},
+                              {"memory_map", true}})
+                   .value();
+  std::string value(10000, 'x');
+  for (size_t i = 0; i < value.size(); ++i) value[i] = 'a' + i % 26;
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord(value)));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result,
+                                   kvstore::Read(store, "a").result());
+  EXPECT_EQ(value, result.value);
+#ifndef _WIN32
+  auto flat = result.value.TryFlat();
+  ASSERT_TRUE(flat);
+  EXPECT_TRUE(tensorstore::internal::IsMappedMemory(flat->data()));
+  EXPECT_TRUE(tensorstore::internal::IsMappedMemoryOwner(
+      tensorstore::internal::MakeSharedCord(result.value)));
+#endif
+
+  // Byte ranges that do not start at a page boundary.
+  kvstore::ReadOptions options;
+  options.byte_range = tensorstore::OptionalByteRangeRequest(5000, 5010);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      result, kvstore::Read(store, "a", std::move(options)).result());
+  EXPECT_EQ(value.substr(5000, 10), result.value);
+
+  // The mapping remains valid after the file is replaced.
+  auto old_value = std::move(result.value);
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("new")));
+  EXPECT_EQ(value.substr(5000, 10), old_value);
+}
+
 TEST(FileKeyValueStoreTest, InvalidKey) {
   tensorstore::internal::ScopedTemporaryDirectory tempdir;
   std::string root = tempdir.path() + "/root";
@@ -493,6 +540,15 @@ TEST(FileKeyValueStoreTest, SpecRoundtrip) {
   tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
 }
 
+TEST(FileKeyValueStoreTest, SpecRoundtripMemoryMap) {
+  tensorstore::internal::ScopedTemporaryDirectory tempdir;
+  std::string root = tempdir.path() + "/root";
+  tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
+  options.full_spec = {
+      {"driver", "file"}, {"path", root}, {"memory_map", true}};
+  tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
+}
+
 TEST(FileKeyValueStoreTest, InvalidSpec) {
   tensorstore::internal::ScopedTemporaryDirectory tempdir;
   std::string root = tempdir.path() + "/root";
@@ -34,6 +34,7 @@
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -161,6 +162,36 @@ inline std::ptrdiff_t ReadFromFile(FileDescriptor fd, void* buf,
   return ::pread(fd, buf, count, static_cast<off_t>(offset));
 }
 
+/// Returns the alignment required of the `offset` passed to
+/// `MapFileForReading`.
+inline std::size_t GetMapFileAlignment() {
+  return static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+/// Maps a range of an open file into memory for reading.
+///
+/// The mapping remains valid after `fd` is closed, and after the file is
+/// renamed or deleted.  Accessing the mapping after the file is truncated by
+/// another writer raises `SIGBUS`.
+///
+/// \param fd Open file descriptor.
+/// \param count Number of bytes to map.  Must be non-zero.
+/// \param offset Byte offset within file at which to start mapping.  Must be a
+///     multiple of `GetMapFileAlignment()`.
+/// \returns Pointer to the mapped memory on success, or `nullptr` on error (in
+///     which case `GetLastErrorCode()` retrieves the error).
+inline const void* MapFileForReading(FileDescriptor fd, std::size_t count,
+                                     std::int64_t offset) {
+  void* data = ::mmap(nullptr, count, PROT_READ, MAP_SHARED, fd,
+                      static_cast<off_t>(offset));
+  return data == MAP_FAILED ? nullptr : data;
+}
+
+/// Unmaps memory returned by `MapFileForReading`.
+inline void UnmapFile(const void* data, std::size_t count) {
+  ::munmap(const_cast<void*>(data), count);
+}
+
 /// Writes to an open file.
 ///
 /// \param fd Open file descriptor.
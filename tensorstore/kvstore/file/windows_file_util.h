@@ -91,6 +91,18 @@ UniqueFileDescriptor OpenFileForWriting(std::string_view path);
 
 std::ptrdiff_t ReadFromFile(FileDescriptor fd, void* buf, std::size_t count,
                             std::int64_t offset);
+
+inline std::size_t GetMapFileAlignment() { return 1; }
+
+/// Memory mapping is not supported, since a file that is mapped cannot be
+/// replaced by `RenameOpenFile`.  Callers fall back to `ReadFromFile`.
+inline const void* MapFileForReading(FileDescriptor fd, std::size_t count,
+                                     std::int64_t offset) {
+  ::SetLastError(ERROR_NOT_SUPPORTED);
+  return nullptr;
+}
+
+inline void UnmapFile(const void* data, std::size_t count) {}
 std::ptrdiff_t WriteToFile(FileDescriptor fd, const void* buf,
                            std::size_t count);
 
@@ -20,6 +20,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -34,6 +35,7 @@
 #include <nlohmann/json.hpp>
 #include "tensorstore/context.h"
 #include "tensorstore/internal/concurrency_resource.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/env.h"
 #include "tensorstore/internal/http/curl_transport.h"
@@ -59,6 +61,7 @@
 #include "tensorstore/kvstore/gcs/rate_limiter.h"
 #include "tensorstore/kvstore/gcs/validate.h"
 #include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/parallel_read.h"
 #include "tensorstore/kvstore/registry.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/kvstore/url_registry.h"
@@ -92,7 +95,10 @@ using ::tensorstore::internal::ScheduleAt;
 using ::tensorstore::internal_http::HttpRequest;
 using ::tensorstore::internal_http::HttpRequestBuilder;
 using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::HttpStreamingResponse;
 using ::tensorstore::internal_http::HttpTransport;
+using ::tensorstore::internal_kvstore::ParallelReadOptions;
+using ::tensorstore::internal_kvstore::ReadPartResult;
 using ::tensorstore::internal_storage_gcs::GcsConcurrencyResource;
 using ::tensorstore::internal_storage_gcs::GcsRateLimiterResource;
 using ::tensorstore::internal_storage_gcs::GcsRequestRetries;
@@ -247,9 +253,15 @@ struct GcsKeyValueStoreSpecData {
   Context::Resource<GcsRequestRetries> retries;
   Context::Resource<DataCopyConcurrencyResource> data_copy_concurrency;
 
+  /// Values larger than this are read as multiple concurrent byte range
+  /// requests.  If `0`, each read is a single request.
+  uint64_t read_part_size = 0;
+  size_t read_part_concurrency = 4;
+
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.bucket, x.request_concurrency, x.rate_limiter, x.user_project,
-             x.retries, x.data_copy_concurrency);
+             x.retries, x.data_copy_concurrency, x.read_part_size,
+             x.read_part_concurrency);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -280,7 +292,15 @@ struct GcsKeyValueStoreSpecData {
                  jb::Projection<&GcsKeyValueStoreSpecData::retries>()),
       jb::Member(DataCopyConcurrencyResource::id,
                  jb::Projection<
-                     &GcsKeyValueStoreSpecData::data_copy_concurrency>()) /**/
+                     &GcsKeyValueStoreSpecData::data_copy_concurrency>()),
+      jb::Member("read_part_size",
+                 jb::Projection<&GcsKeyValueStoreSpecData::read_part_size>(
+                     jb::DefaultValue([](auto* v) { *v = 0; }))),
+      jb::Member(
+          "read_part_concurrency",
+          jb::Projection<&GcsKeyValueStoreSpecData::read_part_concurrency>(
+              jb::DefaultValue([](auto* v) { *v = 4; },
+                               jb::Integer<size_t>(1)))) /**/
   );
 };
 
@@ -321,6 +341,9 @@ class GcsKeyValueStore
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
 
+  Future<kvstore::StreamingReadResult> ReadStreaming(
+      Key key, ReadOptions options) override;
+
   Future<TimestampedStorageGeneration> Write(Key key,
                                              std::optional<Value> value,
                                              WriteOptions options) override;
@@ -370,6 +393,15 @@ class GcsKeyValueStore
 
   RateLimiter& admission_queue() { return *spec_.request_concurrency->queue; }
 
+  ParallelReadOptions parallel_read_options() const {
+    return {spec_.read_part_size, spec_.read_part_concurrency};
+  }
+
+  /// Issues a single read request for `resource`.  See
+  /// `internal_kvstore::ReadPartFunction` for the meaning of `partial`.
+  Future<ReadPartResult> ReadPart(std::string resource, ReadOptions options,
+                                  bool partial);
+
   absl::Status GetBoundSpecData(SpecData& spec) const {
     spec = spec_;
     return absl::OkStatus();
@@ -390,6 +422,14 @@ class GcsKeyValueStore
     return transport_->IssueRequest(request, payload);
   }
 
+  Future<HttpStreamingResponse> IssueStreamingRequest(
+      const char* description, const HttpRequest& request) {
+#ifdef TENSORSTORE_INTERNAL_GCS_LOG_REQUESTS
+    ABSL_LOG(INFO) << description << " " << request.url() << " (streaming)";
+#endif
+    return transport_->IssueStreamingRequest(request, {});
+  }
+
   // Apply default backoff/retry logic to the task.
   // Returns whether the task will be retried. On false, max retries have
   // been met or exceeded.  On true, `task->Retry()` will be scheduled to run
@@ -476,16 +516,36 @@ struct ReadTask : public RateLimiterNode,
   IntrusivePtr<GcsKeyValueStore> owner;
   std::string resource;
   kvstore::ReadOptions options;
-  Promise<kvstore::ReadResult> promise;
+  /// See `internal_kvstore::ReadPartFunction`.
+  bool partial;
+  Promise<ReadPartResult> promise;
+
+  /// If `true`, the value of a successful read is delivered incrementally via
+  /// `value_stream` rather than `ReadResult::value`.  Only supported for
+  /// reads of the full value.
+  bool streaming = false;
+  /// Receives the value of a streaming read.  Set before `promise` is
+  /// resolved, and not modified afterwards.
+  internal::CordStreamPtr value_stream;
 
   int attempt_ = 0;
   absl::Time start_time_;
 
+  /// Body of the current response to a streaming read.
+  internal::CordStreamPtr body_;
+  /// Number of bytes relayed from `body_` to `value_stream` so far.
+  uint64_t relayed_ = 0;
+  /// Generation that a resumed streaming read must match, or
+  /// `StorageGeneration::Unknown()` if the transfer cannot be resumed.
+  StorageGeneration resume_generation_;
+
   ReadTask(IntrusivePtr<GcsKeyValueStore> owner, std::string resource,
-           kvstore::ReadOptions options, Promise<kvstore::ReadResult> promise)
+           kvstore::ReadOptions options, bool partial,
+           Promise<ReadPartResult> promise)
       : owner(std::move(owner)),
         resource(std::move(resource)),
         options(std::move(options)),
+        partial(partial),
         promise(std::move(promise)) {}
 
   ~ReadTask() { owner->admission_queue().Finish(this); }
@@ -505,6 +565,10 @@ struct ReadTask : public RateLimiterNode,
   }
 
   void Retry() {
+    if (value_stream) {
+      ResumeStreaming();
+      return;
+    }
     if (!promise.result_needed()) {
       return;
     }
@@ -541,6 +605,14 @@ struct ReadTask : public RateLimiterNode,
     }
     auto request = request_builder.EnableAcceptEncoding().BuildRequest();
     start_time_ = absl::Now();
+    if (streaming) {
+      auto future = owner->IssueStreamingRequest("ReadTask", request);
+      future.ExecuteWhenReady([self = IntrusivePtr<ReadTask>(this)](
+                                  ReadyFuture<HttpStreamingResponse> response) {
+        self->OnStreamingResponse(response.result());
+      });
+      return;
+    }
     auto future = owner->IssueRequest("ReadTask", request, {});
     future.ExecuteWhenReady([self = IntrusivePtr<ReadTask>(this)](
                                 ReadyFuture<HttpResponse> response) {
@@ -548,6 +620,154 @@ struct ReadTask : public RateLimiterNode,
     });
   }
 
+  void OnStreamingResponse(const Result<HttpStreamingResponse>& response) {
+    if (!promise.result_needed()) {
+      return;
+    }
+    if (!response.ok()) {
+      OnResponse(response.status());
+      return;
+    }
+    if (response->response.status_code != 200) {
+      // Only the body of a successful response is streamed; any other
+      // response is handled in full once its body has been received.
+      auto body = response->body;
+      auto finished = body->finished();
+      std::move(finished).ExecuteWhenReady(
+          [self = IntrusivePtr<ReadTask>(this),
+           httpresponse = response->response,
+           body = std::move(body)](ReadyFuture<const void> future) mutable {
+            // The body has finished, so `ReadAll` does not block.
+            auto payload = body->ReadAll();
+            if (!payload.ok()) {
+              self->OnResponse(payload.status());
+              return;
+            }
+            httpresponse.payload = *std::move(payload);
+            self->OnResponse(httpresponse);
+          });
+      return;
+    }
+    MaybeLogResponse("ReadTask", response->response);
+    ReadPartResult part_result;
+    auto read_result = FinishResponse(response->response,
+                                      part_result.value_size,
+                                      /*streaming=*/true);
+    if (!read_result.ok()) {
+      promise.SetResult(read_result.status());
+      return;
+    }
+    // Byte offsets into a body with a content encoding do not refer to the
+    // value, so such a transfer is not resumed.
+    if (response->response.headers.find("content-encoding") ==
+        response->response.headers.end()) {
+      resume_generation_ = read_result->stamp.generation;
+    }
+    body_ = response->body;
+    value_stream = internal::MakeIntrusivePtr<internal::CordStream>();
+    part_result.read_result = *std::move(read_result);
+    promise.SetResult(std::move(part_result));
+    Relay(IntrusivePtr<ReadTask>(this));
+  }
+
+  /// Relays the data available from `body_` to `value_stream`, and then waits
+  /// for more.
+  ///
+  /// The body is relayed from the transport callbacks as each piece is
+  /// received, and the task, including its admission, remains alive until the
+  /// transfer completes.
+  static void Relay(IntrusivePtr<ReadTask> self) {
+    while (true) {
+      absl::Cord data;
+      auto finished = self->body_->TryReadAvailable(data);
+      self->relayed_ += data.size();
+      gcs_bytes_read.IncrementBy(data.size());
+      if (!data.empty()) self->value_stream->Append(std::move(data));
+      if (!finished.ok()) {
+        self->OnBodyError(std::move(finished).status());
+        return;
+      }
+      if (*finished) {
+        self->body_.reset();
+        self->value_stream->Finish();
+        return;
+      }
+      auto available = self->body_->WhenAvailable();
+      if (available.ready()) continue;
+      std::move(available).ExecuteWhenReady(
+          [self = std::move(self)](ReadyFuture<const void> future) mutable {
+            Relay(std::move(self));
+          });
+      return;
+    }
+  }
+
+  /// Resumes the transfer of a streamed value after `error`, or finishes
+  /// `value_stream` with `error` if it is not retriable or the retries are
+  /// exhausted.
+  void OnBodyError(absl::Status error) {
+    body_.reset();
+    if (!StorageGeneration::IsUnknown(resume_generation_) &&
+        IsRetriable(error) && owner->BackoffForAttemptAsync(attempt_++, this)) {
+      return;
+    }
+    value_stream->Finish(std::move(error));
+  }
+
+  /// Requests the remainder of a streamed value, which must still have the
+  /// generation that was originally read.
+  void ResumeStreaming() {
+    std::string media_url = tensorstore::StrCat(resource, "?alt=media");
+    AddGenerationParam(&media_url, true, "ifGenerationMatch",
+                       resume_generation_);
+    AddUserProjectParam(&media_url, true, owner->encoded_user_project());
+    AddUniqueQueryParameterToDisableCaching(media_url);
+    auto maybe_auth_header = owner->GetAuthHeader();
+    if (!maybe_auth_header.ok()) {
+      value_stream->Finish(maybe_auth_header.status());
+      return;
+    }
+    HttpRequestBuilder request_builder("GET", media_url);
+    if (maybe_auth_header.value().has_value()) {
+      request_builder.AddHeader(*maybe_auth_header.value());
+    }
+    request_builder.AddHeader(
+        internal_http::GetRangeHeader(OptionalByteRangeRequest(relayed_)));
+    auto future = owner->IssueStreamingRequest("ReadTask",
+                                               request_builder.BuildRequest());
+    future.ExecuteWhenReady([self = IntrusivePtr<ReadTask>(this)](
+                                ReadyFuture<HttpStreamingResponse> response) {
+      self->OnResumeResponse(response.result());
+    });
+  }
+
+  void OnResumeResponse(const Result<HttpStreamingResponse>& response) {
+    absl::Status status = [&]() -> absl::Status {
+      if (!response.ok()) return response.status();
+      if (response->response.status_code != 206) {
+        TENSORSTORE_RETURN_IF_ERROR(
+            HttpResponseCodeToStatus(response->response));
+        return absl::FailedPreconditionError(tensorstore::StrCat(
+            "Resumed read of ", resource, " returned status code ",
+            response->response.status_code));
+      }
+      auto content_range =
+          internal_http::TryParseContentRangeHeader(response->response);
+      if (!content_range || std::get<0>(*content_range) != relayed_) {
+        return absl::FailedPreconditionError(
+            tensorstore::StrCat("Resumed read of ", resource,
+                                " returned an unexpected byte range"));
+      }
+      return absl::OkStatus();
+    }();
+    if (!status.ok()) {
+      OnBodyError(std::move(status));
+      return;
+    }
+    body_ = response->body;
+    Relay(IntrusivePtr<ReadTask>(this));
+  }
+
   void OnResponse(const Result<HttpResponse>& response) {
     if (!promise.result_needed()) {
       return;
@@ -562,6 +782,12 @@ struct ReadTask : public RateLimiterNode,
         case 404:
         case 304:
           return absl::OkStatus();
+        case 416:
+          if (partial) {
+            return absl::OutOfRangeError(
+                "Requested byte range not satisfiable");
+          }
+          break;
       }
       return HttpResponseCodeToStatus(response.value());
     }();
@@ -576,11 +802,25 @@ struct ReadTask : public RateLimiterNode,
     if (!status.ok()) {
       promise.SetResult(status);
     } else {
-      promise.SetResult(FinishResponse(response.value()));
+      ReadPartResult part_result;
+      auto read_result = FinishResponse(response.value(),
+                                        part_result.value_size);
+      if (!read_result.ok()) {
+        promise.SetResult(read_result.status());
+        return;
+      }
+      part_result.read_result = *std::move(read_result);
+      promise.SetResult(std::move(part_result));
     }
   }
 
-  Result<kvstore::ReadResult> FinishResponse(const HttpResponse& httpresponse) {
+  /// Computes the result of a read from its response.
+  ///
+  /// \param streaming If `true`, the value is not taken from the payload of
+  ///     `httpresponse`, and is instead delivered via `value_stream`.
+  Result<kvstore::ReadResult> FinishResponse(const HttpResponse& httpresponse,
+                                             uint64_t& value_size,
+                                             bool streaming = false) {
     gcs_bytes_read.IncrementBy(httpresponse.payload.size());
     auto latency = absl::Now() - start_time_;
     gcs_read_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
@@ -609,11 +849,16 @@ struct ReadTask : public RateLimiterNode,
         return read_result;
     }
 
-    TENSORSTORE_ASSIGN_OR_RETURN(
-        auto byte_range,
-        GetHttpResponseByteRange(httpresponse, options.byte_range));
     read_result.state = kvstore::ReadResult::kValue;
-    read_result.value = internal::GetSubCord(httpresponse.payload, byte_range);
+    if (!streaming) {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto byte_range,
+          partial ? GetHttpResponsePartialByteRange(
+                        httpresponse, options.byte_range, value_size)
+                  : GetHttpResponseByteRange(httpresponse, options.byte_range));
+      read_result.value =
+          internal::GetSubCord(httpresponse.payload, byte_range);
+    }
 
     // TODO: Avoid parsing the entire metadata & only extract the
     // generation field.
@@ -641,16 +886,75 @@ Future<kvstore::ReadResult> GcsKeyValueStore::Read(Key key,
   std::string resource = tensorstore::internal::JoinPath(resource_root_, "/o/",
                                                          encoded_object_name);
 
-  auto op = PromiseFuturePair<ReadResult>::Make();
+  if (internal_kvstore::ShouldReadInParallel(options,
+                                             parallel_read_options())) {
+    return internal_kvstore::ParallelRead(
+        std::move(options), parallel_read_options(),
+        [self = IntrusivePtr<GcsKeyValueStore>(this),
+         resource = std::move(resource)](ReadOptions options, bool partial) {
+          return self->ReadPart(resource, std::move(options), partial);
+        });
+  }
+  return MapFutureValue(
+      InlineExecutor{},
+      [](ReadPartResult& part_result) {
+        return std::move(part_result.read_result);
+      },
+      ReadPart(std::move(resource), std::move(options), /*partial=*/false));
+}
+
+Future<ReadPartResult> GcsKeyValueStore::ReadPart(std::string resource,
+                                                  ReadOptions options,
+                                                  bool partial) {
+  auto op = PromiseFuturePair<ReadPartResult>::Make();
   auto state = internal::MakeIntrusivePtr<ReadTask>(
       internal::IntrusivePtr<GcsKeyValueStore>(this), std::move(resource),
-      std::move(options), std::move(op.promise));
+      std::move(options), partial, std::move(op.promise));
 
   intrusive_ptr_increment(state.get());  // adopted by ReadTask::Start.
   read_rate_limiter().Admit(state.get(), &ReadTask::Start);
   return std::move(op.future);
 }
 
+Future<kvstore::StreamingReadResult> GcsKeyValueStore::ReadStreaming(
+    Key key, ReadOptions options) {
+  // Byte range and parallel reads are not streamed.
+  if (options.byte_range.inclusive_min != 0 ||
+      options.byte_range.exclusive_max ||
+      internal_kvstore::ShouldReadInParallel(options,
+                                             parallel_read_options())) {
+    return kvstore::Driver::ReadStreaming(std::move(key), std::move(options));
+  }
+  gcs_read.Increment();
+  if (!IsValidObjectName(key)) {
+    return absl::InvalidArgumentError("Invalid GCS object name");
+  }
+  if (!IsValidStorageGeneration(options.if_equal) ||
+      !IsValidStorageGeneration(options.if_not_equal)) {
+    return absl::InvalidArgumentError("Malformed StorageGeneration");
+  }
+  auto encoded_object_name = internal::PercentEncodeUriComponent(key);
+  std::string resource = tensorstore::internal::JoinPath(resource_root_, "/o/",
+                                                         encoded_object_name);
+  auto op = PromiseFuturePair<ReadPartResult>::Make();
+  auto state = internal::MakeIntrusivePtr<ReadTask>(
+      internal::IntrusivePtr<GcsKeyValueStore>(this), std::move(resource),
+      std::move(options), /*partial=*/false, std::move(op.promise));
+  state->streaming = true;
+
+  intrusive_ptr_increment(state.get());  // adopted by ReadTask::Start.
+  read_rate_limiter().Admit(state.get(), &ReadTask::Start);
+  return MapFutureValue(
+      InlineExecutor{},
+      [state = std::move(state)](ReadPartResult& part_result) {
+        kvstore::StreamingReadResult result;
+        result.read_result = std::move(part_result.read_result);
+        result.value = state->value_stream;
+        return result;
+      },
+      std::move(op.future));
+}
+
 /// A WriteTask is a function object used to satisfy a
 /// GcsKeyValueStore::Write request.
 struct WriteTask : public RateLimiterNode,
@@ -34,6 +34,7 @@
 #include "absl/time/time.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/context.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/http/curl_handle.h"
 #include "tensorstore/internal/http/curl_transport.h"
 #include "tensorstore/internal/http/http_request.h"
@@ -44,6 +45,7 @@
 #include "tensorstore/internal/oauth2/google_auth_provider.h"
 #include "tensorstore/internal/oauth2/google_auth_test_utils.h"
 #include "tensorstore/internal/path.h"
+#include "tensorstore/internal/queue_testutil.h"
 #include "tensorstore/internal/schedule_at.h"
 #include "tensorstore/kvstore/gcs/gcs_mock.h"
 #include "tensorstore/kvstore/generation.h"
@@ -67,11 +69,17 @@ using ::tensorstore::GCSMockStorageBucket;
 using ::tensorstore::KeyRange;
 using ::tensorstore::MatchesJson;
 using ::tensorstore::MatchesStatus;
+using ::tensorstore::PromiseFuturePair;
 using ::tensorstore::StorageGeneration;
 using ::tensorstore::StrCat;
+using ::tensorstore::internal::CordStream;
+using ::tensorstore::internal::MakeIntrusivePtr;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
 using ::tensorstore::internal::ScheduleAt;
 using ::tensorstore::internal_http::HttpRequest;
 using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::HttpStreamingResponse;
 using ::tensorstore::internal_http::HttpTransport;
 using ::tensorstore::internal_http::SetDefaultHttpTransport;
 using ::tensorstore::internal_oauth2::GoogleAuthTestScope;
@@ -145,6 +153,27 @@ class MyMockTransport : public HttpTransport {
   std::vector<GCSMockStorageBucket*> buckets_;
 };
 
+/// Mock transport that delivers the bodies of streaming requests
+/// incrementally.
+class MyStreamingMockTransport : public MyMockTransport {
+ public:
+  Future<HttpStreamingResponse> IssueStreamingRequest(
+      const HttpRequest& request, absl::Cord payload,
+      absl::Duration request_timeout,
+      absl::Duration connect_timeout) override {
+    auto [promise, future] = PromiseFuturePair<HttpStreamingResponse>::Make();
+    streaming_requests_.push({request, promise});
+    return future;
+  }
+
+  struct StreamingRequest {
+    HttpRequest request;
+    tensorstore::Promise<HttpStreamingResponse> promise;
+  };
+
+  tensorstore::internal::ConcurrentQueue<StreamingRequest> streaming_requests_;
+};
+
 struct DefaultHttpTransportSetter {
   DefaultHttpTransportSetter(std::shared_ptr<HttpTransport> transport) {
     SetDefaultHttpTransport(transport);
@@ -240,6 +269,44 @@ TEST(GcsKeyValueStoreTest, Basic) {
   tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
 }
 
+TEST(GcsKeyValueStoreTest, ParallelRead) {
+  auto mock_transport = std::make_shared<MyMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  GCSMockStorageBucket bucket("my-bucket");
+  mock_transport->buckets_.push_back(&bucket);
+
+  auto context = DefaultTestContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", kDriver},
+                                 {"bucket", "my-bucket"},
+                                 {"read_part_size", 16},
+                                 {"read_part_concurrency", 2}},
+                                context)
+                      .result());
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+
+  std::string value(100, '\0');
+  for (size_t i = 0; i < value.size(); ++i) value[i] = static_cast<char>(i);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto write_result,
+      kvstore::Write(store, "large", absl::Cord(value)).result());
+  EXPECT_THAT(
+      kvstore::Read(store, "large").result(),
+      MatchesKvsReadResult(absl::Cord(value), write_result.generation));
+
+  kvstore::ReadOptions options;
+  options.byte_range.inclusive_min = 10;
+  options.byte_range.exclusive_max = 90;
+  EXPECT_THAT(kvstore::Read(store, "large", options).result(),
+              MatchesKvsReadResult(absl::Cord(value.substr(10, 80)),
+                                   write_result.generation));
+
+  options.byte_range.exclusive_max = 200;
+  EXPECT_THAT(kvstore::Read(store, "large", options).result(),
+              MatchesStatus(absl::StatusCode::kOutOfRange));
+}
+
 TEST(GcsKeyValueStoreTest, Retry) {
   for (int max_retries : {2, 3, 4}) {
     for (bool fail : {false, true}) {
@@ -278,6 +345,96 @@ TEST(GcsKeyValueStoreTest, Retry) {
   }
 }
 
+TEST(GcsKeyValueStoreTest, ReadStreaming) {
+  auto mock_transport = std::make_shared<MyMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  GCSMockStorageBucket bucket("my-bucket");
+  mock_transport->buckets_.push_back(&bucket);
+
+  auto context = DefaultTestContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", kDriver}, {"bucket", "my-bucket"}}, context)
+          .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto write_result,
+      kvstore::Write(store, "abc", absl::Cord("value")).result());
+
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto result, store.driver->ReadStreaming("abc").result());
+    EXPECT_THAT(result.read_result,
+                MatchesKvsReadResult(absl::Cord(), write_result.generation));
+    ASSERT_TRUE(result.value);
+    EXPECT_THAT(result.value->ReadAll(),
+                ::testing::Optional(absl::Cord("value")));
+  }
+
+  // Responses without a value are not streamed.
+  {
+    kvstore::ReadOptions options;
+    options.if_not_equal = write_result.generation;
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto result, store.driver->ReadStreaming("abc", options).result());
+    EXPECT_TRUE(result.read_result.aborted());
+    EXPECT_FALSE(result.value);
+  }
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto result, store.driver->ReadStreaming("missing").result());
+    EXPECT_THAT(result.read_result, MatchesKvsReadResultNotFound());
+    EXPECT_FALSE(result.value);
+  }
+}
+
+TEST(GcsKeyValueStoreTest, ReadStreamingResumeAfterError) {
+  auto mock_transport = std::make_shared<MyStreamingMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  auto context = DefaultTestContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", kDriver}, {"bucket", "my-bucket"}}, context)
+          .result());
+
+  auto read_future = store.driver->ReadStreaming("abc");
+  auto body = MakeIntrusivePtr<CordStream>();
+  {
+    auto request = mock_transport->streaming_requests_.pop();
+    EXPECT_THAT(request.request.url(),
+                ::testing::HasSubstr("/o/abc?alt=media"));
+    request.promise.SetResult(HttpStreamingResponse{
+        HttpResponse{200, absl::Cord(), {{"x-goog-generation", "5"}}}, body});
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result, read_future.result());
+  EXPECT_THAT(result.read_result,
+              MatchesKvsReadResult(absl::Cord(),
+                                   StorageGeneration::FromUint64(5)));
+  ASSERT_TRUE(result.value);
+  body->Append(absl::Cord("val"));
+  body->Finish(absl::UnavailableError("connection reset"));
+
+  // The remainder is requested from the offset at which the transfer failed,
+  // conditioned on the generation that was originally read.
+  {
+    auto request = mock_transport->streaming_requests_.pop();
+    EXPECT_THAT(request.request.url(),
+                ::testing::HasSubstr("ifGenerationMatch=5"));
+    EXPECT_THAT(request.request.headers(),
+                ::testing::Contains("Range: bytes=3-"));
+    request.promise.SetResult(HttpStreamingResponse{
+        HttpResponse{206,
+                     absl::Cord(),
+                     {{"x-goog-generation", "5"},
+                      {"content-range", "bytes 3-4/5"}}},
+        CordStream::FromCord(absl::Cord("ue"))});
+  }
+  EXPECT_THAT(result.value->ReadAll(),
+              ::testing::Optional(absl::Cord("value")));
+  EXPECT_TRUE(mock_transport->streaming_requests_.empty());
+}
+
 TEST(GcsKeyValueStoreTest, List) {
   // Setup mocks for:
   // https://www.googleapis.com/kvstore/v1/b/my-bucket/o/test
@@ -14,6 +14,7 @@
 
 #include "tensorstore/kvstore/gcs/gcs_mock.h"
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <optional>
@@ -26,6 +27,7 @@
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
 #include "absl/strings/substitute.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/http/curl_handle.h"
@@ -79,6 +81,14 @@ std::optional<internal_http::HttpResponse> ParseQueryParameters(
   return std::nullopt;
 }
 
+/// Returns the value of the "Range" header of `request`, or an empty string.
+std::string_view GetRangeHeader(const HttpRequest& request) {
+  for (std::string_view header : request.headers()) {
+    if (absl::ConsumePrefix(&header, "Range: ")) return header;
+  }
+  return {};
+}
+
 }  // namespace
 
 GCSMockStorageBucket::~GCSMockStorageBucket() = default;
@@ -183,7 +193,7 @@ GCSMockStorageBucket::Match(const HttpRequest& request, absl::Cord payload) {
     return HandleInsertRequest(path, params, payload);
   } else if (absl::StartsWith(path, "/o/") && request.method() == "GET") {
     // GET request on an object.
-    return HandleGetRequest(path, params);
+    return HandleGetRequest(path, params, GetRangeHeader(request));
   } else if (absl::StartsWith(path, "/o/") && request.method() == "DELETE") {
     // DELETE request on an object.
     return HandleDeleteRequest(path, params);
@@ -314,7 +324,8 @@ GCSMockStorageBucket::HandleInsertRequest(std::string_view path,
 
 std::variant<std::monostate, HttpResponse, absl::Status>
 GCSMockStorageBucket::HandleGetRequest(std::string_view path,
-                                       const ParamMap& params) {
+                                       const ParamMap& params,
+                                       std::string_view range_header) {
   // https://cloud.google.com/storage/docs/json_api/v1/objects/get
   path.remove_prefix(3);  // remove /o/
   std::string name = internal::PercentDecode(path);
@@ -359,7 +370,7 @@ GCSMockStorageBucket::HandleGetRequest(std::string_view path,
     if (params.empty() || alt == params.end() || alt->second != "media") {
       return ObjectMetadataResponse(it->second);
     }
-    return ObjectMediaResponse(it->second);
+    return ObjectMediaResponse(it->second, range_header);
   } while (false);
 
   return HttpResponse{404};
@@ -441,8 +452,33 @@ HttpResponse GCSMockStorageBucket::ObjectMetadataResponse(
   };
 }
 
-HttpResponse GCSMockStorageBucket::ObjectMediaResponse(const Object& object) {
+HttpResponse GCSMockStorageBucket::ObjectMediaResponse(
+    const Object& object, std::string_view range_header) {
   HttpResponse response{200, object.data};
+  // https://cloud.google.com/storage/docs/xml-api/reference-headers#range
+  if (absl::ConsumePrefix(&range_header, "bytes=")) {
+    std::pair<std::string_view, std::string_view> split =
+        absl::StrSplit(range_header, absl::MaxSplits('-', 1));
+    const size_t size = object.data.size();
+    size_t inclusive_min = 0;
+    size_t inclusive_max = size == 0 ? 0 : size - 1;
+    if (!absl::SimpleAtoi(split.first, &inclusive_min) ||
+        (!split.second.empty() &&
+         !absl::SimpleAtoi(split.second, &inclusive_max)) ||
+        inclusive_max < inclusive_min) {
+      return HttpResponse{400, absl::Cord("Invalid range")};
+    }
+    if (inclusive_min >= size) {
+      return HttpResponse{416, absl::Cord("Requested range not satisfiable")};
+    }
+    inclusive_max = std::min(inclusive_max, size - 1);
+    response.status_code = 206;
+    response.payload =
+        object.data.Subcord(inclusive_min, inclusive_max + 1 - inclusive_min);
+    response.headers.insert(
+        {"content-range", tensorstore::StrCat("bytes ", inclusive_min, "-",
+                                              inclusive_max, "/", size)});
+  }
   response.headers.insert(
       {"content-length", tensorstore::StrCat(response.payload.size())});
   response.headers.insert({"content-type", "application/octet-stream"});
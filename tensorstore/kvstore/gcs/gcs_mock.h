@@ -83,7 +83,8 @@ class GCSMockStorageBucket {
 
   // Get an object, which might be the data or the metadata.
   std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
-  HandleGetRequest(std::string_view path, const ParamMap& params);
+  HandleGetRequest(std::string_view path, const ParamMap& params,
+                   std::string_view range_header);
 
   // Delete an object.
   std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
@@ -92,8 +93,10 @@ class GCSMockStorageBucket {
   // Construct an ojbect metadata response.
   internal_http::HttpResponse ObjectMetadataResponse(const Object& object);
 
-  // Construct an object media response.
-  internal_http::HttpResponse ObjectMediaResponse(const Object& object);
+  // Construct an object media response, restricted to `range_header` if it is
+  // not empty.
+  internal_http::HttpResponse ObjectMediaResponse(
+      const Object& object, std::string_view range_header);
 
   ::nlohmann::json ObjectMetadata(const Object& object);
 
@@ -12,11 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -30,6 +34,7 @@
 #include "tensorstore/internal/cache_key/std_vector.h"
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/concurrency_resource_provider.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/env.h"
 #include "tensorstore/internal/http/curl_transport.h"
 #include "tensorstore/internal/http/http_header.h"
@@ -45,8 +50,10 @@
 #include "tensorstore/internal/retries_context_resource.h"
 #include "tensorstore/internal/retry.h"
 #include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/parallel_read.h"
 #include "tensorstore/kvstore/registry.h"
 #include "tensorstore/kvstore/url_registry.h"
 #include "tensorstore/serialization/std_vector.h"
@@ -66,6 +73,8 @@ using ::tensorstore::internal::IntrusivePtr;
 using ::tensorstore::internal_http::HttpRequestBuilder;
 using ::tensorstore::internal_http::HttpResponse;
 using ::tensorstore::internal_http::HttpTransport;
+using ::tensorstore::internal_kvstore::ParallelReadOptions;
+using ::tensorstore::internal_kvstore::ReadPartResult;
 
 auto& http_bytes_read = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/kvstore/http/bytes_read",
@@ -131,8 +140,14 @@ struct HttpKeyValueStoreSpecData {
   Context::Resource<HttpRequestRetries> retries;
   std::vector<std::string> headers;
 
+  /// Values larger than this are read as multiple concurrent byte range
+  /// requests.  If `0`, each read is a single request.
+  uint64_t read_part_size = 0;
+  size_t read_part_concurrency = 4;
+
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
-    return f(x.base_url, x.request_concurrency, x.retries, x.headers);
+    return f(x.base_url, x.request_concurrency, x.retries, x.headers,
+             x.read_part_size, x.read_part_concurrency);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -152,7 +167,15 @@ struct HttpKeyValueStoreSpecData {
           HttpRequestConcurrencyResource::id,
           jb::Projection<&HttpKeyValueStoreSpecData::request_concurrency>()),
       jb::Member(HttpRequestRetries::id,
-                 jb::Projection<&HttpKeyValueStoreSpecData::retries>()));
+                 jb::Projection<&HttpKeyValueStoreSpecData::retries>()),
+      jb::Member("read_part_size",
+                 jb::Projection<&HttpKeyValueStoreSpecData::read_part_size>(
+                     jb::DefaultValue([](auto* v) { *v = 0; }))),
+      jb::Member(
+          "read_part_concurrency",
+          jb::Projection<&HttpKeyValueStoreSpecData::read_part_concurrency>(
+              jb::DefaultValue([](auto* v) { *v = 4; },
+                               jb::Integer<size_t>(1)))));
 
   std::string GetUrl(std::string_view path) const {
     auto parsed = internal::ParseGenericUri(base_url);
@@ -201,10 +224,17 @@ class HttpKeyValueStore
  public:
   Future<ReadResult> Read(Key key, ReadOptions options) override;
 
+  Future<kvstore::StreamingReadResult> ReadStreaming(
+      Key key, ReadOptions options) override;
+
   const Executor& executor() const {
     return spec_.request_concurrency->executor;
   }
 
+  ParallelReadOptions parallel_read_options() const {
+    return {spec_.read_part_size, spec_.read_part_concurrency};
+  }
+
   absl::Status GetBoundSpecData(SpecData& spec) const {
     spec = spec_;
     return absl::OkStatus();
@@ -233,17 +263,153 @@ Future<kvstore::DriverPtr> HttpKeyValueStoreSpec::DoOpen() const {
   return driver;
 }
 
+/// Relays the body of a streaming read to the consumer, resuming the transfer
+/// with a range request if it fails with a retriable error.
+///
+/// The body is relayed from the transport callbacks as each piece is received;
+/// only resume requests are issued on the driver executor.
+struct StreamingBodyRelay
+    : public internal::AtomicReferenceCount<StreamingBodyRelay> {
+  IntrusivePtr<HttpKeyValueStore> owner;
+  std::string url;
+  /// Entity tag that a resumed response must match, or empty if the transfer
+  /// cannot be resumed.
+  std::string etag;
+  internal::CordStreamPtr source;
+  internal::CordStreamPtr output;
+  /// Number of bytes relayed to `output` so far.
+  uint64_t relayed = 0;
+  int attempt = 0;
+
+  /// Returns a stream that receives the body `source` of the 200 `response`.
+  static internal::CordStreamPtr Start(IntrusivePtr<HttpKeyValueStore> owner,
+                                       std::string url,
+                                       const StorageGeneration& generation,
+                                       const HttpResponse& response,
+                                       internal::CordStreamPtr source) {
+    auto self = internal::MakeIntrusivePtr<StreamingBodyRelay>();
+    self->owner = std::move(owner);
+    self->url = std::move(url);
+    // Byte offsets into a body with a content encoding do not refer to the
+    // value, so such a transfer is not resumed.
+    if (StorageGeneration::IsCleanValidValue(generation) &&
+        response.headers.find("content-encoding") == response.headers.end()) {
+      self->etag = std::string(StorageGeneration::DecodeString(generation));
+    }
+    self->source = std::move(source);
+    self->output = internal::MakeIntrusivePtr<internal::CordStream>();
+    auto output = self->output;
+    Relay(std::move(self));
+    return output;
+  }
+
+  /// Relays the data available from `source`, and then waits for more.
+  static void Relay(IntrusivePtr<StreamingBodyRelay> self) {
+    while (true) {
+      absl::Cord data;
+      auto finished = self->source->TryReadAvailable(data);
+      self->relayed += data.size();
+      if (!data.empty()) self->output->Append(std::move(data));
+      if (!finished.ok()) {
+        Resume(std::move(self), std::move(finished).status());
+        return;
+      }
+      if (*finished) {
+        self->output->Finish();
+        return;
+      }
+      auto available = self->source->WhenAvailable();
+      if (available.ready()) continue;
+      std::move(available).ExecuteWhenReady(
+          [self = std::move(self)](ReadyFuture<const void> future) mutable {
+            Relay(std::move(self));
+          });
+      return;
+    }
+  }
+
+  /// Resumes the transfer after `error`, or finishes `output` with `error` if
+  /// it is not retriable or the retries are exhausted.
+  static void Resume(IntrusivePtr<StreamingBodyRelay> self,
+                     absl::Status error) {
+    if (!IsRetriable(error) || self->etag.empty() ||
+        self->attempt >= self->owner->spec_.retries->max_retries) {
+      self->output->Finish(std::move(error));
+      return;
+    }
+    const auto& executor = self->owner->executor();
+    executor([self = std::move(self)]() mutable {
+      const auto& retries = *self->owner->spec_.retries;
+      absl::SleepFor(internal::BackoffForAttempt(
+          self->attempt++, retries.initial_delay, retries.max_delay,
+          retries.initial_delay));
+      auto status = self->IssueResumeRequest();
+      if (!status.ok()) {
+        Resume(std::move(self), std::move(status));
+        return;
+      }
+      Relay(std::move(self));
+    });
+  }
+
+  /// Requests the remainder of the value, replacing `source`.
+  absl::Status IssueResumeRequest() {
+    HttpRequestBuilder request_builder("GET", url);
+    for (const auto& header : owner->spec_.headers) {
+      request_builder.AddHeader(header);
+    }
+    request_builder.AddHeader(internal_http::GetRangeHeader(
+        OptionalByteRangeRequest(relayed)));
+    request_builder.AddHeader(tensorstore::StrCat("if-match: \"", etag, "\""));
+    auto response = owner->transport_
+                        ->IssueStreamingRequest(request_builder.BuildRequest(),
+                                                {})
+                        .result();
+    if (!response.ok()) return response.status();
+    if (response->response.status_code != 206) {
+      auto status = HttpResponseCodeToStatus(response->response);
+      if (!status.ok()) return status;
+      return absl::FailedPreconditionError(tensorstore::StrCat(
+          "Resumed read of ", url, " returned status code ",
+          response->response.status_code));
+    }
+    auto content_range =
+        internal_http::TryParseContentRangeHeader(response->response);
+    if (!content_range || std::get<0>(*content_range) != relayed) {
+      return absl::FailedPreconditionError(tensorstore::StrCat(
+          "Resumed read of ", url, " returned an unexpected byte range"));
+    }
+    source = std::move(response->body);
+    return absl::OkStatus();
+  }
+};
+
 /// A ReadTask is a function object used to satisfy a
 /// HttpKeyValueStore::Read request.
 struct ReadTask {
   IntrusivePtr<HttpKeyValueStore> owner;
   std::string url;
   kvstore::ReadOptions options;
+  /// See `internal_kvstore::ReadPartFunction`.
+  bool partial = false;
 
   Result<kvstore::ReadResult> operator()() {
+    uint64_t value_size;
+    return Read(value_size);
+  }
+
+  /// Performs the read.
+  ///
+  /// \param value_size[out] Set to the total size of the value.
+  /// \param value_stream[out] If non-null, a successful response to a request
+  ///     for the full value is delivered incrementally via `*value_stream`
+  ///     rather than `ReadResult::value`.
+  Result<kvstore::ReadResult> Read(
+      uint64_t& value_size, internal::CordStreamPtr* value_stream = nullptr) {
     kvstore::ReadResult read_result;
 
     HttpResponse httpresponse;
+    internal::CordStreamPtr body;
     auto retry_status = owner->RetryRequestWithBackoff([&] {
       HttpRequestBuilder request_builder("GET", url);
       for (const auto& header : owner->spec_.headers) {
@@ -268,15 +434,35 @@ struct ReadTask {
       }
       auto request = request_builder.EnableAcceptEncoding().BuildRequest();
       read_result.stamp.time = absl::Now();
-      auto response = owner->transport_->IssueRequest(request, {}).result();
-      if (!response.ok()) return response.status();
-      httpresponse = std::move(*response);
+      if (value_stream) {
+        auto response =
+            owner->transport_->IssueStreamingRequest(request, {}).result();
+        if (!response.ok()) return response.status();
+        httpresponse = std::move(response->response);
+        body = std::move(response->body);
+        if (httpresponse.status_code != 200) {
+          // Only the body of a successful response is streamed; any other
+          // response is handled in full below.
+          TENSORSTORE_ASSIGN_OR_RETURN(httpresponse.payload, body->ReadAll());
+          body.reset();
+        }
+      } else {
+        auto response = owner->transport_->IssueRequest(request, {}).result();
+        if (!response.ok()) return response.status();
+        httpresponse = std::move(*response);
+      }
       switch (httpresponse.status_code) {
         // Special status codes handled outside the retry loop.
         case 412:
         case 404:
         case 304:
           return absl::OkStatus();
+        case 416:
+          if (partial) {
+            return absl::OutOfRangeError(
+                "Requested byte range not satisfiable");
+          }
+          break;
       }
       return HttpResponseCodeToStatus(httpresponse);
     });
@@ -332,11 +518,16 @@ struct ReadTask {
         return read_result;
     }
 
-    TENSORSTORE_ASSIGN_OR_RETURN(
-        auto byte_range,
-        GetHttpResponseByteRange(httpresponse, options.byte_range));
     read_result.state = kvstore::ReadResult::kValue;
-    read_result.value = internal::GetSubCord(httpresponse.payload, byte_range);
+    if (!body) {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto byte_range,
+          partial ? GetHttpResponsePartialByteRange(
+                        httpresponse, options.byte_range, value_size)
+                  : GetHttpResponseByteRange(httpresponse, options.byte_range));
+      read_result.value =
+          internal::GetSubCord(httpresponse.payload, byte_range);
+    }
 
     // Parse `ETag` header from response.
     {
@@ -354,17 +545,76 @@ struct ReadTask {
       }
     }
 
+    if (body) {
+      // A streaming read always requests the full value, which a 200 response
+      // always contains.
+      *value_stream =
+          StreamingBodyRelay::Start(owner, url, read_result.stamp.generation,
+                                    httpresponse, std::move(body));
+    }
+
     return read_result;
   }
 };
 
+/// Function object used to satisfy a HttpKeyValueStore::ReadStreaming
+/// request.
+struct StreamingReadTask {
+  ReadTask task;
+
+  Result<kvstore::StreamingReadResult> operator()() {
+    kvstore::StreamingReadResult result;
+    uint64_t value_size;
+    TENSORSTORE_ASSIGN_OR_RETURN(result.read_result,
+                                 task.Read(value_size, &result.value));
+    return result;
+  }
+};
+
+/// Function object used to read a single part of a value for
+/// `internal_kvstore::ParallelRead`.
+struct ReadPartTask {
+  ReadTask task;
+
+  Result<ReadPartResult> operator()() {
+    ReadPartResult part_result;
+    TENSORSTORE_ASSIGN_OR_RETURN(part_result.read_result,
+                                 task.Read(part_result.value_size));
+    return part_result;
+  }
+};
+
 Future<kvstore::ReadResult> HttpKeyValueStore::Read(Key key,
                                                     ReadOptions options) {
   std::string url = spec_.GetUrl(key);
+  if (internal_kvstore::ShouldReadInParallel(options,
+                                             parallel_read_options())) {
+    return internal_kvstore::ParallelRead(
+        std::move(options), parallel_read_options(),
+        [self = IntrusivePtr<HttpKeyValueStore>(this),
+         url = std::move(url)](ReadOptions options, bool partial) {
+          return MapFuture(self->executor(),
+                           ReadPartTask{ReadTask{self, url, std::move(options),
+                                                 partial}});
+        });
+  }
   return MapFuture(executor(), ReadTask{IntrusivePtr<HttpKeyValueStore>(this),
                                         std::move(url), std::move(options)});
 }
 
+Future<kvstore::StreamingReadResult> HttpKeyValueStore::ReadStreaming(
+    Key key, ReadOptions options) {
+  if (options.byte_range.inclusive_min != 0 ||
+      options.byte_range.exclusive_max ||
+      internal_kvstore::ShouldReadInParallel(options,
+                                             parallel_read_options())) {
+    return kvstore::Driver::ReadStreaming(std::move(key), std::move(options));
+  }
+  ReadTask task{IntrusivePtr<HttpKeyValueStore>(this), spec_.GetUrl(key),
+                std::move(options)};
+  return MapFuture(executor(), StreamingReadTask{std::move(task)});
+}
+
 Result<kvstore::Spec> ParseHttpUrl(std::string_view url) {
   auto parsed = internal::ParseGenericUri(url);
   TENSORSTORE_RETURN_IF_ERROR(ValidateParsedHttpUrl(parsed));
@@ -14,11 +14,16 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "absl/time/time.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/http/curl_transport.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/queue_testutil.h"
+#include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
@@ -32,10 +37,13 @@ using ::tensorstore::MatchesStatus;
 using ::tensorstore::Promise;
 using ::tensorstore::PromiseFuturePair;
 using ::tensorstore::StorageGeneration;
+using ::tensorstore::internal::CordStream;
+using ::tensorstore::internal::MakeIntrusivePtr;
 using ::tensorstore::internal::MatchesKvsReadResult;
 using ::tensorstore::internal::MatchesKvsReadResultNotFound;
 using ::tensorstore::internal_http::HttpRequest;
 using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::HttpStreamingResponse;
 using ::tensorstore::internal_http::HttpTransport;
 using ::tensorstore::internal_http::SetDefaultHttpTransport;
 
@@ -72,6 +80,33 @@ class HttpKeyValueStoreTest : public ::testing::Test {
   DefaultHttpTransportSetter mock_transport_setter{mock_transport};
 };
 
+/// Mock transport that delivers response bodies incrementally.
+class MyStreamingMockTransport : public MyMockTransport {
+ public:
+  Future<HttpStreamingResponse> IssueStreamingRequest(
+      const HttpRequest& request, absl::Cord payload,
+      absl::Duration request_timeout,
+      absl::Duration connect_timeout) override {
+    auto [promise, future] = PromiseFuturePair<HttpStreamingResponse>::Make();
+    streaming_requests_.push({request, promise});
+    return future;
+  }
+
+  struct StreamingRequest {
+    HttpRequest request;
+    Promise<HttpStreamingResponse> promise;
+  };
+
+  tensorstore::internal::ConcurrentQueue<StreamingRequest> streaming_requests_;
+};
+
+class HttpKeyValueStoreStreamingTest : public ::testing::Test {
+ public:
+  std::shared_ptr<MyStreamingMockTransport> mock_transport =
+      std::make_shared<MyStreamingMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+};
+
 TEST(DescribeKeyTest, Basic) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto store, kvstore::Open("https://example.com/my/path/").result());
@@ -141,6 +176,74 @@ TEST_F(HttpKeyValueStoreTest, ReadByteRange) {
                                    StorageGeneration::Invalid()));
 }
 
+TEST_F(HttpKeyValueStoreTest, ParallelRead) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "http"},
+                                 {"base_url", "https://example.com/my/path/"},
+                                 {"read_part_size", 4},
+                                 {"read_part_concurrency", 1}})
+                      .result());
+  auto read_future = kvstore::Read(store, "abc");
+  {
+    auto request = mock_transport->requests_.pop();
+    EXPECT_THAT(
+        request.request.headers(),
+        ::testing::ElementsAre("cache-control: no-cache", "Range: bytes=0-3"));
+    request.promise.SetResult(HttpResponse{206,
+                                           absl::Cord("abcd"),
+                                           {{"content-range", "bytes 0-3/10"},
+                                            {"etag", "\"xyz\""}}});
+  }
+  {
+    auto request = mock_transport->requests_.pop();
+    EXPECT_THAT(request.request.headers(),
+                ::testing::ElementsAre("cache-control: no-cache",
+                                       "Range: bytes=4-7",
+                                       "if-match: \"xyz\""));
+    request.promise.SetResult(HttpResponse{206,
+                                           absl::Cord("efgh"),
+                                           {{"content-range", "bytes 4-7/10"},
+                                            {"etag", "\"xyz\""}}});
+  }
+  {
+    auto request = mock_transport->requests_.pop();
+    EXPECT_THAT(request.request.headers(),
+                ::testing::ElementsAre("cache-control: no-cache",
+                                       "Range: bytes=8-9",
+                                       "if-match: \"xyz\""));
+    request.promise.SetResult(HttpResponse{206,
+                                           absl::Cord("ij"),
+                                           {{"content-range", "bytes 8-9/10"},
+                                            {"etag", "\"xyz\""}}});
+  }
+  EXPECT_THAT(read_future.result(),
+              MatchesKvsReadResult(absl::Cord("abcdefghij"),
+                                   StorageGeneration::FromString("xyz")));
+}
+
+TEST_F(HttpKeyValueStoreTest, ParallelReadEmptyValue) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "http"},
+                                 {"base_url", "https://example.com/my/path/"},
+                                 {"read_part_size", 4}})
+                      .result());
+  auto read_future = kvstore::Read(store, "abc");
+  // No byte range of an empty value is satisfiable, so the read is reissued
+  // without a byte range.
+  mock_transport->requests_.pop().promise.SetResult(
+      HttpResponse{416, absl::Cord()});
+  {
+    auto request = mock_transport->requests_.pop();
+    EXPECT_THAT(request.request.headers(),
+                ::testing::ElementsAre("cache-control: no-cache"));
+    request.promise.SetResult(
+        HttpResponse{200, absl::Cord(), {{"etag", "\"xyz\""}}});
+  }
+  EXPECT_THAT(read_future.result(),
+              MatchesKvsReadResult(absl::Cord(),
+                                   StorageGeneration::FromString("xyz")));
+}
+
 TEST_F(HttpKeyValueStoreTest, ReadWithStalenessBound) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto store, kvstore::Open("https://example.com/my/path/").result());
@@ -248,6 +351,97 @@ TEST_F(HttpKeyValueStoreTest, Retry) {
                                    StorageGeneration::FromString("xyz")));
 }
 
+TEST_F(HttpKeyValueStoreTest, ReadStreaming) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open("https://example.com/my/path/").result());
+
+  auto read_future = store.driver->ReadStreaming(store.path + "abc");
+  {
+    auto request = mock_transport->requests_.pop();
+    EXPECT_EQ("https://example.com/my/path/abc", request.request.url());
+    request.promise.SetResult(HttpResponse{503, absl::Cord()});
+  }
+  {
+    auto request = mock_transport->requests_.pop();
+    EXPECT_EQ("https://example.com/my/path/abc", request.request.url());
+    request.promise.SetResult(
+        HttpResponse{200, absl::Cord("value"), {{"etag", "\"xyz\""}}});
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result, read_future.result());
+  EXPECT_THAT(result.read_result,
+              MatchesKvsReadResult(absl::Cord(),
+                                   StorageGeneration::FromString("xyz")));
+  ASSERT_TRUE(result.value);
+  EXPECT_THAT(result.value->ReadAll(),
+              ::testing::Optional(absl::Cord("value")));
+}
+
+TEST_F(HttpKeyValueStoreTest, ReadStreamingNotFound) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open("https://example.com/my/path/").result());
+  auto read_future = store.driver->ReadStreaming(store.path + "abc");
+  auto request = mock_transport->requests_.pop();
+  request.promise.SetResult(HttpResponse{404, absl::Cord("not found")});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result, read_future.result());
+  EXPECT_THAT(result.read_result, MatchesKvsReadResultNotFound());
+  EXPECT_FALSE(result.value);
+}
+
+TEST_F(HttpKeyValueStoreStreamingTest, ResumeAfterError) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open("https://example.com/my/path/").result());
+
+  auto read_future = store.driver->ReadStreaming(store.path + "abc");
+  auto body = MakeIntrusivePtr<CordStream>();
+  {
+    auto request = mock_transport->streaming_requests_.pop();
+    EXPECT_EQ("https://example.com/my/path/abc", request.request.url());
+    request.promise.SetResult(HttpStreamingResponse{
+        HttpResponse{200, absl::Cord(), {{"etag", "\"xyz\""}}}, body});
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result, read_future.result());
+  EXPECT_THAT(result.read_result,
+              MatchesKvsReadResult(absl::Cord(),
+                                   StorageGeneration::FromString("xyz")));
+  ASSERT_TRUE(result.value);
+  body->Append(absl::Cord("val"));
+  body->Finish(absl::UnavailableError("connection reset"));
+
+  // The remainder is requested from the offset at which the transfer failed.
+  {
+    auto request = mock_transport->streaming_requests_.pop();
+    EXPECT_EQ("https://example.com/my/path/abc", request.request.url());
+    EXPECT_THAT(request.request.headers(),
+                ::testing::IsSupersetOf(
+                    {"Range: bytes=3-", "if-match: \"xyz\""}));
+    request.promise.SetResult(HttpStreamingResponse{
+        HttpResponse{206,
+                     absl::Cord(),
+                     {{"etag", "\"xyz\""}, {"content-range", "bytes 3-4/5"}}},
+        CordStream::FromCord(absl::Cord("ue"))});
+  }
+  EXPECT_THAT(result.value->ReadAll(),
+              ::testing::Optional(absl::Cord("value")));
+  EXPECT_TRUE(mock_transport->requests_.empty());
+}
+
+TEST_F(HttpKeyValueStoreStreamingTest, NoResumeWithoutEtag) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open("https://example.com/my/path/").result());
+
+  auto read_future = store.driver->ReadStreaming(store.path + "abc");
+  auto body = MakeIntrusivePtr<CordStream>();
+  mock_transport->streaming_requests_.pop().promise.SetResult(
+      HttpStreamingResponse{HttpResponse{200}, body});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result, read_future.result());
+  ASSERT_TRUE(result.value);
+  body->Append(absl::Cord("val"));
+  body->Finish(absl::UnavailableError("connection reset"));
+  EXPECT_THAT(result.value->ReadAll(),
+              MatchesStatus(absl::StatusCode::kUnavailable));
+  EXPECT_TRUE(mock_transport->streaming_requests_.empty());
+}
+
 TEST_F(HttpKeyValueStoreTest, RetryMax) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto store,
@@ -421,6 +615,8 @@ TEST(SpecTest, SpecRoundtrip) {
   options.full_spec = {{"driver", "http"},
                        {"base_url", "https://example.com?query"},
                        {"headers", {"a: b"}},
+                       {"read_part_size", 1048576},
+                       {"read_part_concurrency", 2},
                        {"path", "/abc"}};
   tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
 }
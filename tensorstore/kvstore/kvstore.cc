@@ -28,6 +28,7 @@
 #include "absl/strings/match.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/context.h"
+#include "tensorstore/internal/cord_stream.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/no_destructor.h"
 #include "tensorstore/kvstore/driver.h"
@@ -95,6 +96,8 @@ Result<DriverSpecPtr> Driver::GetBoundSpec() const {
 void Driver::EncodeCacheKey(std::string* out) const {
   internal::EncodeCacheKey(out, reinterpret_cast<std::uintptr_t>(this));
 }
+
+std::string_view Driver::driver_id() const { return "unknown"; }
 }  // namespace kvstore
 
 namespace internal_kvstore {
@@ -204,6 +207,23 @@ Future<ReadResult> Driver::Read(Key key, ReadOptions options) {
   return absl::UnimplementedError("KeyValueStore does not support reading");
 }
 
+Future<StreamingReadResult> Driver::ReadStreaming(Key key,
+                                                  ReadOptions options) {
+  return MapFutureValue(
+      InlineExecutor{},
+      [](ReadResult& read_result) {
+        StreamingReadResult result;
+        if (read_result.has_value()) {
+          result.value =
+              internal::CordStream::FromCord(std::move(read_result.value));
+          read_result.value = Value();
+        }
+        result.read_result = std::move(read_result);
+        return result;
+      },
+      Read(std::move(key), std::move(options)));
+}
+
 Future<TimestampedStorageGeneration> Driver::Write(Key key,
                                                    std::optional<Value> value,
                                                    WriteOptions options) {
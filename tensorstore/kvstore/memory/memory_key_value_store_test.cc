@@ -21,10 +21,13 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/context.h"
 #include "tensorstore/internal/cache_key/cache_key.h"
 #include "tensorstore/internal/json_gtest.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/test_util.h"
 #include "tensorstore/serialization/serialization.h"
 #include "tensorstore/serialization/test_util.h"
@@ -52,6 +55,24 @@ TEST(MemoryKeyValueStoreTest, Basic) {
   tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
 }
 
+// Tests the default `ReadStreaming` implementation.
+TEST(MemoryKeyValueStoreTest, ReadStreaming) {
+  auto store = tensorstore::GetMemoryKeyValueStore();
+  TENSORSTORE_ASSERT_OK(store->Write("a", absl::Cord("xyz")).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result,
+                                   store->ReadStreaming("a").result());
+  EXPECT_TRUE(result.read_result.has_value());
+  EXPECT_TRUE(result.read_result.value.empty());
+  ASSERT_TRUE(result.value);
+  EXPECT_THAT(result.value->ReadAll(),
+              ::testing::Optional(absl::Cord("xyz")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto missing,
+                                   store->ReadStreaming("b").result());
+  EXPECT_EQ(tensorstore::kvstore::ReadResult::kMissing,
+            missing.read_result.state);
+  EXPECT_FALSE(missing.value);
+}
+
 TEST(MemoryKeyValueStoreTest, DeleteRange) {
   auto store = tensorstore::GetMemoryKeyValueStore();
   TENSORSTORE_EXPECT_OK(store->Write("a/b", absl::Cord("xyz")));
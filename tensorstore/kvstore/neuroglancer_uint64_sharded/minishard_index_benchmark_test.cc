@@ -0,0 +1,133 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// Benchmarks lookups and decoding of large minishard indices.
+///
+/// The "Vector" variants use the `std::vector<MinishardIndexEntry>`
+/// representation with `FindChunkInMinishard`, while the "Compact" variants
+/// use `CompactMinishardIndex`, as used by the minishard index cache.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/random/random.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded_decoder.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded_encoder.h"
+
+namespace {
+
+using ::tensorstore::neuroglancer_uint64_sharded::ChunkId;
+using ::tensorstore::neuroglancer_uint64_sharded::CompactMinishardIndex;
+using ::tensorstore::neuroglancer_uint64_sharded::DecodeCompactMinishardIndex;
+using ::tensorstore::neuroglancer_uint64_sharded::
+    DecodeMinishardIndexAndAdjustByteRanges;
+using ::tensorstore::neuroglancer_uint64_sharded::EncodeMinishardIndex;
+using ::tensorstore::neuroglancer_uint64_sharded::FindChunkInMinishard;
+using ::tensorstore::neuroglancer_uint64_sharded::MinishardIndexEntry;
+using ::tensorstore::neuroglancer_uint64_sharded::ShardingSpec;
+
+constexpr size_t kNumLookups = 1024;
+
+// Returns a sorted minishard index with `size` entries whose chunk ids are
+// spaced randomly, as with hashed chunk ids.
+std::vector<MinishardIndexEntry> MakeMinishardIndex(size_t size) {
+  absl::BitGen gen;
+  std::vector<MinishardIndexEntry> entries(size);
+  uint64_t chunk_id = 0;
+  uint64_t offset = 0;
+  for (auto& entry : entries) {
+    chunk_id += absl::Uniform<uint64_t>(gen, 1, 1000);
+    entry.chunk_id = ChunkId{chunk_id};
+    entry.byte_range = {offset, offset + 100};
+    offset += 100;
+  }
+  return entries;
+}
+
+// Returns chunk ids to look up, half of which are present.
+std::vector<ChunkId> MakeLookups(
+    const std::vector<MinishardIndexEntry>& entries) {
+  absl::BitGen gen;
+  std::vector<ChunkId> chunk_ids(kNumLookups);
+  for (size_t i = 0; i < kNumLookups; ++i) {
+    const auto& entry =
+        entries[absl::Uniform<size_t>(gen, 0, entries.size())];
+    chunk_ids[i] = ChunkId{entry.chunk_id.value + (i % 2)};
+  }
+  return chunk_ids;
+}
+
+void BM_FindVector(benchmark::State& state) {
+  const auto entries = MakeMinishardIndex(state.range(0));
+  const auto chunk_ids = MakeLookups(entries);
+  for (auto s : state) {
+    for (const ChunkId chunk_id : chunk_ids) {
+      benchmark::DoNotOptimize(FindChunkInMinishard(entries, chunk_id));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLookups);
+}
+
+void BM_FindCompact(benchmark::State& state) {
+  const auto entries = MakeMinishardIndex(state.range(0));
+  const auto chunk_ids = MakeLookups(entries);
+  const CompactMinishardIndex minishard_index(entries);
+  for (auto s : state) {
+    for (const ChunkId chunk_id : chunk_ids) {
+      benchmark::DoNotOptimize(minishard_index.Find(chunk_id));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumLookups);
+}
+
+ShardingSpec GetShardingSpec() {
+  return ShardingSpec(ShardingSpec::HashFunction::murmurhash3_x86_128,
+                      /*preshift_bits=*/0, /*minishard_bits=*/6,
+                      /*shard_bits=*/10, ShardingSpec::DataEncoding::raw,
+                      ShardingSpec::DataEncoding::raw);
+}
+
+void BM_DecodeVector(benchmark::State& state) {
+  const absl::Cord encoded =
+      EncodeMinishardIndex(MakeMinishardIndex(state.range(0)));
+  const auto sharding_spec = GetShardingSpec();
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        DecodeMinishardIndexAndAdjustByteRanges(encoded, sharding_spec));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_DecodeCompact(benchmark::State& state) {
+  const absl::Cord encoded =
+      EncodeMinishardIndex(MakeMinishardIndex(state.range(0)));
+  const auto sharding_spec = GetShardingSpec();
+  for (auto s : state) {
+    benchmark::DoNotOptimize(
+        DecodeCompactMinishardIndex(encoded, sharding_spec));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_FindVector)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_FindCompact)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_DecodeVector)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_DecodeCompact)->Range(1 << 8, 1 << 20);
+
+}  // namespace
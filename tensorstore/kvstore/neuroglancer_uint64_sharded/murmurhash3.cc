@@ -14,6 +14,7 @@
 
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/murmurhash3.h"
 
+#include <cstddef>
 #include <cstdint>
 
 namespace tensorstore {
@@ -90,5 +91,44 @@ void MurmurHash3_x86_128Hash64Bits(std::uint64_t input, std::uint32_t h[4]) {
   h[3] = h4;
 }
 
+void MurmurHash3_x86_128Hash64BitsLow64(std::uint64_t* values,
+                                        std::size_t count) {
+  const std::uint32_t c1 = 0x239b961b;
+  const std::uint32_t c2 = 0xab0e9789;
+  const std::uint32_t c3 = 0x38b34ae5;
+  const std::uint32_t len = 8;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::uint64_t input = values[i];
+    const std::uint32_t low = static_cast<std::uint32_t>(input);
+    const std::uint32_t high = static_cast<std::uint32_t>(input >> 32);
+
+    std::uint32_t k2 = high * c2;
+    k2 = RotateLeft(k2, 16);
+    k2 *= c3;
+
+    std::uint32_t k1 = low * c1;
+    k1 = RotateLeft(k1, 15);
+    k1 *= c2;
+
+    // With a seed of 0, `h3 == h4` throughout.
+    std::uint32_t h1 = k1 ^ len;
+    std::uint32_t h2 = k2 ^ len;
+    std::uint32_t h3 = len;
+
+    h1 += h2 + h3 + h3;
+    h2 += h1;
+    h3 += h1;
+
+    h1 = MurmurHash3_x86_128Mix(h1);
+    h2 = MurmurHash3_x86_128Mix(h2);
+    h3 = MurmurHash3_x86_128Mix(h3);
+
+    h1 += h2 + h3 + h3;
+    h2 += h1;
+
+    values[i] = (static_cast<std::uint64_t>(h2) << 32) | h1;
+  }
+}
+
 }  // namespace neuroglancer_uint64_sharded
 }  // namespace tensorstore
@@ -15,6 +15,7 @@
 #ifndef TENSORSTORE_KVSTORE_NEUROGLANCER_UINT64_SHARDED_MURMURHASH3_H_
 #define TENSORSTORE_KVSTORE_NEUROGLANCER_UINT64_SHARDED_MURMURHASH3_H_
 
+#include <cstddef>
 #include <cstdint>
 
 namespace tensorstore {
@@ -30,6 +31,19 @@ namespace neuroglancer_uint64_sharded {
 /// \param h[in,out] On input, specifies the seed.  On output, equals the hash.
 void MurmurHash3_x86_128Hash64Bits(std::uint64_t input, std::uint32_t h[4]);
 
+/// Replaces each element of `values` with the low 64 bits of its
+/// MurmurHash3_x86_128 hash with a seed of 0.
+///
+/// Equivalent to calling `MurmurHash3_x86_128Hash64Bits` for each element and
+/// combining `h[1]` and `h[0]` into a 64-bit value, but uses only 32-bit
+/// arithmetic with no dependencies between elements, so that the loop may be
+/// vectorized by the compiler.
+///
+/// \param values[in,out] Pointer to array of length `count`.
+/// \param count Number of values.
+void MurmurHash3_x86_128Hash64BitsLow64(std::uint64_t* values,
+                                        std::size_t count);
+
 }  // namespace neuroglancer_uint64_sharded
 }  // namespace tensorstore
 
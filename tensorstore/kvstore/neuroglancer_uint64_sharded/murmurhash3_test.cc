@@ -15,6 +15,7 @@
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/murmurhash3.h"
 
 #include <cstdint>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -22,6 +23,8 @@
 namespace {
 
 using ::tensorstore::neuroglancer_uint64_sharded::MurmurHash3_x86_128Hash64Bits;
+using ::tensorstore::neuroglancer_uint64_sharded::
+    MurmurHash3_x86_128Hash64BitsLow64;
 
 // Test against examples computed using pymmh3 library
 TEST(MurmurHash3Test, Basic) {
@@ -73,4 +76,18 @@ TEST(MurmurHash3Test, Basic) {
                                      0x00000000082115eb, 0x00000000082115eb));
 }
 
+TEST(MurmurHash3Test, Low64) {
+  std::vector<std::uint64_t> values{0, 1, 42, 0xffffffff, 0x123456789abcdef,
+                                    ~std::uint64_t(0)};
+  auto hashes = values;
+  MurmurHash3_x86_128Hash64BitsLow64(hashes.data(), hashes.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    std::uint32_t h[4] = {0, 0, 0, 0};
+    MurmurHash3_x86_128Hash64Bits(values[i], h);
+    EXPECT_EQ((static_cast<std::uint64_t>(h[1]) << 32) | h[0], hashes[i])
+        << values[i];
+  }
+  EXPECT_EQ(0x4772b084e028ae41u, hashes[0]);
+}
+
 }  // namespace
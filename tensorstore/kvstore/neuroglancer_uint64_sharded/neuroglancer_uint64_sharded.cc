@@ -14,9 +14,14 @@
 
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/neuroglancer_uint64_sharded.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <numeric>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/base/internal/endian.h"
@@ -265,7 +270,7 @@ class MinishardIndexCache
       internal::KvsBackedCache<MinishardIndexCache, internal::AsyncCache>;
 
  public:
-  using ReadData = std::vector<MinishardIndexEntry>;
+  using ReadData = CompactMinishardIndex;
 
   class Entry : public Base::Entry {
    public:
@@ -291,7 +296,7 @@ class MinishardIndexCache
            receiver = std::move(receiver)]() mutable {
             std::shared_ptr<ReadData> read_data;
             if (value) {
-              if (auto result = DecodeMinishardIndexAndAdjustByteRanges(
+              if (auto result = DecodeCompactMinishardIndex(
                       *value, GetOwningCache(*this).sharding_spec());
                   result.ok()) {
                 read_data = std::make_shared<ReadData>(std::move(*result));
@@ -822,40 +827,54 @@ struct MinishardIndexCacheEntryReadyCallback {
   ChunkId chunk_id_;
   ReadOptions options_;
   void operator()(Promise<ReadResult> promise, ReadyFuture<const void>) {
-    std::optional<ByteRange> byte_range;
     TimestampedStorageGeneration stamp;
-    kvstore::ReadResult::State state;
+    std::shared_ptr<const MinishardIndexCache::ReadData> minishard_index;
     {
       auto lock = internal::AsyncCache::ReadLock<MinishardIndexCache::ReadData>(
           *entry_);
       stamp = lock.stamp();
-      if (!StorageGeneration::IsNoValue(stamp.generation) &&
-          (options_.if_not_equal == stamp.generation ||
-           (!StorageGeneration::IsUnknown(options_.if_equal) &&
-            options_.if_equal != stamp.generation))) {
-        state = kvstore::ReadResult::kUnspecified;
-      } else {
-        span<const MinishardIndexEntry> minishard_index;
-        if (lock.data()) minishard_index = *lock.data();
-        byte_range = FindChunkInMinishard(minishard_index, chunk_id_);
-        state = kvstore::ReadResult::kMissing;
-      }
+      minishard_index = lock.shared_data();
+    }
+    ReadChunk(std::move(entry_), stamp, minishard_index.get(), chunk_id_,
+              std::move(options_), std::move(promise));
+  }
+
+  /// Reads `chunk_id` given the minishard index contained in `entry`.
+  ///
+  /// \param stamp The generation of the minishard index.
+  /// \param minishard_index The decoded minishard index, or `nullptr` if the
+  ///     minishard is empty.
+  static void ReadChunk(internal::PinnedCacheEntry<MinishardIndexCache> entry,
+                        const TimestampedStorageGeneration& stamp,
+                        const MinishardIndexCache::ReadData* minishard_index,
+                        ChunkId chunk_id, ReadOptions options,
+                        Promise<ReadResult> promise) {
+    std::optional<ByteRange> byte_range;
+    kvstore::ReadResult::State state;
+    if (!StorageGeneration::IsNoValue(stamp.generation) &&
+        (options.if_not_equal == stamp.generation ||
+         (!StorageGeneration::IsUnknown(options.if_equal) &&
+          options.if_equal != stamp.generation))) {
+      state = kvstore::ReadResult::kUnspecified;
+    } else {
+      if (minishard_index) byte_range = minishard_index->Find(chunk_id);
+      state = kvstore::ReadResult::kMissing;
     }
     if (!byte_range) {
-      promise.SetResult(ReadResult{state, {}, std::move(stamp)});
+      promise.SetResult(ReadResult{state, {}, stamp});
       return;
     }
     assert(!StorageGeneration::IsUnknown(stamp.generation));
-    auto& cache = GetOwningCache(*entry_);
+    auto& cache = GetOwningCache(*entry);
     ReadOptions kvs_read_options;
     kvs_read_options.if_equal = stamp.generation;
-    kvs_read_options.staleness_bound = options_.staleness_bound;
-    assert(options_.byte_range.SatisfiesInvariants());
+    kvs_read_options.staleness_bound = options.staleness_bound;
+    assert(options.byte_range.SatisfiesInvariants());
     OptionalByteRangeRequest post_decode_byte_range;
     const auto data_encoding = cache.sharding_spec().data_encoding;
     if (data_encoding == ShardingSpec::DataEncoding::raw) {
       // Can apply requested byte range request directly.
-      if (auto result = options_.byte_range.Validate(byte_range->size())) {
+      if (auto result = options.byte_range.Validate(byte_range->size())) {
         kvs_read_options.byte_range =
             ByteRange{byte_range->inclusive_min + result->inclusive_min,
                       byte_range->inclusive_min + result->exclusive_max};
@@ -864,13 +883,13 @@ struct MinishardIndexCacheEntryReadyCallback {
         return;
       }
     } else {
-      post_decode_byte_range = options_.byte_range;
+      post_decode_byte_range = options.byte_range;
       kvs_read_options.byte_range = *byte_range;
     }
-    const auto shard = entry_->shard_info().shard;
+    const auto shard = entry->shard_info().shard;
     LinkValue(
-        [entry = std::move(entry_), chunk_id = chunk_id_,
-         options = std::move(options_), post_decode_byte_range,
+        [entry = std::move(entry), chunk_id, options = std::move(options),
+         post_decode_byte_range,
          data_encoding](Promise<ReadResult> promise,
                         ReadyFuture<ReadResult> future) mutable {
           auto& r = future.result();
@@ -919,6 +938,14 @@ struct MinishardIndexCacheEntryReadyCallback {
   }
 };
 
+/// Minishard index shared by a group of chunks read by
+/// `ShardedKeyValueStore::ReadChunks`.
+struct MinishardIndexSnapshot {
+  TimestampedStorageGeneration stamp;
+  /// `nullptr` if the minishard is empty.
+  std::shared_ptr<const MinishardIndexCache::ReadData> minishard_index;
+};
+
 }  // namespace
 
 struct ShardedKeyValueStoreSpecData {
@@ -1008,6 +1035,69 @@ class ShardedKeyValueStore
         .future;
   }
 
+  std::vector<Future<ReadResult>> ReadChunks(span<const ChunkId> chunk_ids,
+                                            ReadOptions options) {
+    std::vector<ChunkCombinedShardInfo> shard_infos(chunk_ids.size());
+    GetChunkShardInfo(sharding_spec(), chunk_ids, shard_infos);
+
+    // Group the chunks by shard and minishard.  The sort is stable so that
+    // the chunks within a minishard are read in the order requested.
+    std::vector<std::ptrdiff_t> order(chunk_ids.size());
+    std::iota(order.begin(), order.end(), std::ptrdiff_t(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::ptrdiff_t a, std::ptrdiff_t b) {
+                       return shard_infos[a].shard_and_minishard <
+                              shard_infos[b].shard_and_minishard;
+                     });
+
+    std::vector<Future<ReadResult>> futures(chunk_ids.size());
+    for (size_t group_start = 0, group_end; group_start < order.size();
+         group_start = group_end) {
+      const auto shard_info = shard_infos[order[group_start]];
+      for (group_end = group_start + 1;
+           group_end < order.size() &&
+           shard_infos[order[group_end]].shard_and_minishard ==
+               shard_info.shard_and_minishard;
+           ++group_end) {
+      }
+      auto entry = GetCacheEntry(
+          minishard_index_cache(),
+          std::string_view(reinterpret_cast<const char*>(&shard_info),
+                           sizeof(shard_info)));
+      // The minishard index is read once for the group.  The promise of each
+      // chunk is linked to the shared result, so that the read is cancelled
+      // once none of the chunks are needed.
+      auto minishard_index_future =
+          PromiseFuturePair<MinishardIndexSnapshot>::LinkValue(
+              WithExecutor(executor(),
+                           [entry](Promise<MinishardIndexSnapshot> promise,
+                                   ReadyFuture<const void> future) {
+                             auto lock = internal::AsyncCache::ReadLock<
+                                 MinishardIndexCache::ReadData>(*entry);
+                             promise.SetResult(MinishardIndexSnapshot{
+                                 lock.stamp(), lock.shared_data()});
+                           }),
+              entry->Read(options.staleness_bound))
+              .future;
+      for (size_t i = group_start; i < group_end; ++i) {
+        auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+        futures[order[i]] = std::move(future);
+        LinkValue(
+            [entry, chunk_id = chunk_ids[order[i]], options](
+                Promise<ReadResult> promise,
+                ReadyFuture<MinishardIndexSnapshot> future) mutable {
+              auto& snapshot = future.value();
+              MinishardIndexCacheEntryReadyCallback::ReadChunk(
+                  std::move(entry), snapshot.stamp,
+                  snapshot.minishard_index.get(), chunk_id, std::move(options),
+                  std::move(promise));
+            },
+            std::move(promise), minishard_index_future);
+      }
+    }
+    return futures;
+  }
+
   void ListImpl(ListOptions options,
                 AnyFlowReceiver<absl::Status, Key> receiver) override {
     struct State {
@@ -1194,6 +1284,20 @@ kvstore::DriverPtr GetShardedKeyValueStore(
       std::move(get_max_chunks_per_shard)));
 }
 
+std::vector<Future<kvstore::ReadResult>> ReadChunks(
+    kvstore::Driver* driver, span<const ChunkId> chunk_ids,
+    kvstore::ReadOptions options) {
+  if (auto* sharded_kvstore = dynamic_cast<ShardedKeyValueStore*>(driver)) {
+    return sharded_kvstore->ReadChunks(chunk_ids, std::move(options));
+  }
+  std::vector<Future<kvstore::ReadResult>> futures;
+  futures.reserve(chunk_ids.size());
+  for (const ChunkId chunk_id : chunk_ids) {
+    futures.push_back(driver->Read(ChunkIdToKey(chunk_id), options));
+  }
+  return futures;
+}
+
 std::string ChunkIdToKey(ChunkId chunk_id) {
   std::string key;
   key.resize(sizeof(uint64_t));
@@ -19,11 +19,16 @@
 #include <functional>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
+#include "tensorstore/kvstore/operations.h"
 #include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace neuroglancer_uint64_sharded {
@@ -99,6 +104,22 @@ kvstore::DriverPtr GetShardedKeyValueStore(
     const ShardingSpec& sharding_spec, internal::CachePool::WeakPtr cache_pool,
     GetMaxChunksPerShardFunction get_max_chunks_per_shard = {});
 
+/// Reads multiple chunks from a `KeyValueStore` returned from
+/// `GetShardedKeyValueStore`.
+///
+/// Equivalent to calling `driver->Read(ChunkIdToKey(chunk_id), options)` for
+/// each element of `chunk_ids`, but more efficient for large numbers of
+/// chunks: the shard and minishard of all chunks are computed together, and
+/// the minishard index is looked up only once for each distinct minishard.
+///
+/// If `driver` was not returned from `GetShardedKeyValueStore`, the chunks are
+/// read individually.
+///
+/// \returns A future for each element of `chunk_ids`, in the same order.
+std::vector<Future<kvstore::ReadResult>> ReadChunks(
+    kvstore::Driver* driver, span<const ChunkId> chunk_ids,
+    kvstore::ReadOptions options = {});
+
 /// Returns a key suitable for use with a `KeyValueStore` returned from
 /// `GetShardedKeyValueStore`.
 ///
@@ -15,6 +15,7 @@
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/neuroglancer_uint64_sharded.h"
 
 #include <functional>
+#include <set>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -31,6 +32,7 @@
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/memory/memory_key_value_store.h"
 #include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
 #include "tensorstore/kvstore/test_util.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/status.h"
@@ -57,8 +59,12 @@ using ::tensorstore::internal::MatchesTimestampedStorageGeneration;
 using ::tensorstore::internal::MockKeyValueStore;
 using ::tensorstore::internal::UniqueNow;
 using ::tensorstore::kvstore::ReadResult;
+using ::tensorstore::neuroglancer_uint64_sharded::ChunkId;
 using ::tensorstore::neuroglancer_uint64_sharded::ChunkIdToKey;
+using ::tensorstore::neuroglancer_uint64_sharded::GetChunkShardInfo;
 using ::tensorstore::neuroglancer_uint64_sharded::GetShardedKeyValueStore;
+using ::tensorstore::neuroglancer_uint64_sharded::GetSplitShardInfo;
+using ::tensorstore::neuroglancer_uint64_sharded::ReadChunks;
 using ::tensorstore::neuroglancer_uint64_sharded::ShardingSpec;
 
 constexpr CachePool::Limits kSmallCacheLimits{10000000, 5000000};
@@ -614,6 +620,96 @@ TEST_F(GzipEncodingTest, CorruptDataGzipEncoding) {
                             "Error decoding zlib-compressed data"));
 }
 
+TEST(Uint64ShardedKeyValueStoreTest, ReadChunks) {
+  ShardingSpec sharding_spec(ShardingSpec::HashFunction::murmurhash3_x86_128,
+                             /*preshift_bits=*/1, /*minishard_bits=*/2,
+                             /*shard_bits=*/2, ShardingSpec::DataEncoding::raw,
+                             ShardingSpec::DataEncoding::raw);
+  auto cache_pool = CachePool::Make(kSmallCacheLimits);
+  auto base_kv_store = tensorstore::GetMemoryKeyValueStore();
+  auto store = GetShardedKeyValueStore(
+      base_kv_store, tensorstore::InlineExecutor{}, "prefix", sharding_spec,
+      CachePool::WeakPtr(cache_pool));
+  std::vector<ChunkId> chunk_ids;
+  for (std::uint64_t i = 0; i < 100; ++i) {
+    chunk_ids.push_back({i * 7});
+    // Only even chunks are written.
+    if (i % 2 == 0) {
+      TENSORSTORE_ASSERT_OK(
+          store->Write(GetChunkKey(i * 7), absl::Cord(tensorstore::StrCat(i)))
+              .result());
+    }
+  }
+  // Duplicate chunk ids are permitted.
+  chunk_ids.push_back({0});
+
+  auto futures = ReadChunks(store.get(), chunk_ids);
+  ASSERT_EQ(chunk_ids.size(), futures.size());
+  for (size_t i = 0; i < chunk_ids.size(); ++i) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto expected, store->Read(GetChunkKey(chunk_ids[i].value)).result());
+    if (i % 2 == 0) {
+      EXPECT_THAT(futures[i].result(),
+                  MatchesKvsReadResult(expected.value,
+                                       expected.stamp.generation))
+          << i;
+    } else {
+      EXPECT_THAT(futures[i].result(), MatchesKvsReadResultNotFound()) << i;
+    }
+  }
+
+  // Drivers other than the sharded kvstore read the chunks individually.
+  futures = ReadChunks(base_kv_store.get(), {{ChunkId{0}}});
+  ASSERT_EQ(1, futures.size());
+  EXPECT_THAT(futures[0].result(), MatchesKvsReadResultNotFound());
+}
+
+// Tests that `ReadChunks` produces the same results as `Read` for chunks that
+// are present, missing from an existing minishard, in a missing minishard, and
+// in a missing shard.
+TEST(Uint64ShardedKeyValueStoreTest, ReadChunksMatchesRead) {
+  // With the identity hash, bit 0 of the chunk id is the minishard and bits 1
+  // and 2 are the shard.
+  ShardingSpec sharding_spec(ShardingSpec::HashFunction::identity,
+                             /*preshift_bits=*/0, /*minishard_bits=*/1,
+                             /*shard_bits=*/2, ShardingSpec::DataEncoding::gzip,
+                             ShardingSpec::DataEncoding::gzip);
+  auto cache_pool = CachePool::Make(kSmallCacheLimits);
+  auto base_kv_store = tensorstore::GetMemoryKeyValueStore();
+  auto store = GetShardedKeyValueStore(
+      base_kv_store, tensorstore::InlineExecutor{}, "prefix", sharding_spec,
+      CachePool::WeakPtr(cache_pool));
+  for (std::uint64_t id : {0, 1, 2}) {
+    TENSORSTORE_ASSERT_OK(
+        store->Write(GetChunkKey(id), absl::Cord(tensorstore::StrCat(id)))
+            .result());
+  }
+  // Chunk 8 is missing from minishard 0 of shard 0, chunk 3 is in the missing
+  // minishard 1 of shard 1, and chunks 4 and 6 are in missing shards.
+  std::vector<ChunkId> chunk_ids{{8}, {2}, {0}, {4}, {3}, {1}, {6}, {2}};
+  std::set<std::uint64_t> shards;
+  for (auto chunk_id : chunk_ids) {
+    shards.insert(
+        GetSplitShardInfo(sharding_spec,
+                          GetChunkShardInfo(sharding_spec, chunk_id))
+            .shard);
+  }
+  EXPECT_EQ(4, shards.size());
+
+  auto futures = ReadChunks(store.get(), chunk_ids);
+  ASSERT_EQ(chunk_ids.size(), futures.size());
+  for (size_t i = 0; i < chunk_ids.size(); ++i) {
+    const std::uint64_t id = chunk_ids[i].value;
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto expected,
+                                     store->Read(GetChunkKey(id)).result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto actual, futures[i].result());
+    EXPECT_EQ(expected.state, actual.state) << id;
+    EXPECT_EQ(expected.value, actual.value) << id;
+    EXPECT_EQ(expected.stamp.generation, actual.stamp.generation) << id;
+    EXPECT_EQ(id <= 2, actual.has_value()) << id;
+  }
+}
+
 // Tests of operations issued to underlying KeyValueStore.
 class UnderlyingKeyValueStoreTest : public ::testing::Test {
  protected:
@@ -1036,6 +1132,68 @@ TEST_F(UnderlyingKeyValueStoreTest,
   EXPECT_THAT(future.result(), MatchesKvsReadResultNotFound(read_time));
 }
 
+// Tests that chunks read with `ReadChunks` that share a minishard require only
+// a single lookup of the minishard index.
+TEST_F(UnderlyingKeyValueStoreTest, ReadChunks) {
+  // Chunks 0x50 and 0x60 are both in minishard 0 of shard 0, while chunk 0x51
+  // is in minishard 1 of shard 0.
+  auto futures = ReadChunks(store.get(), {{ChunkId{0x50}, ChunkId{0x51},
+                                           ChunkId{0x60}}});
+  {
+    auto req = mock_store->read_requests.pop_nonblock().value();
+    EXPECT_EQ("prefix/0.shard", req.key);
+    EXPECT_EQ(OptionalByteRangeRequest(0, 16), req.options.byte_range);
+    req.promise.SetResult(
+        ReadResult{ReadResult::kValue,
+                   Bytes({
+                       5, 0, 0, 0, 0, 0, 0, 0,   //
+                       31, 0, 0, 0, 0, 0, 0, 0,  //
+                   }),
+                   {StorageGeneration::FromString("g0"), absl::Now()}});
+  }
+  {
+    auto req = mock_store->read_requests.pop_nonblock().value();
+    EXPECT_EQ("prefix/0.shard", req.key);
+    EXPECT_EQ(OptionalByteRangeRequest(16, 32), req.options.byte_range);
+    req.promise.SetResult(ReadResult{
+        ReadResult::kMissing, {}, {StorageGeneration::NoValue(), absl::Now()}});
+  }
+  {
+    auto req = mock_store->read_requests.pop_nonblock().value();
+    EXPECT_EQ("prefix/0.shard", req.key);
+    EXPECT_EQ(OptionalByteRangeRequest(37, 63), req.options.byte_range);
+    req.promise.SetResult(ReadResult{
+        ReadResult::kValue,
+        Bytes({
+            0x50, 0, 0, 0, 0, 0, 0, 0,  //
+            0,    0, 0, 0, 0, 0, 0, 0,  //
+            5,    0, 0, 0, 0, 0, 0, 0,  //
+        }),
+        {StorageGeneration::FromString("g0"), absl::Now()}});
+  }
+  absl::Time read_time;
+  {
+    auto req = mock_store->read_requests.pop_nonblock().value();
+    ASSERT_EQ(0, mock_store->read_requests.size());
+    EXPECT_EQ("prefix/0.shard", req.key);
+    EXPECT_EQ(StorageGeneration::FromString("g0"), req.options.if_equal);
+    EXPECT_EQ(OptionalByteRangeRequest(32, 37), req.options.byte_range);
+    read_time = absl::Now();
+    req.promise.SetResult(
+        ReadResult{ReadResult::kValue,
+                   Bytes({5, 6, 7, 8, 9}),
+                   {StorageGeneration::FromString("g0"), read_time}});
+  }
+  ASSERT_EQ(0, mock_store->read_requests.size());
+  ASSERT_EQ(3, futures.size());
+  EXPECT_THAT(
+      futures[0].result(),
+      MatchesKvsReadResult(Bytes({5, 6, 7, 8, 9}),
+                           StorageGeneration::FromString("g0"), read_time));
+  EXPECT_THAT(futures[1].result(), MatchesKvsReadResultNotFound());
+  EXPECT_THAT(futures[2].result(), MatchesKvsReadResultNotFound());
+}
+
 TEST_F(UnderlyingKeyValueStoreTest, ReadErrorReadingShardIndex) {
   auto future = store->Read(GetChunkKey(0x50), {});
   {
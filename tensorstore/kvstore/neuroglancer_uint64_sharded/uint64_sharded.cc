@@ -15,6 +15,8 @@
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 
 #include "absl/base/optimization.h"
 #include "absl/strings/str_format.h"
@@ -160,6 +162,33 @@ ChunkCombinedShardInfo GetChunkShardInfo(const ShardingSpec& sharding_spec,
   return result;
 }
 
+void GetChunkShardInfo(const ShardingSpec& sharding_spec,
+                       span<const ChunkId> chunk_ids,
+                       span<ChunkCombinedShardInfo> shard_infos) {
+  assert(chunk_ids.size() == shard_infos.size());
+  const std::uint64_t mask =
+      GetLowBitMask(sharding_spec.minishard_bits + sharding_spec.shard_bits);
+  // Hash in fixed-size blocks to avoid allocating a temporary buffer.
+  constexpr std::ptrdiff_t kBlockSize = 256;
+  std::uint64_t block[kBlockSize];
+  for (std::ptrdiff_t start = 0; start < chunk_ids.size();
+       start += kBlockSize) {
+    const std::ptrdiff_t count =
+        std::min(kBlockSize, chunk_ids.size() - start);
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      block[i] = ShiftRightUpTo64(chunk_ids[start + i].value,
+                                  sharding_spec.preshift_bits);
+    }
+    if (sharding_spec.hash_function ==
+        ShardingSpec::HashFunction::murmurhash3_x86_128) {
+      MurmurHash3_x86_128Hash64BitsLow64(block, count);
+    }
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      shard_infos[start + i].shard_and_minishard = block[i] & mask;
+    }
+  }
+}
+
 ChunkSplitShardInfo GetSplitShardInfo(const ShardingSpec& sharding_spec,
                                       ChunkCombinedShardInfo combined_info) {
   ChunkSplitShardInfo result;
@@ -14,9 +14,16 @@
 
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded_decoder.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/status/status.h"
 #include "tensorstore/internal/compression/zlib.h"
 #include "tensorstore/internal/cord_util.h"
 #include "tensorstore/util/str_cat.h"
@@ -24,8 +31,14 @@
 namespace tensorstore {
 namespace neuroglancer_uint64_sharded {
 
-Result<std::vector<MinishardIndexEntry>> DecodeMinishardIndex(
-    const absl::Cord& input, ShardingSpec::DataEncoding encoding) {
+namespace {
+
+/// Decodes a minishard index into separate arrays of chunk ids and byte
+/// ranges, in the order in which they are stored.
+absl::Status DecodeMinishardIndexArrays(const absl::Cord& input,
+                                        ShardingSpec::DataEncoding encoding,
+                                        std::vector<std::uint64_t>& chunk_ids,
+                                        std::vector<ByteRange>& byte_ranges) {
   absl::Cord decoded_input;
   if (encoding != ShardingSpec::DataEncoding::raw) {
     TENSORSTORE_ASSIGN_OR_RETURN(decoded_input, DecodeData(input, encoding));
@@ -36,27 +49,44 @@ Result<std::vector<MinishardIndexEntry>> DecodeMinishardIndex(
     return absl::InvalidArgumentError(tensorstore::StrCat(
         "Invalid minishard index length: ", decoded_input.size()));
   }
-  std::vector<MinishardIndexEntry> result(decoded_input.size() / 24);
-  static_assert(sizeof(MinishardIndexEntry) == 24);
+  const size_t n = decoded_input.size() / 24;
+  chunk_ids.resize(n);
+  byte_ranges.resize(n);
   auto decoded_flat = decoded_input.Flatten();
-  ChunkId chunk_id{0};
+  std::uint64_t chunk_id = 0;
   std::uint64_t byte_offset = 0;
-  for (size_t i = 0; i < result.size(); ++i) {
-    auto& entry = result[i];
-    chunk_id.value += absl::little_endian::Load64(decoded_flat.data() + i * 8);
-    entry.chunk_id = chunk_id;
-    byte_offset += absl::little_endian::Load64(decoded_flat.data() + i * 8 +
-                                               8 * result.size());
-    entry.byte_range.inclusive_min = byte_offset;
-    byte_offset += absl::little_endian::Load64(decoded_flat.data() + i * 8 +
-                                               16 * result.size());
-    entry.byte_range.exclusive_max = byte_offset;
-    if (!entry.byte_range.SatisfiesInvariants()) {
+  for (size_t i = 0; i < n; ++i) {
+    chunk_id += absl::little_endian::Load64(decoded_flat.data() + i * 8);
+    chunk_ids[i] = chunk_id;
+    auto& byte_range = byte_ranges[i];
+    byte_offset +=
+        absl::little_endian::Load64(decoded_flat.data() + i * 8 + 8 * n);
+    byte_range.inclusive_min = byte_offset;
+    byte_offset +=
+        absl::little_endian::Load64(decoded_flat.data() + i * 8 + 16 * n);
+    byte_range.exclusive_max = byte_offset;
+    if (!byte_range.SatisfiesInvariants()) {
       return absl::InvalidArgumentError(tensorstore::StrCat(
-          "Invalid byte range in minishard index for chunk ",
-          entry.chunk_id.value, ": ", entry.byte_range));
+          "Invalid byte range in minishard index for chunk ", chunk_id, ": ",
+          byte_range));
     }
   }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+Result<std::vector<MinishardIndexEntry>> DecodeMinishardIndex(
+    const absl::Cord& input, ShardingSpec::DataEncoding encoding) {
+  std::vector<std::uint64_t> chunk_ids;
+  std::vector<ByteRange> byte_ranges;
+  TENSORSTORE_RETURN_IF_ERROR(
+      DecodeMinishardIndexArrays(input, encoding, chunk_ids, byte_ranges));
+  std::vector<MinishardIndexEntry> result(chunk_ids.size());
+  static_assert(sizeof(MinishardIndexEntry) == 24);
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i] = MinishardIndexEntry{{chunk_ids[i]}, byte_ranges[i]};
+  }
   absl::c_sort(result,
                [](const MinishardIndexEntry& a, const MinishardIndexEntry& b) {
                  return a.chunk_id.value < b.chunk_id.value;
@@ -64,6 +94,80 @@ Result<std::vector<MinishardIndexEntry>> DecodeMinishardIndex(
   return result;
 }
 
+CompactMinishardIndex::CompactMinishardIndex(
+    span<const MinishardIndexEntry> entries) {
+  std::vector<MinishardIndexEntry> sorted_entries(entries.begin(),
+                                                  entries.end());
+  absl::c_sort(sorted_entries,
+               [](const MinishardIndexEntry& a, const MinishardIndexEntry& b) {
+                 return a.chunk_id.value < b.chunk_id.value;
+               });
+  chunk_ids_.resize(sorted_entries.size());
+  byte_ranges_.resize(sorted_entries.size());
+  for (size_t i = 0; i < sorted_entries.size(); ++i) {
+    chunk_ids_[i] = sorted_entries[i].chunk_id.value;
+    byte_ranges_[i] = sorted_entries[i].byte_range;
+  }
+}
+
+CompactMinishardIndex::CompactMinishardIndex(
+    std::vector<std::uint64_t> chunk_ids, std::vector<ByteRange> byte_ranges)
+    : chunk_ids_(std::move(chunk_ids)), byte_ranges_(std::move(byte_ranges)) {
+  assert(chunk_ids_.size() == byte_ranges_.size());
+  assert(std::is_sorted(chunk_ids_.begin(), chunk_ids_.end()));
+}
+
+std::optional<ByteRange> CompactMinishardIndex::Find(ChunkId chunk_id) const {
+  const size_t size = chunk_ids_.size();
+  if (size == 0) return std::nullopt;
+  // Branchless lower bound: the loop has a fixed number of iterations for a
+  // given `size`, and the comparison compiles to a conditional move.
+  const std::uint64_t* base = chunk_ids_.data();
+  for (size_t n = size; n > 1;) {
+    const size_t half = n / 2;
+    base = (base[half] < chunk_id.value) ? base + half : base;
+    n -= half;
+  }
+  base += (*base < chunk_id.value);
+  const size_t i = base - chunk_ids_.data();
+  if (i == size || chunk_ids_[i] != chunk_id.value) return std::nullopt;
+  return byte_ranges_[i];
+}
+
+Result<CompactMinishardIndex> DecodeCompactMinishardIndex(
+    const absl::Cord& encoded, const ShardingSpec& sharding_spec) {
+  std::vector<std::uint64_t> chunk_ids;
+  std::vector<ByteRange> byte_ranges;
+  TENSORSTORE_RETURN_IF_ERROR(DecodeMinishardIndexArrays(
+      encoded, sharding_spec.minishard_index_encoding, chunk_ids, byte_ranges));
+  for (size_t i = 0; i < chunk_ids.size(); ++i) {
+    auto result = GetAbsoluteShardByteRange(byte_ranges[i], sharding_spec);
+    if (!result.ok()) {
+      return MaybeAnnotateStatus(
+          result.status(),
+          tensorstore::StrCat("Error decoding minishard index entry for chunk ",
+                              chunk_ids[i]));
+    }
+    byte_ranges[i] = *result;
+  }
+  if (!std::is_sorted(chunk_ids.begin(), chunk_ids.end())) {
+    std::vector<size_t> order(chunk_ids.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return chunk_ids[a] < chunk_ids[b];
+    });
+    std::vector<std::uint64_t> sorted_chunk_ids(chunk_ids.size());
+    std::vector<ByteRange> sorted_byte_ranges(chunk_ids.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      sorted_chunk_ids[i] = chunk_ids[order[i]];
+      sorted_byte_ranges[i] = byte_ranges[order[i]];
+    }
+    chunk_ids = std::move(sorted_chunk_ids);
+    byte_ranges = std::move(sorted_byte_ranges);
+  }
+  return CompactMinishardIndex(std::move(chunk_ids), std::move(byte_ranges));
+}
+
 std::optional<ByteRange> FindChunkInMinishard(
     span<const MinishardIndexEntry> minishard_index, ChunkId chunk_id) {
   auto it =
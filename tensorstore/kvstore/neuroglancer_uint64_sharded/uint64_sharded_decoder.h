@@ -21,10 +21,14 @@
 /// See description of format here:
 /// https://github.com/google/neuroglancer/tree/master/src/neuroglancer/datasource/precomputed#sharded-format
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string_view>
 #include <vector>
 
+#include "absl/strings/cord.h"
+#include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
 #include "tensorstore/util/endian.h"
 #include "tensorstore/util/result.h"
@@ -51,6 +55,58 @@ Result<std::vector<MinishardIndexEntry>> DecodeMinishardIndex(
 std::optional<ByteRange> FindChunkInMinishard(
     span<const MinishardIndexEntry> minishard_index, ChunkId chunk_id);
 
+/// Decoded minishard index, in a compact form optimized for lookups.
+///
+/// The sorted chunk ids are stored separately from the byte ranges, so that a
+/// lookup, which performs a branchless binary search, only accesses the 8-byte
+/// chunk ids rather than entire 24-byte `MinishardIndexEntry` values.
+///
+/// Instances are immutable once constructed, and may be shared by reference
+/// among concurrent lookups.
+class CompactMinishardIndex {
+ public:
+  CompactMinishardIndex() = default;
+
+  /// Constructs from a list of entries, which need not be sorted.
+  explicit CompactMinishardIndex(span<const MinishardIndexEntry> entries);
+
+  /// Constructs from separate arrays of chunk ids and byte ranges.
+  ///
+  /// \pre `chunk_ids` is sorted.
+  /// \dchecks `chunk_ids.size() == byte_ranges.size()`
+  explicit CompactMinishardIndex(std::vector<std::uint64_t> chunk_ids,
+                                 std::vector<ByteRange> byte_ranges);
+
+  /// Returns the number of entries.
+  std::size_t size() const { return chunk_ids_.size(); }
+
+  /// Returns the entry at position `i`, in order of chunk id.
+  MinishardIndexEntry operator[](std::size_t i) const {
+    return {{chunk_ids_[i]}, byte_ranges_[i]};
+  }
+
+  /// Looks up the byte range associated with `chunk_id`.
+  ///
+  /// \returns The byte range, or `std::nullopt` if `chunk_id` is not found.
+  std::optional<ByteRange> Find(ChunkId chunk_id) const;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.chunk_ids_, x.byte_ranges_);
+  };
+
+ private:
+  std::vector<std::uint64_t> chunk_ids_;
+  std::vector<ByteRange> byte_ranges_;
+};
+
+/// Same as `DecodeMinishardIndexAndAdjustByteRanges`, but returns the
+/// minishard index in compact form.
+///
+/// Avoids sorting in the common case that the entries are already stored in
+/// order of chunk id.
+Result<CompactMinishardIndex> DecodeCompactMinishardIndex(
+    const absl::Cord& encoded, const ShardingSpec& sharding_spec);
+
 /// Decodes a string with a given `ShardingSpec::DataEncoding`.
 ///
 /// \returns The decoded string.
@@ -14,6 +14,10 @@
 
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded_decoder.h"
 
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "tensorstore/internal/compression/zlib.h"
@@ -25,7 +29,11 @@
 namespace {
 
 namespace zlib = tensorstore::zlib;
+using ::tensorstore::ByteRange;
 using ::tensorstore::MatchesStatus;
+using ::tensorstore::neuroglancer_uint64_sharded::ChunkId;
+using ::tensorstore::neuroglancer_uint64_sharded::CompactMinishardIndex;
+using ::tensorstore::neuroglancer_uint64_sharded::DecodeCompactMinishardIndex;
 using ::tensorstore::neuroglancer_uint64_sharded::DecodeMinishardIndex;
 using ::tensorstore::neuroglancer_uint64_sharded::EncodeMinishardIndex;
 using ::tensorstore::neuroglancer_uint64_sharded::MinishardIndexEntry;
@@ -94,4 +102,97 @@ TEST(DecodeMinishardIndexTest, InvalidInterval) {
           "Invalid byte range in minishard index for chunk 3: \\[1, 0\\)"));
 }
 
+std::vector<MinishardIndexEntry> GetEntries(
+    const CompactMinishardIndex& minishard_index) {
+  std::vector<MinishardIndexEntry> entries;
+  for (size_t i = 0; i < minishard_index.size(); ++i) {
+    entries.push_back(minishard_index[i]);
+  }
+  return entries;
+}
+
+TEST(CompactMinishardIndexTest, Empty) {
+  CompactMinishardIndex minishard_index;
+  EXPECT_EQ(0, minishard_index.size());
+  EXPECT_EQ(std::nullopt, minishard_index.Find(ChunkId{0}));
+}
+
+TEST(CompactMinishardIndexTest, Find) {
+  // Entries need not be sorted.
+  CompactMinishardIndex minishard_index(std::vector<MinishardIndexEntry>{
+      {{7}, {12, 15}},
+      {{1}, {3, 10}},
+      {{~std::uint64_t(0)}, {20, 21}},
+      {{5}, {10, 12}},
+  });
+  EXPECT_THAT(GetEntries(minishard_index),
+              ::testing::ElementsAre(
+                  MinishardIndexEntry{{1}, {3, 10}},
+                  MinishardIndexEntry{{5}, {10, 12}},
+                  MinishardIndexEntry{{7}, {12, 15}},
+                  MinishardIndexEntry{{~std::uint64_t(0)}, {20, 21}}));
+  EXPECT_EQ(ByteRange({3, 10}), minishard_index.Find(ChunkId{1}));
+  EXPECT_EQ(ByteRange({10, 12}), minishard_index.Find(ChunkId{5}));
+  EXPECT_EQ(ByteRange({12, 15}), minishard_index.Find(ChunkId{7}));
+  EXPECT_EQ(ByteRange({20, 21}),
+            minishard_index.Find(ChunkId{~std::uint64_t(0)}));
+  EXPECT_EQ(std::nullopt, minishard_index.Find(ChunkId{0}));
+  EXPECT_EQ(std::nullopt, minishard_index.Find(ChunkId{2}));
+  EXPECT_EQ(std::nullopt, minishard_index.Find(ChunkId{6}));
+  EXPECT_EQ(std::nullopt, minishard_index.Find(ChunkId{8}));
+}
+
+TEST(CompactMinishardIndexTest, FindMany) {
+  std::vector<MinishardIndexEntry> entries;
+  for (std::uint64_t i = 0; i < 1000; ++i) {
+    entries.push_back({{i * 3}, {i, i + 1}});
+  }
+  CompactMinishardIndex minishard_index(entries);
+  for (std::uint64_t chunk_id = 0; chunk_id < 3002; ++chunk_id) {
+    std::optional<ByteRange> expected;
+    if (chunk_id % 3 == 0 && chunk_id < 3000) {
+      expected = ByteRange{chunk_id / 3, chunk_id / 3 + 1};
+    }
+    EXPECT_EQ(expected, minishard_index.Find(ChunkId{chunk_id})) << chunk_id;
+  }
+}
+
+TEST(DecodeCompactMinishardIndexTest, Basic) {
+  ShardingSpec sharding_spec(ShardingSpec::HashFunction::identity,
+                             /*preshift_bits=*/0, /*minishard_bits=*/1,
+                             /*shard_bits=*/0, ShardingSpec::DataEncoding::raw,
+                             ShardingSpec::DataEncoding::gzip);
+  // Byte ranges are adjusted by the size of the shard index, which is 32
+  // bytes.
+  std::vector<MinishardIndexEntry> minishard_index{
+      {{7}, {12, 15}},
+      {{1}, {3, 10}},
+  };
+  absl::Cord compressed;
+  zlib::Options options{/*.level=*/9, /*.use_gzip_header=*/true};
+  zlib::Encode(EncodeMinishardIndex(minishard_index), &compressed, options);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto decoded, DecodeCompactMinishardIndex(compressed, sharding_spec));
+  EXPECT_THAT(GetEntries(decoded),
+              ::testing::ElementsAre(MinishardIndexEntry{{1}, {35, 42}},
+                                     MinishardIndexEntry{{7}, {44, 47}}));
+}
+
+TEST(DecodeCompactMinishardIndexTest, Invalid) {
+  ShardingSpec sharding_spec(ShardingSpec::HashFunction::identity,
+                             /*preshift_bits=*/0, /*minishard_bits=*/1,
+                             /*shard_bits=*/0, ShardingSpec::DataEncoding::raw,
+                             ShardingSpec::DataEncoding::raw);
+  EXPECT_THAT(DecodeCompactMinishardIndex(absl::Cord("abc"), sharding_spec),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Invalid minishard index length: 3"));
+  std::vector<MinishardIndexEntry> minishard_index{
+      {{3}, {1, ~std::uint64_t(0) - 1}}};
+  EXPECT_THAT(
+      DecodeCompactMinishardIndex(EncodeMinishardIndex(minishard_index),
+                                  sharding_spec),
+      MatchesStatus(absl::StatusCode::kFailedPrecondition,
+                    "Error decoding minishard index entry for chunk 3: .*"));
+}
+
 }  // namespace
@@ -14,6 +14,10 @@
 
 #include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "tensorstore/internal/json_gtest.h"
@@ -24,6 +28,9 @@
 namespace {
 
 using ::tensorstore::MatchesStatus;
+using ::tensorstore::neuroglancer_uint64_sharded::ChunkCombinedShardInfo;
+using ::tensorstore::neuroglancer_uint64_sharded::ChunkId;
+using ::tensorstore::neuroglancer_uint64_sharded::GetChunkShardInfo;
 using ::tensorstore::neuroglancer_uint64_sharded::MinishardIndexEntry;
 using ::tensorstore::neuroglancer_uint64_sharded::ShardingSpec;
 
@@ -356,4 +363,34 @@ TEST(MinishardIndexEntryTest, Comparison) {
   EXPECT_NE(c, d);
 }
 
+TEST(GetChunkShardInfoTest, Batch) {
+  std::vector<ChunkId> chunk_ids;
+  // Exceeds the internal block size.
+  for (std::uint64_t i = 0; i < 600; ++i) {
+    chunk_ids.push_back({i * 0x9e3779b97f4a7c15u});
+  }
+  chunk_ids.push_back({0});
+  chunk_ids.push_back({~std::uint64_t(0)});
+  for (auto hash_function : {ShardingSpec::HashFunction::identity,
+                             ShardingSpec::HashFunction::murmurhash3_x86_128}) {
+    for (int preshift_bits : {0, 3, 64}) {
+      for (auto [minishard_bits, shard_bits] :
+           {std::pair{0, 0}, std::pair{6, 10}, std::pair{20, 44}}) {
+        ShardingSpec sharding_spec(hash_function, preshift_bits,
+                                   minishard_bits, shard_bits,
+                                   ShardingSpec::DataEncoding::raw,
+                                   ShardingSpec::DataEncoding::raw);
+        std::vector<ChunkCombinedShardInfo> shard_infos(chunk_ids.size());
+        GetChunkShardInfo(sharding_spec, chunk_ids, shard_infos);
+        for (size_t i = 0; i < chunk_ids.size(); ++i) {
+          EXPECT_EQ(GetChunkShardInfo(sharding_spec, chunk_ids[i])
+                        .shard_and_minishard,
+                    shard_infos[i].shard_and_minishard)
+              << sharding_spec << " " << chunk_ids[i].value;
+        }
+      }
+    }
+  }
+}
+
 }  // namespace
@@ -0,0 +1,271 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/parallel_read.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_kvstore {
+namespace {
+
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::kvstore::ReadResult;
+
+struct ParallelReadState
+    : public internal::AtomicReferenceCount<ParallelReadState> {
+  kvstore::ReadOptions options;
+  ParallelReadOptions parallel_options;
+  ReadPartFunction read_part;
+  Promise<ReadResult> promise;
+
+  absl::Mutex mutex;
+  /// Incremented each time the read is restarted, so that parts of earlier
+  /// attempts are ignored.
+  size_t attempt ABSL_GUARDED_BY(mutex) = 0;
+  /// Result of the first part of the current attempt, with an empty value.
+  ReadResult result ABSL_GUARDED_BY(mutex);
+  /// Requested byte range, validated against the size of the value.
+  ByteRange byte_range ABSL_GUARDED_BY(mutex);
+  std::vector<absl::Cord> parts ABSL_GUARDED_BY(mutex);
+  size_t next_part ABSL_GUARDED_BY(mutex) = 0;
+  size_t remaining_parts ABSL_GUARDED_BY(mutex) = 0;
+
+  /// Reads the first part of the specified attempt.
+  void Start(size_t current_attempt);
+
+  /// Restarts the read, unless `current_attempt` is no longer current.
+  void Restart(size_t current_attempt);
+
+  /// Completes the read with a single non-partial request.
+  void ReadWhole();
+
+  void OnFirstPart(size_t attempt, Result<ReadPartResult> part_result);
+
+  /// Issues the request for the specified part of the current attempt.
+  void StartPart(size_t attempt, size_t part_index);
+
+  void OnPart(size_t attempt, size_t part_index,
+              Result<ReadPartResult> part_result);
+
+  /// Returns the byte range of the specified part.
+  ByteRange GetPartByteRange(size_t part_index)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+    const uint64_t part_size = parallel_options.part_size;
+    const uint64_t inclusive_min =
+        byte_range.inclusive_min + part_index * part_size;
+    return ByteRange{inclusive_min, std::min(byte_range.exclusive_max,
+                                             inclusive_min + part_size)};
+  }
+};
+
+void ParallelReadState::Start(size_t current_attempt) {
+  if (!promise.result_needed()) return;
+  kvstore::ReadOptions part_options = options;
+  uint64_t exclusive_max =
+      options.byte_range.inclusive_min + parallel_options.part_size;
+  if (options.byte_range.exclusive_max) {
+    exclusive_max = std::min(exclusive_max, *options.byte_range.exclusive_max);
+  }
+  part_options.byte_range.exclusive_max = exclusive_max;
+  read_part(std::move(part_options), /*partial=*/true)
+      .ExecuteWhenReady([self = IntrusivePtr<ParallelReadState>(this),
+                         current_attempt](ReadyFuture<ReadPartResult> future) {
+        self->OnFirstPart(current_attempt, std::move(future.result()));
+      });
+}
+
+void ParallelReadState::Restart(size_t current_attempt) {
+  {
+    absl::MutexLock lock(&mutex);
+    if (current_attempt != attempt) return;
+    current_attempt = ++attempt;
+  }
+  Start(current_attempt);
+}
+
+void ParallelReadState::ReadWhole() {
+  LinkResult(promise, MapFutureValue(
+                          InlineExecutor{},
+                          [](ReadPartResult& part_result) {
+                            return std::move(part_result.read_result);
+                          },
+                          read_part(options, /*partial=*/false)));
+}
+
+void ParallelReadState::OnFirstPart(size_t current_attempt,
+                                    Result<ReadPartResult> part_result) {
+  if (!promise.result_needed()) return;
+  if (!part_result.ok()) {
+    if (absl::IsOutOfRange(part_result.status())) {
+      ReadWhole();
+    } else {
+      promise.SetResult(part_result.status());
+    }
+    return;
+  }
+  auto& read_result = part_result->read_result;
+  if (!read_result.has_value()) {
+    promise.SetResult(std::move(read_result));
+    return;
+  }
+  auto byte_range_result =
+      options.byte_range.Validate(part_result->value_size);
+  if (!byte_range_result.ok()) {
+    promise.SetResult(byte_range_result.status());
+    return;
+  }
+  const uint64_t part_size = parallel_options.part_size;
+  const size_t num_parts =
+      (byte_range_result->size() + part_size - 1) / part_size;
+  if (num_parts <= 1) {
+    promise.SetResult(std::move(read_result));
+    return;
+  }
+  if (!StorageGeneration::IsCleanValidValue(read_result.stamp.generation)) {
+    // The remaining parts cannot be guaranteed to be consistent with the
+    // first part.
+    ReadWhole();
+    return;
+  }
+  size_t num_to_start;
+  {
+    absl::MutexLock lock(&mutex);
+    if (current_attempt != attempt) return;
+    byte_range = *byte_range_result;
+    const uint64_t expected_size = GetPartByteRange(0).size();
+    if (read_result.value.size() != expected_size) {
+      promise.SetResult(absl::DataLossError(tensorstore::StrCat(
+          "Expected ", expected_size, " bytes but received ",
+          read_result.value.size())));
+      return;
+    }
+    parts.clear();
+    parts.resize(num_parts);
+    parts[0] = std::move(read_result.value);
+    result = std::move(read_result);
+    result.value.Clear();
+    remaining_parts = num_parts - 1;
+    num_to_start = std::min(parallel_options.max_concurrency, num_parts - 1);
+    next_part = 1 + num_to_start;
+  }
+  for (size_t i = 1; i <= num_to_start; ++i) {
+    StartPart(current_attempt, i);
+  }
+}
+
+void ParallelReadState::StartPart(size_t current_attempt, size_t part_index) {
+  if (!promise.result_needed()) return;
+  kvstore::ReadOptions part_options;
+  {
+    absl::MutexLock lock(&mutex);
+    if (current_attempt != attempt) return;
+    part_options.byte_range = GetPartByteRange(part_index);
+    part_options.if_equal = result.stamp.generation;
+  }
+  part_options.staleness_bound = options.staleness_bound;
+  read_part(std::move(part_options), /*partial=*/false)
+      .ExecuteWhenReady([self = IntrusivePtr<ParallelReadState>(this),
+                         current_attempt,
+                         part_index](ReadyFuture<ReadPartResult> future) {
+        self->OnPart(current_attempt, part_index, std::move(future.result()));
+      });
+}
+
+void ParallelReadState::OnPart(size_t current_attempt, size_t part_index,
+                               Result<ReadPartResult> part_result) {
+  if (!promise.result_needed()) return;
+  if (!part_result.ok()) {
+    promise.SetResult(part_result.status());
+    return;
+  }
+  auto& read_result = part_result->read_result;
+  if (!read_result.has_value()) {
+    // The value changed since the first part was read.
+    Restart(current_attempt);
+    return;
+  }
+  size_t next_part_index;
+  std::optional<ReadResult> complete_result;
+  {
+    absl::MutexLock lock(&mutex);
+    if (current_attempt != attempt) return;
+    parts[part_index] = std::move(read_result.value);
+    next_part_index = next_part < parts.size() ? next_part++ : 0;
+    if (--remaining_parts == 0) {
+      complete_result = std::move(result);
+      for (auto& part : parts) {
+        complete_result->value.Append(std::move(part));
+      }
+      parts.clear();
+    }
+  }
+  if (complete_result) {
+    promise.SetResult(*std::move(complete_result));
+  } else if (next_part_index != 0) {
+    StartPart(current_attempt, next_part_index);
+  }
+}
+
+}  // namespace
+
+bool ShouldReadInParallel(const kvstore::ReadOptions& options,
+                          const ParallelReadOptions& parallel_options) {
+  if (parallel_options.part_size == 0) return false;
+  const auto& byte_range = options.byte_range;
+  return !byte_range.exclusive_max ||
+         *byte_range.exclusive_max - byte_range.inclusive_min >
+             parallel_options.part_size;
+}
+
+Future<ReadResult> ParallelRead(kvstore::ReadOptions options,
+                                const ParallelReadOptions& parallel_options,
+                                ReadPartFunction read_part) {
+  assert(parallel_options.part_size > 0);
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  auto state = internal::MakeIntrusivePtr<ParallelReadState>();
+  state->options = std::move(options);
+  state->parallel_options = parallel_options;
+  state->parallel_options.max_concurrency =
+      std::max<size_t>(1, parallel_options.max_concurrency);
+  state->read_part = std::move(read_part);
+  state->promise = std::move(promise);
+  state->Start(/*current_attempt=*/0);
+  return std::move(future);
+}
+
+}  // namespace internal_kvstore
+}  // namespace tensorstore
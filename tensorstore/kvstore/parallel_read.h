@@ -0,0 +1,91 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_PARALLEL_READ_H_
+#define TENSORSTORE_KVSTORE_PARALLEL_READ_H_
+
+/// \file
+///
+/// Support for kvstore drivers that read large values as multiple concurrent
+/// byte range requests, rather than as a single request whose throughput is
+/// limited by a single connection.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_kvstore {
+
+struct ParallelReadOptions {
+  /// Maximum number of bytes read by each request.  If `0`, values are always
+  /// read by a single request.
+  uint64_t part_size = 0;
+
+  /// Maximum number of concurrent requests for a single value.
+  size_t max_concurrency = 1;
+};
+
+/// Result of a single request issued by `ParallelRead`.
+struct ReadPartResult {
+  kvstore::ReadResult read_result;
+
+  /// Total size of the value.  Only meaningful if `read_result.has_value()`.
+  uint64_t value_size = 0;
+};
+
+/// Reads a single byte range of a value.
+///
+/// If `partial` is `true`, `options.byte_range.exclusive_max` may exceed the
+/// size of the value, in which case only the bytes that exist are returned,
+/// and `value_size` must be set.  If no bytes of the requested range exist, an
+/// `absl::StatusCode::kOutOfRange` error may be returned instead, in which
+/// case the read is retried with `partial` equal to `false`.
+///
+/// If `partial` is `false`, this has the same semantics as
+/// `kvstore::Driver::Read` and `value_size` is ignored.
+///
+/// May be called concurrently.
+using ReadPartFunction = std::function<Future<ReadPartResult>(
+    kvstore::ReadOptions options, bool partial)>;
+
+/// Returns `true` if a read with the specified `options` may be split into
+/// more than one request by `ParallelRead`.
+bool ShouldReadInParallel(const kvstore::ReadOptions& options,
+                          const ParallelReadOptions& parallel_options);
+
+/// Reads a value as a sequence of byte ranges of at most
+/// `parallel_options.part_size` bytes.
+///
+/// The first part is read with a single partial request, which also determines
+/// the size and generation of the value; values that fit within a single part
+/// therefore require just one request.  The remaining parts are then read with
+/// up to `parallel_options.max_concurrency` concurrent requests conditioned on
+/// that generation, and assembled without copying.  If the value changes
+/// concurrently, the read is restarted.
+///
+/// Each part is retried independently by `read_part`.
+Future<kvstore::ReadResult> ParallelRead(
+    kvstore::ReadOptions options, const ParallelReadOptions& parallel_options,
+    ReadPartFunction read_part);
+
+}  // namespace internal_kvstore
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_PARALLEL_READ_H_
@@ -0,0 +1,314 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/parallel_read.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = tensorstore::kvstore;
+using ::tensorstore::Future;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal_kvstore::ParallelRead;
+using ::tensorstore::internal_kvstore::ParallelReadOptions;
+using ::tensorstore::internal_kvstore::ReadPartFunction;
+using ::tensorstore::internal_kvstore::ReadPartResult;
+using ::tensorstore::internal_kvstore::ShouldReadInParallel;
+
+/// Single value that emulates the semantics of an HTTP server.
+struct FakeValue {
+  struct Request {
+    OptionalByteRangeRequest byte_range;
+    StorageGeneration if_equal;
+    bool partial;
+  };
+
+  absl::Mutex mutex;
+  std::optional<std::string> value;
+  StorageGeneration generation = StorageGeneration::FromString("g1");
+  std::vector<Request> requests;
+
+  /// Called after each request is recorded.
+  std::function<void(FakeValue&)> on_request;
+
+  tensorstore::Result<ReadPartResult> Read(kvstore::ReadOptions options,
+                                           bool partial) {
+    absl::MutexLock lock(&mutex);
+    requests.push_back({options.byte_range, options.if_equal, partial});
+    if (on_request) on_request(*this);
+    ReadPartResult result;
+    auto& read_result = result.read_result;
+    read_result.stamp.time = absl::Now();
+    if (!value) {
+      read_result.state = kvstore::ReadResult::kMissing;
+      read_result.stamp.generation = StorageGeneration::NoValue();
+      return result;
+    }
+    if (!StorageGeneration::EqualOrUnspecified(generation, options.if_equal) ||
+        options.if_not_equal == generation) {
+      return result;
+    }
+    auto byte_range = options.byte_range;
+    if (partial) {
+      if (byte_range.inclusive_min >= value->size()) {
+        return absl::OutOfRangeError("Range not satisfiable");
+      }
+      byte_range.exclusive_max =
+          std::min<uint64_t>(*byte_range.exclusive_max, value->size());
+      result.value_size = value->size();
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto range,
+                                 byte_range.Validate(value->size()));
+    read_result.state = kvstore::ReadResult::kValue;
+    read_result.stamp.generation = generation;
+    read_result.value = absl::Cord(value->substr(range.inclusive_min,
+                                                 range.size()));
+    return result;
+  }
+
+  ReadPartFunction GetReadPartFunction() {
+    return [this](kvstore::ReadOptions options,
+                  bool partial) -> Future<ReadPartResult> {
+      return Read(std::move(options), partial);
+    };
+  }
+};
+
+std::string MakeValue(size_t size) {
+  std::string value(size, '\0');
+  for (size_t i = 0; i < size; ++i) value[i] = static_cast<char>('a' + i % 26);
+  return value;
+}
+
+TEST(ShouldReadInParallelTest, Basic) {
+  kvstore::ReadOptions options;
+  EXPECT_FALSE(ShouldReadInParallel(options, ParallelReadOptions{}));
+  EXPECT_TRUE(ShouldReadInParallel(options, ParallelReadOptions{10, 2}));
+  options.byte_range = OptionalByteRangeRequest(5, 15);
+  EXPECT_FALSE(ShouldReadInParallel(options, ParallelReadOptions{10, 2}));
+  options.byte_range = OptionalByteRangeRequest(5, 16);
+  EXPECT_TRUE(ShouldReadInParallel(options, ParallelReadOptions{10, 2}));
+}
+
+TEST(ParallelReadTest, SmallValue) {
+  FakeValue fake;
+  fake.value = "abcde";
+  EXPECT_THAT(ParallelRead({}, ParallelReadOptions{10, 2},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesKvsReadResult(absl::Cord("abcde"),
+                                   StorageGeneration::FromString("g1")));
+  ASSERT_EQ(1, fake.requests.size());
+  EXPECT_TRUE(fake.requests[0].partial);
+  EXPECT_EQ(OptionalByteRangeRequest(0, 10), fake.requests[0].byte_range);
+}
+
+TEST(ParallelReadTest, LargeValue) {
+  FakeValue fake;
+  fake.value = MakeValue(100);
+  EXPECT_THAT(ParallelRead({}, ParallelReadOptions{16, 3},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesKvsReadResult(absl::Cord(*fake.value)));
+  ASSERT_EQ(7, fake.requests.size());
+  EXPECT_TRUE(fake.requests[0].partial);
+  for (size_t i = 1; i < fake.requests.size(); ++i) {
+    EXPECT_FALSE(fake.requests[i].partial);
+    EXPECT_EQ(StorageGeneration::FromString("g1"), fake.requests[i].if_equal);
+  }
+  std::vector<OptionalByteRangeRequest> ranges;
+  for (const auto& request : fake.requests) {
+    ranges.push_back(request.byte_range);
+  }
+  EXPECT_THAT(ranges, ::testing::UnorderedElementsAre(
+                          OptionalByteRangeRequest(0, 16),
+                          OptionalByteRangeRequest(16, 32),
+                          OptionalByteRangeRequest(32, 48),
+                          OptionalByteRangeRequest(48, 64),
+                          OptionalByteRangeRequest(64, 80),
+                          OptionalByteRangeRequest(80, 96),
+                          OptionalByteRangeRequest(96, 100)));
+}
+
+TEST(ParallelReadTest, ByteRange) {
+  FakeValue fake;
+  fake.value = MakeValue(100);
+  kvstore::ReadOptions options;
+  options.byte_range = OptionalByteRangeRequest(10, 50);
+  EXPECT_THAT(ParallelRead(options, ParallelReadOptions{16, 2},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesKvsReadResult(absl::Cord(fake.value->substr(10, 40))));
+  EXPECT_EQ(3, fake.requests.size());
+
+  options.byte_range = OptionalByteRangeRequest(90);
+  EXPECT_THAT(ParallelRead(options, ParallelReadOptions{16, 2},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesKvsReadResult(absl::Cord(fake.value->substr(90))));
+
+  options.byte_range = OptionalByteRangeRequest(10, 200);
+  EXPECT_THAT(ParallelRead(options, ParallelReadOptions{16, 2},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesStatus(absl::StatusCode::kOutOfRange));
+}
+
+TEST(ParallelReadTest, EmptyValue) {
+  FakeValue fake;
+  fake.value = "";
+  EXPECT_THAT(ParallelRead({}, ParallelReadOptions{16, 2},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesKvsReadResult(absl::Cord()));
+  // The partial request is retried as a non-partial request.
+  ASSERT_EQ(2, fake.requests.size());
+  EXPECT_FALSE(fake.requests[1].partial);
+}
+
+TEST(ParallelReadTest, Missing) {
+  FakeValue fake;
+  EXPECT_THAT(ParallelRead({}, ParallelReadOptions{16, 2},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesKvsReadResultNotFound());
+}
+
+TEST(ParallelReadTest, IfNotEqual) {
+  FakeValue fake;
+  fake.value = MakeValue(100);
+  kvstore::ReadOptions options;
+  options.if_not_equal = fake.generation;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto result, ParallelRead(options, ParallelReadOptions{16, 2},
+                                fake.GetReadPartFunction())
+                       .result());
+  EXPECT_TRUE(result.aborted());
+  EXPECT_EQ(1, fake.requests.size());
+}
+
+TEST(ParallelReadTest, NoGeneration) {
+  FakeValue fake;
+  fake.value = MakeValue(100);
+  fake.generation = StorageGeneration::Invalid();
+  EXPECT_THAT(ParallelRead({}, ParallelReadOptions{16, 2},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesKvsReadResult(absl::Cord(*fake.value)));
+  // The remainder of the value cannot be read consistently in parts.
+  ASSERT_EQ(2, fake.requests.size());
+  EXPECT_FALSE(fake.requests[1].partial);
+  EXPECT_EQ(OptionalByteRangeRequest(), fake.requests[1].byte_range);
+}
+
+TEST(ParallelReadTest, ConcurrentModification) {
+  FakeValue fake;
+  fake.value = MakeValue(100);
+  fake.on_request = [](FakeValue& fake) {
+    if (fake.requests.size() == 2) {
+      fake.value = std::string(50, 'x');
+      fake.generation = StorageGeneration::FromString("g2");
+    }
+  };
+  EXPECT_THAT(ParallelRead({}, ParallelReadOptions{16, 1},
+                           fake.GetReadPartFunction())
+                  .result(),
+              MatchesKvsReadResult(absl::Cord(std::string(50, 'x')),
+                                   StorageGeneration::FromString("g2")));
+  // The read is restarted after the second request fails its condition.
+  EXPECT_TRUE(fake.requests[2].partial);
+  EXPECT_EQ(6, fake.requests.size());
+}
+
+TEST(ParallelReadTest, Error) {
+  FakeValue fake;
+  fake.value = MakeValue(100);
+  auto read_part = [&](kvstore::ReadOptions options,
+                       bool partial) -> Future<ReadPartResult> {
+    if (options.byte_range.inclusive_min == 32) {
+      return absl::UnavailableError("failed");
+    }
+    return fake.Read(std::move(options), partial);
+  };
+  EXPECT_THAT(
+      ParallelRead({}, ParallelReadOptions{16, 2}, read_part).result(),
+      MatchesStatus(absl::StatusCode::kUnavailable, "failed"));
+}
+
+TEST(ParallelReadTest, MaxConcurrency) {
+  FakeValue fake;
+  fake.value = MakeValue(100);
+  absl::Mutex mutex;
+  std::vector<std::pair<tensorstore::Promise<ReadPartResult>,
+                        tensorstore::Result<ReadPartResult>>>
+      pending;
+  auto read_part = [&](kvstore::ReadOptions options,
+                       bool partial) -> Future<ReadPartResult> {
+    auto [promise, future] = PromiseFuturePair<ReadPartResult>::Make();
+    absl::MutexLock lock(&mutex);
+    pending.emplace_back(std::move(promise),
+                         fake.Read(std::move(options), partial));
+    return future;
+  };
+  auto future = ParallelRead({}, ParallelReadOptions{16, 2}, read_part);
+  size_t num_requests = 0;
+  while (true) {
+    std::vector<std::pair<tensorstore::Promise<ReadPartResult>,
+                          tensorstore::Result<ReadPartResult>>>
+        to_complete;
+    {
+      absl::MutexLock lock(&mutex);
+      to_complete.swap(pending);
+    }
+    if (to_complete.empty()) break;
+    EXPECT_LE(to_complete.size(), 2u);
+    num_requests += to_complete.size();
+    for (auto& [promise, result] : to_complete) {
+      promise.SetResult(std::move(result));
+    }
+  }
+  EXPECT_EQ(7, num_requests);
+  EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord(*fake.value)));
+}
+
+}  // namespace
@@ -0,0 +1,823 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// Key-value store adapter that caches the values read from a base key-value
+/// store in memory and, optionally, in a second "disk cache" key-value store.
+///
+/// This is primarily intended to run behind the gRPC kvstore service as a
+/// read-through caching proxy shared by many clients, but may be used with any
+/// base kvstore.
+///
+/// Cached entries record the generation of the value read from the base
+/// kvstore.  An entry that does not satisfy the staleness bound of a read is
+/// revalidated by reading from the base kvstore with `if_not_equal` set to the
+/// cached generation, so that the value is only transferred again if it
+/// changed.  Entries loaded from the disk cache have no known timestamp and
+/// are therefore always revalidated, unless the read permits unbounded
+/// staleness.
+///
+/// Concurrent reads of the same key and byte range that miss the cache share a
+/// single read from the base kvstore.  Byte range reads are served from the
+/// cached value if the entire value is cached, and otherwise read and cached
+/// in memory separately, so that reading a small range of a large value does
+/// not transfer the entire value.  Only entire values are stored in the disk
+/// cache.
+///
+/// If a `disk_bytes_limit` is specified, the least recently used disk cache
+/// entries are deleted once the total size of the entries exceeds it.  The
+/// sizes of the entries are tracked in memory; the entries already present in
+/// the disk cache are found by listing and reading the header of each entry
+/// when the kvstore is opened.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/cache_key/absl_time.h"
+#include "tensorstore/internal/cache_key/std_optional.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/absl_time.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_optional.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/serialization/absl_time.h"
+#include "tensorstore/serialization/std_optional.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/garbage_collection.h"
+#include "tensorstore/util/garbage_collection/std_optional.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::kvstore::ReadResult;
+
+auto& read_cache_hits = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/read_cache/hits",
+    "Number of read_cache kvstore reads served from memory without accessing "
+    "the base kvstore");
+
+auto& read_cache_revalidations = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/read_cache/revalidations",
+    "Number of read_cache kvstore entries found to be unchanged by a "
+    "conditional read of the base kvstore");
+
+auto& read_cache_misses = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/read_cache/misses",
+    "Number of read_cache kvstore reads that fetched the value from the base "
+    "kvstore");
+
+auto& read_cache_coalesced = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/read_cache/coalesced",
+    "Number of read_cache kvstore reads that shared a concurrent read of the "
+    "base kvstore");
+
+auto& read_cache_disk_write_errors = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/read_cache/disk_write_errors",
+    "Number of read_cache kvstore disk cache entries that failed to be "
+    "written");
+
+auto& read_cache_disk_evictions = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/read_cache/disk_evictions",
+    "Number of read_cache kvstore disk cache entries deleted to stay within "
+    "the disk bytes limit");
+
+struct ReadCacheKeyValueStoreSpecData {
+  kvstore::Spec base;
+
+  /// Optional persistent cache, stored as one key per cached base key.
+  std::optional<kvstore::Spec> disk_cache;
+
+  /// Maximum total size of the encoded disk cache entries, or unbounded if not
+  /// specified.
+  std::optional<uint64_t> disk_bytes_limit;
+
+  /// Maximum total size of the keys and values cached in memory.
+  size_t memory_bytes_limit = 0;
+
+  /// Cached entries younger than this are used without revalidation, even if
+  /// the read requires more recent data.
+  absl::Duration revalidation_interval = absl::ZeroDuration();
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.disk_cache, x.disk_bytes_limit, x.memory_bytes_limit,
+             x.revalidation_interval);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base",
+                 jb::Projection<&ReadCacheKeyValueStoreSpecData::base>()),
+      jb::Member("disk_cache",
+                 jb::Projection<&ReadCacheKeyValueStoreSpecData::disk_cache>(
+                     jb::Optional())),
+      jb::Member(
+          "disk_bytes_limit",
+          jb::Projection<&ReadCacheKeyValueStoreSpecData::disk_bytes_limit>(
+              jb::Optional())),
+      jb::Member(
+          "memory_bytes_limit",
+          jb::Projection<&ReadCacheKeyValueStoreSpecData::memory_bytes_limit>(
+              jb::DefaultValue([](auto* v) { *v = 0; }))),
+      jb::Member(
+          "revalidation_interval",
+          jb::Projection<
+              &ReadCacheKeyValueStoreSpecData::revalidation_interval>(
+              jb::DefaultValue([](auto* v) { *v = absl::ZeroDuration(); }))));
+};
+
+class ReadCacheKeyValueStoreSpec
+    : public internal_kvstore::RegisteredDriverSpec<
+          ReadCacheKeyValueStoreSpec, ReadCacheKeyValueStoreSpecData> {
+ public:
+  static constexpr char id[] = "read_cache";
+  Future<kvstore::DriverPtr> DoOpen() const override;
+};
+
+/// Identifies a cached value, or byte range of a value.
+struct CacheKey {
+  std::string key;
+
+  /// Byte range of the value, or the default (entire value).
+  OptionalByteRangeRequest byte_range;
+
+  bool IsFullValue() const { return byte_range == OptionalByteRangeRequest{}; }
+
+  friend bool operator==(const CacheKey& a, const CacheKey& b) {
+    return a.key == b.key && a.byte_range == b.byte_range;
+  }
+
+  friend bool operator<(const CacheKey& a, const CacheKey& b) {
+    return std::tie(a.key, a.byte_range.inclusive_min,
+                    a.byte_range.exclusive_max) <
+           std::tie(b.key, b.byte_range.inclusive_min,
+                    b.byte_range.exclusive_max);
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const CacheKey& x) {
+    return H::combine(std::move(h), x.key, x.byte_range.inclusive_min,
+                      x.byte_range.exclusive_max);
+  }
+};
+
+/// In-memory LRU cache of read results with a `state` of `kValue` or
+/// `kMissing`, keyed by kvstore key and byte range.
+class MemoryCache {
+ public:
+  explicit MemoryCache(size_t bytes_limit) : bytes_limit_(bytes_limit) {}
+
+  std::optional<ReadResult> Find(const CacheKey& key) {
+    if (bytes_limit_ == 0) return std::nullopt;
+    absl::MutexLock lock(&mutex_);
+    auto it = map_.find(key);
+    if (it == map_.end()) return std::nullopt;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+  }
+
+  /// Inserts or replaces the entry for `key`, unless the existing entry is
+  /// more recent.
+  ///
+  /// Entries for other byte ranges of the same kvstore key that do not match
+  /// the generation of `entry` are erased, even if `entry` itself is too large
+  /// to cache.
+  void Insert(CacheKey key, ReadResult entry) {
+    if (bytes_limit_ == 0) return;
+    const size_t size = key.key.size() + entry.value.size();
+    absl::MutexLock lock(&mutex_);
+    for (auto it = map_.lower_bound(CacheKey{key.key});
+         it != map_.end() && it->first.key == key.key;) {
+      auto next = std::next(it);
+      const ReadResult& existing = it->second->second;
+      if (it->first == key) {
+        if (existing.stamp.time > entry.stamp.time) return;
+        EraseLocked(it->second);
+      } else if (existing.stamp.generation != entry.stamp.generation &&
+                 existing.stamp.time <= entry.stamp.time) {
+        EraseLocked(it->second);
+      }
+      it = next;
+    }
+    if (size > bytes_limit_) return;
+    total_bytes_ += size;
+    lru_.emplace_front(std::move(key), std::move(entry));
+    map_.emplace(lru_.front().first, lru_.begin());
+    while (total_bytes_ > bytes_limit_) {
+      EraseLocked(std::prev(lru_.end()));
+    }
+  }
+
+  void EraseRange(const KeyRange& range) {
+    absl::MutexLock lock(&mutex_);
+    for (auto it = lru_.begin(); it != lru_.end();) {
+      auto next = std::next(it);
+      if (Contains(range, it->first.key)) EraseLocked(it);
+      it = next;
+    }
+  }
+
+ private:
+  using List = std::list<std::pair<CacheKey, ReadResult>>;
+
+  void EraseLocked(List::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    total_bytes_ -= it->first.key.size() + it->second.value.size();
+    map_.erase(it->first);
+    lru_.erase(it);
+  }
+
+  const size_t bytes_limit_;
+  absl::Mutex mutex_;
+  List lru_ ABSL_GUARDED_BY(mutex_);
+  /// Ordered so that the entries for all byte ranges of a given kvstore key
+  /// are adjacent.
+  absl::btree_map<CacheKey, List::iterator> map_ ABSL_GUARDED_BY(mutex_);
+  size_t total_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+/// Length of the header of an encoded disk cache entry, which consists of the
+/// generation length and value length as zero-padded 20-digit decimal numbers,
+/// each followed by `:`.  The fixed length allows the size of an entry to be
+/// determined by reading just its header.
+constexpr size_t kDiskEntryHeaderLength = 42;
+
+/// Encodes a cached value for the disk cache as
+/// `<generation length>:<value length>:<generation><value>`.
+absl::Cord EncodeDiskEntry(const ReadResult& entry) {
+  const std::string& generation = entry.stamp.generation.value;
+  absl::Cord encoded(
+      absl::StrCat(absl::Dec(generation.size(), absl::kZeroPad20), ":",
+                   absl::Dec(entry.value.size(), absl::kZeroPad20), ":",
+                   generation));
+  encoded.Append(entry.value);
+  return encoded;
+}
+
+/// Header of an encoded disk cache entry.
+struct DiskEntryHeader {
+  uint64_t generation_length;
+  uint64_t value_length;
+
+  /// Total size of the encoded entry.
+  uint64_t size() const {
+    return kDiskEntryHeaderLength + generation_length + value_length;
+  }
+};
+
+/// Decodes the header at the start of `encoded`.  Returns `std::nullopt` if
+/// the header is invalid.
+std::optional<DiskEntryHeader> DecodeDiskEntryHeader(
+    const absl::Cord& encoded) {
+  if (encoded.size() < kDiskEntryHeaderLength) return std::nullopt;
+  const std::string header(encoded.Subcord(0, kDiskEntryHeaderLength));
+  constexpr size_t kDigits = 20;
+  DiskEntryHeader result;
+  if (header[kDigits] != ':' || header[2 * kDigits + 1] != ':' ||
+      !absl::SimpleAtoi(std::string_view(header).substr(0, kDigits),
+                        &result.generation_length) ||
+      !absl::SimpleAtoi(std::string_view(header).substr(kDigits + 1, kDigits),
+                        &result.value_length) ||
+      result.generation_length == 0 ||
+      result.value_length > std::numeric_limits<uint64_t>::max() -
+                                kDiskEntryHeaderLength -
+                                result.generation_length) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+/// Decodes a disk cache entry encoded by `EncodeDiskEntry`.  Returns
+/// `std::nullopt` if `encoded` is invalid, in which case the entry is
+/// ignored.
+std::optional<ReadResult> DecodeDiskEntry(const absl::Cord& encoded) {
+  auto header = DecodeDiskEntryHeader(encoded);
+  if (!header || header->size() != encoded.size()) return std::nullopt;
+  ReadResult entry;
+  entry.state = ReadResult::kValue;
+  entry.stamp.generation.value = std::string(
+      encoded.Subcord(kDiskEntryHeaderLength, header->generation_length));
+  // The time at which the entry was last validated is not known.
+  entry.stamp.time = absl::InfinitePast();
+  entry.value = encoded.Subcord(
+      kDiskEntryHeaderLength + header->generation_length, header->value_length);
+  return entry;
+}
+
+/// Tracks the size and disk generation of each disk cache entry, in order of
+/// last use, so that the least recently used entries can be evicted once the
+/// total size exceeds the limit.
+class DiskCacheIndex {
+ public:
+  struct Entry {
+    std::string key;
+    uint64_t size;
+    /// Generation of the entry in the disk cache kvstore, used to avoid
+    /// deleting a more recently written entry.
+    StorageGeneration generation;
+  };
+
+  /// If `bytes_limit` is `std::nullopt`, nothing is tracked.
+  explicit DiskCacheIndex(std::optional<uint64_t> bytes_limit)
+      : bytes_limit_(bytes_limit) {}
+
+  /// Returns `true` if an entry of the specified `size` may be stored.
+  bool Fits(uint64_t size) const {
+    return !bytes_limit_ || size <= *bytes_limit_;
+  }
+
+  /// Records the entry for `key`, and returns the entries that must be
+  /// evicted.
+  ///
+  /// \param used If `false`, for entries found by scanning the disk cache,
+  ///     the entry is treated as the least recently used, and is ignored if
+  ///     `key` is already tracked.
+  std::vector<Entry> Insert(std::string key, uint64_t size,
+                            StorageGeneration generation, bool used = true) {
+    std::vector<Entry> evicted;
+    if (!bytes_limit_) return evicted;
+    absl::MutexLock lock(&mutex_);
+    auto it = map_.find(key);
+    if (it != map_.end()) {
+      if (!used) return evicted;
+      EraseLocked(it->second);
+    }
+    total_bytes_ += size;
+    auto pos = used ? lru_.begin() : lru_.end();
+    pos = lru_.insert(pos, Entry{std::move(key), size, std::move(generation)});
+    map_.emplace(pos->key, pos);
+    while (total_bytes_ > *bytes_limit_) {
+      auto last = std::prev(lru_.end());
+      total_bytes_ -= last->size;
+      map_.erase(last->key);
+      evicted.push_back(std::move(*last));
+      lru_.erase(last);
+    }
+    return evicted;
+  }
+
+  /// Marks the entry for `key`, if tracked, as the most recently used.
+  void Touch(std::string_view key) {
+    if (!bytes_limit_) return;
+    absl::MutexLock lock(&mutex_);
+    auto it = map_.find(key);
+    if (it != map_.end()) lru_.splice(lru_.begin(), lru_, it->second);
+  }
+
+  void Erase(std::string_view key) {
+    if (!bytes_limit_) return;
+    absl::MutexLock lock(&mutex_);
+    auto it = map_.find(key);
+    if (it != map_.end()) EraseLocked(it->second);
+  }
+
+ private:
+  using List = std::list<Entry>;
+
+  void EraseLocked(List::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    total_bytes_ -= it->size;
+    map_.erase(it->key);
+    lru_.erase(it);
+  }
+
+  const std::optional<uint64_t> bytes_limit_;
+  absl::Mutex mutex_;
+  List lru_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string_view, List::iterator> map_
+      ABSL_GUARDED_BY(mutex_);
+  uint64_t total_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+/// Computes the result of a read with the specified `options` from a cached
+/// `entry`.
+///
+/// \param byte_range Byte range of `entry.value` to return, which is
+///     `options.byte_range` if `entry` holds the entire value, and the default
+///     (entire value) if `entry` holds just the requested byte range.
+Result<ReadResult> GetReadResult(const ReadResult& entry,
+                                 const kvstore::ReadOptions& options,
+                                 OptionalByteRangeRequest byte_range_request) {
+  ReadResult result;
+  result.stamp = entry.stamp;
+  const auto& generation = entry.stamp.generation;
+  if (options.if_not_equal == generation ||
+      !StorageGeneration::EqualOrUnspecified(generation, options.if_equal)) {
+    return result;
+  }
+  if (!entry.has_value()) {
+    result.state = ReadResult::kMissing;
+    return result;
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto byte_range, byte_range_request.Validate(entry.value.size()));
+  result.state = ReadResult::kValue;
+  result.value = internal::GetSubCord(entry.value, byte_range);
+  return result;
+}
+
+class ReadCacheKeyValueStore
+    : public internal_kvstore::RegisteredDriver<ReadCacheKeyValueStore,
+                                                ReadCacheKeyValueStoreSpec> {
+ public:
+  explicit ReadCacheKeyValueStore(size_t memory_bytes_limit,
+                                  std::optional<uint64_t> disk_bytes_limit)
+      : memory_cache_(memory_bytes_limit), disk_index_(disk_bytes_limit) {}
+
+  Future<ReadResult> Read(Key key, ReadOptions options) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override;
+
+  Future<const void> DeleteRange(KeyRange range) override {
+    auto future =
+        base_.driver->DeleteRange(KeyRange::AddPrefix(base_.path, range));
+    future.ExecuteWhenReady(
+        [self = IntrusivePtr<ReadCacheKeyValueStore>(this),
+         range = std::move(range)](ReadyFuture<const void> future) {
+          self->memory_cache_.EraseRange(range);
+        });
+    return future;
+  }
+
+  void ListImpl(ListOptions options,
+                AnyFlowReceiver<absl::Status, Key> receiver) override {
+    options.range = KeyRange::AddPrefix(base_.path, std::move(options.range));
+    options.strip_prefix_length += base_.path.size();
+    base_.driver->ListImpl(std::move(options), std::move(receiver));
+  }
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(BaseKey(key));
+  }
+
+  absl::Status GetBoundSpecData(ReadCacheKeyValueStoreSpecData& spec) const {
+    spec = spec_;
+    TENSORSTORE_ASSIGN_OR_RETURN(spec.base.driver,
+                                 base_.driver->GetBoundSpec());
+    spec.base.path = base_.path;
+    if (disk_.driver) {
+      TENSORSTORE_ASSIGN_OR_RETURN(spec.disk_cache->driver,
+                                   disk_.driver->GetBoundSpec());
+      spec.disk_cache->path = disk_.path;
+    }
+    return absl::OkStatus();
+  }
+
+  std::string BaseKey(std::string_view key) const {
+    return tensorstore::StrCat(base_.path, key);
+  }
+
+  std::string DiskKey(std::string_view key) const {
+    return tensorstore::StrCat(disk_.path, key);
+  }
+
+  /// Returns the current cache entry for `key`, valid as of `staleness_bound`.
+  ///
+  /// If a concurrent call for the same key will produce a sufficiently recent
+  /// entry, its result is shared.
+  ///
+  /// \param cached Existing entry from the memory cache, which is revalidated
+  ///     rather than read again if it is unchanged.
+  Future<ReadResult> Fill(CacheKey key, absl::Time staleness_bound,
+                          std::optional<ReadResult> cached);
+
+  /// Reads `key` from the base kvstore, conditioned on the generation not
+  /// matching `cached`, and updates the caches.
+  Future<ReadResult> ReadFromBase(CacheKey key, absl::Time staleness_bound,
+                                  std::optional<ReadResult> cached);
+
+  /// Stores `entry` in the disk cache, if enabled.  Failures are logged but do
+  /// not fail the read, since they only reduce the cache hit rate.
+  void WriteDiskEntry(std::string_view key, const ReadResult& entry);
+
+  /// Deletes evicted disk cache entries, unless they have since been
+  /// rewritten.
+  void EvictDiskEntries(std::vector<DiskCacheIndex::Entry> entries);
+
+  /// Adds the entries already present in the disk cache to `disk_index_`, as
+  /// the least recently used entries.  Entries with an invalid header are left
+  /// untracked until their key is next read, which replaces them.
+  void ScanDiskCache();
+
+  /// In-progress call to `Fill` for a given key.
+  struct PendingFill {
+    Future<ReadResult> future;
+    absl::Time start_time;
+  };
+
+  SpecData spec_;
+  kvstore::KvStore base_;
+  /// Invalid if there is no disk cache.
+  kvstore::KvStore disk_;
+  MemoryCache memory_cache_;
+  DiskCacheIndex disk_index_;
+  absl::Mutex mutex_;
+  absl::flat_hash_map<CacheKey, PendingFill> pending_fills_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+Future<ReadResult> ReadCacheKeyValueStore::Read(Key key, ReadOptions options) {
+  absl::Time staleness_bound = options.staleness_bound;
+  if (staleness_bound == absl::InfiniteFuture()) {
+    staleness_bound = absl::Now();
+  }
+  staleness_bound -= spec_.revalidation_interval;
+  CacheKey cache_key{std::move(key)};
+  auto cached = memory_cache_.Find(cache_key);
+  if (cached && cached->stamp.time >= staleness_bound) {
+    read_cache_hits.Increment();
+    return GetReadResult(*cached, options, options.byte_range);
+  }
+  // A byte range of a value that is not cached in its entirety is read and
+  // cached separately, rather than reading the entire value.
+  OptionalByteRangeRequest byte_range = options.byte_range;
+  if (byte_range != OptionalByteRangeRequest{}) {
+    cache_key.byte_range = byte_range;
+    byte_range = {};
+    cached = memory_cache_.Find(cache_key);
+    if (cached && cached->stamp.time >= staleness_bound) {
+      read_cache_hits.Increment();
+      return GetReadResult(*cached, options, byte_range);
+    }
+  }
+  return MapFutureValue(
+      InlineExecutor{},
+      [options = std::move(options), byte_range](const ReadResult& entry) {
+        return GetReadResult(entry, options, byte_range);
+      },
+      Fill(std::move(cache_key), staleness_bound, std::move(cached)));
+}
+
+Future<ReadResult> ReadCacheKeyValueStore::Fill(
+    CacheKey key, absl::Time staleness_bound,
+    std::optional<ReadResult> cached) {
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  {
+    absl::MutexLock lock(&mutex_);
+    auto& pending = pending_fills_[key];
+    // A fill started at or after `staleness_bound` produces an entry that
+    // satisfies it.
+    if (!pending.future.null() && pending.start_time >= staleness_bound) {
+      read_cache_coalesced.Increment();
+      return pending.future;
+    }
+    pending.future = future;
+    pending.start_time = absl::Now();
+  }
+  future.ExecuteWhenReady([self = IntrusivePtr<ReadCacheKeyValueStore>(this),
+                           key](ReadyFuture<ReadResult> future) {
+    absl::MutexLock lock(&self->mutex_);
+    auto it = self->pending_fills_.find(key);
+    if (it != self->pending_fills_.end() &&
+        HaveSameSharedState(it->second.future, future)) {
+      self->pending_fills_.erase(it);
+    }
+  });
+  if (cached || !disk_.driver || !key.IsFullValue()) {
+    LinkResult(std::move(promise), ReadFromBase(std::move(key), staleness_bound,
+                                                std::move(cached)));
+    return std::move(future);
+  }
+  auto disk_future = disk_.driver->Read(DiskKey(key.key));
+  disk_future.ExecuteWhenReady(
+      [self = IntrusivePtr<ReadCacheKeyValueStore>(this), key = std::move(key),
+       staleness_bound, promise = std::move(promise)](
+          ReadyFuture<ReadResult> disk_future) mutable {
+        std::optional<ReadResult> cached;
+        if (disk_future.result().ok() && disk_future.value().has_value()) {
+          cached = DecodeDiskEntry(disk_future.value().value);
+          if (cached) self->disk_index_.Touch(key.key);
+        }
+        if (cached && cached->stamp.time >= staleness_bound) {
+          self->memory_cache_.Insert(key, *cached);
+          promise.SetResult(*std::move(cached));
+          return;
+        }
+        LinkResult(std::move(promise),
+                   self->ReadFromBase(std::move(key), staleness_bound,
+                                      std::move(cached)));
+      });
+  return std::move(future);
+}
+
+Future<ReadResult> ReadCacheKeyValueStore::ReadFromBase(
+    CacheKey key, absl::Time staleness_bound,
+    std::optional<ReadResult> cached) {
+  ReadOptions options;
+  options.staleness_bound = staleness_bound;
+  options.byte_range = key.byte_range;
+  if (cached) options.if_not_equal = cached->stamp.generation;
+  auto read_future = base_.driver->Read(BaseKey(key.key), std::move(options));
+  return MapFutureValue(
+      InlineExecutor{},
+      [self = IntrusivePtr<ReadCacheKeyValueStore>(this), key = std::move(key),
+       cached = std::move(cached)](ReadResult& result) mutable {
+        if (result.aborted() && cached) {
+          // Unchanged since `cached` was read.
+          read_cache_revalidations.Increment();
+          cached->stamp.time = result.stamp.time;
+          self->memory_cache_.Insert(key, *cached);
+          return *std::move(cached);
+        }
+        read_cache_misses.Increment();
+        self->memory_cache_.Insert(key, result);
+        if (key.IsFullValue()) self->WriteDiskEntry(key.key, result);
+        return std::move(result);
+      },
+      std::move(read_future));
+}
+
+void ReadCacheKeyValueStore::WriteDiskEntry(std::string_view key,
+                                            const ReadResult& entry) {
+  if (!disk_.driver) return;
+  std::optional<absl::Cord> encoded;
+  if (entry.has_value()) {
+    encoded = EncodeDiskEntry(entry);
+    // An entry that exceeds the limit by itself replaces any existing entry
+    // with nothing.
+    if (!disk_index_.Fits(encoded->size())) encoded = std::nullopt;
+  }
+  const size_t size = encoded ? encoded->size() : 0;
+  disk_.driver->Write(DiskKey(key), std::move(encoded))
+      .ExecuteWhenReady([self = IntrusivePtr<ReadCacheKeyValueStore>(this),
+                         key = std::string(key), size](
+                            ReadyFuture<TimestampedStorageGeneration> future) {
+        auto& result = future.result();
+        if (result.ok()) {
+          if (size == 0) {
+            self->disk_index_.Erase(key);
+          } else {
+            self->EvictDiskEntries(self->disk_index_.Insert(
+                std::move(key), size, result->generation));
+          }
+          return;
+        }
+        read_cache_disk_write_errors.Increment();
+        ABSL_LOG(WARNING) << "Failed to write disk cache entry for "
+                          << self->disk_.driver->DescribeKey(
+                                 self->DiskKey(key))
+                          << ": "
+                          << result.status();
+      });
+}
+
+void ReadCacheKeyValueStore::EvictDiskEntries(
+    std::vector<DiskCacheIndex::Entry> entries) {
+  for (auto& entry : entries) {
+    read_cache_disk_evictions.Increment();
+    WriteOptions options;
+    options.if_equal = std::move(entry.generation);
+    disk_.driver->Write(DiskKey(entry.key), std::nullopt, std::move(options));
+  }
+}
+
+void ReadCacheKeyValueStore::ScanDiskCache() {
+  kvstore::ListFuture(disk_).ExecuteWhenReady(
+      [self = IntrusivePtr<ReadCacheKeyValueStore>(this)](
+          ReadyFuture<std::vector<Key>> future) {
+        auto& keys = future.result();
+        if (!keys.ok()) {
+          ABSL_LOG(WARNING) << "Failed to list disk cache entries: "
+                            << keys.status();
+          return;
+        }
+        for (auto& key : *keys) {
+          ReadOptions options;
+          options.byte_range.exclusive_max = kDiskEntryHeaderLength;
+          self->disk_.driver->Read(self->DiskKey(key), std::move(options))
+              .ExecuteWhenReady([self, key = std::move(key)](
+                                    ReadyFuture<ReadResult> future) mutable {
+                auto& result = future.result();
+                if (!result.ok() || !result->has_value()) return;
+                auto header = DecodeDiskEntryHeader(result->value);
+                if (!header) return;
+                self->EvictDiskEntries(self->disk_index_.Insert(
+                    std::move(key), header->size(), result->stamp.generation,
+                    /*used=*/false));
+              });
+        }
+      });
+}
+
+Future<TimestampedStorageGeneration> ReadCacheKeyValueStore::Write(
+    Key key, std::optional<Value> value, WriteOptions options) {
+  auto write_future =
+      base_.driver->Write(BaseKey(key), value, std::move(options));
+  return MapFutureValue(
+      InlineExecutor{},
+      [self = IntrusivePtr<ReadCacheKeyValueStore>(this), key = std::move(key),
+       value = std::move(value)](TimestampedStorageGeneration& stamp) mutable {
+        // Write through to the memory cache.  The disk cache is not updated,
+        // since disk cache entries are always revalidated.
+        if (!StorageGeneration::IsUnknown(stamp.generation)) {
+          ReadResult entry;
+          entry.stamp = stamp;
+          if (value) {
+            entry.state = ReadResult::kValue;
+            entry.value = *std::move(value);
+          } else {
+            entry.state = ReadResult::kMissing;
+          }
+          self->memory_cache_.Insert(CacheKey{std::move(key)},
+                                     std::move(entry));
+        }
+        return std::move(stamp);
+      },
+      std::move(write_future));
+}
+
+Future<kvstore::DriverPtr> ReadCacheKeyValueStoreSpec::DoOpen() const {
+  Future<kvstore::KvStore> disk_future = kvstore::KvStore();
+  if (data_.disk_cache) disk_future = kvstore::Open(*data_.disk_cache);
+  return MapFutureValue(
+      InlineExecutor{},
+      [spec = IntrusivePtr<const ReadCacheKeyValueStoreSpec>(this)](
+          kvstore::KvStore& base,
+          kvstore::KvStore& disk) -> Result<kvstore::DriverPtr> {
+        auto driver = internal::MakeIntrusivePtr<ReadCacheKeyValueStore>(
+            spec->data_.memory_bytes_limit, spec->data_.disk_bytes_limit);
+        driver->spec_ = spec->data_;
+        driver->base_ = std::move(base);
+        driver->disk_ = std::move(disk);
+        if (driver->disk_.driver && spec->data_.disk_bytes_limit) {
+          driver->ScanDiskCache();
+        }
+        return driver;
+      },
+      kvstore::Open(data_.base), std::move(disk_future));
+}
+
+}  // namespace
+}  // namespace tensorstore
+
+namespace tensorstore {
+namespace garbage_collection {
+template <>
+struct GarbageCollection<tensorstore::ReadCacheKeyValueStore> {
+  static void Visit(GarbageCollectionVisitor& visitor,
+                    const tensorstore::ReadCacheKeyValueStore& value) {
+    garbage_collection::GarbageCollectionVisit(visitor, *value.base_.driver);
+    if (value.disk_.driver) {
+      garbage_collection::GarbageCollectionVisit(visitor,
+                                                 *value.disk_.driver);
+    }
+  }
+};
+}  // namespace garbage_collection
+}  // namespace tensorstore
+
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::ReadCacheKeyValueStoreSpec>
+    registration;
+}  // namespace
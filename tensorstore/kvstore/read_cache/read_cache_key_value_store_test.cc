@@ -0,0 +1,430 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <string_view>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = tensorstore::kvstore;
+using ::tensorstore::Context;
+using ::tensorstore::KvStore;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::TimestampedStorageGeneration;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MockKeyValueStore;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+using ::testing::Optional;
+using ::testing::SizeIs;
+using ::testing::UnorderedElementsAre;
+
+KvStore OpenReadCache(const Context& context, ::nlohmann::json options) {
+  options["driver"] = "read_cache";
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(auto store,
+                                  kvstore::Open(options, context).result());
+  return store;
+}
+
+MockKeyValueStore::MockPtr GetMockKeyValueStore(Context context) {
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto resource, context.GetResource<MockKeyValueStoreResource>());
+  return *resource;
+}
+
+kvstore::ReadResult MakeValue(std::string_view value,
+                              std::string_view generation) {
+  return kvstore::ReadResult{
+      kvstore::ReadResult::kValue, absl::Cord(value),
+      TimestampedStorageGeneration{StorageGeneration::FromString(generation),
+                                   absl::Now()}};
+}
+
+TEST(ReadCacheKeyValueStoreTest, Basic) {
+  auto context = Context::Default();
+  auto store = OpenReadCache(
+      context, {{"base", "memory://prefix/"}, {"memory_bytes_limit", 1 << 20}});
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+}
+
+TEST(ReadCacheKeyValueStoreTest, BasicWithDiskCache) {
+  auto context = Context::Default();
+  auto store = OpenReadCache(context, {{"base", "memory://base/"},
+                                       {"disk_cache", "memory://disk/"},
+                                       {"memory_bytes_limit", 1 << 20}});
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+}
+
+TEST(ReadCacheKeyValueStoreTest, DeleteRange) {
+  auto context = Context::Default();
+  auto store = OpenReadCache(
+      context, {{"base", "memory://prefix/"}, {"memory_bytes_limit", 1 << 20}});
+  tensorstore::internal::TestKeyValueStoreDeleteRange(store);
+}
+
+TEST(ReadCacheKeyValueStoreTest, StalenessBound) {
+  auto context = Context::Default();
+  auto store = OpenReadCache(
+      context, {{"base", "memory://"}, {"memory_bytes_limit", 1 << 20}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://", context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "x", absl::Cord("abcdef")));
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              MatchesKvsReadResult(absl::Cord("abcdef")));
+
+  // Modify the value without going through the cache.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "x", absl::Cord("ghijkl")));
+
+  // The cached value satisfies an unbounded staleness bound, and byte ranges
+  // are served from it.
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  options.byte_range.inclusive_min = 2;
+  options.byte_range.exclusive_max = 4;
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              MatchesKvsReadResult(absl::Cord("cd")));
+
+  // By default, the cached value is revalidated.
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              MatchesKvsReadResult(absl::Cord("ghijkl")));
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              MatchesKvsReadResult(absl::Cord("ij")));
+}
+
+TEST(ReadCacheKeyValueStoreTest, RevalidationInterval) {
+  auto context = Context::Default();
+  auto store = OpenReadCache(context, {{"base", "memory://"},
+                                       {"memory_bytes_limit", 1 << 20},
+                                       {"revalidation_interval", "1h"}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://", context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "x", absl::Cord("a")));
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              MatchesKvsReadResult(absl::Cord("a")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "x", absl::Cord("b")));
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              MatchesKvsReadResult(absl::Cord("a")));
+
+  // Writes through the cache update the cached value.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "x", absl::Cord("c")));
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              MatchesKvsReadResult(absl::Cord("c")));
+}
+
+TEST(ReadCacheKeyValueStoreTest, CoalescesConcurrentMisses) {
+  auto context = Context::Default();
+  auto mock = GetMockKeyValueStore(context);
+  auto store = OpenReadCache(context,
+                             {{"base", {{"driver", "mock_key_value_store"}}},
+                              {"memory_bytes_limit", 1 << 20},
+                              {"revalidation_interval", "1h"}});
+  auto future1 = kvstore::Read(store, "x");
+  kvstore::ReadOptions options;
+  options.byte_range.inclusive_min = 1;
+  auto future2 = kvstore::Read(store, "x", options);
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ("x", request.key);
+    request.promise.SetResult(MakeValue("abc", "g1"));
+  }
+  EXPECT_TRUE(mock->read_requests.empty());
+  EXPECT_THAT(future1.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(future2.result(), MatchesKvsReadResult(absl::Cord("bc")));
+}
+
+TEST(ReadCacheKeyValueStoreTest, ByteRange) {
+  auto context = Context::Default();
+  auto mock = GetMockKeyValueStore(context);
+  auto store = OpenReadCache(context,
+                             {{"base", {{"driver", "mock_key_value_store"}}},
+                              {"memory_bytes_limit", 1 << 20},
+                              {"revalidation_interval", "1h"}});
+  kvstore::ReadOptions options;
+  options.byte_range.inclusive_min = 1;
+  options.byte_range.exclusive_max = 3;
+
+  // Only the requested byte range is read from the base kvstore.
+  {
+    auto future = kvstore::Read(store, "x", options);
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ(options.byte_range, request.options.byte_range);
+    request.promise.SetResult(MakeValue("bc", "g1"));
+    EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("bc")));
+  }
+
+  // The byte range is cached separately from the entire value.
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              MatchesKvsReadResult(absl::Cord("bc")));
+  EXPECT_TRUE(mock->read_requests.empty());
+  {
+    auto future = kvstore::Read(store, "x");
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ(OptionalByteRangeRequest{}, request.options.byte_range);
+    request.promise.SetResult(MakeValue("abcd", "g1"));
+    EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("abcd")));
+  }
+
+  // Other byte ranges are served from the cached entire value.
+  options.byte_range.inclusive_min = 2;
+  options.byte_range.exclusive_max = 4;
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              MatchesKvsReadResult(absl::Cord("cd")));
+  EXPECT_TRUE(mock->read_requests.empty());
+}
+
+TEST(ReadCacheKeyValueStoreTest, WriteInvalidatesByteRange) {
+  auto context = Context::Default();
+  auto store = OpenReadCache(context, {{"base", "memory://"},
+                                       {"memory_bytes_limit", 8},
+                                       {"revalidation_interval", "1h"}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://", context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "x", absl::Cord("abcdef")));
+  kvstore::ReadOptions options;
+  options.byte_range.inclusive_min = 1;
+  options.byte_range.exclusive_max = 3;
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              MatchesKvsReadResult(absl::Cord("bc")));
+
+  // The new value is too large to cache, but still invalidates the cached
+  // byte range of the previous value.
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(store, "x", absl::Cord("ghijklmnopqr")));
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              MatchesKvsReadResult(absl::Cord("hi")));
+}
+
+TEST(ReadCacheKeyValueStoreTest, ConditionalReadOfMissingValue) {
+  auto context = Context::Default();
+  auto store = OpenReadCache(context, {{"base", "memory://"},
+                                       {"memory_bytes_limit", 1 << 20},
+                                       {"revalidation_interval", "1h"}});
+  EXPECT_THAT(kvstore::Read(store, "x").result(),
+              tensorstore::internal::MatchesKvsReadResultNotFound());
+
+  // The cached missing entry is subject to the generation conditions.
+  kvstore::ReadOptions options;
+  options.if_not_equal = StorageGeneration::NoValue();
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              tensorstore::internal::MatchesKvsReadResultAborted());
+  options = {};
+  options.if_equal = StorageGeneration::FromString("g1");
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              tensorstore::internal::MatchesKvsReadResultAborted());
+  options = {};
+  options.if_equal = StorageGeneration::NoValue();
+  EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+              tensorstore::internal::MatchesKvsReadResultNotFound());
+}
+
+TEST(ReadCacheKeyValueStoreTest, DiskCacheRevalidation) {
+  auto context = Context::Default();
+  auto mock = GetMockKeyValueStore(context);
+  auto store = OpenReadCache(context,
+                             {{"base", {{"driver", "mock_key_value_store"}}},
+                              {"disk_cache", "memory://disk/"}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto disk, kvstore::Open("memory://disk/", context).result());
+
+  // Miss: the value is read from the base kvstore and stored in the disk
+  // cache.
+  {
+    auto future = kvstore::Read(store, "x");
+    auto request = mock->read_requests.pop();
+    EXPECT_TRUE(StorageGeneration::IsUnknown(request.options.if_not_equal));
+    request.promise.SetResult(MakeValue("abc", "g1"));
+    EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  }
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(UnorderedElementsAre("x")));
+
+  // The disk cache entry is revalidated, and not transferred again if
+  // unchanged.
+  {
+    auto future = kvstore::Read(store, "x");
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ(StorageGeneration::FromString("g1"),
+              request.options.if_not_equal);
+    request.promise.SetResult(kvstore::ReadResult{TimestampedStorageGeneration{
+        StorageGeneration::FromString("g1"), absl::Now()}});
+    EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("abc")));
+  }
+
+  // An unbounded staleness bound is satisfied by the disk cache alone.
+  {
+    kvstore::ReadOptions options;
+    options.staleness_bound = absl::InfinitePast();
+    EXPECT_THAT(kvstore::Read(store, "x", options).result(),
+                MatchesKvsReadResult(absl::Cord("abc")));
+    EXPECT_TRUE(mock->read_requests.empty());
+  }
+
+  // A changed value replaces the disk cache entry.
+  {
+    auto future = kvstore::Read(store, "x");
+    auto request = mock->read_requests.pop();
+    request.promise.SetResult(MakeValue("def", "g2"));
+    EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("def")));
+  }
+  {
+    auto future = kvstore::Read(store, "x");
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ(StorageGeneration::FromString("g2"),
+              request.options.if_not_equal);
+    request.promise.SetResult(kvstore::ReadResult{TimestampedStorageGeneration{
+        StorageGeneration::FromString("g2"), absl::Now()}});
+    EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("def")));
+  }
+
+  // A missing value removes the disk cache entry.
+  {
+    auto future = kvstore::Read(store, "x");
+    auto request = mock->read_requests.pop();
+    request.promise.SetResult(kvstore::ReadResult{
+        kvstore::ReadResult::kMissing, absl::Cord(),
+        TimestampedStorageGeneration{StorageGeneration::NoValue(),
+                                     absl::Now()}});
+    EXPECT_THAT(future.result(),
+                tensorstore::internal::MatchesKvsReadResultNotFound());
+  }
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(UnorderedElementsAre()));
+}
+
+TEST(ReadCacheKeyValueStoreTest, DiskCacheUnbounded) {
+  auto context = Context::Default();
+  auto store = OpenReadCache(
+      context, {{"base", "memory://base/"}, {"disk_cache", "memory://disk/"}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://base/", context).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto disk, kvstore::Open("memory://disk/", context).result());
+  for (const char* key : {"a", "b", "c"}) {
+    TENSORSTORE_ASSERT_OK(kvstore::Write(base, key, absl::Cord("value")));
+    EXPECT_THAT(kvstore::Read(store, key).result(),
+                MatchesKvsReadResult(absl::Cord("value")));
+  }
+
+  // Every value read is kept in the disk cache; entries are only removed when
+  // the value is found to be missing.
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(UnorderedElementsAre("a", "b", "c")));
+
+  // Byte range reads are not stored in the disk cache.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "d", absl::Cord("value")));
+  kvstore::ReadOptions options;
+  options.byte_range.inclusive_min = 1;
+  EXPECT_THAT(kvstore::Read(store, "d", options).result(),
+              MatchesKvsReadResult(absl::Cord("alue")));
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(UnorderedElementsAre("a", "b", "c")));
+}
+
+TEST(ReadCacheKeyValueStoreTest, DiskCacheBytesLimit) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://base/", context).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto disk, kvstore::Open("memory://disk/", context).result());
+  for (const char* key : {"a", "b", "c", "d", "e"}) {
+    TENSORSTORE_ASSERT_OK(kvstore::Write(base, key, absl::Cord("value")));
+  }
+
+  // Determine the size of an encoded entry.
+  size_t entry_size;
+  {
+    auto store = OpenReadCache(context, {{"base", "memory://base/"},
+                                         {"disk_cache", "memory://disk/"}});
+    TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto entry,
+                                     kvstore::Read(disk, "a").result());
+    entry_size = entry.value.size();
+  }
+
+  // The existing entry is found when the kvstore is opened.
+  auto store = OpenReadCache(context, {{"base", "memory://base/"},
+                                       {"disk_cache", "memory://disk/"},
+                                       {"disk_bytes_limit", 2 * entry_size}});
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "b").result());
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(UnorderedElementsAre("a", "b")));
+
+  // The least recently used entry is evicted.
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "c").result());
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(UnorderedElementsAre("b", "c")));
+
+  // Reading an entry from the disk cache marks it as recently used.
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "b").result());
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "d").result());
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(UnorderedElementsAre("b", "d")));
+
+  // A value too large for the limit is not stored.
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(base, "e", absl::Cord(std::string(2 * entry_size, 'x'))));
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "e").result());
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(UnorderedElementsAre("b", "d")));
+
+  // Reopening with a smaller limit evicts entries found on open.
+  auto store2 = OpenReadCache(context, {{"base", "memory://base/"},
+                                        {"disk_cache", "memory://disk/"},
+                                        {"disk_bytes_limit", entry_size}});
+  EXPECT_THAT(kvstore::ListFuture(disk).result(),
+              Optional(SizeIs(1)));
+}
+
+TEST(ReadCacheKeyValueStoreTest, SpecRoundtrip) {
+  tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
+  options.full_spec = {{"driver", "read_cache"},
+                       {"base", {{"driver", "memory"}, {"path", "abc/"}}},
+                       {"disk_cache", {{"driver", "memory"}, {"path", "d/"}}},
+                       {"disk_bytes_limit", 1000000},
+                       {"memory_bytes_limit", 1000},
+                       {"revalidation_interval", "1m"}};
+  options.check_data_persists = false;
+  tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
+}
+
+TEST(ReadCacheKeyValueStoreTest, InvalidSpec) {
+  auto context = Context::Default();
+  EXPECT_THAT(kvstore::Open({{"driver", "read_cache"},
+                             {"base", "memory://"},
+                             {"memory_bytes_limit", -1}},
+                            context)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
@@ -0,0 +1,482 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// Key-value store adapter that simulates the latency, bandwidth, concurrency
+/// limits, and transient failures of a remote object store on top of an
+/// arbitrary base key-value store.
+///
+/// This is intended for benchmarking and for exercising retry logic without
+/// access to an actual remote storage system.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/cache_key/absl_time.h"
+#include "tensorstore/internal/cache_key/std_optional.h"
+#include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/absl_time.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_optional.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/path.h"
+#include "tensorstore/internal/schedule_at.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/serialization/absl_time.h"
+#include "tensorstore/serialization/std_optional.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/garbage_collection.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::internal::ScheduleAt;
+
+auto& simulated_injected_errors = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/simulated/injected_errors",
+    "Number of simulated transient errors returned by the simulated kvstore");
+
+auto& simulated_injected_throttles = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/simulated/injected_throttles",
+    "Number of simulated throttling errors returned by the simulated kvstore");
+
+struct SimulatedKeyValueStoreSpecData {
+  kvstore::Spec base;
+
+  /// Fixed latency added to every request.
+  absl::Duration latency = absl::ZeroDuration();
+
+  /// Upper bound of additional latency, sampled uniformly per request.
+  absl::Duration latency_jitter = absl::ZeroDuration();
+
+  /// Per-request transfer rate, in bytes per second.  If not specified, the
+  /// transfer time is not simulated.
+  std::optional<double> bandwidth;
+
+  /// Maximum number of concurrent requests issued to the base kvstore.  If
+  /// not specified, the concurrency is unlimited.
+  std::optional<size_t> concurrency;
+
+  /// Probability that a request fails with `absl::StatusCode::kUnavailable`.
+  double error_rate = 0;
+
+  /// Probability that a request fails with
+  /// `absl::StatusCode::kResourceExhausted`.
+  double throttle_rate = 0;
+
+  /// Seed for the pseudo-random generator used to sample latencies and
+  /// failures, which makes the simulated behavior reproducible.
+  uint64_t seed = 0;
+
+  Context::Resource<internal::DataCopyConcurrencyResource>
+      data_copy_concurrency;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.latency, x.latency_jitter, x.bandwidth, x.concurrency,
+             x.error_rate, x.throttle_rate, x.seed, x.data_copy_concurrency);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base",
+                 jb::Projection<&SimulatedKeyValueStoreSpecData::base>()),
+      jb::Member("latency",
+                 jb::Projection<&SimulatedKeyValueStoreSpecData::latency>(
+                     jb::DefaultValue([](auto* v) {
+                       *v = absl::ZeroDuration();
+                     }))),
+      jb::Member(
+          "latency_jitter",
+          jb::Projection<&SimulatedKeyValueStoreSpecData::latency_jitter>(
+              jb::DefaultValue([](auto* v) { *v = absl::ZeroDuration(); }))),
+      jb::Member("bandwidth",
+                 jb::Projection<&SimulatedKeyValueStoreSpecData::bandwidth>(
+                     jb::Optional())),
+      jb::Member("concurrency",
+                 jb::Projection<&SimulatedKeyValueStoreSpecData::concurrency>(
+                     jb::Optional(jb::Integer<size_t>(1)))),
+      jb::Member("error_rate",
+                 jb::Projection<&SimulatedKeyValueStoreSpecData::error_rate>(
+                     jb::DefaultValue([](auto* v) { *v = 0; }))),
+      jb::Member(
+          "throttle_rate",
+          jb::Projection<&SimulatedKeyValueStoreSpecData::throttle_rate>(
+              jb::DefaultValue([](auto* v) { *v = 0; }))),
+      jb::Member("seed",
+                 jb::Projection<&SimulatedKeyValueStoreSpecData::seed>(
+                     jb::DefaultValue([](auto* v) { *v = 0; }))),
+      jb::Member(internal::DataCopyConcurrencyResource::id,
+                 jb::Projection<
+                     &SimulatedKeyValueStoreSpecData::data_copy_concurrency>()),
+      jb::Initialize([](auto* obj) -> absl::Status {
+        if (obj->latency < absl::ZeroDuration() ||
+            obj->latency_jitter < absl::ZeroDuration()) {
+          return absl::InvalidArgumentError(
+              "\"latency\" and \"latency_jitter\" must be non-negative");
+        }
+        if (obj->bandwidth && !(*obj->bandwidth > 0)) {
+          return absl::InvalidArgumentError("\"bandwidth\" must be positive");
+        }
+        if (!(obj->error_rate >= 0 && obj->throttle_rate >= 0 &&
+              obj->error_rate + obj->throttle_rate <= 1)) {
+          return absl::InvalidArgumentError(
+              "\"error_rate\" and \"throttle_rate\" must be non-negative "
+              "and sum to at most 1");
+        }
+        return absl::OkStatus();
+      }));
+};
+
+class SimulatedKeyValueStoreSpec
+    : public internal_kvstore::RegisteredDriverSpec<
+          SimulatedKeyValueStoreSpec, SimulatedKeyValueStoreSpecData> {
+ public:
+  static constexpr char id[] = "simulated";
+  Future<kvstore::DriverPtr> DoOpen() const override;
+};
+
+/// Key-value store adapter that delays and perturbs requests to `base_`.
+///
+/// Each request proceeds as follows:
+///
+/// 1. The request waits for admission if `concurrency` requests are already
+///    outstanding.
+///
+/// 2. A latency, and whether the request fails, is sampled.  A failing request
+///    completes with an error after the sampled latency without being issued
+///    to the base kvstore.
+///
+/// 3. Otherwise, the request is issued to the base kvstore, and its result is
+///    delivered no earlier than the start time plus the sampled latency plus
+///    the time required to transfer the value at `bandwidth`.
+///
+/// A request whose result is no longer needed when it is admitted, or, for
+/// writes and deletions, once its delay elapses, is not issued to the base
+/// kvstore.
+class SimulatedKeyValueStore
+    : public internal_kvstore::RegisteredDriver<SimulatedKeyValueStore,
+                                                SimulatedKeyValueStoreSpec> {
+ public:
+  Future<ReadResult> Read(Key key, ReadOptions options) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override;
+
+  Future<const void> DeleteRange(KeyRange range) override;
+
+  void ListImpl(ListOptions options,
+                AnyFlowReceiver<absl::Status, Key> receiver) override;
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(tensorstore::StrCat(base_.path, key));
+  }
+
+  absl::Status GetBoundSpecData(SimulatedKeyValueStoreSpecData& spec) const {
+    spec = spec_;
+    TENSORSTORE_ASSIGN_OR_RETURN(spec.base.driver,
+                                 base_.driver->GetBoundSpec());
+    spec.base.path = base_.path;
+    return absl::OkStatus();
+  }
+
+  const Executor& executor() const {
+    return spec_.data_copy_concurrency->executor;
+  }
+
+  /// Runs `task` once fewer than `spec_.concurrency` requests are in flight.
+  void Admit(ExecutorTask task);
+
+  /// Marks an admitted request as done, possibly admitting a queued request.
+  void Finish();
+
+  /// Samples the latency of a single request.
+  absl::Duration SampleLatency();
+
+  /// Samples whether a request fails.
+  absl::Status SampleFailure();
+
+  /// Returns the simulated time required to transfer `num_bytes`.
+  absl::Duration TransferTime(size_t num_bytes) const {
+    if (!spec_.bandwidth) return absl::ZeroDuration();
+    return absl::Seconds(static_cast<double>(num_bytes) / *spec_.bandwidth);
+  }
+
+  SpecData spec_;
+  kvstore::KvStore base_;
+
+  absl::Mutex mutex_;
+  std::mt19937_64 rng_ ABSL_GUARDED_BY(mutex_);
+  size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::deque<ExecutorTask> pending_ ABSL_GUARDED_BY(mutex_);
+};
+
+void SimulatedKeyValueStore::Admit(ExecutorTask task) {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (spec_.concurrency && in_flight_ >= *spec_.concurrency) {
+      pending_.push_back(std::move(task));
+      return;
+    }
+    ++in_flight_;
+  }
+  std::move(task)();
+}
+
+void SimulatedKeyValueStore::Finish() {
+  ExecutorTask next;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (pending_.empty()) {
+      --in_flight_;
+      return;
+    }
+    next = std::move(pending_.front());
+    pending_.pop_front();
+  }
+  // The slot released by the finished request is transferred to `next`.  It is
+  // started on the executor to avoid unbounded recursion.
+  executor()(std::move(next));
+}
+
+absl::Duration SimulatedKeyValueStore::SampleLatency() {
+  if (spec_.latency_jitter <= absl::ZeroDuration()) return spec_.latency;
+  absl::MutexLock lock(&mutex_);
+  std::uniform_real_distribution<double> dist(0, 1);
+  return spec_.latency + spec_.latency_jitter * dist(rng_);
+}
+
+absl::Status SimulatedKeyValueStore::SampleFailure() {
+  if (spec_.error_rate <= 0 && spec_.throttle_rate <= 0) {
+    return absl::OkStatus();
+  }
+  double x;
+  {
+    absl::MutexLock lock(&mutex_);
+    x = std::uniform_real_distribution<double>(0, 1)(rng_);
+  }
+  if (x < spec_.error_rate) {
+    simulated_injected_errors.Increment();
+    return absl::UnavailableError("Simulated transient error");
+  }
+  if (x < spec_.error_rate + spec_.throttle_rate) {
+    simulated_injected_throttles.Increment();
+    return absl::ResourceExhaustedError("Simulated rate limit exceeded");
+  }
+  return absl::OkStatus();
+}
+
+Future<kvstore::ReadResult> SimulatedKeyValueStore::Read(Key key,
+                                                         ReadOptions options) {
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  Admit([self = IntrusivePtr<SimulatedKeyValueStore>(this),
+         promise = std::move(promise), key = std::move(key),
+         options = std::move(options)]() mutable {
+    // Cancelled while waiting for admission.
+    if (!promise.result_needed()) {
+      self->Finish();
+      return;
+    }
+    const absl::Time start_time = absl::Now();
+    const absl::Duration latency = self->SampleLatency();
+    if (auto status = self->SampleFailure(); !status.ok()) {
+      ScheduleAt(start_time + latency,
+                 WithExecutor(self->executor(),
+                              [self, promise = std::move(promise),
+                               status = std::move(status)] {
+                                promise.SetResult(status);
+                                self->Finish();
+                              }));
+      return;
+    }
+    auto read_future = self->base_.driver->Read(
+        tensorstore::StrCat(self->base_.path, key), std::move(options));
+    read_future.Force();
+    std::move(read_future)
+        .ExecuteWhenReady([self, promise = std::move(promise), start_time,
+                           latency](ReadyFuture<ReadResult> future) mutable {
+          const auto& r = future.result();
+          const size_t num_bytes = r.ok() ? r->value.size() : 0;
+          ScheduleAt(start_time + latency + self->TransferTime(num_bytes),
+                     WithExecutor(self->executor(),
+                                  [self, promise = std::move(promise),
+                                   future = std::move(future)] {
+                                    promise.SetResult(future.result());
+                                    self->Finish();
+                                  }));
+        });
+  });
+  return std::move(future);
+}
+
+Future<TimestampedStorageGeneration> SimulatedKeyValueStore::Write(
+    Key key, std::optional<Value> value, WriteOptions options) {
+  auto [promise, future] =
+      PromiseFuturePair<TimestampedStorageGeneration>::Make();
+  Admit([self = IntrusivePtr<SimulatedKeyValueStore>(this),
+         promise = std::move(promise), key = std::move(key),
+         value = std::move(value), options = std::move(options)]() mutable {
+    if (!promise.result_needed()) {
+      self->Finish();
+      return;
+    }
+    const absl::Duration delay =
+        self->SampleLatency() + self->TransferTime(value ? value->size() : 0);
+    // Failures are determined before the upload is simulated, but are only
+    // reported once the delay has elapsed.  The base kvstore is not modified
+    // by a failed write.
+    auto status = self->SampleFailure();
+    ScheduleAt(
+        absl::Now() + delay,
+        WithExecutor(self->executor(), [self, promise = std::move(promise),
+                                        key = std::move(key),
+                                        value = std::move(value),
+                                        options = std::move(options),
+                                        status = std::move(status)]() mutable {
+          // Cancelled during the simulated upload: the base kvstore is not
+          // modified.
+          if (!promise.result_needed()) {
+            self->Finish();
+            return;
+          }
+          if (!status.ok()) {
+            promise.SetResult(std::move(status));
+            self->Finish();
+            return;
+          }
+          auto write_future = self->base_.driver->Write(
+              tensorstore::StrCat(self->base_.path, key), std::move(value),
+              std::move(options));
+          write_future.Force();
+          std::move(write_future)
+              .ExecuteWhenReady(
+                  [self, promise = std::move(promise)](
+                      ReadyFuture<TimestampedStorageGeneration> future) {
+                    promise.SetResult(future.result());
+                    self->Finish();
+                  });
+        }));
+  });
+  return std::move(future);
+}
+
+Future<const void> SimulatedKeyValueStore::DeleteRange(KeyRange range) {
+  auto [promise, future] = PromiseFuturePair<void>::Make();
+  Admit([self = IntrusivePtr<SimulatedKeyValueStore>(this),
+         promise = std::move(promise), range = std::move(range)]() mutable {
+    if (!promise.result_needed()) {
+      self->Finish();
+      return;
+    }
+    auto status = self->SampleFailure();
+    ScheduleAt(
+        absl::Now() + self->SampleLatency(),
+        WithExecutor(self->executor(), [self, promise = std::move(promise),
+                                        range = std::move(range),
+                                        status = std::move(status)]() mutable {
+          if (!promise.result_needed()) {
+            self->Finish();
+            return;
+          }
+          if (!status.ok()) {
+            promise.SetResult(std::move(status));
+            self->Finish();
+            return;
+          }
+          auto delete_future = self->base_.driver->DeleteRange(
+              KeyRange::AddPrefix(self->base_.path, std::move(range)));
+          delete_future.Force();
+          std::move(delete_future)
+              .ExecuteWhenReady([self, promise = std::move(promise)](
+                                    ReadyFuture<const void> future) {
+                promise.SetResult(future.result());
+                self->Finish();
+              });
+        }));
+  });
+  return std::move(future);
+}
+
+void SimulatedKeyValueStore::ListImpl(
+    ListOptions options, AnyFlowReceiver<absl::Status, Key> receiver) {
+  // Listing is forwarded directly; only point operations are simulated.
+  options.range = KeyRange::AddPrefix(base_.path, std::move(options.range));
+  options.strip_prefix_length += base_.path.size();
+  base_.driver->ListImpl(std::move(options), std::move(receiver));
+}
+
+Future<kvstore::DriverPtr> SimulatedKeyValueStoreSpec::DoOpen() const {
+  return MapFutureValue(
+      InlineExecutor{},
+      [spec = IntrusivePtr<const SimulatedKeyValueStoreSpec>(this)](
+          kvstore::KvStore& base) -> Result<kvstore::DriverPtr> {
+        auto driver = internal::MakeIntrusivePtr<SimulatedKeyValueStore>();
+        driver->spec_ = spec->data_;
+        driver->base_ = std::move(base);
+        driver->rng_.seed(spec->data_.seed);
+        return driver;
+      },
+      kvstore::Open(data_.base));
+}
+
+}  // namespace
+}  // namespace tensorstore
+
+namespace tensorstore {
+namespace garbage_collection {
+template <>
+struct GarbageCollection<tensorstore::SimulatedKeyValueStore> {
+  static void Visit(GarbageCollectionVisitor& visitor,
+                    const tensorstore::SimulatedKeyValueStore& value) {
+    garbage_collection::GarbageCollectionVisit(visitor, *value.base_.driver);
+  }
+};
+}  // namespace garbage_collection
+}  // namespace tensorstore
+
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::SimulatedKeyValueStoreSpec>
+    registration;
+}  // namespace
@@ -0,0 +1,233 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = tensorstore::kvstore;
+using ::tensorstore::Context;
+using ::tensorstore::Future;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::TimestampedStorageGeneration;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+
+TEST(SimulatedKeyValueStoreTest, Basic) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "simulated"},
+                                 {"base", "memory://prefix/"},
+                                 {"latency", "1ms"},
+                                 {"latency_jitter", "1ms"},
+                                 {"concurrency", 2}},
+                                context)
+                      .result());
+  tensorstore::internal::TestKeyValueStoreBasicFunctionality(store);
+}
+
+TEST(SimulatedKeyValueStoreTest, DeleteRange) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "simulated"}, {"base", "memory://prefix/"}},
+                    context)
+          .result());
+  tensorstore::internal::TestKeyValueStoreDeleteRange(store);
+}
+
+TEST(SimulatedKeyValueStoreTest, UsesBasePath) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "simulated"}, {"base", "memory://prefix/"}},
+                    context)
+          .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://prefix/", context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key", absl::Cord("value")));
+  EXPECT_THAT(kvstore::Read(base, "key").result(),
+              MatchesKvsReadResult(absl::Cord("value")));
+}
+
+TEST(SimulatedKeyValueStoreTest, Latency) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "simulated"},
+                                 {"base", "memory://"},
+                                 {"latency", "50ms"}},
+                                context)
+                      .result());
+  auto start_time = absl::Now();
+  EXPECT_THAT(kvstore::Read(store, "missing").result(),
+              MatchesKvsReadResultNotFound());
+  EXPECT_GE(absl::Now() - start_time, absl::Milliseconds(50));
+}
+
+TEST(SimulatedKeyValueStoreTest, Bandwidth) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "simulated"},
+                                 {"base", "memory://"},
+                                 {"bandwidth", 1000}},
+                                context)
+                      .result());
+  absl::Cord value(std::string(100, 'x'));
+  auto start_time = absl::Now();
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key", value));
+  EXPECT_THAT(kvstore::Read(store, "key").result(),
+              MatchesKvsReadResult(value));
+  // 100 bytes transferred at 1000 bytes/s in each direction.
+  EXPECT_GE(absl::Now() - start_time, absl::Milliseconds(200));
+}
+
+TEST(SimulatedKeyValueStoreTest, ConcurrencyLimit) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "simulated"},
+                                 {"base", "memory://"},
+                                 {"latency", "20ms"},
+                                 {"concurrency", 1}},
+                                context)
+                      .result());
+  auto start_time = absl::Now();
+  std::vector<Future<kvstore::ReadResult>> futures;
+  for (int i = 0; i < 3; ++i) {
+    futures.push_back(kvstore::Read(store, "key"));
+  }
+  for (auto& future : futures) {
+    EXPECT_THAT(future.result(), MatchesKvsReadResultNotFound());
+  }
+  // Requests are serialized by the concurrency limit.
+  EXPECT_GE(absl::Now() - start_time, absl::Milliseconds(60));
+}
+
+TEST(SimulatedKeyValueStoreTest, CancelledRequestsAreNotIssued) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_resource, context.GetResource<MockKeyValueStoreResource>());
+  auto mock = *mock_resource;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "simulated"},
+                                 {"base", {{"driver", "mock_key_value_store"}}},
+                                 {"concurrency", 1}},
+                                context)
+                      .result());
+  auto future = kvstore::Read(store, "a");
+  {
+    // Queued behind the first read, and cancelled before being admitted.
+    auto read_future = kvstore::Read(store, "b");
+    auto write_future = kvstore::Write(store, "c", absl::Cord("value"));
+  }
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ("a", request.key);
+    request.promise.SetResult(kvstore::ReadResult{
+        kvstore::ReadResult::kMissing, absl::Cord(),
+        TimestampedStorageGeneration{StorageGeneration::NoValue(),
+                                     absl::Now()}});
+  }
+  EXPECT_THAT(future.result(), MatchesKvsReadResultNotFound());
+
+  // The cancelled requests release their admission slots without being
+  // issued to the base kvstore.
+  future = kvstore::Read(store, "d");
+  {
+    auto request = mock->read_requests.pop();
+    EXPECT_EQ("d", request.key);
+    request.promise.SetResult(kvstore::ReadResult{
+        kvstore::ReadResult::kMissing, absl::Cord(),
+        TimestampedStorageGeneration{StorageGeneration::NoValue(),
+                                     absl::Now()}});
+  }
+  EXPECT_THAT(future.result(), MatchesKvsReadResultNotFound());
+  EXPECT_TRUE(mock->write_requests.empty());
+}
+
+TEST(SimulatedKeyValueStoreTest, InjectedErrors) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto error_store, kvstore::Open({{"driver", "simulated"},
+                                       {"base", "memory://"},
+                                       {"error_rate", 1}},
+                                      context)
+                            .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto throttle_store, kvstore::Open({{"driver", "simulated"},
+                                          {"base", "memory://"},
+                                          {"throttle_rate", 1}},
+                                         context)
+                               .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base, kvstore::Open("memory://", context).result());
+  EXPECT_THAT(kvstore::Read(error_store, "key").result(),
+              MatchesStatus(absl::StatusCode::kUnavailable));
+  EXPECT_THAT(
+      kvstore::Write(throttle_store, "key", absl::Cord("value")).result(),
+      MatchesStatus(absl::StatusCode::kResourceExhausted));
+  // A failed write does not modify the base kvstore.
+  EXPECT_THAT(kvstore::Read(base, "key").result(),
+              MatchesKvsReadResultNotFound());
+}
+
+TEST(SimulatedKeyValueStoreTest, InvalidSpec) {
+  auto context = Context::Default();
+  EXPECT_THAT(kvstore::Open({{"driver", "simulated"},
+                             {"base", "memory://"},
+                             {"error_rate", 0.75},
+                             {"throttle_rate", 0.5}},
+                            context)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(kvstore::Open({{"driver", "simulated"},
+                             {"base", "memory://"},
+                             {"bandwidth", 0}},
+                            context)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(SimulatedKeyValueStoreTest, SpecRoundtrip) {
+  tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
+  options.full_spec = {{"driver", "simulated"},
+                       {"base", {{"driver", "memory"}, {"path", "abc/"}}},
+                       {"latency", "10ms"},
+                       {"bandwidth", 1e9},
+                       {"concurrency", 16},
+                       {"latency_jitter", "5ms"},
+                       {"seed", 5}};
+  tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
+}
+
+}  // namespace
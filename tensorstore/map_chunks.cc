@@ -0,0 +1,232 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/map_chunks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/integer_overflow.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace {
+
+/// Local state for the asynchronous operation initiated by `MapChunks`.
+///
+/// The grid cells are enumerated lazily in C order by `next_cell`.  Each of up
+/// to `max_in_flight` concurrent "lanes" repeatedly claims the next cell, reads
+/// the input, invokes `function` on the executor, writes the output and, once
+/// the write has committed, continues with the next cell.
+///
+/// Once all lanes have finished, all references to `MapChunksState` are
+/// released, which in turn causes `promise` to become ready.
+struct MapChunksState
+    : public internal::AtomicReferenceCount<MapChunksState> {
+  TensorStore<> source;
+  TensorStore<> target;
+  MapChunksFunction function;
+  Executor executor;
+  Box<> target_bounds;
+  Box<> source_bounds;
+  std::vector<Index> halo;
+
+  /// Origin and shape of the write chunk grid.
+  std::vector<Index> grid_origin;
+  std::vector<Index> chunk_shape;
+
+  /// Range of grid cell indices that intersect `target_bounds`.
+  std::vector<Index> first_cell;
+  std::vector<Index> num_cells;
+
+  Index total_cells;
+  std::atomic<Index> next_cell{0};
+  Promise<void> promise;
+
+  void SetError(absl::Status error) {
+    SetDeferredResult(promise, std::move(error));
+  }
+
+  /// Computes the output and input bounds of the grid cell with the specified
+  /// linear index.
+  void GetCellBounds(Index cell, MutableBoxView<> output_bounds,
+                     MutableBoxView<> input_bounds) const {
+    for (DimensionIndex i = target_bounds.rank() - 1; i >= 0; --i) {
+      const Index grid_cell = first_cell[i] + cell % num_cells[i];
+      cell /= num_cells[i];
+      const Index start = grid_origin[i] + grid_cell * chunk_shape[i];
+      const auto output_interval = Intersect(
+          IndexInterval::UncheckedSized(start, chunk_shape[i]),
+          target_bounds[i]);
+      output_bounds[i] = output_interval;
+      input_bounds[i] = Intersect(
+          IndexInterval::UncheckedHalfOpen(
+              output_interval.inclusive_min() - halo[i],
+              output_interval.exclusive_max() + halo[i]),
+          source_bounds[i]);
+    }
+  }
+};
+
+void StartNextChunk(internal::IntrusivePtr<MapChunksState> state);
+
+/// Invoked on the executor once the input of a chunk has been read.
+struct MapChunkOp {
+  internal::IntrusivePtr<MapChunksState> state;
+  Box<> output_bounds;
+
+  void operator()(ReadyFuture<SharedOffsetArray<void>> input_future) {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto input, input_future.result(),
+                                 state->SetError(_));
+    auto output = AllocateArray(output_bounds, c_order, value_init,
+                                state->target.dtype());
+    TENSORSTORE_RETURN_IF_ERROR(
+        state->function(SharedOffsetArray<const void>(std::move(input)),
+                        output),
+        state->SetError(_));
+    auto write_futures = tensorstore::Write(
+        std::move(output),
+        state->target | AllDims().BoxSlice(output_bounds));
+    std::move(write_futures.commit_future)
+        .ExecuteWhenReady([state = std::move(state)](
+                              ReadyFuture<void> commit_future) mutable {
+          TENSORSTORE_RETURN_IF_ERROR(commit_future.status(),
+                                      state->SetError(_));
+          StartNextChunk(std::move(state));
+        });
+  }
+};
+
+void StartNextChunk(internal::IntrusivePtr<MapChunksState> state) {
+  if (!state->promise.result_needed()) return;
+  const Index cell = state->next_cell++;
+  if (cell >= state->total_cells) return;
+  const DimensionIndex rank = state->target_bounds.rank();
+  Box<> output_bounds(rank), input_bounds(rank);
+  state->GetCellBounds(cell, output_bounds, input_bounds);
+  auto input_future = tensorstore::Read(
+      state->source | AllDims().BoxSlice(input_bounds));
+  auto executor = state->executor;
+  std::move(input_future)
+      .ExecuteWhenReady(WithExecutor(
+          std::move(executor),
+          MapChunkOp{std::move(state), std::move(output_bounds)}));
+}
+
+}  // namespace
+
+Future<void> MapChunks(TensorStore<> source, TensorStore<> target,
+                       MapChunksFunction function, MapChunksOptions options) {
+  const DimensionIndex rank = target.rank();
+  if (source.rank() != rank) {
+    return absl::InvalidArgumentError(
+        tensorstore::StrCat("Source rank (", source.rank(),
+                            ") does not match target rank (", rank, ")"));
+  }
+  if (!options.halo.empty() && options.halo.size() != rank) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Halo ", span(options.halo), " does not match target rank (", rank,
+        ")"));
+  }
+  internal::IntrusivePtr<MapChunksState> state(new MapChunksState);
+  state->target_bounds = target.domain().box();
+  state->source_bounds = source.domain().box();
+  if (!IsFinite(state->target_bounds)) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "MapChunks requires a finite target domain, got ", target.domain()));
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto chunk_layout, target.chunk_layout());
+  const auto write_chunk_shape = chunk_layout.write_chunk_shape();
+  const auto grid_origin = chunk_layout.grid_origin();
+  state->halo.resize(rank);
+  state->grid_origin.resize(rank);
+  state->chunk_shape.resize(rank);
+  state->first_cell.resize(rank);
+  state->num_cells.resize(rank);
+  state->total_cells = 1;
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    const IndexInterval bounds = state->target_bounds[i];
+    if (!options.halo.empty()) {
+      state->halo[i] = std::max(Index(0), options.halo[i]);
+    }
+    Index chunk_size =
+        write_chunk_shape.size() == rank ? write_chunk_shape[i] : Index(0);
+    Index origin = grid_origin.size() == rank ? grid_origin[i] : kImplicit;
+    if (chunk_size <= 0) {
+      // Treat the entire dimension as a single chunk.
+      chunk_size = std::max(Index(1), bounds.size());
+      origin = bounds.inclusive_min();
+    } else if (origin == kImplicit) {
+      origin = bounds.inclusive_min();
+    }
+    state->grid_origin[i] = origin;
+    state->chunk_shape[i] = chunk_size;
+    if (bounds.empty()) {
+      state->num_cells[i] = 0;
+    } else {
+      state->first_cell[i] =
+          FloorOfRatio(bounds.inclusive_min() - origin, chunk_size);
+      state->num_cells[i] =
+          FloorOfRatio(bounds.inclusive_max() - origin, chunk_size) -
+          state->first_cell[i] + 1;
+    }
+    if (internal::MulOverflow(state->total_cells, state->num_cells[i],
+                              &state->total_cells)) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Number of chunks in ", state->target_bounds, " exceeds maximum of ",
+          std::numeric_limits<Index>::max()));
+    }
+  }
+  state->executor =
+      internal::TensorStoreAccess::handle(target).driver->data_copy_executor();
+  state->source = std::move(source);
+  state->target = std::move(target);
+  state->function = std::move(function);
+  auto pair = PromiseFuturePair<void>::Make(MakeResult());
+  state->promise = std::move(pair.promise);
+  const Index num_lanes =
+      std::min(std::max(Index(1), options.max_in_flight), state->total_cells);
+  for (Index lane = 0; lane < num_lanes; ++lane) {
+    StartNextChunk(state);
+  }
+  return std::move(pair.future);
+}
+
+Future<void> MapChunks(TensorStore<> store, MapChunksFunction function,
+                       MapChunksOptions options) {
+  auto target = store;
+  return MapChunks(std::move(store), std::move(target), std::move(function),
+                   std::move(options));
+}
+
+}  // namespace tensorstore
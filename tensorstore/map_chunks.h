@@ -0,0 +1,111 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_MAP_CHUNKS_H_
+#define TENSORSTORE_MAP_CHUNKS_H_
+
+/// \file
+/// Chunk-aligned parallel map over TensorStore objects.
+
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/poly/poly.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+
+/// Type-erased function invoked by `MapChunks` for each chunk.
+///
+/// The `output` array has the domain of a single write chunk of the target,
+/// intersected with the target domain, and is initially zero.  The `input`
+/// array has the same domain expanded by the halo on each side, intersected
+/// with the source domain.  Both arrays use the index space of the target.
+///
+/// The function may be invoked concurrently from multiple threads.  Returning
+/// an error aborts the operation.
+///
+/// \relates MapChunks
+using MapChunksFunction =
+    poly::Poly<sizeof(void*) * 2, /*Copyable=*/false,
+               absl::Status(SharedOffsetArrayView<const void> input,
+                            SharedOffsetArrayView<void> output)>;
+
+/// Options for `MapChunks`.
+///
+/// \relates MapChunks
+struct MapChunksOptions {
+  /// Number of additional elements of the source to include on each side of
+  /// each chunk.  If empty, no halo is included.  Otherwise, the length must
+  /// equal the rank of the target.
+  std::vector<Index> halo;
+
+  /// Maximum number of chunks that are processed concurrently.  This bounds
+  /// the memory used for input and output arrays.
+  Index max_in_flight = 16;
+};
+
+/// Applies `function` to each write chunk of `target`.
+///
+/// The write chunk grid of `target`, as specified by its `ChunkLayout`, is
+/// iterated over the domain of `target`.  For each grid cell, the
+/// corresponding region of `source` (expanded by `options.halo`) is read,
+/// `function` is invoked to compute the output, and the output is written to
+/// `target`.  Since each write covers exactly one write chunk, each chunk of
+/// `target` is written exactly once and never read-modify-written by this
+/// operation.  Up to `options.max_in_flight` chunks are processed
+/// concurrently; the next chunk is started once the write of a previous chunk
+/// has been committed.
+///
+/// If a dimension of `target` has no write chunk size specified, the entire
+/// extent of that dimension is treated as a single chunk.
+///
+/// \param source Source TensorStore that supports reading, with the same rank
+///     as `target`.  Indexed using the same coordinates as `target`.
+/// \param target Target TensorStore that supports writing.  The domain must be
+///     finite.
+/// \param function Function that computes each output chunk.
+/// \param options Specifies the halo and concurrency.
+/// \returns A future that becomes ready when all chunks have been written, or
+///     an error occurs.
+/// \error `absl::StatusCode::kInvalidArgument` if the ranks of `source` and
+///     `target`, or the length of `options.halo`, do not match.
+/// \error `absl::StatusCode::kInvalidArgument` if the domain of `target` is
+///     not finite.
+/// \ingroup map_chunks
+Future<void> MapChunks(TensorStore<> source, TensorStore<> target,
+                       MapChunksFunction function,
+                       MapChunksOptions options = {});
+
+/// Applies `function` to each write chunk of `store`, writing the result back
+/// in place.
+///
+/// Equivalent to `MapChunks(store, store, function, options)`.
+///
+/// .. warning::
+///
+///    If `options.halo` is non-zero, the halo region of the input may reflect
+///    the output of neighboring chunks that have already been written.  Use a
+///    separate target to avoid this.
+///
+/// \ingroup map_chunks
+Future<void> MapChunks(TensorStore<> store, MapChunksFunction function,
+                       MapChunksOptions options = {});
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_MAP_CHUNKS_H_
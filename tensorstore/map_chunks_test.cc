@@ -0,0 +1,182 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/map_chunks.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunked_store_testutil.h"
+#include "tensorstore/context.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/static_cast.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/iterate_over_index_range.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Box;
+using ::tensorstore::Context;
+using ::tensorstore::Index;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::SharedOffsetArrayView;
+using ::tensorstore::internal::OpenChunkedTestStore;
+using ::tensorstore::span;
+using ::tensorstore::StaticDataTypeCast;
+using ::tensorstore::unchecked;
+using ::testing::Optional;
+using ::testing::UnorderedElementsAre;
+
+TEST(MapChunksTest, InPlace) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {5, 6}, {3, 4});
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint16_t>({{0, 1, 2, 3, 4, 5},
+                                              {6, 7, 8, 9, 10, 11},
+                                              {12, 13, 14, 15, 16, 17},
+                                              {18, 19, 20, 21, 22, 23},
+                                              {24, 25, 26, 27, 28, 29}}),
+                         store)
+          .result());
+  absl::Mutex mutex;
+  std::vector<Box<>> output_domains;
+  TENSORSTORE_ASSERT_OK(tensorstore::MapChunks(
+      store,
+      [&](SharedOffsetArrayView<const void> input,
+          SharedOffsetArrayView<void> output) {
+        EXPECT_EQ(input.domain(), output.domain());
+        {
+          absl::MutexLock lock(&mutex);
+          output_domains.emplace_back(output.domain());
+        }
+        auto typed_input = StaticDataTypeCast<const uint16_t, unchecked>(input);
+        auto typed_output = StaticDataTypeCast<uint16_t, unchecked>(output);
+        tensorstore::IterateOverIndexRange(
+            output.domain(), [&](span<const Index> indices) {
+              typed_output(indices) = typed_input(indices) * 2;
+            });
+        return absl::OkStatus();
+      }));
+  EXPECT_THAT(output_domains,
+              UnorderedElementsAre(Box<>({0, 0}, {3, 4}), Box<>({0, 4}, {3, 2}),
+                                   Box<>({3, 0}, {2, 4}),
+                                   Box<>({3, 4}, {2, 2})));
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              Optional(MakeArray<uint16_t>({{0, 2, 4, 6, 8, 10},
+                                            {12, 14, 16, 18, 20, 22},
+                                            {24, 26, 28, 30, 32, 34},
+                                            {36, 38, 40, 42, 44, 46},
+                                            {48, 50, 52, 54, 56, 58}})));
+}
+
+TEST(MapChunksTest, Halo) {
+  auto context = Context::Default();
+  auto source = OpenChunkedTestStore(context, "<u2", {10}, {10});
+  auto target = OpenChunkedTestStore(context, "<u2", {10}, {4});
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint16_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}),
+                         source)
+          .result());
+  tensorstore::MapChunksOptions options;
+  options.halo = {1};
+  options.max_in_flight = 2;
+  absl::Mutex mutex;
+  std::vector<Box<>> input_domains;
+  TENSORSTORE_ASSERT_OK(tensorstore::MapChunks(
+      source, target,
+      [&](SharedOffsetArrayView<const void> input,
+          SharedOffsetArrayView<void> output) {
+        {
+          absl::MutexLock lock(&mutex);
+          input_domains.emplace_back(input.domain());
+        }
+        auto typed_input = StaticDataTypeCast<const uint16_t, unchecked>(input);
+        auto typed_output = StaticDataTypeCast<uint16_t, unchecked>(output);
+        // Sum of the neighbors that are within the domain.
+        const auto input_interval = input.domain()[0];
+        const auto output_interval = output.domain()[0];
+        for (Index i = output_interval.inclusive_min();
+             i < output_interval.exclusive_max(); ++i) {
+          uint16_t sum = 0;
+          if (Contains(input_interval, i - 1)) sum += typed_input(i - 1);
+          if (Contains(input_interval, i + 1)) sum += typed_input(i + 1);
+          typed_output(i) = sum;
+        }
+        return absl::OkStatus();
+      },
+      options));
+  EXPECT_THAT(input_domains,
+              UnorderedElementsAre(Box<>({0}, {5}), Box<>({3}, {6}),
+                                   Box<>({7}, {3})));
+  EXPECT_THAT(
+      tensorstore::Read(target).result(),
+      Optional(MakeArray<uint16_t>({1, 2, 4, 6, 8, 10, 12, 14, 16, 8})));
+}
+
+TEST(MapChunksTest, FunctionError) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {10}, {2});
+  auto function = [](SharedOffsetArrayView<const void> input,
+                     SharedOffsetArrayView<void> output) {
+    return absl::UnknownError("failed");
+  };
+  EXPECT_THAT(tensorstore::MapChunks(store, function).result(),
+              MatchesStatus(absl::StatusCode::kUnknown, "failed"));
+}
+
+TEST(MapChunksTest, InvalidArguments) {
+  auto context = Context::Default();
+  auto source = OpenChunkedTestStore(context, "<u2", {10}, {2});
+  auto target = OpenChunkedTestStore(context, "<u2", {10, 10}, {2, 2});
+  auto function = [](SharedOffsetArrayView<const void> input,
+                     SharedOffsetArrayView<void> output) {
+    return absl::OkStatus();
+  };
+  EXPECT_THAT(tensorstore::MapChunks(source, target, function).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Source rank \\(1\\) does not match target rank "
+                            "\\(2\\)"));
+  tensorstore::MapChunksOptions options;
+  options.halo = {1, 1};
+  EXPECT_THAT(tensorstore::MapChunks(source, function, options).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Halo .* does not match target rank \\(1\\)"));
+}
+
+TEST(MapChunksTest, TooManyChunks) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(
+      context, "<u2", {Index(1) << 40, Index(1) << 40}, {1, 1});
+  auto function = [](SharedOffsetArrayView<const void> input,
+                     SharedOffsetArrayView<void> output) {
+    return absl::OkStatus();
+  };
+  EXPECT_THAT(tensorstore::MapChunks(store, function).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Number of chunks in .* exceeds maximum of .*"));
+}
+
+}  // namespace
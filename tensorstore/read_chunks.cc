@@ -0,0 +1,363 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/read_chunks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/internal/integer_overflow.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_read_chunks {
+
+using Chunk = ReadChunksIterator::Chunk;
+using ChunkPromise = Promise<std::optional<Chunk>>;
+
+/// Shared state of a `ReadChunksIterator`.
+///
+/// The grid cells are enumerated lazily in C order by `next_cell`.  Initially
+/// reads of up to `max_buffered_chunks` cells are started.  Completed reads
+/// are queued in `ready` until requested by `Next`, or handed directly to a
+/// pending request in `waiters`.  Each time a chunk is handed to the consumer,
+/// the read of the next cell is started, which keeps the number of chunks
+/// being read or buffered constant.
+struct ReadChunksState
+    : public internal::AtomicReferenceCount<ReadChunksState> {
+  TensorStore<> store;
+  Box<> bounds;
+
+  /// Origin and shape of the read chunk grid.
+  std::vector<Index> grid_origin;
+  std::vector<Index> chunk_shape;
+
+  /// Range of grid cell indices that intersect `bounds`.
+  std::vector<Index> first_cell;
+  std::vector<Index> num_cells;
+
+  Index total_cells = 0;
+
+  absl::Mutex mutex;
+  Index next_cell ABSL_GUARDED_BY(mutex) = 0;
+  Index num_delivered ABSL_GUARDED_BY(mutex) = 0;
+  absl::Status error ABSL_GUARDED_BY(mutex);
+  std::deque<Chunk> ready ABSL_GUARDED_BY(mutex);
+  std::deque<ChunkPromise> waiters ABSL_GUARDED_BY(mutex);
+
+  /// Returns the linear index of the next cell to read, or `-1` if all cells
+  /// have been claimed.
+  Index ClaimCell() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+    return next_cell < total_cells ? next_cell++ : -1;
+  }
+
+  /// Computes the bounds of the grid cell with the specified linear index.
+  void GetCellBounds(Index cell, MutableBoxView<> cell_bounds) const {
+    for (DimensionIndex i = bounds.rank() - 1; i >= 0; --i) {
+      const Index grid_cell = first_cell[i] + cell % num_cells[i];
+      cell /= num_cells[i];
+      const Index start = grid_origin[i] + grid_cell * chunk_shape[i];
+      cell_bounds[i] = Intersect(
+          IndexInterval::UncheckedSized(start, chunk_shape[i]), bounds[i]);
+    }
+  }
+
+  /// Starts the read of the specified cell.
+  void StartRead(Index cell);
+
+  /// Invoked when the read of a cell completes.
+  void OnRead(Result<Chunk> result);
+
+  Future<std::optional<Chunk>> Next();
+};
+
+void ReadChunksState::StartRead(Index cell) {
+  Box<> cell_bounds(bounds.rank());
+  GetCellBounds(cell, cell_bounds);
+  auto cell_store = store | AllDims().BoxSlice(cell_bounds);
+  if (!cell_store.ok()) {
+    OnRead(cell_store.status());
+    return;
+  }
+  auto domain = cell_store->domain();
+  tensorstore::Read(*std::move(cell_store))
+      .ExecuteWhenReady(
+          [self = internal::IntrusivePtr<ReadChunksState>(this),
+           domain = std::move(domain)](
+              ReadyFuture<SharedOffsetArray<void>> future) mutable {
+            auto& result = future.result();
+            if (!result.ok()) {
+              self->OnRead(result.status());
+              return;
+            }
+            self->OnRead(Chunk{std::move(domain), *std::move(result)});
+          });
+}
+
+void ReadChunksState::OnRead(Result<Chunk> result) {
+  ChunkPromise waiter;
+  std::deque<ChunkPromise> remaining_waiters;
+  absl::Status status;
+  Index cell = -1;
+  {
+    absl::MutexLock lock(&mutex);
+    if (!error.ok()) return;
+    if (!result.ok()) {
+      status = error = result.status();
+      remaining_waiters = std::move(waiters);
+    } else {
+      while (!waiters.empty()) {
+        auto promise = std::move(waiters.front());
+        waiters.pop_front();
+        // Skip requests that have been abandoned, so that the chunk is not
+        // lost.
+        if (promise.result_needed()) {
+          waiter = std::move(promise);
+          break;
+        }
+      }
+      if (waiter.null()) {
+        ready.push_back(*std::move(result));
+      } else {
+        ++num_delivered;
+        cell = ClaimCell();
+        if (num_delivered == total_cells) {
+          remaining_waiters = std::move(waiters);
+        }
+      }
+    }
+  }
+  if (!waiter.null()) {
+    waiter.SetResult(*std::move(result));
+  }
+  for (auto& promise : remaining_waiters) {
+    if (status.ok()) {
+      promise.SetResult(std::optional<Chunk>());
+    } else {
+      promise.SetResult(status);
+    }
+  }
+  if (cell != -1) StartRead(cell);
+}
+
+Future<std::optional<Chunk>> ReadChunksState::Next() {
+  std::optional<Chunk> chunk;
+  Index cell = -1;
+  Future<std::optional<Chunk>> future;
+  {
+    absl::MutexLock lock(&mutex);
+    if (!error.ok()) return error;
+    if (!ready.empty()) {
+      chunk = std::move(ready.front());
+      ready.pop_front();
+      ++num_delivered;
+      cell = ClaimCell();
+    } else if (num_delivered == total_cells) {
+      return MakeReadyFuture<std::optional<Chunk>>(std::nullopt);
+    } else {
+      auto pair = PromiseFuturePair<std::optional<Chunk>>::Make();
+      waiters.push_back(std::move(pair.promise));
+      future = std::move(pair.future);
+    }
+  }
+  if (cell != -1) StartRead(cell);
+  if (chunk) return MakeReadyFuture<std::optional<Chunk>>(std::move(chunk));
+  return future;
+}
+
+void intrusive_ptr_increment(ReadChunksState* p) {
+  intrusive_ptr_increment(
+      static_cast<internal::AtomicReferenceCount<ReadChunksState>*>(p));
+}
+
+void intrusive_ptr_decrement(ReadChunksState* p) {
+  intrusive_ptr_decrement(
+      static_cast<internal::AtomicReferenceCount<ReadChunksState>*>(p));
+}
+
+namespace {
+
+/// Computes the read chunk grid of `store`.
+absl::Status Initialize(ReadChunksState& state, TensorStore<> store) {
+  const DimensionIndex rank = store.rank();
+  state.bounds = store.domain().box();
+  if (!IsFinite(state.bounds)) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "ReadChunks requires a finite domain, got ", store.domain()));
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto chunk_layout, store.chunk_layout());
+  const auto read_chunk_shape = chunk_layout.read_chunk_shape();
+  const auto grid_origin = chunk_layout.grid_origin();
+  state.grid_origin.resize(rank);
+  state.chunk_shape.resize(rank);
+  state.first_cell.resize(rank);
+  state.num_cells.resize(rank);
+  state.total_cells = 1;
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    const IndexInterval bounds = state.bounds[i];
+    Index chunk_size =
+        read_chunk_shape.size() == rank ? read_chunk_shape[i] : Index(0);
+    Index origin = grid_origin.size() == rank ? grid_origin[i] : kImplicit;
+    if (chunk_size <= 0) {
+      // Treat the entire dimension as a single chunk.
+      chunk_size = std::max(Index(1), bounds.size());
+      origin = bounds.inclusive_min();
+    } else if (origin == kImplicit) {
+      origin = bounds.inclusive_min();
+    }
+    state.grid_origin[i] = origin;
+    state.chunk_shape[i] = chunk_size;
+    if (bounds.empty()) {
+      state.num_cells[i] = 0;
+    } else {
+      state.first_cell[i] =
+          FloorOfRatio(bounds.inclusive_min() - origin, chunk_size);
+      state.num_cells[i] =
+          FloorOfRatio(bounds.inclusive_max() - origin, chunk_size) -
+          state.first_cell[i] + 1;
+    }
+    if (internal::MulOverflow(state.total_cells, state.num_cells[i],
+                              &state.total_cells)) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Number of read chunks in ", state.bounds, " exceeds maximum of ",
+          std::numeric_limits<Index>::max()));
+    }
+  }
+  state.store = std::move(store);
+  return absl::OkStatus();
+}
+
+/// State of the flow receiver form of `ReadChunks`, which delivers the chunks
+/// returned by a `ReadChunksIterator` one at a time.
+struct ReadChunksReceiverState
+    : public internal::AtomicReferenceCount<ReadChunksReceiverState> {
+  ReadChunksIterator iterator;
+  AnyFlowReceiver<absl::Status, IndexDomain<>, SharedOffsetArray<void>>
+      receiver;
+  std::atomic<bool> cancelled{false};
+
+  /// Delivers the result of `iterator.Next()` to `receiver`.
+  ///
+  /// \returns `true` if more chunks may follow.
+  bool Deliver(Result<std::optional<Chunk>>& result) {
+    if (cancelled) {
+      receiver.set_done();
+    } else if (!result.ok()) {
+      receiver.set_error(result.status());
+    } else if (!*result) {
+      receiver.set_done();
+    } else {
+      receiver.set_value(std::move((*result)->domain),
+                         std::move((*result)->array));
+      return true;
+    }
+    receiver.set_stopping();
+    // Release the cancel receiver, which references this state.
+    receiver = {};
+    return false;
+  }
+};
+
+void PumpChunks(internal::IntrusivePtr<ReadChunksReceiverState> state) {
+  while (true) {
+    auto future = state->iterator.Next();
+    if (!future.ready()) {
+      // Continue once the next chunk is available.  The iterator does not
+      // read beyond the read-ahead limit in the meantime.
+      std::move(future).ExecuteWhenReady(
+          [state = std::move(state)](
+              ReadyFuture<std::optional<Chunk>> future) mutable {
+            if (state->Deliver(future.result())) {
+              PumpChunks(std::move(state));
+            }
+          });
+      return;
+    }
+    if (!state->Deliver(future.result())) return;
+  }
+}
+
+}  // namespace
+}  // namespace internal_read_chunks
+
+ReadChunksIterator::ReadChunksIterator()
+    : ReadChunksIterator(
+          internal::MakeIntrusivePtr<internal_read_chunks::ReadChunksState>()) {
+}
+
+ReadChunksIterator::ReadChunksIterator(
+    internal::IntrusivePtr<internal_read_chunks::ReadChunksState> state)
+    : state_(std::move(state)) {}
+
+Future<std::optional<ReadChunksIterator::Chunk>> ReadChunksIterator::Next() {
+  return state_->Next();
+}
+
+ReadChunksIterator ReadChunks(TensorStore<> store, ReadChunksOptions options) {
+  auto state =
+      internal::MakeIntrusivePtr<internal_read_chunks::ReadChunksState>();
+  auto status = internal_read_chunks::Initialize(*state, std::move(store));
+  Index num_initial_reads = 0;
+  {
+    absl::MutexLock lock(&state->mutex);
+    if (!status.ok()) {
+      state->error = std::move(status);
+    } else {
+      num_initial_reads = std::min(
+          std::max(Index(1), options.max_buffered_chunks), state->total_cells);
+      state->next_cell = num_initial_reads;
+    }
+  }
+  for (Index cell = 0; cell < num_initial_reads; ++cell) {
+    state->StartRead(cell);
+  }
+  return ReadChunksIterator(std::move(state));
+}
+
+void ReadChunks(
+    TensorStore<> store,
+    AnyFlowReceiver<absl::Status, IndexDomain<>, SharedOffsetArray<void>>
+        receiver,
+    ReadChunksOptions options) {
+  auto state = internal::MakeIntrusivePtr<
+      internal_read_chunks::ReadChunksReceiverState>();
+  state->receiver = std::move(receiver);
+  state->receiver.set_starting([state] { state->cancelled = true; });
+  state->iterator = ReadChunks(std::move(store), std::move(options));
+  internal_read_chunks::PumpChunks(std::move(state));
+}
+
+}  // namespace tensorstore
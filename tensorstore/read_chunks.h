@@ -0,0 +1,138 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_READ_CHUNKS_H_
+#define TENSORSTORE_READ_CHUNKS_H_
+
+/// \file
+/// Streaming chunk-by-chunk reads of TensorStore objects.
+
+#include <optional>
+
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+
+/// Options for `ReadChunks`.
+///
+/// \relates ReadChunks
+struct ReadChunksOptions {
+  /// Maximum number of chunks that are read ahead of the consumer, i.e. that
+  /// are either being read or have been read but not yet delivered.  This
+  /// bounds the memory used by the operation.
+  Index max_buffered_chunks = 4;
+};
+
+namespace internal_read_chunks {
+struct ReadChunksState;
+void intrusive_ptr_increment(ReadChunksState* p);
+void intrusive_ptr_decrement(ReadChunksState* p);
+}  // namespace internal_read_chunks
+
+/// Asynchronous iterator over the read chunks of a TensorStore, returned by
+/// `ReadChunks`.
+///
+/// \relates ReadChunks
+class ReadChunksIterator {
+ public:
+  /// A single piece of the result.
+  struct Chunk {
+    /// Domain of the piece, a sub-region of the domain of the store.
+    IndexDomain<> domain;
+
+    /// Array with the bounds of `domain`.
+    SharedOffsetArray<void> array;
+  };
+
+  /// Constructs an iterator that has no chunks.
+  ReadChunksIterator();
+
+  /// Returns a future for the next chunk to be read.
+  ///
+  /// Chunks are returned in the order in which their reads complete.  The
+  /// future resolves to `std::nullopt` once all chunks have been returned, or
+  /// to an error if any read fails.  Multiple calls to `Next` may be
+  /// outstanding at once; they are satisfied in the order in which they were
+  /// made.
+  ///
+  /// Each call to `Next` permits one additional chunk to be read.
+  Future<std::optional<Chunk>> Next();
+
+ private:
+  friend ReadChunksIterator ReadChunks(TensorStore<> store,
+                                       ReadChunksOptions options);
+  explicit ReadChunksIterator(
+      internal::IntrusivePtr<internal_read_chunks::ReadChunksState> state);
+  internal::IntrusivePtr<internal_read_chunks::ReadChunksState> state_;
+};
+
+/// Reads `store` one chunk at a time.
+///
+/// The read chunk grid of `store`, as specified by its `ChunkLayout`, is
+/// iterated over the domain of `store`.  Each grid cell, intersected with the
+/// domain, is read separately, and the pieces are returned by the iterator in
+/// the order in which their reads complete.  Unlike `Read`, the result is
+/// never assembled into a single array: at most
+/// `options.max_buffered_chunks` pieces are read ahead of the consumer, so
+/// that the peak memory and the latency until the first piece is available
+/// are proportional to the size of a few chunks rather than the size of the
+/// domain.
+///
+/// If a dimension of `store` has no read chunk size specified, the entire
+/// extent of that dimension is treated as a single chunk.
+///
+/// Example::
+///
+///     auto it = tensorstore::ReadChunks(store);
+///     while (true) {
+///       TENSORSTORE_ASSIGN_OR_RETURN(auto chunk, it.Next().result());
+///       if (!chunk) break;
+///       Process(chunk->domain, chunk->array);
+///     }
+///
+/// Errors, such as a non-finite domain, are reported by `Next`.
+///
+/// \param store TensorStore that supports reading.  The domain must be finite.
+/// \param options Specifies the read-ahead limit.
+/// \ingroup read_chunks
+ReadChunksIterator ReadChunks(TensorStore<> store,
+                              ReadChunksOptions options = {});
+
+/// Reads `store` one chunk at a time, delivering each piece to `receiver`.
+///
+/// Equivalent to the iterator form of `ReadChunks`, except that each piece is
+/// passed to `receiver.set_value(domain, array)`.  Calls to `set_value` are
+/// never concurrent, and the next chunk beyond the read-ahead limit is not
+/// read until the previous call to `set_value` has returned, which provides
+/// backpressure.  Once all pieces have been delivered, `set_done` is called;
+/// if a read fails, `set_error` is called instead.  Cancelling via the
+/// `AnyCancelReceiver` passed to `set_starting` stops delivery.
+///
+/// \ingroup read_chunks
+void ReadChunks(
+    TensorStore<> store,
+    AnyFlowReceiver<absl::Status, IndexDomain<>, SharedOffsetArray<void>>
+        receiver,
+    ReadChunksOptions options = {});
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_READ_CHUNKS_H_
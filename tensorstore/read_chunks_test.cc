@@ -0,0 +1,198 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/read_chunks.h"
+
+#include <stdint.h>
+
+#include <optional>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunked_store_testutil.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/open.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Box;
+using ::tensorstore::Context;
+using ::tensorstore::Dims;
+using ::tensorstore::Index;
+using ::tensorstore::IndexDomain;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::ReadChunksIterator;
+using ::tensorstore::SharedOffsetArray;
+using ::tensorstore::internal::OpenChunkedTestStore;
+using ::testing::UnorderedElementsAre;
+
+tensorstore::SharedArray<const uint16_t, 2> GetData() {
+  return MakeArray<uint16_t>({{0, 1, 2, 3, 4, 5},
+                              {6, 7, 8, 9, 10, 11},
+                              {12, 13, 14, 15, 16, 17},
+                              {18, 19, 20, 21, 22, 23},
+                              {24, 25, 26, 27, 28, 29}});
+}
+
+/// Reads all chunks from `it`, checking that each chunk matches `GetData()`.
+std::vector<Box<>> ReadAll(ReadChunksIterator& it) {
+  std::vector<Box<>> domains;
+  while (true) {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(auto chunk, it.Next().result());
+    if (!chunk) break;
+    EXPECT_EQ(chunk->domain.box(), chunk->array.domain());
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto expected, GetData() |
+                           tensorstore::AllDims().BoxSlice(
+                               chunk->array.domain()) |
+                           tensorstore::Materialize());
+    EXPECT_EQ(expected, chunk->array);
+    domains.push_back(Box<>(chunk->domain.box()));
+  }
+  return domains;
+}
+
+TEST(ReadChunksTest, Iterator) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {5, 6}, {3, 4});
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(GetData(), store).result());
+  auto it = tensorstore::ReadChunks(store, {/*.max_buffered_chunks=*/2});
+  EXPECT_THAT(ReadAll(it),
+              UnorderedElementsAre(Box({0, 0}, {3, 4}), Box({0, 4}, {3, 2}),
+                                   Box({3, 0}, {2, 4}), Box({3, 4}, {2, 2})));
+  // Once exhausted, the iterator continues to return `std::nullopt`.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto chunk, it.Next().result());
+  EXPECT_FALSE(chunk);
+}
+
+TEST(ReadChunksTest, Subregion) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {5, 6}, {3, 4});
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(GetData(), store).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto sub_store, store | Dims(0, 1).HalfOpenInterval({1, 2}, {4, 5}));
+  auto it = tensorstore::ReadChunks(sub_store);
+  EXPECT_THAT(ReadAll(it),
+              UnorderedElementsAre(Box({1, 2}, {2, 2}), Box({1, 4}, {2, 1}),
+                                   Box({3, 2}, {1, 2}), Box({3, 4}, {1, 1})));
+}
+
+TEST(ReadChunksTest, ConcurrentNext) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {5, 6}, {3, 4});
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(GetData(), store).result());
+  auto it = tensorstore::ReadChunks(store, {/*.max_buffered_chunks=*/1});
+  std::vector<tensorstore::Future<std::optional<ReadChunksIterator::Chunk>>>
+      futures;
+  for (int i = 0; i < 5; ++i) futures.push_back(it.Next());
+  std::vector<Box<>> domains;
+  for (int i = 0; i < 4; ++i) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto chunk, futures[i].result());
+    ASSERT_TRUE(chunk);
+    domains.push_back(Box<>(chunk->domain.box()));
+  }
+  EXPECT_THAT(domains,
+              UnorderedElementsAre(Box({0, 0}, {3, 4}), Box({0, 4}, {3, 2}),
+                                   Box({3, 0}, {2, 4}), Box({3, 4}, {2, 2})));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto chunk, futures[4].result());
+  EXPECT_FALSE(chunk);
+}
+
+TEST(ReadChunksTest, Labels) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {5, 6}, {5, 6});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto labeled_store, store | Dims(0, 1).Label("x", "y"));
+  auto it = tensorstore::ReadChunks(labeled_store);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto chunk, it.Next().result());
+  ASSERT_TRUE(chunk);
+  EXPECT_THAT(chunk->domain.labels(), ::testing::ElementsAre("x", "y"));
+}
+
+TEST(ReadChunksTest, NonFiniteDomain) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open({{"driver", "array"},
+                         {"array", {1, 2, 3}},
+                         {"dtype", "int32"},
+                         {"transform",
+                          {{"input_inclusive_min", {"-inf"}},
+                           {"input_exclusive_max", {"+inf"}},
+                           {"output", {{{"input_dimension", 0}}}}}}},
+                        context)
+          .result());
+  auto it = tensorstore::ReadChunks(store);
+  EXPECT_THAT(it.Next().result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "ReadChunks requires a finite domain.*"));
+}
+
+TEST(ReadChunksTest, TooManyChunks) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(
+      context, "<u2", {Index(1) << 40, Index(1) << 40}, {1, 1});
+  auto it = tensorstore::ReadChunks(store);
+  EXPECT_THAT(
+      it.Next().result(),
+      MatchesStatus(absl::StatusCode::kInvalidArgument,
+                    "Number of read chunks in .* exceeds maximum of .*"));
+}
+
+/// FlowReceiver that records the domains of the chunks it receives.
+struct CollectingReceiver {
+  std::vector<Box<>>* domains;
+  absl::Status* status;
+  absl::Notification* stopped;
+  void set_starting(tensorstore::AnyCancelReceiver cancel) {}
+  void set_value(IndexDomain<> domain, SharedOffsetArray<void> array) {
+    EXPECT_EQ(domain.box(), array.domain());
+    domains->push_back(Box<>(domain.box()));
+  }
+  void set_done() {}
+  void set_error(absl::Status error) { *status = std::move(error); }
+  void set_stopping() { stopped->Notify(); }
+};
+
+TEST(ReadChunksTest, Receiver) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {5, 6}, {3, 4});
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(GetData(), store).result());
+  std::vector<Box<>> domains;
+  absl::Status status;
+  absl::Notification stopped;
+  tensorstore::ReadChunks(store,
+                          CollectingReceiver{&domains, &status, &stopped},
+                          {/*.max_buffered_chunks=*/1});
+  stopped.WaitForNotification();
+  TENSORSTORE_EXPECT_OK(status);
+  EXPECT_THAT(domains,
+              UnorderedElementsAre(Box({0, 0}, {3, 4}), Box({0, 4}, {3, 2}),
+                                   Box({3, 0}, {2, 4}), Box({3, 4}, {2, 2})));
+}
+
+}  // namespace
@@ -17,6 +17,7 @@
 
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/index_space/alignment.h"
+#include "tensorstore/io_statistics.h"
 #include "tensorstore/progress.h"
 
 namespace tensorstore {
@@ -39,6 +40,9 @@ struct ReadOptions {
 
   /// Optional progress callback.
   ReadProgressFunction progress_function;
+
+  /// Optional sink for the I/O statistics of this operation.
+  IoStatisticsPtr io_statistics;
 };
 
 /// Options for `tensorstore::Read` into new array.
@@ -59,6 +63,46 @@ struct ReadIntoNewArrayOptions {
 
   /// Optional progress callback.
   ReadProgressFunction progress_function;
+
+  /// Optional sink for the I/O statistics of this operation.
+  IoStatisticsPtr io_statistics;
+};
+
+/// Options for `tensorstore::Read` into a read-only array that may reference
+/// cached data.
+///
+/// \relates Read[TensorStore, ReadIntoSharedArrayOptions]
+struct ReadIntoSharedArrayOptions {
+  /// Constructs the options.
+  ReadIntoSharedArrayOptions(ContiguousLayoutOrder layout_order = {},
+                             ReadProgressFunction progress_function = {})
+      : layout_order(layout_order),
+        progress_function(std::move(progress_function)) {}
+  ReadIntoSharedArrayOptions(ReadProgressFunction progress_function)
+      : progress_function(std::move(progress_function)) {}
+
+  /// Specifies the required layout order of the returned array.  Defaults to
+  /// `c_order`.
+  ContiguousLayoutOrder layout_order = c_order;
+
+  /// Optional progress callback.
+  ReadProgressFunction progress_function;
+
+  /// Optional sink for the I/O statistics of this operation.
+  IoStatisticsPtr io_statistics;
+};
+
+/// Options for `tensorstore::Reduce`.
+///
+/// \relates Reduce
+struct ReduceOptions {
+  /// Constructs the options.
+  ReduceOptions(ReadProgressFunction progress_function = {})
+      : progress_function(std::move(progress_function)) {}
+
+  /// Optional progress callback.  The `copied_elements` member indicates the
+  /// number of elements that have been reduced.
+  ReadProgressFunction progress_function;
 };
 
 /// Options for `tensorstore::Write`.
@@ -79,6 +123,9 @@ struct WriteOptions {
 
   /// Optional progress callback.
   WriteProgressFunction progress_function;
+
+  /// Optional sink for the I/O statistics of this operation.
+  IoStatisticsPtr io_statistics;
 };
 
 /// Options for `tensorstore::Copy`.
@@ -100,6 +147,9 @@ struct CopyOptions {
 
   /// Optional progress callback.
   CopyProgressFunction progress_function;
+
+  /// Optional sink for the I/O statistics of this operation.
+  IoStatisticsPtr io_statistics;
 };
 
 }  // namespace tensorstore
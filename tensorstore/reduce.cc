@@ -0,0 +1,214 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/reduce.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "tensorstore/index.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+
+namespace {
+
+/// Number of independent accumulators used by the reduction kernels.  Using
+/// several independent accumulators breaks the loop-carried dependency on a
+/// single accumulator, which permits the compiler to vectorize the loop
+/// without reassociating floating-point operations.
+constexpr ptrdiff_t kNumLanes = 8;
+
+}  // namespace
+
+double SummaryStatistics::mean() const {
+  return count == 0 ? std::numeric_limits<double>::quiet_NaN()
+                    : sum / static_cast<double>(count);
+}
+
+void SummaryStatistics::Add(span<const double> values) {
+  const double* data = values.data();
+  const ptrdiff_t n = values.size();
+  double lane_sum[kNumLanes] = {};
+  double lane_min[kNumLanes], lane_max[kNumLanes];
+  std::fill_n(lane_min, kNumLanes, min);
+  std::fill_n(lane_max, kNumLanes, max);
+  ptrdiff_t i = 0;
+  for (; i + kNumLanes <= n; i += kNumLanes) {
+    for (ptrdiff_t j = 0; j < kNumLanes; ++j) {
+      const double v = data[i + j];
+      lane_sum[j] += v;
+      // Written so that NaN values are ignored.
+      lane_min[j] = v < lane_min[j] ? v : lane_min[j];
+      lane_max[j] = v > lane_max[j] ? v : lane_max[j];
+    }
+  }
+  for (ptrdiff_t j = 0; i < n; ++i, ++j) {
+    const double v = data[i];
+    lane_sum[j] += v;
+    lane_min[j] = v < lane_min[j] ? v : lane_min[j];
+    lane_max[j] = v > lane_max[j] ? v : lane_max[j];
+  }
+  for (ptrdiff_t j = 0; j < kNumLanes; ++j) {
+    sum += lane_sum[j];
+    min = std::min(min, lane_min[j]);
+    max = std::max(max, lane_max[j]);
+  }
+  count += n;
+}
+
+void SummaryStatistics::Merge(const SummaryStatistics& other) {
+  count += other.count;
+  sum += other.sum;
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+}
+
+bool operator==(const SummaryStatistics& a, const SummaryStatistics& b) {
+  return a.count == b.count && a.sum == b.sum && a.min == b.min &&
+         a.max == b.max;
+}
+
+std::ostream& operator<<(std::ostream& os, const SummaryStatistics& x) {
+  return os << "{ count=" << x.count << ", sum=" << x.sum << ", min=" << x.min
+            << ", max=" << x.max << " }";
+}
+
+Histogram::Histogram(double lower, double upper, Index num_bins)
+    : lower(lower), upper(upper), counts(num_bins) {
+  assert(lower < upper);
+  assert(num_bins > 0);
+}
+
+void Histogram::Add(span<const double> values) {
+  const Index num_bins = counts.size();
+  const double scale = num_bins / (upper - lower);
+  Index* bin_counts = counts.data();
+  for (const double v : values) {
+    if (v < lower) {
+      ++underflow;
+    } else if (v >= upper) {
+      ++overflow;
+    } else if (v == v) {
+      // Rounding may produce `num_bins` for values just below `upper`.
+      const Index bin = std::min(num_bins - 1,
+                                 static_cast<Index>((v - lower) * scale));
+      ++bin_counts[bin];
+    }
+  }
+}
+
+void Histogram::Merge(const Histogram& other) {
+  assert(lower == other.lower && upper == other.upper &&
+         counts.size() == other.counts.size());
+  for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+  underflow += other.underflow;
+  overflow += other.overflow;
+}
+
+bool operator==(const Histogram& a, const Histogram& b) {
+  return a.lower == b.lower && a.upper == b.upper && a.counts == b.counts &&
+         a.underflow == b.underflow && a.overflow == b.overflow;
+}
+
+QuantileSketch::QuantileSketch(double relative_accuracy)
+    : relative_accuracy_(relative_accuracy),
+      gamma_((1 + relative_accuracy) / (1 - relative_accuracy)),
+      inv_log_gamma_(1 / std::log(gamma_)) {
+  assert(relative_accuracy > 0 && relative_accuracy < 1);
+}
+
+void QuantileSketch::Buckets::Increment(int32_t key, Index count) {
+  if (counts.empty()) {
+    offset = key;
+  } else if (key < offset) {
+    counts.insert(counts.begin(), offset - key, 0);
+    offset = key;
+  }
+  const size_t index = key - offset;
+  if (index >= counts.size()) counts.resize(index + 1);
+  counts[index] += count;
+}
+
+int32_t QuantileSketch::Key(double magnitude) const {
+  // Bucket `k` contains magnitudes in `(gamma**(k-1), gamma**k]`.  Infinite
+  // magnitudes are counted in the bucket of the largest finite magnitude.
+  magnitude = std::min(magnitude, std::numeric_limits<double>::max());
+  return static_cast<int32_t>(std::ceil(std::log(magnitude) * inv_log_gamma_));
+}
+
+double QuantileSketch::Value(int32_t key) const {
+  // Representative value with relative error at most `relative_accuracy_`
+  // for all magnitudes in the bucket.
+  return 2 * std::pow(gamma_, key) / (gamma_ + 1);
+}
+
+void QuantileSketch::Add(span<const double> values) {
+  for (const double v : values) {
+    if (v > 0) {
+      positive_.Increment(Key(v), 1);
+    } else if (v < 0) {
+      negative_.Increment(Key(-v), 1);
+    } else if (v == 0) {
+      ++zero_count_;
+    } else {
+      // NaN
+      continue;
+    }
+    ++count_;
+  }
+}
+
+void QuantileSketch::Merge(const QuantileSketch& other) {
+  assert(relative_accuracy_ == other.relative_accuracy_);
+  for (size_t i = 0; i < other.positive_.counts.size(); ++i) {
+    if (!other.positive_.counts[i]) continue;
+    positive_.Increment(other.positive_.offset + i, other.positive_.counts[i]);
+  }
+  for (size_t i = 0; i < other.negative_.counts.size(); ++i) {
+    if (!other.negative_.counts[i]) continue;
+    negative_.Increment(other.negative_.offset + i, other.negative_.counts[i]);
+  }
+  zero_count_ += other.zero_count_;
+  count_ += other.count_;
+}
+
+double QuantileSketch::Quantile(double q) const {
+  if (count_ == 0) return std::numeric_limits<double>::quiet_NaN();
+  q = std::clamp(q, 0.0, 1.0);
+  // Zero-based rank of the requested value, using "nearest" interpolation.
+  Index rank = static_cast<Index>(std::nearbyint(q * (count_ - 1)));
+  // Negative values in increasing order, i.e. decreasing magnitude.
+  for (size_t i = negative_.counts.size(); i-- > 0;) {
+    if (rank < negative_.counts[i]) return -Value(negative_.offset + i);
+    rank -= negative_.counts[i];
+  }
+  if (rank < zero_count_) return 0;
+  rank -= zero_count_;
+  for (size_t i = 0; i < positive_.counts.size(); ++i) {
+    if (rank < positive_.counts[i]) return Value(positive_.offset + i);
+    rank -= positive_.counts[i];
+  }
+  // Unreachable, since `rank < count_`.
+  return std::numeric_limits<double>::quiet_NaN();
+}
+
+}  // namespace tensorstore
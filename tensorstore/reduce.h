@@ -0,0 +1,347 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_REDUCE_H_
+#define TENSORSTORE_REDUCE_H_
+
+/// \file
+/// Chunk-parallel reductions over TensorStore objects.
+
+#include <stdint.h>
+
+#include <iosfwd>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/array.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/reduce.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/type_traits.h"
+#include "tensorstore/read_write_options.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+
+/// Count, sum, minimum and maximum of a collection of values.
+///
+/// NaN values are counted and propagate to `sum`, but are ignored by `min`
+/// and `max`.
+///
+/// \ingroup reduce
+struct SummaryStatistics {
+  /// Number of values.
+  Index count = 0;
+
+  /// Sum of the values.
+  double sum = 0;
+
+  /// Minimum value, or `+inf` if there are no (non-NaN) values.
+  double min = std::numeric_limits<double>::infinity();
+
+  /// Maximum value, or `-inf` if there are no (non-NaN) values.
+  double max = -std::numeric_limits<double>::infinity();
+
+  /// Returns the mean, or NaN if `count == 0`.
+  double mean() const;
+
+  /// Adds the values in `values`.
+  void Add(span<const double> values);
+
+  /// Merges the values summarized by `other`.
+  void Merge(const SummaryStatistics& other);
+
+  friend bool operator==(const SummaryStatistics& a,
+                         const SummaryStatistics& b);
+  friend bool operator!=(const SummaryStatistics& a,
+                         const SummaryStatistics& b) {
+    return !(a == b);
+  }
+  friend std::ostream& operator<<(std::ostream& os,
+                                  const SummaryStatistics& x);
+};
+
+/// Counts of values in equal-width bins over a half-open interval
+/// `[lower, upper)`.
+///
+/// NaN values are ignored.
+///
+/// \ingroup reduce
+struct Histogram {
+  /// Constructs an empty histogram with `num_bins` bins.
+  ///
+  /// \dchecks `lower < upper`
+  /// \dchecks `num_bins > 0`
+  Histogram(double lower = 0, double upper = 1, Index num_bins = 1);
+
+  /// Lower bound of the first bin.
+  double lower;
+
+  /// Upper (exclusive) bound of the last bin.
+  double upper;
+
+  /// Number of values in each bin.
+  std::vector<Index> counts;
+
+  /// Number of values less than `lower`.
+  Index underflow = 0;
+
+  /// Number of values greater than or equal to `upper`.
+  Index overflow = 0;
+
+  /// Adds the values in `values`.
+  void Add(span<const double> values);
+
+  /// Merges the counts of `other`, which must have the same bins.
+  void Merge(const Histogram& other);
+
+  friend bool operator==(const Histogram& a, const Histogram& b);
+  friend bool operator!=(const Histogram& a, const Histogram& b) {
+    return !(a == b);
+  }
+};
+
+/// Mergeable sketch for computing approximate quantiles.
+///
+/// Values are counted in logarithmically-spaced buckets, such that each
+/// quantile estimate is within a relative error of `relative_accuracy` of a
+/// value of the exact quantile.  The memory used is proportional to the
+/// logarithm of the ratio of the largest to smallest non-zero magnitudes,
+/// independent of the number of values.  NaN values are ignored.
+///
+/// \ingroup reduce
+class QuantileSketch {
+ public:
+  /// Constructs an empty sketch.
+  ///
+  /// \dchecks `0 < relative_accuracy && relative_accuracy < 1`
+  explicit QuantileSketch(double relative_accuracy = 0.01);
+
+  /// Adds the values in `values`.
+  void Add(span<const double> values);
+
+  /// Merges the values counted by `other`, which must have the same
+  /// `relative_accuracy`.
+  void Merge(const QuantileSketch& other);
+
+  /// Returns the number of values added.
+  Index count() const { return count_; }
+
+  /// Returns the relative accuracy.
+  double relative_accuracy() const { return relative_accuracy_; }
+
+  /// Returns an estimate of the `q` quantile, or NaN if `count() == 0`.
+  ///
+  /// \param q Quantile in `[0, 1]`; values outside that range are clamped.
+  double Quantile(double q) const;
+
+ private:
+  /// Counts for a contiguous range of bucket keys.
+  struct Buckets {
+    int32_t offset = 0;
+    std::vector<Index> counts;
+    void Increment(int32_t key, Index count);
+  };
+
+  int32_t Key(double magnitude) const;
+  double Value(int32_t key) const;
+
+  double relative_accuracy_;
+  double gamma_;
+  double inv_log_gamma_;
+  Index count_ = 0;
+  Index zero_count_ = 0;
+  Buckets positive_;
+  Buckets negative_;
+};
+
+/// Reducer that computes `SummaryStatistics`, i.e. the sum, mean, minimum and
+/// maximum.
+///
+/// \ingroup reduce
+struct SummaryStatisticsReducer {
+  using Element = double;
+  using Accumulator = SummaryStatistics;
+  Accumulator Initial() const { return {}; }
+  void Accumulate(Accumulator& accumulator, span<const double> values) const {
+    accumulator.Add(values);
+  }
+  void Merge(Accumulator& accumulator, Accumulator&& other) const {
+    accumulator.Merge(other);
+  }
+};
+
+/// Reducer that computes a `Histogram`.
+///
+/// \ingroup reduce
+struct HistogramReducer {
+  using Element = double;
+  using Accumulator = Histogram;
+
+  /// Lower bound of the first bin.
+  double lower;
+
+  /// Upper (exclusive) bound of the last bin.
+  double upper;
+
+  /// Number of bins.
+  Index num_bins;
+
+  Accumulator Initial() const { return Histogram(lower, upper, num_bins); }
+  void Accumulate(Accumulator& accumulator, span<const double> values) const {
+    accumulator.Add(values);
+  }
+  void Merge(Accumulator& accumulator, Accumulator&& other) const {
+    accumulator.Merge(other);
+  }
+};
+
+/// Reducer that computes a `QuantileSketch`.
+///
+/// \ingroup reduce
+struct QuantileSketchReducer {
+  using Element = double;
+  using Accumulator = QuantileSketch;
+
+  /// Relative accuracy of the quantile estimates.
+  double relative_accuracy = 0.01;
+
+  Accumulator Initial() const { return QuantileSketch(relative_accuracy); }
+  void Accumulate(Accumulator& accumulator, span<const double> values) const {
+    accumulator.Add(values);
+  }
+  void Merge(Accumulator& accumulator, Accumulator&& other) const {
+    accumulator.Merge(other);
+  }
+};
+
+namespace internal_reduce {
+
+/// Shared state of a `Reduce` operation.
+template <typename Reducer>
+struct ReduceState
+    : public internal::AtomicReferenceCount<ReduceState<Reducer>> {
+  using Accumulator = typename Reducer::Accumulator;
+  explicit ReduceState(Reducer reducer)
+      : reducer(std::move(reducer)), accumulator(this->reducer.Initial()) {}
+  Reducer reducer;
+  absl::Mutex mutex;
+  Accumulator accumulator ABSL_GUARDED_BY(mutex);
+};
+
+/// Block function used by `Reduce`.
+///
+/// Each block is first reduced into a separate partial accumulator without
+/// holding any lock, and then merged.
+template <typename Reducer>
+struct ReduceBlock {
+  using Element = typename Reducer::Element;
+  internal::IntrusivePtr<ReduceState<Reducer>> state;
+  absl::Status operator()(ArrayView<const void, 1> block) const {
+    auto partial = state->reducer.Initial();
+    state->reducer.Accumulate(
+        partial, span<const Element>(static_cast<const Element*>(block.data()),
+                                     block.num_elements()));
+    absl::MutexLock lock(&state->mutex);
+    state->reducer.Merge(state->accumulator, std::move(partial));
+    return absl::OkStatus();
+  }
+};
+
+}  // namespace internal_reduce
+
+/// Reduces the elements of a TensorStore using `reducer`.
+///
+/// The chunks that intersect the domain of `source` are streamed through the
+/// cache as they become available and reduced in parallel, in blocks of
+/// bounded size, using the data copy executor of `source`.  Unlike `Read`, no
+/// array of the size of `source` is allocated, and only a bounded number of
+/// read chunks (16) are requested at a time, so memory usage does not grow
+/// with the size of `source`.
+///
+/// The `Reducer` type must define:
+///
+/// - ``Element``: the element type to which values are converted before they
+///   are passed to ``Accumulate``.
+///
+/// - ``Accumulator``: a movable type representing a partial result.
+///
+/// - ``Accumulator Initial() const``: returns the identity partial result.
+///
+/// - ``void Accumulate(Accumulator& accumulator,
+///   span<const Element> values) const``: adds a contiguous block of values.
+///   May be invoked concurrently on different accumulators.
+///
+/// - ``void Merge(Accumulator& accumulator, Accumulator&& other) const``:
+///   merges `other` into `accumulator`.
+///
+/// Built-in reducers include `SummaryStatisticsReducer`, `HistogramReducer`
+/// and `QuantileSketchReducer`.
+///
+/// Example::
+///
+///     TensorReader<std::uint16_t, 3> store = ...;
+///     TENSORSTORE_ASSIGN_OR_RETURN(
+///         auto stats,
+///         Reduce(store, SummaryStatisticsReducer{}).result());
+///     std::cout << stats.mean() << std::endl;
+///
+/// \param source Source TensorStore object that supports reading.  May be
+///     `Result`-wrapped.
+/// \param reducer The reducer.
+/// \param options Specifies optional progress function.
+/// \returns A future that becomes ready with the merged result of all blocks
+///     when the reduction has completed successfully or has failed.
+/// \error `absl::StatusCode::kInvalidArgument` if the data type of `source`
+///     cannot be converted to `Reducer::Element`.
+/// \ingroup reduce
+template <typename Source, typename Reducer>
+Future<typename Reducer::Accumulator> Reduce(Source&& source, Reducer reducer,
+                                             ReduceOptions options = {}) {
+  using Accumulator = typename Reducer::Accumulator;
+  using State = internal_reduce::ReduceState<Reducer>;
+  return MapResult(
+      [&](UnwrapQualifiedResultType<Source&&> unwrapped_source)
+          -> Future<Accumulator> {
+        internal::IntrusivePtr<State> state(new State(std::move(reducer)));
+        auto future = internal::DriverReduce(
+            internal::TensorStoreAccess::handle(
+                std::forward<decltype(unwrapped_source)>(unwrapped_source)),
+            dtype_v<typename Reducer::Element>,
+            internal_reduce::ReduceBlock<Reducer>{state}, std::move(options));
+        return MapFuture(
+            InlineExecutor{},
+            [state = std::move(state)](
+                const Result<void>& result) -> Result<Accumulator> {
+              TENSORSTORE_RETURN_IF_ERROR(result);
+              absl::MutexLock lock(&state->mutex);
+              return std::move(state->accumulator);
+            },
+            std::move(future));
+      },
+      std::forward<Source>(source));
+}
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_REDUCE_H_
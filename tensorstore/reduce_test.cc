@@ -0,0 +1,272 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/reduce.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/array.h"
+#include "tensorstore/chunked_store_testutil.h"
+#include "tensorstore/context.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/array/array.h"
+#include "tensorstore/driver/reduce.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/progress.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::Dims;
+using ::tensorstore::Histogram;
+using ::tensorstore::HistogramReducer;
+using ::tensorstore::Index;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::QuantileSketch;
+using ::tensorstore::QuantileSketchReducer;
+using ::tensorstore::ReadProgress;
+using ::tensorstore::SummaryStatistics;
+using ::tensorstore::SummaryStatisticsReducer;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+using ::tensorstore::internal::OpenChunkedTestStore;
+
+/// Returns a zarr TensorStore of shape `{10, 9}` and chunk shape `{3, 4}`
+/// containing the values `i * 9 + j`.
+tensorstore::TensorStore<> OpenChunkedStore() {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {10, 9}, {3, 4});
+  auto array = tensorstore::AllocateArray<uint16_t>({10, 9});
+  for (Index i = 0; i < 10; ++i) {
+    for (Index j = 0; j < 9; ++j) array(i, j) = i * 9 + j;
+  }
+  TENSORSTORE_CHECK_OK(tensorstore::Write(array, store).result());
+  return store;
+}
+
+TEST(SummaryStatisticsTest, Add) {
+  SummaryStatistics stats;
+  EXPECT_TRUE(std::isnan(stats.mean()));
+  std::vector<double> values{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+  stats.Add(values);
+  EXPECT_EQ(11, stats.count);
+  EXPECT_EQ(44, stats.sum);
+  EXPECT_EQ(1, stats.min);
+  EXPECT_EQ(9, stats.max);
+  EXPECT_EQ(4, stats.mean());
+}
+
+TEST(SummaryStatisticsTest, NaN) {
+  SummaryStatistics stats;
+  std::vector<double> values{1, std::nan(""), 2};
+  stats.Add(values);
+  EXPECT_EQ(3, stats.count);
+  EXPECT_TRUE(std::isnan(stats.sum));
+  EXPECT_EQ(1, stats.min);
+  EXPECT_EQ(2, stats.max);
+}
+
+TEST(HistogramTest, Add) {
+  Histogram histogram(0, 10, 5);
+  std::vector<double> values{-1, 0, 1.5, 2, 9.99, 10, 11, std::nan("")};
+  histogram.Add(values);
+  EXPECT_THAT(histogram.counts, ::testing::ElementsAre(2, 1, 0, 0, 1));
+  EXPECT_EQ(1, histogram.underflow);
+  EXPECT_EQ(2, histogram.overflow);
+}
+
+TEST(QuantileSketchTest, Accuracy) {
+  QuantileSketch a(0.01), b(0.01);
+  std::vector<double> values;
+  for (int i = -500; i <= 1500; ++i) values.push_back(i);
+  // Split the values between two sketches to exercise `Merge`.
+  a.Add(tensorstore::span<const double>(values).subspan(0, 700));
+  b.Add(tensorstore::span<const double>(values).subspan(700));
+  a.Merge(b);
+  EXPECT_EQ(2001, a.count());
+  EXPECT_EQ(0, a.Quantile(0.25));
+  EXPECT_NEAR(-500, a.Quantile(0), 5);
+  EXPECT_NEAR(500, a.Quantile(0.5), 5);
+  EXPECT_NEAR(1000, a.Quantile(0.75), 10);
+  EXPECT_NEAR(1500, a.Quantile(1), 15);
+  EXPECT_TRUE(std::isnan(QuantileSketch().Quantile(0.5)));
+}
+
+TEST(ReduceTest, SummaryStatisticsFromArray) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::FromArray(Context::Default(),
+                                         MakeArray<int32_t>({{1, -2, 3},
+                                                             {4, 5, 6}})));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stats,
+      tensorstore::Reduce(store, SummaryStatisticsReducer{}).result());
+  EXPECT_EQ(6, stats.count);
+  EXPECT_EQ(17, stats.sum);
+  EXPECT_EQ(-2, stats.min);
+  EXPECT_EQ(6, stats.max);
+}
+
+TEST(ReduceTest, Chunked) {
+  auto store = OpenChunkedStore();
+  absl::Mutex mutex;
+  Index reduced_elements = 0;
+  tensorstore::ReduceOptions options{[&](ReadProgress progress) {
+    EXPECT_EQ(90, progress.total_elements);
+    absl::MutexLock lock(&mutex);
+    reduced_elements = std::max(reduced_elements, progress.copied_elements);
+  }};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stats, tensorstore::Reduce(store, SummaryStatisticsReducer{},
+                                      std::move(options))
+                      .result());
+  {
+    absl::MutexLock lock(&mutex);
+    EXPECT_EQ(90, reduced_elements);
+  }
+  EXPECT_EQ(90, stats.count);
+  EXPECT_EQ(89 * 90 / 2, stats.sum);
+  EXPECT_EQ(0, stats.min);
+  EXPECT_EQ(89, stats.max);
+  EXPECT_EQ(44.5, stats.mean());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto histogram, tensorstore::Reduce(store, HistogramReducer{0, 80, 4})
+                          .result());
+  EXPECT_THAT(histogram.counts, ::testing::ElementsAre(20, 20, 20, 20));
+  EXPECT_EQ(0, histogram.underflow);
+  EXPECT_EQ(10, histogram.overflow);
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto sketch,
+      tensorstore::Reduce(store, QuantileSketchReducer{0.01}).result());
+  EXPECT_EQ(90, sketch.count());
+  // The median of `0, ..., 89` with "nearest" interpolation is 44.
+  EXPECT_NEAR(44, sketch.Quantile(0.5), 0.5);
+}
+
+TEST(ReduceTest, Transformed) {
+  auto store = OpenChunkedStore();
+  // Row 5 contains the values 45, ..., 53.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stats, tensorstore::Reduce(store | Dims(0).IndexSlice(5),
+                                      SummaryStatisticsReducer{})
+                      .result());
+  EXPECT_EQ(9, stats.count);
+  EXPECT_EQ(45, stats.min);
+  EXPECT_EQ(53, stats.max);
+}
+
+TEST(ReduceTest, UnsupportedDataType) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::FromArray(
+                      Context::Default(),
+                      MakeArray<std::string>({"a", "b"})));
+  EXPECT_THAT(tensorstore::Reduce(store, SummaryStatisticsReducer{}).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(DriverReduceTest, MaxBlockBytes) {
+  auto store = OpenChunkedStore();
+  absl::Mutex mutex;
+  std::vector<Index> block_sizes;
+  tensorstore::internal::DriverReduceOptions options;
+  options.max_block_bytes = 2 * sizeof(double);
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::internal::DriverReduce(
+          tensorstore::InlineExecutor{},
+          tensorstore::internal::TensorStoreAccess::handle(store),
+          tensorstore::dtype_v<double>,
+          [&](tensorstore::ArrayView<const void, 1> block) {
+            absl::MutexLock lock(&mutex);
+            block_sizes.push_back(block.num_elements());
+            return absl::OkStatus();
+          },
+          std::move(options))
+          .result());
+  Index total = 0;
+  for (Index size : block_sizes) {
+    EXPECT_LE(size, 2);
+    total += size;
+  }
+  EXPECT_EQ(90, total);
+}
+
+// Tests that the next read chunk is not requested until a previous one has
+// been reduced.
+TEST(DriverReduceTest, MaxInFlight) {
+  auto context = Context::Default();
+  auto memory_store = OpenChunkedTestStore(context, "<u2", {6, 4}, {2, 4});
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(tensorstore::MakeScalarArray<uint16_t>(1),
+                         memory_store)
+          .result());
+  auto memory_kvstore = memory_store.kvstore().driver;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_kvstore_resource,
+      context.GetResource<MockKeyValueStoreResource>());
+  auto mock_kvstore = *mock_kvstore_resource;
+  auto store_future =
+      tensorstore::Open({{"driver", "zarr"},
+                         {"kvstore", {{"driver", "mock_key_value_store"}}}},
+                        context, tensorstore::OpenMode::open);
+  mock_kvstore->read_requests.pop()(memory_kvstore);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, store_future.result());
+
+  absl::Mutex mutex;
+  Index total = 0;
+  tensorstore::internal::DriverReduceOptions options;
+  options.max_in_flight = 2;
+  auto future = tensorstore::internal::DriverReduce(
+      tensorstore::InlineExecutor{},
+      tensorstore::internal::TensorStoreAccess::handle(store),
+      tensorstore::dtype_v<double>,
+      [&](tensorstore::ArrayView<const void, 1> block) {
+        absl::MutexLock lock(&mutex);
+        total += block.num_elements();
+        return absl::OkStatus();
+      },
+      std::move(options));
+  auto request1 = mock_kvstore->read_requests.pop();
+  auto request2 = mock_kvstore->read_requests.pop();
+  EXPECT_TRUE(mock_kvstore->read_requests.empty());
+  EXPECT_FALSE(future.ready());
+
+  // Completing one chunk allows the last chunk to be requested.
+  request1(memory_kvstore);
+  mock_kvstore->read_requests.pop()(memory_kvstore);
+  EXPECT_TRUE(mock_kvstore->read_requests.empty());
+  request2(memory_kvstore);
+  TENSORSTORE_ASSERT_OK(future.result());
+  EXPECT_EQ(24, total);
+}
+
+}  // namespace
@@ -0,0 +1,454 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/scatter_write.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/data_type_conversion.h"
+#include "tensorstore/driver/chunk.h"
+#include "tensorstore/driver/driver.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/lock_collection.h"
+#include "tensorstore/internal/nditerable_copy.h"
+#include "tensorstore/internal/nditerable_data_type_conversion.h"
+#include "tensorstore/internal/nditerable_transformed_array.h"
+#include "tensorstore/internal/nditerable_util.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/progress.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace {
+
+/// Combines `*value` into `*accumulator`.
+using CombineFunction = void (*)(void* accumulator, const void* value);
+
+template <typename T>
+CombineFunction GetCombineFunctionForType(ScatterDuplicatePolicy policy) {
+  switch (policy) {
+    case ScatterDuplicatePolicy::kMin:
+      return [](void* accumulator, const void* value) {
+        auto& a = *static_cast<T*>(accumulator);
+        const auto& v = *static_cast<const T*>(value);
+        if (v < a) a = v;
+      };
+    case ScatterDuplicatePolicy::kMax:
+      return [](void* accumulator, const void* value) {
+        auto& a = *static_cast<T*>(accumulator);
+        const auto& v = *static_cast<const T*>(value);
+        if (a < v) a = v;
+      };
+    case ScatterDuplicatePolicy::kAdd:
+      return [](void* accumulator, const void* value) {
+        auto& a = *static_cast<T*>(accumulator);
+        const auto& v = *static_cast<const T*>(value);
+        if constexpr (std::is_integral_v<T>) {
+          // Signed overflow is undefined; integer sums instead wrap modulo
+          // 2^N, computed in the corresponding unsigned type.
+          using U = std::make_unsigned_t<T>;
+          a = static_cast<T>(
+              static_cast<U>(static_cast<U>(a) + static_cast<U>(v)));
+        } else {
+          a = static_cast<T>(a + v);
+        }
+      };
+    default:
+      return nullptr;
+  }
+}
+
+/// Returns the function used to combine duplicate values, or `nullptr` for
+/// `ScatterDuplicatePolicy::kLast`.
+Result<CombineFunction> GetCombineFunction(DataType dtype,
+                                           ScatterDuplicatePolicy policy) {
+  if (policy == ScatterDuplicatePolicy::kLast) return nullptr;
+#define TENSORSTORE_INTERNAL_GET_COMBINE_FUNCTION(T, ...) \
+  if (dtype == dtype_v<T>) return GetCombineFunctionForType<T>(policy);
+  TENSORSTORE_FOR_EACH_INTEGER_DATA_TYPE(
+      TENSORSTORE_INTERNAL_GET_COMBINE_FUNCTION)
+  TENSORSTORE_FOR_EACH_FLOAT_DATA_TYPE(
+      TENSORSTORE_INTERNAL_GET_COMBINE_FUNCTION)
+#undef TENSORSTORE_INTERNAL_GET_COMBINE_FUNCTION
+  return absl::InvalidArgumentError(
+      tensorstore::StrCat("Duplicate policy ", policy,
+                          " is not supported for data type ", dtype));
+}
+
+/// Local state for the asynchronous operation initiated by `ScatterWrite`.
+///
+/// `PartitionOp` groups the points by write chunk grid cell, and then
+/// schedules a separate `WriteCellOp` for the points of each grid cell, which
+/// sorts and de-duplicates those points and issues a single `Driver::Write`
+/// restricted to them.  Each `WriteChunk` received is written by
+/// `WriteCellChunk` while holding the chunk lock, in a single copy pass.
+///
+/// `copy_promise` becomes ready once all references to `ScatterWriteState`
+/// have been released, i.e. once all copies have completed.  For
+/// non-transactional writes, `commit_promise` is additionally linked to the
+/// commit future of each chunk.
+struct ScatterWriteState
+    : public internal::AtomicReferenceCount<ScatterWriteState> {
+  internal::DriverPtr driver;
+  IndexTransform<> transform;
+  internal::OpenTransactionPtr transaction;
+  SharedArray<const Index, 2> points;
+  SharedArray<const void, 1> values;
+  ScatterDuplicatePolicy duplicate_policy;
+  CombineFunction combine;
+  internal::DataTypeConversionLookupResult data_type_conversion;
+  Executor executor;
+
+  /// Grid cell indices of each point, in C order with shape
+  /// `points.shape()`.
+  std::vector<Index> cells;
+
+  /// Permutation of the point indices, grouped by grid cell.
+  std::vector<Index> order;
+
+  Promise<void> copy_promise;
+  Promise<void> commit_promise;
+
+  DimensionIndex rank() const { return points.shape()[1]; }
+
+  const Index* cell(Index i) const { return cells.data() + i * rank(); }
+
+  void SetError(absl::Status error) {
+    SetDeferredResult(copy_promise, std::move(error));
+  }
+};
+
+/// Copies the portion of `source` corresponding to `cell_transform` to
+/// `chunk`.
+void WriteCellChunk(ScatterWriteState& state,
+                    const TransformedSharedArray<const void>& source,
+                    internal::WriteChunk chunk,
+                    IndexTransform<> cell_transform) {
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto chunk_source,
+      ApplyIndexTransform(std::move(cell_transform), source),
+      state.SetError(_));
+  internal::DefaultNDIterableArena arena;
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto source_iterable,
+      internal::GetTransformedArrayNDIterable(std::move(chunk_source), arena),
+      state.SetError(_));
+  internal::LockCollection lock_collection;
+  absl::Status copy_status;
+  Future<const void> commit_future;
+  {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto guard, internal::LockChunks(lock_collection, chunk.impl),
+        state.SetError(_));
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto target_iterable,
+        chunk.impl(internal::WriteChunk::BeginWrite{}, chunk.transform, arena),
+        state.SetError(_));
+    source_iterable = internal::GetConvertedInputNDIterable(
+        std::move(source_iterable), target_iterable->dtype(),
+        state.data_type_conversion);
+    internal::NDIterableCopier copier(*source_iterable, *target_iterable,
+                                      chunk.transform.input_shape(), arena);
+    copy_status = copier.Copy();
+    auto end_write_result =
+        chunk.impl(internal::WriteChunk::EndWrite{}, chunk.transform,
+                   copier.layout_info().layout_view(),
+                   copier.stepper().position(), arena);
+    commit_future = std::move(end_write_result.commit_future);
+    if (copy_status.ok()) {
+      copy_status = std::move(end_write_result.copy_status);
+    }
+  }
+  if (!copy_status.ok()) {
+    state.SetError(std::move(copy_status));
+    return;
+  }
+  if (!state.commit_promise.null() && !commit_future.null()) {
+    // For transactional writes, `state.commit_promise` is null.
+    LinkError(state.commit_promise, std::move(commit_future));
+  }
+}
+
+/// FlowReceiver used by `WriteCellOp` to write the chunks of a single grid
+/// cell.
+///
+/// Chunks are written directly from `set_value` rather than being deferred to
+/// the executor: each covers only the points of one grid cell, and
+/// chunk cache-based drivers emit them synchronously from `Driver::Write`,
+/// i.e. on the executor thread already running `WriteCellOp`.
+struct WriteCellReceiver {
+  internal::IntrusivePtr<ScatterWriteState> state;
+  TransformedSharedArray<const void> source;
+  FutureCallbackRegistration cancel_registration;
+  void set_starting(AnyCancelReceiver cancel) {
+    cancel_registration =
+        state->copy_promise.ExecuteWhenNotNeeded(std::move(cancel));
+  }
+  void set_stopping() { cancel_registration(); }
+  void set_done() {}
+  void set_error(absl::Status error) { state->SetError(std::move(error)); }
+  void set_value(internal::WriteChunk chunk, IndexTransform<> cell_transform) {
+    WriteCellChunk(*state, source, std::move(chunk),
+                   std::move(cell_transform));
+  }
+};
+
+/// Writes the points `order[begin:end]`, which are all in the same grid cell.
+struct WriteCellOp {
+  internal::IntrusivePtr<ScatterWriteState> state;
+  Index begin;
+  Index end;
+
+  void operator()() {
+    if (!state->copy_promise.result_needed()) return;
+    const auto& points = state->points;
+    const DimensionIndex rank = state->rank();
+    span<Index> indices(state->order.data() + begin, end - begin);
+    // Sort by position, preserving the original order of duplicate points.
+    std::stable_sort(indices.begin(), indices.end(), [&](Index a, Index b) {
+      for (DimensionIndex i = 0; i < rank; ++i) {
+        if (points(a, i) != points(b, i)) return points(a, i) < points(b, i);
+      }
+      return false;
+    });
+    const auto same_point = [&](Index a, Index b) {
+      for (DimensionIndex i = 0; i < rank; ++i) {
+        if (points(a, i) != points(b, i)) return false;
+      }
+      return true;
+    };
+
+    // Determine the runs of duplicate points.
+    std::vector<Index> run_starts;
+    for (Index k = 0; k < indices.size(); ++k) {
+      if (k == 0 || !same_point(indices[k - 1], indices[k])) {
+        run_starts.push_back(k);
+      }
+    }
+    run_starts.push_back(indices.size());
+    const Index num_unique = run_starts.size() - 1;
+
+    auto cell_points =
+        AllocateArray<Index>({num_unique, rank}, c_order, default_init);
+    auto selected = AllocateArray<Index>({num_unique}, c_order, default_init);
+    for (Index j = 0; j < num_unique; ++j) {
+      const Index run_begin = run_starts[j], run_end = run_starts[j + 1];
+      const Index point = indices[run_begin];
+      for (DimensionIndex i = 0; i < rank; ++i) {
+        cell_points(j, i) = points(point, i);
+      }
+      selected(j) = state->duplicate_policy == ScatterDuplicatePolicy::kLast
+                        ? indices[run_end - 1]
+                        : point;
+    }
+
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto target_transform,
+        state->transform | AllDims().IndexVectorArraySlice(cell_points),
+        state->SetError(_));
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        TransformedSharedArray<const void> source,
+        state->values | Dims(0).OuterIndexArraySlice(selected),
+        state->SetError(_));
+    if (state->combine) {
+      TENSORSTORE_ASSIGN_OR_RETURN(auto combined, MakeCopy(source),
+                                   state->SetError(_));
+      const auto& values = state->values;
+      const Index element_size = values.dtype()->size;
+      auto* output = static_cast<char*>(const_cast<void*>(combined.data()));
+      for (Index j = 0; j < num_unique; ++j) {
+        for (Index k = run_starts[j] + 1; k < run_starts[j + 1]; ++k) {
+          state->combine(output + j * element_size,
+                         static_cast<const char*>(values.data()) +
+                             indices[k] * values.byte_strides()[0]);
+        }
+      }
+      source = std::move(combined);
+    }
+    auto driver = state->driver;
+    auto transaction = state->transaction;
+    driver->Write(std::move(transaction), std::move(target_transform),
+                  WriteCellReceiver{std::move(state), std::move(source)});
+  }
+};
+
+/// Groups the points by grid cell and schedules a `WriteCellOp` for each grid
+/// cell.
+///
+/// The grouping is a counting sort keyed by the grid cell indices, and
+/// therefore takes time linear in the number of points.
+struct PartitionOp {
+  internal::IntrusivePtr<ScatterWriteState> state;
+
+  void operator()() {
+    if (!state->copy_promise.result_needed()) return;
+    const DimensionIndex rank = state->rank();
+    const Index num_points = state->points.shape()[0];
+    const auto* s = state.get();
+    const auto cell_key = [&](Index p) {
+      return std::string_view(reinterpret_cast<const char*>(s->cell(p)),
+                              rank * sizeof(Index));
+    };
+    // Assign each grid cell a bucket, in order of first occurrence.
+    absl::flat_hash_map<std::string_view, Index> cell_buckets;
+    std::vector<Index> point_buckets(num_points);
+    std::vector<Index> bucket_starts;
+    for (Index p = 0; p < num_points; ++p) {
+      auto [it, inserted] =
+          cell_buckets.try_emplace(cell_key(p), bucket_starts.size());
+      if (inserted) bucket_starts.push_back(0);
+      ++bucket_starts[it->second];
+      point_buckets[p] = it->second;
+    }
+    // Convert the bucket sizes to offsets, and place each point in its bucket,
+    // preserving the original order within each bucket.
+    Index offset = 0;
+    for (auto& start : bucket_starts) {
+      start = std::exchange(offset, offset + start);
+    }
+    auto& order = state->order;
+    order.resize(num_points);
+    std::vector<Index> bucket_ends = bucket_starts;
+    for (Index p = 0; p < num_points; ++p) {
+      order[bucket_ends[point_buckets[p]]++] = p;
+    }
+    for (size_t b = 0; b < bucket_starts.size(); ++b) {
+      state->executor(WriteCellOp{state, bucket_starts[b], bucket_ends[b]});
+    }
+  }
+};
+
+}  // namespace
+
+std::ostream& operator<<(std::ostream& os, ScatterDuplicatePolicy policy) {
+  switch (policy) {
+    case ScatterDuplicatePolicy::kLast:
+      return os << "last";
+    case ScatterDuplicatePolicy::kMin:
+      return os << "min";
+    case ScatterDuplicatePolicy::kMax:
+      return os << "max";
+    case ScatterDuplicatePolicy::kAdd:
+      return os << "add";
+  }
+  return os;
+}
+
+WriteFutures ScatterWrite(SharedArray<const Index, 2> points,
+                          SharedArray<const void, 1> values,
+                          TensorStore<> store, ScatterWriteOptions options) {
+  const DimensionIndex rank = store.rank();
+  const Index num_points = points.shape()[0];
+  if (points.shape()[1] != rank || values.shape()[0] != num_points) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Points of shape ", points.shape(), " and values of shape ",
+        values.shape(), " are not compatible with TensorStore of rank ",
+        rank));
+  }
+  internal::IntrusivePtr<ScatterWriteState> state(new ScatterWriteState);
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      state->combine,
+      GetCombineFunction(values.dtype(), options.duplicate_policy));
+  state->duplicate_policy = options.duplicate_policy;
+
+  // Compute the write chunk grid cell of each point.
+  TENSORSTORE_ASSIGN_OR_RETURN(auto chunk_layout, store.chunk_layout());
+  const auto write_chunk_shape = chunk_layout.write_chunk_shape();
+  const auto grid_origin = chunk_layout.grid_origin();
+  const auto domain = store.domain();
+  std::vector<Index> origin(rank), chunk_shape(rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    chunk_shape[i] =
+        write_chunk_shape.size() == rank ? write_chunk_shape[i] : Index(0);
+    origin[i] = grid_origin.size() == rank ? grid_origin[i] : kImplicit;
+    if (origin[i] == kImplicit) origin[i] = 0;
+  }
+  state->cells.resize(num_points * rank);
+  for (Index p = 0; p < num_points; ++p) {
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      const Index x = points(p, i);
+      if (!Contains(domain[i], x)) {
+        return absl::OutOfRangeError(tensorstore::StrCat(
+            "Point ", p, " has index ", x, " in dimension ", i,
+            ", which is outside the domain ", domain[i]));
+      }
+      // Treat a dimension without a chunk size as a single chunk.
+      state->cells[p * rank + i] =
+          chunk_shape[i] > 0 ? FloorOfRatio(x - origin[i], chunk_shape[i])
+                             : Index(0);
+    }
+  }
+
+  auto handle = internal::TensorStoreAccess::handle(std::move(store));
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::ValidateSupportsWrite(handle.driver.read_write_mode()));
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      state->data_type_conversion,
+      internal::GetDataTypeConverterOrError(
+          values.dtype(), handle.driver->dtype(),
+          DataTypeConversionFlags::kSafeAndImplicit));
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      state->transaction,
+      internal::AcquireOpenTransactionPtrOrError(handle.transaction));
+  state->executor = handle.driver->data_copy_executor();
+  state->driver = std::move(handle.driver);
+  state->transform = std::move(handle.transform);
+  state->points = std::move(points);
+  state->values = std::move(values);
+  auto copy_pair = PromiseFuturePair<void>::Make(MakeResult());
+  PromiseFuturePair<void> commit_pair;
+  if (!state->transaction) {
+    commit_pair =
+        PromiseFuturePair<void>::LinkError(MakeResult(), copy_pair.future);
+    state->commit_promise = std::move(commit_pair.promise);
+  } else {
+    commit_pair.future = copy_pair.future;
+  }
+  state->copy_promise = std::move(copy_pair.promise);
+  auto executor = state->executor;
+  executor(PartitionOp{std::move(state)});
+  return WriteFutures(std::move(copy_pair.future),
+                      std::move(commit_pair.future));
+}
+
+}  // namespace tensorstore
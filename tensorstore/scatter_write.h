@@ -0,0 +1,99 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_SCATTER_WRITE_H_
+#define TENSORSTORE_SCATTER_WRITE_H_
+
+/// \file
+/// Writes of individual points to TensorStore objects.
+
+#include <iosfwd>
+
+#include "tensorstore/array.h"
+#include "tensorstore/index.h"
+#include "tensorstore/progress.h"
+#include "tensorstore/tensorstore.h"
+
+namespace tensorstore {
+
+/// Specifies how `ScatterWrite` resolves multiple values written to the same
+/// position.
+///
+/// \relates ScatterWrite
+enum class ScatterDuplicatePolicy {
+  /// The value that occurs last in the list of points is written.
+  kLast,
+  /// The minimum of the values is written.
+  kMin,
+  /// The maximum of the values is written.
+  kMax,
+  /// The sum of the values is written.  Integer sums wrap on overflow.
+  kAdd,
+};
+
+/// Prints a debugging string representation to an `std::ostream`.
+///
+/// \relates ScatterDuplicatePolicy
+std::ostream& operator<<(std::ostream& os, ScatterDuplicatePolicy policy);
+
+/// Options for `ScatterWrite`.
+///
+/// \relates ScatterWrite
+struct ScatterWriteOptions {
+  /// Specifies how duplicate points are resolved.  Only the values specified
+  /// in the same call are combined; values already stored are overwritten.
+  ScatterDuplicatePolicy duplicate_policy = ScatterDuplicatePolicy::kLast;
+};
+
+/// Writes a list of individual points to `store`.
+///
+/// This is equivalent to assigning ``values[i]`` to the position
+/// ``points[i, :]`` of `store` for each ``i``, but is much more efficient than
+/// issuing a separate `Write` for each point, or a single `Write` using an
+/// index array transform.
+///
+/// The points are grouped by the write chunk grid of `store`, as specified by
+/// its `ChunkLayout`, in time linear in the number of points.  The points of
+/// each chunk are then sorted and de-duplicated in parallel, and copied to the
+/// chunk in a single pass while holding its lock.
+///
+/// If the same position occurs more than once, the values are combined as
+/// specified by `options.duplicate_policy`.  The `kMin`, `kMax` and `kAdd`
+/// policies require that `values` has an integer or floating-point data type;
+/// the values are combined in that data type before being converted to the
+/// data type of `store`.  Integer sums that overflow wrap around modulo
+/// ``2**N``, where ``N`` is the number of bits of the data type.
+///
+/// \param points Array of shape ``[n, store.rank()]`` specifying the positions
+///     to write.
+/// \param values Array of shape ``[n]`` specifying the values to write.  Must
+///     be convertible to the data type of `store`.
+/// \param store Target TensorStore that supports writing.
+/// \param options Specifies the duplicate resolution policy.
+/// \error `absl::StatusCode::kInvalidArgument` if the shapes of `points` and
+///     `values` are not compatible with each other or with `store`.
+/// \error `absl::StatusCode::kInvalidArgument` if
+///     `options.duplicate_policy` is not supported by the data type of
+///     `values`.
+/// \error `absl::StatusCode::kOutOfRange` if a point is outside the domain of
+///     `store`.
+/// \ingroup scatter_write
+WriteFutures ScatterWrite(SharedArray<const Index, 2> points,
+                          SharedArray<const void, 1> values,
+                          TensorStore<> store,
+                          ScatterWriteOptions options = {});
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_SCATTER_WRITE_H_
@@ -0,0 +1,111 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// Benchmarks writing a list of random points to an in-memory zarr array.
+///
+/// The "ScatterWrite" variant uses `tensorstore::ScatterWrite`.  The
+/// "IndexArray" variant uses a single `tensorstore::Write` with an index array
+/// transform.  The "PerPoint" variant issues a separate `tensorstore::Write`
+/// for each point.
+
+#include <stdint.h>
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/chunked_store_testutil.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/progress.h"
+#include "tensorstore/scatter_write.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Index;
+
+constexpr Index kSize = 512;
+
+enum class Method { kScatterWrite, kIndexArray, kPerPoint };
+
+void BenchmarkWritePoints(benchmark::State& state, Method method) {
+  const Index num_points = state.range(0);
+  std::minstd_rand gen(42);
+  std::uniform_int_distribution<Index> dist(0, kSize - 1);
+  auto points = tensorstore::AllocateArray<Index>({num_points, 3});
+  auto values = tensorstore::AllocateArray<uint32_t>({num_points});
+  for (Index i = 0; i < num_points; ++i) {
+    for (Index j = 0; j < 3; ++j) points(i, j) = dist(gen);
+    values(i) = static_cast<uint32_t>(i);
+  }
+  for (auto s : state) {
+    state.PauseTiming();
+    auto store = tensorstore::internal::OpenChunkedTestStore(
+        tensorstore::Context::Default(), "<u4", {kSize, kSize, kSize},
+        {64, 64, 64}, {{"compressor", nullptr}});
+    state.ResumeTiming();
+    switch (method) {
+      case Method::kScatterWrite:
+        TENSORSTORE_CHECK_OK(
+            tensorstore::ScatterWrite(points, values, store).result());
+        break;
+      case Method::kIndexArray:
+        TENSORSTORE_CHECK_OK(
+            tensorstore::Write(
+                values,
+                store | tensorstore::AllDims().IndexVectorArraySlice(points))
+                .result());
+        break;
+      case Method::kPerPoint: {
+        std::vector<tensorstore::AnyFuture> futures;
+        for (Index i = 0; i < num_points; ++i) {
+          futures.push_back(
+              tensorstore::Write(
+                  tensorstore::MakeScalarArray<uint32_t>(values(i)),
+                  store | tensorstore::Dims(0, 1, 2).IndexSlice(
+                              {points(i, 0), points(i, 1), points(i, 2)}))
+                  .commit_future);
+        }
+        TENSORSTORE_CHECK_OK(
+            tensorstore::WaitAllFuture(futures).result());
+        break;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_points);
+}
+
+void BM_ScatterWrite(benchmark::State& state) {
+  BenchmarkWritePoints(state, Method::kScatterWrite);
+}
+
+void BM_IndexArray(benchmark::State& state) {
+  BenchmarkWritePoints(state, Method::kIndexArray);
+}
+
+void BM_PerPoint(benchmark::State& state) {
+  BenchmarkWritePoints(state, Method::kPerPoint);
+}
+
+BENCHMARK(BM_ScatterWrite)->Range(1000, 1000000)->UseRealTime();
+BENCHMARK(BM_IndexArray)->Range(1000, 1000000)->UseRealTime();
+BENCHMARK(BM_PerPoint)->Range(1000, 100000)->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,187 @@
+// Copyright 2023 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/scatter_write.h"
+
+#include <stdint.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/chunked_store_testutil.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/status_testutil.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::Index;
+using ::tensorstore::MakeArray;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::ScatterDuplicatePolicy;
+using ::tensorstore::Transaction;
+using ::tensorstore::internal::OpenChunkedTestStore;
+
+TEST(ScatterWriteTest, Basic) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<i4", {4, 5}, {2, 3});
+  TENSORSTORE_ASSERT_OK(tensorstore::ScatterWrite(
+      MakeArray<Index>({{0, 0}, {3, 4}, {1, 2}, {2, 3}, {0, 4}}),
+      MakeArray<int32_t>({1, 2, 3, 4, 5}), store));
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(MakeArray<int32_t>({{1, 0, 0, 0, 5},
+                                                      {0, 0, 3, 0, 0},
+                                                      {0, 0, 0, 4, 0},
+                                                      {0, 0, 0, 0, 2}})));
+}
+
+TEST(ScatterWriteTest, ConvertsDataType) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<u2", {4, 5}, {2, 3});
+  TENSORSTORE_ASSERT_OK(tensorstore::ScatterWrite(
+      MakeArray<Index>({{1, 1}, {2, 2}}), MakeArray<int64_t>({7, 8}), store,
+      {/*.duplicate_policy=*/ScatterDuplicatePolicy::kAdd}));
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(MakeArray<uint16_t>({{0, 0, 0, 0, 0},
+                                                       {0, 7, 0, 0, 0},
+                                                       {0, 0, 8, 0, 0},
+                                                       {0, 0, 0, 0, 0}})));
+}
+
+void TestDuplicates(ScatterDuplicatePolicy policy, int32_t expected_a,
+                    int32_t expected_b) {
+  SCOPED_TRACE(tensorstore::StrCat("policy=", policy));
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<i4", {4, 5}, {2, 3});
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+                            MakeArray<int32_t>({{9, 9, 9, 9, 9},
+                                                {9, 9, 9, 9, 9},
+                                                {9, 9, 9, 9, 9},
+                                                {9, 9, 9, 9, 9}}),
+                            store)
+                            .result());
+  TENSORSTORE_ASSERT_OK(tensorstore::ScatterWrite(
+      MakeArray<Index>({{1, 1}, {2, 3}, {1, 1}, {2, 3}, {1, 1}}),
+      MakeArray<int32_t>({3, 4, 1, 6, 2}), store,
+      {/*.duplicate_policy=*/policy}));
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(MakeArray<int32_t>({{9, 9, 9, 9, 9},
+                                                      {9, expected_a, 9, 9, 9},
+                                                      {9, 9, 9, expected_b, 9},
+                                                      {9, 9, 9, 9, 9}})));
+}
+
+TEST(ScatterWriteTest, Duplicates) {
+  TestDuplicates(ScatterDuplicatePolicy::kLast, 2, 6);
+  TestDuplicates(ScatterDuplicatePolicy::kMin, 1, 4);
+  TestDuplicates(ScatterDuplicatePolicy::kMax, 3, 6);
+  TestDuplicates(ScatterDuplicatePolicy::kAdd, 6, 10);
+}
+
+TEST(ScatterWriteTest, AddWrapsOnOverflow) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<i4", {2}, {2});
+  TENSORSTORE_ASSERT_OK(tensorstore::ScatterWrite(
+      MakeArray<Index>({{0}, {0}, {1}, {1}}),
+      MakeArray<int32_t>({std::numeric_limits<int32_t>::max(), 2,
+                          std::numeric_limits<int32_t>::min(), -1}),
+      store, {/*.duplicate_policy=*/ScatterDuplicatePolicy::kAdd}));
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(MakeArray<int32_t>(
+                  {std::numeric_limits<int32_t>::min() + 1,
+                   std::numeric_limits<int32_t>::max()})));
+}
+
+TEST(ScatterWriteTest, Transaction) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<i4", {4, 5}, {2, 3});
+  Transaction txn(tensorstore::isolated);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto txn_store, store | txn);
+  TENSORSTORE_ASSERT_OK(tensorstore::ScatterWrite(
+      MakeArray<Index>({{0, 0}, {3, 4}}), MakeArray<int32_t>({1, 2}),
+      txn_store));
+  EXPECT_THAT(tensorstore::Read(txn_store).result(),
+              ::testing::Optional(MakeArray<int32_t>({{1, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 2}})));
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(MakeArray<int32_t>({{0, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 0}})));
+  TENSORSTORE_ASSERT_OK(txn.CommitAsync().result());
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(MakeArray<int32_t>({{1, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 0},
+                                                      {0, 0, 0, 0, 2}})));
+}
+
+TEST(ScatterWriteTest, Empty) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<i4", {4, 5}, {2, 3});
+  TENSORSTORE_EXPECT_OK(tensorstore::ScatterWrite(
+      tensorstore::AllocateArray<Index>({0, 2}),
+      tensorstore::AllocateArray<int32_t>({0}), store));
+}
+
+TEST(ScatterWriteTest, OutOfRange) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<i4", {4, 5}, {2, 3});
+  EXPECT_THAT(tensorstore::ScatterWrite(MakeArray<Index>({{0, 0}, {4, 0}}),
+                                        MakeArray<int32_t>({1, 2}), store)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kOutOfRange,
+                            "Point 1 has index 4 in dimension 0, .*"));
+}
+
+TEST(ScatterWriteTest, ShapeMismatch) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<i4", {4, 5}, {2, 3});
+  EXPECT_THAT(tensorstore::ScatterWrite(MakeArray<Index>({{0, 0}, {1, 0}}),
+                                        MakeArray<int32_t>({1}), store)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Points of shape \\{2, 2\\} and values of shape "
+                            "\\{1\\} are not compatible .*"));
+  EXPECT_THAT(tensorstore::ScatterWrite(MakeArray<Index>({{0}, {1}}),
+                                        MakeArray<int32_t>({1, 2}), store)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ScatterWriteTest, UnsupportedPolicy) {
+  auto context = Context::Default();
+  auto store = OpenChunkedTestStore(context, "<i4", {4, 5}, {2, 3});
+  EXPECT_THAT(
+      tensorstore::ScatterWrite(
+          MakeArray<Index>({{0, 0}}), MakeArray<std::string>({"1"}), store,
+          {/*.duplicate_policy=*/ScatterDuplicatePolicy::kAdd})
+          .result(),
+      MatchesStatus(absl::StatusCode::kInvalidArgument,
+                    "Duplicate policy add is not supported for data type "
+                    "string"));
+}
+
+}  // namespace
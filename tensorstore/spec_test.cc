@@ -309,10 +309,12 @@ TEST(SpecTest, SetContextAndKvstore) {
           {"transform",
            {{"input_inclusive_min", {0}}, {"input_exclusive_max", {{10}}}}},
           {"data_copy_concurrency", {"data_copy_concurrency"}},
+          {"in_flight_bytes", {"in_flight_bytes"}},
           {"context",
            {
                {"data_copy_concurrency", ::nlohmann::json::object_t()},
                {"cache_pool", ::nlohmann::json::object_t()},
+               {"in_flight_bytes", ::nlohmann::json::object_t()},
                {"file_io_concurrency#a", {{"limit", 5}}},
            }},
       })));
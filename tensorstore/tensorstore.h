@@ -16,8 +16,11 @@
 #define TENSORSTORE_TENSORSTORE_H_
 
 #include <string>
+#include <vector>
 
+#include "tensorstore/box.h"
 #include "tensorstore/chunk_layout.h"
+#include "tensorstore/chunk_statistics.h"
 #include "tensorstore/driver/copy.h"
 #include "tensorstore/driver/driver.h"
 #include "tensorstore/driver/read.h"
@@ -25,6 +28,7 @@
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/io_cost.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/rank.h"
@@ -520,6 +524,137 @@ Resize(
       std::move(store));
 }
 
+/// Returns the regions of `store` corresponding to storage chunks that may
+/// contain elements matching `query`.
+///
+/// Drivers that maintain per-chunk statistics (see
+/// :json:schema:`KeyValueStoreBackedChunkDriver.chunk_statistics`) use them
+/// to exclude chunks that are ruled out by `query`, without reading the chunk
+/// data.  All other chunks are included, so the result is a superset of the
+/// matching chunks.
+///
+/// Example::
+///
+///     TensorStore<std::uint16_t, 3> store = ...;
+///     ChunkStatisticsQuery query;
+///     query.min_value = 1000;
+///     TENSORSTORE_ASSIGN_OR_RETURN(auto chunks,
+///                                  FindChunks(store, query).result());
+///     for (const auto& chunk : chunks) {
+///       // Only read chunks that may contain a value >= 1000.
+///       auto array = Read(store | AllDims().BoxSlice(chunk)).result();
+///     }
+///
+/// \param store The TensorStore to query.  May be `Result`-wrapped.
+/// \param query The predicate on chunk values.
+/// \returns A future for the bounding box, within the domain of `store`, of
+///     each candidate chunk.
+/// \relates TensorStore
+/// \membergroup I/O
+template <typename StoreResult>
+std::enable_if_t<internal::IsTensorStore<UnwrapResultType<StoreResult>>,
+                 Future<std::vector<Box<>>>>
+FindChunks(StoreResult store, ChunkStatisticsQuery query = {}) {
+  return MapResult(
+      [&](auto&& store) -> Future<std::vector<Box<>>> {
+        auto& handle = internal::TensorStoreAccess::handle(store);
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto open_transaction,
+            internal::AcquireOpenTransactionPtrOrError(handle.transaction));
+        return handle.driver->FindChunks(
+            std::move(open_transaction),
+            IndexTransform<>(std::move(handle.transform)), std::move(query));
+      },
+      std::move(store));
+}
+
+/// Estimates the I/O cost of reading `store`, without performing any I/O.
+///
+/// The domain is partitioned over the chunk grid exactly as by `Read`, and the
+/// chunk cache is consulted to determine which chunks are already cached.  The
+/// resultant report lists every chunk that would be read, whether it is only
+/// partially accessed, and the estimated kvstore requests and bytes, which may
+/// be used, for example, to choose chunk-aligned units of work.
+///
+/// Example::
+///
+///     TensorStore<float, 3> store = ...;
+///     TENSORSTORE_ASSIGN_OR_RETURN(
+///         auto report, ExplainRead(store | Dims(0).HalfOpenInterval(0, 100)));
+///     auto total = report.total();
+///     std::cout << total.kvstore_reads << " reads, amplification "
+///               << total.read_amplification() << std::endl;
+///
+/// \param store The TensorStore to read.  May be `Result`-wrapped.
+/// \error `absl::StatusCode::kUnimplemented` if the driver does not support
+///     I/O cost estimation, or `store` is bound to a transaction.
+/// \relates TensorStore
+/// \membergroup I/O
+template <typename StoreResult>
+std::enable_if_t<internal::IsTensorStore<UnwrapResultType<StoreResult>>,
+                 Result<IoCostReport>>
+ExplainRead(StoreResult store) {
+  return MapResult(
+      [](auto&& store) {
+        return internal::ExplainIo(internal::TensorStoreAccess::handle(store),
+                                   ReadWriteMode::read);
+      },
+      std::move(store));
+}
+
+/// Estimates the I/O cost of writing to `store`, without performing any I/O.
+///
+/// Chunks that are only partially overwritten must be read before they are
+/// written back, unless they are already cached.
+///
+/// \param store The TensorStore to write.  May be `Result`-wrapped.
+/// \error `absl::StatusCode::kUnimplemented` if the driver does not support
+///     I/O cost estimation, or `store` is bound to a transaction.
+/// \relates TensorStore
+/// \membergroup I/O
+template <typename StoreResult>
+std::enable_if_t<internal::IsTensorStore<UnwrapResultType<StoreResult>>,
+                 Result<IoCostReport>>
+ExplainWrite(StoreResult store) {
+  return MapResult(
+      [](auto&& store) {
+        return internal::ExplainIo(internal::TensorStoreAccess::handle(store),
+                                   ReadWriteMode::write);
+      },
+      std::move(store));
+}
+
+/// Estimates the I/O cost of copying from `source` to `target`, without
+/// performing any I/O.
+///
+/// The chunks read from `source` are followed by the chunks written to
+/// `target`; `IoCostReport::per_kvstore` separates the costs of each.
+///
+/// \param source The source TensorStore.  May be `Result`-wrapped.
+/// \param target The target TensorStore.  May be `Result`-wrapped.
+/// \relates TensorStore
+/// \membergroup I/O
+template <typename SourceResult, typename TargetResult>
+std::enable_if_t<(internal::IsTensorStore<UnwrapResultType<SourceResult>> &&
+                  internal::IsTensorStore<UnwrapResultType<TargetResult>>),
+                 Result<IoCostReport>>
+ExplainCopy(SourceResult source, TargetResult target) {
+  return MapResult(
+      [](auto&& source, auto&& target) -> Result<IoCostReport> {
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto report,
+            internal::ExplainIo(internal::TensorStoreAccess::handle(source),
+                                ReadWriteMode::read));
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto write_report,
+            internal::ExplainIo(internal::TensorStoreAccess::handle(target),
+                                ReadWriteMode::write));
+        report.Append(std::move(write_report));
+        return report;
+      },
+      std::move(source), std::move(target));
+}
+
 /// Copies from `source` TensorStore to `target` array.
 ///
 /// The domain of `source` is resolved via `ResolveBounds` and then
@@ -601,6 +736,51 @@ Read(Source&& source, ReadIntoNewArrayOptions options = {}) {
       std::forward<Source>(source));
 }
 
+/// Reads from a `source` `TensorStore` into a read-only `Array`, avoiding a
+/// copy when possible.
+///
+/// If the read is satisfied by a single cached chunk whose data already has
+/// the contiguous `options.layout_order`, the returned array references the
+/// cached chunk data directly, and keeps it alive for as long as the array is
+/// referenced.  Otherwise, the data is copied into a newly-allocated array, as
+/// with `Read[TensorStore]`.  Reads within a transaction always copy.
+///
+/// Example::
+///
+///     TensorReader<std::int32_t, 3> store = ...;
+///     SharedArray<const std::int32_t, 3> array = Read(
+///         store | AllDims().SizedInterval({0, 0, 0}, {64, 64, 64}),
+///         ReadIntoSharedArrayOptions{}).value();
+///
+/// \tparam OriginKind If equal to `offset_origin` (the default), the returned
+///     array has the same origin as `source`.  Otherwise, the returned array is
+///     translated to have an origin of zero for all dimensions.
+/// \param source Source TensorStore object that supports reading.  May be
+///     `Result`-wrapped.
+/// \param options Additional read options.
+/// \returns A future that becomes ready when the read has completed
+///     successfully or has failed.
+/// \relates TensorStore
+/// \id TensorStore, ReadIntoSharedArrayOptions
+/// \membergroup I/O
+template <ArrayOriginKind OriginKind = offset_origin, typename Source,
+          typename Options>
+internal::ReadTensorStoreIntoSharedArrayResult<
+    OriginKind, UnwrapResultType<internal::remove_cvref_t<Source>>, Options>
+Read(Source&& source, Options options) {
+  return MapResult(
+      [&](UnwrapQualifiedResultType<Source&&> unwrapped_source) {
+        using Store = UnwrapResultType<internal::remove_cvref_t<Source>>;
+        return internal_tensorstore::MapArrayFuture<
+            const typename Store::Element, Store::static_rank, OriginKind>(
+            internal::DriverReadIntoSharedArray(
+                internal::TensorStoreAccess::handle(
+                    std::forward<decltype(unwrapped_source)>(unwrapped_source)),
+                std::move(options)));
+      },
+      std::forward<Source>(source));
+}
+
 /// Copies from a `source` array to `target` TensorStore.
 ///
 /// The domain of `target` is resolved via `ResolveBounds` and then the domain
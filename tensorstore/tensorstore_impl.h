@@ -164,6 +164,15 @@ using ReadTensorStoreIntoNewArrayResult = std::enable_if_t<
     Future<
         SharedArray<typename Store::Element, Store::static_rank, OriginKind>>>;
 
+/// Evaluates to the return type of `Read` (for a read-only target array) if the
+/// constraints are satisfied.
+template <ArrayOriginKind OriginKind, typename Store, typename Options>
+using ReadTensorStoreIntoSharedArrayResult = std::enable_if_t<
+    (internal::IsTensorStoreThatSupportsMode<Store, ReadWriteMode::read> &&
+     std::is_same_v<Options, ReadIntoSharedArrayOptions>),
+    Future<SharedArray<const typename Store::Element, Store::static_rank,
+                       OriginKind>>>;
+
 absl::Status InvalidModeError(ReadWriteMode mode, ReadWriteMode static_mode);
 absl::Status ValidateDataTypeAndRank(DataType expected_dtype,
                                      DimensionIndex expected_rank,
@@ -192,12 +201,13 @@ namespace internal_tensorstore {
 
 using TensorStoreAccess = internal::TensorStoreAccess;
 
-template <typename Element, DimensionIndex Rank, ArrayOriginKind OriginKind>
+template <typename Element, DimensionIndex Rank, ArrayOriginKind OriginKind,
+          typename SourceElement>
 Future<SharedArray<Element, Rank, OriginKind>> MapArrayFuture(
-    Future<SharedOffsetArray<void>> future) {
+    Future<SharedOffsetArray<SourceElement>> future) {
   return MapFutureValue(
       InlineExecutor{},
-      [](SharedOffsetArray<void>& array)
+      [](SharedOffsetArray<SourceElement>& array)
           -> Result<SharedArray<Element, Rank, OriginKind>> {
         // StaticCast the type-erased array type returned by `DriverRead` to the
         // more strongly-typed array type.
@@ -14,8 +14,12 @@
 
 #include "tensorstore/transaction.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include "absl/base/optimization.h"
 #include "absl/functional/function_ref.h"
+#include "tensorstore/internal/metrics/gauge.h"
 #include "tensorstore/serialization/serialization.h"
 #include "tensorstore/transaction_impl.h"
 #include "tensorstore/util/str_cat.h"
@@ -28,6 +32,11 @@ static_assert(TransactionState::kAtomic ==
               TransactionMode::atomic_isolated - TransactionMode::isolated);
 
 namespace {
+auto& transaction_bytes = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/transaction/total_bytes",
+    "Estimated bytes of memory held by transactions that have not yet been "
+    "committed or aborted.");
+
 absl::Status GetCancelledError() {
   return absl::CancelledError("Transaction aborted");
 }
@@ -39,6 +48,12 @@ TransactionState::Node::Node(void* associated_data)
 std::string TransactionState::Node::Describe() { return {}; }
 TransactionState::Node::~Node() = default;
 
+void TransactionState::Node::UpdateSizeInBytes(size_t new_minus_old) {
+  transaction_->total_bytes_.fetch_add(new_minus_old,
+                                       std::memory_order_relaxed);
+  transaction_bytes.IncrementBy(static_cast<int64_t>(new_minus_old));
+}
+
 void TransactionState::NoMoreCommitReferences() {
   UniqueWriterLock lock(mutex_);
   const size_t count = commit_reference_count_.load(std::memory_order_relaxed);
@@ -178,7 +193,7 @@ void TransactionState::ExecuteAbort() {
   if (nodes_.empty()) {
     // Nothing to abort, just release `promise_` so that it becomes ready with
     // the error set previously by `SetDeferredResult`.
-    promise_ = Promise<void>();
+    Finish();
     return;
   }
   // Transaction nodes are allowed to abort asynchronously.  When they are
@@ -213,6 +228,12 @@ void TransactionState::DecrementNodesPendingAbort(size_t count) {
   }
   // All nodes aborted.  Release `promise_` so that it becomes ready with the
   // error set previously by `SetDeferredResult`.
+  Finish();
+}
+
+void TransactionState::Finish() {
+  finished_bytes_ = total_bytes();
+  transaction_bytes.DecrementBy(static_cast<int64_t>(finished_bytes_));
   promise_ = Promise<void>();
 }
 
@@ -226,7 +247,7 @@ void TransactionState::ExecuteCommit() {
 void TransactionState::ExecuteCommitPhase() {
   if (nodes_.empty()) {
     // All phases completed.
-    promise_ = Promise<void>();
+    Finish();
     return;
   }
   // Reset the `commit_start_time_` at the start of each phase, because for
@@ -327,7 +348,7 @@ void TransactionState::DecrementNodesPendingCommit(size_t count) {
     // All phases completed.  Release the reference to `promise_` so that it
     // becomes ready either with success or with the error set previously by
     // `SetDeferredResult`.
-    promise_ = Promise<void>();
+    Finish();
   }
 }
 
@@ -471,7 +492,12 @@ void TransactionState::NoMoreOpenReferences() {
   }
 }
 
-TransactionState::~TransactionState() = default;
+TransactionState::~TransactionState() {
+  // Remove any changes made after `Finish`, or the entire size if the
+  // transaction never completed.
+  transaction_bytes.DecrementBy(
+      static_cast<int64_t>(total_bytes() - finished_bytes_));
+}
 
 void TransactionState::Node::PrepareDone() {
   auto& transaction = *this->transaction();
@@ -442,10 +442,10 @@ class TransactionState {
 
     /// Adjusts the size in bytes accounted to the transaction by
     /// `new_minus_old`.
-    void UpdateSizeInBytes(size_t new_minus_old) {
-      transaction_->total_bytes_.fetch_add(new_minus_old,
-                                           std::memory_order_relaxed);
-    }
+    ///
+    /// Until the transaction completes, the change is also reflected in the
+    /// `/tensorstore/transaction/total_bytes` metric.
+    void UpdateSizeInBytes(size_t new_minus_old);
 
     /// Returns a string description of the node,
     /// e.g. `"write to local file xyz"`.
@@ -712,6 +712,11 @@ class TransactionState {
   /// remaining phases if an error occurred while committing the last phase.
   void ExecuteAbort();
 
+  /// Called once the transaction has been committed or aborted.  Removes
+  /// `total_bytes()` from the `/tensorstore/transaction/total_bytes` metric and
+  /// releases `promise_` so that it becomes ready.
+  void Finish();
+
   /// Called when `ExecuteAbort` finishes calling `Abort` on every node, and
   /// also by `Node::AbortDone`.
   ///
@@ -842,6 +847,10 @@ class TransactionState {
   /// Estimated bytes of memory occupied by transaction.
   std::atomic<size_t> total_bytes_;
 
+  /// Value of `total_bytes_` removed from the metric by `Finish`.  Any later
+  /// changes are removed by the destructor.
+  size_t finished_bytes_ = 0;
+
   /// Commit state values, indicating the current state of the transaction.
   enum CommitState {
     /// Additional reads or writes may be performed using the transaction.  No
@@ -22,7 +22,9 @@
 #include <array>
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 
+#include "absl/base/attributes.h"
 #include "tensorstore/util/internal/iterate.h"
 #include "tensorstore/util/iterate.h"
 
@@ -220,6 +222,10 @@ InnerShapeAndStrides<N, InnerRank> ExtractInnerShapeAndStrides(
   return inner_shapes_and_strides;
 }
 
+/// Maximum number of dimensions for which `IterateHelper` uses a loop nest
+/// with the number of dimensions fixed at compile time.
+constexpr DimensionIndex kMaxStaticIterationRank = 4;
+
 /// Helper class that implements the recursive iteration over a
 /// multi-dimensional shape.
 template <typename Func, typename... Pointer>
@@ -229,17 +235,57 @@ class IterateHelper {
   using Result = std::invoke_result_t<Func, Pointer...>;
 
   /// Calls `func` for each position within the multi-dimensional layout.
+  ///
+  /// For the common case of at most `kMaxStaticIterationRank` dimensions,
+  /// dispatches to a loop nest specialized for the number of dimensions, which
+  /// avoids the per-element recursion and `span` bookkeeping that otherwise
+  /// dominates when the extents are small.
   static Result Start(Func func,
                       span<const DimensionSizeAndStrides<arity>> layouts,
                       Pointer... pointers) {
-    if (layouts.size() == 0) {
-      return func(pointers...);
+    constexpr auto index_sequence = std::index_sequence_for<Pointer...>();
+    switch (layouts.size()) {
+      case 0:
+        return func(pointers...);
+      case 1:
+        return StaticLoop<1, 0>(func, layouts.data(), index_sequence,
+                                pointers...);
+      case 2:
+        return StaticLoop<2, 0>(func, layouts.data(), index_sequence,
+                                pointers...);
+      case 3:
+        return StaticLoop<3, 0>(func, layouts.data(), index_sequence,
+                                pointers...);
+      case 4:
+        static_assert(kMaxStaticIterationRank == 4);
+        return StaticLoop<4, 0>(func, layouts.data(), index_sequence,
+                                pointers...);
+      default:
+        return Loop(func, layouts, index_sequence, pointers...);
     }
-    return Loop(func, layouts, std::index_sequence_for<Pointer...>(),
-                pointers...);
   }
 
  private:
+  /// Loops over dimension `Dim` of a layout with `Rank` dimensions, and either
+  /// recurses or, if `Dim == Rank`, calls `func`.
+  template <DimensionIndex Rank, DimensionIndex Dim, std::size_t... Is>
+  ABSL_ATTRIBUTE_ALWAYS_INLINE static Result StaticLoop(
+      Func& func, const DimensionSizeAndStrides<arity>* layouts,
+      std::index_sequence<Is...> index_sequence, Pointer... pointers) {
+    if constexpr (Dim == Rank) {
+      return func(pointers...);
+    } else {
+      const DimensionSizeAndStrides<arity> size_and_strides = layouts[Dim];
+      for (Index i = 0; i < size_and_strides.size; ++i) {
+        Result result = StaticLoop<Rank, Dim + 1>(func, layouts,
+                                                  index_sequence, pointers...);
+        if (!result) return result;
+        ((pointers += size_and_strides.strides[Is]), ...);
+      }
+      return internal::DefaultIterationResult<Result>::value();
+    }
+  }
+
   /// Loops over the next dimension, and either recurses or calls `func`.
   ///
   /// \pre layouts.size() >= 1
@@ -261,8 +307,8 @@ class IterateHelper {
       }
     } else {
       for (Index i = 0; i < size_and_strides.size; ++i) {
-        auto result = Loop(func, {&layouts[1], layouts.size() - 1},
-                           index_sequence, pointers...);
+        result = Loop(func, {&layouts[1], layouts.size() - 1}, index_sequence,
+                      pointers...);
         if (!result) break;
         increment_pointers();
       }
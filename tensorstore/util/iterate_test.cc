@@ -525,6 +525,40 @@ TEST(IterateOverStridedLayoutsTest, InnerRank0NonContiguousFortranStop) {
   EXPECT_EQ(expected_result, result);
 }
 
+// Tests iteration over a rank for which `IterateHelper` uses a loop nest
+// specialized for the number of dimensions.
+TEST(IterateOverStridedLayoutsTest, StaticRankStop) {
+  const Index shape[] = {2, 2, 3};
+  const Index strides[] = {100, 10, 1};
+
+  std::vector<int> result;
+  auto func = [&](int a) {
+    result.push_back(a);
+    return a != 12;
+  };
+  EXPECT_EQ(false, IterateOverStridedLayouts(shape, {{strides}}, func,
+                                             ContiguousLayoutOrder::c, 0));
+  EXPECT_THAT(result, ElementsAre(0, 1, 2, 10, 11, 12));
+}
+
+// Tests iteration over a rank greater than `kMaxStaticIterationRank`, for
+// which `IterateHelper` uses the general recursive loop.
+TEST(IterateOverStridedLayoutsTest, DynamicRankStop) {
+  const Index shape[] = {2, 1, 2, 2, 2, 2};
+  const Index strides[] = {100000, 0, 1000, 100, 10, 1};
+
+  std::vector<int> result;
+  auto func = [&](int a) {
+    result.push_back(a);
+    return a != 1011;
+  };
+  EXPECT_EQ(false, IterateOverStridedLayouts(shape, {{strides}}, func,
+                                             ContiguousLayoutOrder::c, 0));
+  EXPECT_THAT(result,
+              ElementsAre(0, 1, 10, 11, 100, 101, 110, 111, 1000, 1001,
+                          1010, 1011));
+}
+
 TEST(ArrayIterateResultTest, Comparison) {
   ArrayIterateResult r0{true, 3};
   ArrayIterateResult r1{true, 4};